@@ -38,6 +38,12 @@ const GameObjectType* AnimationResourceHandler::GetResourceType() const
     return Animation::GetStaticType();
 }
 
+/// @copydoc ResourceHandler::GetVersion()
+uint32_t AnimationResourceHandler::GetVersion() const
+{
+    return VERSION;
+}
+
 /// @copydoc ResourceHandler::GetSourceExtensions()
 void AnimationResourceHandler::GetSourceExtensions(
     const tchar_t* const*& rppExtensions,
@@ -0,0 +1,410 @@
+#include "EditorSupportPch.h"
+
+#if HELIUM_TOOLS
+
+#include "EditorSupport/BatchCooker.h"
+
+#include "Platform/Thread.h"
+#include "Platform/Timer.h"
+#include "Foundation/DirectoryIterator.h"
+#include "Foundation/FilePath.h"
+#include "Engine/FileLocations.h"
+#include "Engine/GameObjectLoader.h"
+#include "Engine/PackageLoader.h"
+#include "PcSupport/ResourceHandler.h"
+
+#include <set>
+
+using namespace Helium;
+
+/// Constructor.
+BatchCooker::BatchCooker()
+{
+}
+
+/// Destructor.
+BatchCooker::~BatchCooker()
+{
+}
+
+/// Preprocess and cache all resources found in the data directory.
+///
+/// @return  True if all resources were cooked successfully, false if any errors occurred.
+bool BatchCooker::Run()
+{
+    ObjectPreprocessor* pObjectPreprocessor = ObjectPreprocessor::GetStaticInstance();
+    if( !pObjectPreprocessor )
+    {
+        HELIUM_TRACE( TraceLevels::Error, TXT( "BatchCooker::Run(): Missing ObjectPreprocessor instance.\n" ) );
+
+        return false;
+    }
+
+    HELIUM_ASSERT( GameObjectLoader::GetStaticInstance() );
+
+    uint64_t startTickCount = Timer::GetTickCount();
+
+    DynamicArray< GameObjectPath > packagePaths;
+    if( !FindPackages( packagePaths ) )
+    {
+        return false;
+    }
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "BatchCooker: Cooking %" ) TPRIuSZ TXT( " packages.\n" ),
+        packagePaths.GetSize() );
+
+    m_statistics.Resize( 0 );
+    DynamicArray< ObjectPreprocessor::BatchStatistics > batchStatistics;
+
+    // Load all objects, queueing any out-of-date resources, then preprocess and cache them in a single batch.
+    pObjectPreprocessor->BeginBatch();
+    LoadPackageObjects( packagePaths );
+    bool bSuccess = pObjectPreprocessor->EndBatch( &batchStatistics );
+    AddStatistics( batchStatistics );
+
+    // Shader variants are generated from the user options of their shaders, which are only available once the shaders
+    // have been preprocessed.
+    pObjectPreprocessor->BeginBatch();
+    LoadShaderVariants();
+    bSuccess &= pObjectPreprocessor->EndBatch( &batchStatistics );
+    AddStatistics( batchStatistics );
+
+    if( !pObjectPreprocessor->GetDependencyDatabase().Save() )
+    {
+        HELIUM_TRACE( TraceLevels::Error, TXT( "BatchCooker::Run(): Failed to save the dependency database.\n" ) );
+
+        bSuccess = false;
+    }
+
+    ReportStatistics( Timer::GetTickCount() - startTickCount );
+
+    m_shaderVariants.Clear();
+    m_objects.Clear();
+
+    return bSuccess;
+}
+
+/// Find all packages in the data directory.
+///
+/// Each directory below the data directory containing at least one file is treated as a package.
+///
+/// @param[out] rPackagePaths  Paths of the packages found.
+///
+/// @return  True if the data directory was searched successfully, false if not.
+bool BatchCooker::FindPackages( DynamicArray< GameObjectPath >& rPackagePaths ) const
+{
+    rPackagePaths.Resize( 0 );
+
+    FilePath dataDirectory;
+    if( !FileLocations::GetDataDirectory( dataDirectory ) )
+    {
+        HELIUM_TRACE( TraceLevels::Error, TXT( "BatchCooker::FindPackages(): Could not get data directory.\n" ) );
+
+        return false;
+    }
+
+    const tstring& rDataDirectoryString = dataDirectory.Get();
+    size_t dataDirectoryLength = rDataDirectoryString.length();
+
+    std::set< FilePath > files;
+    DirectoryIterator directoryIterator( dataDirectory );
+    directoryIterator.GetFiles( files, true );
+
+    // Gather the unique package directories relative to the data directory.
+    std::set< tstring > packageDirectories;
+    std::set< FilePath >::const_iterator fileEnd = files.end();
+    for( std::set< FilePath >::const_iterator fileIterator = files.begin(); fileIterator != fileEnd; ++fileIterator )
+    {
+        tstring directory = fileIterator->Directory();
+        if( directory.length() <= dataDirectoryLength ||
+            directory.compare( 0, dataDirectoryLength, rDataDirectoryString ) != 0 )
+        {
+            continue;
+        }
+
+        directory.erase( 0, dataDirectoryLength );
+        while( !directory.empty() && ( directory[ directory.length() - 1 ] == TXT( '/' ) ||
+                                       directory[ directory.length() - 1 ] == TXT( '\\' ) ) )
+        {
+            directory.erase( directory.length() - 1 );
+        }
+
+        if( !directory.empty() )
+        {
+            packageDirectories.insert( directory );
+        }
+    }
+
+    for( std::set< tstring >::const_iterator packageIterator = packageDirectories.begin();
+        packageIterator != packageDirectories.end();
+        ++packageIterator )
+    {
+        String pathString( TXT( "/" ) );
+        pathString += packageIterator->c_str();
+
+        size_t pathLength = pathString.GetSize();
+        for( size_t characterIndex = 0; characterIndex < pathLength; ++characterIndex )
+        {
+            if( pathString[ characterIndex ] == TXT( '\\' ) )
+            {
+                pathString[ characterIndex ] = TXT( '/' );
+            }
+        }
+
+        GameObjectPath packagePath;
+        if( !packagePath.Set( pathString ) )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Warning,
+                TXT( "BatchCooker::FindPackages(): Skipping directory \"%s\" (not a valid package path).\n" ),
+                *pathString );
+
+            continue;
+        }
+
+        rPackagePaths.Push( packagePath );
+    }
+
+    return true;
+}
+
+/// Load the given packages and all objects within them.
+///
+/// @param[in] rPackagePaths  Paths of the packages to load.
+void BatchCooker::LoadPackageObjects( const DynamicArray< GameObjectPath >& rPackagePaths )
+{
+    GameObjectLoader* pObjectLoader = GameObjectLoader::GetStaticInstance();
+    HELIUM_ASSERT( pObjectLoader );
+
+    // Load the package objects first so that their contents can be enumerated.
+    size_t packageCount = rPackagePaths.GetSize();
+
+    DynamicArray< size_t > loadIds;
+    loadIds.Reserve( packageCount );
+    for( size_t packageIndex = 0; packageIndex < packageCount; ++packageIndex )
+    {
+        loadIds.Push( pObjectLoader->BeginLoadObject( rPackagePaths[ packageIndex ] ) );
+    }
+
+    DynamicArray< GameObjectPath > objectPaths;
+
+    for( size_t packageIndex = 0; packageIndex < packageCount; ++packageIndex )
+    {
+        GameObjectPath packagePath = rPackagePaths[ packageIndex ];
+
+        size_t loadId = loadIds[ packageIndex ];
+        if( IsInvalid( loadId ) )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                TXT( "BatchCooker: Failed to begin loading package \"%s\".\n" ),
+                *packagePath.ToString() );
+
+            continue;
+        }
+
+        GameObjectPtr spPackage;
+        while( !pObjectLoader->TryFinishLoad( loadId, spPackage ) )
+        {
+            pObjectLoader->Tick();
+        }
+
+        PackageLoader* pPackageLoader = ( spPackage ? pObjectLoader->FindPackageLoader( packagePath ) : NULL );
+        if( !pPackageLoader )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                TXT( "BatchCooker: Failed to load package \"%s\".\n" ),
+                *packagePath.ToString() );
+
+            continue;
+        }
+
+        m_objects.Push( spPackage );
+
+        size_t objectCount = pPackageLoader->GetObjectCount();
+        for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+        {
+            GameObjectPath objectPath = pPackageLoader->GetObjectPath( objectIndex );
+            if( !objectPath.IsPackage() )
+            {
+                objectPaths.Push( objectPath );
+            }
+        }
+    }
+
+    // Load all objects in the packages at once, letting the loader work on as many as possible in parallel.
+    size_t objectCount = objectPaths.GetSize();
+
+    loadIds.Resize( 0 );
+    loadIds.Reserve( objectCount );
+    for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    {
+        loadIds.Push( pObjectLoader->BeginLoadObject( objectPaths[ objectIndex ] ) );
+    }
+
+    for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    {
+        size_t loadId = loadIds[ objectIndex ];
+        if( IsInvalid( loadId ) )
+        {
+            continue;
+        }
+
+        GameObjectPtr spObject;
+        while( !pObjectLoader->TryFinishLoad( loadId, spObject ) )
+        {
+            pObjectLoader->Tick();
+        }
+
+        if( !spObject )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                TXT( "BatchCooker: Failed to load object \"%s\".\n" ),
+                *objectPaths[ objectIndex ].ToString() );
+
+            continue;
+        }
+
+        m_objects.Push( spObject );
+    }
+}
+
+/// Load all user option variants of each loaded shader.
+void BatchCooker::LoadShaderVariants()
+{
+    DynamicArray< size_t > loadIds;
+    DynamicArray< Shader* > loadShaders;
+
+    size_t objectCount = m_objects.GetSize();
+    for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    {
+        Shader* pShader = Reflect::SafeCast< Shader >( m_objects[ objectIndex ].Get() );
+        if( !pShader || pShader->IsDefaultTemplate() )
+        {
+            continue;
+        }
+
+        const Shader::Options& rUserOptions = pShader->GetUserOptions();
+
+        for( size_t shaderTypeIndex = 0; shaderTypeIndex < RShader::TYPE_MAX; ++shaderTypeIndex )
+        {
+            RShader::EType shaderType = static_cast< RShader::EType >( shaderTypeIndex );
+
+            size_t variantCount = rUserOptions.ComputeOptionSetCount( shaderType );
+            HELIUM_ASSERT( variantCount <= UINT32_MAX );
+            for( size_t variantIndex = 0; variantIndex < variantCount; ++variantIndex )
+            {
+                size_t loadId = pShader->BeginLoadVariant( shaderType, static_cast< uint32_t >( variantIndex ) );
+                if( IsValid( loadId ) )
+                {
+                    loadIds.Push( loadId );
+                    loadShaders.Push( pShader );
+                }
+            }
+        }
+    }
+
+    size_t loadCount = loadIds.GetSize();
+    for( size_t loadIndex = 0; loadIndex < loadCount; ++loadIndex )
+    {
+        ShaderVariantPtr spVariant;
+        while( !loadShaders[ loadIndex ]->TryFinishLoadVariant( loadIds[ loadIndex ], spVariant ) )
+        {
+            Thread::Yield();
+        }
+
+        if( spVariant )
+        {
+            m_shaderVariants.Push( spVariant );
+        }
+    }
+}
+
+/// Accumulate the preprocessing statistics from a batch.
+///
+/// @param[in] rStatistics  Statistics for each resource handler used in the batch.
+void BatchCooker::AddStatistics( const DynamicArray< ObjectPreprocessor::BatchStatistics >& rStatistics )
+{
+    size_t statisticsCount = rStatistics.GetSize();
+    for( size_t statisticsIndex = 0; statisticsIndex < statisticsCount; ++statisticsIndex )
+    {
+        const ObjectPreprocessor::BatchStatistics& rBatchStatistics = rStatistics[ statisticsIndex ];
+
+        size_t totalCount = m_statistics.GetSize();
+        size_t totalIndex;
+        for( totalIndex = 0; totalIndex < totalCount; ++totalIndex )
+        {
+            if( m_statistics[ totalIndex ].pHandler == rBatchStatistics.pHandler )
+            {
+                break;
+            }
+        }
+
+        if( totalIndex >= totalCount )
+        {
+            m_statistics.Push( rBatchStatistics );
+
+            continue;
+        }
+
+        ObjectPreprocessor::BatchStatistics& rTotalStatistics = m_statistics[ totalIndex ];
+        rTotalStatistics.resourceCount += rBatchStatistics.resourceCount;
+        rTotalStatistics.failureCount += rBatchStatistics.failureCount;
+        rTotalStatistics.busyTickCount += rBatchStatistics.busyTickCount;
+        rTotalStatistics.wallTickCount += rBatchStatistics.wallTickCount;
+    }
+}
+
+/// Report the preprocessing time and throughput of each resource handler.
+///
+/// @param[in] totalTickCount  Total time spent cooking, in ticks.
+void BatchCooker::ReportStatistics( uint64_t totalTickCount ) const
+{
+    float64_t secondsPerTick = Timer::GetSecondsPerTick();
+
+    size_t totalResourceCount = 0;
+    size_t totalFailureCount = 0;
+
+    size_t statisticsCount = m_statistics.GetSize();
+    for( size_t statisticsIndex = 0; statisticsIndex < statisticsCount; ++statisticsIndex )
+    {
+        const ObjectPreprocessor::BatchStatistics& rStatistics = m_statistics[ statisticsIndex ];
+        HELIUM_ASSERT( rStatistics.pHandler );
+
+        const GameObjectType* pResourceType = rStatistics.pHandler->GetResourceType();
+        HELIUM_ASSERT( pResourceType );
+
+        float64_t busySeconds = static_cast< float64_t >( rStatistics.busyTickCount ) * secondsPerTick;
+        float64_t wallSeconds = static_cast< float64_t >( rStatistics.wallTickCount ) * secondsPerTick;
+        float64_t throughput =
+            ( wallSeconds > 0.0 ? static_cast< float64_t >( rStatistics.resourceCount ) / wallSeconds : 0.0 );
+
+        HELIUM_TRACE(
+            TraceLevels::Info,
+            ( TXT( "BatchCooker: %s: %" ) TPRIuSZ TXT( " resources (%" ) TPRIuSZ TXT( " failed), %.3f sec wall, " )
+            TXT( "%.3f sec busy, %.2f resources/sec.\n" ) ),
+            *pResourceType->GetName(),
+            rStatistics.resourceCount,
+            rStatistics.failureCount,
+            wallSeconds,
+            busySeconds,
+            throughput );
+
+        totalResourceCount += rStatistics.resourceCount;
+        totalFailureCount += rStatistics.failureCount;
+    }
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        ( TXT( "BatchCooker: Preprocessed %" ) TPRIuSZ TXT( " resources (%" ) TPRIuSZ TXT( " failed) in %.3f " )
+        TXT( "sec.\n" ) ),
+        totalResourceCount,
+        totalFailureCount,
+        static_cast< float64_t >( totalTickCount ) * secondsPerTick );
+}
+
+#endif  // HELIUM_TOOLS
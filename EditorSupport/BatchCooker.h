@@ -0,0 +1,67 @@
+//----------------------------------------------------------------------------------------------------------------------
+// BatchCooker.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_EDITOR_SUPPORT_BATCH_COOKER_H
+#define HELIUM_EDITOR_SUPPORT_BATCH_COOKER_H
+
+#include "EditorSupport/EditorSupport.h"
+
+#if HELIUM_TOOLS
+
+#include "Engine/GameObject.h"
+#include "Graphics/Shader.h"
+#include "PcSupport/ObjectPreprocessor.h"
+
+namespace Helium
+{
+    /// Headless cooker for preprocessing and caching all resources under the data directory.
+    ///
+    /// The batch cooker loads every package found in the data directory along with all of the objects in each
+    /// package, letting the object preprocessor queue each out-of-date resource and preprocess the entire batch in
+    /// parallel once everything has been loaded.  Shader variants can only be determined once their shaders have been
+    /// preprocessed, so all user option variants of each loaded shader are cooked in a second batch.  Preprocessing
+    /// time and throughput for each resource handler are reported once cooking is complete.
+    ///
+    /// The object loader and object preprocessor must both be initialized prior to running the cooker.
+    class HELIUM_EDITOR_SUPPORT_API BatchCooker : NonCopyable
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        BatchCooker();
+        ~BatchCooker();
+        //@}
+
+        /// @name Cooking
+        //@{
+        bool Run();
+        //@}
+
+    private:
+        /// Objects loaded for cooking (held until cooking has completed).
+        DynamicArray< GameObjectPtr > m_objects;
+        /// Shader variants loaded for cooking (held until cooking has completed).
+        DynamicArray< ShaderVariantPtr > m_shaderVariants;
+
+        /// Preprocessing statistics for each resource handler used, accumulated across all batches.
+        DynamicArray< ObjectPreprocessor::BatchStatistics > m_statistics;
+
+        /// @name Private Utility Functions
+        //@{
+        bool FindPackages( DynamicArray< GameObjectPath >& rPackagePaths ) const;
+        void LoadPackageObjects( const DynamicArray< GameObjectPath >& rPackagePaths );
+        void LoadShaderVariants();
+        void AddStatistics( const DynamicArray< ObjectPreprocessor::BatchStatistics >& rStatistics );
+        void ReportStatistics( uint64_t totalTickCount ) const;
+        //@}
+    };
+}
+
+#endif  // HELIUM_TOOLS
+
+#endif  // HELIUM_EDITOR_SUPPORT_BATCH_COOKER_H
@@ -148,6 +148,12 @@ const GameObjectType* FontResourceHandler::GetResourceType() const
     return Font::GetStaticType();
 }
 
+/// @copydoc ResourceHandler::GetVersion()
+uint32_t FontResourceHandler::GetVersion() const
+{
+    return VERSION;
+}
+
 /// @copydoc ResourceHandler::GetSourceExtensions()
 void FontResourceHandler::GetSourceExtensions( const tchar_t* const*& rppExtensions, size_t& rExtensionCount ) const
 {
@@ -523,7 +529,8 @@ bool FontResourceHandler::CacheResource(
         Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
             static_cast< Cache::EPlatform >( platformIndex ) );
         //rPreprocessedData.persistentDataBuffer = ;
-        SaveObjectToPersistentDataBuffer(&resource_data, rPreprocessedData.persistentDataBuffer);
+        SaveObjectToPersistentDataBuffer(
+            &resource_data, rPreprocessedData.persistentDataBuffer, static_cast< Cache::EPlatform >( platformIndex ) );
         rPreprocessedData.subDataBuffers = textureSheets;
         rPreprocessedData.bLoaded = true;
 
@@ -19,6 +19,9 @@ namespace Helium
         HELIUM_DECLARE_OBJECT( FontResourceHandler, ResourceHandler );
 
     public:
+        /// Version of the resource data produced by this handler (see GetVersion()).
+        static const uint32_t VERSION = 1;
+
         /// @name Construction/Destruction
         //@{
         FontResourceHandler();
@@ -28,6 +31,7 @@ namespace Helium
         /// @name Resource Handling Support
         //@{
         virtual const GameObjectType* GetResourceType() const;
+        virtual uint32_t GetVersion() const;
         virtual void GetSourceExtensions( const tchar_t* const*& rppExtensions, size_t& rExtensionCount ) const;
 
         virtual bool CacheResource(
@@ -7,6 +7,7 @@
 #include "Engine/BinaryDeserializer.h"
 #include "Engine/BinarySerializer.h"
 #include "Graphics/Material.h"
+#include "Graphics/Texture.h"
 #include "PcSupport/ObjectPreprocessor.h"
 #include "PcSupport/PlatformPreprocessor.h"
 
@@ -30,6 +31,12 @@ const GameObjectType* MaterialResourceHandler::GetResourceType() const
     return Material::GetStaticType();
 }
 
+/// @copydoc ResourceHandler::GetVersion()
+uint32_t MaterialResourceHandler::GetVersion() const
+{
+    return VERSION;
+}
+
 /// @copydoc ResourceHandler::CacheResource()
 bool MaterialResourceHandler::CacheResource(
     ObjectPreprocessor* pObjectPreprocessor,
@@ -42,6 +49,19 @@ bool MaterialResourceHandler::CacheResource(
     Material* pMaterial = Reflect::AssertCast< Material >( pResource );
     Shader* pShader = pMaterial->GetShader();
 
+    // The shader variant indices depend on the shader options, so the material needs to be preprocessed again whenever
+    // the shader changes.
+    pObjectPreprocessor->AddObjectDependency( pMaterial, pShader );
+
+    // Record the textures bound to the material parameters as well so that the material is preprocessed again when
+    // any of them change.
+    size_t textureParameterCount = pMaterial->GetTextureParameterCount();
+    for( size_t parameterIndex = 0; parameterIndex < textureParameterCount; ++parameterIndex )
+    {
+        const Material::TextureParameter& rParameter = pMaterial->GetTextureParameter( parameterIndex );
+        pObjectPreprocessor->AddObjectDependency( pMaterial, rParameter.value.Get() );
+    }
+
     // Compute the shader variant indices from the user options selected in the material, as the array of indices in
     // the material is not yet initialized.
     uint32_t shaderVariantIndices[ RShader::TYPE_MAX ];
@@ -283,4 +303,30 @@ bool MaterialResourceHandler::CacheResource(
     return true;
 }
 
+/// @copydoc ResourceHandler::SupportsConcurrentCaching()
+bool MaterialResourceHandler::SupportsConcurrentCaching() const
+{
+    return true;
+}
+
+/// @copydoc ResourceHandler::GetResourceDependencies()
+void MaterialResourceHandler::GetResourceDependencies(
+    Resource* pResource,
+    DynamicArray< GameObject* >& rDependencies ) const
+{
+    HELIUM_ASSERT( pResource );
+
+    // Shader variant indices are computed from the user options of the material shader.
+    Material* pMaterial = Reflect::AssertCast< Material >( pResource );
+    rDependencies.Push( pMaterial->GetShader() );
+
+    // Textures bound to the material parameters are recorded as cook dependencies of the material as well.
+    size_t textureParameterCount = pMaterial->GetTextureParameterCount();
+    for( size_t parameterIndex = 0; parameterIndex < textureParameterCount; ++parameterIndex )
+    {
+        const Material::TextureParameter& rParameter = pMaterial->GetTextureParameter( parameterIndex );
+        rDependencies.Push( rParameter.value.Get() );
+    }
+}
+
 #endif  // HELIUM_TOOLS
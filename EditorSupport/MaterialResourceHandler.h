@@ -23,6 +23,9 @@ namespace Helium
         HELIUM_DECLARE_OBJECT( MaterialResourceHandler, ResourceHandler );
 
     public:
+        /// Version of the resource data produced by this handler (see GetVersion()).
+        static const uint32_t VERSION = 1;
+
         /// @name Construction/Destruction
         //@{
         MaterialResourceHandler();
@@ -32,9 +35,12 @@ namespace Helium
         /// @name Resource Handling Support
         //@{
         virtual const GameObjectType* GetResourceType() const;
+        virtual uint32_t GetVersion() const;
 
         virtual bool CacheResource(
             ObjectPreprocessor* pObjectPreprocessor, Resource* pResource, const String& rSourceFilePath );
+        virtual bool SupportsConcurrentCaching() const;
+        virtual void GetResourceDependencies( Resource* pResource, DynamicArray< GameObject* >& rDependencies ) const;
         //@}
     };
 }
@@ -35,6 +35,12 @@ const GameObjectType* MeshResourceHandler::GetResourceType() const
     return Mesh::GetStaticType();
 }
 
+/// @copydoc ResourceHandler::GetVersion()
+uint32_t MeshResourceHandler::GetVersion() const
+{
+    return VERSION;
+}
+
 /// @copydoc ResourceHandler::GetSourceExtensions()
 void MeshResourceHandler::GetSourceExtensions( const tchar_t* const*& rppExtensions, size_t& rExtensionCount ) const
 {
@@ -141,7 +147,8 @@ bool MeshResourceHandler::CacheResource(
         rSubDataBuffers.Resize( 2 );
         rSubDataBuffers.Trim();
 
-        Cache::WriteCacheObjectToBuffer(persistentResourceData, rPreprocessedData.persistentDataBuffer);
+        SaveObjectToPersistentDataBuffer(
+            &persistentResourceData, rPreprocessedData.persistentDataBuffer, static_cast< Cache::EPlatform >( platformIndex ) );
 
         // Serialize the vertex buffer.  If the mesh is a skinned mesh, the vertices will need to be converted to
         // and serialized as an array of SkinnedMeshVertex structs.
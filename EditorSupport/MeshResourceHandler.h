@@ -27,6 +27,9 @@ namespace Helium
         HELIUM_DECLARE_OBJECT( MeshResourceHandler, ResourceHandler );
 
     public:
+        /// Version of the resource data produced by this handler (see GetVersion()).
+        static const uint32_t VERSION = 1;
+
         /// @name Construction/Destruction
         //@{
         MeshResourceHandler();
@@ -36,6 +39,7 @@ namespace Helium
         /// @name Resource Handling Support
         //@{
         virtual const GameObjectType* GetResourceType() const;
+        virtual uint32_t GetVersion() const;
         virtual void GetSourceExtensions( const tchar_t* const*& rppExtensions, size_t& rExtensionCount ) const;
 
         virtual bool CacheResource(
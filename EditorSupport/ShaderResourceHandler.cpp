@@ -33,6 +33,12 @@ const GameObjectType* ShaderResourceHandler::GetResourceType() const
     return Shader::GetStaticType();
 }
 
+/// @copydoc ResourceHandler::GetVersion()
+uint32_t ShaderResourceHandler::GetVersion() const
+{
+    return VERSION;
+}
+
 /// @copydoc ResourceHandler::GetSourceExtensions()
 void ShaderResourceHandler::GetSourceExtensions(
     const tchar_t* const*& rppExtensions,
@@ -159,7 +165,8 @@ bool ShaderResourceHandler::CacheResource(
 
         Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
             static_cast< Cache::EPlatform >( platformIndex ) );
-        SaveObjectToPersistentDataBuffer(&resourceData, rPreprocessedData.persistentDataBuffer);
+        SaveObjectToPersistentDataBuffer(
+            &resourceData, rPreprocessedData.persistentDataBuffer, static_cast< Cache::EPlatform >( platformIndex ) );
         rPreprocessedData.subDataBuffers.Resize( 0 );
         rPreprocessedData.bLoaded = true;
     }
@@ -169,6 +176,12 @@ bool ShaderResourceHandler::CacheResource(
     return true;
 }
 
+/// @copydoc ResourceHandler::SupportsConcurrentCaching()
+bool ShaderResourceHandler::SupportsConcurrentCaching() const
+{
+    return true;
+}
+
 /// Parse the given shader source line for toggle and select options.
 ///
 /// @param[in] shaderPath     GameObject path of the shader resource being preprocessed (used for logging purposes
@@ -44,6 +44,12 @@ const GameObjectType* ShaderVariantResourceHandler::GetResourceType() const
     return ShaderVariant::GetStaticType();
 }
 
+/// @copydoc ResourceHandler::GetVersion()
+uint32_t ShaderVariantResourceHandler::GetVersion() const
+{
+    return VERSION;
+}
+
 /// @copydoc ResourceHandler::CacheResource()
 bool ShaderVariantResourceHandler::CacheResource(
     ObjectPreprocessor* pObjectPreprocessor,
@@ -211,6 +217,20 @@ bool ShaderVariantResourceHandler::CacheResource(
 
     delete pSourceFileStream;
 
+    // Record the parent shader and all included files as dependencies so that the variant is compiled again if any
+    // of them change.
+    pObjectPreprocessor->AddObjectDependency( pVariant, pShader );
+
+    FilePath shaderDirectory;
+    shaderDirectory.Set( FilePath( rSourceFilePath.GetData() ).Directory() );
+    AddIncludeDependencies(
+        pObjectPreprocessor,
+        pVariant,
+        shaderDirectory,
+        static_cast< const char* >( pShaderSource ),
+        size,
+        0 );
+
     // Compile each variant of system options for each shader profile in each supported target platform.
     const Shader::Options& rSystemOptions = pShader->GetSystemOptions();
     size_t systemOptionSetCount = rSystemOptions.ComputeOptionSetCount( shaderType );
@@ -245,7 +265,8 @@ bool ShaderVariantResourceHandler::CacheResource(
         
         ShaderVariant::PersistentResourceData persistentResourceData;
         persistentResourceData.m_resourceCount = systemOptionSetCount32;
-        SaveObjectToPersistentDataBuffer(&persistentResourceData, rPreprocessedData.persistentDataBuffer);
+        SaveObjectToPersistentDataBuffer(
+            &persistentResourceData, rPreprocessedData.persistentDataBuffer, static_cast< Cache::EPlatform >( platformIndex ) );
 
         size_t shaderProfileCount = pPreprocessor->GetShaderProfileCount();
         size_t shaderCount = shaderProfileCount * systemOptionSetCount;
@@ -344,7 +365,10 @@ bool ShaderVariantResourceHandler::CacheResource(
                 DynamicArray< uint8_t >& rPcSm4SubDataBuffer =
                     rPcSubDataBuffers[ ShaderProfile::PC_SM4 * systemOptionSetCount + systemOptionSetIndex ];
 
-                Cache::WriteCacheObjectToBuffer(csd_pc_sm4, rPcSm4SubDataBuffer);
+                Cache::WriteCacheObjectToBuffer(
+                    csd_pc_sm4,
+                    rPcSm4SubDataBuffer,
+                    GetResourcePayloadFormat( pVariant, Cache::PLATFORM_PC ) );
                 
                 // FOR EACH PLATFORM
                 for( size_t platformIndex = 0;
@@ -408,7 +432,10 @@ bool ShaderVariantResourceHandler::CacheResource(
 
                         DynamicArray< uint8_t >& rTargetSubDataBuffer =
                             rSubDataBuffers[ shaderProfileIndex * systemOptionSetCount + systemOptionSetIndex ];
-                        Cache::WriteCacheObjectToBuffer(csd, rTargetSubDataBuffer);
+                        Cache::WriteCacheObjectToBuffer(
+                            csd,
+                            rTargetSubDataBuffer,
+                            GetResourcePayloadFormat( pVariant, static_cast< Cache::EPlatform >( platformIndex ) ) );
                     }
                 }
             }
@@ -423,6 +450,23 @@ bool ShaderVariantResourceHandler::CacheResource(
     return true;
 }
 
+/// @copydoc ResourceHandler::SupportsConcurrentCaching()
+bool ShaderVariantResourceHandler::SupportsConcurrentCaching() const
+{
+    return true;
+}
+
+/// @copydoc ResourceHandler::GetResourceDependencies()
+void ShaderVariantResourceHandler::GetResourceDependencies(
+    Resource* pResource,
+    DynamicArray< GameObject* >& rDependencies ) const
+{
+    HELIUM_ASSERT( pResource );
+
+    // Variants are compiled using the user options parsed from the source of their owning shader.
+    rDependencies.Push( pResource->GetOwner() );
+}
+
 /// Begin asynchronous loading of a shader variant.
 ///
 /// @param[in] pShader          Parent shader resource.
@@ -501,29 +545,22 @@ size_t ShaderVariantResourceHandler::BeginLoadVariant(
         }
     }
 
-    // If we have an object for the shader variant, attempt to load its resource data.
+    // If we have an object for the shader variant, attempt to load its resource data.  If preprocessing of the variant
+    // is deferred to the end of a batch (or fails), no resource data is available to deserialize, so the variant is
+    // returned without being precached and will be precached by the first load request made once it is available.
+    pLoadRequest->bPrecaching = false;
+
     ShaderVariant* pVariant = pLoadRequest->spVariant;
     if( pVariant && !pVariant->GetAnyFlagSet( GameObject::FLAG_PRECACHED ) )
     {
-        GameObject* pPackageObject;
-        for( pPackageObject = pShader->GetOwner();
-            pPackageObject != NULL && !pPackageObject->IsPackage();
-            pPackageObject = pPackageObject->GetOwner() )
-        {
-            // This space intentionally left blank...
-        }
-
-        HELIUM_ASSERT( pPackageObject );
-
-        PackageLoader* pPackageLoader = Reflect::AssertCast< Package >( pPackageObject )->GetLoader();
-        HELIUM_ASSERT( pPackageLoader );
-        HELIUM_ASSERT( pPackageLoader->IsSourcePackageFile() );
-
         ObjectPreprocessor* pObjectPreprocessor = ObjectPreprocessor::GetStaticInstance();
         HELIUM_ASSERT( pObjectPreprocessor );
 
-        pObjectPreprocessor->LoadResourceData( pVariant, pPackageLoader->GetFileTimestamp() );
+        pLoadRequest->bPrecaching = pObjectPreprocessor->LoadResourceData( pVariant );
+    }
 
+    if( pLoadRequest->bPrecaching )
+    {
         // Resource data loaded, so deserialize the persistent data for the current platform and begin precaching.
         CacheManager& rCacheManager = CacheManager::GetStaticInstance();
         const Resource::PreprocessedData& rPreprocessedData = pVariant->GetPreprocessedData(
@@ -569,13 +606,17 @@ bool ShaderVariantResourceHandler::TryFinishLoadVariant( size_t loadId, ShaderVa
 
     // Check if the load request has completed.
     ShaderVariant* pVariant = pLoadRequest->spVariant;
-    if( pVariant && !pVariant->GetAnyFlagSet( GameObject::FLAG_PRECACHED ) )
+    if( pLoadRequest->bPrecaching )
     {
+        HELIUM_ASSERT( pVariant );
+
         if( !pVariant->TryFinishPrecacheResourceData() )
         {
             return false;
         }
 
+        pLoadRequest->bPrecaching = false;
+
         pVariant->SetFlags( GameObject::FLAG_PRELOADED | GameObject::FLAG_LINKED | GameObject::FLAG_PRECACHED );
         pVariant->ConditionalFinalizeLoad();
 
@@ -756,6 +797,127 @@ bool ShaderVariantResourceHandler::CompileShader(
     return bCompileResult;
 }
 
+/// Record the files included by the given shader source as cook dependencies of a shader variant.
+///
+/// Include files are resolved relative to the directory of the shader source file, matching the include handling
+/// used when compiling shaders, and are scanned recursively for nested includes.
+///
+/// @param[in] pObjectPreprocessor  Object preprocessor with which to record dependencies.
+/// @param[in] pVariant             Shader variant being preprocessed.
+/// @param[in] rShaderDirectory     Directory containing the shader source file.
+/// @param[in] pShaderSourceData    Shader source data to scan.
+/// @param[in] shaderSourceSize     Size of the shader source data, in bytes.
+/// @param[in] depth                Current include nesting depth.
+void ShaderVariantResourceHandler::AddIncludeDependencies(
+    ObjectPreprocessor* pObjectPreprocessor,
+    ShaderVariant* pVariant,
+    const FilePath& rShaderDirectory,
+    const char* pShaderSourceData,
+    size_t shaderSourceSize,
+    size_t depth )
+{
+    HELIUM_ASSERT( pObjectPreprocessor );
+    HELIUM_ASSERT( pVariant );
+    HELIUM_ASSERT( pShaderSourceData || shaderSourceSize == 0 );
+
+    if( depth >= INCLUDE_DEPTH_MAX )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            ( TXT( "ShaderVariantResourceHandler: Maximum include depth exceeded while scanning dependencies of " )
+            TXT( "\"%s\".\n" ) ),
+            *pVariant->GetPath().ToString() );
+
+        return;
+    }
+
+    const char includeDirective[] = "#include";
+    const size_t includeDirectiveLength = HELIUM_ARRAY_COUNT( includeDirective ) - 1;
+
+    const char* pSourceEnd = pShaderSourceData + shaderSourceSize;
+    for( const char* pLineStart = pShaderSourceData; pLineStart < pSourceEnd; )
+    {
+        const char* pLineEnd = pLineStart;
+        while( pLineEnd < pSourceEnd && *pLineEnd != '\n' )
+        {
+            ++pLineEnd;
+        }
+
+        // Skip leading whitespace and check for an include directive.
+        const char* pCharacter = pLineStart;
+        while( pCharacter < pLineEnd && ( *pCharacter == ' ' || *pCharacter == '\t' ) )
+        {
+            ++pCharacter;
+        }
+
+        pLineStart = pLineEnd + 1;
+
+        if( static_cast< size_t >( pLineEnd - pCharacter ) <= includeDirectiveLength ||
+            CompareString( pCharacter, includeDirective, includeDirectiveLength ) != 0 )
+        {
+            continue;
+        }
+
+        pCharacter += includeDirectiveLength;
+        while( pCharacter < pLineEnd && ( *pCharacter == ' ' || *pCharacter == '\t' ) )
+        {
+            ++pCharacter;
+        }
+
+        if( pCharacter >= pLineEnd || ( *pCharacter != '"' && *pCharacter != '<' ) )
+        {
+            continue;
+        }
+
+        char terminator = ( *pCharacter == '"' ? '"' : '>' );
+        const char* pNameStart = ++pCharacter;
+        while( pCharacter < pLineEnd && *pCharacter != terminator )
+        {
+            ++pCharacter;
+        }
+
+        if( pCharacter >= pLineEnd || pCharacter == pNameStart )
+        {
+            continue;
+        }
+
+        // Build the path to the include file and record it as a dependency.
+        CharString includeName( pNameStart, static_cast< size_t >( pCharacter - pNameStart ) );
+        String fileName;
+        HELIUM_VERIFY( ( StringConverter< char, tchar_t >::Convert( fileName, includeName ) ) );
+
+        FilePath includePath( rShaderDirectory + fileName.GetData() );
+        pObjectPreprocessor->AddFileDependency( pVariant, includePath.c_str() );
+
+        // Scan the include file for nested includes.
+        FileStream* pIncludeFileStream = FileStream::OpenFileStream( includePath.c_str(), FileStream::MODE_READ );
+        if( !pIncludeFileStream )
+        {
+            continue;
+        }
+
+        int64_t includeSize64 = pIncludeFileStream->GetSize();
+        if( includeSize64 > 0 && static_cast< uint64_t >( includeSize64 ) <= static_cast< size_t >( -1 ) )
+        {
+            size_t includeSize = static_cast< size_t >( includeSize64 );
+
+            DynamicArray< char > includeData;
+            includeData.Resize( includeSize );
+            includeSize = BufferedStream( pIncludeFileStream ).Read( includeData.GetData(), 1, includeSize );
+
+            AddIncludeDependencies(
+                pObjectPreprocessor,
+                pVariant,
+                rShaderDirectory,
+                includeData.GetData(),
+                includeSize,
+                depth + 1 );
+        }
+
+        delete pIncludeFileStream;
+    }
+}
+
 /// Compute a hash value for a shader variant load request.
 ///
 /// @param[in] pRequest  Load request.
@@ -20,14 +20,21 @@
 
 namespace Helium
 {
+    class FilePath;
+
     /// Resource handler for Shader resource types.
     class HELIUM_EDITOR_SUPPORT_API ShaderVariantResourceHandler : public ResourceHandler
     {
         HELIUM_DECLARE_OBJECT( ShaderVariantResourceHandler, ResourceHandler );
 
     public:
+        /// Version of the resource data produced by this handler (see GetVersion()).
+        static const uint32_t VERSION = 1;
+
         /// Load request pool block size.
         static const size_t LOAD_REQUEST_POOL_BLOCK_SIZE = 8;
+        /// Maximum depth of nested shader include files to follow when recording cook dependencies.
+        static const size_t INCLUDE_DEPTH_MAX = 16;
 
         /// @name Construction/Destruction
         //@{
@@ -38,9 +45,12 @@ namespace Helium
         /// @name Resource Handling Support
         //@{
         virtual const GameObjectType* GetResourceType() const;
+        virtual uint32_t GetVersion() const;
 
         virtual bool CacheResource(
             ObjectPreprocessor* pObjectPreprocessor, Resource* pResource, const String& rSourceFilePath );
+        virtual bool SupportsConcurrentCaching() const;
+        virtual void GetResourceDependencies( Resource* pResource, DynamicArray< GameObject* >& rDependencies ) const;
         //@}
 
     private:
@@ -56,6 +66,9 @@ namespace Helium
             ShaderVariantPtr spVariant;
             /// Load request count.
             volatile int32_t requestCount;
+            /// True while the variant is being precached, false once precaching completes or if it was never started
+            /// (the variant was already precached, or its preprocessing was deferred to the end of a batch).
+            bool bPrecaching;
         };
 
         /// Shader variant load request hasher.
@@ -106,6 +119,10 @@ namespace Helium
             size_t shaderProfileIndex, RShader::EType shaderType, const void* pShaderSourceData,
             size_t shaderSourceSize, const DynamicArray< PlatformPreprocessor::ShaderToken >& rTokens,
             DynamicArray< uint8_t >& rCompiledCodeBuffer );
+
+        static void AddIncludeDependencies(
+            ObjectPreprocessor* pObjectPreprocessor, ShaderVariant* pVariant, const FilePath& rShaderDirectory,
+            const char* pShaderSourceData, size_t shaderSourceSize, size_t depth );
         //@}
     };
 }
@@ -39,6 +39,12 @@ const GameObjectType* Texture2dResourceHandler::GetResourceType() const
     return Texture2d::GetStaticType();
 }
 
+/// @copydoc ResourceHandler::GetVersion()
+uint32_t Texture2dResourceHandler::GetVersion() const
+{
+    return VERSION;
+}
+
 /// @copydoc ResourceHandler::GetSourceExtensions()
 void Texture2dResourceHandler::GetSourceExtensions(
     const tchar_t* const*& rppExtensions,
@@ -339,4 +345,11 @@ bool Texture2dResourceHandler::CacheResource(
     return true;
 }
 
+/// @copydoc ResourceHandler::SupportsConcurrentCaching()
+bool Texture2dResourceHandler::SupportsConcurrentCaching() const
+{
+    // Image loading and compression only use state local to each CacheResource() call.
+    return true;
+}
+
 #endif  // HELIUM_TOOLS
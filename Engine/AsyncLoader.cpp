@@ -7,12 +7,25 @@
 using namespace Helium;
 
 AsyncLoader* AsyncLoader::sm_pInstance = NULL;
+bool AsyncLoader::sm_bIoUringAllowed = true;
+
+/// Backend names (see FindBackend()).
+static const tchar_t* const BACKEND_NAMES[] =
+{
+    TXT( "stream" ),
+    TXT( "positional" ),
+    TXT( "io_uring" )
+};
+
+HELIUM_COMPILE_ASSERT( HELIUM_ARRAY_COUNT( BACKEND_NAMES ) == AsyncLoader::BACKEND_MAX );
 
 /// Constructor.
 AsyncLoader::AsyncLoader()
-: m_requestPool( REQUEST_POOL_BLOCK_SIZE )
-, m_pThread( NULL )
-, m_pWorker( NULL )
+: m_wakeUpCondition( false, false )
+, m_pendingCounter( 0 )
+, m_stopCounter( 0 )
+, m_requestPool( REQUEST_POOL_BLOCK_SIZE )
+, m_backend( BACKEND_INVALID )
 {
 }
 
@@ -24,20 +37,85 @@ AsyncLoader::~AsyncLoader()
 
 /// Initialize the async loader.
 ///
+/// @param[in] workerCount  Number of load worker threads to start, or zero to use DEFAULT_WORKER_COUNT.  This is
+///                         clamped to FILE_STREAM_LIMIT so that each worker can keep at least one file open.  The
+///                         io_uring backend always uses a single submission thread and ignores this value.
+/// @param[in] backend      Backend to use for servicing load requests.  Backends that are not supported on the
+///                         current platform fall back to BACKEND_STREAM.
+///
 /// @return  True if initialization was sucessful, false if not.
 ///
 /// @see Shutdown()
-bool AsyncLoader::Initialize()
+bool AsyncLoader::Initialize( size_t workerCount, EBackend backend )
 {
+    HELIUM_ASSERT( static_cast< size_t >( backend ) < static_cast< size_t >( BACKEND_MAX ) );
+
     Shutdown();
 
-    // Start up the async loading thread.
-    m_pWorker = new LoadWorker;
-    HELIUM_ASSERT( m_pWorker );
+#if !HELIUM_OS_LINUX
+    if( backend != BACKEND_STREAM )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            TXT( "AsyncLoader::Initialize(): Requested backend is not supported on this platform, using file streams.\n" ) );
+        backend = BACKEND_STREAM;
+    }
+#endif
+
+    if( workerCount == 0 )
+    {
+        workerCount = DEFAULT_WORKER_COUNT;
+    }
+
+    workerCount = Min( workerCount, FILE_STREAM_LIMIT );
+
+    AtomicExchangeRelease( m_stopCounter, 0 );
 
-    m_pThread = new RunnableThread( m_pWorker, TXT( "Async loading" ) );
-    HELIUM_ASSERT( m_pThread );
-    HELIUM_VERIFY( m_pThread->Start() );
+#if HELIUM_OS_LINUX
+    if( backend == BACKEND_IO_URING )
+    {
+        LoadWorker* pWorker = ( sm_bIoUringAllowed ? CreateUringLoadWorker( this, FILE_STREAM_LIMIT ) : NULL );
+        if( pWorker )
+        {
+            m_workers.Push( pWorker );
+        }
+        else
+        {
+            HELIUM_TRACE(
+                TraceLevels::Warning,
+                TXT( "AsyncLoader::Initialize(): io_uring is not available, falling back to positional reads.\n" ) );
+            backend = BACKEND_POSITIONAL;
+        }
+    }
+#endif
+
+    if( m_workers.IsEmpty() )
+    {
+        // Split the open file budget evenly across all workers.
+        size_t fileLimit = FILE_STREAM_LIMIT / workerCount;
+        bool bPositional = ( backend == BACKEND_POSITIONAL );
+
+        m_workers.Reserve( workerCount );
+        for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+        {
+            LoadWorker* pWorker = new StreamLoadWorker( this, fileLimit, bPositional );
+            HELIUM_ASSERT( pWorker );
+            m_workers.Push( pWorker );
+        }
+    }
+
+    m_backend = backend;
+
+    // Start up the async loading threads.
+    size_t startedWorkerCount = m_workers.GetSize();
+    m_threads.Reserve( startedWorkerCount );
+    for( size_t workerIndex = 0; workerIndex < startedWorkerCount; ++workerIndex )
+    {
+        RunnableThread* pThread = new RunnableThread( m_workers[ workerIndex ], TXT( "Async loading" ) );
+        HELIUM_ASSERT( pThread );
+        m_threads.Push( pThread );
+        HELIUM_VERIFY( pThread->Start() );
+    }
 
     return true;
 }
@@ -47,20 +125,33 @@ bool AsyncLoader::Initialize()
 /// @see Initialize()
 void AsyncLoader::Shutdown()
 {
-    if( m_pWorker )
+    if( !m_workers.IsEmpty() )
     {
-        m_pWorker->Stop();
+        // Each worker passes the wake-up signal along when it exits, so a single signal is enough to stop them all.
+        AtomicExchangeRelease( m_stopCounter, 1 );
+        m_wakeUpCondition.Signal();
     }
 
-    if( m_pThread )
+    size_t threadCount = m_threads.GetSize();
+    for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
     {
-        m_pThread->Join();
-        delete m_pThread;
-        m_pThread = NULL;
+        RunnableThread* pThread = m_threads[ threadIndex ];
+        HELIUM_ASSERT( pThread );
+        pThread->Join();
+        delete pThread;
     }
 
-    delete m_pWorker;
-    m_pWorker = NULL;
+    m_threads.Clear();
+
+    size_t workerCount = m_workers.GetSize();
+    for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+    {
+        delete m_workers[ workerIndex ];
+    }
+
+    m_workers.Clear();
+
+    m_backend = BACKEND_INVALID;
 }
 
 /// Queue an async load request.
@@ -84,8 +175,8 @@ size_t AsyncLoader::QueueRequest(
     HELIUM_ASSERT( pBuffer );
     HELIUM_ASSERT( static_cast< size_t >( priority ) < static_cast< size_t >( PRIORITY_MAX ) );
 
-    // Make sure the load worker is running.
-    if( !m_pWorker )
+    // Make sure the load workers are running.
+    if( m_workers.IsEmpty() )
     {
         return Invalid< size_t >();
     }
@@ -102,7 +193,14 @@ size_t AsyncLoader::QueueRequest(
     pRequest->bytesRead = 0;
     AtomicExchangeRelease( pRequest->processedCounter, 0 );
 
-    m_pWorker->QueueRequest( pRequest );
+    {
+        // Prevent access to the load queues while an exclusive write lock is held.
+        ScopeReadLock nonExclusiveLock( m_writeLock );
+
+        AtomicIncrementAcquire( m_pendingCounter );
+        m_requestQueues[ priority ].push( pRequest );
+        m_wakeUpCondition.Signal();
+    }
 
     size_t requestIndex = m_requestPool.GetIndex( pRequest );
     HELIUM_ASSERT( IsValid( requestIndex ) );
@@ -175,20 +273,29 @@ bool AsyncLoader::TrySyncRequest( size_t id, size_t& rBytesRead )
 /// pending requests in order to free any associated resources.
 void AsyncLoader::Flush()
 {
-    if( m_pWorker )
-    {
-        m_pWorker->Flush();
-    }
+    WaitForPending();
 }
 
 /// Lock async loading for writing to files that may be in use.
 ///
+/// This flushes all pending requests and closes any file streams held open by the load workers, so files may be
+/// freely rewritten until Unlock() is called.
+///
 /// @see Unlock()
 void AsyncLoader::Lock()
 {
-    if( m_pWorker )
+    // Prevent other threads from queueing requests or writing out data while we have a write lock.
+    m_writeLock.LockWrite();
+
+    WaitForPending();
+
+    // All workers are now idle and cannot receive new requests, so it is safe to touch their file caches.
+    size_t workerCount = m_workers.GetSize();
+    for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
     {
-        m_pWorker->Lock();
+        LoadWorker* pWorker = m_workers[ workerIndex ];
+        HELIUM_ASSERT( pWorker );
+        pWorker->CloseFiles();
     }
 }
 
@@ -197,10 +304,69 @@ void AsyncLoader::Lock()
 /// @see Lock()
 void AsyncLoader::Unlock()
 {
-    if( m_pWorker )
+    m_writeLock.UnlockWrite();
+}
+
+/// Find the backend with the given name.
+///
+/// This is used to select the backend from the command line ("-asyncbackend <name>").
+///
+/// @param[in] pName  Backend name ("stream", "positional", or "io_uring").
+///
+/// @return  Backend with the given name, or BACKEND_INVALID if no backend exists with the given name.
+///
+/// @see GetBackendName()
+AsyncLoader::EBackend AsyncLoader::FindBackend( const tchar_t* pName )
+{
+    HELIUM_ASSERT( pName );
+
+    for( size_t backendIndex = 0; backendIndex < HELIUM_ARRAY_COUNT( BACKEND_NAMES ); ++backendIndex )
     {
-        m_pWorker->Unlock();
+        if( CompareString( pName, BACKEND_NAMES[ backendIndex ] ) == 0 )
+        {
+            return static_cast< EBackend >( backendIndex );
+        }
     }
+
+    return BACKEND_INVALID;
+}
+
+/// Get the name of a backend.
+///
+/// @param[in] backend  Backend.
+///
+/// @return  Backend name.
+///
+/// @see FindBackend()
+const tchar_t* AsyncLoader::GetBackendName( EBackend backend )
+{
+    HELIUM_ASSERT( static_cast< size_t >( backend ) < static_cast< size_t >( BACKEND_MAX ) );
+
+    return BACKEND_NAMES[ backend ];
+}
+
+/// Set whether BACKEND_IO_URING may use io_uring.
+///
+/// If io_uring is not allowed, initializing the loader with BACKEND_IO_URING falls back to BACKEND_POSITIONAL as if
+/// io_uring were not supported by the running kernel.  This only takes effect the next time the loader is
+/// initialized.
+///
+/// @param[in] bAllowed  True to allow the use of io_uring, false to disable it.
+///
+/// @see IsIoUringAllowed(), Initialize()
+void AsyncLoader::SetIoUringAllowed( bool bAllowed )
+{
+    sm_bIoUringAllowed = bAllowed;
+}
+
+/// Get whether BACKEND_IO_URING may use io_uring.
+///
+/// @return  True if io_uring may be used, false if BACKEND_IO_URING always falls back to BACKEND_POSITIONAL.
+///
+/// @see SetIoUringAllowed()
+bool AsyncLoader::IsIoUringAllowed()
+{
+    return sm_bIoUringAllowed;
 }
 
 /// Get the singleton AsyncLoader instance, creating it if necessary.
@@ -228,12 +394,43 @@ void AsyncLoader::DestroyStaticInstance()
     sm_pInstance = NULL;
 }
 
+/// Pop the next request from the highest-priority non-empty queue.
+///
+/// @param[out] rPriority  Priority of the queue from which the request was taken.
+///
+/// @return  Request popped from the queue, or null if all queues are empty.
+AsyncLoader::Request* AsyncLoader::PopRequest( EPriority& rPriority )
+{
+    for( int32_t priority = PRIORITY_LAST; priority >= PRIORITY_FIRST; --priority )
+    {
+        Request* pRequest;
+        if( m_requestQueues[ priority ].try_pop( pRequest ) )
+        {
+            rPriority = static_cast< EPriority >( priority );
+
+            return pRequest;
+        }
+    }
+
+    return NULL;
+}
+
+/// Block the current thread until all queued and in-progress requests have been processed.
+void AsyncLoader::WaitForPending()
+{
+    while( m_pendingCounter != 0 )
+    {
+        Thread::Yield();
+    }
+}
+
 /// Constructor.
-AsyncLoader::LoadWorker::LoadWorker()
-: m_wakeUpCondition( false, false )
-, m_stopCounter( 0 )
-, m_processingCounter( 0 )
+///
+/// @param[in] pLoader  Async loader that owns this worker.
+AsyncLoader::LoadWorker::LoadWorker( AsyncLoader* pLoader )
+: m_pLoader( pLoader )
 {
+    HELIUM_ASSERT( pLoader );
 }
 
 /// Destructor.
@@ -241,111 +438,372 @@ AsyncLoader::LoadWorker::~LoadWorker()
 {
 }
 
-/// Execute the async loading work.
-void AsyncLoader::LoadWorker::Run()
+/// Store the result of a load request and flag it as processed.
+///
+/// @param[in] pRequest   Request that has completed.
+/// @param[in] bytesRead  Number of bytes read, or an invalid index if the file could not be opened.
+void AsyncLoader::LoadWorker::CompleteRequest( Request* pRequest, size_t bytesRead )
+{
+    HELIUM_ASSERT( pRequest );
+
+    pRequest->bytesRead = bytesRead;
+
+    AtomicExchangeRelease( pRequest->processedCounter, 1 );
+    AtomicDecrementRelease( m_pLoader->m_pendingCounter );
+}
+
+/// Constructor.
+///
+/// @param[in] pLoader      Async loader that owns this worker.
+/// @param[in] fileLimit    Maximum number of files this worker may keep open at once.
+/// @param[in] bPositional  True to read using positional reads directly into request buffers, false to read through
+///                         file streams.
+AsyncLoader::StreamLoadWorker::StreamLoadWorker( AsyncLoader* pLoader, size_t fileLimit, bool bPositional )
+: LoadWorker( pLoader )
+, m_fileLimit( Max< size_t >( fileLimit, 1 ) )
+, m_useIndex( 0 )
+, m_bPositional( bPositional )
+, m_pCoalesceBuffer( NULL )
+{
+#if !HELIUM_OS_LINUX
+    HELIUM_ASSERT( !bPositional );
+#endif
+
+    m_files.Reserve( m_fileLimit );
+    m_batch.Reserve( COALESCE_BATCH_SIZE );
+}
+
+/// Destructor.
+AsyncLoader::StreamLoadWorker::~StreamLoadWorker()
 {
-    BufferedStream* pBufferedStream = new BufferedStream;
-    HELIUM_ASSERT( pBufferedStream );
+    CloseFiles();
+}
 
-    while( m_stopCounter == 0 )
+/// Execute the async loading work.
+void AsyncLoader::StreamLoadWorker::Run()
+{
+    // Positional reads scatter directly into the request buffers, so no staging buffer is needed.
+    if( !m_bPositional )
     {
-        AtomicExchangeAcquire( m_processingCounter, 1 );
+        m_pCoalesceBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( COALESCE_BUFFER_SIZE ) );
+        HELIUM_ASSERT( m_pCoalesceBuffer );
+    }
 
-        Request* pRequest;
-        if( !m_requestQueue.try_pop( pRequest ) )
+    while( m_pLoader->m_stopCounter == 0 )
+    {
+        if( !PopBatch() )
         {
-            // Queue is empty, so sleep until notified.
-            AtomicExchangeRelease( m_processingCounter, 0 );
-            m_wakeUpCondition.Wait();
+            // Queues are empty, so sleep until notified.
+            m_pLoader->m_wakeUpCondition.Wait();
 
             continue;
         }
 
-        HELIUM_ASSERT( pRequest );
+        ProcessBatch();
+    }
+
+    // Pass the stop signal along to the next sleeping worker.
+    m_pLoader->m_wakeUpCondition.Signal();
 
-        FileStream* pFileStream = FileStream::OpenFileStream( pRequest->fileName, FileStream::MODE_READ );
-        if( !pFileStream )
+    DefaultAllocator().Free( m_pCoalesceBuffer );
+    m_pCoalesceBuffer = NULL;
+}
+
+/// Close all files held open by this worker.
+///
+/// This must only be called while the worker is not processing requests (i.e. when the owning loader is shutting
+/// down or has flushed all requests under its write lock).
+void AsyncLoader::StreamLoadWorker::CloseFiles()
+{
+    size_t fileCount = m_files.GetSize();
+    for( size_t fileIndex = 0; fileIndex < fileCount; ++fileIndex )
+    {
+        CachedFile& rCachedFile = m_files[ fileIndex ];
+        delete rCachedFile.pStream;
+#if HELIUM_OS_LINUX
+        CloseFileDescriptor( rCachedFile.fileDescriptor );
+#endif
+    }
+
+    m_files.Clear();
+}
+
+/// Pull a batch of requests of the same priority level from the load queues.
+///
+/// @return  True if at least one request was retrieved, false if all queues were empty.
+bool AsyncLoader::StreamLoadWorker::PopBatch()
+{
+    m_batch.Resize( 0 );
+
+    EPriority priority;
+    Request* pRequest = m_pLoader->PopRequest( priority );
+    if( !pRequest )
+    {
+        return false;
+    }
+
+    m_batch.Push( pRequest );
+
+    // Grab any other requests already waiting at the same priority level so that requests on the same file can be
+    // coalesced.  Lower priority queues are left alone so that higher priority work is never held up behind them.
+    tbb::concurrent_queue< Request* >& rQueue = m_pLoader->m_requestQueues[ priority ];
+    while( m_batch.GetSize() < COALESCE_BATCH_SIZE && rQueue.try_pop( pRequest ) )
+    {
+        m_batch.Push( pRequest );
+    }
+
+    // Wake up another worker if there is still work left in the queues.
+    for( int32_t queueIndex = PRIORITY_FIRST; queueIndex < PRIORITY_MAX; ++queueIndex )
+    {
+        if( !m_pLoader->m_requestQueues[ queueIndex ].empty() )
         {
-            SetInvalid( pRequest->bytesRead );
+            m_pLoader->m_wakeUpCondition.Signal();
+
+            break;
         }
-        else
-        {
-            pRequest->bytesRead = 0;
+    }
+
+    return true;
+}
 
-            pBufferedStream->Open( pFileStream );
-            int64_t offset = pBufferedStream->Seek( pRequest->offset, SeekOrigins::SEEK_ORIGIN_BEGIN );
-            if( static_cast< uint64_t >( offset ) == pRequest->offset )
+/// Process the current request batch, grouping requests by file and reading each group in file offset order.
+void AsyncLoader::StreamLoadWorker::ProcessBatch()
+{
+    Request** ppRequests = m_batch.GetData();
+    size_t requestCount = m_batch.GetSize();
+
+    // Sort by file name, then offset (insertion sort, as batches are small).
+    for( size_t requestIndex = 1; requestIndex < requestCount; ++requestIndex )
+    {
+        Request* pRequest = ppRequests[ requestIndex ];
+        HELIUM_ASSERT( pRequest );
+
+        size_t insertIndex = requestIndex;
+        while( insertIndex > 0 )
+        {
+            Request* pPrevious = ppRequests[ insertIndex - 1 ];
+            int nameCompare = CompareString( *pPrevious->fileName, *pRequest->fileName );
+            if( nameCompare < 0 || ( nameCompare == 0 && pPrevious->offset <= pRequest->offset ) )
             {
-                pRequest->bytesRead = pBufferedStream->Read( pRequest->pBuffer, 1, pRequest->size );
+                break;
             }
 
-            pBufferedStream->Open( NULL );
+            ppRequests[ insertIndex ] = pPrevious;
+            --insertIndex;
+        }
+
+        ppRequests[ insertIndex ] = pRequest;
+    }
+
+    size_t runStart = 0;
+    while( runStart < requestCount )
+    {
+        const String& rFileName = ppRequests[ runStart ]->fileName;
 
-            delete pFileStream;
+        size_t runEnd = runStart + 1;
+        while( runEnd < requestCount && ppRequests[ runEnd ]->fileName == rFileName )
+        {
+            ++runEnd;
         }
 
-        AtomicExchangeRelease( pRequest->processedCounter, 1 );
+        ProcessRun( ppRequests + runStart, runEnd - runStart );
 
-        Thread::Yield();
+        runStart = runEnd;
     }
 
-    AtomicExchangeRelease( m_processingCounter, 0 );
-
-    delete pBufferedStream;
+    m_batch.Resize( 0 );
 }
 
-/// Request the load worker to stop processing and return at the next possible opportunity.
-void AsyncLoader::LoadWorker::Stop()
+/// Process a set of requests targeting the same file, sorted by offset.
+///
+/// @param[in] ppRequests    Requests to process.
+/// @param[in] requestCount  Number of requests to process.
+void AsyncLoader::StreamLoadWorker::ProcessRun( Request* const* ppRequests, size_t requestCount )
 {
-    AtomicExchangeRelease( m_stopCounter, 1 );
-    m_wakeUpCondition.Signal();
+    HELIUM_ASSERT( ppRequests );
+    HELIUM_ASSERT( requestCount != 0 );
+
+    CachedFile* pCachedFile = AcquireFile( ppRequests[ 0 ]->fileName );
+    if( !pCachedFile )
+    {
+        for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+        {
+            CompleteRequest( ppRequests[ requestIndex ], Invalid< size_t >() );
+        }
+
+        return;
+    }
+
+    size_t requestIndex = 0;
+    while( requestIndex < requestCount )
+    {
+        Request* pRequest = ppRequests[ requestIndex ];
+        HELIUM_ASSERT( pRequest );
+
+        // Find the extent of requests that are directly adjacent to each other.  Stream reads are additionally limited
+        // by the size of the staging buffer.
+        uint64_t spanStart = pRequest->offset;
+        uint64_t spanEnd = spanStart + pRequest->size;
+        size_t spanEndIndex = requestIndex + 1;
+        while( spanEndIndex < requestCount )
+        {
+            Request* pNext = ppRequests[ spanEndIndex ];
+            if( pNext->offset != spanEnd ||
+                ( !m_bPositional && spanEnd + pNext->size - spanStart > COALESCE_BUFFER_SIZE ) )
+            {
+                break;
+            }
+
+            spanEnd += pNext->size;
+            ++spanEndIndex;
+        }
+
+#if HELIUM_OS_LINUX
+        if( m_bPositional )
+        {
+            ProcessPositionalSpan( pCachedFile, ppRequests + requestIndex, spanEndIndex - requestIndex );
+            requestIndex = spanEndIndex;
+
+            continue;
+        }
+#endif
+
+        if( spanEndIndex - requestIndex < 2 )
+        {
+            // Nothing to coalesce with, so read straight into the request buffer.
+            CompleteRequest( pRequest, ReadDirect( pCachedFile, pRequest ) );
+            ++requestIndex;
+
+            continue;
+        }
+
+        // Read the full span in one go and scatter it to each request.
+        size_t spanBytesRead = 0;
+        FileStream* pStream = pCachedFile->pStream;
+        HELIUM_ASSERT( pStream );
+        if( pCachedFile->position == spanStart ||
+            static_cast< uint64_t >( pStream->Seek( spanStart, SeekOrigins::SEEK_ORIGIN_BEGIN ) ) == spanStart )
+        {
+            spanBytesRead = pStream->Read( m_pCoalesceBuffer, 1, static_cast< size_t >( spanEnd - spanStart ) );
+            pCachedFile->position = spanStart + spanBytesRead;
+        }
+        else
+        {
+            SetInvalid( pCachedFile->position );
+        }
+
+        for( ; requestIndex < spanEndIndex; ++requestIndex )
+        {
+            pRequest = ppRequests[ requestIndex ];
+            HELIUM_ASSERT( pRequest );
+
+            size_t spanOffset = static_cast< size_t >( pRequest->offset - spanStart );
+            size_t bytesRead = ( spanBytesRead > spanOffset ? Min( spanBytesRead - spanOffset, pRequest->size ) : 0 );
+            MemoryCopy( pRequest->pBuffer, m_pCoalesceBuffer + spanOffset, bytesRead );
+
+            CompleteRequest( pRequest, bytesRead );
+        }
+    }
 }
 
-/// Queue an async load request.
+/// Read the data for a single request directly into its output buffer.
 ///
-/// @param[in] pRequest  Request to queue.  Note that the @c processedCounter value should be set to 0 prior to
-///                      calling this function (the worker thread will set it to 1 once the request has been
-///                      processed).
+/// @param[in] pCachedFile  Cached file to read.
+/// @param[in] pRequest     Request to process.
 ///
-/// @see Flush()
-void AsyncLoader::LoadWorker::QueueRequest( Request* pRequest )
+/// @return  Number of bytes read.
+size_t AsyncLoader::StreamLoadWorker::ReadDirect( CachedFile* pCachedFile, Request* pRequest )
 {
+    HELIUM_ASSERT( pCachedFile );
     HELIUM_ASSERT( pRequest );
-    HELIUM_ASSERT( pRequest->processedCounter == 0 );
 
-    // Prevent access to the load queue while an exclusive write lock is held.
-    ScopeReadLock nonExclusiveLock( m_writeLock );
+    FileStream* pStream = pCachedFile->pStream;
+    HELIUM_ASSERT( pStream );
+
+    // Skip the seek if we are already at the requested offset (i.e. sequential reads of adjacent data).
+    if( pCachedFile->position != pRequest->offset )
+    {
+        int64_t offset = pStream->Seek( pRequest->offset, SeekOrigins::SEEK_ORIGIN_BEGIN );
+        if( static_cast< uint64_t >( offset ) != pRequest->offset )
+        {
+            SetInvalid( pCachedFile->position );
 
-    m_requestQueue.push( pRequest );
-    m_wakeUpCondition.Signal();
+            return 0;
+        }
+    }
+
+    size_t bytesRead = pStream->Read( pRequest->pBuffer, 1, pRequest->size );
+    pCachedFile->position = pRequest->offset + bytesRead;
+
+    return bytesRead;
 }
 
-/// Block the current thread until all pending load requests have completed.
+/// Get an open file for the given file name, opening it and evicting the least recently used file if necessary.
+///
+/// @param[in] rFileName  Name of the file to open.
 ///
-/// @see QueueRequest()
-void AsyncLoader::LoadWorker::Flush()
+/// @return  Cached file, or null if the file could not be opened.
+AsyncLoader::CachedFile* AsyncLoader::StreamLoadWorker::AcquireFile( const String& rFileName )
 {
-    while( m_processingCounter != 0 && !m_requestQueue.empty() )
+    ++m_useIndex;
+
+    size_t fileCount = m_files.GetSize();
+    size_t leastRecentIndex = 0;
+    for( size_t fileIndex = 0; fileIndex < fileCount; ++fileIndex )
     {
-        Thread::Yield();
+        CachedFile& rCachedFile = m_files[ fileIndex ];
+        if( rCachedFile.fileName == rFileName )
+        {
+            rCachedFile.lastUseIndex = m_useIndex;
+
+            return &rCachedFile;
+        }
+
+        if( rCachedFile.lastUseIndex < m_files[ leastRecentIndex ].lastUseIndex )
+        {
+            leastRecentIndex = fileIndex;
+        }
     }
-}
 
-/// Acquire an exclusive lock for writing to files and flush the async loader queue.
-///
-/// @see Unlock()
-void AsyncLoader::LoadWorker::Lock()
-{
-    // Prevent other threads from queueing requests or writing out data while we have a write lock.
-    m_writeLock.LockWrite();
+    FileStream* pStream = NULL;
+    int fileDescriptor = -1;
+#if HELIUM_OS_LINUX
+    if( m_bPositional )
+    {
+        fileDescriptor = OpenFileDescriptor( rFileName );
+        if( fileDescriptor < 0 )
+        {
+            return NULL;
+        }
+    }
+    else
+#endif
+    {
+        pStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_READ );
+        if( !pStream )
+        {
+            return NULL;
+        }
+    }
 
-    Flush();
-}
+    if( fileCount >= m_fileLimit )
+    {
+        CachedFile& rEvictedFile = m_files[ leastRecentIndex ];
+        delete rEvictedFile.pStream;
+#if HELIUM_OS_LINUX
+        CloseFileDescriptor( rEvictedFile.fileDescriptor );
+#endif
+        m_files.RemoveSwap( leastRecentIndex );
+    }
 
-/// Release an exclusive lock for writing to files.
-///
-/// @see Lock()
-void AsyncLoader::LoadWorker::Unlock()
-{
-    m_writeLock.UnlockWrite();
+    CachedFile* pCachedFile = m_files.New();
+    HELIUM_ASSERT( pCachedFile );
+    pCachedFile->fileName = rFileName;
+    pCachedFile->pStream = pStream;
+    pCachedFile->fileDescriptor = fileDescriptor;
+    pCachedFile->position = 0;
+    pCachedFile->lastUseIndex = m_useIndex;
+    pCachedFile->inFlightCount = 0;
+
+    return pCachedFile;
 }
@@ -14,6 +14,7 @@
 #include "Platform/Thread.h"
 
 #include "Foundation/String.h"
+#include "Foundation/DynamicArray.h"
 #include "Foundation/ObjectPool.h"
 
 #include "Engine/Engine.h"
@@ -31,7 +32,21 @@
 
 namespace Helium
 {
+    class FileStream;
+
     /// Async loading manager.
+    ///
+    /// Load requests are serviced by a pool of worker threads.  Each priority level has its own queue, and workers
+    /// always drain higher priority queues first.  Workers keep a small LRU cache of open file streams (bounded so that
+    /// the total across all workers respects FILE_STREAM_LIMIT), and adjacent requests on the same file are sorted by
+    /// offset and coalesced into a single read where possible.
+    ///
+    /// The backend used to perform reads is selected at initialization time.  BACKEND_STREAM reads through FileStream
+    /// and is available everywhere.  On Linux, BACKEND_POSITIONAL issues pread()/preadv() calls straight into the
+    /// request buffers, and BACKEND_IO_URING keeps up to IO_URING_QUEUE_DEPTH reads in flight through a single io_uring
+    /// instance (falling back to BACKEND_POSITIONAL if io_uring is not supported by the running kernel or has been
+    /// disabled through SetIoUringAllowed()).  Applications select the backend with the "-asyncbackend <name>"
+    /// command-line option (see FindBackend()).
     class HELIUM_ENGINE_API AsyncLoader : NonCopyable
     {
     public:
@@ -39,6 +54,14 @@ namespace Helium
         static const size_t REQUEST_POOL_BLOCK_SIZE = 128;
         /// Maximum number of open file streams.
         static const size_t FILE_STREAM_LIMIT = 16;
+        /// Default number of load worker threads.
+        static const size_t DEFAULT_WORKER_COUNT = 4;
+        /// Maximum number of requests a worker will pull from a single priority queue at once for coalescing.
+        static const size_t COALESCE_BATCH_SIZE = 32;
+        /// Size of the per-worker staging buffer used when coalescing adjacent small reads into one read.
+        static const size_t COALESCE_BUFFER_SIZE = 256 * 1024;
+        /// Maximum number of reads kept in flight by the io_uring backend.
+        static const size_t IO_URING_QUEUE_DEPTH = 64;
 
         /// Load request priority.
         enum EPriority
@@ -54,10 +77,39 @@ namespace Helium
             PRIORITY_LAST = PRIORITY_MAX - 1
         };
 
+        /// Load backend.
+        enum EBackend
+        {
+            BACKEND_FIRST   =  0,
+            BACKEND_INVALID = -1,
+
+            /// Buffered reads through FileStream.
+            BACKEND_STREAM,
+            /// Positional reads directly into request buffers (Linux only).
+            BACKEND_POSITIONAL,
+            /// Batched io_uring reads directly into request buffers (Linux only).
+            BACKEND_IO_URING,
+
+            BACKEND_MAX,
+            BACKEND_LAST = BACKEND_MAX - 1
+        };
+
         /// @name Initialization
         //@{
-        bool Initialize();
+        bool Initialize( size_t workerCount = 0, EBackend backend = BACKEND_STREAM );
         void Shutdown();
+
+        inline size_t GetWorkerCount() const;
+        inline EBackend GetBackend() const;
+        //@}
+
+        /// @name Backend Selection
+        //@{
+        static EBackend FindBackend( const tchar_t* pName );
+        static const tchar_t* GetBackendName( EBackend backend );
+
+        static void SetIoUringAllowed( bool bAllowed );
+        static bool IsIoUringAllowed();
         //@}
 
         /// @name Load Request Management
@@ -101,67 +153,148 @@ namespace Helium
             volatile int32_t processedCounter;
         };
 
-        /// Async loading thread runnable.
+        /// Open file cached by a load worker.
+        struct CachedFile
+        {
+            /// File name.
+            String fileName;
+            /// File stream (BACKEND_STREAM only).
+            FileStream* pStream;
+            /// Platform file descriptor (BACKEND_POSITIONAL and BACKEND_IO_URING only, -1 otherwise).
+            int fileDescriptor;
+            /// Current read position within the file stream.
+            uint64_t position;
+            /// Worker request count at the time this file was last used (for LRU eviction).
+            uint64_t lastUseIndex;
+            /// Number of reads currently in flight on this file (BACKEND_IO_URING only).
+            size_t inFlightCount;
+        };
+
+        /// Async loading thread runnable base.
         class LoadWorker : public Runnable
         {
         public:
             /// @name Construction/Destruction
             //@{
-            LoadWorker();
+            explicit LoadWorker( AsyncLoader* pLoader );
             virtual ~LoadWorker();
             //@}
 
-            /// @name Runnable Interface
+            /// @name File Cache
             //@{
-            virtual void Run();
+            virtual void CloseFiles() = 0;
             //@}
 
-            /// @name External Thread Control
+        protected:
+            /// Owning async loader.
+            AsyncLoader* m_pLoader;
+
+            /// @name Request Completion
             //@{
-            void Stop();
+            void CompleteRequest( Request* pRequest, size_t bytesRead );
             //@}
+        };
 
-            /// @name External Request Queue Control
+        /// Load worker performing blocking reads, either through file streams or positional reads.
+        class StreamLoadWorker : public LoadWorker
+        {
+        public:
+            /// @name Construction/Destruction
             //@{
-            void QueueRequest( Request* pRequest );
-            void Flush();
+            StreamLoadWorker( AsyncLoader* pLoader, size_t fileLimit, bool bPositional );
+            virtual ~StreamLoadWorker();
+            //@}
 
-            void Lock();
-            void Unlock();
+            /// @name Runnable Interface
+            //@{
+            virtual void Run();
+            //@}
+
+            /// @name File Cache
+            //@{
+            virtual void CloseFiles();
             //@}
 
         private:
-            /// Async load request queue.
-            tbb::concurrent_queue< Request* > m_requestQueue;
-            /// Condition used to wake up the worker thread when load requests are queued (or when it should shut down).
-            Condition m_wakeUpCondition;
-
-            /// Read-write lock used for synchronization of external file writes.
-            ReadWriteLock m_writeLock;
-
-            /// Non-zero if this thread should stop when next possible, zero if it should continue.
-            volatile int32_t m_stopCounter;
-            /// Non-zero if this thread is currently processing a load request.
-            volatile int32_t m_processingCounter;
+            /// Open files, most recently used files updated in place.
+            DynamicArray< CachedFile > m_files;
+            /// Maximum number of files this worker may keep open at once.
+            size_t m_fileLimit;
+            /// Running count of requests processed (used to track file use order).
+            uint64_t m_useIndex;
+            /// True to read using positional reads into request buffers, false to read through file streams.
+            bool m_bPositional;
+
+            /// Requests pulled from the queue for the current batch.
+            DynamicArray< Request* > m_batch;
+            /// Staging buffer for coalesced reads.
+            uint8_t* m_pCoalesceBuffer;
+
+            bool PopBatch();
+            void ProcessBatch();
+            void ProcessRun( Request* const* ppRequests, size_t requestCount );
+            size_t ReadDirect( CachedFile* pCachedFile, Request* pRequest );
+
+            CachedFile* AcquireFile( const String& rFileName );
+
+#if HELIUM_OS_LINUX
+            void ProcessPositionalSpan( CachedFile* pCachedFile, Request* const* ppRequests, size_t requestCount );
+#endif
         };
 
+        class UringLoadWorker;
+
+        /// Async load request queues, one per priority level.
+        tbb::concurrent_queue< Request* > m_requestQueues[ PRIORITY_MAX ];
+        /// Condition used to wake up worker threads when load requests are queued (or when they should shut down).
+        Condition m_wakeUpCondition;
+
+        /// Read-write lock used for synchronization of external file writes.
+        ReadWriteLock m_writeLock;
+
+        /// Number of requests queued or in progress.
+        volatile int32_t m_pendingCounter;
+        /// Non-zero if worker threads should stop when next possible, zero if they should continue.
+        volatile int32_t m_stopCounter;
+
         /// Pool of async load request objects.
         ObjectPool< Request > m_requestPool;
 
-        /// Async loading thread.
-        RunnableThread* m_pThread;
-        /// Async loading thread worker.
-        LoadWorker* m_pWorker;
+        /// Async loading threads.
+        DynamicArray< RunnableThread* > m_threads;
+        /// Async loading thread workers.
+        DynamicArray< LoadWorker* > m_workers;
+        /// Active load backend.
+        EBackend m_backend;
 
         /// Singleton instance.
         static AsyncLoader* sm_pInstance;
+        /// True if BACKEND_IO_URING may use io_uring, false to always fall back to BACKEND_POSITIONAL.
+        static bool sm_bIoUringAllowed;
 
         /// @name Construction/Destruction
         //@{
         AsyncLoader();
         ~AsyncLoader();
         //@}
+
+        /// @name Request Processing Support
+        //@{
+        Request* PopRequest( EPriority& rPriority );
+        void WaitForPending();
+        //@}
+
+#if HELIUM_OS_LINUX
+        /// @name Platform Support
+        //@{
+        static int OpenFileDescriptor( const String& rFileName );
+        static void CloseFileDescriptor( int fileDescriptor );
+        static LoadWorker* CreateUringLoadWorker( AsyncLoader* pLoader, size_t fileLimit );
+        //@}
+#endif
     };
 }
 
+#include "Engine/AsyncLoader.inl"
+
 #endif  // HELIUM_ENGINE_ASYNC_LOADER_H
@@ -0,0 +1,25 @@
+//----------------------------------------------------------------------------------------------------------------------
+// AsyncLoader.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get the number of worker threads servicing load requests.
+    ///
+    /// @return  Number of active load worker threads.
+    size_t AsyncLoader::GetWorkerCount() const
+    {
+        return m_workers.GetSize();
+    }
+
+    /// Get the backend used to service load requests.
+    ///
+    /// @return  Active load backend, or BACKEND_INVALID if the loader is not initialized.
+    AsyncLoader::EBackend AsyncLoader::GetBackend() const
+    {
+        return m_backend;
+    }
+}
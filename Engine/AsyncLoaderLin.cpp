@@ -0,0 +1,716 @@
+#include "EnginePch.h"
+#include "Engine/AsyncLoader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+using namespace Helium;
+
+/// Load worker submitting reads directly into request buffers through a single io_uring instance.
+///
+/// Rather than blocking on each read, this worker keeps up to IO_URING_QUEUE_DEPTH reads in flight at once and only
+/// sleeps on the loader wake-up condition when nothing is queued or in flight.  The ring is driven through the raw
+/// io_uring system calls so that no additional library dependency is required.
+class AsyncLoader::UringLoadWorker : public AsyncLoader::LoadWorker
+{
+public:
+    /// @name Construction/Destruction
+    //@{
+    UringLoadWorker( AsyncLoader* pLoader, size_t fileLimit );
+    virtual ~UringLoadWorker();
+    //@}
+
+    /// @name Initialization
+    //@{
+    bool Initialize();
+    //@}
+
+    /// @name Runnable Interface
+    //@{
+    virtual void Run();
+    //@}
+
+    /// @name File Cache
+    //@{
+    virtual void CloseFiles();
+    //@}
+
+private:
+    /// In-flight read slot.
+    struct Slot
+    {
+        /// Request being processed (null if this slot is free).
+        Request* pRequest;
+        /// File being read.
+        CachedFile* pCachedFile;
+        /// Read target for the remaining portion of the request.
+        struct iovec vector;
+        /// Number of bytes read so far.
+        size_t bytesRead;
+    };
+
+    /// io_uring file descriptor.
+    int m_ringDescriptor;
+
+    /// Submission queue ring mapping.
+    void* m_pSubmissionRing;
+    /// Submission queue ring mapping size.
+    size_t m_submissionRingSize;
+    /// Completion queue ring mapping (may alias the submission queue ring mapping).
+    void* m_pCompletionRing;
+    /// Completion queue ring mapping size.
+    size_t m_completionRingSize;
+    /// Submission queue entry array.
+    struct io_uring_sqe* m_pSubmissionEntries;
+    /// Submission queue entry array mapping size.
+    size_t m_submissionEntriesSize;
+
+    /// Submission queue tail index.
+    uint32_t* m_pSubmissionTail;
+    /// Submission queue index mask.
+    uint32_t m_submissionMask;
+    /// Submission queue index array.
+    uint32_t* m_pSubmissionArray;
+    /// Completion queue head index.
+    uint32_t* m_pCompletionHead;
+    /// Completion queue tail index.
+    uint32_t* m_pCompletionTail;
+    /// Completion queue index mask.
+    uint32_t m_completionMask;
+    /// Completion queue entry array.
+    struct io_uring_cqe* m_pCompletionEntries;
+
+    /// Read slots.
+    Slot m_slots[ IO_URING_QUEUE_DEPTH ];
+    /// Indices of free read slots.
+    DynamicArray< size_t > m_freeSlots;
+    /// Number of prepared submissions not yet passed to the kernel.
+    uint32_t m_unsubmittedCount;
+
+    /// Open files.
+    DynamicArray< CachedFile > m_files;
+    /// Maximum number of files kept open at once.
+    size_t m_fileLimit;
+    /// Running count of requests processed (used to track file use order).
+    uint64_t m_useIndex;
+
+    /// Request popped from the queue that could not be started yet because all open files were in use.
+    Request* m_pDeferredRequest;
+
+    void Release();
+
+    bool StartRequest( Request* pRequest );
+    void PrepareRead( size_t slotIndex );
+    int Enter( uint32_t submitCount, uint32_t minimumCompleteCount );
+    void ReapCompletions();
+
+    CachedFile* AcquireFile( const String& rFileName, bool& rbAllFilesBusy );
+};
+
+/// Open a file for positional reads.
+///
+/// @param[in] rFileName  Name of the file to open.
+///
+/// @return  File descriptor if opened successfully, -1 if not.
+int AsyncLoader::OpenFileDescriptor( const String& rFileName )
+{
+    int fileDescriptor;
+    do
+    {
+        fileDescriptor = open( *rFileName, O_RDONLY | O_CLOEXEC );
+    } while( fileDescriptor < 0 && errno == EINTR );
+
+    if( fileDescriptor >= 0 )
+    {
+        // Requests on the same file arrive roughly sorted by offset, so let the kernel read ahead aggressively.
+        posix_fadvise( fileDescriptor, 0, 0, POSIX_FADV_SEQUENTIAL );
+    }
+
+    return fileDescriptor;
+}
+
+/// Close a file descriptor opened using OpenFileDescriptor().
+///
+/// @param[in] fileDescriptor  File descriptor to close (ignored if negative).
+void AsyncLoader::CloseFileDescriptor( int fileDescriptor )
+{
+    if( fileDescriptor >= 0 )
+    {
+        close( fileDescriptor );
+    }
+}
+
+/// Create an io_uring load worker.
+///
+/// @param[in] pLoader    Async loader that will own the worker.
+/// @param[in] fileLimit  Maximum number of files the worker may keep open at once.
+///
+/// @return  Load worker if io_uring is supported by the running kernel, null if not.
+AsyncLoader::LoadWorker* AsyncLoader::CreateUringLoadWorker( AsyncLoader* pLoader, size_t fileLimit )
+{
+    UringLoadWorker* pWorker = new UringLoadWorker( pLoader, fileLimit );
+    HELIUM_ASSERT( pWorker );
+    if( !pWorker->Initialize() )
+    {
+        delete pWorker;
+
+        return NULL;
+    }
+
+    return pWorker;
+}
+
+/// Read a span of directly adjacent requests on a single file using one scatter read, then complete each request.
+///
+/// @param[in] pCachedFile   File to read.
+/// @param[in] ppRequests    Requests to process, sorted by offset with no gaps between them.
+/// @param[in] requestCount  Number of requests to process.
+void AsyncLoader::StreamLoadWorker::ProcessPositionalSpan(
+    CachedFile* pCachedFile,
+    Request* const* ppRequests,
+    size_t requestCount )
+{
+    HELIUM_ASSERT( pCachedFile );
+    HELIUM_ASSERT( pCachedFile->fileDescriptor >= 0 );
+    HELIUM_ASSERT( ppRequests );
+    HELIUM_ASSERT( requestCount != 0 );
+    HELIUM_ASSERT( requestCount <= COALESCE_BATCH_SIZE );
+
+    struct iovec vectors[ COALESCE_BATCH_SIZE ];
+    for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+    {
+        Request* pRequest = ppRequests[ requestIndex ];
+        HELIUM_ASSERT( pRequest );
+        vectors[ requestIndex ].iov_base = pRequest->pBuffer;
+        vectors[ requestIndex ].iov_len = pRequest->size;
+    }
+
+    // Keep reading until the entire span has been filled, end-of-file has been reached, or an error occurs.
+    struct iovec* pVector = vectors;
+    size_t vectorCount = requestCount;
+    uint64_t offset = ppRequests[ 0 ]->offset;
+    size_t totalBytesRead = 0;
+    while( vectorCount != 0 )
+    {
+        ssize_t result = preadv( pCachedFile->fileDescriptor, pVector, static_cast< int >( vectorCount ), offset );
+        if( result < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        if( result == 0 )
+        {
+            break;
+        }
+
+        size_t bytesRead = static_cast< size_t >( result );
+        totalBytesRead += bytesRead;
+        offset += bytesRead;
+
+        while( vectorCount != 0 && bytesRead >= pVector->iov_len )
+        {
+            bytesRead -= pVector->iov_len;
+            ++pVector;
+            --vectorCount;
+        }
+
+        if( vectorCount != 0 )
+        {
+            pVector->iov_base = static_cast< uint8_t* >( pVector->iov_base ) + bytesRead;
+            pVector->iov_len -= bytesRead;
+        }
+    }
+
+    pCachedFile->position = ppRequests[ 0 ]->offset + totalBytesRead;
+
+    for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+    {
+        Request* pRequest = ppRequests[ requestIndex ];
+        size_t bytesRead = Min( totalBytesRead, pRequest->size );
+        totalBytesRead -= bytesRead;
+
+        CompleteRequest( pRequest, bytesRead );
+    }
+}
+
+/// Constructor.
+///
+/// @param[in] pLoader    Async loader that owns this worker.
+/// @param[in] fileLimit  Maximum number of files this worker may keep open at once.
+AsyncLoader::UringLoadWorker::UringLoadWorker( AsyncLoader* pLoader, size_t fileLimit )
+: LoadWorker( pLoader )
+, m_ringDescriptor( -1 )
+, m_pSubmissionRing( MAP_FAILED )
+, m_submissionRingSize( 0 )
+, m_pCompletionRing( MAP_FAILED )
+, m_completionRingSize( 0 )
+, m_pSubmissionEntries( static_cast< struct io_uring_sqe* >( MAP_FAILED ) )
+, m_submissionEntriesSize( 0 )
+, m_pSubmissionTail( NULL )
+, m_submissionMask( 0 )
+, m_pSubmissionArray( NULL )
+, m_pCompletionHead( NULL )
+, m_pCompletionTail( NULL )
+, m_completionMask( 0 )
+, m_pCompletionEntries( NULL )
+, m_unsubmittedCount( 0 )
+, m_fileLimit( Max< size_t >( fileLimit, 1 ) )
+, m_useIndex( 0 )
+, m_pDeferredRequest( NULL )
+{
+    m_freeSlots.Reserve( IO_URING_QUEUE_DEPTH );
+    for( size_t slotIndex = IO_URING_QUEUE_DEPTH; slotIndex-- != 0; )
+    {
+        m_slots[ slotIndex ].pRequest = NULL;
+        m_slots[ slotIndex ].pCachedFile = NULL;
+        m_freeSlots.Push( slotIndex );
+    }
+
+    m_files.Reserve( m_fileLimit );
+}
+
+/// Destructor.
+AsyncLoader::UringLoadWorker::~UringLoadWorker()
+{
+    CloseFiles();
+    Release();
+}
+
+/// Set up the io_uring instance used by this worker.
+///
+/// @return  True if initialization was successful, false if io_uring is not available.
+bool AsyncLoader::UringLoadWorker::Initialize()
+{
+    struct io_uring_params parameters;
+    MemoryZero( &parameters, sizeof( parameters ) );
+
+    m_ringDescriptor = static_cast< int >( syscall(
+        __NR_io_uring_setup,
+        static_cast< unsigned >( IO_URING_QUEUE_DEPTH ),
+        &parameters ) );
+    if( m_ringDescriptor < 0 )
+    {
+        return false;
+    }
+
+    m_submissionRingSize = parameters.sq_off.array + parameters.sq_entries * sizeof( uint32_t );
+    m_completionRingSize = parameters.cq_off.cqes + parameters.cq_entries * sizeof( struct io_uring_cqe );
+
+    bool bSingleMap = ( ( parameters.features & IORING_FEAT_SINGLE_MMAP ) != 0 );
+    if( bSingleMap )
+    {
+        m_submissionRingSize = Max( m_submissionRingSize, m_completionRingSize );
+    }
+
+    m_pSubmissionRing = mmap(
+        NULL,
+        m_submissionRingSize,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        m_ringDescriptor,
+        IORING_OFF_SQ_RING );
+    if( m_pSubmissionRing == MAP_FAILED )
+    {
+        Release();
+
+        return false;
+    }
+
+    if( !bSingleMap )
+    {
+        m_pCompletionRing = mmap(
+            NULL,
+            m_completionRingSize,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            m_ringDescriptor,
+            IORING_OFF_CQ_RING );
+        if( m_pCompletionRing == MAP_FAILED )
+        {
+            Release();
+
+            return false;
+        }
+    }
+
+    m_submissionEntriesSize = parameters.sq_entries * sizeof( struct io_uring_sqe );
+    m_pSubmissionEntries = static_cast< struct io_uring_sqe* >( mmap(
+        NULL,
+        m_submissionEntriesSize,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        m_ringDescriptor,
+        IORING_OFF_SQES ) );
+    if( m_pSubmissionEntries == MAP_FAILED )
+    {
+        Release();
+
+        return false;
+    }
+
+    uint8_t* pSubmissionRing = static_cast< uint8_t* >( m_pSubmissionRing );
+    uint8_t* pCompletionRing = static_cast< uint8_t* >( bSingleMap ? m_pSubmissionRing : m_pCompletionRing );
+
+    m_pSubmissionTail = reinterpret_cast< uint32_t* >( pSubmissionRing + parameters.sq_off.tail );
+    m_submissionMask = *reinterpret_cast< uint32_t* >( pSubmissionRing + parameters.sq_off.ring_mask );
+    m_pSubmissionArray = reinterpret_cast< uint32_t* >( pSubmissionRing + parameters.sq_off.array );
+
+    m_pCompletionHead = reinterpret_cast< uint32_t* >( pCompletionRing + parameters.cq_off.head );
+    m_pCompletionTail = reinterpret_cast< uint32_t* >( pCompletionRing + parameters.cq_off.tail );
+    m_completionMask = *reinterpret_cast< uint32_t* >( pCompletionRing + parameters.cq_off.ring_mask );
+    m_pCompletionEntries = reinterpret_cast< struct io_uring_cqe* >( pCompletionRing + parameters.cq_off.cqes );
+
+    return true;
+}
+
+/// Process load requests until the owning loader is shut down.
+void AsyncLoader::UringLoadWorker::Run()
+{
+    while( m_pLoader->m_stopCounter == 0 )
+    {
+        // Fill up any free slots with new requests, highest priority first.
+        while( !m_freeSlots.IsEmpty() )
+        {
+            Request* pRequest = m_pDeferredRequest;
+            m_pDeferredRequest = NULL;
+            if( !pRequest )
+            {
+                EPriority priority;
+                pRequest = m_pLoader->PopRequest( priority );
+                if( !pRequest )
+                {
+                    break;
+                }
+            }
+
+            if( !StartRequest( pRequest ) )
+            {
+                // All open files have reads in flight, so wait for some to complete before opening another.
+                m_pDeferredRequest = pRequest;
+
+                break;
+            }
+        }
+
+        size_t inFlightCount = IO_URING_QUEUE_DEPTH - m_freeSlots.GetSize();
+        if( inFlightCount == 0 )
+        {
+            HELIUM_ASSERT( m_unsubmittedCount == 0 );
+            m_pLoader->m_wakeUpCondition.Wait();
+
+            continue;
+        }
+
+        // Submit everything prepared so far.  We only get here once the queues are drained, every slot is in use, or
+        // we are waiting on a busy file, so block until at least one read completes.
+        Enter( m_unsubmittedCount, 1 );
+
+        ReapCompletions();
+    }
+
+    // Wait for any reads still in flight so that the kernel is no longer writing into request buffers.  Reaping
+    // completions can prepare new reads (to finish short reads or retry interrupted ones), so anything prepared is
+    // submitted on each pass as well.
+    while( m_freeSlots.GetSize() != IO_URING_QUEUE_DEPTH )
+    {
+        Enter( m_unsubmittedCount, 1 );
+        ReapCompletions();
+    }
+
+    if( m_pDeferredRequest )
+    {
+        CompleteRequest( m_pDeferredRequest, 0 );
+        m_pDeferredRequest = NULL;
+    }
+
+    // Pass the stop signal along in case other threads are waiting on it.
+    m_pLoader->m_wakeUpCondition.Signal();
+}
+
+/// Close all files held open by this worker.
+///
+/// This must only be called while no reads are in flight.
+void AsyncLoader::UringLoadWorker::CloseFiles()
+{
+    size_t fileCount = m_files.GetSize();
+    for( size_t fileIndex = 0; fileIndex < fileCount; ++fileIndex )
+    {
+        CachedFile& rCachedFile = m_files[ fileIndex ];
+        HELIUM_ASSERT( rCachedFile.inFlightCount == 0 );
+        CloseFileDescriptor( rCachedFile.fileDescriptor );
+    }
+
+    m_files.Clear();
+}
+
+/// Unmap the io_uring queues and close the ring.
+void AsyncLoader::UringLoadWorker::Release()
+{
+    if( m_pSubmissionEntries != MAP_FAILED )
+    {
+        munmap( m_pSubmissionEntries, m_submissionEntriesSize );
+        m_pSubmissionEntries = static_cast< struct io_uring_sqe* >( MAP_FAILED );
+    }
+
+    if( m_pCompletionRing != MAP_FAILED )
+    {
+        munmap( m_pCompletionRing, m_completionRingSize );
+        m_pCompletionRing = MAP_FAILED;
+    }
+
+    if( m_pSubmissionRing != MAP_FAILED )
+    {
+        munmap( m_pSubmissionRing, m_submissionRingSize );
+        m_pSubmissionRing = MAP_FAILED;
+    }
+
+    if( m_ringDescriptor >= 0 )
+    {
+        close( m_ringDescriptor );
+        m_ringDescriptor = -1;
+    }
+}
+
+/// Assign a request to a free slot and prepare its first read.
+///
+/// @param[in] pRequest  Request to start.
+///
+/// @return  True if the request was started or completed immediately, false if it must be retried once some
+///          in-flight reads have completed.
+bool AsyncLoader::UringLoadWorker::StartRequest( Request* pRequest )
+{
+    HELIUM_ASSERT( pRequest );
+    HELIUM_ASSERT( !m_freeSlots.IsEmpty() );
+
+    bool bAllFilesBusy = false;
+    CachedFile* pCachedFile = AcquireFile( pRequest->fileName, bAllFilesBusy );
+    if( !pCachedFile )
+    {
+        if( bAllFilesBusy )
+        {
+            return false;
+        }
+
+        CompleteRequest( pRequest, Invalid< size_t >() );
+
+        return true;
+    }
+
+    if( pRequest->size == 0 )
+    {
+        CompleteRequest( pRequest, 0 );
+
+        return true;
+    }
+
+    size_t slotIndex = m_freeSlots.GetLast();
+    m_freeSlots.Pop();
+
+    Slot& rSlot = m_slots[ slotIndex ];
+    rSlot.pRequest = pRequest;
+    rSlot.pCachedFile = pCachedFile;
+    rSlot.vector.iov_base = pRequest->pBuffer;
+    rSlot.vector.iov_len = pRequest->size;
+    rSlot.bytesRead = 0;
+
+    ++pCachedFile->inFlightCount;
+
+    PrepareRead( slotIndex );
+
+    return true;
+}
+
+/// Add a submission queue entry for the remaining portion of the read assigned to the given slot.
+///
+/// @param[in] slotIndex  Index of the slot to read.
+void AsyncLoader::UringLoadWorker::PrepareRead( size_t slotIndex )
+{
+    HELIUM_ASSERT( slotIndex < IO_URING_QUEUE_DEPTH );
+
+    Slot& rSlot = m_slots[ slotIndex ];
+    HELIUM_ASSERT( rSlot.pRequest );
+    HELIUM_ASSERT( rSlot.pCachedFile );
+
+    // The submission queue is only ever written from this thread, so the tail does not need an atomic load.
+    uint32_t tail = *m_pSubmissionTail;
+    uint32_t entryIndex = tail & m_submissionMask;
+
+    struct io_uring_sqe* pEntry = m_pSubmissionEntries + entryIndex;
+    MemoryZero( pEntry, sizeof( *pEntry ) );
+    pEntry->opcode = IORING_OP_READV;
+    pEntry->fd = rSlot.pCachedFile->fileDescriptor;
+    pEntry->off = rSlot.pRequest->offset + rSlot.bytesRead;
+    pEntry->addr = reinterpret_cast< uintptr_t >( &rSlot.vector );
+    pEntry->len = 1;
+    pEntry->user_data = slotIndex;
+
+    m_pSubmissionArray[ entryIndex ] = entryIndex;
+    __atomic_store_n( m_pSubmissionTail, tail + 1, __ATOMIC_RELEASE );
+
+    ++m_unsubmittedCount;
+}
+
+/// Submit prepared reads and optionally wait for completions.
+///
+/// @param[in] submitCount           Number of prepared submission queue entries to submit.
+/// @param[in] minimumCompleteCount  Number of completions to wait for before returning.
+///
+/// @return  Result of the io_uring_enter() call.
+int AsyncLoader::UringLoadWorker::Enter( uint32_t submitCount, uint32_t minimumCompleteCount )
+{
+    unsigned flags = ( minimumCompleteCount != 0 ? IORING_ENTER_GETEVENTS : 0 );
+
+    int result;
+    do
+    {
+        result = static_cast< int >( syscall(
+            __NR_io_uring_enter,
+            m_ringDescriptor,
+            submitCount,
+            minimumCompleteCount,
+            flags,
+            NULL,
+            0 ) );
+    } while( result < 0 && errno == EINTR );
+
+    if( result > 0 )
+    {
+        m_unsubmittedCount -= Min( static_cast< uint32_t >( result ), submitCount );
+    }
+
+    return result;
+}
+
+/// Process all available completion queue entries, completing finished requests and resubmitting short reads.
+void AsyncLoader::UringLoadWorker::ReapCompletions()
+{
+    uint32_t head = *m_pCompletionHead;
+    uint32_t tail = __atomic_load_n( m_pCompletionTail, __ATOMIC_ACQUIRE );
+
+    for( ; head != tail; ++head )
+    {
+        struct io_uring_cqe* pEntry = m_pCompletionEntries + ( head & m_completionMask );
+        size_t slotIndex = static_cast< size_t >( pEntry->user_data );
+        int32_t result = pEntry->res;
+
+        HELIUM_ASSERT( slotIndex < IO_URING_QUEUE_DEPTH );
+        Slot& rSlot = m_slots[ slotIndex ];
+        HELIUM_ASSERT( rSlot.pRequest );
+
+        if( result == -EINTR || result == -EAGAIN )
+        {
+            PrepareRead( slotIndex );
+
+            continue;
+        }
+
+        if( result > 0 )
+        {
+            size_t bytesRead = static_cast< size_t >( result );
+            rSlot.bytesRead += bytesRead;
+            rSlot.vector.iov_base = static_cast< uint8_t* >( rSlot.vector.iov_base ) + bytesRead;
+            rSlot.vector.iov_len -= bytesRead;
+
+            if( rSlot.vector.iov_len != 0 )
+            {
+                // Short read, so queue up the remainder.
+                PrepareRead( slotIndex );
+
+                continue;
+            }
+        }
+
+        // Request finished (fully read, end-of-file reached, or failed).
+        CachedFile* pCachedFile = rSlot.pCachedFile;
+        HELIUM_ASSERT( pCachedFile );
+        HELIUM_ASSERT( pCachedFile->inFlightCount != 0 );
+        --pCachedFile->inFlightCount;
+
+        CompleteRequest( rSlot.pRequest, rSlot.bytesRead );
+
+        rSlot.pRequest = NULL;
+        rSlot.pCachedFile = NULL;
+        m_freeSlots.Push( slotIndex );
+    }
+
+    __atomic_store_n( m_pCompletionHead, head, __ATOMIC_RELEASE );
+}
+
+/// Get an open file descriptor for the given file, opening it and evicting the least recently used idle file if
+/// necessary.
+///
+/// @param[in]  rFileName       Name of the file to open.
+/// @param[out] rbAllFilesBusy  Set to true if the file could not be opened because the open file limit has been
+///                             reached and every open file has reads in flight.
+///
+/// @return  Cached file, or null if the file could not be opened.
+AsyncLoader::CachedFile* AsyncLoader::UringLoadWorker::AcquireFile( const String& rFileName, bool& rbAllFilesBusy )
+{
+    ++m_useIndex;
+    rbAllFilesBusy = false;
+
+    size_t fileCount = m_files.GetSize();
+    size_t leastRecentIndex = Invalid< size_t >();
+    for( size_t fileIndex = 0; fileIndex < fileCount; ++fileIndex )
+    {
+        CachedFile& rCachedFile = m_files[ fileIndex ];
+        if( rCachedFile.fileName == rFileName )
+        {
+            rCachedFile.lastUseIndex = m_useIndex;
+
+            return &rCachedFile;
+        }
+
+        if( rCachedFile.inFlightCount == 0 &&
+            ( IsInvalid( leastRecentIndex ) || rCachedFile.lastUseIndex < m_files[ leastRecentIndex ].lastUseIndex ) )
+        {
+            leastRecentIndex = fileIndex;
+        }
+    }
+
+    if( fileCount >= m_fileLimit && IsInvalid( leastRecentIndex ) )
+    {
+        rbAllFilesBusy = true;
+
+        return NULL;
+    }
+
+    int fileDescriptor = OpenFileDescriptor( rFileName );
+    if( fileDescriptor < 0 )
+    {
+        return NULL;
+    }
+
+    // Slots reference cached files by address, so reuse the evicted entry in place rather than shuffling the array
+    // (the array is reserved up front to the file limit, so adding entries never reallocates it either).
+    CachedFile* pCachedFile;
+    if( fileCount >= m_fileLimit )
+    {
+        pCachedFile = &m_files[ leastRecentIndex ];
+        CloseFileDescriptor( pCachedFile->fileDescriptor );
+    }
+    else
+    {
+        pCachedFile = m_files.New();
+        HELIUM_ASSERT( pCachedFile );
+    }
+
+    pCachedFile->fileName = rFileName;
+    pCachedFile->pStream = NULL;
+    pCachedFile->fileDescriptor = fileDescriptor;
+    pCachedFile->position = 0;
+    pCachedFile->lastUseIndex = m_useIndex;
+    pCachedFile->inFlightCount = 0;
+
+    return pCachedFile;
+}
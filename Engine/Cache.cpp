@@ -14,11 +14,8 @@
 #include "Engine/FileLocations.h"
 #include "Engine/AsyncLoader.h"
 
-#if USE_XML_FOR_CACHE_DATA
 #include "Reflect/ArchiveXML.h"
-#else
 #include "Reflect/ArchiveBinary.h"
-#endif
 
 using namespace Helium;
 
@@ -26,16 +23,198 @@ using namespace Helium;
 static const uint32_t TOC_MAGIC = 0xcac4e70c;
 /// TOC header magic number (byte-swapped).
 static const uint32_t TOC_MAGIC_SWAPPED = 0x0ce7c4ca;
+/// Journal header magic number.
+static const uint32_t JOURNAL_MAGIC = 0xcac4e70d;
+
+/// Suffix appended to the TOC file name to form the journal file name.
+static const tchar_t JOURNAL_FILE_SUFFIX[] = TXT( ".journal" );
+/// Cached object payload header magic number (stored little-endian).
+static const uint32_t PAYLOAD_MAGIC = 0x4c504348;
+
+namespace
+{
+    /// Stream buffer for writing a cached object payload directly into a DynamicArray.
+    template< typename CharType >
+    class PayloadWriteStreamBuffer : public std::basic_streambuf< CharType >
+    {
+    public:
+        typedef std::basic_streambuf< CharType > Base;
+        typedef typename Base::traits_type traits_type;
+        typedef typename Base::int_type int_type;
+        typedef typename Base::pos_type pos_type;
+        typedef typename Base::off_type off_type;
+
+        /// Constructor.
+        ///
+        /// @param[in] rBuffer     Buffer to which data should be written.
+        /// @param[in] baseOffset  Byte offset within the buffer at which stream data should start.
+        PayloadWriteStreamBuffer( DynamicArray< uint8_t >& rBuffer, size_t baseOffset )
+            : m_rBuffer( rBuffer )
+            , m_baseOffset( baseOffset )
+            , m_position( 0 )
+        {
+        }
+
+    protected:
+        /// Write a sequence of characters at the current position, growing the buffer as necessary.
+        std::streamsize xsputn( const CharType* pCharacters, std::streamsize count )
+        {
+            size_t byteOffset = m_baseOffset + m_position * sizeof( CharType );
+            size_t byteCount = static_cast< size_t >( count ) * sizeof( CharType );
+            size_t requiredSize = byteOffset + byteCount;
+            if( m_rBuffer.GetSize() < requiredSize )
+            {
+                // Grow geometrically, as archives are written in many small pieces.
+                size_t capacity = m_rBuffer.GetCapacity();
+                if( capacity < requiredSize )
+                {
+                    m_rBuffer.Reserve( Max( requiredSize, capacity * 2 ) );
+                }
+
+                m_rBuffer.Resize( requiredSize );
+            }
+
+            MemoryCopy( m_rBuffer.GetData() + byteOffset, pCharacters, byteCount );
+            m_position += static_cast< size_t >( count );
+
+            return count;
+        }
+
+        /// Write a single character at the current position.
+        int_type overflow( int_type character )
+        {
+            if( traits_type::eq_int_type( character, traits_type::eof() ) )
+            {
+                return traits_type::not_eof( character );
+            }
+
+            CharType value = traits_type::to_char_type( character );
+            xsputn( &value, 1 );
+
+            return character;
+        }
+
+        /// Set the current write position relative to the start, current position, or end of the stream.
+        pos_type seekoff( off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode )
+        {
+            if( !( mode & std::ios_base::out ) )
+            {
+                return pos_type( off_type( -1 ) );
+            }
+
+            off_type position = offset;
+            if( direction == std::ios_base::cur )
+            {
+                position += static_cast< off_type >( m_position );
+            }
+            else if( direction == std::ios_base::end )
+            {
+                position += static_cast< off_type >( ( m_rBuffer.GetSize() - m_baseOffset ) / sizeof( CharType ) );
+            }
+
+            if( position < 0 )
+            {
+                return pos_type( off_type( -1 ) );
+            }
+
+            m_position = static_cast< size_t >( position );
+
+            return pos_type( position );
+        }
+
+        /// Set the current write position relative to the start of the stream.
+        pos_type seekpos( pos_type position, std::ios_base::openmode mode )
+        {
+            return seekoff( off_type( position ), std::ios_base::beg, mode );
+        }
+
+    private:
+        /// Destination buffer.
+        DynamicArray< uint8_t >& m_rBuffer;
+        /// Byte offset within the destination buffer at which stream data starts.
+        size_t m_baseOffset;
+        /// Current write position, in characters.
+        size_t m_position;
+    };
+
+    /// Stream buffer for reading a cached object payload in place from memory.
+    template< typename CharType >
+    class PayloadReadStreamBuffer : public std::basic_streambuf< CharType >
+    {
+    public:
+        typedef std::basic_streambuf< CharType > Base;
+        typedef typename Base::pos_type pos_type;
+        typedef typename Base::off_type off_type;
+
+        /// Constructor.
+        ///
+        /// @param[in] pCharacters     Payload data.
+        /// @param[in] characterCount  Number of characters in the payload.
+        PayloadReadStreamBuffer( const CharType* pCharacters, size_t characterCount )
+        {
+            // The get area is never written through, so it is safe to cast away const here.
+            CharType* pBegin = const_cast< CharType* >( pCharacters );
+            this->setg( pBegin, pBegin, pBegin + characterCount );
+        }
+
+    protected:
+        /// Set the current read position relative to the start, current position, or end of the stream.
+        pos_type seekoff( off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode )
+        {
+            if( !( mode & std::ios_base::in ) )
+            {
+                return pos_type( off_type( -1 ) );
+            }
+
+            off_type position = offset;
+            if( direction == std::ios_base::cur )
+            {
+                position += this->gptr() - this->eback();
+            }
+            else if( direction == std::ios_base::end )
+            {
+                position += this->egptr() - this->eback();
+            }
+
+            if( position < 0 || position > this->egptr() - this->eback() )
+            {
+                return pos_type( off_type( -1 ) );
+            }
+
+            this->setg( this->eback(), this->eback() + position, this->egptr() );
+
+            return pos_type( position );
+        }
+
+        /// Set the current read position relative to the start of the stream.
+        pos_type seekpos( pos_type position, std::ios_base::openmode mode )
+        {
+            return seekoff( off_type( position ), std::ios_base::beg, mode );
+        }
+    };
+}
 
 /// Constructor.
 Cache::Cache()
 : m_name( NULL_NAME )
 , m_platform( PLATFORM_INVALID )
+, m_payloadFormat( PAYLOAD_FORMAT_BINARY )
 , m_bTocLoaded( false )
 , m_asyncLoadId( Invalid< size_t >() )
 , m_pTocBuffer( NULL )
 , m_tocSize( Invalid< uint32_t >() )
+, m_bMapCacheFile( false )
+, m_pMappedData( NULL )
+, m_mappedSize( 0 )
+, m_pMappingHandle( NULL )
+, m_pTocEntries( NULL )
+, m_tocEntryCount( 0 )
+, m_pTocBuckets( NULL )
+, m_tocBucketCount( 0 )
+, m_pTocStringPool( NULL )
+, m_tocStringPoolSize( 0 )
 , m_pEntryPool( NULL )
+, m_journalRecordCount( 0 )
 {
 }
 
@@ -52,15 +231,25 @@ Cache::~Cache()
 ///
 /// Once initialization is performed, the table of contents must be loaded using BeginLoadToc().
 ///
+/// Entries cached after the TOC file was last written are recorded in a journal file alongside the TOC (the TOC file
+/// name with ".journal" appended), which is replayed when the TOC is loaded.
+///
 /// @param[in] name            Name identifying this cache.
 /// @param[in] platform        Cache platform identifier.
 /// @param[in] pTocFileName    FilePath name of the table of contents file.
 /// @param[in] pCacheFileName  FilePath name of the cache file.
+/// @param[in] bMapCacheFile   True to map the cache file into memory once the TOC has been loaded, allowing entry
+///                            data to be accessed in place using GetMappedEntryData().  Mapped caches are read-only.
 ///
 /// @return  True if initialization was successful, false if not.
 ///
 /// @see Shutdown(), BeginLoadToc()
-bool Cache::Initialize( Name name, EPlatform platform, const tchar_t* pTocFileName, const tchar_t* pCacheFileName )
+bool Cache::Initialize(
+                       Name name,
+                       EPlatform platform,
+                       const tchar_t* pTocFileName,
+                       const tchar_t* pCacheFileName,
+                       bool bMapCacheFile )
 {
     HELIUM_ASSERT( !name.IsEmpty() );
     HELIUM_ASSERT( static_cast< size_t >( platform ) < static_cast< size_t >( PLATFORM_MAX ) );
@@ -87,9 +276,13 @@ bool Cache::Initialize( Name name, EPlatform platform, const tchar_t* pTocFileNa
 
     m_tocFileName = pTocFileName;
     m_cacheFileName = pCacheFileName;
+    m_journalFileName = pTocFileName;
+    m_journalFileName += JOURNAL_FILE_SUFFIX;
 
     m_tocSize = static_cast< uint32_t >( tocSize64 );
 
+    m_bMapCacheFile = bMapCacheFile;
+
     HELIUM_ASSERT( !m_pEntryPool );
     m_pEntryPool = new ObjectPool< Entry >( ENTRY_POOL_BLOCK_SIZE );
     HELIUM_ASSERT( m_pEntryPool );
@@ -99,29 +292,36 @@ bool Cache::Initialize( Name name, EPlatform platform, const tchar_t* pTocFileNa
 
 /// Shut down this cache and free all allocated memory.
 ///
-/// @see Initialize()
+/// Any journal records written since the TOC file was last written are compacted into a new TOC file first.
+///
+/// @see Initialize(), Compact()
 void Cache::Shutdown()
 {
-    m_name = NULL_NAME;
-    m_platform = PLATFORM_INVALID;
-
-    m_tocFileName.Clear();
-    m_cacheFileName.Clear();
-
     if( IsValid( m_asyncLoadId ) )
     {
         AsyncLoader::GetStaticInstance().SyncRequest( m_asyncLoadId );
         SetInvalid( m_asyncLoadId );
     }
 
-    DefaultAllocator().Free( m_pTocBuffer );
-    m_pTocBuffer = NULL;
+    if( m_journalRecordCount != 0 && !m_bMapCacheFile )
+    {
+        Compact();
+    }
+
+    m_name = NULL_NAME;
+    m_platform = PLATFORM_INVALID;
+
+    m_tocFileName.Clear();
+    m_cacheFileName.Clear();
+    m_journalFileName.Clear();
+
+    ReleaseEntries();
     SetInvalid( m_tocSize );
 
     m_bTocLoaded = false;
 
-    m_entries.Clear();
-    m_entryMap.Clear();
+    UnmapCacheFile();
+    m_bMapCacheFile = false;
 
     delete m_pEntryPool;
     m_pEntryPool = NULL;
@@ -157,13 +357,16 @@ bool Cache::BeginLoadToc()
     {
         HELIUM_TRACE( TraceLevels::Info, TXT( "Cache::BeginLoadToc(): TOC file does not seem to exist.  MOVING ON...\n" ) );
 
-        // Since the TOC doesn't exist, we can consider its loading to be complete.
-        m_bTocLoaded = true;
+        // Since the TOC doesn't exist, we can consider its loading to be complete (entries may still have been cached
+        // to the journal, though).
+        CompleteTocLoad();
 
         return false;
     }
 
-    HELIUM_ASSERT( !m_pTocBuffer );
+    // Entries from any previous load reference the old TOC buffer, so discard them before loading again.
+    ReleaseEntries();
+
     DefaultAllocator allocator;
     m_pTocBuffer = static_cast< uint8_t* >( allocator.Allocate( m_tocSize ) );
     HELIUM_ASSERT( m_pTocBuffer );
@@ -247,28 +450,22 @@ bool Cache::TryFinishLoadToc()
         }
 
         bool bFinalizeResult = FinalizeTocLoad();
-
-        DefaultAllocator().Free( m_pTocBuffer );
-        m_pTocBuffer = NULL;
-
         if( !bFinalizeResult )
         {
-            HELIUM_ASSERT( m_pEntryPool );
-
-            size_t entryCount = m_entries.GetSize();
-            for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+            ReleaseEntries();
+        }
+        else
+        {
+            // Entries converted from a legacy TOC don't reference the TOC buffer, so it is no longer needed.
+            if( !m_pTocEntries )
             {
-                Entry* pEntry = m_entries[ entryIndex ];
-                HELIUM_ASSERT( pEntry );
-                m_pEntryPool->Release( pEntry );
+                DefaultAllocator().Free( m_pTocBuffer );
+                m_pTocBuffer = NULL;
             }
-
-            m_entries.Clear();
-            m_entryMap.Clear();
         }
     }
 
-    m_bTocLoaded = true;
+    CompleteTocLoad();
 
     return true;
 }
@@ -292,6 +489,72 @@ void Cache::EnforceTocLoad()
     }
 }
 
+/// Write a new TOC file containing all current cache entries and discard the journal.
+///
+/// This is performed automatically on shutdown if any journal records are pending, but can be called explicitly
+/// (i.e. at the end of a cooking pass) to avoid replaying the journal on the next load.
+///
+/// @return  True if the TOC file was written successfully, false if not.
+///
+/// @see CacheEntries(), GetJournalRecordCount()
+bool Cache::Compact()
+{
+    if( m_tocFileName.IsEmpty() )
+    {
+        HELIUM_TRACE( TraceLevels::Error, TXT( "Cache::Compact(): Called without having initialized the cache.\n" ) );
+
+        return false;
+    }
+
+    if( m_bMapCacheFile )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache::Compact(): Cannot compact read-only (memory-mapped) cache \"%s\".\n" ),
+            *m_cacheFileName );
+
+        return false;
+    }
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "Cache::Compact(): Compacting %" ) TPRIu32 TXT( " journal records into TOC file \"%s\".\n" ),
+        m_journalRecordCount,
+        *m_tocFileName );
+
+    AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+
+    rLoader.Lock();
+
+    bool bResult = WriteToc();
+    if( bResult )
+    {
+        // The TOC file now includes every journaled entry, so the journal can be truncated.  If the journal is left
+        // behind for some reason, replaying it on top of the new TOC is harmless.
+        Status status;
+        status.Read( m_journalFileName.GetData() );
+        if( status.m_Size > 0 )
+        {
+            FileStream* pJournalStream = FileStream::OpenFileStream( m_journalFileName, FileStream::MODE_WRITE, true );
+            if( !pJournalStream )
+            {
+                HELIUM_TRACE(
+                    TraceLevels::Warning,
+                    TXT( "Cache::Compact(): Failed to truncate journal file \"%s\".\n" ),
+                    *m_journalFileName );
+            }
+
+            delete pJournalStream;
+        }
+
+        m_journalRecordCount = 0;
+    }
+
+    rLoader.Unlock();
+
+    return bResult;
+}
+
 /// Search for a cache entry with the given object path name.
 ///
 /// @param[in] path          GameObject path.
@@ -300,20 +563,54 @@ void Cache::EnforceTocLoad()
 /// @return  Pointer to the cache entry for the given object path if found, null pointer if not found.
 const Cache::Entry* Cache::FindEntry( GameObjectPath path, uint32_t subDataIndex ) const
 {
-    EntryKey key;
-    key.path = path;
-    key.subDataIndex = subDataIndex;
+    // Entries added since the TOC was loaded are tracked in the entry map.
+    if( !m_entries.IsEmpty() )
+    {
+        EntryKey key;
+        key.path = path;
+        key.subDataIndex = subDataIndex;
+
+        EntryMapType::ConstAccessor mapAccessor;
+        if( m_entryMap.Find( mapAccessor, key ) )
+        {
+            Entry* pEntry = mapAccessor->Second();
+            HELIUM_ASSERT( pEntry );
+
+            return pEntry;
+        }
+    }
 
-    EntryMapType::ConstAccessor mapAccessor;
-    if( !m_entryMap.Find( mapAccessor, key ) )
+    if( m_tocEntryCount == 0 || path.IsEmpty() )
     {
         return NULL;
     }
 
-    Entry* pEntry = mapAccessor->Second();
-    HELIUM_ASSERT( pEntry );
+    return FindTocEntry( path, subDataIndex );
+}
 
-    return pEntry;
+/// Get the GameObjectPath for the given cache entry.
+///
+/// Cache entries only store their path name strings, so this will resolve the path through the object path table.
+/// Prefer using a path that is already known where possible.
+///
+/// @param[in] rEntry  Cache entry.
+///
+/// @return  Entry path.
+///
+/// @see GetEntryPathString()
+GameObjectPath Cache::GetEntryPath( const Entry& rEntry ) const
+{
+    GameObjectPath path;
+    if( !path.Set( GetEntryPathString( rEntry ) ) )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache::GetEntryPath(): Failed to set GameObjectPath for entry \"%s\" in cache \"%s\".\n" ),
+            GetEntryPathString( rEntry ),
+            *m_cacheFileName );
+    }
+
+    return path;
 }
 
 /// Add or update an entry in the cache.
@@ -325,6 +622,8 @@ const Cache::Entry* Cache::FindEntry( GameObjectPath path, uint32_t subDataIndex
 /// @param[in] size          Number of bytes to cache.
 ///
 /// @return  True if the cache was updated successfully, false if not.
+///
+/// @see CacheEntries()
 bool Cache::CacheEntry(
                        GameObjectPath path,
                        uint32_t subDataIndex,
@@ -332,63 +631,54 @@ bool Cache::CacheEntry(
                        int64_t timestamp,
                        uint32_t size )
 {
-    HELIUM_ASSERT( pData || size == 0 );
-
-	Status status;
-	status.Read( m_cacheFileName.GetData() );
-	int64_t cacheFileSize = status.m_Size;
-    uint64_t entryOffset = ( cacheFileSize == -1 ? 0 : static_cast< uint64_t >( cacheFileSize ) );
-
-    HELIUM_ASSERT( m_pEntryPool );
-    Entry* pEntryUpdate = m_pEntryPool->Allocate();
-    HELIUM_ASSERT( pEntryUpdate );
-    pEntryUpdate->offset = entryOffset;
-    pEntryUpdate->timestamp = timestamp;
-    pEntryUpdate->path = path;
-    pEntryUpdate->subDataIndex = subDataIndex;
-    pEntryUpdate->size = size;
-
-    uint64_t originalOffset = 0;
-    int64_t originalTimestamp = 0;
-    uint32_t originalSize = 0;
+    EntryWrite write;
+    write.path = path;
+    write.subDataIndex = subDataIndex;
+    write.pData = pData;
+    write.timestamp = timestamp;
+    write.size = size;
+
+    return CacheEntries( &write, 1 );
+}
 
-    EntryKey key;
-    key.path = path;
-    key.subDataIndex = subDataIndex;
+/// Add or update a set of entries in the cache.
+///
+/// All entry data is written while holding a single AsyncLoader lock with the cache file opened only once.  Rather
+/// than rewriting the TOC file, a record for each entry written is appended to the journal file, which is replayed
+/// when the TOC is loaded and folded into the TOC file by Compact() (or on shutdown).
+///
+/// @param[in] pWrites     Array of entry write requests.
+/// @param[in] writeCount  Number of entry write requests.
+///
+/// @return  True if all entries were updated successfully, false if any failed to be written.
+///
+/// @see CacheEntry(), Compact()
+bool Cache::CacheEntries( const EntryWrite* pWrites, size_t writeCount )
+{
+    HELIUM_ASSERT( pWrites || writeCount == 0 );
 
-    EntryMapType::Accessor entryAccessor;
-    bool bNewEntry = m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntryUpdate ) );
-    if( bNewEntry )
+    if( m_bMapCacheFile )
     {
-        HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Adding \"%s\" to cache \"%s\".\n" ), *path.ToString(), *m_cacheFileName );
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache: Cannot update entries in read-only (memory-mapped) cache \"%s\".\n" ),
+            *m_cacheFileName );
 
-        m_entries.Push( pEntryUpdate );
+        return false;
     }
-    else
-    {
-        HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Updating \"%s\" in cache \"%s\".\n" ), *path.ToString(), *m_cacheFileName );
-
-        m_pEntryPool->Release( pEntryUpdate );
 
-        pEntryUpdate = entryAccessor->Second();
-        HELIUM_ASSERT( pEntryUpdate );
-
-        originalOffset = pEntryUpdate->offset;
-        originalTimestamp = pEntryUpdate->timestamp;
-        originalSize = pEntryUpdate->size;
+    if( writeCount == 0 )
+    {
+        return true;
+    }
 
-        if( originalSize < size )
-        {
-            pEntryUpdate->offset = entryOffset;
-        }
-        else
-        {
-            entryOffset = originalOffset;
-        }
+	Status status;
+	status.Read( m_cacheFileName.GetData() );
+	int64_t cacheFileSize = status.m_Size;
+    uint64_t cacheFileEnd = ( cacheFileSize == -1 ? 0 : static_cast< uint64_t >( cacheFileSize ) );
 
-        pEntryUpdate->timestamp = timestamp;
-        pEntryUpdate->size = size;
-    }
+    DynamicArray< uint8_t > journalBuffer;
+    uint32_t journalRecordCount = 0;
 
     AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
 
@@ -405,132 +695,155 @@ bool Cache::CacheEntry(
     }
     else
     {
-        HELIUM_TRACE(
-            TraceLevels::Info,
-            TXT( "Cache: Caching \"%s\" to \"%s\" (%" ) TPRIu32 TXT( " bytes @ offset %" ) TPRIu64 TXT( ").\n" ),
-            *path.ToString(),
-            *m_cacheFileName,
-            size,
-            entryOffset );
-
-        uint64_t seekOffset = static_cast< uint64_t >( pCacheStream->Seek(
-            static_cast< int64_t >( entryOffset ),
-            SeekOrigins::SEEK_ORIGIN_BEGIN ) );
-        if( seekOffset != entryOffset )
+        for( size_t writeIndex = 0; writeIndex < writeCount; ++writeIndex )
         {
-            HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Cache file offset seek failed.\n" ) );
+            const EntryWrite& rWrite = pWrites[ writeIndex ];
+            HELIUM_ASSERT( rWrite.pData || rWrite.size == 0 );
+
+            // Existing entries are overwritten in place if the new data fits, otherwise the data is appended to the
+            // cache file.  Entries are only added or updated once the data has been written successfully.
+            uint64_t entryOffset = cacheFileEnd;
 
-            if( bNewEntry )
+            Entry* pEntryUpdate = const_cast< Entry* >( FindEntry( rWrite.path, rWrite.subDataIndex ) );
+            if( !pEntryUpdate )
             {
-                m_entries.Pop();
-                m_entryMap.Remove( entryAccessor );
-                m_pEntryPool->Release( pEntryUpdate );
+                HELIUM_TRACE(
+                    TraceLevels::Info,
+                    TXT( "Cache: Adding \"%s\" to cache \"%s\".\n" ),
+                    *rWrite.path.ToString(),
+                    *m_cacheFileName );
             }
             else
-            {
-                pEntryUpdate->offset = originalOffset;
-                pEntryUpdate->timestamp = originalTimestamp;
-                pEntryUpdate->size = originalSize;
-            }
-
-            bCacheSuccess = false;
-        }
-        else
-        {
-            size_t writeSize = pCacheStream->Write( pData, 1, size );
-            if( writeSize != size )
             {
                 HELIUM_TRACE(
-                    TraceLevels::Error,
-                    ( TXT( "Cache: Failed to write %" ) TPRIu32 TXT( " bytes to cache \"%s\" (%" ) TPRIuSZ
-                    TXT( " bytes written).\n" ) ),
-                    size,
-                    *m_cacheFileName,
-                    writeSize );
+                    TraceLevels::Info,
+                    TXT( "Cache: Updating \"%s\" in cache \"%s\".\n" ),
+                    *rWrite.path.ToString(),
+                    *m_cacheFileName );
 
-                if( bNewEntry )
-                {
-                    m_entries.Pop();
-                    m_entryMap.Remove( entryAccessor );
-                    m_pEntryPool->Release( pEntryUpdate );
-                }
-                else
+                if( pEntryUpdate->size >= rWrite.size )
                 {
-                    pEntryUpdate->offset = originalOffset;
-                    pEntryUpdate->timestamp = originalTimestamp;
-                    pEntryUpdate->size = originalSize;
+                    entryOffset = pEntryUpdate->offset;
                 }
-
-                bCacheSuccess = false;
             }
-            else
+
+            HELIUM_TRACE(
+                TraceLevels::Info,
+                TXT( "Cache: Caching \"%s\" to \"%s\" (%" ) TPRIu32 TXT( " bytes @ offset %" ) TPRIu64 TXT( ").\n" ),
+                *rWrite.path.ToString(),
+                *m_cacheFileName,
+                rWrite.size,
+                entryOffset );
+
+            uint64_t seekOffset = static_cast< uint64_t >( pCacheStream->Seek(
+                static_cast< int64_t >( entryOffset ),
+                SeekOrigins::SEEK_ORIGIN_BEGIN ) );
+            if( seekOffset != entryOffset )
             {
-                HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Rewriting TOC file \"%s\".\n" ), *m_tocFileName );
+                HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Cache file offset seek failed.\n" ) );
 
-                FileStream* pTocStream = FileStream::OpenFileStream( m_tocFileName, FileStream::MODE_WRITE, true );
-                if( !pTocStream )
-                {
-                    HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *m_tocFileName );
-                }
-                else
-                {
-                    BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
-                    HELIUM_ASSERT( pBufferedStream );
+                bCacheSuccess = false;
 
-                    pBufferedStream->Write( &TOC_MAGIC, sizeof( TOC_MAGIC ), 1 );
-                    pBufferedStream->Write( &sm_Version, sizeof( sm_Version ), 1 );
+                continue;
+            }
 
-                    uint32_t entryCount = static_cast< uint32_t >( m_entries.GetSize() );
-                    pBufferedStream->Write( &entryCount, sizeof( entryCount ), 1 );
+            size_t writeSize = pCacheStream->Write( rWrite.pData, 1, rWrite.size );
+            if( entryOffset == cacheFileEnd )
+            {
+                cacheFileEnd += writeSize;
+            }
 
-                    String entryPath;
-                    uint_fast32_t entryCountFast = entryCount;
-                    for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
-                    {
-                        Entry* pEntry = m_entries[ entryIndex ];
-                        HELIUM_ASSERT( pEntry );
+            if( writeSize != rWrite.size )
+            {
+                HELIUM_TRACE(
+                    TraceLevels::Error,
+                    ( TXT( "Cache: Failed to write %" ) TPRIu32 TXT( " bytes to cache \"%s\" (%" ) TPRIuSZ
+                    TXT( " bytes written).\n" ) ),
+                    rWrite.size,
+                    *m_cacheFileName,
+                    writeSize );
 
-                        pEntry->path.ToString( entryPath );
-                        HELIUM_ASSERT( entryPath.GetSize() < UINT16_MAX );
-                        uint16_t pathSize = static_cast< uint16_t >( entryPath.GetSize() );
-                        pBufferedStream->Write( &pathSize, sizeof( pathSize ), 1 );
+                bCacheSuccess = false;
 
-                        pBufferedStream->Write( *entryPath, sizeof( tchar_t ), pathSize );
+                continue;
+            }
 
-                        pBufferedStream->Write( &pEntry->subDataIndex, sizeof( pEntry->subDataIndex ), 1 );
+            if( !pEntryUpdate )
+            {
+                pEntryUpdate = AddEntry( rWrite.path, rWrite.subDataIndex );
+                HELIUM_ASSERT( pEntryUpdate );
+            }
 
-                        pBufferedStream->Write( &pEntry->offset, sizeof( pEntry->offset ), 1 );
-                        pBufferedStream->Write( &pEntry->timestamp, sizeof( pEntry->timestamp ), 1 );
-                        pBufferedStream->Write( &pEntry->size, sizeof( pEntry->size ), 1 );
-                    }
+            pEntryUpdate->offset = entryOffset;
+            pEntryUpdate->timestamp = rWrite.timestamp;
+            pEntryUpdate->size = rWrite.size;
 
-                    delete pBufferedStream;
-                    delete pTocStream;
-                }
-            }
+            WriteJournalRecord( journalBuffer, *pEntryUpdate );
+            ++journalRecordCount;
         }
 
         delete pCacheStream;
     }
 
+    if( journalRecordCount != 0 && !AppendJournal( journalBuffer, journalRecordCount ) )
+    {
+        bCacheSuccess = false;
+    }
+
     rLoader.Unlock();
 
     return bCacheSuccess;
 }
 
-/// Finalize the TOC loading process.
+/// Get a pointer to the data for a given cache entry within the memory-mapped cache file.
 ///
-/// Note that this does not free any resources on a failed load (the caller is responsible for such clean-up work).
+/// This also hints to the operating system that the entry's pages will be needed soon and will be read sequentially,
+/// so the returned data can be consumed immediately without first issuing an explicit read.
 ///
-/// @return  True if the TOC load was successful, false if not.
-bool Cache::FinalizeTocLoad()
+/// @param[in] rEntry  Cache entry.
+///
+/// @return  Pointer to the start of the entry data, or null if the cache file is not mapped or the entry lies outside
+///          the bounds of the mapped file.
+///
+/// @see IsCacheFileMapped()
+const uint8_t* Cache::GetMappedEntryData( const Entry& rEntry ) const
 {
-    HELIUM_ASSERT( m_pTocBuffer );
-
-    const uint8_t* pTocCurrent = m_pTocBuffer;
-    const uint8_t* pTocMax = pTocCurrent + m_tocSize;
+    if( !m_pMappedData )
+    {
+        return NULL;
+    }
 
-    StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
+    if( rEntry.offset > m_mappedSize || rEntry.size > m_mappedSize - rEntry.offset )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache: Entry \"%s\" lies outside the bounds of cache file \"%s\".\n" ),
+            GetEntryPathString( rEntry ),
+            *m_cacheFileName );
+
+        return NULL;
+    }
+
+    AdviseMappedRange( rEntry.offset, rEntry.size );
+
+    return m_pMappedData + rEntry.offset;
+}
+
+/// Finalize the TOC loading process.
+///
+/// Version 1 and later TOC files are used in place: the entry records, hash bucket table, and string pool are
+/// referenced directly within the TOC buffer (byte swapping them first if necessary), so no per-entry allocations are
+/// performed.  Legacy TOC files are converted into added entries instead.
+///
+/// Note that this does not free any resources on a failed load (the caller is responsible for such clean-up work).
+///
+/// @return  True if the TOC load was successful, false if not.
+bool Cache::FinalizeTocLoad()
+{
+    HELIUM_ASSERT( m_pTocBuffer );
+
+    const uint8_t* pTocCurrent = m_pTocBuffer;
+    const uint8_t* pTocMax = pTocCurrent + m_tocSize;
 
     // Validate the TOC header.
     uint32_t magic;
@@ -540,6 +853,7 @@ bool Cache::FinalizeTocLoad()
     }
 
     LOAD_VALUE_CALLBACK* pLoadFunction = NULL;
+    bool bSwapBytes = false;
     if( magic == TOC_MAGIC )
     {
         HELIUM_TRACE(
@@ -562,6 +876,7 @@ bool Cache::FinalizeTocLoad()
             *m_tocFileName );
 
         pLoadFunction = ReverseByteOrder;
+        bSwapBytes = true;
     }
     else
     {
@@ -591,6 +906,183 @@ bool Cache::FinalizeTocLoad()
         return false;
     }
 
+    if( version == 0 )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            ( TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" uses a legacy format and must be converted while loading.  " )
+            TXT( "Recache to improve load times.\n" ) ),
+            *m_tocFileName );
+
+        return FinalizeLegacyTocLoad( pLoadFunction, pTocCurrent, pTocMax );
+    }
+
+    if( m_tocSize < sizeof( TocHeader ) )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache::FinalizeTocLoad(): Not enough bytes in TOC \"%s\" for the header.\n" ),
+            *m_tocFileName );
+
+        return false;
+    }
+
+    TocHeader* pHeader = reinterpret_cast< TocHeader* >( m_pTocBuffer );
+    if( bSwapBytes )
+    {
+        SwapTocValue( pHeader->entryCount );
+        SwapTocValue( pHeader->bucketCount );
+        SwapTocValue( pHeader->stringPoolSize );
+        SwapTocValue( pHeader->characterSize );
+    }
+
+    uint32_t entryCount = pHeader->entryCount;
+    uint32_t bucketCount = pHeader->bucketCount;
+    uint32_t stringPoolSize = pHeader->stringPoolSize;
+
+    if( pHeader->characterSize != sizeof( tchar_t ) )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            ( TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" string character size (%" ) TPRIu32 TXT( ") does not " )
+            TXT( "match the runtime character size (%" ) TPRIuSZ TXT( ").\n" ) ),
+            *m_tocFileName,
+            pHeader->characterSize,
+            sizeof( tchar_t ) );
+
+        return false;
+    }
+
+    if( bucketCount == 0 || ( bucketCount & ( bucketCount - 1 ) ) != 0 )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" has an invalid hash bucket count (%" ) TPRIu32 TXT( ").\n" ),
+            *m_tocFileName,
+            bucketCount );
+
+        return false;
+    }
+
+    uint64_t entryTableSize = static_cast< uint64_t >( entryCount ) * sizeof( Entry );
+    uint64_t bucketTableSize = ( static_cast< uint64_t >( bucketCount ) + 1 ) * sizeof( uint32_t );
+    uint64_t stringPoolByteSize = static_cast< uint64_t >( stringPoolSize ) * sizeof( tchar_t );
+    if( sizeof( TocHeader ) + entryTableSize + bucketTableSize + stringPoolByteSize > m_tocSize )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache::FinalizeTocLoad(): Not enough bytes in TOC \"%s\" for %" ) TPRIu32 TXT( " entries.\n" ),
+            *m_tocFileName,
+            entryCount );
+
+        return false;
+    }
+
+    uint8_t* pTocData = m_pTocBuffer + sizeof( TocHeader );
+    Entry* pEntries = reinterpret_cast< Entry* >( pTocData );
+    pTocData += entryTableSize;
+    uint32_t* pBuckets = reinterpret_cast< uint32_t* >( pTocData );
+    pTocData += bucketTableSize;
+    tchar_t* pStringPool = reinterpret_cast< tchar_t* >( pTocData );
+
+    if( bSwapBytes )
+    {
+        for( uint_fast32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+        {
+            Entry& rEntry = pEntries[ entryIndex ];
+            SwapTocValue( rEntry.offset );
+            SwapTocValue( rEntry.timestamp );
+            SwapTocValue( rEntry.pathHash );
+            SwapTocValue( rEntry.pathOffset );
+            SwapTocValue( rEntry.pathLength );
+            SwapTocValue( rEntry.subDataIndex );
+            SwapTocValue( rEntry.size );
+        }
+
+        for( uint_fast32_t bucketIndex = 0; bucketIndex <= bucketCount; ++bucketIndex )
+        {
+            SwapTocValue( pBuckets[ bucketIndex ] );
+        }
+
+        if( sizeof( tchar_t ) > 1 )
+        {
+            for( uint_fast32_t characterIndex = 0; characterIndex < stringPoolSize; ++characterIndex )
+            {
+                SwapTocValue( pStringPool[ characterIndex ] );
+            }
+        }
+    }
+
+    // Validate the bucket table and string references up front so that lookups don't need to perform any bounds
+    // checking.
+    if( pBuckets[ 0 ] != 0 || pBuckets[ bucketCount ] != entryCount )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" has an invalid hash bucket table.\n" ),
+            *m_tocFileName );
+
+        return false;
+    }
+
+    for( uint_fast32_t bucketIndex = 0; bucketIndex < bucketCount; ++bucketIndex )
+    {
+        if( pBuckets[ bucketIndex ] > pBuckets[ bucketIndex + 1 ] )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" has an invalid hash bucket table.\n" ),
+                *m_tocFileName );
+
+            return false;
+        }
+    }
+
+    for( uint_fast32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        const Entry& rEntry = pEntries[ entryIndex ];
+        if( rEntry.pathOffset >= stringPoolSize ||
+            rEntry.pathLength >= stringPoolSize - rEntry.pathOffset ||
+            pStringPool[ rEntry.pathOffset + rEntry.pathLength ] != TXT( '\0' ) )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                ( TXT( "Cache::FinalizeTocLoad(): Entry %" ) TPRIu32 TXT( " in TOC \"%s\" has an invalid path " )
+                TXT( "string reference.\n" ) ),
+                static_cast< uint32_t >( entryIndex ),
+                *m_tocFileName );
+
+            return false;
+        }
+    }
+
+    m_pTocEntries = pEntries;
+    m_tocEntryCount = entryCount;
+    m_pTocBuckets = pBuckets;
+    m_tocBucketCount = bucketCount;
+    m_pTocStringPool = pStringPool;
+    m_tocStringPoolSize = stringPoolSize;
+
+    return true;
+}
+
+/// Finalize loading of a legacy (version 0) TOC, converting each entry to an added entry.
+///
+/// @param[in] pLoadFunction  Function to use for reading values.
+/// @param[in] pTocCurrent    Pointer to the current offset within the TOC file buffer (immediately past the version
+///                           number).
+/// @param[in] pTocMax        Pointer to the end of the TOC file buffer.
+///
+/// @return  True if the TOC load was successful, false if not.
+bool Cache::FinalizeLegacyTocLoad(
+                                  LOAD_VALUE_CALLBACK* pLoadFunction,
+                                  const uint8_t* pTocCurrent,
+                                  const uint8_t* pTocMax )
+{
+    HELIUM_ASSERT( pLoadFunction );
+
+    StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
+
     // Read the numbers of entries in the cache.
     uint32_t entryCount;
     bool bReadResult = CheckedTocRead(
@@ -605,8 +1097,6 @@ bool Cache::FinalizeTocLoad()
     }
 
     // Load the entry information.
-    EntryKey key;
-
     uint_fast32_t entryCountFast = entryCount;
     m_entries.Reserve( entryCountFast );
     for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
@@ -685,11 +1175,7 @@ bool Cache::FinalizeTocLoad()
             return false;
         }
 
-        key.path = entryPath;
-        key.subDataIndex = entrySubDataIndex;
-
-        EntryMapType::ConstAccessor entryAccessor;
-        if( m_entryMap.Find( entryAccessor, key ) )
+        if( FindEntry( entryPath, entrySubDataIndex ) )
         {
             HELIUM_TRACE(
                 TraceLevels::Error,
@@ -719,19 +1205,479 @@ bool Cache::FinalizeTocLoad()
             return false;
         }
 
-        Entry* pEntry = m_pEntryPool->Allocate();
+        Entry* pEntry = AddEntry( entryPath, entrySubDataIndex );
         HELIUM_ASSERT( pEntry );
-        pEntry->path = entryPath;
-        pEntry->subDataIndex = entrySubDataIndex;
         pEntry->offset = entryOffset;
         pEntry->timestamp = entryTimestamp;
         pEntry->size = entrySize;
+    }
+
+    return true;
+}
+
+/// Release all cache entries, including the TOC buffer they may reference.
+void Cache::ReleaseEntries()
+{
+    DefaultAllocator().Free( m_pTocBuffer );
+    m_pTocBuffer = NULL;
+
+    m_pTocEntries = NULL;
+    m_tocEntryCount = 0;
+    m_pTocBuckets = NULL;
+    m_tocBucketCount = 0;
+    m_pTocStringPool = NULL;
+    m_tocStringPoolSize = 0;
+
+    if( m_pEntryPool )
+    {
+        size_t entryCount = m_entries.GetSize();
+        for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+        {
+            Entry* pEntry = m_entries[ entryIndex ];
+            HELIUM_ASSERT( pEntry );
+            m_pEntryPool->Release( pEntry );
+        }
+    }
+
+    m_entries.Clear();
+    m_entryMap.Clear();
+    m_stringPool.Clear();
+
+    m_journalRecordCount = 0;
+}
+
+/// Finish the TOC loading process by replaying the journal and mapping the cache file if requested.
+void Cache::CompleteTocLoad()
+{
+    ReplayJournal();
+
+    if( m_bMapCacheFile && GetEntryCount() != 0 && !MapCacheFile() )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            ( TXT( "Cache::TryFinishLoadToc(): Failed to map cache file \"%s\".  Falling back to async " )
+            TXT( "loading.\n" ) ),
+            *m_cacheFileName );
+    }
+
+    m_bTocLoaded = true;
+}
+
+/// Apply the records in the journal file (if any) on top of the loaded TOC entries.
+///
+/// Replay stops at the first incomplete or corrupt record (i.e. if a write was interrupted).  Records are absolute
+/// entry states, so replaying a journal that has already been partially folded into the TOC file is harmless.
+void Cache::ReplayJournal()
+{
+    m_journalRecordCount = 0;
 
-        m_entries.Add( pEntry );
+    Status status;
+    status.Read( m_journalFileName.GetData() );
+    int64_t journalSize64 = status.m_Size;
+    if( journalSize64 <= 0 )
+    {
+        return;
+    }
+
+    if( static_cast< uint64_t >( journalSize64 ) >= UINT32_MAX )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache::ReplayJournal(): Journal file \"%s\" exceeds the maximum allowed size (2 GB).\n" ),
+            *m_journalFileName );
+
+        return;
+    }
+
+    FileStream* pJournalStream = FileStream::OpenFileStream( m_journalFileName, FileStream::MODE_READ );
+    if( !pJournalStream )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache::ReplayJournal(): Failed to open journal file \"%s\".\n" ),
+            *m_journalFileName );
+
+        return;
+    }
+
+    size_t journalSize = static_cast< size_t >( journalSize64 );
 
-        HELIUM_VERIFY( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) );
+    DefaultAllocator allocator;
+    uint8_t* pJournalBuffer = static_cast< uint8_t* >( allocator.Allocate( journalSize ) );
+    HELIUM_ASSERT( pJournalBuffer );
+    journalSize = pJournalStream->Read( pJournalBuffer, 1, journalSize );
+
+    delete pJournalStream;
+
+    StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
+
+    const uint8_t* pJournalCurrent = pJournalBuffer;
+    const uint8_t* pJournalMax = pJournalBuffer + journalSize;
+
+    bool bJournalValid = false;
+
+    JournalHeader header;
+    if( journalSize >= sizeof( header ) )
+    {
+        MemoryCopy( &header, pJournalCurrent, sizeof( header ) );
+        pJournalCurrent += sizeof( header );
+
+        bJournalValid =
+            ( header.magic == JOURNAL_MAGIC &&
+              header.version == sm_Version &&
+              header.characterSize == sizeof( tchar_t ) );
     }
 
+    if( !bJournalValid )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            TXT( "Cache::ReplayJournal(): Journal file \"%s\" has an invalid header and will be ignored.\n" ),
+            *m_journalFileName );
+    }
+    else
+    {
+        while( pJournalCurrent < pJournalMax )
+        {
+            JournalRecord record;
+            if( static_cast< size_t >( pJournalMax - pJournalCurrent ) < sizeof( record ) )
+            {
+                bJournalValid = false;
+
+                break;
+            }
+
+            MemoryCopy( &record, pJournalCurrent, sizeof( record ) );
+
+            size_t pathByteSize = sizeof( tchar_t ) * record.pathLength;
+            if( record.pathLength == 0 ||
+                static_cast< size_t >( pJournalMax - pJournalCurrent ) - sizeof( record ) < pathByteSize )
+            {
+                bJournalValid = false;
+
+                break;
+            }
+
+            StackMemoryHeap<>::Marker stackMarker( rStackHeap );
+            tchar_t* pPathString = static_cast< tchar_t* >( rStackHeap.Allocate( pathByteSize + sizeof( tchar_t ) ) );
+            HELIUM_ASSERT( pPathString );
+            MemoryCopy( pPathString, pJournalCurrent + sizeof( record ), pathByteSize );
+            pPathString[ record.pathLength ] = TXT( '\0' );
+
+            if( ComputeJournalChecksum( record, pPathString ) != record.checksum )
+            {
+                bJournalValid = false;
+
+                break;
+            }
+
+            GameObjectPath entryPath;
+            if( !entryPath.Set( pPathString ) )
+            {
+                HELIUM_TRACE(
+                    TraceLevels::Error,
+                    TXT( "Cache::ReplayJournal(): Failed to set GameObjectPath for journal entry \"%s\".\n" ),
+                    pPathString );
+
+                bJournalValid = false;
+
+                break;
+            }
+
+            Entry* pEntry = const_cast< Entry* >( FindEntry( entryPath, record.subDataIndex ) );
+            if( !pEntry )
+            {
+                pEntry = AddEntry( entryPath, record.subDataIndex );
+                HELIUM_ASSERT( pEntry );
+            }
+
+            pEntry->offset = record.offset;
+            pEntry->timestamp = record.timestamp;
+            pEntry->size = record.size;
+
+            ++m_journalRecordCount;
+            pJournalCurrent += sizeof( record ) + pathByteSize;
+        }
+
+        if( !bJournalValid )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Warning,
+                ( TXT( "Cache::ReplayJournal(): Journal file \"%s\" is truncated or corrupt after %" ) TPRIu32
+                TXT( " records.  Remaining records will be ignored.\n" ) ),
+                *m_journalFileName,
+                m_journalRecordCount );
+        }
+    }
+
+    allocator.Free( pJournalBuffer );
+
+    // Records appended after a bad header or corrupt record would never be replayed, so rewrite the TOC and start a
+    // fresh journal right away if the cache is writable.
+    if( !bJournalValid && !m_bMapCacheFile )
+    {
+        Compact();
+    }
+}
+
+/// Search the loaded TOC hash table for an entry.
+///
+/// The path name hash is computed directly from the components of the path and the path name string is only built
+/// up for comparison against the string pool for entries with a matching hash, so no memory is allocated.
+///
+/// @param[in] path          GameObject path.
+/// @param[in] subDataIndex  Sub-data index associated with the cached data.
+///
+/// @return  Pointer to the TOC entry if found, null pointer if not found.
+const Cache::Entry* Cache::FindTocEntry( GameObjectPath path, uint32_t subDataIndex ) const
+{
+    HELIUM_ASSERT( !path.IsEmpty() );
+    HELIUM_ASSERT( m_pTocEntries );
+    HELIUM_ASSERT( m_pTocBuckets );
+    HELIUM_ASSERT( m_pTocStringPool );
+
+    uint32_t pathLength = 0;
+    uint32_t pathHash = AccumulatePathHash( path, 2166136261U, pathLength );
+    uint32_t bucketIndex = pathHash & ( m_tocBucketCount - 1 );
+
+    uint_fast32_t entryEnd = m_pTocBuckets[ bucketIndex + 1 ];
+    for( uint_fast32_t entryIndex = m_pTocBuckets[ bucketIndex ]; entryIndex < entryEnd; ++entryIndex )
+    {
+        const Entry& rEntry = m_pTocEntries[ entryIndex ];
+        if( rEntry.pathHash != pathHash || rEntry.subDataIndex != subDataIndex || rEntry.pathLength != pathLength )
+        {
+            continue;
+        }
+
+        const tchar_t* pPathString = m_pTocStringPool + rEntry.pathOffset;
+        if( MatchPathString( path, pPathString ) && *pPathString == TXT( '\0' ) )
+        {
+            return &rEntry;
+        }
+    }
+
+    return NULL;
+}
+
+/// Add a new entry to the cache.
+///
+/// The entry offset, timestamp, and size are left zeroed for the caller to fill in.
+///
+/// @param[in] path          GameObject path.
+/// @param[in] subDataIndex  Sub-data index associated with the cached data.
+///
+/// @return  Newly added entry.
+Cache::Entry* Cache::AddEntry( GameObjectPath path, uint32_t subDataIndex )
+{
+    HELIUM_ASSERT( m_pEntryPool );
+
+    String pathString;
+    path.ToString( pathString );
+
+    size_t pathLength = pathString.GetSize();
+    size_t stringPoolSize = m_stringPool.GetSize();
+    HELIUM_ASSERT( m_tocStringPoolSize + stringPoolSize + pathLength + 1 <= UINT32_MAX );
+
+    m_stringPool.Resize( stringPoolSize + pathLength + 1 );
+    MemoryCopy( m_stringPool.GetData() + stringPoolSize, *pathString, sizeof( tchar_t ) * pathLength );
+    m_stringPool[ stringPoolSize + pathLength ] = TXT( '\0' );
+
+    Entry* pEntry = m_pEntryPool->Allocate();
+    HELIUM_ASSERT( pEntry );
+    pEntry->offset = 0;
+    pEntry->timestamp = 0;
+    pEntry->pathHash = ComputePathHash( *pathString, pathLength );
+    pEntry->pathOffset = static_cast< uint32_t >( m_tocStringPoolSize + stringPoolSize );
+    pEntry->pathLength = static_cast< uint32_t >( pathLength );
+    pEntry->subDataIndex = subDataIndex;
+    pEntry->size = 0;
+    pEntry->reserved = 0;
+
+    m_entries.Push( pEntry );
+
+    EntryKey key;
+    key.path = path;
+    key.subDataIndex = subDataIndex;
+
+    EntryMapType::Accessor entryAccessor;
+    HELIUM_VERIFY( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) );
+
+    return pEntry;
+}
+
+/// Rewrite the TOC file from the current set of cache entries.
+///
+/// Entries are sorted into hash buckets using a counting sort and their path name strings are packed into a single
+/// string pool so that the resulting file can be used in place by FinalizeTocLoad().
+///
+/// @return  True if the TOC file was written successfully, false if not.
+bool Cache::WriteToc()
+{
+    HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Rewriting TOC file \"%s\".\n" ), *m_tocFileName );
+
+    uint32_t entryCount = GetEntryCount();
+
+    // Use a power-of-two bucket count no smaller than the entry count, keeping the average bucket size at or below one
+    // entry.
+    uint32_t bucketCount = 1;
+    while( bucketCount < entryCount )
+    {
+        bucketCount <<= 1;
+    }
+
+    uint32_t bucketMask = bucketCount - 1;
+
+    DynamicArray< uint32_t > buckets;
+    buckets.Resize( bucketCount + 1 );
+    MemoryZero( buckets.GetData(), sizeof( uint32_t ) * ( bucketCount + 1 ) );
+
+    for( uint_fast32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        const Entry& rEntry = GetEntry( static_cast< uint32_t >( entryIndex ) );
+        ++buckets[ ( rEntry.pathHash & bucketMask ) + 1 ];
+    }
+
+    for( uint_fast32_t bucketIndex = 1; bucketIndex <= bucketCount; ++bucketIndex )
+    {
+        buckets[ bucketIndex ] += buckets[ bucketIndex - 1 ];
+    }
+
+    DynamicArray< uint32_t > bucketCursors;
+    bucketCursors.Resize( bucketCount );
+    MemoryCopy( bucketCursors.GetData(), buckets.GetData(), sizeof( uint32_t ) * bucketCount );
+
+    DynamicArray< Entry > sortedEntries;
+    sortedEntries.Resize( entryCount );
+
+    DynamicArray< tchar_t > stringPool;
+    for( uint_fast32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        const Entry& rEntry = GetEntry( static_cast< uint32_t >( entryIndex ) );
+        const tchar_t* pPathString = GetEntryPathString( rEntry );
+
+        Entry& rSortedEntry = sortedEntries[ bucketCursors[ rEntry.pathHash & bucketMask ]++ ];
+        rSortedEntry = rEntry;
+
+        size_t stringPoolSize = stringPool.GetSize();
+        rSortedEntry.pathOffset = static_cast< uint32_t >( stringPoolSize );
+
+        stringPool.Resize( stringPoolSize + rEntry.pathLength + 1 );
+        MemoryCopy(
+            stringPool.GetData() + stringPoolSize,
+            pPathString,
+            sizeof( tchar_t ) * ( rEntry.pathLength + 1 ) );
+    }
+
+    FileStream* pTocStream = FileStream::OpenFileStream( m_tocFileName, FileStream::MODE_WRITE, true );
+    if( !pTocStream )
+    {
+        HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *m_tocFileName );
+
+        return false;
+    }
+
+    TocHeader header;
+    header.magic = TOC_MAGIC;
+    header.version = sm_Version;
+    header.entryCount = entryCount;
+    header.bucketCount = bucketCount;
+    header.stringPoolSize = static_cast< uint32_t >( stringPool.GetSize() );
+    header.characterSize = sizeof( tchar_t );
+
+    BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
+    HELIUM_ASSERT( pBufferedStream );
+
+    pBufferedStream->Write( &header, sizeof( header ), 1 );
+    pBufferedStream->Write( sortedEntries.GetData(), sizeof( Entry ), entryCount );
+    pBufferedStream->Write( buckets.GetData(), sizeof( uint32_t ), bucketCount + 1 );
+    pBufferedStream->Write( stringPool.GetData(), sizeof( tchar_t ), stringPool.GetSize() );
+
+    delete pBufferedStream;
+    delete pTocStream;
+
+    return true;
+}
+
+/// Serialize a journal record for the given entry to the end of a buffer.
+///
+/// @param[in] rBuffer  Buffer to which the record should be appended.
+/// @param[in] rEntry   Cache entry.
+///
+/// @see AppendJournal()
+void Cache::WriteJournalRecord( DynamicArray< uint8_t >& rBuffer, const Entry& rEntry ) const
+{
+    const tchar_t* pPathString = GetEntryPathString( rEntry );
+
+    JournalRecord record;
+    record.offset = rEntry.offset;
+    record.timestamp = rEntry.timestamp;
+    record.subDataIndex = rEntry.subDataIndex;
+    record.size = rEntry.size;
+    record.pathLength = rEntry.pathLength;
+    record.checksum = ComputeJournalChecksum( record, pPathString );
+
+    size_t pathByteSize = sizeof( tchar_t ) * rEntry.pathLength;
+    size_t bufferSize = rBuffer.GetSize();
+    rBuffer.Resize( bufferSize + sizeof( record ) + pathByteSize );
+
+    uint8_t* pRecordData = rBuffer.GetData() + bufferSize;
+    MemoryCopy( pRecordData, &record, sizeof( record ) );
+    MemoryCopy( pRecordData + sizeof( record ), pPathString, pathByteSize );
+}
+
+/// Append a set of serialized records to the journal file, writing the journal header first if necessary.
+///
+/// @param[in] rBuffer      Serialized journal records (see WriteJournalRecord()).
+/// @param[in] recordCount  Number of records in the buffer.
+///
+/// @return  True if the records were written successfully, false if not.
+bool Cache::AppendJournal( const DynamicArray< uint8_t >& rBuffer, uint32_t recordCount )
+{
+    FileStream* pJournalStream = FileStream::OpenFileStream( m_journalFileName, FileStream::MODE_WRITE, false );
+    if( !pJournalStream )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache: Failed to open journal \"%s\" for writing.\n" ),
+            *m_journalFileName );
+
+        return false;
+    }
+
+    bool bResult = true;
+
+    int64_t journalOffset = pJournalStream->Seek( 0, SeekOrigins::SEEK_ORIGIN_END );
+    if( journalOffset == 0 )
+    {
+        JournalHeader header;
+        header.magic = JOURNAL_MAGIC;
+        header.version = sm_Version;
+        header.characterSize = sizeof( tchar_t );
+
+        bResult = ( pJournalStream->Write( &header, sizeof( header ), 1 ) == 1 );
+    }
+
+    if( bResult )
+    {
+        size_t bufferSize = rBuffer.GetSize();
+        bResult = ( journalOffset >= 0 && pJournalStream->Write( rBuffer.GetData(), 1, bufferSize ) == bufferSize );
+    }
+
+    delete pJournalStream;
+
+    if( !bResult )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Cache: Failed to append %" ) TPRIu32 TXT( " records to journal \"%s\".\n" ),
+            recordCount,
+            *m_journalFileName );
+
+        return false;
+    }
+
+    m_journalRecordCount += recordCount;
+
     return true;
 }
 
@@ -775,6 +1721,210 @@ bool Cache::CheckedTocRead(
     return true;
 }
 
+/// Reverse the byte order of a value from the cache TOC in place.
+///
+/// @param[in,out] rValue  Value to byte swap.
+template< typename T >
+void Cache::SwapTocValue( T& rValue )
+{
+    T swappedValue;
+    ReverseByteOrder( &swappedValue, &rValue, sizeof( rValue ) );
+    rValue = swappedValue;
+}
+
+/// Compute the hash of an entry path name string as stored in the cache TOC.
+///
+/// This must produce the same result on every platform and build configuration, as the hash values are stored in the
+/// TOC file.  Characters are hashed by code unit value (not by their in-memory representation) so that byte-swapped
+/// TOC files can still be used with their stored hash values (32-bit FNV-1a).
+///
+/// @param[in] pString  Path name string.
+/// @param[in] length   Length of the path name string, in characters.
+///
+/// @return  Path name hash.
+uint32_t Cache::ComputePathHash( const tchar_t* pString, size_t length )
+{
+    HELIUM_ASSERT( pString || length == 0 );
+
+    return HashPathCharacters( 2166136261U, pString, length );
+}
+
+/// Continue computing a path name hash (see ComputePathHash()) over the string representation of an object path
+/// without building the string.
+///
+/// @param[in]     path     GameObject path.
+/// @param[in]     hash     Hash of the path name characters preceding the given path.
+/// @param[in,out] rLength  Length of the path name string, in characters.  The length of the string representation of
+///                         the given path is added to this.
+///
+/// @return  Path name hash.
+///
+/// @see MatchPathString()
+uint32_t Cache::AccumulatePathHash( GameObjectPath path, uint32_t hash, uint32_t& rLength )
+{
+    HELIUM_ASSERT( !path.IsEmpty() );
+
+    GameObjectPath parentPath = path.GetParent();
+    if( !parentPath.IsEmpty() )
+    {
+        hash = AccumulatePathHash( parentPath, hash, rLength );
+    }
+
+    tchar_t delimiter = ( path.IsPackage() ? HELIUM_PACKAGE_PATH_CHAR : HELIUM_OBJECT_PATH_CHAR );
+    hash = HashPathCharacters( hash, &delimiter, 1 );
+
+    Name name = path.GetName();
+    const tchar_t* pName = name.Get();
+    size_t nameLength = StringLength( pName );
+    hash = HashPathCharacters( hash, pName, nameLength );
+
+    rLength += static_cast< uint32_t >( 1 + nameLength );
+
+    uint32_t instanceIndex = path.GetInstanceIndex();
+    if( IsValid( instanceIndex ) )
+    {
+        tchar_t instanceIndexString[ 16 ];
+        size_t instanceIndexLength = GetInstanceIndexString( instanceIndex, instanceIndexString );
+        hash = HashPathCharacters( hash, instanceIndexString, instanceIndexLength );
+
+        rLength += static_cast< uint32_t >( instanceIndexLength );
+    }
+
+    return hash;
+}
+
+/// Compare the string representation of an object path against the start of a path name string without building the
+/// string representation.
+///
+/// @param[in]     path       GameObject path.
+/// @param[in,out] rpString   Path name string to compare.  On a match, this is advanced past the matched characters.
+///                           The caller must make sure the string is at least as long as the string representation of
+///                           the path.
+///
+/// @return  True if the path name string starts with the string representation of the path, false if not.
+///
+/// @see AccumulatePathHash()
+bool Cache::MatchPathString( GameObjectPath path, const tchar_t*& rpString )
+{
+    HELIUM_ASSERT( !path.IsEmpty() );
+    HELIUM_ASSERT( rpString );
+
+    GameObjectPath parentPath = path.GetParent();
+    if( !parentPath.IsEmpty() && !MatchPathString( parentPath, rpString ) )
+    {
+        return false;
+    }
+
+    tchar_t delimiter = ( path.IsPackage() ? HELIUM_PACKAGE_PATH_CHAR : HELIUM_OBJECT_PATH_CHAR );
+    if( *rpString != delimiter )
+    {
+        return false;
+    }
+
+    ++rpString;
+
+    Name name = path.GetName();
+    for( const tchar_t* pName = name.Get(); *pName != TXT( '\0' ); ++pName, ++rpString )
+    {
+        if( *rpString != *pName )
+        {
+            return false;
+        }
+    }
+
+    uint32_t instanceIndex = path.GetInstanceIndex();
+    if( IsValid( instanceIndex ) )
+    {
+        tchar_t instanceIndexString[ 16 ];
+        GetInstanceIndexString( instanceIndex, instanceIndexString );
+        for( const tchar_t* pCharacter = instanceIndexString; *pCharacter != TXT( '\0' ); ++pCharacter, ++rpString )
+        {
+            if( *rpString != *pCharacter )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/// Update a 32-bit FNV-1a hash with a sequence of path name characters.
+///
+/// Characters are hashed by code unit value (not by their in-memory representation) so that byte-swapped TOC files
+/// can still be used with their stored hash values.
+///
+/// @param[in] hash     Current hash value.
+/// @param[in] pString  Path name characters.
+/// @param[in] length   Number of characters to hash.
+///
+/// @return  Updated hash value.
+uint32_t Cache::HashPathCharacters( uint32_t hash, const tchar_t* pString, size_t length )
+{
+    HELIUM_ASSERT( pString || length == 0 );
+
+    for( size_t characterIndex = 0; characterIndex < length; ++characterIndex )
+    {
+#if HELIUM_WCHAR_T
+        uint32_t character = static_cast< uint32_t >( pString[ characterIndex ] );
+#else
+        uint32_t character = static_cast< uint8_t >( pString[ characterIndex ] );
+#endif
+        hash ^= character;
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+/// Generate the instance index suffix of an object path name string (see GameObjectPath::ToString()).
+///
+/// @param[in]  instanceIndex  Object instance index.
+/// @param[out] rString        Instance index suffix string.
+///
+/// @return  Length of the instance index suffix string, in characters.
+size_t Cache::GetInstanceIndexString( uint32_t instanceIndex, tchar_t ( &rString )[ 16 ] )
+{
+    StringPrint( rString, HELIUM_INSTANCE_PATH_CHAR_STRING TXT( "%" ) TPRIu32, instanceIndex );
+    rString[ HELIUM_ARRAY_COUNT( rString ) - 1 ] = TXT( '\0' );
+
+    return StringLength( rString );
+}
+
+/// Compute the checksum of a journal record and its path name string (32-bit FNV-1a over the record data, excluding the
+/// checksum field itself).
+///
+/// @param[in] rRecord      Journal record.
+/// @param[in] pPathString  Entry path name string (must contain at least rRecord.pathLength characters).
+///
+/// @return  Journal record checksum.
+uint32_t Cache::ComputeJournalChecksum( const JournalRecord& rRecord, const tchar_t* pPathString )
+{
+    HELIUM_ASSERT( pPathString );
+
+    JournalRecord record = rRecord;
+    record.checksum = 0;
+
+    uint32_t hash = 2166136261U;
+
+    const uint8_t* pBytes = reinterpret_cast< const uint8_t* >( &record );
+    for( size_t byteIndex = 0; byteIndex < sizeof( record ); ++byteIndex )
+    {
+        hash ^= pBytes[ byteIndex ];
+        hash *= 16777619U;
+    }
+
+    pBytes = reinterpret_cast< const uint8_t* >( pPathString );
+    size_t pathByteSize = sizeof( tchar_t ) * rRecord.pathLength;
+    for( size_t byteIndex = 0; byteIndex < pathByteSize; ++byteIndex )
+    {
+        hash ^= pBytes[ byteIndex ];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
 /// Equality comparison.
 ///
 /// @param[in] rOther  Entry key with which to compare.
@@ -800,47 +1950,70 @@ size_t Cache::EntryKeyHash::operator()( const EntryKey& rKey ) const
 }
 
 #if HELIUM_TOOLS
-void Helium::Cache::WriteCacheObjectToBuffer( Reflect::Object &_object, DynamicArray< uint8_t > &_buffer )
+/// Serialize an object into a cache payload buffer.
+///
+/// The payload is prefixed with a small header identifying its format (see PAYLOAD_HEADER_SIZE), followed by the
+/// serialized archive data, which is written directly into the buffer without any intermediate string copies.
+///
+/// @param[in]  _object  Object to serialize.
+/// @param[out] _buffer  Buffer in which to store the payload.  Any existing contents are replaced.  The buffer is left
+///                      empty if serialization produced no data.
+/// @param[in]  format   Payload format to use (typically the format of the cache in which the payload will be stored).
+///
+/// @see ReadCacheObjectFromBuffer(), GetPayloadFormat()
+void Helium::Cache::WriteCacheObjectToBuffer(
+    Reflect::Object &_object,
+    DynamicArray< uint8_t > &_buffer,
+    EPayloadFormat format )
 {
-#if USE_XML_FOR_CACHE_DATA
+    HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( PAYLOAD_FORMAT_MAX ) );
+
+    _buffer.Resize( PAYLOAD_HEADER_SIZE );
+
+    uint8_t* pHeader = _buffer.GetData();
+    pHeader[ 0 ] = static_cast< uint8_t >( PAYLOAD_MAGIC );
+    pHeader[ 1 ] = static_cast< uint8_t >( PAYLOAD_MAGIC >> 8 );
+    pHeader[ 2 ] = static_cast< uint8_t >( PAYLOAD_MAGIC >> 16 );
+    pHeader[ 3 ] = static_cast< uint8_t >( PAYLOAD_MAGIC >> 24 );
+    pHeader[ 4 ] = static_cast< uint8_t >( format );
+    pHeader[ 5 ] = sm_PayloadVersion;
+    pHeader[ 6 ] = 0;
+    pHeader[ 7 ] = 0;
+
+    if( format == PAYLOAD_FORMAT_XML )
     {
-        tstringstream xml_out_ss;
+        PayloadWriteStreamBuffer< tchar_t > streamBuffer( _buffer, PAYLOAD_HEADER_SIZE );
+        std::basic_iostream< tchar_t > xml_out_stream( &streamBuffer );
 
-        Reflect::ArchiveXML xml_out(new Reflect::TCharStream(&xml_out_ss, false), true);
+        Reflect::ArchiveXML xml_out(new Reflect::TCharStream(&xml_out_stream, false), true);
         xml_out.WriteFileHeader();
         xml_out.WriteSingleObject(_object);
         xml_out.WriteFileFooter();
         xml_out.Close();
-            
-        tstring xml_str;
-        xml_str = xml_out_ss.str();
-
-        if (xml_str.size() > 0)
-        {
-            _buffer.Resize(xml_str.size() * sizeof(tchar_t));
-            memcpy(&_buffer[0], xml_str.data(), xml_str.size() * sizeof(tchar_t));
-        }
     }
-#else
+    else
     {
-        std::stringstream ss_out;
-        Reflect::ArchiveBinary binary_out(new Reflect::CharStream(&ss_out, false, Helium::ByteOrders::LittleEndian, Helium::Reflect::CharacterEncodings::UTF_16), true);
-        binary_out.SerializeInstance( &_object );
+        PayloadWriteStreamBuffer< char > streamBuffer( _buffer, PAYLOAD_HEADER_SIZE );
+        std::iostream binary_out_stream( &streamBuffer );
 
-        // This is not an efficient way to do this
-        std::string str_out;
-        str_out = ss_out.str();
+        Reflect::ArchiveBinary binary_out(new Reflect::CharStream(&binary_out_stream, false, Helium::ByteOrders::LittleEndian, Helium::Reflect::CharacterEncodings::UTF_16), true);
+        binary_out.SerializeInstance( &_object );
+    }
 
-        if (!str_out.empty())
-        {
-            _buffer.Resize(str_out.size());
-            memcpy(&_buffer[0], str_out.data(), str_out.size());
-        }
+    if( _buffer.GetSize() == PAYLOAD_HEADER_SIZE )
+    {
+        _buffer.Resize( 0 );
     }
-#endif
 }
 #endif
 
+/// Deserialize an object from a cache payload buffer.
+///
+/// @param[in] _buffer  Payload buffer.
+///
+/// @return  Deserialized object, or a null reference if the buffer is empty or could not be deserialized.
+///
+/// @see WriteCacheObjectToBuffer()
 Reflect::ObjectPtr Helium::Cache::ReadCacheObjectFromBuffer( const DynamicArray< uint8_t > &_buffer )
 {
     if (_buffer.GetSize() == 0)
@@ -852,46 +2025,90 @@ Reflect::ObjectPtr Helium::Cache::ReadCacheObjectFromBuffer( const DynamicArray<
     return ReadCacheObjectFromBuffer(_buffer.GetData(), 0, _buffer.GetSize());
 }
 
+/// Deserialize an object from a cache payload stored within a region of memory.
+///
+/// The archive is read in place from the given memory region (no copy of the payload is made).  Payloads without a
+/// header (written prior to the introduction of payload headers) are assumed to be XML.
+///
+/// @param[in] _buffer  Base address of the memory region.
+/// @param[in] _offset  Byte offset of the payload within the memory region.
+/// @param[in] _count   Size of the payload, in bytes.
+///
+/// @return  Deserialized object, or a null reference if the payload is empty or could not be deserialized.
+///
+/// @see WriteCacheObjectToBuffer()
 Reflect::ObjectPtr Helium::Cache::ReadCacheObjectFromBuffer( const uint8_t *_buffer, const size_t _offset, const size_t _count )
 {
+    Reflect::ObjectPtr cached_object;
+
     if (_count == 0)
     {
-        Reflect::ObjectPtr null_object;
-        return null_object;
+        return cached_object;
     }
 
-    Reflect::ObjectPtr cached_object;
+    HELIUM_ASSERT( _buffer );
 
-#if USE_XML_FOR_CACHE_DATA
+    const uint8_t* pPayload = _buffer + _offset;
+    size_t payloadSize = _count;
+
+    EPayloadFormat format = PAYLOAD_FORMAT_XML;
+    if( payloadSize >= PAYLOAD_HEADER_SIZE &&
+        ( static_cast< uint32_t >( pPayload[ 0 ] ) |
+          ( static_cast< uint32_t >( pPayload[ 1 ] ) << 8 ) |
+          ( static_cast< uint32_t >( pPayload[ 2 ] ) << 16 ) |
+          ( static_cast< uint32_t >( pPayload[ 3 ] ) << 24 ) ) == PAYLOAD_MAGIC )
     {
-        tstringstream xml_ss_in;
-        xml_ss_in.write((tchar_t *)(_buffer + _offset), _count / sizeof(tchar_t));
-        //xml_ss_in.str(xml_str);
+        format = static_cast< EPayloadFormat >( pPayload[ 4 ] );
+        uint8_t version = pPayload[ 5 ];
+        if( static_cast< size_t >( format ) >= static_cast< size_t >( PAYLOAD_FORMAT_MAX ) ||
+            version > sm_PayloadVersion )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                ( TXT( "Cache::ReadCacheObjectFromBuffer(): Unsupported payload format %" ) TPRIu32 TXT( " (version %" )
+                TPRIu32 TXT( ").\n" ) ),
+                static_cast< uint32_t >( pPayload[ 4 ] ),
+                static_cast< uint32_t >( version ) );
 
-        tstring str = xml_ss_in.str();
-        FileStream* pFileStream = FileStream::OpenFileStream( TXT("test.txt"), FileStream::MODE_WRITE, true );
-        pFileStream->Write(str.c_str(), sizeof(tchar_t), str.size());
-        pFileStream->Close();
-        delete pFileStream;
+            return cached_object;
+        }
+
+        pPayload += PAYLOAD_HEADER_SIZE;
+        payloadSize -= PAYLOAD_HEADER_SIZE;
+    }
 
-        Reflect::ArchiveXML xml_in(new Reflect::TCharStream(&xml_ss_in, false), false);
+    if( format == PAYLOAD_FORMAT_XML )
+    {
+        size_t characterCount = payloadSize / sizeof( tchar_t );
+
+        // Wide character XML data can only be read in place if it is suitably aligned.
+        tstring alignedCopy;
+        const tchar_t* pCharacters = reinterpret_cast< const tchar_t* >( pPayload );
+        if( reinterpret_cast< uintptr_t >( pPayload ) % sizeof( tchar_t ) != 0 )
+        {
+            alignedCopy.resize( characterCount );
+            MemoryCopy( &alignedCopy[ 0 ], pPayload, characterCount * sizeof( tchar_t ) );
+            pCharacters = alignedCopy.data();
+        }
+
+        PayloadReadStreamBuffer< tchar_t > streamBuffer( pCharacters, characterCount );
+        std::basic_iostream< tchar_t > xml_in_stream( &streamBuffer );
+
+        Reflect::ArchiveXML xml_in(new Reflect::TCharStream(&xml_in_stream, false), false);
         xml_in.ReadFileHeader();
         xml_in.BeginReadingSingleObjects();
-        
+
         xml_in.ReadSingleObject(cached_object);
     }
-
-#else
+    else
     {
-        std::stringstream binary_ss_in;
-        binary_ss_in.write((char *)(_buffer + _offset), _count);
+        PayloadReadStreamBuffer< char > streamBuffer( reinterpret_cast< const char* >( pPayload ), payloadSize );
+        std::iostream binary_in_stream( &streamBuffer );
+
+        Reflect::ArchiveBinary binary_in(new Reflect::CharStream(&binary_in_stream, false, Helium::ByteOrders::LittleEndian, Helium::Reflect::CharacterEncodings::UTF_16), false);
 
-        Reflect::ArchiveBinary binary_in(new Reflect::CharStream(&binary_ss_in, false, Helium::ByteOrders::LittleEndian, Helium::Reflect::CharacterEncodings::UTF_16), false);
-        
         binary_in.ReadSingleObject(cached_object);
     }
 
-#endif
-
     return cached_object;
-}
\ No newline at end of file
+}
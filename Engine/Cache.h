@@ -9,8 +9,6 @@
 #ifndef HELIUM_ENGINE_CACHE_H
 #define HELIUM_ENGINE_CACHE_H
 
-#define USE_XML_FOR_CACHE_DATA 1
-
 #include "Engine/Engine.h"
 
 #include "Foundation/ConcurrentHashMap.h"
@@ -25,7 +23,7 @@ namespace Helium
     {
     public:
         /// Current cache file format version number.
-        static const uint32_t sm_Version = 0;
+        static const uint32_t sm_Version = 1;
 
         /// Default Entry pool block size (for use with modifiable caches on the PC).
         static const size_t ENTRY_POOL_BLOCK_SIZE = 64;
@@ -43,8 +41,29 @@ namespace Helium
             PLATFORM_LAST = PLATFORM_MAX - 1
         };
 
-        /// Cache entry information.  Note that the members of this struct are organized as such so as to reduce memory
-        /// overhead from padding each value.
+        /// Cached object payload formats.
+        enum EPayloadFormat
+        {
+            PAYLOAD_FORMAT_FIRST   =  0,
+            PAYLOAD_FORMAT_INVALID = -1,
+
+            /// Compact Reflect binary archive (little-endian, field-tagged).
+            PAYLOAD_FORMAT_BINARY,
+            /// Reflect XML archive (larger and slower to load, but human-readable).
+            PAYLOAD_FORMAT_XML,
+
+            PAYLOAD_FORMAT_MAX,
+            PAYLOAD_FORMAT_LAST = PAYLOAD_FORMAT_MAX - 1
+        };
+
+        /// Current cached object payload header version number.
+        static const uint8_t sm_PayloadVersion = 1;
+        /// Size of the header preceding each cached object payload, in bytes.
+        static const size_t PAYLOAD_HEADER_SIZE = 8;
+
+        /// Cache entry information.  Entries are stored as fixed-size records that can be used directly from the table
+        /// of contents buffer, so the members of this struct are organized to keep the layout identical on all
+        /// platforms (it must not be changed without bumping the cache format version number).
         struct Entry
         {
             /// Entry offset.
@@ -52,13 +71,34 @@ namespace Helium
             /// Entry timestamp.
             int64_t timestamp;
 
-            /// Entry path name.
-            GameObjectPath path;
+            /// Hash of the entry path name string (see ComputePathHash()).
+            uint32_t pathHash;
+            /// Offset of the null-terminated entry path name string within the string pool, in characters.
+            uint32_t pathOffset;
+            /// Length of the entry path name string, in characters (not including the null terminator).
+            uint32_t pathLength;
             /// Sub-data index.
             uint32_t subDataIndex;
 
             /// Entry size.
             uint32_t size;
+            /// Reserved (padding for alignment).
+            uint32_t reserved;
+        };
+
+        /// Cache entry write request (see CacheEntries()).
+        struct EntryWrite
+        {
+            /// GameObject path.
+            GameObjectPath path;
+            /// Sub-data index associated with the cached data.
+            uint32_t subDataIndex;
+            /// Data to cache.
+            const void* pData;
+            /// Timestamp value to associate with the entry in the cache.
+            int64_t timestamp;
+            /// Number of bytes to cache.
+            uint32_t size;
         };
 
         /// @name Construction/Destruction
@@ -69,7 +109,9 @@ namespace Helium
 
         /// @name Initialization
         //@{
-        bool Initialize( Name name, EPlatform platform, const tchar_t* pTocFileName, const tchar_t* pCacheFileName );
+        bool Initialize(
+            Name name, EPlatform platform, const tchar_t* pTocFileName, const tchar_t* pCacheFileName,
+            bool bMapCacheFile = false );
         void Shutdown();
         //@}
 
@@ -80,6 +122,9 @@ namespace Helium
         inline bool IsTocLoaded() const;
 
         void EnforceTocLoad();
+
+        bool Compact();
+        inline uint32_t GetJournalRecordCount() const;
         //@}
 
         /// @name Data Access
@@ -89,24 +134,92 @@ namespace Helium
 
         inline const String& GetTocFileName() const;
         inline const String& GetCacheFileName() const;
+        inline const String& GetJournalFileName() const;
 
         inline uint32_t GetEntryCount() const;
         inline const Entry& GetEntry( uint32_t index ) const;
         const Entry* FindEntry( GameObjectPath path, uint32_t subDataIndex ) const;
 
+        inline const tchar_t* GetEntryPathString( const Entry& rEntry ) const;
+        GameObjectPath GetEntryPath( const Entry& rEntry ) const;
+
         bool CacheEntry( GameObjectPath path, uint32_t subDataIndex, const void* pData, int64_t timestamp, uint32_t size );
+        bool CacheEntries( const EntryWrite* pWrites, size_t writeCount );
+
+        inline EPayloadFormat GetPayloadFormat() const;
+        inline void SetPayloadFormat( EPayloadFormat format );
         //@}
 
+        /// @name Memory-mapped Access
+        //@{
+        inline bool IsCacheFileMapped() const;
+        const uint8_t* GetMappedEntryData( const Entry& rEntry ) const;
+        //@}
+
+        /// @name Object Payload Serialization
+        //@{
 #if HELIUM_TOOLS
-        static void WriteCacheObjectToBuffer( Helium::Reflect::Object &_object, DynamicArray< uint8_t > &_buffer );
+        static void WriteCacheObjectToBuffer(
+            Helium::Reflect::Object &_object, DynamicArray< uint8_t > &_buffer,
+            EPayloadFormat format = PAYLOAD_FORMAT_BINARY );
 #endif
         static Reflect::ObjectPtr ReadCacheObjectFromBuffer( const DynamicArray< uint8_t > &_buffer );
         static Reflect::ObjectPtr ReadCacheObjectFromBuffer( const uint8_t *_buffer, const size_t _offset, const size_t _count );
+        //@}
 
     private:
         /// Value read callback.
         typedef void ( LOAD_VALUE_CALLBACK )( void* pDestination, const void* pSource, size_t byteCount );
 
+        /// Table of contents header (version 1 and later).  The header is followed by the entry records (sorted by
+        /// hash bucket), the hash bucket table (one starting entry index per bucket plus a terminating entry count),
+        /// and the string pool.
+        struct TocHeader
+        {
+            /// File magic.
+            uint32_t magic;
+            /// Cache format version number.
+            uint32_t version;
+            /// Number of entries.
+            uint32_t entryCount;
+            /// Number of hash buckets (always a power of two).
+            uint32_t bucketCount;
+            /// Size of the string pool, in characters.
+            uint32_t stringPoolSize;
+            /// Size of each string pool character, in bytes.
+            uint32_t characterSize;
+        };
+
+        /// Journal file header.  The header is followed by a sequence of journal records, each of which is immediately
+        /// followed by its entry path name string (not null-terminated).
+        struct JournalHeader
+        {
+            /// File magic.
+            uint32_t magic;
+            /// Cache format version number.
+            uint32_t version;
+            /// Size of each path name string character, in bytes.
+            uint32_t characterSize;
+        };
+
+        /// Journal record, written each time an entry is added or updated.  Journal files are only ever read back on
+        /// the platform that wrote them, so records are stored in native byte order.
+        struct JournalRecord
+        {
+            /// Entry offset.
+            uint64_t offset;
+            /// Entry timestamp.
+            int64_t timestamp;
+            /// Sub-data index.
+            uint32_t subDataIndex;
+            /// Entry size.
+            uint32_t size;
+            /// Length of the entry path name string following this record, in characters.
+            uint32_t pathLength;
+            /// Checksum of this record and its path name string (see ComputeJournalChecksum()).
+            uint32_t checksum;
+        };
+
         /// GameObject entry key.
         struct EntryKey
         {
@@ -143,6 +256,11 @@ namespace Helium
         String m_tocFileName;
         /// Cache file name.
         String m_cacheFileName;
+        /// Journal file name.
+        String m_journalFileName;
+
+        /// Format used when serializing objects for this cache.
+        EPayloadFormat m_payloadFormat;
 
         /// True if a TOC load request has been fully processed and synced (not indicative of whether the cache files
         /// actually exist, though).
@@ -155,16 +273,64 @@ namespace Helium
         /// Size of the TOC, in bytes.
         uint32_t m_tocSize;
 
-        /// Cache entry pool.
+        /// True if the cache file should be mapped into memory once the TOC has been loaded.
+        bool m_bMapCacheFile;
+        /// Base address of the memory-mapped cache file (null if not mapped).
+        const uint8_t* m_pMappedData;
+        /// Size of the memory-mapped cache file, in bytes.
+        uint64_t m_mappedSize;
+        /// Platform-specific file mapping handle.
+        void* m_pMappingHandle;
+
+        /// Entry records within the loaded TOC buffer.
+        Entry* m_pTocEntries;
+        /// Number of entry records in the loaded TOC buffer.
+        uint32_t m_tocEntryCount;
+        /// Hash bucket table within the loaded TOC buffer.
+        const uint32_t* m_pTocBuckets;
+        /// Number of hash buckets in the loaded TOC buffer.
+        uint32_t m_tocBucketCount;
+        /// String pool within the loaded TOC buffer.
+        const tchar_t* m_pTocStringPool;
+        /// Size of the string pool in the loaded TOC buffer, in characters.
+        uint32_t m_tocStringPoolSize;
+
+        /// Pool for entries added since the TOC was loaded.
         ObjectPool< Entry >* m_pEntryPool;
-        /// Cache entry information.
+        /// Entries added since the TOC was loaded (indexed after the TOC entries).
         DynamicArray< Entry* > m_entries;
-        /// Entry lookup hash map.
+        /// Lookup hash map for entries added since the TOC was loaded.
         EntryMapType m_entryMap;
+        /// String pool for entries added since the TOC was loaded (offsets continue on from the TOC string pool).
+        DynamicArray< tchar_t > m_stringPool;
+
+        /// Number of journal records not yet folded into the TOC file.
+        uint32_t m_journalRecordCount;
 
         /// @name Loading Utility Functions
         //@{
         bool FinalizeTocLoad();
+        bool FinalizeLegacyTocLoad(
+            LOAD_VALUE_CALLBACK* pLoadFunction, const uint8_t* pTocCurrent, const uint8_t* pTocMax );
+        void ReleaseEntries();
+        void CompleteTocLoad();
+        void ReplayJournal();
+        //@}
+
+        /// @name Entry Management Utility Functions
+        //@{
+        const Entry* FindTocEntry( GameObjectPath path, uint32_t subDataIndex ) const;
+        Entry* AddEntry( GameObjectPath path, uint32_t subDataIndex );
+        bool WriteToc();
+        void WriteJournalRecord( DynamicArray< uint8_t >& rBuffer, const Entry& rEntry ) const;
+        bool AppendJournal( const DynamicArray< uint8_t >& rBuffer, uint32_t recordCount );
+        //@}
+
+        /// @name Platform-specific Memory Mapping Support
+        //@{
+        bool MapCacheFile();
+        void UnmapCacheFile();
+        void AdviseMappedRange( uint64_t offset, uint64_t size ) const;
         //@}
 
         /// @name Private Static Utility Functions
@@ -172,6 +338,14 @@ namespace Helium
         template< typename T > static bool CheckedTocRead(
             LOAD_VALUE_CALLBACK* pLoadFunction, T& rValue, const tchar_t* pDescription, const uint8_t*& rpTocCurrent,
             const uint8_t* pTocMax );
+        template< typename T > static void SwapTocValue( T& rValue );
+
+        static uint32_t ComputePathHash( const tchar_t* pString, size_t length );
+        static uint32_t AccumulatePathHash( GameObjectPath path, uint32_t hash, uint32_t& rLength );
+        static bool MatchPathString( GameObjectPath path, const tchar_t*& rpString );
+        static uint32_t HashPathCharacters( uint32_t hash, const tchar_t* pString, size_t length );
+        static size_t GetInstanceIndexString( uint32_t instanceIndex, tchar_t ( &rString )[ 16 ] );
+        static uint32_t ComputeJournalChecksum( const JournalRecord& rRecord, const tchar_t* pPathString );
         //@}
     };
 }
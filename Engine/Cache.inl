@@ -17,6 +17,16 @@ namespace Helium
         return m_bTocLoaded;
     }
 
+    /// Get the number of journal records written or replayed since the TOC file was last written.
+    ///
+    /// @return  Number of journal records pending compaction.
+    ///
+    /// @see Compact()
+    uint32_t Cache::GetJournalRecordCount() const
+    {
+        return m_journalRecordCount;
+    }
+
     /// Get the name used to identify this cache.
     ///
     /// @return  Cache name.
@@ -33,6 +43,29 @@ namespace Helium
         return m_platform;
     }
 
+    /// Get the format used when serializing objects for this cache.
+    ///
+    /// Payloads are tagged with their format, so this only affects how new data is written.
+    ///
+    /// @return  Object payload format.
+    ///
+    /// @see SetPayloadFormat(), WriteCacheObjectToBuffer()
+    Cache::EPayloadFormat Cache::GetPayloadFormat() const
+    {
+        return m_payloadFormat;
+    }
+
+    /// Set the format used when serializing objects for this cache.
+    ///
+    /// @param[in] format  Object payload format.
+    ///
+    /// @see GetPayloadFormat()
+    void Cache::SetPayloadFormat( EPayloadFormat format )
+    {
+        HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( PAYLOAD_FORMAT_MAX ) );
+        m_payloadFormat = format;
+    }
+
     /// Get the path name of the cache table of contents file.
     ///
     /// @return  TOC file path name.
@@ -53,6 +86,16 @@ namespace Helium
         return m_cacheFileName;
     }
 
+    /// Get the path name of the cache journal file.
+    ///
+    /// @return  Journal file path name.
+    ///
+    /// @see GetTocFileName(), Compact()
+    const String& Cache::GetJournalFileName() const
+    {
+        return m_journalFileName;
+    }
+
     /// Get the number of object entries in this cache.
     ///
     /// @return  GameObject entry count.
@@ -60,7 +103,7 @@ namespace Helium
     /// @see GetEntry()
     uint32_t Cache::GetEntryCount() const
     {
-        size_t entryCount = m_entries.GetSize();
+        size_t entryCount = m_tocEntryCount + m_entries.GetSize();
         HELIUM_ASSERT( entryCount <= UINT32_MAX );
 
         return static_cast< uint32_t >( entryCount );
@@ -75,6 +118,14 @@ namespace Helium
     /// @see GetEntryCount()
     const Cache::Entry& Cache::GetEntry( uint32_t index ) const
     {
+        if( index < m_tocEntryCount )
+        {
+            HELIUM_ASSERT( m_pTocEntries );
+
+            return m_pTocEntries[ index ];
+        }
+
+        index -= m_tocEntryCount;
         HELIUM_ASSERT( index < m_entries.GetSize() );
 
         Entry* pEntry = m_entries[ index ];
@@ -82,4 +133,39 @@ namespace Helium
 
         return *pEntry;
     }
+
+    /// Get the path name string for the given cache entry.
+    ///
+    /// The string is owned by the cache and may be invalidated when entries are added, so it should not be held onto.
+    ///
+    /// @param[in] rEntry  Cache entry.
+    ///
+    /// @return  Null-terminated entry path name string.
+    ///
+    /// @see GetEntryPath()
+    const tchar_t* Cache::GetEntryPathString( const Entry& rEntry ) const
+    {
+        uint32_t pathOffset = rEntry.pathOffset;
+        if( pathOffset < m_tocStringPoolSize )
+        {
+            HELIUM_ASSERT( m_pTocStringPool );
+
+            return m_pTocStringPool + pathOffset;
+        }
+
+        pathOffset -= m_tocStringPoolSize;
+        HELIUM_ASSERT( pathOffset < m_stringPool.GetSize() );
+
+        return m_stringPool.GetData() + pathOffset;
+    }
+
+    /// Get whether the cache file is mapped into memory for direct read-only access.
+    ///
+    /// @return  True if the cache file is mapped, false if cache data must be loaded through the AsyncLoader.
+    ///
+    /// @see GetMappedEntryData()
+    bool Cache::IsCacheFileMapped() const
+    {
+        return ( m_pMappedData != NULL );
+    }
 }
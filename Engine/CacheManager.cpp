@@ -19,6 +19,7 @@ CacheManager* CacheManager::sm_pInstance = NULL;
 /// Constructor.
 CacheManager::CacheManager( const FilePath& rBaseDirectory )
 : m_cachePool( CACHE_POOL_BLOCK_SIZE )
+, m_bMapCacheFiles( !HELIUM_TOOLS )
 {
     m_platformDataDirectories[ Cache::PLATFORM_PC ] = rBaseDirectory.c_str();
     m_platformDataDirectories[ Cache::PLATFORM_PC ] += TXT( "DataPC/" );
@@ -78,7 +79,7 @@ Cache* CacheManager::GetCache( Name name, Cache::EPlatform platform )
 
     cacheFileName += TXT( "." ) HELIUM_CACHE_EXTENSION;
 
-    if( !pCache->Initialize( name, platform, *tocFileName, *cacheFileName ) )
+    if( !pCache->Initialize( name, platform, *tocFileName, *cacheFileName, m_bMapCacheFiles ) )
     {
         HELIUM_TRACE( TraceLevels::Error, TXT( "CacheManager: Failed to initialize cache \"%s\".\n" ), *name );
 
@@ -99,6 +100,29 @@ Cache* CacheManager::GetCache( Name name, Cache::EPlatform platform )
     return pCache;
 }
 
+/// Set whether cache files should be memory-mapped when their cache instances are created.
+///
+/// Mapped caches are read-only (CacheEntry() will fail on them), so mapping is disabled by default in tools builds.
+/// This only affects caches created after the call; existing cache instances are left unchanged.
+///
+/// @param[in] bMapCacheFiles  True to memory-map cache files, false to read them through the AsyncLoader.
+///
+/// @see GetMapCacheFiles()
+void CacheManager::SetMapCacheFiles( bool bMapCacheFiles )
+{
+    m_bMapCacheFiles = bMapCacheFiles;
+}
+
+/// Get whether cache files are memory-mapped when their cache instances are created.
+///
+/// @return  True if cache files are memory-mapped, false if they are read through the AsyncLoader.
+///
+/// @see SetMapCacheFiles()
+bool CacheManager::GetMapCacheFiles() const
+{
+    return m_bMapCacheFiles;
+}
+
 /// Get the cache data directory for the specified platform.
 ///
 /// @param[in] platform  Target platform, or Cache::PLATFORM_INVALID name to use the current platform.
@@ -30,6 +30,9 @@ namespace Helium
         /// @name Cache Access
         //@{
         Cache* GetCache( Name name, Cache::EPlatform platform = Cache::PLATFORM_INVALID );
+
+        void SetMapCacheFiles( bool bMapCacheFiles );
+        bool GetMapCacheFiles() const;
         //@}
 
         /// @name Filesystem Information
@@ -58,6 +61,9 @@ namespace Helium
         /// Cache lookup tables.
         ConcurrentHashMap< Name, Cache* > m_cacheMaps[ Cache::PLATFORM_MAX ];
 
+        /// True to memory-map the cache files of newly created (read-only) cache instances.
+        bool m_bMapCacheFiles;
+
         /// Singleton instance.
         static CacheManager* sm_pInstance;
 
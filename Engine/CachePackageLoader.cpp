@@ -12,6 +12,7 @@
 #include "Engine/BinaryDeserializer.h"
 #include "Engine/CacheManager.h"
 #include "Engine/GameObjectLoader.h"
+#include "Engine/JobContext.h"
 #include "Engine/NullLinker.h"
 #include "Engine/Resource.h"
 #include "Engine/ObjectLoaderVisitors.h"
@@ -67,8 +68,6 @@ bool CachePackageLoader::Initialize( Name cacheName )
 /// @see Initialize()
 void CachePackageLoader::Shutdown()
 {
-    DefaultAllocator allocator;
-
     AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
 
     size_t loadRequestCount = m_loadRequests.GetSize();
@@ -83,7 +82,7 @@ void CachePackageLoader::Shutdown()
                 rAsyncLoader.SyncRequest( pRequest->asyncLoadId );
             }
 
-            allocator.Free( pRequest->pAsyncLoadBuffer );
+            ReleaseLoadData( pRequest );
 
             m_loadRequestPool.Release( pRequest );
         }
@@ -148,12 +147,14 @@ size_t CachePackageLoader::BeginLoadObject( GameObjectPath path )
         LoadRequest* pRequest = m_loadRequestPool.Allocate();
         HELIUM_ASSERT( pRequest );
         pRequest->pEntry = NULL;
+        pRequest->path = path;
 
         ResolvePackage( pRequest->spObject, path );
         HELIUM_ASSERT( pRequest->spObject );
 
         SetInvalid( pRequest->asyncLoadId );
         pRequest->pAsyncLoadBuffer = NULL;
+        pRequest->pMappedData = NULL;
         pRequest->pSerializedData = NULL;
         pRequest->pPropertyStreamEnd = NULL;
         pRequest->pPersistentResourceStreamEnd = NULL;
@@ -212,9 +213,11 @@ size_t CachePackageLoader::BeginLoadObject( GameObjectPath path )
     LoadRequest* pRequest = m_loadRequestPool.Allocate();
     HELIUM_ASSERT( pRequest );
     pRequest->pEntry = pEntry;
+    pRequest->path = path;
     HELIUM_ASSERT( !pRequest->spObject );
     SetInvalid( pRequest->asyncLoadId );
     pRequest->pAsyncLoadBuffer = NULL;
+    pRequest->pMappedData = NULL;
     pRequest->pSerializedData = NULL;
     pRequest->pPropertyStreamEnd = NULL;
     pRequest->pPersistentResourceStreamEnd = NULL;
@@ -230,7 +233,7 @@ size_t CachePackageLoader::BeginLoadObject( GameObjectPath path )
 
     // If a fully-loaded object already exists with the same name, do not attempt to re-load the object (just mark
     // the request as complete).
-    pRequest->spObject = GameObject::FindObject( pEntry->path );
+    pRequest->spObject = GameObject::FindObject( path );
 
     GameObject* pObject = pRequest->spObject;
     if( pObject && pObject->IsFullyLoaded() )
@@ -247,22 +250,28 @@ size_t CachePackageLoader::BeginLoadObject( GameObjectPath path )
     {
         HELIUM_ASSERT( !pObject || !pObject->GetAnyFlagSet( GameObject::FLAG_LOADED | GameObject::FLAG_LINKED ) );
 
-        HELIUM_TRACE(
-            TraceLevels::Debug,
-            TXT( "CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n" ),
-            *path.ToString() );
+        // If the cache file is mapped into memory, deserialize straight out of the mapping instead of allocating a
+        // buffer and copying the data into it.
+        pRequest->pMappedData = m_pCache->GetMappedEntryData( *pEntry );
+        if( !pRequest->pMappedData )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Debug,
+                TXT( "CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n" ),
+                *path.ToString() );
 
-        size_t entrySize = pEntry->size;
-        pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
-        HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
-
-        AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
-        pRequest->asyncLoadId = rLoader.QueueRequest(
-            pRequest->pAsyncLoadBuffer,
-            m_pCache->GetCacheFileName(),
-            pEntry->offset,
-            entrySize );
-        HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+            size_t entrySize = pEntry->size;
+            pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
+            HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
+
+            AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+            pRequest->asyncLoadId = rLoader.QueueRequest(
+                pRequest->pAsyncLoadBuffer,
+                m_pCache->GetCacheFileName(),
+                pEntry->offset,
+                entrySize );
+            HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+        }
     }
 
     size_t requestId = m_loadRequests.Add( pRequest );
@@ -345,6 +354,7 @@ bool CachePackageLoader::TryFinishLoadObject(
 
     HELIUM_ASSERT( IsInvalid( pRequest->asyncLoadId ) );
     HELIUM_ASSERT( !pRequest->pAsyncLoadBuffer );
+    HELIUM_ASSERT( !pRequest->pMappedData );
 
     pRequest->spType.Release();
     pRequest->spTemplate.Release();
@@ -356,7 +366,7 @@ bool CachePackageLoader::TryFinishLoadObject(
         TraceLevels::Debug,
         ( TXT( "CachePackageLoader::TryFinishLoadObject(): Load request for \"%s\" (ID: %" ) TPRIuSZ TXT( ") " )
         TXT( "synced.\n" ) ),
-        *( pObject ? pObject->GetPath() : pRequest->pEntry->path ).ToString(),
+        *pRequest->path.ToString(),
         requestId );
 
     m_loadRequests.Remove( requestId );
@@ -382,7 +392,9 @@ void CachePackageLoader::Tick()
 
         if( !( pRequest->flags & LOAD_FLAG_PRELOADED ) )
         {
-            if( IsValid( pRequest->asyncLoadId ) )
+            // Link tables still need to be read either once the async load completes or, for mapped cache data, on
+            // the first tick.
+            if( IsValid( pRequest->asyncLoadId ) || ( pRequest->pMappedData && !pRequest->pSerializedData ) )
             {
                 if( !TickCacheLoad( pRequest ) )
                 {
@@ -397,12 +409,23 @@ void CachePackageLoader::Tick()
                 {
                     continue;
                 }
+
+                // Object data is deserialized for all ready requests at once below.
+                if( !( pRequest->flags & LOAD_FLAG_PRELOADED ) )
+                {
+                    m_deserializeRequests.Push( pRequest );
+
+                    continue;
+                }
             }
         }
 
         HELIUM_ASSERT( IsInvalid( pRequest->asyncLoadId ) );
         HELIUM_ASSERT( pRequest->pAsyncLoadBuffer == NULL );
+        HELIUM_ASSERT( pRequest->pMappedData == NULL );
     }
+
+    DeserializeReadyRequests();
 }
 
 /// @copydoc PackageLoader::GetObjectCount()
@@ -421,7 +444,7 @@ GameObjectPath CachePackageLoader::GetObjectPath( size_t index ) const
 
     const Cache::Entry& rEntry = m_pCache->GetEntry( static_cast< uint32_t >( index ) );
 
-    return rEntry.path;
+    return m_pCache->GetEntryPath( rEntry );
 }
 
 /// @copydoc PackageLoader::IsSourcePackageFile()
@@ -446,15 +469,25 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
     HELIUM_ASSERT( pRequest );
     HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
 
-    AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
-
+    const uint8_t* pData = pRequest->pMappedData;
     size_t bytesRead = 0;
-    if( !rAsyncLoader.TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+    if( pData )
     {
-        return false;
+        HELIUM_ASSERT( pRequest->pEntry );
+        bytesRead = pRequest->pEntry->size;
     }
+    else
+    {
+        AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+        if( !rAsyncLoader.TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+        {
+            return false;
+        }
 
-    SetInvalid( pRequest->asyncLoadId );
+        SetInvalid( pRequest->asyncLoadId );
+
+        pData = pRequest->pAsyncLoadBuffer;
+    }
 
     if( bytesRead == 0 || IsInvalid( bytesRead ) )
     {
@@ -463,11 +496,11 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
         HELIUM_TRACE(
             TraceLevels::Error,
             TXT( "CachePackageLoader: Failed to read cache data for object \"%s\".\n" ),
-            *pRequest->pEntry->path.ToString() );
+            *pRequest->path.ToString() );
     }
     else
     {
-        uint8_t* pBufferEnd = pRequest->pAsyncLoadBuffer + bytesRead;
+        const uint8_t* pBufferEnd = pData + bytesRead;
         pRequest->pPropertyStreamEnd = pBufferEnd;
         pRequest->pPersistentResourceStreamEnd = pBufferEnd;
 
@@ -479,8 +512,7 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 
     // An error occurred attempting to load the property data, so mark any existing object as fully loaded (nothing
     // else will be done with the object itself from here on out).
-    DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-    pRequest->pAsyncLoadBuffer = NULL;
+    ReleaseLoadData( pRequest );
 
     GameObject* pObject = pRequest->spObject;
     if( pObject )
@@ -496,9 +528,14 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 
 /// Tick the object deserialization process for the given object load request.
 ///
+/// This waits for the template and owner objects to load and creates the object, after which the request is ready to
+/// have its object data deserialized using DeserializeObject().  If an error occurs, the request is flagged as
+/// preloaded with an error instead.
+///
 /// @param[in] pRequest  Load request.
 ///
-/// @return  True if the deserialization process has completed, false if it still needs time to process.
+/// @return  True if the object is ready to be deserialized or the load failed, false if the request is still waiting
+///          on other objects.
 bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 {
     HELIUM_ASSERT( pRequest );
@@ -506,8 +543,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 
     GameObject* pObject = pRequest->spObject;
 
-    const Cache::Entry* pCacheEntry = pRequest->pEntry;
-    HELIUM_ASSERT( pCacheEntry );
+    HELIUM_ASSERT( pRequest->pEntry );
 
     // Wait for the template and owner objects to load.
     GameObjectLoader* pObjectLoader = GameObjectLoader::GetStaticInstance();
@@ -529,7 +565,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
             HELIUM_TRACE(
                 TraceLevels::Error,
                 TXT( "CachePackageLoader: Failed to load template object for \"%s\".\n" ),
-                *pCacheEntry->path.ToString() );
+                *pRequest->path.ToString() );
 
             if( pObject )
             {
@@ -537,8 +573,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
                 pObject->ConditionalFinalizeLoad();
             }
 
-            DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-            pRequest->pAsyncLoadBuffer = NULL;
+            ReleaseLoadData( pRequest );
 
             pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -564,7 +599,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
             HELIUM_TRACE(
                 TraceLevels::Error,
                 TXT( "CachePackageLoader: Failed to load owner object for \"%s\".\n" ),
-                *pCacheEntry->path.ToString() );
+                *pRequest->path.ToString() );
 
             if( pObject )
             {
@@ -572,8 +607,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
                 pObject->ConditionalFinalizeLoad();
             }
 
-            DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-            pRequest->pAsyncLoadBuffer = NULL;
+            ReleaseLoadData( pRequest );
 
             pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -600,15 +634,14 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
                 TraceLevels::Error,
                 ( TXT( "CachePackageLoader: Cannot load \"%s\" using the existing object as the types do not " )
                 TXT( "match (existing type: \"%s\"; serialized type: \"%s\".\n" ) ),
-                *pCacheEntry->path.ToString(),
+                *pRequest->path.ToString(),
                 *pExistingType->GetName(),
                 *pType->GetName() );
 
             pObject->SetFlags( GameObject::FLAG_PRELOADED | GameObject::FLAG_LINKED );
             pObject->ConditionalFinalizeLoad();
 
-            DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-            pRequest->pAsyncLoadBuffer = NULL;
+            ReleaseLoadData( pRequest );
 
             pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -618,15 +651,14 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
     else
     {
         // Create the object.
-        if( !GameObject::CreateObject( pRequest->spObject, pType, pCacheEntry->path.GetName(), pOwner, pTemplate ) )
+        if( !GameObject::CreateObject( pRequest->spObject, pType, pRequest->path.GetName(), pOwner, pTemplate ) )
         {
             HELIUM_TRACE(
                 TraceLevels::Error,
                 TXT( "CachePackageLoader: Failed to create \"%s\" during loading.\n" ),
-                *pCacheEntry->path.ToString() );
+                *pRequest->path.ToString() );
 
-            DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-            pRequest->pAsyncLoadBuffer = NULL;
+            ReleaseLoadData( pRequest );
 
             pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -636,65 +668,83 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
         pObject = pRequest->spObject;
         HELIUM_ASSERT( pObject );
     }
-        
-    Reflect::ObjectPtr cached_object = Cache::ReadCacheObjectFromBuffer(pRequest->pSerializedData, 0, pRequest->pPropertyStreamEnd - pRequest->pSerializedData);
 
-    if (!cached_object.ReferencesObject())
+    // GameObject is ready to be deserialized.
+    return true;
+}
+
+/// Deserialize the objects for all load requests that became ready for deserialization during the current tick.
+///
+/// Deserialization is performed in parallel using the job system when there are enough objects to deserialize.
+void CachePackageLoader::DeserializeReadyRequests()
+{
+    size_t requestCount = m_deserializeRequests.GetSize();
+    if( requestCount == 0 )
     {
-        HELIUM_TRACE(
-            TraceLevels::Error,
-            TXT( "CachePackageLoader: Failed to deserialize object \"%s\".\n" ),
-            *pCacheEntry->path.ToString() );
+        return;
+    }
 
-        // Clear out object references (object can now be considered fully loaded as well).
-        // pmd - Not sure that we need to do this.. but if we do, just use this visitor
-        //ClearLinkIndicesFromObject clifo_visitor;
-        //pObject->Accept(clifo_visitor);
-        pObject->SetFlags( GameObject::FLAG_LINKED );
-        pObject->ConditionalFinalizeLoad();
+    LoadRequest* const* ppRequests = m_deserializeRequests.GetData();
 
-        pRequest->flags |= LOAD_FLAG_ERROR;
+    size_t jobCount = requestCount / DESERIALIZE_JOB_REQUEST_COUNT_MIN;
+    if( jobCount > DESERIALIZE_JOB_COUNT_MAX )
+    {
+        jobCount = DESERIALIZE_JOB_COUNT_MAX;
+    }
+
+    if( jobCount < 2 )
+    {
+        // Not enough work to be worth running in parallel.
+        for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+        {
+            DeserializeObject( ppRequests[ requestIndex ] );
+        }
     }
     else
     {
-        cached_object->CopyTo(pObject);
-                
-        if( !pObject->IsDefaultTemplate() )
+        JobContext::Spawner< DESERIALIZE_JOB_COUNT_MAX > rootSpawner;
+
+        size_t startIndex = 0;
+        for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
         {
-            // Load persistent resource data.
-            Resource* pResource = Reflect::SafeCast< Resource >( pObject );
-            if( pResource )
-            {
-                Reflect::ObjectPtr cached_prd = Cache::ReadCacheObjectFromBuffer(
-                    pRequest->pPropertyStreamEnd, 
-                    0, 
-                    (pRequest->pPersistentResourceStreamEnd - pRequest->pPropertyStreamEnd));
+            size_t endIndex = requestCount * ( jobIndex + 1 ) / jobCount;
 
-                if (!cached_prd.ReferencesObject())
-                {
-                    HELIUM_TRACE(
-                        TraceLevels::Error,
-                        ( TXT( "CachePackageLoader: Failed to deserialize persistent resource " )
-                        TXT( "data for \"%s\".\n" ) ),
-                        *pCacheEntry->path.ToString() );
-                }
-                else
-                {
-                    pResource->LoadPersistentResourceObject(cached_prd);
-                }
-            }
+            JobContext* pContext = rootSpawner.Allocate();
+            HELIUM_ASSERT( pContext );
+            DeserializeJob* pJob = pContext->Create< DeserializeJob >();
+            HELIUM_ASSERT( pJob );
+            DeserializeJob::Parameters& rParameters = pJob->GetParameters();
+            rParameters.ppRequests = ppRequests + startIndex;
+            rParameters.requestCount = endIndex - startIndex;
+
+            startIndex = endIndex;
         }
     }
 
-    DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-    pRequest->pAsyncLoadBuffer = NULL;
+    for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+    {
+        FinishDeserialize( ppRequests[ requestIndex ] );
+    }
 
-    pObject->SetFlags( GameObject::FLAG_PRELOADED );
+    m_deserializeRequests.Resize( 0 );
+}
 
-    pRequest->flags |= LOAD_FLAG_PRELOADED;
+/// Run the DeserializeJob job.
+///
+/// @param[in] pContext  Context in which this job is running.
+void CachePackageLoader::DeserializeJob::Run( JobContext* /*pContext*/ )
+{
+    LoadRequest* const* ppRequests = m_parameters.ppRequests;
+    size_t requestCount = m_parameters.requestCount;
+    HELIUM_ASSERT( ppRequests || requestCount == 0 );
 
-    // GameObject is now preloaded.
-    return true;
+    for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+    {
+        DeserializeObject( ppRequests[ requestIndex ] );
+    }
+
+    JobManager& rJobManager = JobManager::GetStaticInstance();
+    rJobManager.ReleaseJob( this );
 }
 
 /// Recursive function for resolving a package request.
@@ -726,6 +776,12 @@ void CachePackageLoader::ResolvePackage( GameObjectPtr& rspPackage, GameObjectPa
     }
 
     rspPackage->SetFlags( GameObject::FLAG_PRELOADED | GameObject::FLAG_LINKED | GameObject::FLAG_LOADED );
+
+    Package* pPackage = Reflect::SafeCast< Package >( rspPackage.Get() );
+    if( pPackage )
+    {
+        ConditionalEnablePackageArena( pPackage );
+    }
 }
 
 /// Deserialize the link tables for an object load.
@@ -735,8 +791,9 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
 {
     HELIUM_ASSERT( pRequest );
 
-    uint8_t* pBufferCurrent = pRequest->pAsyncLoadBuffer;
-    uint8_t* pPropertyStreamEnd = pRequest->pPropertyStreamEnd;
+    const uint8_t* pBufferCurrent =
+        ( pRequest->pMappedData ? pRequest->pMappedData : pRequest->pAsyncLoadBuffer );
+    const uint8_t* pPropertyStreamEnd = pRequest->pPropertyStreamEnd;
     HELIUM_ASSERT( pBufferCurrent );
     HELIUM_ASSERT( pPropertyStreamEnd );
     HELIUM_ASSERT( pBufferCurrent <= pPropertyStreamEnd );
@@ -747,7 +804,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
         HELIUM_TRACE(
             TraceLevels::Error,
             TXT( "CachePackageLoader: End of buffer reached when attempting to deserialize \"%s\".\n" ),
-            *pRequest->pEntry->path.ToString() );
+            *pRequest->path.ToString() );
 
         return false;
     }
@@ -762,7 +819,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
             ( TXT( "CachePackageLoader: Property stream size (%" ) TPRIu32 TXT( " bytes) for \"%s\" exceeds the " )
             TXT( "amount of data cached.  Value will be clamped.\n" ) ),
             propertyStreamSize,
-            *pRequest->pEntry->path.ToString() );
+            *pRequest->path.ToString() );
 
         propertyStreamSize = static_cast< uint32_t >( pPropertyStreamEnd - pBufferCurrent );
     }
@@ -790,7 +847,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
         HELIUM_TRACE(
             TraceLevels::Error,
             TXT( "CachePackageLoader: End of buffer reached when attempting to deserialize \"%s\".\n" ),
-            *pRequest->pEntry->path.ToString() );
+            *pRequest->path.ToString() );
 
         return false;
     }
@@ -810,7 +867,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
             HELIUM_TRACE(
                 TraceLevels::Error,
                 TXT( "CachePackageLoader: End of buffer reached when attempting to deserialize \"%s\".\n" ),
-                *pRequest->pEntry->path.ToString() );
+                *pRequest->path.ToString() );
 
             return false;
         }
@@ -823,7 +880,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
             HELIUM_TRACE(
                 TraceLevels::Error,
                 TXT( "CachePackageLoader: End of buffer reached when attempting to deserialize \"%s\".\n" ),
-                *pRequest->pEntry->path.ToString() );
+                *pRequest->path.ToString() );
 
             return false;
         }
@@ -847,7 +904,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
                 TraceLevels::Error,
                 TXT( "CachePackageLoader: Failed to locate type \"%s\" when attempting to deserialize \"%s\".\n" ),
                 pTypeNameString,
-                *pRequest->pEntry->path.ToString() );
+                *pRequest->path.ToString() );
         }
 
         pRequest->typeLinkTable.Push( pType );
@@ -860,7 +917,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
         HELIUM_TRACE(
             TraceLevels::Error,
             TXT( "CachePackageLoader: End of buffer reached when attempting to deserialize \"%s\".\n" ),
-            *pRequest->pEntry->path.ToString() );
+            *pRequest->path.ToString() );
 
         return false;
     }
@@ -893,7 +950,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
             HELIUM_TRACE(
                 TraceLevels::Error,
                 TXT( "CachePackageLoader: End of buffer reached when attempting to deserialize \"%s\".\n" ),
-                *pRequest->pEntry->path.ToString() );
+                *pRequest->path.ToString() );
 
             return false;
         }
@@ -906,7 +963,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
             HELIUM_TRACE(
                 TraceLevels::Error,
                 TXT( "CachePackageLoader: End of buffer reached when attempting to deserialize \"%s\".\n" ),
-                *pRequest->pEntry->path.ToString() );
+                *pRequest->path.ToString() );
 
             return false;
         }
@@ -932,7 +989,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
                 ( TXT( "CachePackageLoader: Invalid object path \"%s\" found in linker table when deserializing " )
                 TXT( "\"%s\".  Setting to null.\n" ) ),
                 pPathString,
-                *pRequest->pEntry->path.ToString() );
+                *pRequest->path.ToString() );
 
             pRequest->flags |= LOAD_FLAG_ERROR;
         }
@@ -949,7 +1006,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
                     ( TXT( "CachePackageLoader: Failed to begin loading \"%s\" as a link dependency for \"%s\".  " )
                     TXT( "Setting to null.\n" ) ),
                     pPathString,
-                    *pRequest->pEntry->path.ToString() );
+                    *pRequest->path.ToString() );
 
                 pRequest->flags |= LOAD_FLAG_ERROR;
             }
@@ -965,7 +1022,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
         HELIUM_TRACE(
             TraceLevels::Error,
             TXT( "CachePackageLoader: End of buffer reached when attempting to deserialize \"%s\".\n" ),
-            *pRequest->pEntry->path.ToString() );
+            *pRequest->path.ToString() );
 
         return false;
     }
@@ -978,7 +1035,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
         HELIUM_TRACE(
             TraceLevels::Error,
             TXT( "CachePackageLoader: Invalid link table index for the type of \"%s\".\n" ),
-            *pRequest->pEntry->path.ToString() );
+            *pRequest->path.ToString() );
 
         return false;
     }
@@ -989,7 +1046,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
         HELIUM_TRACE(
             TraceLevels::Error,
             TXT( "CachePackageLoader: Type not found for object \"%s\".\n" ),
-            *pRequest->pEntry->path.ToString() );
+            *pRequest->path.ToString() );
 
         return false;
     }
@@ -1002,7 +1059,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
         HELIUM_TRACE(
             TraceLevels::Error,
             TXT( "CachePackageLoader: End of buffer reached when attempting to deserialize \"%s\".\n" ),
-            *pRequest->pEntry->path.ToString() );
+            *pRequest->path.ToString() );
 
         return false;
     }
@@ -1017,7 +1074,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
             HELIUM_TRACE(
                 TraceLevels::Error,
                 TXT( "CachePackageLoader: Invalid link table index for the template of \"%s\".\n" ),
-                *pRequest->pEntry->path.ToString() );
+                *pRequest->path.ToString() );
 
             SetInvalid( pRequest->templateLinkIndex );
 
@@ -1036,7 +1093,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
         HELIUM_TRACE(
             TraceLevels::Error,
             TXT( "CachePackageLoader: End of buffer reached when attempting to deserialize \"%s\".\n" ),
-            *pRequest->pEntry->path.ToString() );
+            *pRequest->path.ToString() );
 
         return false;
     }
@@ -1051,7 +1108,7 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
             HELIUM_TRACE(
                 TraceLevels::Error,
                 TXT( "CachePackageLoader: Invalid link table index for the owner of \"%s\".\n" ),
-                *pRequest->pEntry->path.ToString() );
+                *pRequest->path.ToString() );
 
             SetInvalid( pRequest->ownerLinkIndex );
 
@@ -1067,3 +1124,111 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
 
     return true;
 }
+
+/// Deserialize the property data and any persistent resource data for a load request's object.
+///
+/// This only touches the given load request and its object, so it can be run for different requests in parallel.
+/// Errors are recorded in the request flags and handled by FinishDeserialize().
+///
+/// @param[in] pRequest  Load request with its object created and ready for deserialization.
+///
+/// @see FinishDeserialize()
+void CachePackageLoader::DeserializeObject( LoadRequest* pRequest )
+{
+    HELIUM_ASSERT( pRequest );
+    HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
+
+    GameObject* pObject = pRequest->spObject;
+    HELIUM_ASSERT( pObject );
+
+    Reflect::ObjectPtr cached_object = Cache::ReadCacheObjectFromBuffer(pRequest->pSerializedData, 0, pRequest->pPropertyStreamEnd - pRequest->pSerializedData);
+
+    if (!cached_object.ReferencesObject())
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "CachePackageLoader: Failed to deserialize object \"%s\".\n" ),
+            *pRequest->path.ToString() );
+
+        pRequest->flags |= LOAD_FLAG_ERROR;
+
+        return;
+    }
+
+    cached_object->CopyTo(pObject);
+
+    if( !pObject->IsDefaultTemplate() )
+    {
+        // Load persistent resource data.
+        Resource* pResource = Reflect::SafeCast< Resource >( pObject );
+        if( pResource )
+        {
+            Reflect::ObjectPtr cached_prd = Cache::ReadCacheObjectFromBuffer(
+                pRequest->pPropertyStreamEnd, 
+                0, 
+                (pRequest->pPersistentResourceStreamEnd - pRequest->pPropertyStreamEnd));
+
+            if (!cached_prd.ReferencesObject())
+            {
+                HELIUM_TRACE(
+                    TraceLevels::Error,
+                    ( TXT( "CachePackageLoader: Failed to deserialize persistent resource " )
+                    TXT( "data for \"%s\".\n" ) ),
+                    *pRequest->path.ToString() );
+            }
+            else
+            {
+                pResource->LoadPersistentResourceObject(cached_prd);
+            }
+        }
+    }
+}
+
+/// Finish the preload process for a load request once its object has been deserialized.
+///
+/// @param[in] pRequest  Load request.
+///
+/// @see DeserializeObject()
+void CachePackageLoader::FinishDeserialize( LoadRequest* pRequest )
+{
+    HELIUM_ASSERT( pRequest );
+    HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
+
+    GameObject* pObject = pRequest->spObject;
+    HELIUM_ASSERT( pObject );
+
+    if( pRequest->flags & LOAD_FLAG_ERROR )
+    {
+        // Clear out object references (object can now be considered fully loaded as well).
+        // pmd - Not sure that we need to do this.. but if we do, just use this visitor
+        //ClearLinkIndicesFromObject clifo_visitor;
+        //pObject->Accept(clifo_visitor);
+        pObject->SetFlags( GameObject::FLAG_LINKED );
+        pObject->ConditionalFinalizeLoad();
+    }
+
+    ReleaseLoadData( pRequest );
+
+    pObject->SetFlags( GameObject::FLAG_PRELOADED );
+
+    pRequest->flags |= LOAD_FLAG_PRELOADED;
+
+    HELIUM_ASSERT( IsInvalid( pRequest->asyncLoadId ) );
+    HELIUM_ASSERT( pRequest->pAsyncLoadBuffer == NULL );
+    HELIUM_ASSERT( pRequest->pMappedData == NULL );
+}
+
+/// Release the serialized data buffer for a load request, if any.
+///
+/// Data loaded through the AsyncLoader is freed, while data referenced in place from a memory-mapped cache file is
+/// simply released.
+///
+/// @param[in] pRequest  Load request data.
+void CachePackageLoader::ReleaseLoadData( LoadRequest* pRequest )
+{
+    HELIUM_ASSERT( pRequest );
+
+    DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
+    pRequest->pAsyncLoadBuffer = NULL;
+    pRequest->pMappedData = NULL;
+}
@@ -7,12 +7,21 @@
 
 namespace Helium
 {
+    class JobContext;
+
     /// Package loader for loading objects from a binary cache.
+    ///
+    /// Object property and persistent resource data for all objects that become ready to deserialize during a tick is
+    /// deserialized in parallel using the job system.
     class CachePackageLoader : public PackageLoader
     {
     public:
         /// Load request pool block size.
         static const size_t LOAD_REQUEST_POOL_BLOCK_SIZE = 16;
+        /// Maximum number of jobs to spawn at once when deserializing objects.
+        static const size_t DESERIALIZE_JOB_COUNT_MAX = 16;
+        /// Minimum number of objects to deserialize in a single job.
+        static const size_t DESERIALIZE_JOB_REQUEST_COUNT_MIN = 4;
 
         /// @name Construction/Destruction
         //@{
@@ -67,6 +76,8 @@ namespace Helium
         {
             /// Cache entry.
             const Cache::Entry* pEntry;
+            /// Path of the object being loaded.
+            GameObjectPath path;
             /// Temporary object reference (hold while loading is in progress).
             GameObjectPtr spObject;
 
@@ -74,12 +85,15 @@ namespace Helium
             size_t asyncLoadId;
             /// Async load buffer.
             uint8_t* pAsyncLoadBuffer;
+            /// Cache entry data within the memory-mapped cache file (used instead of the async load buffer when the
+            /// cache file is mapped).
+            const uint8_t* pMappedData;
             /// Binary serialized object property data (immediately past the link table).
-            uint8_t* pSerializedData;
+            const uint8_t* pSerializedData;
             /// End of the serialized property data.
-            uint8_t* pPropertyStreamEnd;
+            const uint8_t* pPropertyStreamEnd;
             /// End of the serialized persistent resource data.
-            uint8_t* pPersistentResourceStreamEnd;
+            const uint8_t* pPersistentResourceStreamEnd;
 
             /// Type link table (table stores type object instances).
             DynamicArray< GameObjectTypePtr > typeLinkTable;
@@ -101,6 +115,40 @@ namespace Helium
             uint32_t flags;
         };
 
+        /// Job for deserializing the data for a range of load requests.
+        class DeserializeJob : NonCopyable
+        {
+        public:
+            class Parameters
+            {
+            public:
+                /// [in] Load requests to deserialize.
+                LoadRequest* const* ppRequests;
+                /// [in] Number of load requests to deserialize.
+                size_t requestCount;
+
+                /// @name Construction/Destruction
+                //@{
+                inline Parameters();
+                //@}
+            };
+
+            /// @name Parameters
+            //@{
+            inline Parameters& GetParameters();
+            //@}
+
+            /// @name Job Execution
+            //@{
+            void Run( JobContext* pContext );
+            inline static void RunCallback( void* pJob, JobContext* pContext );
+            inline static const char* GetTypeName();
+            //@}
+
+        private:
+            Parameters m_parameters;
+        };
+
         /// Cache from which objects will be loaded.
         Cache* m_pCache;
         /// True if we've synced the cache TOC load process.
@@ -111,16 +159,23 @@ namespace Helium
         /// Load request pool.
         ObjectPool< LoadRequest > m_loadRequestPool;
 
+        /// Load requests with objects created and ready to be deserialized in the current tick.
+        DynamicArray< LoadRequest* > m_deserializeRequests;
+
         /// @name Load Ticking Functions
         //@{
         bool TickCacheLoad( LoadRequest* pRequest );
         bool TickDeserialize( LoadRequest* pRequest );
+        void DeserializeReadyRequests();
         //@}
 
         /// @name Static Private Utility Functions
         //@{
         static void ResolvePackage( GameObjectPtr& spPackage, GameObjectPath packagePath );
         static bool DeserializeLinkTables( LoadRequest* pRequest );
+        static void DeserializeObject( LoadRequest* pRequest );
+        static void FinishDeserialize( LoadRequest* pRequest );
+        static void ReleaseLoadData( LoadRequest* pRequest );
         //@}
     };
 }
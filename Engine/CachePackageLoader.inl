@@ -14,4 +14,38 @@ namespace Helium
     {
         return m_pCache;
     }
+
+    /// Constructor.
+    CachePackageLoader::DeserializeJob::Parameters::Parameters()
+        : ppRequests( NULL )
+        , requestCount( 0 )
+    {
+    }
+
+    /// Get the parameters for this job.
+    ///
+    /// @return  Reference to the structure containing the job parameters.
+    CachePackageLoader::DeserializeJob::Parameters& CachePackageLoader::DeserializeJob::GetParameters()
+    {
+        return m_parameters;
+    }
+
+    /// Callback executed to run the job.
+    ///
+    /// @param[in] pJob      Job to run.
+    /// @param[in] pContext  Context associated with the running job instance.
+    void CachePackageLoader::DeserializeJob::RunCallback( void* pJob, JobContext* pContext )
+    {
+        HELIUM_ASSERT( pJob );
+        HELIUM_ASSERT( pContext );
+        static_cast< DeserializeJob* >( pJob )->Run( pContext );
+    }
+
+    /// Get the name of this job type.
+    ///
+    /// @return  Job type name.
+    const char* CachePackageLoader::DeserializeJob::GetTypeName()
+    {
+        return "CachePackageLoader::DeserializeJob";
+    }
 }
@@ -0,0 +1,97 @@
+//----------------------------------------------------------------------------------------------------------------------
+// CachePosix.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "EnginePch.h"
+#include "Engine/Cache.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace Helium;
+
+/// Map the entire cache file into memory for read-only access.
+///
+/// @return  True if the cache file was mapped successfully, false if not.
+///
+/// @see UnmapCacheFile()
+bool Cache::MapCacheFile()
+{
+    UnmapCacheFile();
+
+    int fileDescriptor = open( *m_cacheFileName, O_RDONLY | O_CLOEXEC );
+    if( fileDescriptor < 0 )
+    {
+        return false;
+    }
+
+    struct stat fileStatus;
+    if( fstat( fileDescriptor, &fileStatus ) != 0 || fileStatus.st_size <= 0 )
+    {
+        close( fileDescriptor );
+
+        return false;
+    }
+
+    size_t mappedSize = static_cast< size_t >( fileStatus.st_size );
+    void* pMapping = mmap( NULL, mappedSize, PROT_READ, MAP_SHARED, fileDescriptor, 0 );
+
+    // The mapping holds its own reference to the file, so the descriptor is no longer needed.
+    close( fileDescriptor );
+
+    if( pMapping == MAP_FAILED )
+    {
+        return false;
+    }
+
+    // Entries are accessed in whatever order objects are requested, so don't let the kernel assume sequential access
+    // for the file as a whole (individual entry ranges are advised as they are requested).
+    madvise( pMapping, mappedSize, MADV_RANDOM );
+
+    m_pMappedData = static_cast< const uint8_t* >( pMapping );
+    m_mappedSize = mappedSize;
+
+    return true;
+}
+
+/// Release the memory mapping of the cache file if one exists.
+///
+/// @see MapCacheFile()
+void Cache::UnmapCacheFile()
+{
+    if( m_pMappedData )
+    {
+        munmap( const_cast< uint8_t* >( m_pMappedData ), static_cast< size_t >( m_mappedSize ) );
+        m_pMappedData = NULL;
+    }
+
+    m_mappedSize = 0;
+}
+
+/// Hint to the operating system that a range of the memory-mapped cache file will be read soon, sequentially.
+///
+/// @param[in] offset  Byte offset of the range within the cache file.
+/// @param[in] size    Size of the range, in bytes.
+void Cache::AdviseMappedRange( uint64_t offset, uint64_t size ) const
+{
+    HELIUM_ASSERT( m_pMappedData );
+
+    if( size == 0 )
+    {
+        return;
+    }
+
+    // madvise() requires a page-aligned start address.
+    uint64_t pageSize = static_cast< uint64_t >( sysconf( _SC_PAGESIZE ) );
+    uint64_t alignedOffset = offset & ~( pageSize - 1 );
+    size_t alignedSize = static_cast< size_t >( size + ( offset - alignedOffset ) );
+
+    void* pAlignedStart = const_cast< uint8_t* >( m_pMappedData + alignedOffset );
+    madvise( pAlignedStart, alignedSize, MADV_SEQUENTIAL );
+    madvise( pAlignedStart, alignedSize, MADV_WILLNEED );
+}
@@ -0,0 +1,101 @@
+//----------------------------------------------------------------------------------------------------------------------
+// CacheWin.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "EnginePch.h"
+#include "Engine/Cache.h"
+
+#include <windows.h>
+
+using namespace Helium;
+
+/// Map the entire cache file into memory for read-only access.
+///
+/// @return  True if the cache file was mapped successfully, false if not.
+///
+/// @see UnmapCacheFile()
+bool Cache::MapCacheFile()
+{
+    UnmapCacheFile();
+
+    HANDLE hFile = CreateFile(
+        *m_cacheFileName,
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+        NULL );
+    if( hFile == INVALID_HANDLE_VALUE )
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if( !GetFileSizeEx( hFile, &fileSize ) || fileSize.QuadPart <= 0 )
+    {
+        CloseHandle( hFile );
+
+        return false;
+    }
+
+    HANDLE hMapping = CreateFileMapping( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+    // The mapping object holds its own reference to the file, so the file handle is no longer needed.
+    CloseHandle( hFile );
+
+    if( !hMapping )
+    {
+        return false;
+    }
+
+    void* pView = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+    if( !pView )
+    {
+        CloseHandle( hMapping );
+
+        return false;
+    }
+
+    m_pMappedData = static_cast< const uint8_t* >( pView );
+    m_mappedSize = static_cast< uint64_t >( fileSize.QuadPart );
+    m_pMappingHandle = hMapping;
+
+    return true;
+}
+
+/// Release the memory mapping of the cache file if one exists.
+///
+/// @see MapCacheFile()
+void Cache::UnmapCacheFile()
+{
+    if( m_pMappedData )
+    {
+        UnmapViewOfFile( m_pMappedData );
+        m_pMappedData = NULL;
+    }
+
+    if( m_pMappingHandle )
+    {
+        CloseHandle( m_pMappingHandle );
+        m_pMappingHandle = NULL;
+    }
+
+    m_mappedSize = 0;
+}
+
+/// Hint to the operating system that a range of the memory-mapped cache file will be read soon, sequentially.
+///
+/// @param[in] offset  Byte offset of the range within the cache file.
+/// @param[in] size    Size of the range, in bytes.
+void Cache::AdviseMappedRange( uint64_t offset, uint64_t size ) const
+{
+    // No portable prefetch hint is available for mapped views on the Windows versions we support, so page faults
+    // will pull in the data on first access.
+    HELIUM_ASSERT( m_pMappedData );
+    HELIUM_UNREF( offset );
+    HELIUM_UNREF( size );
+}
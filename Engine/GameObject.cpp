@@ -3,7 +3,9 @@
 
 #include "Foundation/ObjectPool.h"
 #include "Engine/GameObjectType.h"
+#include "Engine/GameObjectCopyPlan.h"
 #include "Engine/Package.h"
+#include "Engine/PackageArena.h"
 #include "Engine/DirectSerializer.h"
 #include "Engine/DirectDeserializer.h"
 #include "Engine/GameObjectPointerData.h"
@@ -210,20 +212,17 @@ bool GameObject::Rename( const RenameParameters& rParameters )
             }
             else
             {
-                // Check each child of the new owner for a name clash.
-                for( GameObject* pChild = rwpOwnerFirstChild; pChild != NULL; pChild = pChild->m_wpNextSibling )
+                // Check the new owner for an existing child with the same name.
+                if( FindChildOf( pOwner, name, instanceIndex ) )
                 {
-                    if( pChild->m_name == name && pChild->m_instanceIndex == instanceIndex )
-                    {
-                        HELIUM_TRACE(
-                            TraceLevels::Error,
-                            ( TXT( "GameObject::Rename(): Object already exists with the specified owner (%s) and " )
-                              TXT( "name (%s).\n" ) ),
-                            ( pOwner ? *pOwner->GetPath().ToString() : TXT( "none" ) ),
-                            *name );
-
-                        return false;
-                    }
+                    HELIUM_TRACE(
+                        TraceLevels::Error,
+                        ( TXT( "GameObject::Rename(): Object already exists with the specified owner (%s) and " )
+                          TXT( "name (%s).\n" ) ),
+                        ( pOwner ? *pOwner->GetPath().ToString() : TXT( "none" ) ),
+                        *name );
+
+                    return false;
                 }
             }
         }
@@ -318,6 +317,33 @@ bool Helium::GameObject::CloneGameObject(GameObjectPtr _game_object_ptr)
     return CreateObject(_game_object_ptr, GetGameObjectType(), m_name, m_spOwner.Get(), this, true);
 }
 
+/// Copy the reflected fields of this object to another object.
+///
+/// Copies to objects of the same type (such as when instantiating an object from its template or when copying an
+/// object deserialized from the cache) use the precompiled copy plan of the type.  Copies to objects of any other
+/// type fall back to copying each field through Reflect.
+///
+/// @param[in] pObject  Object to which to copy.
+///
+/// @see GameObjectType::GetCopyPlan()
+void Helium::GameObject::CopyTo( Reflect::Object* pObject )
+{
+    HELIUM_ASSERT( pObject );
+
+    const GameObjectType* pType = GetGameObjectType();
+    HELIUM_ASSERT( pType );
+    if( pObject->GetClass() != pType->GetClass() )
+    {
+        Reflect::Object::CopyTo( pObject );
+
+        return;
+    }
+
+    const GameObjectCopyPlan* pPlan = pType->GetCopyPlan();
+    HELIUM_ASSERT( pPlan );
+    pPlan->Copy( this, pObject );
+}
+
 /// Set all object flags covered by the given mask.
 ///
 /// Note that all object flag functions are thread-safe.
@@ -625,13 +651,26 @@ bool GameObject::CreateObject(
         return false;
     }
 
-    // Allocate memory for and create the object.
-    DefaultAllocator allocator;
-
+    // Allocate memory for and create the object.  Objects created within a package that has an arena enabled are
+    // allocated from that arena.
     size_t bufferSize = pObjectTemplate->GetInstanceSize();
-    void* pObjectMemory = allocator.AllocateAligned( HELIUM_SIMD_ALIGNMENT, bufferSize );
+    PackageArena* pArena = ( pObjectTemplate->IsPackage() ? NULL : GetOwnerPackageArena( pOwner ) );
+
+    void* pObjectMemory;
+    CUSTOM_DESTROY_CALLBACK* pDestroyCallback;
+    if( pArena )
+    {
+        pObjectMemory = pArena->Allocate( pType, bufferSize );
+        pDestroyCallback = PackageArenaCustomDestroy;
+    }
+    else
+    {
+        pObjectMemory = DefaultAllocator().AllocateAligned( HELIUM_SIMD_ALIGNMENT, bufferSize );
+        pDestroyCallback = StandardCustomDestroy;
+    }
+
     HELIUM_ASSERT( pObjectMemory );
-    GameObject* pObject = pObjectTemplate->InPlaceConstruct( pObjectMemory, StandardCustomDestroy );
+    GameObject* pObject = pObjectTemplate->InPlaceConstruct( pObjectMemory, pDestroyCallback );
     HELIUM_ASSERT( pObject == pObjectMemory );
     rspObject = pObject;
 
@@ -682,55 +721,220 @@ bool GameObject::CreateObject(
     return true;
 }
 
-/// Find an object based on its path name.
+/// Create a batch of objects of the same type.
 ///
-/// @param[in] path  FilePath of the object to locate.
+/// All objects are allocated from a single block of memory, and all of them are registered and named while holding
+/// the object list lock once.  Each object is given the same name and owner, with a unique instance index assigned
+/// automatically.  The block of memory is freed once all objects in the batch have been destroyed.
 ///
-/// @return  Pointer to the object if found, null pointer if not found.
-GameObject* GameObject::FindObject( GameObjectPath path )
+/// @param[out] pspObjects   Array in which to store the newly created objects.  Any object references stored in this
+///                          array prior to calling this function will always be cleared.
+/// @param[in]  objectCount  Number of objects to create.
+/// @param[in]  pType        Type of objects to create (package types are not supported).
+/// @param[in]  name         Object name (must not be empty).
+/// @param[in]  pOwner       Object owner.
+/// @param[in]  pTemplate    Optional override template object.  If null, the default template for the specified type
+///                          will be used.
+///
+/// @return  True if object creation was successful, false if not.
+///
+/// @see CreateObject()
+bool GameObject::CreateObjects(
+    GameObjectPtr* pspObjects,
+    size_t objectCount,
+    const GameObjectType* pType,
+    Name name,
+    GameObject* pOwner,
+    GameObject* pTemplate )
 {
-    // Make sure the path isn't empty.
-    if( path.IsEmpty() )
+    HELIUM_ASSERT( pspObjects || objectCount == 0 );
+    HELIUM_ASSERT( pType );
+
+    for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
     {
-        return NULL;
+        pspObjects[ objectIndex ].Release();
+    }
+
+    if( objectCount == 0 )
+    {
+        return true;
     }
 
-    // Assemble a list of object names and instance indices, from the top level on down.
-    size_t pathDepth = 0;
-    size_t packageDepth = 0;
-    for( GameObjectPath testPath = path; !testPath.IsEmpty(); testPath = testPath.GetParent() )
+    HELIUM_TRACE(
+        TraceLevels::Debug,
+        ( TXT( "GameObject::CreateObjects(): Creating %" ) TPRIuSZ TXT( " objects named \"%s\" of type \"%s\" owned " )
+          TXT( "by \"%s\".\n" ) ),
+        objectCount,
+        *name,
+        *pType->GetName(),
+        !pOwner ? TXT("[none]") : *pOwner->GetPath().ToString());
+
+    if( name.IsEmpty() )
     {
-        ++pathDepth;
+        HELIUM_TRACE( TraceLevels::Error, TXT( "GameObject::CreateObjects(): Objects must be given a name.\n" ) );
 
-        if( testPath.IsPackage() )
+        return false;
+    }
+
+    if( pOwner && pOwner->m_name.IsEmpty() )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            ( TXT( "GameObject::CreateObjects(): Cannot set the owner of an object to an object with no path " )
+              TXT( "information.\n" ) ) );
+
+        return false;
+    }
+
+    // Get the appropriate template object.
+    GameObject* pObjectTemplate = pTemplate;
+    if( pObjectTemplate )
+    {
+        if( pType->GetFlags() & GameObjectType::FLAG_NO_TEMPLATE && pType->GetTemplate() != pObjectTemplate )
         {
-            ++packageDepth;
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                TXT( "GameObject::CreateObjects(): Objects of type \"%s\" cannot be used as templates.\n" ),
+                *pType->GetName() );
+
+            return false;
         }
     }
+    else
+    {
+        pObjectTemplate = pType->GetTemplate();
+        HELIUM_ASSERT( pObjectTemplate );
+    }
 
-    StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
-    StackMemoryHeap<>::Marker stackMarker( rStackHeap );
+    // Make sure the object template is of the correct type.
+    if( !pObjectTemplate->IsInstanceOf( pType ) )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "GameObject::CreateObjects: Template object \"%s\" is not of type \"%s\".\n" ),
+            *pObjectTemplate->GetPath().ToString(),
+            pType->GetName().Get() );
+        HELIUM_ASSERT_FALSE();
 
-    Name* pPathNames = static_cast< Name* >( rStackHeap.Allocate( sizeof( Name ) * pathDepth ) );
-    HELIUM_ASSERT( pPathNames );
+        return false;
+    }
 
-    uint32_t* pInstanceIndices = static_cast< uint32_t* >( rStackHeap.Allocate( sizeof( uint32_t ) * pathDepth ) );
-    HELIUM_ASSERT( pInstanceIndices );
+    // Packages cannot be given instance indices.
+    if( pObjectTemplate->IsPackage() )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "GameObject::CreateObjects(): Packages cannot be created in batches.\n" ) );
+
+        return false;
+    }
+
+    // Allocate a single block for all the objects.  The block starts with the batch header, and each object is
+    // preceded by a pointer back to the header so that the block can be freed when the last object is destroyed.
+    const size_t alignment = HELIUM_SIMD_ALIGNMENT;
+    HELIUM_ASSERT( sizeof( BatchSlab ) <= alignment );
+    HELIUM_ASSERT( sizeof( BatchSlab* ) <= alignment );
 
-    size_t pathIndex = pathDepth;
-    for( GameObjectPath testPath = path; !testPath.IsEmpty(); testPath = testPath.GetParent() )
+    size_t instanceSize = ( pObjectTemplate->GetInstanceSize() + alignment - 1 ) & ~( alignment - 1 );
+    size_t objectStride = alignment + instanceSize;
+
+    DefaultAllocator allocator;
+    void* pSlabMemory = allocator.AllocateAligned( alignment, alignment + objectStride * objectCount );
+    HELIUM_ASSERT( pSlabMemory );
+
+    BatchSlab* pSlab = new( pSlabMemory ) BatchSlab;
+    pSlab->liveObjectCount = static_cast< int32_t >( objectCount );
+
+    uint8_t* pObjectMemory = static_cast< uint8_t* >( pSlabMemory ) + alignment;
+    for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
     {
-        HELIUM_ASSERT( pathIndex != 0 );
-        --pathIndex;
+        pObjectMemory += alignment;
+        reinterpret_cast< BatchSlab** >( pObjectMemory )[ -1 ] = pSlab;
+
+        GameObject* pObject = pObjectTemplate->InPlaceConstruct( pObjectMemory, BatchSlabCustomDestroy );
+        HELIUM_ASSERT( pObject == static_cast< void* >( pObjectMemory ) );
+        pspObjects[ objectIndex ] = pObject;
+
+        pObject->m_spTemplate = pTemplate;
 
-        pPathNames[ pathIndex ] = testPath.GetName();
-        pInstanceIndices[ pathIndex ] = testPath.GetInstanceIndex();
+        // Initialize the object based on its default.
+        pObjectTemplate->CopyTo( pObject );
+
+        pObjectMemory += instanceSize;
     }
 
-    HELIUM_ASSERT( pathIndex == 0 );
+    {
+        // Register and name all the objects at once.
+        ScopeWriteLock scopeLock( sm_objectListLock );
+
+        ChildNameInstanceIndexMap& rNameInstanceIndexMap = GetNameInstanceIndexMap();
+        HELIUM_ASSERT( sm_pEmptyNameInstanceIndexMap );
+        HELIUM_ASSERT( sm_pEmptyInstanceIndexSet );
+
+        sm_pEmptyNameInstanceIndexMap->First() = ( pOwner ? pOwner->GetPath() : GameObjectPath( NULL_NAME ) );
+        sm_pEmptyInstanceIndexSet->First() = name;
+
+        ChildNameInstanceIndexMap::Accessor childNameMapAccessor;
+        rNameInstanceIndexMap.Insert( childNameMapAccessor, *sm_pEmptyNameInstanceIndexMap );
+
+        NameInstanceIndexMap::Accessor indexSetAccessor;
+        childNameMapAccessor->Second().Insert( indexSetAccessor, *sm_pEmptyInstanceIndexSet );
+
+        InstanceIndexSet& rIndexSet = indexSetAccessor->Second();
+        InstanceIndexSet::ConstAccessor indexAccessor;
+
+        GameObjectWPtr& rwpOwnerFirstChild = ( pOwner ? pOwner->m_wpFirstChild : sm_wpFirstTopLevelObject );
+
+        // Instance indices are assigned in increasing order, so the search for each unused index can pick up where
+        // the previous one left off.
+        uint32_t instanceIndex = 0;
+        for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+        {
+            GameObject* pObject = pspObjects[ objectIndex ];
+            HELIUM_ASSERT( pObject );
+            HELIUM_ASSERT( IsInvalid( pObject->m_id ) );
+
+            size_t objectId = sm_objects.Add( GameObjectWPtr( pObject ) );
+            HELIUM_ASSERT( objectId < UINT32_MAX );
+            pObject->m_id = static_cast< uint32_t >( objectId );
+
+            while( !rIndexSet.Insert( indexAccessor, instanceIndex ) )
+            {
+                ++instanceIndex;
+                HELIUM_ASSERT( instanceIndex < INSTANCE_INDEX_AUTO );
+            }
+
+            pObject->m_name = name;
+            pObject->m_spOwner = pOwner;
+            pObject->m_instanceIndex = instanceIndex;
+            ++instanceIndex;
 
-    // Search from the root.
-    return FindChildOf( NULL, pPathNames, pInstanceIndices, pathDepth, packageDepth );
+            pObject->m_wpNextSibling = rwpOwnerFirstChild;
+            rwpOwnerFirstChild = pObject;
+
+            pObject->UpdatePath();
+        }
+    }
+
+    return true;
+}
+
+/// Find an object based on its path name.
+///
+/// @param[in] path  FilePath of the object to locate.
+///
+/// @return  Pointer to the object if found, null pointer if not found.
+GameObject* GameObject::FindObject( GameObjectPath path )
+{
+    // Make sure the path isn't empty.
+    if( path.IsEmpty() )
+    {
+        return NULL;
+    }
+
+    // Each object registers itself with its path table entry whenever its path is updated, so we can simply look up
+    // the object using the path itself.
+    return path.GetInstance();
 }
 
 /// Search for a direct child of the specified object with the given name.
@@ -748,19 +952,17 @@ GameObject* GameObject::FindChildOf( const GameObject* pObject, Name name, uint3
         return NULL;
     }
 
-    ScopeReadLock scopeLock( sm_objectListLock );
+    // Look up the child through the path table, checking for both non-package and package children (packages can
+    // only be children of other packages).
+    GameObjectPath parentPath = ( pObject ? pObject->m_path : GameObjectPath( NULL_NAME ) );
 
-    for( GameObject* pChild = ( pObject ? pObject->m_wpFirstChild : sm_wpFirstTopLevelObject );
-         pChild != NULL;
-         pChild = pChild->m_wpNextSibling )
+    GameObject* pChild = GameObjectPath::FindInstance( name, false, parentPath, instanceIndex );
+    if( !pChild && ( parentPath.IsEmpty() || parentPath.IsPackage() ) )
     {
-        if( pChild->GetName() == name && pChild->GetInstanceIndex() == instanceIndex )
-        {
-            return pChild;
-        }
+        pChild = GameObjectPath::FindInstance( name, true, parentPath, instanceIndex );
     }
 
-    return NULL;
+    return pChild;
 }
 
 /// Search for a child or grandchild of the given object with a relative path dictated by the given parameters.
@@ -1119,6 +1321,12 @@ void GameObject::SetCustomDestroyCallback( CUSTOM_DESTROY_CALLBACK* pDestroyCall
 /// This should be called whenever the name of this object or one of its parents changes.
 void GameObject::UpdatePath()
 {
+    // Unregister this object from its old path table entry.
+    if( m_path.GetInstance() == this )
+    {
+        m_path.SetInstance( NULL );
+    }
+
     // Update this object's path first.
     HELIUM_VERIFY( m_path.Set(
         m_name,
@@ -1126,6 +1334,14 @@ void GameObject::UpdatePath()
         ( m_spOwner ? m_spOwner->m_path : GameObjectPath( NULL_NAME ) ),
         m_instanceIndex ) );
 
+    // Register this object with its new path table entry so that it can be found through FindObject() (objects without
+    // names cannot be looked up).
+    if( !m_name.IsEmpty() )
+    {
+        HELIUM_ASSERT( !m_path.GetInstance() );
+        m_path.SetInstance( this );
+    }
+
     // Update the path of each child object.
     for( GameObject* pChild = m_wpFirstChild; pChild != NULL; pChild = pChild->m_wpNextSibling )
     {
@@ -1143,6 +1359,55 @@ void GameObject::StandardCustomDestroy( GameObject* pObject )
     DefaultAllocator().Free( pObject );
 }
 
+/// Custom destroy callback for objects created using CreateObjects().
+///
+/// The block of memory shared by the batch is freed once all of its objects have been destroyed.
+///
+/// @param[in] pObject  Object to destroy.
+void GameObject::BatchSlabCustomDestroy( GameObject* pObject )
+{
+    HELIUM_ASSERT( pObject );
+
+    BatchSlab* pSlab = reinterpret_cast< BatchSlab** >( pObject )[ -1 ];
+    HELIUM_ASSERT( pSlab );
+
+    pObject->InPlaceDestroy();
+
+    if( AtomicDecrement( pSlab->liveObjectCount ) == 0 )
+    {
+        DefaultAllocator().Free( pSlab );
+    }
+}
+
+/// Custom destroy callback for objects allocated from a package arena.
+///
+/// @param[in] pObject  Object to destroy.
+void GameObject::PackageArenaCustomDestroy( GameObject* pObject )
+{
+    HELIUM_ASSERT( pObject );
+    pObject->InPlaceDestroy();
+    PackageArena::Free( pObject );
+}
+
+/// Get the arena from which to allocate objects with the given owner.
+///
+/// @param[in] pOwner  Object owner.
+///
+/// @return  Arena of the nearest package in the owner chain, or null if that package does not have an arena enabled
+///          or the owner chain does not contain a package.
+PackageArena* GameObject::GetOwnerPackageArena( GameObject* pOwner )
+{
+    for( GameObject* pObject = pOwner; pObject != NULL; pObject = pObject->GetOwner() )
+    {
+        if( pObject->IsPackage() )
+        {
+            return static_cast< Package* >( pObject )->GetArena();
+        }
+    }
+
+    return NULL;
+}
+
 /// Get the static name instance lookup map, creating it if necessary.
 ///
 /// Since our hash table implementation dynamically allocates buckets on construction and always keeps them around
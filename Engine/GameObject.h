@@ -119,6 +119,7 @@
 namespace Helium
 {
     class Serializer;
+    class PackageArena;
 
     class GameObjectType;
     typedef SmartPtr< GameObjectType > GameObjectTypePtr;
@@ -205,6 +206,9 @@ namespace Helium
         virtual Reflect::ObjectPtr Clone();
         virtual bool CloneGameObject(GameObjectPtr _game_object_ptr);
 
+        // Override for Object::CopyTo
+        virtual void CopyTo( Reflect::Object* pObject );
+
         inline uint32_t GetId() const;
 
         inline uint32_t GetFlags() const;
@@ -271,6 +275,9 @@ namespace Helium
         static bool CreateObject(
             GameObjectPtr& rspObject, const GameObjectType* pType, Name name, GameObject* pOwner,
             GameObject* pTemplate = NULL, bool bAssignInstanceIndex = false );
+        static bool CreateObjects(
+            GameObjectPtr* pspObjects, size_t objectCount, const GameObjectType* pType, Name name, GameObject* pOwner,
+            GameObject* pTemplate = NULL );
         template< typename T > static bool Create(
             StrongPtr< T >& rspObject, Name name, GameObject* pOwner, T* pTemplate = NULL,
             bool bAssignInstanceIndex = false );
@@ -303,6 +310,13 @@ namespace Helium
         //@}
 
     private:
+        /// Header for a block of objects allocated together by CreateObjects().
+        struct BatchSlab
+        {
+            /// Number of objects in the block that have yet to be destroyed.
+            volatile int32_t liveObjectCount;
+        };
+
         /// Name instance index lookup set type.
         typedef ConcurrentHashSet< uint32_t > InstanceIndexSet;
         /// Name instance lookup map type.
@@ -361,11 +375,14 @@ namespace Helium
         /// @name Reference Counting Support, Private
         //@{
         static void StandardCustomDestroy( GameObject* pObject );
+        static void BatchSlabCustomDestroy( GameObject* pObject );
+        static void PackageArenaCustomDestroy( GameObject* pObject );
         //@}
 
         /// @name Static GameObject Management
         //@{
         static ChildNameInstanceIndexMap& GetNameInstanceIndexMap();
+        static PackageArena* GetOwnerPackageArena( GameObject* pOwner );
         //@}
     };
 
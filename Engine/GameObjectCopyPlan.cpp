@@ -0,0 +1,217 @@
+//----------------------------------------------------------------------------------------------------------------------
+// GameObjectCopyPlan.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "EnginePch.h"
+#include "Engine/GameObjectCopyPlan.h"
+
+#include "Reflect/Data/PointerData.h"
+#include "Engine/GameObjectPointerData.h"
+
+#include <cstdlib>
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] pComposite  Reflection composite of the type for which to build a copy plan.  Fields from all base
+///                        composites are included.
+GameObjectCopyPlan::GameObjectCopyPlan( const Reflect::Composite* pComposite )
+    : m_pComposite( pComposite )
+    , m_fieldCount( 0 )
+{
+    HELIUM_ASSERT( pComposite );
+
+    // Gather an operation for each field.
+    DynamicArray< Operation > fieldOperations;
+    for( const Reflect::Composite* pCurrent = pComposite; pCurrent != NULL; pCurrent = pCurrent->m_Base )
+    {
+        size_t fieldCount = pCurrent->m_Fields.GetSize();
+        for( size_t fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex )
+        {
+            const Reflect::Field* pField = &pCurrent->m_Fields[ fieldIndex ];
+
+            Operation* pOperation = fieldOperations.New();
+            HELIUM_ASSERT( pOperation );
+            pOperation->pField = pField;
+            pOperation->offset = pField->m_Offset;
+            pOperation->size = pField->m_Size;
+            pOperation->type = GetFieldOperation( pField );
+        }
+    }
+
+    m_fieldCount = fieldOperations.GetSize();
+    if( m_fieldCount == 0 )
+    {
+        return;
+    }
+
+    qsort( fieldOperations.GetData(), m_fieldCount, sizeof( Operation ), OperationCompare );
+
+    // Merge byte copies of fields that directly follow each other in memory.  Gaps between fields are never filled
+    // in, as they may hold members that are not reflected.
+    m_operations.Reserve( m_fieldCount );
+    for( size_t operationIndex = 0; operationIndex < m_fieldCount; ++operationIndex )
+    {
+        const Operation& rFieldOperation = fieldOperations[ operationIndex ];
+        if( rFieldOperation.type == OPERATION_COPY_BYTES && !m_operations.IsEmpty() )
+        {
+            Operation& rLastOperation = m_operations.GetLast();
+            if( rLastOperation.type == OPERATION_COPY_BYTES &&
+                rLastOperation.offset + rLastOperation.size == rFieldOperation.offset )
+            {
+                rLastOperation.size += rFieldOperation.size;
+
+                continue;
+            }
+        }
+
+        Operation* pOperation = m_operations.New( rFieldOperation );
+        HELIUM_ASSERT( pOperation );
+        if( pOperation->type != OPERATION_COPY_FIELD )
+        {
+            pOperation->pField = NULL;
+        }
+    }
+
+    m_operations.Trim();
+}
+
+/// Destructor.
+GameObjectCopyPlan::~GameObjectCopyPlan()
+{
+}
+
+/// Copy all reflected fields from one object to another.
+///
+/// @param[in] pSource       Object from which to copy.
+/// @param[in] pDestination  Object to which to copy.  This must be of the same type as the source object.
+void GameObjectCopyPlan::Copy( const void* pSource, void* pDestination ) const
+{
+    HELIUM_ASSERT( pSource );
+    HELIUM_ASSERT( pDestination );
+
+    if( pSource == pDestination )
+    {
+        return;
+    }
+
+    const uint8_t* pSourceBytes = static_cast< const uint8_t* >( pSource );
+    uint8_t* pDestinationBytes = static_cast< uint8_t* >( pDestination );
+
+    size_t operationCount = m_operations.GetSize();
+    const Operation* pOperations = m_operations.GetData();
+    for( size_t operationIndex = 0; operationIndex < operationCount; ++operationIndex )
+    {
+        const Operation& rOperation = pOperations[ operationIndex ];
+        const void* pSourceData = pSourceBytes + rOperation.offset;
+        void* pDestinationData = pDestinationBytes + rOperation.offset;
+
+        switch( rOperation.type )
+        {
+            case OPERATION_COPY_BYTES:
+            {
+                MemoryCopy( pDestinationData, pSourceData, rOperation.size );
+
+                break;
+            }
+
+            case OPERATION_ASSIGN_POINTER:
+            {
+                *static_cast< Reflect::ObjectPtr* >( pDestinationData ) =
+                    *static_cast< const Reflect::ObjectPtr* >( pSourceData );
+
+                break;
+            }
+
+            case OPERATION_ASSIGN_STRING:
+            {
+                *static_cast< tstring* >( pDestinationData ) = *static_cast< const tstring* >( pSourceData );
+
+                break;
+            }
+
+            case OPERATION_COPY_FIELD:
+            {
+                const Reflect::Field* pField = rOperation.pField;
+                HELIUM_ASSERT( pField );
+
+                Reflect::DataPtr spSourceData = pField->CreateData( const_cast< void* >( pSource ) );
+                Reflect::DataPtr spDestinationData = pField->CreateData( pDestination );
+                HELIUM_ASSERT( spSourceData );
+                HELIUM_ASSERT( spDestinationData );
+
+                HELIUM_VERIFY( spDestinationData->Set(
+                    spSourceData,
+                    ( pField->m_Flags & Reflect::FieldFlags::Share ) ? Reflect::DataFlags::Shallow : 0 ) );
+
+                break;
+            }
+
+            default:
+            {
+                HELIUM_ASSERT_FALSE();
+            }
+        }
+    }
+}
+
+/// Get the type of operation to use when copying a given field.
+///
+/// @param[in] pField  Field to copy.
+///
+/// @return  Copy operation type.
+uint32_t GameObjectCopyPlan::GetFieldOperation( const Reflect::Field* pField )
+{
+    HELIUM_ASSERT( pField );
+
+    const Reflect::Class* pDataClass = pField->m_DataClass;
+    if( pDataClass == Reflect::GetClass< Reflect::BoolData >() ||
+        pDataClass == Reflect::GetClass< Reflect::UInt8Data >() ||
+        pDataClass == Reflect::GetClass< Reflect::Int8Data >() ||
+        pDataClass == Reflect::GetClass< Reflect::UInt16Data >() ||
+        pDataClass == Reflect::GetClass< Reflect::Int16Data >() ||
+        pDataClass == Reflect::GetClass< Reflect::UInt32Data >() ||
+        pDataClass == Reflect::GetClass< Reflect::Int32Data >() ||
+        pDataClass == Reflect::GetClass< Reflect::UInt64Data >() ||
+        pDataClass == Reflect::GetClass< Reflect::Int64Data >() ||
+        pDataClass == Reflect::GetClass< Reflect::Float32Data >() ||
+        pDataClass == Reflect::GetClass< Reflect::Float64Data >() )
+    {
+        return OPERATION_COPY_BYTES;
+    }
+
+    if( pDataClass == Reflect::GetClass< Reflect::StlStringData >() )
+    {
+        return OPERATION_ASSIGN_STRING;
+    }
+
+    // Pointers not flagged as shared are deep copied (cloned) by Reflect::PointerData, so only shared pointers can be
+    // copied by simple assignment.
+    if( ( pField->m_Flags & Reflect::FieldFlags::Share ) &&
+        ( pDataClass == Reflect::GetClass< Reflect::PointerData >() ||
+          pDataClass == Reflect::GetClass< GameObjectPointerData >() ) )
+    {
+        return OPERATION_ASSIGN_POINTER;
+    }
+
+    return OPERATION_COPY_FIELD;
+}
+
+/// qsort() callback for sorting operations by offset.
+///
+/// @param[in] pElement0  First operation to compare.
+/// @param[in] pElement1  Second operation to compare.
+///
+/// @return  Less than zero if the first operation comes before the second, greater than zero if the first operation
+///          comes after the second, zero if both operations have the same offset.
+int GameObjectCopyPlan::OperationCompare( const void* pElement0, const void* pElement1 )
+{
+    uint32_t offset0 = static_cast< const Operation* >( pElement0 )->offset;
+    uint32_t offset1 = static_cast< const Operation* >( pElement1 )->offset;
+
+    return ( offset0 < offset1 ? -1 : ( offset0 > offset1 ? 1 : 0 ) );
+}
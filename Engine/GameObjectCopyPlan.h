@@ -0,0 +1,102 @@
+//----------------------------------------------------------------------------------------------------------------------
+// GameObjectCopyPlan.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_ENGINE_GAME_OBJECT_COPY_PLAN_H
+#define HELIUM_ENGINE_GAME_OBJECT_COPY_PLAN_H
+
+#include "Engine/Engine.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Reflect/Composite.h"
+
+namespace Helium
+{
+    /// Precompiled set of operations for copying the reflected fields of one object to another object of the same type.
+    ///
+    /// Walking a Reflect::Composite field list and creating a pair of Reflect::Data objects for each field is expensive
+    /// when done for every object instantiated from a template or loaded from the cache.  A copy plan walks the field
+    /// list once and flattens it into an array of operations:
+    /// - Fields of plain-old-data types are copied with a single memory copy, with fields laid out back-to-back in
+    ///   memory merged into a single range.
+    /// - Shared (shallow) strong pointer fields and string fields are copied using their assignment operators.
+    /// - All other fields are copied through Reflect::Data::Set(), exactly as Reflect::Composite copies them.
+    ///
+    /// Plans are immutable once built, and can be used from any thread.
+    class HELIUM_ENGINE_API GameObjectCopyPlan : NonCopyable
+    {
+    public:
+        /// Copy operation types.
+        enum EOperation
+        {
+            OPERATION_FIRST   =  0,
+            OPERATION_INVALID = -1,
+
+            /// Copy a range of bytes.
+            OPERATION_COPY_BYTES,
+            /// Assign a strong pointer (shallow copy).
+            OPERATION_ASSIGN_POINTER,
+            /// Assign a string.
+            OPERATION_ASSIGN_STRING,
+            /// Copy a field through its Reflect::Data type.
+            OPERATION_COPY_FIELD,
+
+            OPERATION_MAX,
+            OPERATION_LAST = OPERATION_MAX - 1
+        };
+
+        /// Single copy operation.
+        struct Operation
+        {
+            /// Field to copy (only set for OPERATION_COPY_FIELD operations).
+            const Reflect::Field* pField;
+            /// Byte offset of the data to copy within each object.
+            uint32_t offset;
+            /// Number of bytes to copy (only used for OPERATION_COPY_BYTES operations).
+            uint32_t size;
+            /// Operation type.
+            uint32_t type;
+        };
+
+        /// @name Construction/Destruction
+        //@{
+        explicit GameObjectCopyPlan( const Reflect::Composite* pComposite );
+        ~GameObjectCopyPlan();
+        //@}
+
+        /// @name Copying
+        //@{
+        void Copy( const void* pSource, void* pDestination ) const;
+        //@}
+
+        /// @name Data Access
+        //@{
+        inline const Reflect::Composite* GetComposite() const;
+        inline size_t GetOperationCount() const;
+        inline const Operation& GetOperation( size_t index ) const;
+        inline size_t GetFieldCount() const;
+        //@}
+
+    private:
+        /// Composite for which this plan was built.
+        const Reflect::Composite* m_pComposite;
+        /// Copy operations, sorted by offset.
+        DynamicArray< Operation > m_operations;
+        /// Number of reflected fields covered by this plan.
+        size_t m_fieldCount;
+
+        /// @name Private Utility Functions
+        //@{
+        static uint32_t GetFieldOperation( const Reflect::Field* pField );
+        static int OperationCompare( const void* pElement0, const void* pElement1 );
+        //@}
+    };
+}
+
+#include "Engine/GameObjectCopyPlan.inl"
+
+#endif  // HELIUM_ENGINE_GAME_OBJECT_COPY_PLAN_H
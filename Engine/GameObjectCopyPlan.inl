@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------------------------------------------------
+// GameObjectCopyPlan.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get the composite for which this plan was built.
+    ///
+    /// @return  Reflection composite.
+    const Reflect::Composite* GameObjectCopyPlan::GetComposite() const
+    {
+        return m_pComposite;
+    }
+
+    /// Get the number of operations in this plan.
+    ///
+    /// @return  Operation count.
+    ///
+    /// @see GetOperation()
+    size_t GameObjectCopyPlan::GetOperationCount() const
+    {
+        return m_operations.GetSize();
+    }
+
+    /// Get the operation at the specified index.
+    ///
+    /// @param[in] index  Operation index.
+    ///
+    /// @return  Reference to the operation.
+    ///
+    /// @see GetOperationCount()
+    const GameObjectCopyPlan::Operation& GameObjectCopyPlan::GetOperation( size_t index ) const
+    {
+        HELIUM_ASSERT( index < m_operations.GetSize() );
+
+        return m_operations[ index ];
+    }
+
+    /// Get the number of reflected fields covered by this plan.
+    ///
+    /// @return  Field count.
+    size_t GameObjectCopyPlan::GetFieldCount() const
+    {
+        return m_fieldCount;
+    }
+}
@@ -1,13 +1,16 @@
 #include "EnginePch.h"
 #include "Engine/GameObjectLoader.h"
 
+#include "Platform/Atomic.h"
 #include "Platform/Thread.h"
 #include "Engine/GameObjectType.h"
 #include "Engine/GameObject.h"
 #include "Engine/Package.h"
 #include "Engine/PackageLoader.h"
+#include "Engine/ResidencyManager.h"
 
 #include "Engine/GameObjectPointerData.h"
+#include "Engine/JobContext.h"
 
 /// GameObject cache name.
 #define HELIUM_OBJECT_CACHE_NAME TXT( "GameObject" )
@@ -20,6 +23,8 @@ GameObjectLoader* GameObjectLoader::sm_pInstance = NULL;
 GameObjectLoader::GameObjectLoader()
 : m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
 , m_cacheName( HELIUM_OBJECT_CACHE_NAME )
+, m_pNewRequestHead( NULL )
+, m_tickLock( 0 )
 {
 }
 
@@ -70,15 +75,25 @@ size_t GameObjectLoader::BeginLoadObject( GameObjectPath path )
 	pRequest->pPackageLoader = pPackageLoader;
 	SetInvalid( pRequest->packageLoadRequestId );
 	HELIUM_ASSERT( pRequest->linkTable.IsEmpty() );
+	HELIUM_ASSERT( pRequest->preloadWaiters.IsEmpty() );
+	HELIUM_ASSERT( pRequest->loadWaiters.IsEmpty() );
+	pRequest->pendingDependencyCount = 0;
+	pRequest->pNextNew = NULL;
 	pRequest->stateFlags = 0;
 	pRequest->requestCount = 1;
 
 	ConcurrentHashMap< GameObjectPath, LoadRequest* >::Accessor requestAccessor;
 	if( m_loadRequestMap.Insert( requestAccessor, KeyValue< GameObjectPath, LoadRequest* >( path, pRequest ) ) )
 	{
-		// New load request was created, so tick it once to get the load process running.
+		// New load request was created, so queue it to be started on the next tick.
 		requestAccessor.Release();
-		TickLoadRequest( pRequest );
+
+		LoadRequest* pHeadRequest;
+		do
+		{
+			pHeadRequest = m_pNewRequestHead;
+			pRequest->pNextNew = pHeadRequest;
+		} while( AtomicCompareExchangeRelease( m_pNewRequestHead, pRequest, pHeadRequest ) != pHeadRequest );
 	}
 	else
 	{
@@ -134,6 +149,9 @@ bool GameObjectLoader::TryFinishLoad( size_t id, GameObjectPtr& rspObject )
 	int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
 	if( newRequestCount == 0 )
 	{
+		HELIUM_ASSERT( pRequest->preloadWaiters.IsEmpty() );
+		HELIUM_ASSERT( pRequest->loadWaiters.IsEmpty() );
+
 		pRequest->spObject.Release();
 		pRequest->linkTable.Resize( 0 );
 
@@ -150,6 +168,9 @@ bool GameObjectLoader::TryFinishLoad( size_t id, GameObjectPtr& rspObject )
 ///
 /// Note that after a load request has completed, the request ID will no longer be valid.
 ///
+/// This ticks the load pipeline while waiting, so it must not be called from a thread that is already updating the
+/// pipeline (such as from a package loader tick or a load callback); use TryFinishLoad() there instead.
+///
 /// @param[in]  id         Load request ID.
 /// @param[out] rspObject  Smart pointer set to the loaded object if loading has completed.  If the object failed to
 ///                        load, this will be set to a null reference.
@@ -157,6 +178,10 @@ bool GameObjectLoader::TryFinishLoad( size_t id, GameObjectPtr& rspObject )
 /// @see TryFinishLoad(), BeginLoadObject(), BeginPreloadPackage()
 void GameObjectLoader::FinishLoad( size_t id, GameObjectPtr& rspObject )
 {
+	HELIUM_ASSERT_MSG(
+		!m_tickingTls.GetPointer(),
+		TXT( "GameObjectLoader::FinishLoad() cannot be called while the current thread is ticking the loader." ) );
+
 	while( !TryFinishLoad( id, rspObject ) )
 	{
 		Tick();
@@ -216,63 +241,52 @@ bool GameObjectLoader::CacheObject( GameObject* /*pObject*/, bool /*bEvictPlatfo
 #endif  // HELIUM_TOOLS
 
 /// Update object loading.
+///
+/// Only one thread can update the load pipeline at a time.  If another thread is already updating it, this returns
+/// immediately.  The pipeline cannot be ticked from within a callback made during the pipeline update (such as
+/// OnPrecacheReady() or OnLoadComplete()), which is treated as an error.
 void GameObjectLoader::Tick()
 {
-	// Tick package loaders first.
-	TickPackageLoaders();
-
-	// Build the list of object load requests to update this tick, incrementing the request count on each to prevent
-	// them from being released while we don't have a lock on the request hash map.
-	//HELIUM_ASSERT( m_loadRequestTickArray.IsEmpty() );
-	/// List of load requests to update in the current tick.
-	DynamicArray< LoadRequest* > m_loadRequestTickArray;
+	HELIUM_ASSERT_MSG(
+		!m_tickingTls.GetPointer(),
+		TXT( "GameObjectLoader::Tick() cannot be called while the current thread is ticking the loader." ) );
 
-	ConcurrentHashMap< GameObjectPath, LoadRequest* >::ConstAccessor loadRequestConstAccessor;
-	if( m_loadRequestMap.First( loadRequestConstAccessor ) )
+	if( AtomicExchangeAcquire( m_tickLock, 1 ) != 0 )
 	{
-		do
-		{
-			LoadRequest* pRequest = loadRequestConstAccessor->Second();
-			HELIUM_ASSERT( pRequest );
-			AtomicIncrementUnsafe( pRequest->requestCount );
-			m_loadRequestTickArray.Add( pRequest );
-
-			++loadRequestConstAccessor;
-		} while( loadRequestConstAccessor.IsValid() );
+		return;
 	}
 
-	// Tick object load requests.
-	size_t loadRequestCount = m_loadRequestTickArray.GetSize();
-	for( size_t requestIndex = 0; requestIndex < loadRequestCount; ++requestIndex )
-	{
-		LoadRequest* pRequest = m_loadRequestTickArray[ requestIndex ];
-		HELIUM_ASSERT( pRequest );
+	m_tickingTls.SetPointer( this );
 
-		TickLoadRequest( pRequest );
+	// Tick package loaders first.
+	TickPackageLoaders();
 
-		int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
-		if( newRequestCount == 0 )
-		{
-			ConcurrentHashMap< GameObjectPath, LoadRequest* >::Accessor loadRequestAccessor;
-			if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
-			{
-				pRequest = loadRequestAccessor->Second();
-				HELIUM_ASSERT( pRequest );
-				if( pRequest->requestCount == 0 )
-				{
-					HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
-
-					pRequest->spObject.Release();
-					pRequest->linkTable.Resize( 0 );
-
-					m_loadRequestMap.Remove( loadRequestAccessor );
-					m_loadRequestPool.Release( pRequest );
-				}
-			}
-		}
+	// Start any new load requests and poll the requests waiting on I/O.
+	StartNewRequests();
+	TickPreloads();
+	TickPrecaches();
+
+	// Process the requests that are ready for their next stage, along with any requests that become ready as a result.
+	while( !m_linkReadyRequests.IsEmpty() || !m_precacheReadyRequests.IsEmpty() )
+	{
+		LinkReadyRequests();
+		PrecacheReadyRequests();
 	}
 
-	//m_loadRequestTickArray.Resize( 0 );
+	m_tickingTls.SetPointer( NULL );
+	AtomicExchangeRelease( m_tickLock, 0 );
+}
+
+/// Get the package loader used for loading the specified object.
+///
+/// Package loaders are only guaranteed to have finished preloading once an object from the package has been loaded.
+///
+/// @param[in] path  GameObject path.
+///
+/// @return  Package loader for the given object, or null if no package loader could be found.
+PackageLoader* GameObjectLoader::FindPackageLoader( GameObjectPath path )
+{
+	return GetPackageLoader( path );
 }
 
 /// Get the global object loader instance.
@@ -323,99 +337,198 @@ void GameObjectLoader::OnLoadComplete( GameObjectPath /*path*/, GameObject* /*pO
 {
 }
 
-/// Update the given load request.
-///
-/// @param[in] pRequest  Load request to update.
-///
-/// @return  True if the load request has completed, false if it still requires time to process.
-bool GameObjectLoader::TickLoadRequest( LoadRequest* pRequest )
+/// Move all load requests added since the last tick into the preload stage.
+void GameObjectLoader::StartNewRequests()
 {
-	HELIUM_ASSERT( pRequest );
-
-	// Update preloading.
-	bool bLockedTick = false;
-
-#define LOCK_TICK() \
-	if( !bLockedTick ) \
-	{ \
-	if( AtomicOrAcquire( pRequest->stateFlags, LOAD_FLAG_IN_TICK ) & LOAD_FLAG_IN_TICK ) \
-	{ \
-	return false; \
-	} \
-	\
-	bLockedTick = true; \
+	LoadRequest* pRequest = AtomicExchangeAcquire( m_pNewRequestHead, static_cast< LoadRequest* >( NULL ) );
+	if( !pRequest )
+	{
+		return;
 	}
 
-#define UNLOCK_TICK() AtomicAndRelease( pRequest->stateFlags, ~LOAD_FLAG_IN_TICK )
+	// Requests are pushed onto the front of the list, so add them in reverse order to keep I/O in request order.
+	size_t firstIndex = m_preloadRequests.GetSize();
+	do
+	{
+		m_preloadRequests.Add( pRequest );
+		pRequest = pRequest->pNextNew;
+	} while( pRequest );
 
-	if( !( pRequest->stateFlags & LOAD_FLAG_PRELOADED ) )
+	size_t lastIndex = m_preloadRequests.GetSize() - 1;
+	while( firstIndex < lastIndex )
 	{
-		LOCK_TICK();
+		LoadRequest* pFirstRequest = m_preloadRequests[ firstIndex ];
+		m_preloadRequests[ firstIndex ] = m_preloadRequests[ lastIndex ];
+		m_preloadRequests[ lastIndex ] = pFirstRequest;
 
+		++firstIndex;
+		--lastIndex;
+	}
+}
+
+/// Poll the load requests waiting on their package loader, moving each one that has finished preloading on to the
+/// link stage.
+void GameObjectLoader::TickPreloads()
+{
+	size_t requestIndex = 0;
+	while( requestIndex < m_preloadRequests.GetSize() )
+	{
+		LoadRequest* pRequest = m_preloadRequests[ requestIndex ];
+		HELIUM_ASSERT( pRequest );
 		if( !TickPreload( pRequest ) )
 		{
-			UNLOCK_TICK();
+			++requestIndex;
 
-			return false;
+			continue;
+		}
+
+		m_preloadRequests.RemoveSwap( requestIndex );
+
+		if( pRequest->stateFlags & LOAD_FLAG_LINKED )
+		{
+			QueuePrecache( pRequest );
+		}
+		else
+		{
+			QueueLink( pRequest );
 		}
 	}
+}
 
-	if( !( pRequest->stateFlags & LOAD_FLAG_LINKED ) )
+/// Link all load requests whose link dependencies have been preloaded.
+///
+/// Requests are linked in parallel using the job system, after which they are moved on to the precache stage.
+void GameObjectLoader::LinkReadyRequests()
+{
+	// Take the current set of requests, as more requests may become ready once these are queued for precaching.
+	HELIUM_ASSERT( m_linkRequests.IsEmpty() );
+	m_linkRequests.Swap( m_linkReadyRequests );
+
+	size_t requestCount = m_linkRequests.GetSize();
+	if( requestCount == 0 )
 	{
-		LOCK_TICK();
+		return;
+	}
 
-		if( !TickLink( pRequest ) )
-		{
-			UNLOCK_TICK();
+	LoadRequest* const* ppRequests = m_linkRequests.GetData();
 
-			return false;
+	// Fill in the link tables with the preloaded objects.
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		LoadRequest* pRequest = ppRequests[ requestIndex ];
+		HELIUM_ASSERT( pRequest );
+
+		DynamicArray< LinkEntry >& rLinkTable = pRequest->linkTable;
+		size_t linkTableSize = rLinkTable.GetSize();
+		for( size_t linkIndex = 0; linkIndex < linkTableSize; ++linkIndex )
+		{
+			LinkEntry& rLinkEntry = rLinkTable[ linkIndex ];
+			if( IsValid( rLinkEntry.loadId ) )
+			{
+				LoadRequest* pLinkRequest = m_loadRequestPool.GetObject( rLinkEntry.loadId );
+				HELIUM_ASSERT( pLinkRequest );
+				HELIUM_ASSERT( pLinkRequest->stateFlags & LOAD_FLAG_PRELOADED );
+				rLinkEntry.spObject = pLinkRequest->spObject;
+			}
 		}
 	}
 
-	if( !( pRequest->stateFlags & LOAD_FLAG_PRECACHED ) )
+	size_t jobCount = requestCount / LINK_JOB_REQUEST_COUNT_MIN;
+	if( jobCount > LINK_JOB_COUNT_MAX )
 	{
-		LOCK_TICK();
+		jobCount = LINK_JOB_COUNT_MAX;
+	}
 
-		if( !TickPrecache( pRequest ) )
+	if( jobCount < 2 )
+	{
+		// Not enough work to be worth running in parallel.
+		for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
 		{
-			UNLOCK_TICK();
-
-			return false;
+			LinkObject( ppRequests[ requestIndex ] );
 		}
 	}
-
-	if( !( pRequest->stateFlags & LOAD_FLAG_LOADED ) )
+	else
 	{
-		LOCK_TICK();
+		JobContext::Spawner< LINK_JOB_COUNT_MAX > rootSpawner;
 
-		if( !TickFinalizeLoad( pRequest ) )
+		size_t startIndex = 0;
+		for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
 		{
-			UNLOCK_TICK();
+			size_t endIndex = requestCount * ( jobIndex + 1 ) / jobCount;
 
-			return false;
+			JobContext* pContext = rootSpawner.Allocate();
+			HELIUM_ASSERT( pContext );
+			LinkJob* pJob = pContext->Create< LinkJob >();
+			HELIUM_ASSERT( pJob );
+			LinkJob::Parameters& rParameters = pJob->GetParameters();
+			rParameters.ppRequests = ppRequests + startIndex;
+			rParameters.requestCount = endIndex - startIndex;
+
+			startIndex = endIndex;
 		}
 	}
 
-	if( bLockedTick )
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
 	{
-		UNLOCK_TICK();
+		LoadRequest* pRequest = ppRequests[ requestIndex ];
+		SetRequestFlags( pRequest, LOAD_FLAG_LINKED );
+		QueuePrecache( pRequest );
 	}
 
-#undef LOCK_TICK
-#undef UNLOCK_TICK
+	m_linkRequests.Resize( 0 );
+}
 
-	return true;
+/// Start resource precaching for all load requests whose link dependencies have been fully loaded.
+void GameObjectLoader::PrecacheReadyRequests()
+{
+	// Requests may be added while we are processing the current set as requests complete their load process, so
+	// process requests until none remain.
+	while( !m_precacheReadyRequests.IsEmpty() )
+	{
+		LoadRequest* pRequest = m_precacheReadyRequests.GetLast();
+		m_precacheReadyRequests.Pop();
+		HELIUM_ASSERT( pRequest );
+
+		if( BeginPrecache( pRequest ) )
+		{
+			FinalizeLoad( pRequest );
+		}
+		else
+		{
+			m_precacheRequests.Add( pRequest );
+		}
+	}
+}
+
+/// Poll the load requests waiting on resource precaching, finalizing each one that has finished precaching.
+void GameObjectLoader::TickPrecaches()
+{
+	size_t requestIndex = 0;
+	while( requestIndex < m_precacheRequests.GetSize() )
+	{
+		LoadRequest* pRequest = m_precacheRequests[ requestIndex ];
+		HELIUM_ASSERT( pRequest );
+		if( !TickPrecache( pRequest ) )
+		{
+			++requestIndex;
+
+			continue;
+		}
+
+		m_precacheRequests.RemoveSwap( requestIndex );
+		FinalizeLoad( pRequest );
+	}
 }
 
 /// Update property preloading for the given object load request.
 ///
 /// @param[in] pRequest  Load request to update.
 ///
-/// @return  True if preloading still needs processing, false if it is complete.
+/// @return  True if preloading has completed, false if it still needs processing.
 bool GameObjectLoader::TickPreload( LoadRequest* pRequest )
 {
 	HELIUM_ASSERT( pRequest );
-	HELIUM_ASSERT( !( pRequest->stateFlags & ( LOAD_FLAG_LINKED | LOAD_FLAG_PRECACHED | LOAD_FLAG_LOADED ) ) );
+	HELIUM_ASSERT( !( pRequest->stateFlags & ( LOAD_FLAG_PRELOADED | LOAD_FLAG_LINKED | LOAD_FLAG_PRECACHED | LOAD_FLAG_LOADED ) ) );
 
 	PackageLoader* pPackageLoader = pRequest->pPackageLoader;
 	HELIUM_ASSERT( pPackageLoader );
@@ -446,7 +559,7 @@ bool GameObjectLoader::TickPreload( LoadRequest* pRequest )
 				// finalization if necessary.
 				pObject->SetFlags( GameObject::FLAG_PRELOADED | GameObject::FLAG_LINKED );
 
-				AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_PRELOADED | LOAD_FLAG_LINKED );
+				SetRequestFlags( pRequest, LOAD_FLAG_PRELOADED | LOAD_FLAG_LINKED );
 
 				return true;
 			}
@@ -456,7 +569,8 @@ bool GameObjectLoader::TickPreload( LoadRequest* pRequest )
 				TXT( "GameObjectLoader: GameObject \"%s\" is not serialized and does not exist in memory.\n" ),
 				*path.ToString() );
 
-			AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_FULLY_LOADED | LOAD_FLAG_ERROR );
+			// Nothing more can be done for this object, so skip straight to load finalization.
+			SetRequestFlags( pRequest, LOAD_FLAG_PRELOADED | LOAD_FLAG_LINKED | LOAD_FLAG_ERROR );
 
 			return true;
 		}
@@ -477,7 +591,7 @@ bool GameObjectLoader::TickPreload( LoadRequest* pRequest )
 	// Preload complete.
 	SetInvalid( pRequest->packageLoadRequestId );
 
-	AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_PRELOADED );
+	SetRequestFlags( pRequest, LOAD_FLAG_PRELOADED );
 
 	return true;
 }
@@ -574,99 +688,156 @@ namespace Helium
     };
 }
 
-/// Update object reference linking for the given object load request.
+/// Queue a preloaded load request for linking once all of its link dependencies have been preloaded.
 ///
-/// @param[in] pRequest  Load request to update.
-///
-/// @return  True if linking still requires processing, false if it is complete.
-bool GameObjectLoader::TickLink( LoadRequest* pRequest )
+/// @param[in] pRequest  Load request.
+void GameObjectLoader::QueueLink( LoadRequest* pRequest )
 {
 	HELIUM_ASSERT( pRequest );
-	HELIUM_ASSERT( !( pRequest->stateFlags & ( LOAD_FLAG_PRECACHED | LOAD_FLAG_LOADED ) ) );
+	HELIUM_ASSERT( pRequest->stateFlags & LOAD_FLAG_PRELOADED );
+	HELIUM_ASSERT( !( pRequest->stateFlags & LOAD_FLAG_LINKED ) );
 
-	// Make sure each dependency has finished its preload process.
-	bool bHavePendingLinkEntries = false;
+	// Register with each dependency that has yet to finish preloading.
+	size_t pendingCount = 0;
 
 	DynamicArray< LinkEntry >& rLinkTable = pRequest->linkTable;
 	size_t linkTableSize = rLinkTable.GetSize();
 	for( size_t linkIndex = 0; linkIndex < linkTableSize; ++linkIndex )
 	{
-		LinkEntry& rLinkEntry = rLinkTable[ linkIndex ];
+		const LinkEntry& rLinkEntry = rLinkTable[ linkIndex ];
 		if( IsValid( rLinkEntry.loadId ) )
 		{
 			LoadRequest* pLinkRequest = m_loadRequestPool.GetObject( rLinkEntry.loadId );
 			HELIUM_ASSERT( pLinkRequest );
-			if( pLinkRequest->stateFlags & LOAD_FLAG_PRELOADED )
+			if( !( pLinkRequest->stateFlags & LOAD_FLAG_PRELOADED ) )
 			{
-				rLinkEntry.spObject = pLinkRequest->spObject;
-			}
-			else
-			{
-				bHavePendingLinkEntries = true;
+				pLinkRequest->preloadWaiters.Add( pRequest );
+				++pendingCount;
 			}
 		}
 	}
 
-	if( bHavePendingLinkEntries )
+	pRequest->pendingDependencyCount = pendingCount;
+	if( pendingCount == 0 )
 	{
-		return false;
+		m_linkReadyRequests.Add( pRequest );
 	}
+}
+
+/// Resolve the object references for the given load request using its link table.
+///
+/// This is run from link jobs, so it must not modify any state outside of the load request and its object.
+///
+/// @param[in] pRequest  Load request with its link table filled in with the preloaded link dependencies.
+void GameObjectLoader::LinkObject( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
 
-	// Ready to link.
 	GameObject* pObject = pRequest->spObject;
-	if( pObject )
+	if( !pObject )
 	{
-		uint32_t objectFlags = pObject->GetFlags();
-		if( !( objectFlags & GameObject::FLAG_LINKED ) )
-		{
-			if( !( objectFlags & GameObject::FLAG_BROKEN ) )
-			{
-				PopulateObjectFromLinkTable visitor(*pObject, rLinkTable);
-				pObject->Accept(visitor);
-			}
+		return;
+	}
 
-			pObject->SetFlags( GameObject::FLAG_LINKED );
-		}
+	uint32_t objectFlags = pObject->GetFlags();
+	if( objectFlags & GameObject::FLAG_LINKED )
+	{
+		return;
 	}
 
-	AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_LINKED );
+	if( !( objectFlags & GameObject::FLAG_BROKEN ) )
+	{
+		PopulateObjectFromLinkTable visitor( *pObject, pRequest->linkTable );
+		pObject->Accept( visitor );
+	}
 
-	return true;
+	pObject->SetFlags( GameObject::FLAG_LINKED );
 }
 
-/// Update resource precaching for the given object load request.
+/// Run the LinkJob job.
 ///
-/// @param[in] pRequest  Load request to update.
+/// @param[in] pContext  Context in which this job is running.
+void GameObjectLoader::LinkJob::Run( JobContext* /*pContext*/ )
+{
+	LoadRequest* const* ppRequests = m_parameters.ppRequests;
+	size_t requestCount = m_parameters.requestCount;
+	HELIUM_ASSERT( ppRequests || requestCount == 0 );
+
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		LinkObject( ppRequests[ requestIndex ] );
+	}
+
+	JobManager& rJobManager = JobManager::GetStaticInstance();
+	rJobManager.ReleaseJob( this );
+}
+
+/// Queue a linked load request for resource precaching once all of its link dependencies have been fully loaded.
 ///
-/// @return  True if resource precaching still requires processing, false if not.
-bool GameObjectLoader::TickPrecache( LoadRequest* pRequest )
+/// @param[in] pRequest  Load request.
+void GameObjectLoader::QueuePrecache( LoadRequest* pRequest )
 {
 	HELIUM_ASSERT( pRequest );
-	HELIUM_ASSERT( !( pRequest->stateFlags & LOAD_FLAG_LOADED ) );
+	HELIUM_ASSERT( pRequest->stateFlags & LOAD_FLAG_LINKED );
+	HELIUM_ASSERT( !( pRequest->stateFlags & LOAD_FLAG_PRECACHED ) );
 
-	GameObject* pObject = pRequest->spObject;
-	if( pObject )
+	// Register with each dependency that has yet to fully load.
+	size_t pendingCount = 0;
+
+	DynamicArray< LinkEntry >& rLinkTable = pRequest->linkTable;
+	size_t linkTableSize = rLinkTable.GetSize();
+	for( size_t linkIndex = 0; linkIndex < linkTableSize; ++linkIndex )
 	{
-		// Wait for all link dependencies to fully load first.
-		DynamicArray< LinkEntry >& rLinkTable = pRequest->linkTable;
-		size_t linkTableSize = rLinkTable.GetSize();
-		for( size_t linkIndex = 0; linkIndex < linkTableSize; ++linkIndex )
+		const LinkEntry& rLinkEntry = rLinkTable[ linkIndex ];
+		if( IsValid( rLinkEntry.loadId ) )
 		{
-			LinkEntry& rLinkEntry = rLinkTable[ linkIndex ];
-			if( IsValid( rLinkEntry.loadId ) )
+			LoadRequest* pLinkRequest = m_loadRequestPool.GetObject( rLinkEntry.loadId );
+			HELIUM_ASSERT( pLinkRequest );
+			if( !( pLinkRequest->stateFlags & LOAD_FLAG_LOADED ) )
 			{
-				if( !TryFinishLoad( rLinkEntry.loadId, rLinkEntry.spObject ) )
-				{
-					return false;
-				}
-
-				SetInvalid( rLinkEntry.loadId );
-				rLinkEntry.spObject.Release();
+				pLinkRequest->loadWaiters.Add( pRequest );
+				++pendingCount;
 			}
 		}
+	}
 
-		rLinkTable.Resize( 0 );
+	pRequest->pendingDependencyCount = pendingCount;
+	if( pendingCount == 0 )
+	{
+		m_precacheReadyRequests.Add( pRequest );
+	}
+}
 
+/// Start resource precaching for the given load request.
+///
+/// @param[in] pRequest  Load request with all link dependencies fully loaded.
+///
+/// @return  True if precaching has completed, false if it needs to be polled using TickPrecache().
+bool GameObjectLoader::BeginPrecache( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !( pRequest->stateFlags & ( LOAD_FLAG_PRECACHED | LOAD_FLAG_LOADED ) ) );
+
+	// Release the link dependencies, which should all be fully loaded by now.
+	DynamicArray< LinkEntry >& rLinkTable = pRequest->linkTable;
+	size_t linkTableSize = rLinkTable.GetSize();
+	for( size_t linkIndex = 0; linkIndex < linkTableSize; ++linkIndex )
+	{
+		LinkEntry& rLinkEntry = rLinkTable[ linkIndex ];
+		if( IsValid( rLinkEntry.loadId ) )
+		{
+			HELIUM_VERIFY( TryFinishLoad( rLinkEntry.loadId, rLinkEntry.spObject ) );
+			SetInvalid( rLinkEntry.loadId );
+		}
+
+		rLinkEntry.spObject.Release();
+	}
+
+	rLinkTable.Resize( 0 );
+
+	GameObject* pObject = pRequest->spObject;
+	if( pObject )
+	{
 		// Perform any pre-precaching work (note that we don't precache anything for the default template object for
 		// a given type).
 		OnPrecacheReady( pObject, pRequest->pPackageLoader );
@@ -675,46 +846,64 @@ bool GameObjectLoader::TickPrecache( LoadRequest* pRequest )
 			!pObject->IsDefaultTemplate() &&
 			pObject->NeedsPrecacheResourceData() )
 		{
-			if( !( pRequest->stateFlags & LOAD_FLAG_PRECACHE_STARTED ) )
+			if( !pObject->BeginPrecacheResourceData() )
 			{
-				if( !pObject->BeginPrecacheResourceData() )
-				{
-					HELIUM_TRACE(
-						TraceLevels::Error,
-						TXT( "GameObjectLoader: Failed to begin precaching object \"%s\".\n" ),
-						*pObject->GetPath().ToString() );
-
-					pObject->SetFlags( GameObject::FLAG_PRECACHED | GameObject::FLAG_BROKEN );
-					AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_PRECACHED | LOAD_FLAG_ERROR );
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					TXT( "GameObjectLoader: Failed to begin precaching object \"%s\".\n" ),
+					*pObject->GetPath().ToString() );
 
-					return true;
-				}
+				pObject->SetFlags( GameObject::FLAG_PRECACHED | GameObject::FLAG_BROKEN );
+				SetRequestFlags( pRequest, LOAD_FLAG_PRECACHED | LOAD_FLAG_ERROR );
 
-				AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_PRECACHE_STARTED );
+				return true;
 			}
 
-			if( !pObject->TryFinishPrecacheResourceData() )
-			{
-				return false;
-			}
+			SetRequestFlags( pRequest, LOAD_FLAG_PRECACHE_STARTED );
+
+			return TickPrecache( pRequest );
 		}
 
 		pObject->SetFlags( GameObject::FLAG_PRECACHED );
 	}
 
-	AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_PRECACHED );
+	SetRequestFlags( pRequest, LOAD_FLAG_PRECACHED );
 
 	return true;
 }
 
-/// Update loading finalization for the given object load request.
+/// Update resource precaching for the given object load request.
 ///
-/// @param[in] pRequest  Load request to update.
+/// @param[in] pRequest  Load request for which precaching has been started.
 ///
-/// @return  True if load finalization has completed, false if not.
-bool GameObjectLoader::TickFinalizeLoad( LoadRequest* pRequest )
+/// @return  True if resource precaching has completed, false if it still requires processing.
+bool GameObjectLoader::TickPrecache( LoadRequest* pRequest )
 {
 	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->stateFlags & LOAD_FLAG_PRECACHE_STARTED );
+	HELIUM_ASSERT( !( pRequest->stateFlags & ( LOAD_FLAG_PRECACHED | LOAD_FLAG_LOADED ) ) );
+
+	GameObject* pObject = pRequest->spObject;
+	HELIUM_ASSERT( pObject );
+	if( !pObject->TryFinishPrecacheResourceData() )
+	{
+		return false;
+	}
+
+	pObject->SetFlags( GameObject::FLAG_PRECACHED );
+	SetRequestFlags( pRequest, LOAD_FLAG_PRECACHED );
+
+	return true;
+}
+
+/// Finalize loading for the given object load request.
+///
+/// @param[in] pRequest  Load request for which resource precaching has completed.
+void GameObjectLoader::FinalizeLoad( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->stateFlags & LOAD_FLAG_PRECACHED );
+	HELIUM_ASSERT( !( pRequest->stateFlags & LOAD_FLAG_LOADED ) );
 
 	GameObject* pObject = pRequest->spObject;
 	if( pObject )
@@ -722,11 +911,82 @@ bool GameObjectLoader::TickFinalizeLoad( LoadRequest* pRequest )
 		pObject->ConditionalFinalizeLoad();
 	}
 
+	// Hand loaded resources to the residency manager, if one is in use.
+	ResidencyManager* pResidencyManager = ResidencyManager::GetStaticInstance();
+	if( pResidencyManager && pObject && !( pRequest->stateFlags & LOAD_FLAG_ERROR ) && !pObject->IsDefaultTemplate() )
+	{
+		Resource* pResource = Reflect::SafeCast< Resource >( pObject );
+		if( pResource )
+		{
+			pResidencyManager->TrackResource( pResource );
+		}
+	}
+
 	// Loading now complete.
 	OnLoadComplete( pRequest->path, pObject, pRequest->pPackageLoader );
-	AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_LOADED );
+	SetRequestFlags( pRequest, LOAD_FLAG_LOADED );
+}
 
-	return true;
+/// Set load status flags for the given load request, queuing any requests waiting on it that are now ready for their
+/// next stage.
+///
+/// @param[in] pRequest  Load request.
+/// @param[in] flags     Load flags to set.
+void GameObjectLoader::SetRequestFlags( LoadRequest* pRequest, int32_t flags )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( m_notifyRequests.IsEmpty() );
+
+	// Take the lists of waiting requests before setting the flags, as the request may be released by another thread
+	// as soon as it has been flagged as fully loaded.
+	size_t preloadWaiterCount = 0;
+	if( flags & LOAD_FLAG_PRELOADED )
+	{
+		DynamicArray< LoadRequest* >& rPreloadWaiters = pRequest->preloadWaiters;
+		preloadWaiterCount = rPreloadWaiters.GetSize();
+		for( size_t waiterIndex = 0; waiterIndex < preloadWaiterCount; ++waiterIndex )
+		{
+			m_notifyRequests.Add( rPreloadWaiters[ waiterIndex ] );
+		}
+
+		rPreloadWaiters.Resize( 0 );
+	}
+
+	if( flags & LOAD_FLAG_LOADED )
+	{
+		DynamicArray< LoadRequest* >& rLoadWaiters = pRequest->loadWaiters;
+		size_t loadWaiterCount = rLoadWaiters.GetSize();
+		for( size_t waiterIndex = 0; waiterIndex < loadWaiterCount; ++waiterIndex )
+		{
+			m_notifyRequests.Add( rLoadWaiters[ waiterIndex ] );
+		}
+
+		rLoadWaiters.Resize( 0 );
+	}
+
+	AtomicOrRelease( pRequest->stateFlags, flags );
+
+	size_t notifyCount = m_notifyRequests.GetSize();
+	for( size_t notifyIndex = 0; notifyIndex < notifyCount; ++notifyIndex )
+	{
+		LoadRequest* pWaiter = m_notifyRequests[ notifyIndex ];
+		HELIUM_ASSERT( pWaiter );
+		HELIUM_ASSERT( pWaiter->pendingDependencyCount != 0 );
+		--pWaiter->pendingDependencyCount;
+		if( pWaiter->pendingDependencyCount == 0 )
+		{
+			if( notifyIndex < preloadWaiterCount )
+			{
+				m_linkReadyRequests.Add( pWaiter );
+			}
+			else
+			{
+				m_precacheReadyRequests.Add( pWaiter );
+			}
+		}
+	}
+
+	m_notifyRequests.Resize( 0 );
 }
 
 ///// Constructor.
@@ -11,6 +11,7 @@
 
 #include "Engine/Engine.h"
 
+#include "Platform/Thread.h"
 #include "Foundation/ConcurrentHashMap.h"
 #include "Foundation/ObjectPool.h"
 #include "Engine/GameObjectPath.h"
@@ -19,14 +20,30 @@
 
 namespace Helium
 {
+    class JobContext;
     class PackageLoader;
 
     /// Asynchronous object loading interface
+    ///
+    /// Load requests move through a pipeline of stages (preload, link, precache, and finalize).  Requests are only
+    /// updated when they can make progress: requests waiting on I/O from a package loader or on resource precaching
+    /// are kept in separate lists that are polled each tick, while requests waiting on other objects are registered
+    /// with those objects and queued for their next stage once the last of them reaches the required state.  Object
+    /// linking is performed in parallel using the job system.
+    ///
+    /// Tick() can be called from any thread, although only one thread at a time will actually update the pipeline.
+    /// The pipeline is not reentrant: Tick(), FinishLoad(), and LoadObject() must not be called while the current
+    /// thread is updating the pipeline (i.e. from package loader ticks or load callbacks), as the nested call could
+    /// never make progress.  Code running during an update should poll TryFinishLoad() instead.
     class HELIUM_ENGINE_API GameObjectLoader : NonCopyable
     {
     public:
         /// Number of request objects to allocate in each block of the request pool.
         static const size_t LOAD_REQUEST_POOL_BLOCK_SIZE = 64;
+        /// Maximum number of jobs to spawn at once when linking objects.
+        static const size_t LINK_JOB_COUNT_MAX = 16;
+        /// Minimum number of objects to link in a single job.
+        static const size_t LINK_JOB_REQUEST_COUNT_MIN = 8;
 
         /// GameObject link table entry.
         struct LinkEntry
@@ -61,6 +78,7 @@ namespace Helium
         /// @name Data Access
         //@{
         inline Name GetCacheName() const;
+        PackageLoader* FindPackageLoader( GameObjectPath path );
         //@}
 
         /// @name Static Access
@@ -93,10 +111,7 @@ namespace Helium
             LOAD_FLAG_ERROR = 1 << 4,
 
             /// Set if resource precaching has been started.
-            LOAD_FLAG_PRECACHE_STARTED = 1 << 5,
-
-            /// Set if ticking is in progress.
-            LOAD_FLAG_IN_TICK = 1 << 6
+            LOAD_FLAG_PRECACHE_STARTED = 1 << 5
         };
 
         /// GameObject load request information.
@@ -115,6 +130,16 @@ namespace Helium
             /// Link table.
             DynamicArray< LinkEntry > linkTable;
 
+            /// Load requests waiting for this object to be preloaded before they can be linked.
+            DynamicArray< LoadRequest* > preloadWaiters;
+            /// Load requests waiting for this object to be fully loaded before they can be precached.
+            DynamicArray< LoadRequest* > loadWaiters;
+            /// Number of objects on which this request is waiting before it can move on to its next stage.
+            size_t pendingDependencyCount;
+
+            /// Next request in the list of requests that have yet to be started.
+            LoadRequest* pNextNew;
+
             /// Loading status flags.
             volatile int32_t stateFlags;
 
@@ -201,16 +226,81 @@ namespace Helium
         //@}
 
     private:
+        /// Job for linking a range of load requests.
+        class LinkJob : NonCopyable
+        {
+        public:
+            class Parameters
+            {
+            public:
+                /// [in] Load requests to link.
+                LoadRequest* const* ppRequests;
+                /// [in] Number of load requests to link.
+                size_t requestCount;
+
+                /// @name Construction/Destruction
+                //@{
+                inline Parameters();
+                //@}
+            };
+
+            /// @name Parameters
+            //@{
+            inline Parameters& GetParameters();
+            //@}
+
+            /// @name Job Execution
+            //@{
+            void Run( JobContext* pContext );
+            inline static void RunCallback( void* pJob, JobContext* pContext );
+            inline static const char* GetTypeName();
+            //@}
+
+        private:
+            Parameters m_parameters;
+        };
+
         /// GameObject cache name.
         Name m_cacheName;
 
+        /// Load requests added since the last tick (lock-free list).
+        LoadRequest* volatile m_pNewRequestHead;
+
+        /// Load requests waiting on their package loader to finish preloading the object.
+        DynamicArray< LoadRequest* > m_preloadRequests;
+        /// Load requests with all link dependencies preloaded, ready to be linked.
+        DynamicArray< LoadRequest* > m_linkReadyRequests;
+        /// Load requests being linked in the current batch.
+        DynamicArray< LoadRequest* > m_linkRequests;
+        /// Load requests with all link dependencies fully loaded, ready to start resource precaching.
+        DynamicArray< LoadRequest* > m_precacheReadyRequests;
+        /// Load requests waiting on resource precaching to complete.
+        DynamicArray< LoadRequest* > m_precacheRequests;
+        /// Load requests to notify about a change in state of one of their dependencies.
+        DynamicArray< LoadRequest* > m_notifyRequests;
+
+        /// Non-zero while a thread is updating the load pipeline.
+        volatile int32_t m_tickLock;
+        /// Thread-local storage set to this loader while the current thread is updating the load pipeline.
+        ThreadLocalPointer m_tickingTls;
+
         /// @name Load Process Updating
         //@{
-        bool TickLoadRequest( LoadRequest* pRequest );
+        void StartNewRequests();
+        void TickPreloads();
+        void LinkReadyRequests();
+        void PrecacheReadyRequests();
+        void TickPrecaches();
+
         bool TickPreload( LoadRequest* pRequest );
-        bool TickLink( LoadRequest* pRequest );
+        void QueueLink( LoadRequest* pRequest );
+        static void LinkObject( LoadRequest* pRequest );
+        void QueuePrecache( LoadRequest* pRequest );
+        bool BeginPrecache( LoadRequest* pRequest );
         bool TickPrecache( LoadRequest* pRequest );
-        bool TickFinalizeLoad( LoadRequest* pRequest );
+        void FinalizeLoad( LoadRequest* pRequest );
+
+        void SetRequestFlags( LoadRequest* pRequest, int32_t flags );
         //@}
     };
 }
@@ -14,4 +14,38 @@ namespace Helium
     {
         return m_cacheName;
     }
+
+    /// Constructor.
+    GameObjectLoader::LinkJob::Parameters::Parameters()
+        : ppRequests( NULL )
+        , requestCount( 0 )
+    {
+    }
+
+    /// Get the parameters for this job.
+    ///
+    /// @return  Reference to the structure containing the job parameters.
+    GameObjectLoader::LinkJob::Parameters& GameObjectLoader::LinkJob::GetParameters()
+    {
+        return m_parameters;
+    }
+
+    /// Callback executed to run the job.
+    ///
+    /// @param[in] pJob      Job to run.
+    /// @param[in] pContext  Context associated with the running job instance.
+    void GameObjectLoader::LinkJob::RunCallback( void* pJob, JobContext* pContext )
+    {
+        HELIUM_ASSERT( pJob );
+        HELIUM_ASSERT( pContext );
+        static_cast< LinkJob* >( pJob )->Run( pContext );
+    }
+
+    /// Get the name of this job type.
+    ///
+    /// @return  Job type name.
+    const char* GameObjectLoader::LinkJob::GetTypeName()
+    {
+        return "GameObjectLoader::LinkJob";
+    }
 }
@@ -24,7 +24,10 @@ struct Helium::GameObjectPath::PendingLink
 
 using namespace Helium;
 
-GameObjectPath::TableBucket* GameObjectPath::sm_pTable = NULL;
+GameObjectPath::Table* volatile GameObjectPath::sm_pTable = NULL;
+GameObjectPath::Table* GameObjectPath::sm_pRetiredTables = NULL;
+size_t GameObjectPath::sm_entryCount = 0;
+Mutex GameObjectPath::sm_tableLock;
 StackMemoryHeap<>* GameObjectPath::sm_pEntryMemoryHeap = NULL;
 ObjectPool<GameObjectPath::PendingLink> *GameObjectPath::sm_pPendingLinksPool = NULL;
 
@@ -513,8 +516,22 @@ void GameObjectPath::Shutdown()
 {
     HELIUM_TRACE( TraceLevels::Info, TXT( "Shutting down GameObjectPath table.\n" ) );
 
-    delete [] sm_pTable;
-    sm_pTable = NULL;
+    Table* pTable = sm_pTable;
+    if( pTable )
+    {
+        DestroyTable( pTable->pPrevious );
+        DestroyTable( pTable );
+        sm_pTable = NULL;
+    }
+
+    while( sm_pRetiredTables )
+    {
+        Table* pRetiredTable = sm_pRetiredTables;
+        sm_pRetiredTables = pRetiredTable->pNextRetired;
+        DestroyTable( pRetiredTable );
+    }
+
+    sm_entryCount = 0;
 
     delete sm_pEntryMemoryHeap;
     sm_pEntryMemoryHeap = NULL;
@@ -525,6 +542,39 @@ void GameObjectPath::Shutdown()
     HELIUM_TRACE( TraceLevels::Info, TXT( "GameObjectPath table shutdown complete.\n" ) );
 }
 
+/// Get statistics on the object path table and its memory usage.
+///
+/// @param[out] rStatistics  Table statistics.
+void GameObjectPath::GetTableStatistics( TableStatistics& rStatistics )
+{
+    MutexScopeLock scopeLock( sm_tableLock );
+
+    rStatistics.entryCount = sm_entryCount;
+    rStatistics.slotCount = 0;
+    rStatistics.migratingSlotCount = 0;
+    rStatistics.entryMemory = sm_entryCount * sizeof( Entry );
+    rStatistics.tableMemory = 0;
+
+    Table* pTable = sm_pTable;
+    if( pTable )
+    {
+        rStatistics.slotCount = pTable->slotMask + 1;
+        rStatistics.tableMemory += sizeof( Table ) + sizeof( Entry* ) * rStatistics.slotCount;
+
+        Table* pPreviousTable = pTable->pPrevious;
+        if( pPreviousTable )
+        {
+            rStatistics.migratingSlotCount = pPreviousTable->slotMask + 1;
+            rStatistics.tableMemory += sizeof( Table ) + sizeof( Entry* ) * rStatistics.migratingSlotCount;
+        }
+    }
+
+    for( Table* pRetiredTable = sm_pRetiredTables; pRetiredTable != NULL; pRetiredTable = pRetiredTable->pNextRetired )
+    {
+        rStatistics.tableMemory += sizeof( Table ) + sizeof( Entry* ) * ( pRetiredTable->slotMask + 1 );
+    }
+}
+
 /// Convert the path separator characters in the given object path to valid directory delimiters for the current
 /// platform.
 ///
@@ -874,28 +924,135 @@ GameObjectPath::Entry* GameObjectPath::Add( const Entry& rEntry )
         HELIUM_ASSERT( sm_pPendingLinksPool );
 
         HELIUM_ASSERT( !sm_pTable );
-        sm_pTable = new TableBucket [ TABLE_BUCKET_COUNT ];
+        sm_pTable = CreateTable( TABLE_SLOT_COUNT_INITIAL );
         HELIUM_ASSERT( sm_pTable );
     }
 
-    HELIUM_ASSERT( sm_pTable );
+    // Most paths being set already exist, so search the table without locking first.
+    size_t hash = ComputeEntryHash( rEntry );
+    Entry* pTableEntry = Find( rEntry, hash );
+    if( pTableEntry )
+    {
+        return pTableEntry;
+    }
 
-    // Compute the entry's hash table index and retrieve the corresponding bucket.
-    uint32_t bucketIndex = ComputeEntryStringHash( rEntry ) % TABLE_BUCKET_COUNT;
-    TableBucket& rBucket = sm_pTable[ bucketIndex ];
+    MutexScopeLock scopeLock( sm_tableLock );
 
-    // Locate the entry in the table.  If it does not exist, add it.
-    size_t entryCount = 0;
-    Entry* pTableEntry = rBucket.Find( rEntry, entryCount );
-    if( !pTableEntry )
+    // Check whether the entry was added by another thread before we acquired the lock.
+    pTableEntry = Find( rEntry, hash );
+    if( pTableEntry )
     {
-        pTableEntry = rBucket.Add( rEntry, entryCount );
-        HELIUM_ASSERT( pTableEntry );
+        return pTableEntry;
+    }
+
+    Table* pTable = sm_pTable;
+    HELIUM_ASSERT( pTable );
+
+    // Grow the table once it becomes half full.  Any previous migration is completed first, so only one old table
+    // needs to be searched at a time.
+    size_t slotCount = pTable->slotMask + 1;
+    if( ( sm_entryCount + 1 ) * 2 > slotCount )
+    {
+        if( pTable->pPrevious )
+        {
+            MigrateTableEntries( pTable, Invalid< size_t >() );
+        }
+
+        Table* pNewTable = CreateTable( slotCount * 2 );
+        HELIUM_ASSERT( pNewTable );
+        pNewTable->pPrevious = pTable;
+
+        AtomicExchangeRelease( sm_pTable, pNewTable );
+        pTable = pNewTable;
+    }
+
+    // Migrate a few more entries from the previous table if the table is growing.
+    if( pTable->pPrevious )
+    {
+        MigrateTableEntries( pTable, TABLE_MIGRATE_SLOT_COUNT );
+    }
+
+    HELIUM_ASSERT( sm_pEntryMemoryHeap );
+    Entry* pNewEntry = static_cast< Entry* >( sm_pEntryMemoryHeap->Allocate( sizeof( Entry ) ) );
+    HELIUM_ASSERT( pNewEntry );
+    new( pNewEntry ) Entry( rEntry );
+    pNewEntry->hash = hash;
+    pNewEntry->instance = NULL;
+    pNewEntry->rpFirstPendingLink = NULL;
+
+    InsertTableEntry( pTable, pNewEntry );
+    ++sm_entryCount;
+
+    return pNewEntry;
+}
+
+/// Look up a table entry without adding it if it does not exist.
+///
+/// @param[in] rEntry  Entry to locate.
+///
+/// @return  Pointer to the actual table entry if found, null if not found.
+GameObjectPath::Entry* GameObjectPath::Find( const Entry& rEntry )
+{
+    return Find( rEntry, ComputeEntryHash( rEntry ) );
+}
+
+/// Look up a table entry without adding it if it does not exist.
+///
+/// This does not acquire any locks.  Entries being added by other threads at the same time may not be found.
+///
+/// @param[in] rEntry  Entry to locate.
+/// @param[in] hash    Entry hash, as computed by ComputeEntryHash().
+///
+/// @return  Pointer to the actual table entry if found, null if not found.
+GameObjectPath::Entry* GameObjectPath::Find( const Entry& rEntry, size_t hash )
+{
+    Table* pTable = sm_pTable;
+    if( !pTable )
+    {
+        return NULL;
+    }
+
+    // Entries added before the table started growing may not have been migrated yet.  The previous table must be
+    // read (volatile, acquire) before searching the current one, as migration can complete and clear it during the
+    // search; retired tables stay valid until shutdown, so an entry missed in one table will be found in the other.
+    Table* pPreviousTable = pTable->pPrevious;
+
+    Entry* pTableEntry = FindTableEntry( pTable, rEntry, hash );
+    if( !pTableEntry && pPreviousTable )
+    {
+        pTableEntry = FindTableEntry( pPreviousTable, rEntry, hash );
     }
 
     return pTableEntry;
 }
 
+/// Find the object registered with the path built from the given parameters.
+///
+/// Unlike Set(), this will not add the path to the path table if it has not been used before.
+///
+/// @param[in] name           GameObject name.
+/// @param[in] bPackage       True if the object is a package, false if not.
+/// @param[in] parentPath     FilePath to the parent object.
+/// @param[in] instanceIndex  GameObject instance index.
+///
+/// @return  GameObject registered with the specified path, or null if no such object exists.
+///
+/// @see GetInstance()
+GameObject* GameObjectPath::FindInstance( Name name, bool bPackage, GameObjectPath parentPath, uint32_t instanceIndex )
+{
+    Entry entry;
+    entry.pParent = parentPath.m_pEntry;
+    entry.name = name;
+    entry.instanceIndex = instanceIndex;
+    entry.bPackage = bPackage;
+    entry.instance = NULL;
+    entry.rpFirstPendingLink = NULL;
+
+    Entry* pTableEntry = Find( entry );
+
+    return ( pTableEntry ? pTableEntry->instance : NULL );
+}
+
 /// Recursive function for building the string representation of an object path entry.
 ///
 /// @param[in]  rEntry   FilePath entry.
@@ -939,13 +1096,14 @@ void GameObjectPath::EntryToFilePathString( const Entry& rEntry, String& rString
     rString += rEntry.name.Get();
 }
 
-/// Compute a hash value for an object path entry based on the contents of the name strings (slow, should only be
-/// used internally when a string comparison is needed).
+/// Compute a hash value for an object path entry based on the contents of the name strings.
+///
+/// The hash of the parent path is taken from the parent table entry, so this does not need to walk the entire path.
 ///
 /// @param[in] rEntry  GameObject path entry.
 ///
 /// @return  Hash value.
-size_t GameObjectPath::ComputeEntryStringHash( const Entry& rEntry )
+size_t GameObjectPath::ComputeEntryHash( const Entry& rEntry )
 {
     size_t hash = StringHash( rEntry.name.GetDirect() );
     hash = ( ( hash * 33 ) ^ rEntry.instanceIndex );
@@ -957,8 +1115,7 @@ size_t GameObjectPath::ComputeEntryStringHash( const Entry& rEntry )
     Entry* pParent = rEntry.pParent;
     if( pParent )
     {
-        size_t parentHash = ComputeEntryStringHash( *pParent );
-        hash = ( ( hash * 33 ) ^ parentHash );
+        hash = ( ( hash * 33 ) ^ pParent->hash );
     }
 
     return hash;
@@ -978,72 +1135,148 @@ bool GameObjectPath::EntryContentsMatch( const Entry& rEntry0, const Entry& rEnt
         rEntry0.pParent == rEntry1.pParent );
 }
 
-/// Find an existing object path entry in this table.
+/// Allocate an empty path hash table.
 ///
-/// @param[in]  rEntry       Externally defined entry to match.
-/// @param[out] rEntryCount  Number of entries in this bucket when the search was performed.
+/// @param[in] slotCount  Number of table slots (must be a power of two).
 ///
-/// @return  Table entry if found, null if not found.
+/// @return  Newly allocated table.
+///
+/// @see DestroyTable()
+GameObjectPath::Table* GameObjectPath::CreateTable( size_t slotCount )
+{
+    HELIUM_ASSERT( slotCount != 0 );
+    HELIUM_ASSERT( ( slotCount & ( slotCount - 1 ) ) == 0 );
+
+    DefaultAllocator allocator;
+
+    Table* pTable = new Table;
+    HELIUM_ASSERT( pTable );
+    pTable->pSlots = static_cast< Entry* volatile* >( allocator.Allocate( sizeof( Entry* ) * slotCount ) );
+    HELIUM_ASSERT( pTable->pSlots );
+    MemoryZero( const_cast< Entry** >( pTable->pSlots ), sizeof( Entry* ) * slotCount );
+    pTable->slotMask = slotCount - 1;
+    pTable->pPrevious = NULL;
+    pTable->migrateIndex = 0;
+    pTable->pNextRetired = NULL;
+
+    return pTable;
+}
+
+/// Free a path hash table (the entries referenced by the table are not freed).
+///
+/// @param[in] pTable  Table to free.
 ///
-/// @see Add()
-GameObjectPath::Entry* GameObjectPath::TableBucket::Find( const Entry& rEntry, size_t& rEntryCount )
+/// @see CreateTable()
+void GameObjectPath::DestroyTable( Table* pTable )
 {
-    ScopeReadLock readLock( m_lock );
+    if( pTable )
+    {
+        DefaultAllocator().Free( const_cast< Entry** >( pTable->pSlots ) );
+        delete pTable;
+    }
+}
 
-    Entry* const * ppTableEntries = m_entries.GetData();
-    size_t entryCount = m_entries.GetSize();
-    HELIUM_ASSERT( ppTableEntries || entryCount == 0 );
+/// Search a single path hash table for an entry.
+///
+/// This does not acquire any locks.  Table slots are only ever filled in (never cleared or modified), so a search can
+/// safely run while another thread adds entries to the same table.
+///
+/// @param[in] pTable  Table to search.
+/// @param[in] rEntry  Entry to locate.
+/// @param[in] hash    Entry hash.
+///
+/// @return  Table entry if found, null if not found.
+GameObjectPath::Entry* GameObjectPath::FindTableEntry( const Table* pTable, const Entry& rEntry, size_t hash )
+{
+    HELIUM_ASSERT( pTable );
 
-    rEntryCount = entryCount;
+    Entry* volatile* pSlots = pTable->pSlots;
+    size_t slotMask = pTable->slotMask;
 
-    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    for( size_t slotIndex = hash & slotMask; ; slotIndex = ( slotIndex + 1 ) & slotMask )
     {
-        Entry* pTableEntry = ppTableEntries[ entryIndex ];
-        HELIUM_ASSERT( pTableEntry );
-        if( EntryContentsMatch( rEntry, *pTableEntry ) )
+        Entry* pTableEntry = pSlots[ slotIndex ];
+        if( !pTableEntry )
+        {
+            return NULL;
+        }
+
+        // Compare the full hash first to avoid comparing the contents of entries that can't possibly match.
+        if( pTableEntry->hash == hash && EntryContentsMatch( rEntry, *pTableEntry ) )
         {
             return pTableEntry;
         }
     }
-
-    return NULL;
 }
 
-/// Add an object path entry to this table if it does not already exist.
+/// Insert an entry into a path hash table.
 ///
-/// @param[in] rEntry              Externally defined entry to locate or add.
-/// @param[in] previousEntryCount  Number of entries already checked during a previous Find() call (existing entries
-///                                are not expected to change).  In other words, the entry index from which to start
-///                                checking for any additional string entries that may have been added since the
-///                                previous Find() call.
+/// This must only be called while holding the table lock, and the table must have at least one free slot.
 ///
-/// @return  Pointer to the object path table entry.
+/// @param[in] pTable  Table in which to insert the entry.
+/// @param[in] pEntry  Entry to insert.
+void GameObjectPath::InsertTableEntry( Table* pTable, Entry* pEntry )
+{
+    HELIUM_ASSERT( pTable );
+    HELIUM_ASSERT( pEntry );
+
+    Entry* volatile* pSlots = pTable->pSlots;
+    size_t slotMask = pTable->slotMask;
+
+    size_t slotIndex = pEntry->hash & slotMask;
+    while( pSlots[ slotIndex ] )
+    {
+        HELIUM_ASSERT( pSlots[ slotIndex ] != pEntry );
+        slotIndex = ( slotIndex + 1 ) & slotMask;
+    }
+
+    // Make sure the entry contents are visible to other threads before the entry itself.
+    AtomicExchangeRelease( pSlots[ slotIndex ], pEntry );
+}
+
+/// Migrate entries from the table being replaced by the given table.
 ///
-/// @see Find()
-GameObjectPath::Entry* GameObjectPath::TableBucket::Add( const Entry& rEntry, size_t previousEntryCount )
+/// This must only be called while holding the table lock.  Once all entries have been migrated, the previous table is
+/// moved to the list of retired tables.
+///
+/// @param[in] pTable     Table into which entries should be migrated.
+/// @param[in] slotCount  Maximum number of slots in the previous table to migrate (pass an invalid count to migrate all
+///                       remaining slots).
+void GameObjectPath::MigrateTableEntries( Table* pTable, size_t slotCount )
 {
-    ScopeWriteLock writeLock( m_lock );
+    HELIUM_ASSERT( pTable );
+
+    Table* pPreviousTable = pTable->pPrevious;
+    HELIUM_ASSERT( pPreviousTable );
+    HELIUM_ASSERT( !pPreviousTable->pPrevious );
 
-    Entry* const * ppTableEntries = m_entries.GetData();
-    size_t entryCount = m_entries.GetSize();
-    HELIUM_ASSERT( ppTableEntries || entryCount == 0 );
-    HELIUM_ASSERT( previousEntryCount <= entryCount );
-    for( size_t entryIndex = previousEntryCount; entryIndex < entryCount; ++entryIndex )
+    Entry* volatile* pPreviousSlots = pPreviousTable->pSlots;
+    size_t previousSlotCount = pPreviousTable->slotMask + 1;
+
+    size_t slotIndex = pTable->migrateIndex;
+    size_t endSlotIndex = previousSlotCount;
+    if( IsValid( slotCount ) && previousSlotCount - slotIndex > slotCount )
     {
-        Entry* pTableEntry = ppTableEntries[ entryIndex ];
-        HELIUM_ASSERT( pTableEntry );
-        if( EntryContentsMatch( rEntry, *pTableEntry ) )
+        endSlotIndex = slotIndex + slotCount;
+    }
+
+    for( ; slotIndex < endSlotIndex; ++slotIndex )
+    {
+        Entry* pEntry = pPreviousSlots[ slotIndex ];
+        if( pEntry )
         {
-            return pTableEntry;
+            InsertTableEntry( pTable, pEntry );
         }
     }
 
-    HELIUM_ASSERT( sm_pEntryMemoryHeap );
-    Entry* pNewEntry = static_cast< Entry* >( sm_pEntryMemoryHeap->Allocate( sizeof( Entry ) ) );
-    HELIUM_ASSERT( pNewEntry );
-    new( pNewEntry ) Entry( rEntry );
+    pTable->migrateIndex = endSlotIndex;
 
-    m_entries.Push( pNewEntry );
+    if( endSlotIndex == previousSlotCount )
+    {
+        // Other threads may still be searching the previous table, so keep it around until shutdown.
+        AtomicExchangeRelease( pTable->pPrevious, static_cast< Table* >( NULL ) );
 
-    return pNewEntry;
+        pPreviousTable->pNextRetired = sm_pRetiredTables;
+        sm_pRetiredTables = pPreviousTable;
+    }
 }
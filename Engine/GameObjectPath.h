@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Platform/Atomic.h"
 #include "Platform/Locks.h"
 
 #include "Foundation/Name.h"
@@ -32,11 +33,25 @@ namespace Helium
     class GameObject;
 
     /// Hashed object path name for fast lookups and comparisons.
+    ///
+    /// Each unique path is stored once in a global table, and each table entry also tracks the GameObject currently
+    /// registered with that path.  This lets GameObject::FindObject() resolve a path directly without searching
+    /// through the object hierarchy.
+    ///
+    /// The path table is an open-addressed hash table that is searched without locking.  Adding new paths is
+    /// serialized with a mutex.  When the table needs to grow, a table twice the size is created and entries are
+    /// migrated over a few slots at a time with each subsequent addition, with lookups checking both tables until the
+    /// migration is complete.  Table slot arrays that have been replaced are kept until Shutdown(), as other threads may
+    /// still be searching them.
     class HELIUM_ENGINE_API GameObjectPath
     {
+        friend class GameObject;
+
     public:
-        /// Number of object path hash table buckets (prime numbers are recommended).
-        static const size_t TABLE_BUCKET_COUNT = 37;
+        /// Initial number of object path hash table slots (must be a power of two).
+        static const size_t TABLE_SLOT_COUNT_INITIAL = 4096;
+        /// Number of slots to migrate from the previous hash table with each path addition while the table is growing.
+        static const size_t TABLE_MIGRATE_SLOT_COUNT = 64;
         /// GameObject path stack memory heap block size.
         static const size_t STACK_HEAP_BLOCK_SIZE = sizeof( tchar_t ) * 8192;
         /// Block size for pool of pending links
@@ -82,11 +97,31 @@ namespace Helium
         inline bool operator!=( GameObjectPath path ) const;
         //@}
 
+        /// Object path table statistics.
+        struct TableStatistics
+        {
+            /// Number of unique paths in the table.
+            size_t entryCount;
+            /// Number of slots in the current hash table.
+            size_t slotCount;
+            /// Number of slots in the previous hash table still being migrated (zero if the table is not growing).
+            size_t migratingSlotCount;
+            /// Memory used by path entries, in bytes.
+            size_t entryMemory;
+            /// Memory used by all hash table slot arrays (including replaced tables), in bytes.
+            size_t tableMemory;
+        };
+
         /// @name Static Initialization
         //@{
         static void Shutdown();
         //@}
 
+        /// @name Table Statistics
+        //@{
+        static void GetTableStatistics( TableStatistics& rStatistics );
+        //@}
+
         /// @name File Support
         //@{
         static void ConvertStringToFilePath( String& rFilePath, const String& rPackagePath );
@@ -101,6 +136,8 @@ namespace Helium
         {
             /// Parent entry.
             Entry* pParent;
+            /// Hash of the full path (computed when the entry is added to the table).
+            size_t hash;
             /// GameObject name.
             Name name;
             /// GameObject instance index.
@@ -108,9 +145,10 @@ namespace Helium
             /// True if the object is a package.
             bool bPackage;
             
-            /// Pointer to instance of object
-            class GameObject *instance; // NOTE: Hate raw pointers but GameObject depends on GameObjectPath
-                                        //       so can't use smart pointer
+            /// Pointer to instance of object (updated by GameObject while holding its object list write lock, but
+            /// read without locking).
+            class GameObject* volatile instance; // NOTE: Hate raw pointers but GameObject depends on GameObjectPath
+                                                 //       so can't use smart pointer
 
             /// Links other objects have placed on this object
             /// NOTE: For thread safety, this is a weird variables
@@ -122,28 +160,32 @@ namespace Helium
             PendingLink * volatile rpFirstPendingLink;
         };
 
-        /// GameObject path hash table bucket.
-        class TableBucket
+        /// Open-addressed GameObject path hash table.
+        struct Table
         {
-        public:
-            /// @name Access
-            //@{
-            Entry* Find( const Entry& rEntry, size_t& rEntryCount );
-            Entry* Add( const Entry& rEntry, size_t previousEntryCount );
-            //@}
-
-        private:
-            /// Array of entry pointers.
-            DynamicArray< Entry* > m_entries;
-            /// Read-write lock for synchronizing access.
-            ReadWriteLock m_lock;
+            /// Table slots (null for unused slots).
+            Entry* volatile* pSlots;
+            /// Slot index mask (slot count minus one).
+            size_t slotMask;
+            /// Previous table from which entries are still being migrated (null if migration has completed).
+            Table* volatile pPrevious;
+            /// Index of the next slot in the previous table to migrate.
+            size_t migrateIndex;
+            /// Next table in the list of replaced tables.
+            Table* pNextRetired;
         };
 
         /// GameObject path entry.
         Entry* m_pEntry;
 
         /// GameObject path hash table.
-        static TableBucket* sm_pTable;
+        static Table* volatile sm_pTable;
+        /// Tables that have been replaced and fully migrated.
+        static Table* sm_pRetiredTables;
+        /// Number of entries in the path table.
+        static size_t sm_entryCount;
+        /// Mutex for synchronizing additions to the path table.
+        static Mutex sm_tableLock;
         /// Stack-based memory heap for object path entry allocations.
         static StackMemoryHeap<>* sm_pEntryMemoryHeap;
         static ObjectPool<PendingLink> *sm_pPendingLinksPool;
@@ -153,6 +195,15 @@ namespace Helium
         void Set( const Name* pNames, const uint32_t* pInstanceIndices, size_t nameCount, size_t packageCount );
         //@}
 
+        /// @name GameObject Instance Tracking
+        //@{
+        inline GameObject* GetInstance() const;
+        inline void SetInstance( GameObject* pObject ) const;
+
+        static GameObject* FindInstance(
+            Name name, bool bPackage, GameObjectPath parentPath, uint32_t instanceIndex = Invalid< uint32_t >() );
+        //@}
+
         /// @name Static Utility Functions
         //@{
         static bool Parse(
@@ -160,13 +211,24 @@ namespace Helium
             size_t& rNameCount, size_t& rPackageCount );
 
         static Entry* Add( const Entry& rEntry );
+        static Entry* Find( const Entry& rEntry );
+        static Entry* Find( const Entry& rEntry, size_t hash );
 
         static void EntryToString( const Entry& rEntry, String& rString );
         static void EntryToFilePathString( const Entry& rEntry, String& rString );
 
-        static size_t ComputeEntryStringHash( const Entry& rEntry );
+        static size_t ComputeEntryHash( const Entry& rEntry );
         static bool EntryContentsMatch( const Entry& rEntry0, const Entry& rEntry1 );
         //@}
+
+        /// @name Path Table Functions
+        //@{
+        static Table* CreateTable( size_t slotCount );
+        static void DestroyTable( Table* pTable );
+        static Entry* FindTableEntry( const Table* pTable, const Entry& rEntry, size_t hash );
+        static void InsertTableEntry( Table* pTable, Entry* pEntry );
+        static void MigrateTableEntries( Table* pTable, size_t slotCount );
+        //@}
     };
 }
 
@@ -130,6 +130,31 @@ namespace Helium
     {
         return ( m_pEntry != path.m_pEntry );
     }
+
+    /// Get the object currently registered with this path.
+    ///
+    /// This does not acquire any locks, so it is safe to call from any thread.
+    ///
+    /// @return  GameObject registered with this path, or null if no object is using this path (or the path is empty).
+    ///
+    /// @see SetInstance(), FindInstance()
+    GameObject* GameObjectPath::GetInstance() const
+    {
+        return ( m_pEntry ? m_pEntry->instance : NULL );
+    }
+
+    /// Set the object currently registered with this path.
+    ///
+    /// This should only be called by GameObject while holding a write lock on its object list.
+    ///
+    /// @param[in] pObject  GameObject to register with this path, or null to clear the registered object.
+    ///
+    /// @see GetInstance()
+    void GameObjectPath::SetInstance( GameObject* pObject ) const
+    {
+        HELIUM_ASSERT( m_pEntry );
+        AtomicExchangeRelease( m_pEntry->instance, pObject );
+    }
 }
 
 namespace Helium
@@ -1,8 +1,10 @@
 #include "EnginePch.h"
 #include "Engine/GameObjectType.h"
 
+#include "Platform/Atomic.h"
 #include "Foundation/ObjectPool.h"
 #include "Reflect/Registry.h"
+#include "Engine/GameObjectCopyPlan.h"
 #include "Engine/GameObjectPointerData.h"
 
 #include "Engine/Package.h"
@@ -16,12 +18,44 @@ GameObjectType::LookupMap* GameObjectType::sm_pLookupMap = NULL;
 GameObjectType::GameObjectType()
     : m_class( NULL )
     , m_flags( 0 )
+    , m_pCopyPlan( NULL )
 {
 }
 
 /// Destructor.
 GameObjectType::~GameObjectType()
 {
+    delete m_pCopyPlan;
+}
+
+/// Get the plan for copying the reflected fields of instances of this type.
+///
+/// The plan is built the first time it is requested, as the type's fields are not populated until after the type is
+/// created.  This is safe to call from any thread.
+///
+/// @return  Field copy plan.
+const GameObjectCopyPlan* GameObjectType::GetCopyPlan() const
+{
+    GameObjectCopyPlan* pPlan = m_pCopyPlan;
+    if( !pPlan )
+    {
+        HELIUM_ASSERT( m_class );
+        GameObjectCopyPlan* pNewPlan = new GameObjectCopyPlan( m_class );
+        HELIUM_ASSERT( pNewPlan );
+
+        // If another thread built the plan at the same time, use its plan instead of ours.
+        pPlan = AtomicCompareExchangeRelease( m_pCopyPlan, pNewPlan, static_cast< GameObjectCopyPlan* >( NULL ) );
+        if( pPlan )
+        {
+            delete pNewPlan;
+        }
+        else
+        {
+            pPlan = pNewPlan;
+        }
+    }
+
+    return pPlan;
 }
 
 /// Set the package in which all template object packages are stored.
@@ -19,6 +19,8 @@ namespace Helium
     class GameObjectType;
     typedef SmartPtr< GameObjectType > GameObjectTypePtr;
 
+    class GameObjectCopyPlan;
+
     /// Run-time type information for GameObject classes.
     class HELIUM_ENGINE_API GameObjectType : public Helium::AtomicRefCountBase< GameObjectType >
     {
@@ -90,6 +92,8 @@ namespace Helium
         inline GameObject* GetTemplate() const;
 
         inline uint32_t GetFlags() const;
+
+        const GameObjectCopyPlan* GetCopyPlan() const;
         //@}
 
         /// @name Static Type Registration
@@ -115,6 +119,8 @@ namespace Helium
         Name m_name;
         /// Type flags.
         uint32_t m_flags;
+        /// Field copy plan (built on first use).
+        mutable GameObjectCopyPlan* volatile m_pCopyPlan;
 
         /// Main package containing all template objects.
         static PackagePtr sm_spTypePackage;
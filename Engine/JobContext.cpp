@@ -8,13 +8,28 @@
 #include "EnginePch.h"
 #include "Engine/JobContext.h"
 
+#if !HELIUM_NATIVE_JOB_SCHEDULER
 #include "Engine/JobTask.h"
+#endif
 
 using namespace Helium;
 
 /// Constructor.
 JobContext::JobContext()
+#if HELIUM_NATIVE_JOB_SCHEDULER
+: m_pParent( NULL )
+, m_pRootCounter( NULL )
+, m_pNextMail( NULL )
+, m_pendingCount( 1 )
+, m_affinity( JobScheduler::INVALID_WORKER_INDEX )
+#else
 : m_pTask( NULL )
+#endif
+#if HELIUM_PROFILE_JOBS
+, m_profileId( 0 )
+, m_profileParentId( 0 )
+, m_bProfileContinuation( false )
+#endif
 , m_pActiveSpawner( NULL )
 , m_bAllocatedChildren( false )
 {
@@ -25,6 +40,25 @@ JobContext::~JobContext()
 {
 }
 
+/// Set the worker on which this job should preferably run.
+///
+/// This is only a hint; the job may still be run by any worker if the preferred worker is busy.  It must be set
+/// before the job is spawned.
+///
+/// @param[in] workerIndex  Index of the preferred worker.
+void JobContext::SetAffinity( uint32_t workerIndex )
+{
+#if HELIUM_NATIVE_JOB_SCHEDULER
+    m_affinity = workerIndex;
+#else
+    // TBB affinity IDs are one-based, with zero meaning no affinity.
+    HELIUM_ASSERT( m_pTask );
+    m_pTask->set_affinity( static_cast< tbb::task::affinity_id >( workerIndex + 1 ) );
+#endif
+}
+
+#if !HELIUM_NATIVE_JOB_SCHEDULER
+
 /// Allocate a TBB child task instance for a given job context.
 ///
 /// @param[in] pChildContext  Context for the child job.
@@ -77,3 +111,5 @@ tbb::task* JobContext::AllocateRootTask( JobContext* pContext )
 
     return pRootTask;
 }
+
+#endif  // !HELIUM_NATIVE_JOB_SCHEDULER
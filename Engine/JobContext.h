@@ -14,13 +14,18 @@
 #include "Platform/Trace.h"
 #include "Foundation/DynamicArray.h"
 #include "Engine/JobManager.h"
+#include "Engine/JobProfiler.h"
 
+#if HELIUM_NATIVE_JOB_SCHEDULER
+#include "Engine/JobScheduler.h"
+#else
 #include <tbb/task.h>
 
 namespace tbb
 {
     class task;
 }
+#endif
 
 namespace Helium
 {
@@ -49,6 +54,9 @@ namespace Helium
 
             inline void* GetData() const;
             inline JOB_EXECUTE_CALLBACK* GetExecuteCallback() const;
+#if HELIUM_PROFILE_JOBS
+            inline const char* GetTypeName() const;
+#endif
             //@}
 
         private:
@@ -56,6 +64,10 @@ namespace Helium
             void* m_pData;
             /// Job execution callback.
             JOB_EXECUTE_CALLBACK* m_pExecuteCallback;
+#if HELIUM_PROFILE_JOBS
+            /// Job type name (for profiling).
+            const char* m_pTypeName;
+#endif
         };
 
         /// Job spawner.
@@ -115,12 +127,46 @@ namespace Helium
         inline const AttachData& GetAttachData() const;
         //@}
 
+        /// @name Scheduling Hints
+        //@{
+        void SetAffinity( uint32_t workerIndex );
+        //@}
+
     private:
+#if HELIUM_NATIVE_JOB_SCHEDULER
+        friend class JobScheduler;
+#endif
+#if HELIUM_PROFILE_JOBS
+        friend class JobProfiler;
+#endif
+
         /// Job attachment data.
         AttachData m_attachData;
 
+#if HELIUM_NATIVE_JOB_SCHEDULER
+        /// Context to notify when this job and all of its children have completed.
+        JobContext* m_pParent;
+        /// Counter to decrement when this root job and all of its children have completed.
+        volatile int32_t* m_pRootCounter;
+        /// Next context in a worker mailbox.
+        JobContext* m_pNextMail;
+        /// Number of child jobs that have not yet completed, plus one while this job has not finished executing.
+        volatile int32_t m_pendingCount;
+        /// Index of the worker on which this job should preferably run.
+        uint32_t m_affinity;
+#else
         /// TBB task.
         tbb::task* m_pTask;
+#endif
+
+#if HELIUM_PROFILE_JOBS
+        /// Profiler ID of this job (assigned when the job is run while profiling).
+        uint32_t m_profileId;
+        /// Profiler ID of the job that spawned this job (zero for root jobs).
+        uint32_t m_profileParentId;
+        /// True if this job is a continuation of the job that spawned it.
+        bool m_bProfileContinuation;
+#endif
 
         /// Currently active spawner (for checking; never dereferenced).
         void* m_pActiveSpawner;
@@ -132,6 +178,7 @@ namespace Helium
         JobContext();
         //@}
 
+#if !HELIUM_NATIVE_JOB_SCHEDULER
         /// @name TBB Task Allocation
         //@{
         tbb::task* AllocateChildTask( JobContext* pChildContext );
@@ -142,6 +189,7 @@ namespace Helium
         //@{
         static tbb::task* AllocateRootTask( JobContext* pContext );
         //@}
+#endif
     };
 }
 
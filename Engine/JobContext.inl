@@ -79,6 +79,9 @@ namespace Helium
     JobContext::AttachData::AttachData()
         : m_pData( NULL )
         , m_pExecuteCallback( NULL )
+#if HELIUM_PROFILE_JOBS
+        , m_pTypeName( NULL )
+#endif
     {
     }
 
@@ -89,6 +92,9 @@ namespace Helium
     JobContext::AttachData::AttachData( JobType* pJob )
         : m_pData( pJob )
         , m_pExecuteCallback( JobType::RunCallback )
+#if HELIUM_PROFILE_JOBS
+        , m_pTypeName( JobType::GetTypeName() )
+#endif
     {
         HELIUM_ASSERT( pJob );
     }
@@ -105,6 +111,9 @@ namespace Helium
 
         m_pData = pJob;
         m_pExecuteCallback = JobType::RunCallback;
+#if HELIUM_PROFILE_JOBS
+        m_pTypeName = JobType::GetTypeName();
+#endif
     }
 
     /// Set the job to attach.
@@ -120,6 +129,9 @@ namespace Helium
 
         m_pData = pData;
         m_pExecuteCallback = pExecuteCallback;
+#if HELIUM_PROFILE_JOBS
+        m_pTypeName = NULL;
+#endif
     }
 
     /// Clear the job information.
@@ -129,6 +141,9 @@ namespace Helium
     {
         m_pData = NULL;
         m_pExecuteCallback = NULL;
+#if HELIUM_PROFILE_JOBS
+        m_pTypeName = NULL;
+#endif
     }
 
     /// Get the pointer to the job data.
@@ -151,6 +166,18 @@ namespace Helium
         return m_pExecuteCallback;
     }
 
+#if HELIUM_PROFILE_JOBS
+    /// Get the name of the attached job's type.
+    ///
+    /// @return  Job type name, or null if the job was attached without type information.
+    ///
+    /// @see GetData(), GetExecuteCallback()
+    const char* JobContext::AttachData::GetTypeName() const
+    {
+        return m_pTypeName;
+    }
+#endif
+
     /// Constructor.
     ///
     /// @param[in] pContext  Job context from which to spawn jobs, or null to spawn root jobs.  Note that continuation
@@ -234,6 +261,10 @@ namespace Helium
             HELIUM_ASSERT( pChildContext );
             new( pChildContext ) JobContext;
 
+#if HELIUM_PROFILE_JOBS
+            pChildContext->m_profileParentId = m_pContext->m_profileId;
+#endif
+
             // Allocate jobs as children of the continuation context if one has been already allocated.
             JobContext* pSourceContext = m_pContinuationContext;
             if( !pSourceContext )
@@ -241,10 +272,14 @@ namespace Helium
                 pSourceContext = m_pContext;
             }
 
+#if HELIUM_NATIVE_JOB_SCHEDULER
+            pChildContext->m_pParent = pSourceContext;
+#else
             tbb::task* pChildTask = pSourceContext->AllocateChildTask( pChildContext );
             HELIUM_ASSERT( pChildTask );
 
             pChildContext->m_pTask = pChildTask;
+#endif
         }
         else
         {
@@ -253,10 +288,12 @@ namespace Helium
             HELIUM_ASSERT( pChildContext );
             new( pChildContext ) JobContext;
 
+#if !HELIUM_NATIVE_JOB_SCHEDULER
             tbb::task* pChildTask = JobContext::AllocateRootTask( pChildContext );
             HELIUM_ASSERT( pChildTask );
 
             pChildContext->m_pTask = pChildTask;
+#endif
         }
 
         // Queue the job context for spawning.
@@ -342,10 +379,23 @@ namespace Helium
         HELIUM_ASSERT( m_pContinuationContext );
         new( m_pContinuationContext ) JobContext;
 
+#if HELIUM_PROFILE_JOBS
+        m_pContinuationContext->m_profileParentId = m_pContext->m_profileId;
+        m_pContinuationContext->m_bProfileContinuation = true;
+#endif
+
+#if HELIUM_NATIVE_JOB_SCHEDULER
+        // The continuation takes over notifying this job's parent, as this job will be finished as soon as it returns.
+        m_pContinuationContext->m_pParent = m_pContext->m_pParent;
+        m_pContinuationContext->m_pRootCounter = m_pContext->m_pRootCounter;
+        m_pContext->m_pParent = NULL;
+        m_pContext->m_pRootCounter = NULL;
+#else
         tbb::task* pContinuationTask = m_pContext->AllocateContinuationTask( m_pContinuationContext );
         HELIUM_ASSERT( pContinuationTask );
 
         m_pContinuationContext->m_pTask = pContinuationTask;
+#endif
 
         return m_pContinuationContext;
     }
@@ -353,7 +403,8 @@ namespace Helium
     /// Spawn all allocated jobs.
     ///
     /// When spawning root jobs, this will also block until those jobs and any child jobs spawned complete.  When
-    /// spawning child jobs, this will return immediately.
+    /// spawning child jobs, this will return immediately.  With the native job scheduler, the calling thread runs other
+    /// jobs while waiting on root jobs instead of sleeping.
     ///
     /// Note that this is automatically called upon destruction (such as when an instance goes out of scope).  It is
     /// only necessary to call this function directly if explicit control of when the jobs are spawned is necessary.
@@ -370,6 +421,54 @@ namespace Helium
             pSpawnParent = m_pContext;
         }
 
+#if HELIUM_NATIVE_JOB_SCHEDULER
+        JobScheduler& rScheduler = JobScheduler::GetStaticInstance();
+
+        size_t jobCount = m_childContextCount;
+
+        if( pSpawnParent )
+        {
+            // Nothing needs to be done if no jobs were allocated (such as when committing a spawner a second time).
+            if( jobCount != 0 || m_pContinuationContext )
+            {
+                // Update the spawn parent before spawning anything, as a continuation may run and be released as soon
+                // as its children are spawned.
+                pSpawnParent->m_bAllocatedChildren = true;
+                pSpawnParent->m_pActiveSpawner = NULL;
+
+                if( !m_pContinuationContext )
+                {
+                    // Keep this job open as an empty continuation until both it and its children have finished.
+                    pSpawnParent->m_pendingCount = static_cast< int32_t >( jobCount + 1 );
+                    rScheduler.Spawn( m_childContexts, jobCount );
+                }
+                else if( jobCount != 0 )
+                {
+                    pSpawnParent->m_pendingCount = static_cast< int32_t >( jobCount );
+                    rScheduler.Spawn( m_childContexts, jobCount );
+                }
+                else
+                {
+                    // Continuation jobs without any children are ready to run immediately.
+                    rScheduler.Spawn( &m_pContinuationContext, 1 );
+                }
+            }
+        }
+        else if( jobCount != 0 )
+        {
+            volatile int32_t rootCounter = static_cast< int32_t >( jobCount );
+            for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+            {
+                JobContext* pRootContext = m_childContexts[ jobIndex ];
+                HELIUM_ASSERT( pRootContext );
+
+                pRootContext->m_pRootCounter = &rootCounter;
+            }
+
+            rScheduler.Spawn( m_childContexts, jobCount );
+            rScheduler.WaitForRoots( rootCounter );
+        }
+#else
         tbb::task* pSpawnParentTask = NULL;
         if( pSpawnParent )
         {
@@ -427,6 +526,7 @@ namespace Helium
                 tbb::task::spawn_root_and_wait( *pRootTask );
             }
         }
+#endif
 
         m_pContinuationContext = NULL;
         m_childContextCount = 0;
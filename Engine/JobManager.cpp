@@ -3,6 +3,13 @@
 
 #include "Platform/Atomic.h"
 
+#if HELIUM_NATIVE_JOB_SCHEDULER
+#include "Engine/JobScheduler.h"
+#endif
+#if HELIUM_PROFILE_JOBS
+#include "Engine/JobProfiler.h"
+#endif
+
 using namespace Helium;
 
 JobManager* JobManager::sm_pInstance = NULL;
@@ -21,13 +28,27 @@ JobManager::~JobManager()
 
 /// Initialize this manager for use.
 ///
+/// @param[in] workerThreadCount  Number of job worker threads to start, or zero to use the default.  This is only used
+///                               by the native job scheduler; TBB manages its own worker threads.
+///
 /// @return  True if initialization was successful, false if not.
 ///
 /// @see Shutdown()
-bool JobManager::Initialize()
+bool JobManager::Initialize( size_t workerThreadCount )
 {
     Shutdown();
 
+#if HELIUM_NATIVE_JOB_SCHEDULER
+    if( !JobScheduler::GetStaticInstance().Initialize( workerThreadCount ) )
+    {
+        HELIUM_TRACE( TraceLevels::Error, TXT( "JobManager::Initialize(): Failed to initialize the job scheduler.\n" ) );
+
+        return false;
+    }
+#else
+    HELIUM_UNREF( workerThreadCount );
+#endif
+
     return true;
 }
 
@@ -36,6 +57,11 @@ bool JobManager::Initialize()
 /// @see Initialize()
 void JobManager::Shutdown()
 {
+#if HELIUM_NATIVE_JOB_SCHEDULER
+    // Stop the job worker threads before freeing the pools they allocate from.
+    JobScheduler::DestroyStaticInstance();
+#endif
+
     m_poolTls.SetPointer( NULL );
 
 #if HELIUM_TRACK_JOB_POOL_HITS
@@ -81,13 +107,53 @@ void JobManager::Shutdown()
 ///
 /// @see ReleaseJobUninitialized(), AllocateJob(), ReleaseJob()
 void* JobManager::AllocateJobUninitialized( size_t size )
+{
+    return AllocateJobFromSizeClass( JobPool::GetSizeClass( size ), size );
+}
+
+/// Release memory for a job of the given size.
+///
+/// This does not actually free the allocated job memory, but instead places it in a pool for later reuse.
+///
+/// Unlike ReleaseJob(), this does not call the destructor for the job.  It is the responsibility of the caller to
+/// make sure the job object's destructor is called prior to calling this function.
+///
+/// @param[in] pJob  Job allocation memory.
+/// @param[in] size  Job size.
+///
+/// @see AllocateJobUninitialized(), ReleaseJob(), AllocateJob()
+void JobManager::ReleaseJobUninitialized( void* pJob, size_t size )
+{
+    ReleaseJobToSizeClass( pJob, JobPool::GetSizeClass( size ) );
+}
+
+/// Allocate memory for a job in a given job pool size class.
+///
+/// @param[in] sizeClass  Job pool size class index.
+/// @param[in] size       Job size (only used if the size class is JobPool::SIZE_CLASS_LARGE).
+///
+/// @return  Pointer to an uninitialized allocation for the job.
+///
+/// @see ReleaseJobToSizeClass()
+void* JobManager::AllocateJobFromSizeClass( size_t sizeClass, size_t size )
 {
     // Get the current thread's job pool.
     PoolNode* pLocalNode = GetThreadLocalPoolNode();
     HELIUM_ASSERT( pLocalNode );
 
+    // Allocations too large to be pooled are always allocated directly.
+    if( sizeClass >= JobPool::SIZE_CLASS_COUNT )
+    {
+#if HELIUM_TRACK_JOB_POOL_HITS
+        ++pLocalNode->misses;
+#endif
+
+        return JobPool::NewJobUninitialized( size );
+    }
+
     // Attempt to acquire an allocation from the current thread's pool first.
-    void* pJob = pLocalNode->pool.AcquireUninitialized( size );
+    JobPool& rLocalPool = pLocalNode->pool;
+    void* pJob = rLocalPool.AcquireFromSizeClass( sizeClass );
     if( pJob )
     {
 #if HELIUM_TRACK_JOB_POOL_HITS
@@ -97,17 +163,19 @@ void* JobManager::AllocateJobUninitialized( size_t size )
         return pJob;
     }
 
-    // Attempt to steal an allocation from an existing pool, starting with the pool immediately following the
+    // Attempt to steal a batch of allocations from another pool, starting with the pool immediately following the
     // current thread's pool in the list and looping through all available pools.
     for( PoolNode* pNode = pLocalNode->pNext; pNode != NULL; pNode = pNode->pNext )
     {
-        pJob = pNode->pool.AcquireUninitialized( size );
-        if( pJob )
+        if( rLocalPool.StealFrom( pNode->pool, sizeClass ) != 0 )
         {
 #if HELIUM_TRACK_JOB_POOL_HITS
             ++pLocalNode->stolenHits;
 #endif
 
+            pJob = rLocalPool.AcquireFromSizeClass( sizeClass );
+            HELIUM_ASSERT( pJob );
+
             return pJob;
         }
     }
@@ -115,41 +183,37 @@ void* JobManager::AllocateJobUninitialized( size_t size )
     for( PoolNode* pNode = m_pHeadPool; pNode != pLocalNode; pNode = pNode->pNext )
     {
         HELIUM_ASSERT( pNode != NULL );
-        pJob = pNode->pool.AcquireUninitialized( size );
-        if( pJob )
+        if( rLocalPool.StealFrom( pNode->pool, sizeClass ) != 0 )
         {
 #if HELIUM_TRACK_JOB_POOL_HITS
             ++pLocalNode->stolenHits;
 #endif
 
+            pJob = rLocalPool.AcquireFromSizeClass( sizeClass );
+            HELIUM_ASSERT( pJob );
+
             return pJob;
         }
     }
 
     // No job allocation could be retrieved from any other thread's pools, so allocate a new job.
-    pJob = JobPool::NewJobUninitialized( size );
+    pJob = JobPool::NewJobUninitialized( JobPool::GetSizeClassSize( sizeClass ) );
     HELIUM_ASSERT( pJob );
 
 #if HELIUM_TRACK_JOB_POOL_HITS
     ++pLocalNode->misses;
 #endif
 
-
     return pJob;
 }
 
-/// Release memory for a job of the given size.
+/// Release memory for a job in a given job pool size class.
 ///
-/// This does not actually free the allocated job memory, but instead places it in a pool for later reuse.
+/// @param[in] pJob       Job allocation memory.
+/// @param[in] sizeClass  Job pool size class index.
 ///
-/// Unlike ReleaseJob(), this does not call the destructor for the job.  It is the responsibility of the caller to
-/// make sure the job object's destructor is called prior to calling this function.
-///
-/// @param[in] pJob  Job allocation memory.
-/// @param[in] size  Job size.
-///
-/// @see AllocateJobUninitialized(), ReleaseJob(), AllocateJob()
-void JobManager::ReleaseJobUninitialized( void* pJob, size_t size )
+/// @see AllocateJobFromSizeClass()
+void JobManager::ReleaseJobToSizeClass( void* pJob, size_t sizeClass )
 {
     HELIUM_ASSERT( pJob );
 
@@ -157,7 +221,7 @@ void JobManager::ReleaseJobUninitialized( void* pJob, size_t size )
     PoolNode* pLocalNode = GetThreadLocalPoolNode();
     HELIUM_ASSERT( pLocalNode );
 
-    pLocalNode->pool.ReleaseUninitialized( pJob, size );
+    pLocalNode->pool.ReleaseToSizeClass( pJob, sizeClass );
 }
 
 /// Get the static task manager instance, creating it if necessary.
@@ -183,6 +247,11 @@ void JobManager::DestroyStaticInstance()
 {
     delete sm_pInstance;
     sm_pInstance = NULL;
+
+#if HELIUM_PROFILE_JOBS
+    // All job threads have been stopped at this point, so the profiler capture buffers can be safely freed.
+    JobProfiler::Shutdown();
+#endif
 }
 
 /// Get the job pool node for the current thread, allocating it if necessary.
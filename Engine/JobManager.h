@@ -19,6 +19,11 @@
 #define HELIUM_TRACK_JOB_POOL_HITS ( HELIUM_DEBUG )
 #endif
 
+#ifndef HELIUM_NATIVE_JOB_SCHEDULER
+/// Set to non-zero to run jobs on the native work-stealing JobScheduler instead of the TBB task scheduler.
+#define HELIUM_NATIVE_JOB_SCHEDULER 0
+#endif
+
 namespace Helium
 {
     /// Job manager.
@@ -27,7 +32,7 @@ namespace Helium
     public:
         /// @name Initialization
         //@{
-        bool Initialize();
+        bool Initialize( size_t workerThreadCount = 0 );
         void Shutdown();
         //@}
 
@@ -80,6 +85,9 @@ namespace Helium
 
         /// @name Private Utility Functions
         //@{
+        void* AllocateJobFromSizeClass( size_t sizeClass, size_t size );
+        void ReleaseJobToSizeClass( void* pJob, size_t sizeClass );
+
         PoolNode* GetThreadLocalPoolNode();
         //@}
     };
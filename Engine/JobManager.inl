@@ -10,7 +10,7 @@ namespace Helium
     /// Allocate a job, acquiring a pooled allocation if possible.
     ///
     /// Unlike AllocateJobUninitialized(), this will handle initializing the acquired job instance using the placement
-    /// "new" operator before returning.
+    /// "new" operator before returning.  The job pool size class is resolved at compile time.
     ///
     /// @return  Pointer to an allocated job.
     ///
@@ -18,7 +18,7 @@ namespace Helium
     template< typename T >
     T* JobManager::AllocateJob()
     {
-        void* pJob = AllocateJobUninitialized( sizeof( T ) );
+        void* pJob = AllocateJobFromSizeClass( JobPool::SizeClass< sizeof( T ) >::INDEX, sizeof( T ) );
         if( pJob )
         {
             new( pJob ) T;
@@ -41,6 +41,6 @@ namespace Helium
         HELIUM_ASSERT( pJob );
 
         pJob->~T();
-        ReleaseJobUninitialized( pJob, sizeof( T ) );
+        ReleaseJobToSizeClass( pJob, JobPool::SizeClass< sizeof( T ) >::INDEX );
     }
 }
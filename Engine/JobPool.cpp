@@ -8,6 +8,8 @@ using namespace Helium;
 /// Constructor.
 JobPool::JobPool()
 {
+    MemoryZero( m_magazines, sizeof( m_magazines ) );
+    MemoryZero( const_cast< AllocationHeader** >( m_sharedHeads ), sizeof( m_sharedHeads ) );
 }
 
 /// Destructor.
@@ -16,10 +18,17 @@ JobPool::~JobPool()
     // Free all pooled job memory.
     DefaultAllocator allocator;
 
-    AllocationPoolMap::Accessor poolAccessor;
-    for( m_allocationPools.First( poolAccessor ); poolAccessor.IsValid(); ++poolAccessor )
+    for( size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass )
     {
-        AllocationHeader* pHeader = poolAccessor->Second();
+        AllocationHeader* pHeader = m_magazines[ sizeClass ].pHead;
+        while( pHeader )
+        {
+            AllocationHeader* pNext = pHeader->pNext;
+            allocator.Free( pHeader );
+            pHeader = pNext;
+        }
+
+        pHeader = m_sharedHeads[ sizeClass ];
         while( pHeader )
         {
             AllocationHeader* pNext = pHeader->pNext;
@@ -35,95 +44,145 @@ JobPool::~JobPool()
 /// returned pointer and initialize the allocation using the placement "new" operator for the job type before using
 /// the job object.
 ///
+/// This must only be called from the thread that owns this pool.
+///
 /// @param[in] size  Job allocation size.
 ///
 /// @return  Pointer to the allocation if one could be located, null if no allocations for the specified size could
 ///          be located.  Note that the allocation must be initialized using the placement "new" operator for the
 ///          job type before using it.
 ///
-/// @see ReleaseUninitialized(), Acquire(), Release()
+/// @see ReleaseUninitialized(), Acquire(), Release(), AcquireFromSizeClass()
 void* JobPool::AcquireUninitialized( size_t size )
 {
-    // Make sure the job size is at least large enough for the header data.
-    if( size < sizeof( AllocationHeader ) )
+    return AcquireFromSizeClass( GetSizeClass( size ) );
+}
+
+/// Release a job allocation to the pool of the appropriate size.
+///
+/// Unlike Release(), this does not call the destructor on the job object.  It is the caller's responsibility to
+/// call the job object's destructor prior to calling this function.
+///
+/// This must only be called from the thread that owns this pool.
+///
+/// @param[in] pJob  Job allocation to release.  Note that job instances should have their destructors explicitly
+///                  called before passing to this function.
+/// @param[in] size  Job allocation size.
+///
+/// @see AcquireUninitialized(), Release(), Acquire(), ReleaseToSizeClass()
+void JobPool::ReleaseUninitialized( void* pJob, size_t size )
+{
+    ReleaseToSizeClass( pJob, GetSizeClass( size ) );
+}
+
+/// Move up to half a magazine of allocations of the given size class from another pool's shared list into this
+/// pool's magazine.
+///
+/// The source pool's entire shared list is detached with a single atomic exchange, and any allocations beyond half a
+/// magazine are pushed back onto it.  This may be called with this pool as the source in order to reclaim allocations
+/// previously published by this pool.  This must only be called from the thread that owns this pool.
+///
+/// @param[in] rSource    Pool from which to steal allocations.
+/// @param[in] sizeClass  Size class index.
+///
+/// @return  Number of allocations moved into this pool's magazine.
+///
+/// @see AcquireFromSizeClass()
+uint32_t JobPool::StealFrom( JobPool& rSource, size_t sizeClass )
+{
+    HELIUM_ASSERT( sizeClass < SIZE_CLASS_COUNT );
+
+    // Check before exchanging so that scanning empty pools doesn't force any cache line ownership changes.
+    if( !rSource.m_sharedHeads[ sizeClass ] )
     {
-        size = sizeof( AllocationHeader );
+        return 0;
     }
 
-    // Locate an existing entry in the allocation pool lookup.
-    AllocationPoolMap::ConstAccessor poolAccessor;
-    if( !m_allocationPools.Find( poolAccessor, size ) )
+    AllocationHeader* pHead = AtomicExchangeAcquire(
+        rSource.m_sharedHeads[ sizeClass ],
+        static_cast< AllocationHeader* >( NULL ) );
+    if( !pHead )
     {
-        return NULL;
+        return 0;
     }
 
-    // Pop the allocation off the head of the pool.
-    AllocationHeader* pTestHeader;
-    AllocationHeader* pHeader = poolAccessor->Second();
-    do
+    uint32_t stealCount = 1;
+    AllocationHeader* pTail = pHead;
+    while( stealCount < MAGAZINE_CAPACITY / 2 && pTail->pNext )
     {
-        pTestHeader = pHeader;
-        if( !pTestHeader )
+        pTail = pTail->pNext;
+        ++stealCount;
+    }
+
+    // Return anything beyond half a magazine to the source pool.
+    AllocationHeader* pRemainderHead = pTail->pNext;
+    if( pRemainderHead )
+    {
+        AllocationHeader* pRemainderTail = pRemainderHead;
+        while( pRemainderTail->pNext )
         {
-            return NULL;
+            pRemainderTail = pRemainderTail->pNext;
         }
 
-        AllocationHeader* pNext = pTestHeader->pNext;
-        HELIUM_ASSERT( pNext != pTestHeader );
+        rSource.PushShared( sizeClass, pRemainderHead, pRemainderTail );
+    }
 
-        pHeader = AtomicCompareExchangeRelease(
-            const_cast< AllocationHeader*& >( poolAccessor->Second() ),
-            pNext,
-            pTestHeader );
-    } while( pHeader != pTestHeader );
+    Magazine& rMagazine = m_magazines[ sizeClass ];
+    pTail->pNext = rMagazine.pHead;
+    rMagazine.pHead = pHead;
+    rMagazine.count += stealCount;
 
-    return pHeader;
+    return stealCount;
 }
 
-/// Release a job allocation to the pool of the appropriate size.
-///
-/// Unlike Release(), this does not call the destructor on the job object.  It is the caller's responsibility to
-/// call the job object's destructor prior to calling this function.
-///
-/// @param[in] pJob  Job allocation to release.  Note that job instances should have their destructors explicitly
-///                  called before passing to this function.
-/// @param[in] size  Job allocation size.
+/// Publish half of the magazine for the given size class to this pool's shared list.
 ///
-/// @see AcquireUninitialized(), Release(), Acquire()
-void JobPool::ReleaseUninitialized( void* pJob, size_t size )
+/// @param[in] sizeClass  Size class index.
+void JobPool::PublishHalfMagazine( size_t sizeClass )
 {
-    HELIUM_ASSERT( pJob );
+    HELIUM_ASSERT( sizeClass < SIZE_CLASS_COUNT );
+
+    Magazine& rMagazine = m_magazines[ sizeClass ];
+    HELIUM_ASSERT( rMagazine.count >= MAGAZINE_CAPACITY / 2 );
+
+    AllocationHeader* pHead = rMagazine.pHead;
+    HELIUM_ASSERT( pHead );
 
-    // Make sure the job size is at least large enough for the header data.
-    if( size < sizeof( AllocationHeader ) )
+    AllocationHeader* pTail = pHead;
+    for( uint32_t allocationIndex = 1; allocationIndex < MAGAZINE_CAPACITY / 2; ++allocationIndex )
     {
-        size = sizeof( AllocationHeader );
+        pTail = pTail->pNext;
+        HELIUM_ASSERT( pTail );
     }
 
-    // Initialize the job allocation header.
-    AllocationHeader* pHeader = static_cast< AllocationHeader* >( pJob );
-    pHeader->pNext = NULL;
+    rMagazine.pHead = pTail->pNext;
+    rMagazine.count -= MAGAZINE_CAPACITY / 2;
+
+    PushShared( sizeClass, pHead, pTail );
+}
+
+/// Push a chain of allocations onto this pool's shared list for the given size class.
+///
+/// @param[in] sizeClass  Size class index.
+/// @param[in] pHead      First allocation in the chain.
+/// @param[in] pTail      Last allocation in the chain.
+void JobPool::PushShared( size_t sizeClass, AllocationHeader* pHead, AllocationHeader* pTail )
+{
+    HELIUM_ASSERT( sizeClass < SIZE_CLASS_COUNT );
+    HELIUM_ASSERT( pHead );
+    HELIUM_ASSERT( pTail );
 
-    // Update the appropriate allocation pool, initializing a new pool if a pool for the specified size does not yet
-    // exist.
-    KeyValue< size_t, AllocationHeader* > poolEntry( size, pHeader );
+    AllocationHeader* volatile& rSharedHead = m_sharedHeads[ sizeClass ];
 
-    AllocationPoolMap::ConstAccessor poolAccessor;
-    if( !m_allocationPools.Insert( poolAccessor, poolEntry ) )
+    AllocationHeader* pTestNext;
+    AllocationHeader* pNext = rSharedHead;
+    do
     {
-        AllocationHeader* pTestNext;
-        AllocationHeader* pNext = poolAccessor->Second();
-        do
-        {
-            pTestNext = pNext;
-            pHeader->pNext = pTestNext;
-
-            pNext = AtomicCompareExchangeRelease(
-                const_cast< AllocationHeader*& >( poolAccessor->Second() ),
-                pHeader,
-                pTestNext );
-        } while( pNext != pTestNext );
-    }
+        pTestNext = pNext;
+        pTail->pNext = pTestNext;
+
+        pNext = AtomicCompareExchangeRelease( rSharedHead, pHead, pTestNext );
+    } while( pNext != pTestNext );
 }
 
 /// Allocate uninitialized memory for a new job instance outside the pool that is compatible with pool usage.
@@ -148,11 +207,15 @@ void JobPool::ReleaseUninitialized( void* pJob, size_t size )
 /// @see NewJob(), Acquire(), Release(), AcquireUninitialized(), ReleaseUninitialized()
 void* JobPool::NewJobUninitialized( size_t size )
 {
-    if( size < sizeof( AllocationHeader ) )
+    // Round the allocation up to the full size of its size class so that it can be reused for any job in the class.
+    size_t sizeClass = GetSizeClass( size );
+    if( sizeClass < SIZE_CLASS_COUNT )
     {
-        size = sizeof( AllocationHeader );
+        size = GetSizeClassSize( sizeClass );
     }
 
+    HELIUM_ASSERT( size >= sizeof( AllocationHeader ) );
+
     void* pJob = DefaultAllocator().AllocateAligned( HELIUM_SIMD_ALIGNMENT, size );
 
     return pJob;
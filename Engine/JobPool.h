@@ -11,18 +11,40 @@
 
 #include "Engine/Engine.h"
 
-#include "Foundation/ConcurrentHashMap.h"
-
 namespace Helium
 {
     /// Pool of job objects.
     ///
-    /// While each thread will have its own job pool in order to minimize thread contention during job object allocation
-    /// and deallocation, pools are also internally thread-safe in order to allow threads to grab available jobs from
-    /// other pools.
+    /// Each thread has its own job pool.  Job allocations are grouped into fixed size classes, each of which has a
+    /// magazine of free allocations that is only ever accessed by the owning thread.  When a magazine overflows, half
+    /// of it is published to a shared list that other threads can steal from in bulk (see StealFrom()).
+    ///
+    /// The shared lists are lock-free and ABA-safe: allocations are only ever pushed onto them with a compare-exchange
+    /// (which is not subject to the ABA problem), and they are only ever emptied by atomically exchanging the list head
+    /// with null, so no thread ever performs a compare-exchange based on a "next" pointer that may have been recycled.
     class HELIUM_ENGINE_API JobPool : NonCopyable
     {
     public:
+        /// Size class granularity, in bytes.
+        static const size_t SIZE_CLASS_GRANULARITY = HELIUM_SIMD_ALIGNMENT;
+        /// Number of pooled size classes.  Allocations larger than the largest size class are not pooled.
+        static const size_t SIZE_CLASS_COUNT = 64;
+        /// Size class index used for allocations too large to be pooled.
+        static const size_t SIZE_CLASS_LARGE = SIZE_CLASS_COUNT;
+        /// Maximum number of allocations kept in each magazine before half of them are published for other threads.
+        static const uint32_t MAGAZINE_CAPACITY = 64;
+
+        /// Compile-time size class lookup.
+        template< size_t Size >
+        struct SizeClass
+        {
+            /// Size class index for the templated allocation size.
+            static const size_t INDEX =
+                ( Size <= SIZE_CLASS_GRANULARITY * SIZE_CLASS_COUNT
+                  ? ( Size + SIZE_CLASS_GRANULARITY - 1 ) / SIZE_CLASS_GRANULARITY - ( Size != 0 ? 1 : 0 )
+                  : SIZE_CLASS_LARGE );
+        };
+
         /// @name Construction/Destruction
         //@{
         JobPool();
@@ -36,27 +58,49 @@ namespace Helium
 
         void* AcquireUninitialized( size_t size );
         void ReleaseUninitialized( void* pJob, size_t size );
+
+        inline void* AcquireFromSizeClass( size_t sizeClass );
+        inline void ReleaseToSizeClass( void* pJob, size_t sizeClass );
+
+        uint32_t StealFrom( JobPool& rSource, size_t sizeClass );
         //@}
 
         /// @name Static Allocation Utility Functions
         //@{
         template< typename T > static T* NewJob();
         static void* NewJobUninitialized( size_t size );
+
+        inline static size_t GetSizeClass( size_t size );
+        inline static size_t GetSizeClassSize( size_t sizeClass );
         //@}
 
     private:
         /// Job allocation header.
         struct AllocationHeader
         {
-            /// Next allocation in the pool of the same size.
-            AllocationHeader* volatile pNext;
+            /// Next allocation in the same magazine or shared list.
+            AllocationHeader* pNext;
         };
 
-        /// Allocation pool hash map type (allocations keyed by job size).
-        typedef ConcurrentHashMap< size_t, AllocationHeader* > AllocationPoolMap;
+        /// Magazine of free allocations for a single size class (accessed only by the owning thread).
+        struct Magazine
+        {
+            /// First allocation in the magazine.
+            AllocationHeader* pHead;
+            /// Number of allocations in the magazine.
+            uint32_t count;
+        };
 
-        /// Allocation pool lookup.
-        AllocationPoolMap m_allocationPools;
+        /// Per-size class magazines.
+        Magazine m_magazines[ SIZE_CLASS_COUNT ];
+        /// Per-size class lists of allocations published for use by any thread.
+        AllocationHeader* volatile m_sharedHeads[ SIZE_CLASS_COUNT ];
+
+        /// @name Private Utility Functions
+        //@{
+        void PublishHalfMagazine( size_t sizeClass );
+        void PushShared( size_t sizeClass, AllocationHeader* pHead, AllocationHeader* pTail );
+        //@}
     };
 }
 
@@ -19,7 +19,7 @@ namespace Helium
     template< typename T >
     T* JobPool::Acquire()
     {
-        void* pJob = Acquire( sizeof( T ) );
+        void* pJob = AcquireFromSizeClass( SizeClass< sizeof( T ) >::INDEX );
         if( pJob )
         {
             new( pJob ) T;
@@ -43,7 +43,108 @@ namespace Helium
         HELIUM_ASSERT( pJob );
 
         pJob->~T();
-        ReleaseUninitialized( pJob, sizeof( T ) );
+        ReleaseToSizeClass( pJob, SizeClass< sizeof( T ) >::INDEX );
+    }
+
+    /// Acquire an unused job allocation from the given size class.
+    ///
+    /// If this pool's magazine for the size class is empty, any allocations previously published from this pool for
+    /// other threads are reclaimed first.  This must only be called from the thread that owns this pool.
+    ///
+    /// @param[in] sizeClass  Size class index (see GetSizeClass() and SizeClass).
+    ///
+    /// @return  Pointer to the uninitialized allocation if one could be located, null if none are available.
+    ///
+    /// @see ReleaseToSizeClass(), AcquireUninitialized(), StealFrom()
+    void* JobPool::AcquireFromSizeClass( size_t sizeClass )
+    {
+        if( sizeClass >= SIZE_CLASS_COUNT )
+        {
+            return NULL;
+        }
+
+        Magazine& rMagazine = m_magazines[ sizeClass ];
+        AllocationHeader* pHeader = rMagazine.pHead;
+        if( !pHeader )
+        {
+            if( StealFrom( *this, sizeClass ) == 0 )
+            {
+                return NULL;
+            }
+
+            pHeader = rMagazine.pHead;
+            HELIUM_ASSERT( pHeader );
+        }
+
+        rMagazine.pHead = pHeader->pNext;
+        --rMagazine.count;
+
+        return pHeader;
+    }
+
+    /// Release a job allocation to the magazine for the given size class.
+    ///
+    /// Allocations too large to be pooled are freed immediately.  This must only be called from the thread that owns
+    /// this pool.
+    ///
+    /// @param[in] pJob       Job allocation to release.  Job instances should have their destructors explicitly called
+    ///                       before passing them to this function.
+    /// @param[in] sizeClass  Size class index (see GetSizeClass() and SizeClass).
+    ///
+    /// @see AcquireFromSizeClass(), ReleaseUninitialized()
+    void JobPool::ReleaseToSizeClass( void* pJob, size_t sizeClass )
+    {
+        HELIUM_ASSERT( pJob );
+
+        if( sizeClass >= SIZE_CLASS_COUNT )
+        {
+            DefaultAllocator().Free( pJob );
+
+            return;
+        }
+
+        Magazine& rMagazine = m_magazines[ sizeClass ];
+
+        AllocationHeader* pHeader = static_cast< AllocationHeader* >( pJob );
+        pHeader->pNext = rMagazine.pHead;
+        rMagazine.pHead = pHeader;
+
+        ++rMagazine.count;
+        if( rMagazine.count > MAGAZINE_CAPACITY )
+        {
+            PublishHalfMagazine( sizeClass );
+        }
+    }
+
+    /// Get the size class index for a given job allocation size.
+    ///
+    /// @param[in] size  Job allocation size.
+    ///
+    /// @return  Size class index, or SIZE_CLASS_LARGE if the allocation is too large to be pooled.
+    ///
+    /// @see GetSizeClassSize(), SizeClass
+    size_t JobPool::GetSizeClass( size_t size )
+    {
+        if( size > SIZE_CLASS_GRANULARITY * SIZE_CLASS_COUNT )
+        {
+            return SIZE_CLASS_LARGE;
+        }
+
+        return ( size + SIZE_CLASS_GRANULARITY - 1 ) / SIZE_CLASS_GRANULARITY - ( size != 0 ? 1 : 0 );
+    }
+
+    /// Get the allocation size for all jobs in a given size class.
+    ///
+    /// @param[in] sizeClass  Size class index.
+    ///
+    /// @return  Allocation size, in bytes.
+    ///
+    /// @see GetSizeClass()
+    size_t JobPool::GetSizeClassSize( size_t sizeClass )
+    {
+        HELIUM_ASSERT( sizeClass < SIZE_CLASS_COUNT );
+
+        return ( sizeClass + 1 ) * SIZE_CLASS_GRANULARITY;
     }
 
     /// Allocate a new job instance outside the pool that is compatible with pool usage.
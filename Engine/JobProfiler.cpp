@@ -0,0 +1,481 @@
+//----------------------------------------------------------------------------------------------------------------------
+// JobProfiler.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "EnginePch.h"
+#include "Engine/JobProfiler.h"
+
+#if HELIUM_PROFILE_JOBS
+
+#include "Platform/Atomic.h"
+#include "Platform/Timer.h"
+#include "Foundation/DynamicArray.h"
+#include "Foundation/FileStream.h"
+#include "Engine/JobContext.h"
+
+using namespace Helium;
+
+volatile bool JobProfiler::sm_bEnabled = false;
+volatile int32_t JobProfiler::sm_frameIndex = 0;
+JobProfiler* JobProfiler::sm_pInstance = NULL;
+
+/// Event copied out of a thread buffer for export.
+struct CapturedEvent
+{
+    /// Job type name (null for frame boundaries and untyped jobs).
+    const char* pName;
+    /// Start time, in ticks.
+    uint64_t startTickCount;
+    /// End time, in ticks.
+    uint64_t endTickCount;
+    /// Job ID (or frame index for frame boundaries).
+    uint32_t id;
+    /// ID of the job that spawned this job (zero for root jobs).
+    uint32_t parentId;
+    /// Event type.
+    uint32_t type;
+    /// Index of the thread on which the event was recorded.
+    uint32_t threadIndex;
+};
+
+/// Append a string to a JSON output buffer.
+///
+/// @param[in] rBuffer  Output buffer.
+/// @param[in] pString  Null-terminated string to append.
+static void AppendJson( DynamicArray< char >& rBuffer, const char* pString )
+{
+    HELIUM_ASSERT( pString );
+
+    size_t length = StringLength( pString );
+    size_t offset = rBuffer.GetSize();
+    rBuffer.Resize( offset + length );
+    MemoryCopy( rBuffer.GetData() + offset, pString, length );
+}
+
+/// Constructor.
+JobProfiler::JobProfiler()
+: m_pHeadBuffer( NULL )
+, m_threadCount( 0 )
+{
+}
+
+/// Destructor.
+JobProfiler::~JobProfiler()
+{
+    m_bufferTls.SetPointer( NULL );
+
+    ThreadBuffer* pBuffer = m_pHeadBuffer;
+    while( pBuffer )
+    {
+        ThreadBuffer* pNext = pBuffer->pNext;
+        delete pBuffer;
+        pBuffer = pNext;
+    }
+}
+
+/// Start recording job executions.
+///
+/// @see Disable(), IsEnabled()
+void JobProfiler::Enable()
+{
+    if( !sm_pInstance )
+    {
+        sm_pInstance = new JobProfiler;
+        HELIUM_ASSERT( sm_pInstance );
+    }
+
+    sm_bEnabled = true;
+}
+
+/// Stop recording job executions.
+///
+/// Events recorded so far remain available for export.
+///
+/// @see Enable(), IsEnabled()
+void JobProfiler::Disable()
+{
+    sm_bEnabled = false;
+}
+
+/// Mark the start of a new frame.
+///
+/// @see GetFrameIndex()
+void JobProfiler::MarkFrame()
+{
+    uint32_t frameIndex = static_cast< uint32_t >( AtomicIncrementRelease( sm_frameIndex ) );
+    if( !sm_bEnabled )
+    {
+        return;
+    }
+
+    HELIUM_ASSERT( sm_pInstance );
+    ThreadBuffer* pBuffer = sm_pInstance->GetThreadLocalBuffer();
+    HELIUM_ASSERT( pBuffer );
+
+    uint64_t tickCount = Timer::GetTickCount();
+
+    Event& rEvent = BeginEvent( pBuffer );
+    rEvent.pName = NULL;
+    rEvent.startTickCount = tickCount;
+    rEvent.endTickCount = tickCount;
+    rEvent.id = frameIndex;
+    rEvent.parentId = 0;
+    rEvent.type = EVENT_TYPE_FRAME;
+    EndEvent( pBuffer );
+}
+
+/// Stop recording and free all capture buffers.
+///
+/// This must only be called when no jobs are running.
+///
+/// @see Enable()
+void JobProfiler::Shutdown()
+{
+    sm_bEnabled = false;
+
+    delete sm_pInstance;
+    sm_pInstance = NULL;
+}
+
+/// Write all buffered events to a file in the Chrome trace event format.
+///
+/// Jobs are written as complete events on the thread that ran them, with flow events linking each job to the job that
+/// spawned it.  Frame boundaries are written as global instant events.  Capture can remain enabled while writing,
+/// although events recorded during the write may be omitted.
+///
+/// @param[in] rFileName  Name of the file to write.
+///
+/// @return  True if the capture was written successfully, false if not.
+bool JobProfiler::WriteChromeTrace( const String& rFileName )
+{
+    if( !sm_pInstance )
+    {
+        HELIUM_TRACE( TraceLevels::Warning, TXT( "JobProfiler::WriteChromeTrace(): No job capture has been recorded.\n" ) );
+
+        return false;
+    }
+
+    // Copy the events out of each thread's buffer.  Events whose slots may have been reused by their thread while being
+    // copied (including the slot of any event being recorded right now) are discarded.
+    DynamicArray< CapturedEvent > events;
+    uint32_t threadCount = 0;
+    for( ThreadBuffer* pBuffer = sm_pInstance->m_pHeadBuffer; pBuffer != NULL; pBuffer = pBuffer->pNext )
+    {
+        ++threadCount;
+
+        uint32_t endIndex = pBuffer->eventCount;
+        uint32_t startIndex = ( endIndex > EVENT_BUFFER_CAPACITY ? endIndex - EVENT_BUFFER_CAPACITY : 0 );
+
+        size_t firstEventIndex = events.GetSize();
+        for( uint32_t eventIndex = startIndex; eventIndex != endIndex; ++eventIndex )
+        {
+            const Event& rEvent = pBuffer->events[ eventIndex & ( EVENT_BUFFER_CAPACITY - 1 ) ];
+
+            CapturedEvent capturedEvent;
+            capturedEvent.pName = rEvent.pName;
+            capturedEvent.startTickCount = rEvent.startTickCount;
+            capturedEvent.endTickCount = rEvent.endTickCount;
+            capturedEvent.id = rEvent.id;
+            capturedEvent.parentId = rEvent.parentId;
+            capturedEvent.type = rEvent.type;
+            capturedEvent.threadIndex = pBuffer->threadIndex;
+            events.Push( capturedEvent );
+        }
+
+        uint32_t newEndIndex = pBuffer->eventCount;
+        if( newEndIndex - startIndex >= EVENT_BUFFER_CAPACITY )
+        {
+            size_t overwrittenCount = newEndIndex - startIndex - EVENT_BUFFER_CAPACITY + 1;
+            size_t copiedCount = events.GetSize() - firstEventIndex;
+            if( overwrittenCount > copiedCount )
+            {
+                overwrittenCount = copiedCount;
+            }
+
+            events.Remove( firstEventIndex, overwrittenCount );
+        }
+    }
+
+    size_t eventCount = events.GetSize();
+
+    // Build a table mapping job IDs to events so that flow events can be placed on the spawning job's thread.
+    size_t tableSize = 1;
+    while( tableSize < eventCount * 2 )
+    {
+        tableSize <<= 1;
+    }
+
+    size_t tableMask = tableSize - 1;
+    DynamicArray< uint32_t > jobTable;
+    jobTable.Resize( tableSize );
+    for( size_t tableIndex = 0; tableIndex < tableSize; ++tableIndex )
+    {
+        jobTable[ tableIndex ] = Invalid< uint32_t >();
+    }
+
+    uint64_t baseTickCount = Invalid< uint64_t >();
+    for( size_t eventIndex = 0; eventIndex < eventCount; ++eventIndex )
+    {
+        const CapturedEvent& rEvent = events[ eventIndex ];
+        if( rEvent.startTickCount < baseTickCount )
+        {
+            baseTickCount = rEvent.startTickCount;
+        }
+
+        if( rEvent.type == EVENT_TYPE_FRAME )
+        {
+            continue;
+        }
+
+        size_t tableIndex = rEvent.id & tableMask;
+        while( IsValid( jobTable[ tableIndex ] ) )
+        {
+            tableIndex = ( tableIndex + 1 ) & tableMask;
+        }
+
+        jobTable[ tableIndex ] = static_cast< uint32_t >( eventIndex );
+    }
+
+    // Write the events.
+    float64_t microsecondsPerTick = Timer::GetSecondsPerTick() * 1000000.0;
+
+    DynamicArray< char > output;
+    output.Reserve( 128 + eventCount * 192 );
+    AppendJson( output, "{\"traceEvents\":[\n" );
+
+    char line[ 512 ];
+    bool bFirstEvent = true;
+    for( uint32_t threadIndex = 1; threadIndex <= threadCount; ++threadIndex )
+    {
+        StringPrint(
+            line,
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Job thread %u\"}}",
+            ( bFirstEvent ? "" : ",\n" ),
+            threadIndex,
+            threadIndex );
+        AppendJson( output, line );
+        bFirstEvent = false;
+    }
+
+    for( size_t eventIndex = 0; eventIndex < eventCount; ++eventIndex )
+    {
+        const CapturedEvent& rEvent = events[ eventIndex ];
+
+        float64_t startTime =
+            static_cast< float64_t >( rEvent.startTickCount - baseTickCount ) * microsecondsPerTick;
+
+        if( rEvent.type == EVENT_TYPE_FRAME )
+        {
+            StringPrint(
+                line,
+                "%s{\"name\":\"Frame %u\",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                ( bFirstEvent ? "" : ",\n" ),
+                rEvent.id,
+                startTime,
+                rEvent.threadIndex );
+            AppendJson( output, line );
+            bFirstEvent = false;
+
+            continue;
+        }
+
+        float64_t duration =
+            static_cast< float64_t >( rEvent.endTickCount - rEvent.startTickCount ) * microsecondsPerTick;
+        const char* pLinkName = ( rEvent.type == EVENT_TYPE_CONTINUATION ? "continuation" : "spawn" );
+
+        StringPrint(
+            line,
+            ( "%s{\"name\":\"%s\",\"cat\":\"job\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+              "\"args\":{\"id\":%u,\"parent\":%u,\"link\":\"%s\"}}" ),
+            ( bFirstEvent ? "" : ",\n" ),
+            ( rEvent.pName ? rEvent.pName : "Job" ),
+            startTime,
+            duration,
+            rEvent.threadIndex,
+            rEvent.id,
+            rEvent.parentId,
+            ( rEvent.parentId != 0 ? pLinkName : "root" ) );
+        AppendJson( output, line );
+        bFirstEvent = false;
+
+        if( rEvent.parentId == 0 )
+        {
+            continue;
+        }
+
+        // Link the job to its parent if the parent is still in the capture.
+        size_t tableIndex = rEvent.parentId & tableMask;
+        for( ; ; )
+        {
+            uint32_t parentEventIndex = jobTable[ tableIndex ];
+            if( IsInvalid( parentEventIndex ) )
+            {
+                break;
+            }
+
+            const CapturedEvent& rParentEvent = events[ parentEventIndex ];
+            if( rParentEvent.id == rEvent.parentId )
+            {
+                float64_t parentStartTime =
+                    static_cast< float64_t >( rParentEvent.startTickCount - baseTickCount ) * microsecondsPerTick;
+
+                StringPrint(
+                    line,
+                    ( ",\n{\"name\":\"%s\",\"cat\":\"job\",\"ph\":\"s\",\"id\":%u,\"ts\":%.3f,\"pid\":1,\"tid\":%u}"
+                      ",\n{\"name\":\"%s\",\"cat\":\"job\",\"ph\":\"f\",\"bp\":\"e\",\"id\":%u,\"ts\":%.3f,\"pid\":1,"
+                      "\"tid\":%u}" ),
+                    pLinkName,
+                    rEvent.id,
+                    parentStartTime,
+                    rParentEvent.threadIndex,
+                    pLinkName,
+                    rEvent.id,
+                    startTime,
+                    rEvent.threadIndex );
+                AppendJson( output, line );
+
+                break;
+            }
+
+            tableIndex = ( tableIndex + 1 ) & tableMask;
+        }
+    }
+
+    AppendJson( output, "\n]}\n" );
+
+    FileStream* pStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_WRITE, true );
+    if( !pStream )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "JobProfiler::WriteChromeTrace(): Failed to open \"%s\" for writing.\n" ),
+            *rFileName );
+
+        return false;
+    }
+
+    size_t writeSize = pStream->Write( output.GetData(), 1, output.GetSize() );
+    delete pStream;
+
+    if( writeSize != output.GetSize() )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "JobProfiler::WriteChromeTrace(): Failed to write the job capture to \"%s\".\n" ),
+            *rFileName );
+
+        return false;
+    }
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "JobProfiler: Wrote %" ) TPRIuSZ TXT( " events to \"%s\".\n" ),
+        eventCount,
+        *rFileName );
+
+    return true;
+}
+
+/// Run a job and record its execution.
+///
+/// This is called by the job scheduler in place of the job's execution callback while capture is enabled.
+///
+/// @param[in] pContext  Context of the job to run.
+void JobProfiler::RunJob( JobContext* pContext )
+{
+    HELIUM_ASSERT( pContext );
+    HELIUM_ASSERT( sm_pInstance );
+
+    const JobContext::AttachData& rAttachData = pContext->GetAttachData();
+    void* pData = rAttachData.GetData();
+    HELIUM_ASSERT( pData );
+    JobContext::JOB_EXECUTE_CALLBACK* pExecuteCallback = rAttachData.GetExecuteCallback();
+    HELIUM_ASSERT( pExecuteCallback );
+
+    ThreadBuffer* pBuffer = sm_pInstance->GetThreadLocalBuffer();
+    HELIUM_ASSERT( pBuffer );
+
+    // Assign the job ID before running the job so that any jobs it spawns can be linked back to it.
+    uint32_t jobId =
+        ( pBuffer->threadIndex << JOB_COUNTER_BITS ) | ( ++pBuffer->jobCounter & ( ( 1 << JOB_COUNTER_BITS ) - 1 ) );
+    pContext->m_profileId = jobId;
+
+    const char* pName = rAttachData.GetTypeName();
+    uint32_t parentId = pContext->m_profileParentId;
+    uint32_t type = ( pContext->m_bProfileContinuation ? EVENT_TYPE_CONTINUATION : EVENT_TYPE_JOB );
+
+    uint64_t startTickCount = Timer::GetTickCount();
+    pExecuteCallback( pData, pContext );
+    uint64_t endTickCount = Timer::GetTickCount();
+
+    Event& rEvent = BeginEvent( pBuffer );
+    rEvent.pName = pName;
+    rEvent.startTickCount = startTickCount;
+    rEvent.endTickCount = endTickCount;
+    rEvent.id = jobId;
+    rEvent.parentId = parentId;
+    rEvent.type = type;
+    EndEvent( pBuffer );
+}
+
+/// Get the event buffer for the current thread, allocating it if necessary.
+///
+/// @return  Pointer to the current thread's event buffer.
+JobProfiler::ThreadBuffer* JobProfiler::GetThreadLocalBuffer()
+{
+    ThreadBuffer* pBuffer = static_cast< ThreadBuffer* >( m_bufferTls.GetPointer() );
+    if( !pBuffer )
+    {
+        // Buffer does not yet exist, so allocate one and add it to the global list of buffers.
+        pBuffer = new ThreadBuffer;
+        HELIUM_ASSERT( pBuffer );
+        m_bufferTls.SetPointer( pBuffer );
+
+        pBuffer->eventCount = 0;
+        pBuffer->jobCounter = 0;
+        pBuffer->threadIndex = static_cast< uint32_t >( AtomicIncrementRelease( m_threadCount ) );
+
+        ThreadBuffer* pTestNext;
+        ThreadBuffer* pNext = m_pHeadBuffer;
+        do
+        {
+            pTestNext = pNext;
+            pBuffer->pNext = pTestNext;
+
+            pNext = AtomicCompareExchangeRelease( m_pHeadBuffer, pBuffer, pTestNext );
+        } while( pNext != pTestNext );
+    }
+
+    return pBuffer;
+}
+
+/// Get the slot in which to record the next event for a thread.
+///
+/// @param[in] pBuffer  Buffer for the current thread.
+///
+/// @return  Event to fill in.
+///
+/// @see EndEvent()
+JobProfiler::Event& JobProfiler::BeginEvent( ThreadBuffer* pBuffer )
+{
+    HELIUM_ASSERT( pBuffer );
+
+    return pBuffer->events[ pBuffer->eventCount & ( EVENT_BUFFER_CAPACITY - 1 ) ];
+}
+
+/// Publish the event most recently filled in for a thread.
+///
+/// @param[in] pBuffer  Buffer for the current thread.
+///
+/// @see BeginEvent()
+void JobProfiler::EndEvent( ThreadBuffer* pBuffer )
+{
+    HELIUM_ASSERT( pBuffer );
+
+    pBuffer->eventCount = pBuffer->eventCount + 1;
+}
+
+#endif  // HELIUM_PROFILE_JOBS
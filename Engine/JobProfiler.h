@@ -0,0 +1,155 @@
+//----------------------------------------------------------------------------------------------------------------------
+// JobProfiler.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_ENGINE_JOB_PROFILER_H
+#define HELIUM_ENGINE_JOB_PROFILER_H
+
+#include "Engine/Engine.h"
+
+#ifndef HELIUM_PROFILE_JOBS
+/// Set to non-zero to compile in support for capturing job execution timings through JobProfiler.
+#define HELIUM_PROFILE_JOBS ( !HELIUM_RELEASE )
+#endif
+
+#if HELIUM_PROFILE_JOBS
+
+#include "Platform/Thread.h"
+
+#include "Foundation/String.h"
+
+namespace Helium
+{
+    class JobContext;
+
+    /// Job execution profiler.
+    ///
+    /// While enabled, every job run records its type name, the thread on which it ran, its start and end times, and
+    /// the job that spawned it into a ring buffer owned by the running thread.  Recording never takes a lock, and when
+    /// capture is disabled the only cost to running a job is a single check of IsEnabled().
+    ///
+    /// Each thread keeps only its most recent EVENT_BUFFER_CAPACITY events.  MarkFrame() should be called once at the
+    /// start of each frame so that exported captures can be split up by frame.  WriteChromeTrace() saves the buffered
+    /// events in the Chrome trace event format, which can be viewed using chrome://tracing.
+    ///
+    /// Shutdown() frees all capture buffers, and must only be called when no jobs are running.
+    class HELIUM_ENGINE_API JobProfiler : NonCopyable
+    {
+    public:
+        /// Number of events buffered for each thread (must be a power of two).
+        static const size_t EVENT_BUFFER_CAPACITY = 8192;
+
+        /// Event types.
+        enum EEventType
+        {
+            EVENT_TYPE_FIRST   =  0,
+            EVENT_TYPE_INVALID = -1,
+
+            /// Child or root job execution.
+            EVENT_TYPE_JOB,
+            /// Continuation job execution.
+            EVENT_TYPE_CONTINUATION,
+            /// Frame boundary.
+            EVENT_TYPE_FRAME,
+
+            EVENT_TYPE_MAX,
+            EVENT_TYPE_LAST = EVENT_TYPE_MAX - 1
+        };
+
+        /// @name Capture Control
+        //@{
+        static void Enable();
+        static void Disable();
+        inline static bool IsEnabled();
+
+        static void MarkFrame();
+        inline static uint32_t GetFrameIndex();
+
+        static void Shutdown();
+        //@}
+
+        /// @name Capture Export
+        //@{
+        static bool WriteChromeTrace( const String& rFileName );
+        //@}
+
+        /// @name Job Execution
+        //@{
+        static void RunJob( JobContext* pContext );
+        //@}
+
+    private:
+        /// Captured event.
+        struct Event
+        {
+            /// Job type name (null for frame boundaries and untyped jobs).
+            const char* pName;
+            /// Start time, in ticks.
+            uint64_t startTickCount;
+            /// End time, in ticks.
+            uint64_t endTickCount;
+            /// Job ID (or frame index for frame boundaries).
+            uint32_t id;
+            /// ID of the job that spawned this job (zero for root jobs).
+            uint32_t parentId;
+            /// Event type.
+            uint32_t type;
+        };
+
+        /// Per-thread event ring buffer.
+        struct ThreadBuffer
+        {
+            /// Event ring buffer.
+            Event events[ EVENT_BUFFER_CAPACITY ];
+            /// Total number of events recorded (the next event is written at this index modulo the capacity).
+            volatile uint32_t eventCount;
+            /// Counter used to assign job IDs.
+            uint32_t jobCounter;
+            /// Thread index (one-based).
+            uint32_t threadIndex;
+            /// Next buffer in the list.
+            ThreadBuffer* volatile pNext;
+        };
+
+        /// Number of low-order job ID bits assigned from the per-thread job counter.
+        static const uint32_t JOB_COUNTER_BITS = 24;
+
+        /// List of all thread buffers.
+        ThreadBuffer* volatile m_pHeadBuffer;
+        /// Thread-local storage for thread buffers.
+        ThreadLocalPointer m_bufferTls;
+        /// Number of thread buffers created (used to assign thread indices).
+        volatile int32_t m_threadCount;
+
+        /// True if capture is enabled.
+        static volatile bool sm_bEnabled;
+        /// Index of the current frame.
+        static volatile int32_t sm_frameIndex;
+
+        /// Profiler instance (created the first time capture is enabled).
+        static JobProfiler* sm_pInstance;
+
+        /// @name Construction/Destruction
+        //@{
+        JobProfiler();
+        ~JobProfiler();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        ThreadBuffer* GetThreadLocalBuffer();
+        static Event& BeginEvent( ThreadBuffer* pBuffer );
+        static void EndEvent( ThreadBuffer* pBuffer );
+        //@}
+    };
+}
+
+#include "Engine/JobProfiler.inl"
+
+#endif  // HELIUM_PROFILE_JOBS
+
+#endif  // HELIUM_ENGINE_JOB_PROFILER_H
@@ -0,0 +1,29 @@
+//----------------------------------------------------------------------------------------------------------------------
+// JobProfiler.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get whether job capture is enabled.
+    ///
+    /// @return  True if job executions are being recorded, false if not.
+    ///
+    /// @see Enable(), Disable()
+    bool JobProfiler::IsEnabled()
+    {
+        return sm_bEnabled;
+    }
+
+    /// Get the index of the current frame.
+    ///
+    /// @return  Index of the frame most recently started with MarkFrame().
+    ///
+    /// @see MarkFrame()
+    uint32_t JobProfiler::GetFrameIndex()
+    {
+        return static_cast< uint32_t >( sm_frameIndex );
+    }
+}
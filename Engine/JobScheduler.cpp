@@ -0,0 +1,756 @@
+//----------------------------------------------------------------------------------------------------------------------
+// JobScheduler.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "EnginePch.h"
+#include "Engine/JobScheduler.h"
+
+#if HELIUM_NATIVE_JOB_SCHEDULER
+
+#include "Platform/Atomic.h"
+#include "Engine/JobContext.h"
+
+using namespace Helium;
+
+JobScheduler* JobScheduler::sm_pInstance = NULL;
+volatile int32_t JobScheduler::sm_generation = 1;
+
+/// Offset a deque index, wrapping around on overflow.
+///
+/// @param[in] index   Deque index.
+/// @param[in] offset  Offset to apply.
+///
+/// @return  Offset index.
+static int32_t OffsetDequeIndex( int32_t index, int32_t offset )
+{
+    return static_cast< int32_t >( static_cast< uint32_t >( index ) + static_cast< uint32_t >( offset ) );
+}
+
+/// Compute the signed distance between two deque indices, accounting for wrap-around.
+///
+/// @param[in] from  Starting index.
+/// @param[in] to    Ending index.
+///
+/// @return  Number of entries from the starting index to the ending index.
+static int32_t GetDequeDistance( int32_t from, int32_t to )
+{
+    return static_cast< int32_t >( static_cast< uint32_t >( to ) - static_cast< uint32_t >( from ) );
+}
+
+/// Constructor.
+JobScheduler::JobScheduler()
+: m_pHeadWorker( NULL )
+, m_workerCount( 0 )
+, m_wakeUpCondition( false, false )
+, m_sleepingCount( 0 )
+, m_stopCounter( 0 )
+{
+}
+
+/// Destructor.
+JobScheduler::~JobScheduler()
+{
+    Shutdown();
+}
+
+/// Initialize this scheduler and start its worker threads.
+///
+/// @param[in] workerThreadCount  Number of worker threads to start, or zero to use DEFAULT_WORKER_COUNT.
+///
+/// @return  True if initialization was successful, false if not.
+///
+/// @see Shutdown()
+bool JobScheduler::Initialize( size_t workerThreadCount )
+{
+    Shutdown();
+
+    if( workerThreadCount == 0 )
+    {
+        workerThreadCount = DEFAULT_WORKER_COUNT;
+    }
+
+    // Worker threads take the lowest worker indices so that affinity hints can name them reliably.  Threads that are
+    // registered later on demand are numbered after them.
+    m_workerCount = static_cast< int32_t >( workerThreadCount );
+
+    m_workerThreads.Reserve( workerThreadCount );
+    m_threads.Reserve( workerThreadCount );
+    for( size_t workerIndex = 0; workerIndex < workerThreadCount; ++workerIndex )
+    {
+        WorkerThread* pWorkerThread = new WorkerThread( this, static_cast< uint32_t >( workerIndex ) );
+        HELIUM_ASSERT( pWorkerThread );
+        m_workerThreads.Push( pWorkerThread );
+
+        RunnableThread* pThread = new RunnableThread( pWorkerThread, TXT( "Job worker" ) );
+        HELIUM_ASSERT( pThread );
+        m_threads.Push( pThread );
+        HELIUM_VERIFY( pThread->Start() );
+    }
+
+    return true;
+}
+
+/// Stop all worker threads and free any allocated resources.
+///
+/// All root jobs must have completed prior to calling this function.
+///
+/// @see Initialize()
+void JobScheduler::Shutdown()
+{
+    if( !m_threads.IsEmpty() )
+    {
+        // Each worker passes the wake-up signal along when it exits, so a single signal is enough to stop them all.
+        AtomicExchangeRelease( m_stopCounter, 1 );
+        m_wakeUpCondition.Signal();
+    }
+
+    size_t threadCount = m_threads.GetSize();
+    for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+    {
+        RunnableThread* pThread = m_threads[ threadIndex ];
+        HELIUM_ASSERT( pThread );
+        pThread->Join();
+        delete pThread;
+    }
+
+    m_threads.Clear();
+
+    size_t workerThreadCount = m_workerThreads.GetSize();
+    for( size_t workerIndex = 0; workerIndex < workerThreadCount; ++workerIndex )
+    {
+        delete m_workerThreads[ workerIndex ];
+    }
+
+    m_workerThreads.Clear();
+
+    // Other threads that committed root jobs still hold pointers to their workers in thread-local storage, so bump
+    // the generation to make those pointers stale before the workers are freed.
+    m_workerTls.SetPointer( NULL );
+    AtomicIncrement( sm_generation );
+
+    Worker* pWorker = m_pHeadWorker;
+    while( pWorker )
+    {
+        HELIUM_ASSERT( !pWorker->pMailbox );
+
+        Worker* pNext = pWorker->pNext;
+        delete pWorker;
+        pWorker = pNext;
+    }
+
+    m_pHeadWorker = NULL;
+    m_workerCount = 0;
+    m_sleepingCount = 0;
+    m_stopCounter = 0;
+}
+
+/// Schedule a set of ready jobs for execution.
+///
+/// Jobs are pushed onto the current thread's deque, or posted to the mailbox of the worker named by their affinity
+/// hint if one has been set.  If the current thread's deque is full, jobs are run immediately instead.
+///
+/// @param[in] ppContexts    Contexts of the jobs to schedule.
+/// @param[in] contextCount  Number of jobs to schedule.
+///
+/// @see WaitForRoots()
+void JobScheduler::Spawn( JobContext* const* ppContexts, size_t contextCount )
+{
+    HELIUM_ASSERT( ppContexts || contextCount == 0 );
+
+    if( contextCount == 0 )
+    {
+        return;
+    }
+
+    Worker* pLocalWorker = GetThreadLocalWorker();
+    HELIUM_ASSERT( pLocalWorker );
+
+    for( size_t contextIndex = 0; contextIndex < contextCount; ++contextIndex )
+    {
+        JobContext* pContext = ppContexts[ contextIndex ];
+        HELIUM_ASSERT( pContext );
+
+        uint32_t affinity = pContext->m_affinity;
+        if( affinity != INVALID_WORKER_INDEX && affinity != pLocalWorker->index )
+        {
+            Worker* pTargetWorker = FindWorker( affinity );
+            if( pTargetWorker )
+            {
+                PostMail( pTargetWorker, pContext );
+
+                continue;
+            }
+        }
+
+        if( !pLocalWorker->deque.Push( pContext ) )
+        {
+            RunInline( pContext );
+        }
+    }
+
+    WakeWorkers();
+}
+
+/// Run jobs on the current thread until a set of root jobs and all of their children have completed.
+///
+/// @param[in] rRootCounter  Counter decremented as each root job completes.
+///
+/// @see Spawn()
+void JobScheduler::WaitForRoots( volatile int32_t& rRootCounter )
+{
+    Worker* pLocalWorker = GetThreadLocalWorker();
+    HELIUM_ASSERT( pLocalWorker );
+
+    while( rRootCounter != 0 )
+    {
+        JobContext* pContext = FindJob( pLocalWorker );
+        if( pContext )
+        {
+            RunInline( pContext );
+        }
+        else
+        {
+            Thread::Yield();
+        }
+    }
+}
+
+/// Get the index of the worker associated with the current thread.
+///
+/// @return  Current worker index, or INVALID_WORKER_INDEX if the current thread has not run any jobs.
+uint32_t JobScheduler::GetCurrentWorkerIndex()
+{
+    Worker* pWorker = GetRegisteredWorker();
+
+    return ( pWorker ? pWorker->index : INVALID_WORKER_INDEX );
+}
+
+/// Get the singleton JobScheduler instance, creating it if necessary.
+///
+/// @return  Reference to the JobScheduler instance.
+///
+/// @see DestroyStaticInstance()
+JobScheduler& JobScheduler::GetStaticInstance()
+{
+    if( !sm_pInstance )
+    {
+        sm_pInstance = new JobScheduler;
+        HELIUM_ASSERT( sm_pInstance );
+    }
+
+    return *sm_pInstance;
+}
+
+/// Destroy the singleton JobScheduler instance.
+///
+/// @see GetStaticInstance()
+void JobScheduler::DestroyStaticInstance()
+{
+    delete sm_pInstance;
+    sm_pInstance = NULL;
+}
+
+/// Execute a job.
+///
+/// If the job spawned children without an explicit continuation, its context remains open as an empty continuation
+/// until the children have completed.
+///
+/// @param[in] pContext  Context of the job to execute.
+///
+/// @return  Continuation that became ready to run as a result of this job completing, or null if no continuation is
+///          ready.
+///
+/// @see Finish(), RunInline()
+JobContext* JobScheduler::Execute( JobContext* pContext )
+{
+    HELIUM_ASSERT( pContext );
+
+    const JobContext::AttachData& rAttachData = pContext->GetAttachData();
+    void* pData = rAttachData.GetData();
+    if( pData )
+    {
+        JobContext::JOB_EXECUTE_CALLBACK* pExecuteCallback = rAttachData.GetExecuteCallback();
+        HELIUM_ASSERT( pExecuteCallback );
+
+#if HELIUM_PROFILE_JOBS
+        if( JobProfiler::IsEnabled() )
+        {
+            JobProfiler::RunJob( pContext );
+        }
+        else
+#endif
+        {
+            pExecuteCallback( pData, pContext );
+        }
+    }
+
+    // Clear the job data before releasing this job's own hold on the context so that the context is treated as an
+    // empty continuation if its children complete first.
+    pContext->m_attachData.Clear();
+    if( AtomicDecrement( pContext->m_pendingCount ) != 0 )
+    {
+        return NULL;
+    }
+
+    return Finish( pContext );
+}
+
+/// Release a completed job context and notify its parent.
+///
+/// Empty continuations whose children have all completed are finished immediately, walking up the job tree until a
+/// parent with outstanding children, an explicit continuation, or a root job is reached.
+///
+/// @param[in] pContext  Context of the completed job.
+///
+/// @return  Explicit continuation that became ready to run, or null if no continuation is ready.
+///
+/// @see Execute()
+JobContext* JobScheduler::Finish( JobContext* pContext )
+{
+    HELIUM_ASSERT( pContext );
+
+    JobManager& rJobManager = JobManager::GetStaticInstance();
+
+    for( ; ; )
+    {
+        JobContext* pParent = pContext->m_pParent;
+        volatile int32_t* pRootCounter = pContext->m_pRootCounter;
+        rJobManager.ReleaseJob( pContext );
+
+        if( !pParent )
+        {
+            if( pRootCounter )
+            {
+                AtomicDecrementRelease( *pRootCounter );
+            }
+
+            return NULL;
+        }
+
+        if( AtomicDecrement( pParent->m_pendingCount ) != 0 )
+        {
+            return NULL;
+        }
+
+        // Hand explicit continuations back to the caller to run next on this thread.
+        if( pParent->GetAttachData().GetData() )
+        {
+            pParent->m_pendingCount = 1;
+
+            return pParent;
+        }
+
+        pContext = pParent;
+    }
+}
+
+/// Execute a job on the current thread, along with any continuations made ready by its completion.
+///
+/// @param[in] pContext  Context of the job to execute.
+///
+/// @see Execute()
+void JobScheduler::RunInline( JobContext* pContext )
+{
+    while( pContext )
+    {
+        pContext = Execute( pContext );
+    }
+}
+
+/// Find the next job to run on the current thread.
+///
+/// Jobs are taken from the local deque first, followed by the local mailbox.  If both are empty, jobs are stolen from
+/// other workers' deques, and only then taken from other workers' mailboxes.
+///
+/// @param[in] pLocalWorker  Worker associated with the current thread.
+///
+/// @return  Context of the job to run, or null if no job was found.
+JobContext* JobScheduler::FindJob( Worker* pLocalWorker )
+{
+    HELIUM_ASSERT( pLocalWorker );
+
+    JobContext* pContext = pLocalWorker->deque.Pop();
+    if( pContext )
+    {
+        return pContext;
+    }
+
+    pContext = TakeMail( pLocalWorker, pLocalWorker );
+    if( pContext )
+    {
+        return pContext;
+    }
+
+    // Steal from other workers, starting with the worker immediately following this one in the list and looping
+    // through all available workers.
+    for( Worker* pWorker = pLocalWorker->pNext; pWorker != NULL; pWorker = pWorker->pNext )
+    {
+        pContext = pWorker->deque.Steal();
+        if( pContext )
+        {
+            // Pass the work along to any sleeping workers in case there is more to steal.
+            WakeWorkers();
+
+            return pContext;
+        }
+    }
+
+    for( Worker* pWorker = m_pHeadWorker; pWorker != pLocalWorker; pWorker = pWorker->pNext )
+    {
+        HELIUM_ASSERT( pWorker != NULL );
+        pContext = pWorker->deque.Steal();
+        if( pContext )
+        {
+            WakeWorkers();
+
+            return pContext;
+        }
+    }
+
+    // Nothing left to steal, so ignore affinity hints and take jobs posted to other workers.
+    for( Worker* pWorker = m_pHeadWorker; pWorker != NULL; pWorker = pWorker->pNext )
+    {
+        if( pWorker != pLocalWorker )
+        {
+            pContext = TakeMail( pWorker, pLocalWorker );
+            if( pContext )
+            {
+                return pContext;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/// Take all jobs posted to a worker's mailbox.
+///
+/// The first job is returned, while the rest are pushed onto the local worker's deque.
+///
+/// @param[in] pMailWorker   Worker whose mailbox should be emptied.
+/// @param[in] pLocalWorker  Worker associated with the current thread.
+///
+/// @return  Context of the job to run, or null if the mailbox was empty.
+JobContext* JobScheduler::TakeMail( Worker* pMailWorker, Worker* pLocalWorker )
+{
+    HELIUM_ASSERT( pMailWorker );
+    HELIUM_ASSERT( pLocalWorker );
+
+    if( !pMailWorker->pMailbox )
+    {
+        return NULL;
+    }
+
+    // Detach the entire mailbox at once so that popping entries cannot suffer from ABA issues.
+    JobContext* pContext = AtomicExchangeAcquire( pMailWorker->pMailbox, static_cast< JobContext* >( NULL ) );
+    if( !pContext )
+    {
+        return NULL;
+    }
+
+    JobContext* pNext = pContext->m_pNextMail;
+    pContext->m_pNextMail = NULL;
+    if( pNext )
+    {
+        do
+        {
+            JobContext* pMail = pNext;
+            pNext = pMail->m_pNextMail;
+            pMail->m_pNextMail = NULL;
+
+            if( !pLocalWorker->deque.Push( pMail ) )
+            {
+                PostMail( pLocalWorker, pMail );
+            }
+        } while( pNext );
+
+        WakeWorkers();
+    }
+
+    return pContext;
+}
+
+/// Post a job to a worker's mailbox.
+///
+/// @param[in] pWorker   Worker to which the job should be posted.
+/// @param[in] pContext  Context of the job to post.
+void JobScheduler::PostMail( Worker* pWorker, JobContext* pContext )
+{
+    HELIUM_ASSERT( pWorker );
+    HELIUM_ASSERT( pContext );
+
+    JobContext* pTestNext;
+    JobContext* pNext = pWorker->pMailbox;
+    do
+    {
+        pTestNext = pNext;
+        pContext->m_pNextMail = pTestNext;
+
+        pNext = AtomicCompareExchangeRelease( pWorker->pMailbox, pContext, pTestNext );
+    } while( pNext != pTestNext );
+}
+
+/// Wake up a sleeping worker thread if any worker threads are sleeping.
+void JobScheduler::WakeWorkers()
+{
+    // Read the sleeping count using an interlocked operation so that the check cannot be ordered before the stores
+    // publishing the jobs that were just made available.
+    if( AtomicCompareExchange( m_sleepingCount, 0, 0 ) != 0 )
+    {
+        m_wakeUpCondition.Signal();
+    }
+}
+
+/// Get the worker for the current thread, registering a new worker if necessary.
+///
+/// @return  Pointer to the current thread's worker.
+JobScheduler::Worker* JobScheduler::GetThreadLocalWorker()
+{
+    Worker* pWorker = GetRegisteredWorker();
+    if( !pWorker )
+    {
+        uint32_t index = static_cast< uint32_t >( AtomicIncrement( m_workerCount ) - 1 );
+        pWorker = RegisterWorker( index );
+        HELIUM_ASSERT( pWorker );
+    }
+
+    return pWorker;
+}
+
+/// Get the worker registered for the current thread.
+///
+/// Worker pointers left in thread-local storage by a previous initialization of this scheduler are ignored, as the
+/// workers they reference have already been freed.
+///
+/// @return  Pointer to the current thread's worker, or null if the current thread has not been registered since the
+///          last shutdown.
+JobScheduler::Worker* JobScheduler::GetRegisteredWorker() const
+{
+    uintptr_t generation = reinterpret_cast< uintptr_t >( m_generationTls.GetPointer() );
+    if( generation != static_cast< uintptr_t >( static_cast< uint32_t >( sm_generation ) ) )
+    {
+        return NULL;
+    }
+
+    return static_cast< Worker* >( m_workerTls.GetPointer() );
+}
+
+/// Register a worker for the current thread.
+///
+/// @param[in] index  Worker index.
+///
+/// @return  Newly registered worker.
+JobScheduler::Worker* JobScheduler::RegisterWorker( uint32_t index )
+{
+    HELIUM_ASSERT( !GetRegisteredWorker() );
+
+    Worker* pWorker = new Worker;
+    HELIUM_ASSERT( pWorker );
+    pWorker->pMailbox = NULL;
+    pWorker->index = index;
+    m_workerTls.SetPointer( pWorker );
+    m_generationTls.SetPointer(
+        reinterpret_cast< void* >( static_cast< uintptr_t >( static_cast< uint32_t >( sm_generation ) ) ) );
+
+    Worker* pTestNext;
+    Worker* pNext = m_pHeadWorker;
+    do
+    {
+        pTestNext = pNext;
+        pWorker->pNext = pTestNext;
+
+        pNext = AtomicCompareExchangeRelease( m_pHeadWorker, pWorker, pTestNext );
+    } while( pNext != pTestNext );
+
+    return pWorker;
+}
+
+/// Find the worker with a given index.
+///
+/// @param[in] index  Worker index.
+///
+/// @return  Worker with the given index, or null if no such worker has been registered.
+JobScheduler::Worker* JobScheduler::FindWorker( uint32_t index ) const
+{
+    for( Worker* pWorker = m_pHeadWorker; pWorker != NULL; pWorker = pWorker->pNext )
+    {
+        if( pWorker->index == index )
+        {
+            return pWorker;
+        }
+    }
+
+    return NULL;
+}
+
+/// Constructor.
+JobScheduler::Deque::Deque()
+: m_top( 0 )
+, m_bottom( 0 )
+{
+    for( size_t entryIndex = 0; entryIndex < DEQUE_CAPACITY; ++entryIndex )
+    {
+        m_entries[ entryIndex ] = NULL;
+    }
+}
+
+/// Push a job onto the bottom of this deque.
+///
+/// This can only be called by the thread that owns this deque.
+///
+/// @param[in] pContext  Context of the job to push.
+///
+/// @return  True if the job was pushed, false if the deque is full.
+///
+/// @see Pop(), Steal()
+bool JobScheduler::Deque::Push( JobContext* pContext )
+{
+    HELIUM_ASSERT( pContext );
+
+    int32_t bottom = m_bottom;
+    int32_t top = m_top;
+    if( GetDequeDistance( top, bottom ) >= static_cast< int32_t >( DEQUE_CAPACITY ) )
+    {
+        return false;
+    }
+
+    // Volatile stores are not reordered with respect to each other, so the entry is visible before the new bottom.
+    m_entries[ static_cast< uint32_t >( bottom ) & ( DEQUE_CAPACITY - 1 ) ] = pContext;
+    m_bottom = OffsetDequeIndex( bottom, 1 );
+
+    return true;
+}
+
+/// Pop the most recently pushed job from the bottom of this deque.
+///
+/// This can only be called by the thread that owns this deque.
+///
+/// @return  Context of the popped job, or null if the deque is empty (or the last job was stolen).
+///
+/// @see Push(), Steal()
+JobContext* JobScheduler::Deque::Pop()
+{
+    // Reserve the bottom entry before reading the top index.  The interlocked exchange acts as a full barrier, which
+    // is needed to resolve races with thieves over the last entry.
+    int32_t bottom = OffsetDequeIndex( m_bottom, -1 );
+    AtomicExchange( m_bottom, bottom );
+
+    int32_t top = m_top;
+    int32_t size = GetDequeDistance( top, bottom );
+    if( size < 0 )
+    {
+        // Deque was empty.
+        m_bottom = top;
+
+        return NULL;
+    }
+
+    JobContext* pContext = m_entries[ static_cast< uint32_t >( bottom ) & ( DEQUE_CAPACITY - 1 ) ];
+    if( size > 0 )
+    {
+        return pContext;
+    }
+
+    // This was the last entry, so race any thieves for it.
+    if( AtomicCompareExchange( m_top, OffsetDequeIndex( top, 1 ), top ) != top )
+    {
+        pContext = NULL;
+    }
+
+    m_bottom = OffsetDequeIndex( top, 1 );
+
+    return pContext;
+}
+
+/// Steal the oldest job from the top of this deque.
+///
+/// This can be called from any thread.
+///
+/// @return  Context of the stolen job, or null if the deque is empty or another thread won the race for the job.
+///
+/// @see Push(), Pop()
+JobContext* JobScheduler::Deque::Steal()
+{
+    int32_t top = m_top;
+    int32_t bottom = m_bottom;
+    if( GetDequeDistance( top, bottom ) <= 0 )
+    {
+        return NULL;
+    }
+
+    JobContext* pContext = m_entries[ static_cast< uint32_t >( top ) & ( DEQUE_CAPACITY - 1 ) ];
+    if( AtomicCompareExchange( m_top, OffsetDequeIndex( top, 1 ), top ) != top )
+    {
+        return NULL;
+    }
+
+    return pContext;
+}
+
+/// Constructor.
+///
+/// @param[in] pScheduler  Owning scheduler.
+/// @param[in] index       Worker index.
+JobScheduler::WorkerThread::WorkerThread( JobScheduler* pScheduler, uint32_t index )
+: m_pScheduler( pScheduler )
+, m_index( index )
+{
+    HELIUM_ASSERT( pScheduler );
+}
+
+/// Run jobs until the scheduler is shut down.
+void JobScheduler::WorkerThread::Run()
+{
+    JobScheduler* pScheduler = m_pScheduler;
+    HELIUM_ASSERT( pScheduler );
+
+    Worker* pWorker = pScheduler->RegisterWorker( m_index );
+    HELIUM_ASSERT( pWorker );
+
+    uint32_t idleCount = 0;
+    while( pScheduler->m_stopCounter == 0 )
+    {
+        JobContext* pContext = pScheduler->FindJob( pWorker );
+        if( pContext )
+        {
+            idleCount = 0;
+            pScheduler->RunInline( pContext );
+
+            continue;
+        }
+
+        if( ++idleCount < IDLE_SPIN_COUNT )
+        {
+            Thread::Yield();
+
+            continue;
+        }
+
+        idleCount = 0;
+
+        // Announce that we are about to sleep before checking for work one last time, so that any thread that makes
+        // jobs available after the check will wake us back up.
+        AtomicIncrement( pScheduler->m_sleepingCount );
+
+        pContext = pScheduler->FindJob( pWorker );
+        if( !pContext && pScheduler->m_stopCounter == 0 )
+        {
+            pScheduler->m_wakeUpCondition.Wait();
+        }
+
+        AtomicDecrement( pScheduler->m_sleepingCount );
+
+        if( pContext )
+        {
+            pScheduler->RunInline( pContext );
+        }
+    }
+
+    // Pass the stop signal along to the next sleeping worker.
+    pScheduler->m_wakeUpCondition.Signal();
+}
+
+#endif  // HELIUM_NATIVE_JOB_SCHEDULER
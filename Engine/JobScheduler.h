@@ -0,0 +1,204 @@
+//----------------------------------------------------------------------------------------------------------------------
+// JobScheduler.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_ENGINE_JOB_SCHEDULER_H
+#define HELIUM_ENGINE_JOB_SCHEDULER_H
+
+#include "Engine/JobManager.h"
+
+#if HELIUM_NATIVE_JOB_SCHEDULER
+
+#include "Platform/Condition.h"
+#include "Platform/Thread.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+    class JobContext;
+
+    /// Native work-stealing job scheduler.
+    ///
+    /// Each thread that runs jobs owns a Chase-Lev deque of ready job contexts.  Jobs spawned on a thread are pushed
+    /// onto the bottom of that thread's deque and popped back off in LIFO order, while idle threads steal the oldest
+    /// jobs from the top of other threads' deques.  Jobs never block waiting on their children: a job's parent (or its
+    /// explicit continuation) tracks the number of outstanding children, and the thread that completes the last child
+    /// runs the continuation directly.
+    ///
+    /// Jobs may carry an affinity hint naming a preferred worker.  Hinted jobs are posted to that worker's mailbox,
+    /// which the worker checks before stealing; other workers only take mailed jobs once there is nothing left to
+    /// steal.
+    ///
+    /// Worker threads are created by Initialize().  Any other thread that commits root jobs is registered with the
+    /// scheduler on demand and helps run jobs until its root jobs have completed.  Shutdown() frees every worker and
+    /// invalidates all registrations, so such threads are registered again the next time they commit jobs.
+    class HELIUM_ENGINE_API JobScheduler : NonCopyable
+    {
+    public:
+        /// Default number of worker threads.
+        static const size_t DEFAULT_WORKER_COUNT = 3;
+        /// Maximum number of ready jobs held in a single thread's deque (must be a power of two).
+        static const size_t DEQUE_CAPACITY = 1024;
+        /// Number of times an idle worker will look for work before going to sleep.
+        static const uint32_t IDLE_SPIN_COUNT = 64;
+        /// Invalid worker index (used for jobs with no affinity hint).
+        static const uint32_t INVALID_WORKER_INDEX = static_cast< uint32_t >( -1 );
+
+        /// @name Initialization
+        //@{
+        bool Initialize( size_t workerThreadCount = 0 );
+        void Shutdown();
+        //@}
+
+        /// @name Job Scheduling
+        //@{
+        void Spawn( JobContext* const* ppContexts, size_t contextCount );
+        void WaitForRoots( volatile int32_t& rRootCounter );
+        //@}
+
+        /// @name Worker Information
+        //@{
+        inline size_t GetWorkerThreadCount() const;
+        uint32_t GetCurrentWorkerIndex();
+        //@}
+
+        /// @name Static Access
+        //@{
+        static JobScheduler& GetStaticInstance();
+        static void DestroyStaticInstance();
+        //@}
+
+    private:
+        /// Chase-Lev work-stealing deque of ready job contexts.
+        ///
+        /// Only the owning thread may call Push() and Pop(); any thread may call Steal().
+        class Deque : NonCopyable
+        {
+        public:
+            /// @name Construction/Destruction
+            //@{
+            Deque();
+            //@}
+
+            /// @name Owner Access
+            //@{
+            bool Push( JobContext* pContext );
+            JobContext* Pop();
+            //@}
+
+            /// @name Thief Access
+            //@{
+            JobContext* Steal();
+            //@}
+
+        private:
+            /// Index of the next entry to steal.
+            volatile int32_t m_top;
+            /// Index one past the most recently pushed entry.
+            volatile int32_t m_bottom;
+            /// Circular entry buffer.
+            JobContext* volatile m_entries[ DEQUE_CAPACITY ];
+        };
+
+        /// Per-thread scheduling state.
+        struct Worker
+        {
+            /// Ready job deque.
+            Deque deque;
+            /// Jobs posted to this worker through affinity hints.
+            JobContext* volatile pMailbox;
+            /// Next worker in the list.
+            Worker* volatile pNext;
+            /// Worker index.
+            uint32_t index;
+        };
+
+        /// Worker thread runnable.
+        class WorkerThread : public Runnable
+        {
+        public:
+            /// @name Construction/Destruction
+            //@{
+            WorkerThread( JobScheduler* pScheduler, uint32_t index );
+            //@}
+
+            /// @name Runnable Interface
+            //@{
+            virtual void Run();
+            //@}
+
+        private:
+            /// Owning scheduler.
+            JobScheduler* m_pScheduler;
+            /// Worker index.
+            uint32_t m_index;
+        };
+
+        /// List of all registered workers.
+        Worker* volatile m_pHeadWorker;
+        /// Thread-local storage for worker data.
+        ThreadLocalPointer m_workerTls;
+        /// Thread-local storage for the registration generation of the worker data stored in m_workerTls.
+        ThreadLocalPointer m_generationTls;
+        /// Number of registered workers (used to assign worker indices).
+        volatile int32_t m_workerCount;
+
+        /// Condition used to wake up sleeping worker threads when jobs are spawned (or when they should shut down).
+        Condition m_wakeUpCondition;
+        /// Number of worker threads sleeping or about to sleep.
+        volatile int32_t m_sleepingCount;
+        /// Non-zero if worker threads should stop when next possible, zero if they should continue.
+        volatile int32_t m_stopCounter;
+
+        /// Worker threads.
+        DynamicArray< RunnableThread* > m_threads;
+        /// Worker thread runnables.
+        DynamicArray< WorkerThread* > m_workerThreads;
+
+        /// Singleton instance.
+        static JobScheduler* sm_pInstance;
+        /// Current registration generation (incremented on shutdown to invalidate all thread-local worker pointers, and
+        /// shared between instances so that a new scheduler never accepts pointers left behind by a destroyed one).
+        static volatile int32_t sm_generation;
+
+        /// @name Construction/Destruction
+        //@{
+        JobScheduler();
+        ~JobScheduler();
+        //@}
+
+        /// @name Job Execution
+        //@{
+        JobContext* Execute( JobContext* pContext );
+        JobContext* Finish( JobContext* pContext );
+        void RunInline( JobContext* pContext );
+        //@}
+
+        /// @name Job Distribution
+        //@{
+        JobContext* FindJob( Worker* pLocalWorker );
+        JobContext* TakeMail( Worker* pMailWorker, Worker* pLocalWorker );
+        void PostMail( Worker* pWorker, JobContext* pContext );
+        void WakeWorkers();
+        //@}
+
+        /// @name Worker Registration
+        //@{
+        Worker* GetThreadLocalWorker();
+        Worker* GetRegisteredWorker() const;
+        Worker* RegisterWorker( uint32_t index );
+        Worker* FindWorker( uint32_t index ) const;
+        //@}
+    };
+}
+
+#include "Engine/JobScheduler.inl"
+
+#endif  // HELIUM_NATIVE_JOB_SCHEDULER
+
+#endif  // HELIUM_ENGINE_JOB_SCHEDULER_H
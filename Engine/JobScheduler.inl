@@ -0,0 +1,20 @@
+//----------------------------------------------------------------------------------------------------------------------
+// JobScheduler.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get the number of dedicated worker threads started by Initialize().
+    ///
+    /// Note that threads which wait on root jobs also run jobs while waiting, so the total number of threads running
+    /// jobs at any given time may be higher.
+    ///
+    /// @return  Worker thread count.
+    size_t JobScheduler::GetWorkerThreadCount() const
+    {
+        return m_threads.GetSize();
+    }
+}
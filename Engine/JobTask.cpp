@@ -8,6 +8,8 @@
 #include "EnginePch.h"
 #include "Engine/JobTask.h"
 
+#if !HELIUM_NATIVE_JOB_SCHEDULER
+
 #include "Engine/JobContext.h"
 
 using namespace Helium;
@@ -37,7 +39,16 @@ tbb::task* JobTask::execute()
             JobContext::JOB_EXECUTE_CALLBACK* pExecuteCallback = rAttachData.GetExecuteCallback();
             HELIUM_ASSERT( pExecuteCallback );
 
-            pExecuteCallback( pData, m_pContext );
+#if HELIUM_PROFILE_JOBS
+            if( JobProfiler::IsEnabled() )
+            {
+                JobProfiler::RunJob( m_pContext );
+            }
+            else
+#endif
+            {
+                pExecuteCallback( pData, m_pContext );
+            }
         }
 
         // Delete the job context object, as it is no longer needed.
@@ -48,3 +59,5 @@ tbb::task* JobTask::execute()
 
     return NULL;
 }
+
+#endif  // !HELIUM_NATIVE_JOB_SCHEDULER
@@ -10,6 +10,10 @@
 #define HELIUM_ENGINE_JOB_TASK_H
 
 #include "Engine/Engine.h"
+#include "Engine/JobManager.h"
+
+#if !HELIUM_NATIVE_JOB_SCHEDULER
+
 #include "tbb/task.h"
 
 namespace Helium
@@ -36,4 +40,6 @@ namespace Helium
     };
 }
 
+#endif  // !HELIUM_NATIVE_JOB_SCHEDULER
+
 #endif  // HELIUM_ENGINE_JOB_TASK_H
@@ -3,6 +3,7 @@
 
 #include "Reflect/Class.h"
 #include "Engine/GameObjectType.h"
+#include "Engine/PackageArena.h"
 
 using namespace Helium;
 
@@ -11,6 +12,7 @@ HELIUM_IMPLEMENT_OBJECT_NOINITTYPE( Package, Engine );
 /// Constructor.
 Package::Package()
     : m_pLoader( NULL )
+    , m_pArena( NULL )
 {
     // Set the package flag by default.
     SetFlags( FLAG_PACKAGE );
@@ -19,6 +21,11 @@ Package::Package()
 /// Destructor.
 Package::~Package()
 {
+    // Objects allocated from the arena keep it alive until they are destroyed as well.
+    if( m_pArena )
+    {
+        m_pArena->Release();
+    }
 }
 
 /// Initialize the static type information for the "Package" class.
@@ -46,3 +53,19 @@ void Package::SetLoader( PackageLoader* pLoader )
 {
     m_pLoader = pLoader;
 }
+
+/// Enable allocation of objects created in this package from a package-owned arena.
+///
+/// Once enabled, all non-package objects subsequently created with this package as their nearest package owner are
+/// allocated from the arena.  Objects that already exist are not affected.  This should only be called from the main
+/// thread, before any objects are loaded into the package.
+///
+/// @see GetArena()
+void Package::EnableArena()
+{
+    if( !m_pArena )
+    {
+        m_pArena = new PackageArena;
+        HELIUM_ASSERT( m_pArena );
+    }
+}
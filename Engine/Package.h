@@ -4,6 +4,7 @@
 
 namespace Helium
 {
+	class PackageArena;
 	class PackageLoader;
 	class Package;
 	typedef Helium::StrongPtr< Package > PackagePtr;
@@ -27,6 +28,12 @@ namespace Helium
 		void SetLoader( PackageLoader* pLoader );
 		//@}
 
+		/// @name Object Memory
+		//@{
+		void EnableArena();
+		inline PackageArena* GetArena() const;
+		//@}
+
 		/// @name Package Serialization
 		//@{
 		void SavePackage();
@@ -35,6 +42,8 @@ namespace Helium
 	private:
 		/// Package loader.
 		PackageLoader* m_pLoader;
+		/// Arena from which objects in this package are allocated (null if objects are allocated from the heap).
+		PackageArena* m_pArena;
 	};
 }
 
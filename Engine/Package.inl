@@ -16,4 +16,14 @@ namespace Helium
     {
         return m_pLoader;
     }
+
+    /// Get the arena from which objects in this package are allocated.
+    ///
+    /// @return  Package object arena, or null if the arena is not enabled for this package.
+    ///
+    /// @see EnableArena()
+    PackageArena* Package::GetArena() const
+    {
+        return m_pArena;
+    }
 }
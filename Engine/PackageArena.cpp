@@ -0,0 +1,234 @@
+//----------------------------------------------------------------------------------------------------------------------
+// PackageArena.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "EnginePch.h"
+#include "Engine/PackageArena.h"
+
+using namespace Helium;
+
+/// Alignment of each slab and each object allocated from an arena.  Each block also reserves this many bytes in front
+/// of the object for storing a pointer to the free list to which the block belongs.
+static const size_t BLOCK_ALIGNMENT = HELIUM_SIMD_ALIGNMENT;
+
+/// Constructor.
+///
+/// The arena is created with a single reference, which is owned by the caller.
+PackageArena::PackageArena()
+    : m_pFirstSlab( NULL )
+    , m_pSlabCurrent( NULL )
+    , m_pSlabEnd( NULL )
+    , m_pFirstBlockList( NULL )
+    , m_referenceCount( 1 )
+{
+    MemoryZero( &m_statistics, sizeof( m_statistics ) );
+}
+
+/// Destructor.
+PackageArena::~PackageArena()
+{
+    HELIUM_ASSERT( m_statistics.objectCount == 0 );
+
+    DefaultAllocator allocator;
+
+    TypeBlockList* pBlockList = m_pFirstBlockList;
+    while( pBlockList )
+    {
+        TypeBlockList* pNextBlockList = pBlockList->pNext;
+        allocator.Free( pBlockList );
+        pBlockList = pNextBlockList;
+    }
+
+    Slab* pSlab = m_pFirstSlab;
+    while( pSlab )
+    {
+        Slab* pNextSlab = pSlab->pNext;
+        allocator.Free( pSlab );
+        pSlab = pNextSlab;
+    }
+}
+
+/// Release a reference to this arena, destroying it and freeing all of its slabs if this was the last reference.
+///
+/// @see AddRef()
+void PackageArena::Release()
+{
+    int32_t newReferenceCount = AtomicDecrementRelease( m_referenceCount );
+    HELIUM_ASSERT( newReferenceCount >= 0 );
+    if( newReferenceCount == 0 )
+    {
+        delete this;
+    }
+}
+
+/// Allocate memory for an object.
+///
+/// The returned memory is aligned to HELIUM_SIMD_ALIGNMENT bytes.  Each allocation adds a reference to this arena that
+/// is released when the memory is freed.
+///
+/// @param[in] pType  Type of the object being allocated.
+/// @param[in] size   Size of the object, in bytes.
+///
+/// @return  Pointer to the allocated memory.
+///
+/// @see Free()
+void* PackageArena::Allocate( const GameObjectType* pType, size_t size )
+{
+    HELIUM_ASSERT( pType );
+    HELIUM_ASSERT( size != 0 );
+
+    size_t blockSize = BLOCK_ALIGNMENT + ( ( size + BLOCK_ALIGNMENT - 1 ) & ~( BLOCK_ALIGNMENT - 1 ) );
+
+    void* pMemory;
+    {
+        MutexScopeLock scopeLock( m_lock );
+
+        TypeBlockList* pBlockList = GetBlockList( pType, blockSize );
+        HELIUM_ASSERT( pBlockList );
+
+        pMemory = pBlockList->pFreeHead;
+        if( pMemory )
+        {
+            pBlockList->pFreeHead = *static_cast< void** >( pMemory );
+            --pBlockList->freeCount;
+
+            --m_statistics.freeBlockCount;
+            m_statistics.freeBlockMemory -= blockSize;
+        }
+        else
+        {
+            pMemory = static_cast< uint8_t* >( AllocateBlock( blockSize ) ) + BLOCK_ALIGNMENT;
+            static_cast< TypeBlockList** >( pMemory )[ -1 ] = pBlockList;
+        }
+
+        ++m_statistics.objectCount;
+        m_statistics.objectMemory += blockSize;
+        if( m_statistics.peakObjectMemory < m_statistics.objectMemory )
+        {
+            m_statistics.peakObjectMemory = m_statistics.objectMemory;
+        }
+    }
+
+    AddRef();
+
+    return pMemory;
+}
+
+/// Free memory previously allocated from an arena.
+///
+/// The memory is placed on the free list for its object type for reuse, and the reference to the arena held by the
+/// allocation is released.
+///
+/// @param[in] pMemory  Memory to free (as returned by Allocate()).
+///
+/// @see Allocate()
+void PackageArena::Free( void* pMemory )
+{
+    HELIUM_ASSERT( pMemory );
+
+    TypeBlockList* pBlockList = static_cast< TypeBlockList** >( pMemory )[ -1 ];
+    HELIUM_ASSERT( pBlockList );
+    PackageArena* pArena = pBlockList->pArena;
+    HELIUM_ASSERT( pArena );
+
+    {
+        MutexScopeLock scopeLock( pArena->m_lock );
+
+        *static_cast< void** >( pMemory ) = pBlockList->pFreeHead;
+        pBlockList->pFreeHead = pMemory;
+        ++pBlockList->freeCount;
+
+        HELIUM_ASSERT( pArena->m_statistics.objectCount != 0 );
+        --pArena->m_statistics.objectCount;
+        pArena->m_statistics.objectMemory -= pBlockList->blockSize;
+        ++pArena->m_statistics.freeBlockCount;
+        pArena->m_statistics.freeBlockMemory += pBlockList->blockSize;
+    }
+
+    pArena->Release();
+}
+
+/// Get the current memory usage statistics for this arena.
+///
+/// @param[out] rStatistics  Memory usage statistics.
+void PackageArena::GetStatistics( Statistics& rStatistics ) const
+{
+    MutexScopeLock scopeLock( m_lock );
+
+    rStatistics = m_statistics;
+}
+
+/// Get the free list for blocks of the given type and size, creating it if necessary.
+///
+/// This must be called with the arena lock held.
+///
+/// @param[in] pType      Object type.
+/// @param[in] blockSize  Block size, including the block header.
+///
+/// @return  Free list.
+PackageArena::TypeBlockList* PackageArena::GetBlockList( const GameObjectType* pType, size_t blockSize )
+{
+    for( TypeBlockList* pBlockList = m_pFirstBlockList; pBlockList != NULL; pBlockList = pBlockList->pNext )
+    {
+        if( pBlockList->pType == pType && pBlockList->blockSize == blockSize )
+        {
+            return pBlockList;
+        }
+    }
+
+    TypeBlockList* pBlockList = static_cast< TypeBlockList* >( DefaultAllocator().Allocate( sizeof( TypeBlockList ) ) );
+    HELIUM_ASSERT( pBlockList );
+    pBlockList->pArena = this;
+    pBlockList->pType = pType;
+    pBlockList->blockSize = blockSize;
+    pBlockList->pFreeHead = NULL;
+    pBlockList->freeCount = 0;
+    pBlockList->pNext = m_pFirstBlockList;
+    m_pFirstBlockList = pBlockList;
+
+    return pBlockList;
+}
+
+/// Carve a new block from the current slab, allocating a new slab if the current slab is full.
+///
+/// This must be called with the arena lock held.
+///
+/// @param[in] blockSize  Size of the block to allocate (must be a multiple of the block alignment).
+///
+/// @return  Pointer to the start of the block.
+void* PackageArena::AllocateBlock( size_t blockSize )
+{
+    HELIUM_ASSERT( ( blockSize & ( BLOCK_ALIGNMENT - 1 ) ) == 0 );
+
+    if( static_cast< size_t >( m_pSlabEnd - m_pSlabCurrent ) < blockSize )
+    {
+        // Blocks larger than the default slab size get a slab of their own.  The remainder of the current slab is
+        // abandoned, as it is too small for the block being allocated.
+        size_t slabHeaderSize = ( sizeof( Slab ) + BLOCK_ALIGNMENT - 1 ) & ~( BLOCK_ALIGNMENT - 1 );
+        size_t slabSize = slabHeaderSize + blockSize;
+        if( slabSize < SLAB_SIZE )
+        {
+            slabSize = SLAB_SIZE;
+        }
+
+        Slab* pSlab = static_cast< Slab* >( DefaultAllocator().AllocateAligned( BLOCK_ALIGNMENT, slabSize ) );
+        HELIUM_ASSERT( pSlab );
+        pSlab->pNext = m_pFirstSlab;
+        pSlab->size = slabSize;
+        m_pFirstSlab = pSlab;
+
+        m_pSlabCurrent = reinterpret_cast< uint8_t* >( pSlab ) + slabHeaderSize;
+        m_pSlabEnd = reinterpret_cast< uint8_t* >( pSlab ) + slabSize;
+
+        ++m_statistics.slabCount;
+        m_statistics.slabMemory += slabSize;
+    }
+
+    void* pBlock = m_pSlabCurrent;
+    m_pSlabCurrent += blockSize;
+
+    return pBlock;
+}
@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------------------------------------------------------
+// PackageArena.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_ENGINE_PACKAGE_ARENA_H
+#define HELIUM_ENGINE_PACKAGE_ARENA_H
+
+#include "Engine/Engine.h"
+
+#include "Platform/Atomic.h"
+#include "Platform/Locks.h"
+
+namespace Helium
+{
+    class GameObjectType;
+
+    /// Slab allocator for the objects owned by a single package.
+    ///
+    /// Object memory is carved sequentially from large slabs, so objects loaded together end up close together in
+    /// memory.  Memory for destroyed objects is kept on a free list for the object's type and size, and is reused for
+    /// later objects of the same type created in the package.  Slabs are never freed individually; they are all
+    /// released at once when the arena itself is destroyed.
+    ///
+    /// The arena is reference counted.  The owning package holds one reference, and each live object allocated from
+    /// the arena holds another, so the arena (and all of its slabs) is released only once the package and all of its
+    /// objects have been destroyed.
+    ///
+    /// Allocation and freeing are thread-safe.
+    class HELIUM_ENGINE_API PackageArena : NonCopyable
+    {
+    public:
+        /// Default size of each slab, in bytes.
+        static const size_t SLAB_SIZE = 64 * 1024;
+
+        /// Memory usage statistics.
+        struct Statistics
+        {
+            /// Number of slabs allocated.
+            size_t slabCount;
+            /// Total size of all slabs, in bytes.
+            size_t slabMemory;
+            /// Number of live objects.
+            size_t objectCount;
+            /// Memory used by live objects (including per-object overhead), in bytes.
+            size_t objectMemory;
+            /// Highest value of objectMemory since the arena was created, in bytes.
+            size_t peakObjectMemory;
+            /// Number of blocks on the per-type free lists.
+            size_t freeBlockCount;
+            /// Memory held on the per-type free lists, in bytes.
+            size_t freeBlockMemory;
+        };
+
+        /// @name Construction/Destruction
+        //@{
+        PackageArena();
+        //@}
+
+        /// @name Reference Counting
+        //@{
+        inline void AddRef();
+        void Release();
+        //@}
+
+        /// @name Allocation
+        //@{
+        void* Allocate( const GameObjectType* pType, size_t size );
+        static void Free( void* pMemory );
+        //@}
+
+        /// @name Statistics
+        //@{
+        void GetStatistics( Statistics& rStatistics ) const;
+        //@}
+
+    private:
+        /// Slab header.
+        struct Slab
+        {
+            /// Next slab in the arena.
+            Slab* pNext;
+            /// Total size of the slab, including this header.
+            size_t size;
+        };
+
+        /// Free list for blocks of a specific type and size.
+        struct TypeBlockList
+        {
+            /// Arena to which this list belongs.
+            PackageArena* pArena;
+            /// Object type.
+            const GameObjectType* pType;
+            /// Size of each block, including the block header.
+            size_t blockSize;
+            /// First free block.
+            void* pFreeHead;
+            /// Number of free blocks.
+            size_t freeCount;
+            /// Next free list in the arena.
+            TypeBlockList* pNext;
+        };
+
+        /// Slab list.
+        Slab* m_pFirstSlab;
+        /// Next free byte in the current slab.
+        uint8_t* m_pSlabCurrent;
+        /// End of the current slab.
+        uint8_t* m_pSlabEnd;
+
+        /// Per-type free lists.
+        TypeBlockList* m_pFirstBlockList;
+
+        /// Memory usage statistics.
+        Statistics m_statistics;
+
+        /// Reference count.
+        volatile int32_t m_referenceCount;
+
+        /// Mutex for synchronizing access to the slabs and free lists.
+        mutable Mutex m_lock;
+
+        /// @name Construction/Destruction, Private
+        //@{
+        ~PackageArena();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        TypeBlockList* GetBlockList( const GameObjectType* pType, size_t blockSize );
+        void* AllocateBlock( size_t blockSize );
+        //@}
+    };
+}
+
+#include "Engine/PackageArena.inl"
+
+#endif  // HELIUM_ENGINE_PACKAGE_ARENA_H
@@ -0,0 +1,17 @@
+//----------------------------------------------------------------------------------------------------------------------
+// PackageArena.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Add a reference to this arena.
+    ///
+    /// @see Release()
+    void PackageArena::AddRef()
+    {
+        AtomicIncrementAcquire( m_referenceCount );
+    }
+}
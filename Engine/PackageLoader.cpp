@@ -8,13 +8,47 @@
 #include "EnginePch.h"
 #include "Engine/PackageLoader.h"
 
+#include "Engine/Package.h"
+
 using namespace Helium;
 
+bool PackageLoader::sm_bUsePackageArenas = false;
+
 /// Destructor.
 PackageLoader::~PackageLoader()
 {
 }
 
+/// Set whether objects loaded into packages should be allocated from per-package arenas.
+///
+/// When enabled, each package for which a loader is set up allocates its objects from its own arena (see
+/// Package::EnableArena()), which keeps the objects of a package together in memory, releases their memory in bulk
+/// once the package is unloaded, and provides per-package memory statistics.  This only affects packages set up by
+/// loaders after this is called, and should be set during engine initialization.
+///
+/// @param[in] bUsePackageArenas  True to use package arenas, false to allocate objects from the heap.
+///
+/// @see GetUsePackageArenas()
+void PackageLoader::SetUsePackageArenas( bool bUsePackageArenas )
+{
+    sm_bUsePackageArenas = bUsePackageArenas;
+}
+
+/// Enable the arena for the given package if package arenas are in use.
+///
+/// @param[in] pPackage  Package being set up by a loader.
+///
+/// @see SetUsePackageArenas()
+void PackageLoader::ConditionalEnablePackageArena( Package* pPackage )
+{
+    HELIUM_ASSERT( pPackage );
+
+    if( sm_bUsePackageArenas )
+    {
+        pPackage->EnableArena();
+    }
+}
+
 /// @fn size_t PackageLoader::BeginLoadObject( GameObjectPath path )
 /// Begin asynchronous preloading of an object's properties from the cache.
 ///
@@ -13,6 +13,8 @@
 
 namespace Helium
 {
+    class Package;
+
     /// Package loader interface.
     class HELIUM_ENGINE_API PackageLoader : NonCopyable
     {
@@ -44,7 +46,25 @@ namespace Helium
         virtual bool IsSourcePackageFile() const = 0;
         virtual int64_t GetFileTimestamp() const = 0;
         //@}
+
+        /// @name Package Arenas
+        //@{
+        static void SetUsePackageArenas( bool bUsePackageArenas );
+        inline static bool GetUsePackageArenas();
+        //@}
+
+    protected:
+        /// @name Package Arenas, Protected
+        //@{
+        static void ConditionalEnablePackageArena( Package* pPackage );
+        //@}
+
+    private:
+        /// True if objects loaded into packages should be allocated from per-package arenas.
+        static bool sm_bUsePackageArenas;
     };
 }
 
+#include "Engine/PackageLoader.inl"
+
 #endif  // HELIUM_ENGINE_PACKAGE_LOADER_H
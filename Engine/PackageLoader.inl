@@ -0,0 +1,19 @@
+//----------------------------------------------------------------------------------------------------------------------
+// PackageLoader.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get whether objects loaded into packages are allocated from per-package arenas.
+    ///
+    /// @return  True if package arenas are used, false if not.
+    ///
+    /// @see SetUsePackageArenas()
+    bool PackageLoader::GetUsePackageArenas()
+    {
+        return sm_bUsePackageArenas;
+    }
+}
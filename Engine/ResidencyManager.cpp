@@ -0,0 +1,873 @@
+//----------------------------------------------------------------------------------------------------------------------
+// ResidencyManager.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "EnginePch.h"
+#include "Engine/ResidencyManager.h"
+
+#include "Platform/Thread.h"
+#include "Engine/GameObjectLoader.h"
+#include "Engine/PackageLoader.h"
+
+#include <cstdlib>
+
+using namespace Helium;
+
+ResidencyManager* ResidencyManager::sm_pInstance = NULL;
+
+/// Constructor.
+ResidencyManager::ResidencyManager()
+    : m_memoryBudget( 0 )
+    , m_residentMemory( 0 )
+    , m_restoreCount( 0 )
+    , m_minimumEvictionAge( DEFAULT_MINIMUM_EVICTION_AGE )
+    , m_frameIndex( 0 )
+    , m_totalReleaseCount( 0 )
+    , m_totalEvictionCount( 0 )
+    , m_totalRestoreCount( 0 )
+{
+}
+
+/// Destructor.
+///
+/// All residency references are released, although resource data that has been evicted is not restored.
+ResidencyManager::~ResidencyManager()
+{
+    m_pendingResources.Clear();
+
+    size_t resourceCount = m_resources.GetSize();
+    while( resourceCount != 0 )
+    {
+        --resourceCount;
+        RemoveResource( resourceCount );
+    }
+
+    HELIUM_ASSERT( m_restoreCount == 0 );
+    HELIUM_ASSERT( m_residentMemory == 0 );
+
+    // Any prefetches still in progress are left to finish in the object loader.  The load requests are released once
+    // the loader is shut down.
+}
+
+/// Update residency for the current frame.
+///
+/// This advances the frame index, starts tracking any newly loaded resources, updates package prefetches, restores
+/// evicted resource data that has been requested, and evicts least recently used resources if the resident resource
+/// data exceeds the memory budget.  Only a limited amount of restoring and eviction is performed during each tick, so
+/// this should be called once per frame.
+void ResidencyManager::Tick()
+{
+    ++m_frameIndex;
+
+    TrackPendingResources();
+    TickPrefetches();
+    TickRestores();
+    TickEvictions();
+}
+
+/// Start tracking residency for the given resource.
+///
+/// This is called automatically by the GameObjectLoader when a resource finishes loading, but it can also be called
+/// for resources created at runtime.  Tracking begins during the next Tick().  Calling this for a resource that is
+/// already tracked has no effect.
+///
+/// This can be called from any thread.
+///
+/// @param[in] pResource  Resource to track.
+void ResidencyManager::TrackResource( Resource* pResource )
+{
+    HELIUM_ASSERT( pResource );
+
+    MutexScopeLock scopeLock( m_pendingResourceLock );
+    m_pendingResources.Push( pResource );
+}
+
+/// Report that a resource is being used in the current frame.
+///
+/// If the resource data of the resource was evicted, it is queued to be restored.  Note that the resource data may
+/// not be available again for a few frames; IsResident() can be used to check whether the data has been restored.
+///
+/// @param[in] pResource  Resource being used.
+///
+/// @see IsResident(), TouchPackage()
+void ResidencyManager::Touch( Resource* pResource )
+{
+    if( !pResource )
+    {
+        return;
+    }
+
+    size_t entryIndex = pResource->m_residencyIndex;
+    if( IsInvalid( entryIndex ) )
+    {
+        return;
+    }
+
+    HELIUM_ASSERT( entryIndex < m_resources.GetSize() );
+    ResourceEntry& rEntry = m_resources[ entryIndex ];
+    HELIUM_ASSERT( rEntry.spResource.Get() == pResource );
+
+    rEntry.lastUseFrame = m_frameIndex;
+    rEntry.bUsageTracked = true;
+
+    if( rEntry.state == STATE_EVICTED )
+    {
+        rEntry.state = STATE_RESTORE_PENDING;
+        ++m_restoreCount;
+    }
+}
+
+/// Get whether the resource data of a resource is currently resident.
+///
+/// @param[in] pResource  Resource to check.
+///
+/// @return  True if the resource data is resident or the resource is not tracked, false if the data has been evicted
+///          or is being restored.
+bool ResidencyManager::IsResident( const Resource* pResource ) const
+{
+    HELIUM_ASSERT( pResource );
+
+    size_t entryIndex = pResource->m_residencyIndex;
+    if( IsInvalid( entryIndex ) )
+    {
+        return true;
+    }
+
+    HELIUM_ASSERT( entryIndex < m_resources.GetSize() );
+
+    return ( m_resources[ entryIndex ].state == STATE_RESIDENT );
+}
+
+/// Report that a package is being used in the current frame.
+///
+/// Resources in a package are not evicted until both the resource and its package have gone unused for the minimum
+/// eviction age.  This can be used to keep the resources of a level from being evicted while the player is in or
+/// near the level without having to touch each resource individually.
+///
+/// @param[in] packagePath  Package path.
+///
+/// @see Touch()
+void ResidencyManager::TouchPackage( GameObjectPath packagePath )
+{
+    HELIUM_ASSERT( !packagePath.IsEmpty() );
+
+    size_t packageIndex = FindOrAddPackage( packagePath );
+    m_packages[ packageIndex ].lastUseFrame = m_frameIndex;
+}
+
+/// Pin a package, preventing all of its resources from being evicted.
+///
+/// Pinning is reference counted; each call to this function must be matched by a call to UnpinPackage().
+///
+/// @param[in] packagePath  Package path.
+///
+/// @see UnpinPackage(), IsPackagePinned()
+void ResidencyManager::PinPackage( GameObjectPath packagePath )
+{
+    HELIUM_ASSERT( !packagePath.IsEmpty() );
+
+    size_t packageIndex = FindOrAddPackage( packagePath );
+    ++m_packages[ packageIndex ].pinCount;
+}
+
+/// Release a pin previously added with PinPackage().
+///
+/// @param[in] packagePath  Package path.
+///
+/// @see PinPackage(), IsPackagePinned()
+void ResidencyManager::UnpinPackage( GameObjectPath packagePath )
+{
+    size_t packageIndex = FindPackage( packagePath );
+    if( IsInvalid( packageIndex ) )
+    {
+        return;
+    }
+
+    PackageEntry& rPackage = m_packages[ packageIndex ];
+    HELIUM_ASSERT( rPackage.pinCount != 0 );
+    if( rPackage.pinCount != 0 )
+    {
+        --rPackage.pinCount;
+    }
+}
+
+/// Get whether a package is currently pinned.
+///
+/// @param[in] packagePath  Package path.
+///
+/// @return  True if the package is pinned, false if not.
+///
+/// @see PinPackage(), UnpinPackage()
+bool ResidencyManager::IsPackagePinned( GameObjectPath packagePath ) const
+{
+    size_t packageIndex = FindPackage( packagePath );
+
+    return ( IsValid( packageIndex ) && m_packages[ packageIndex ].pinCount != 0 );
+}
+
+/// Begin loading a package and all of the objects in it ahead of when they will be needed.
+///
+/// The prefetch is carried out over the course of several ticks.  Resources loaded by the prefetch are kept alive by
+/// the residency manager until they are evicted or the package is released.  The package is also touched so that
+/// its resources are not evicted right away.
+///
+/// @param[in] packagePath  Package path.
+///
+/// @see IsPrefetchPending(), ReleasePackage()
+void ResidencyManager::PrefetchPackage( GameObjectPath packagePath )
+{
+    HELIUM_ASSERT( !packagePath.IsEmpty() );
+    HELIUM_ASSERT( packagePath.IsPackage() );
+
+    TouchPackage( packagePath );
+
+    size_t requestCount = m_prefetchRequests.GetSize();
+    for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+    {
+        PrefetchRequest& rRequest = m_prefetchRequests[ requestIndex ];
+        if( rRequest.packagePath == packagePath )
+        {
+            rRequest.bReleaseOnCompletion = false;
+
+            return;
+        }
+    }
+
+    GameObjectLoader* pObjectLoader = GameObjectLoader::GetStaticInstance();
+    HELIUM_ASSERT( pObjectLoader );
+
+    size_t packageLoadId = pObjectLoader->BeginLoadObject( packagePath );
+    if( IsInvalid( packageLoadId ) )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "ResidencyManager::PrefetchPackage(): Failed to begin loading package \"%s\".\n" ),
+            *packagePath.ToString() );
+
+        return;
+    }
+
+    PrefetchRequest* pRequest = m_prefetchRequests.New();
+    HELIUM_ASSERT( pRequest );
+    pRequest->packagePath = packagePath;
+    pRequest->packageLoadId = packageLoadId;
+    pRequest->stage = PREFETCH_STAGE_PACKAGE;
+    pRequest->bReleaseOnCompletion = false;
+}
+
+/// Get whether a package prefetch is still in progress.
+///
+/// @param[in] packagePath  Package path.
+///
+/// @return  True if the package is being prefetched, false if not.
+///
+/// @see PrefetchPackage()
+bool ResidencyManager::IsPrefetchPending( GameObjectPath packagePath ) const
+{
+    size_t requestCount = m_prefetchRequests.GetSize();
+    for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+    {
+        if( m_prefetchRequests[ requestIndex ].packagePath == packagePath )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// Release all residency references to the resources in a package (streaming unload).
+///
+/// Any pins on the package are removed as well.  Resources that are not referenced elsewhere are destroyed
+/// immediately; the rest are destroyed once the last outside reference to them goes away.  If the package is still
+/// being prefetched, it is released again once the prefetch completes.
+///
+/// @param[in] packagePath  Package path.
+void ResidencyManager::ReleasePackage( GameObjectPath packagePath )
+{
+    size_t requestCount = m_prefetchRequests.GetSize();
+    for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+    {
+        PrefetchRequest& rRequest = m_prefetchRequests[ requestIndex ];
+        if( rRequest.packagePath == packagePath )
+        {
+            rRequest.bReleaseOnCompletion = true;
+
+            break;
+        }
+    }
+
+    size_t packageIndex = FindPackage( packagePath );
+    if( IsInvalid( packageIndex ) )
+    {
+        return;
+    }
+
+    m_packages[ packageIndex ].pinCount = 0;
+
+    // Resources queued for tracking are added first so that they get released as well.
+    TrackPendingResources();
+
+    size_t resourceIndex = m_resources.GetSize();
+    while( resourceIndex != 0 )
+    {
+        --resourceIndex;
+
+        // Removal swaps the last entry into the removed slot, which has already been visited when iterating backwards.
+        if( m_resources[ resourceIndex ].packageIndex == packageIndex )
+        {
+            RemoveResource( resourceIndex );
+            ++m_totalReleaseCount;
+        }
+    }
+
+    HELIUM_ASSERT( m_packages[ packageIndex ].resourceCount == 0 );
+    HELIUM_ASSERT( m_packages[ packageIndex ].residentSize == 0 );
+}
+
+/// Get the amount of memory used by the resident resource data of the tracked resources in a package.
+///
+/// @param[in] packagePath  Package path.
+///
+/// @return  Resident resource data size, in bytes.
+///
+/// @see GetResidentMemory()
+size_t ResidencyManager::GetPackageResidentMemory( GameObjectPath packagePath ) const
+{
+    size_t packageIndex = FindPackage( packagePath );
+
+    return ( IsValid( packageIndex ) ? m_packages[ packageIndex ].residentSize : 0 );
+}
+
+/// Get the current residency statistics.
+///
+/// @param[out] rStatistics  Residency statistics.
+void ResidencyManager::GetStatistics( Statistics& rStatistics ) const
+{
+    rStatistics.resourceCount = m_resources.GetSize();
+    rStatistics.evictedResourceCount = 0;
+    rStatistics.restoringResourceCount = 0;
+    rStatistics.residentMemory = m_residentMemory;
+    rStatistics.memoryBudget = m_memoryBudget;
+    rStatistics.pinnedPackageCount = 0;
+    rStatistics.prefetchCount = m_prefetchRequests.GetSize();
+    rStatistics.totalReleaseCount = m_totalReleaseCount;
+    rStatistics.totalEvictionCount = m_totalEvictionCount;
+    rStatistics.totalRestoreCount = m_totalRestoreCount;
+
+    size_t resourceCount = m_resources.GetSize();
+    for( size_t resourceIndex = 0; resourceIndex < resourceCount; ++resourceIndex )
+    {
+        int32_t state = m_resources[ resourceIndex ].state;
+        if( state == STATE_EVICTED || state == STATE_RESTORE_PENDING )
+        {
+            ++rStatistics.evictedResourceCount;
+        }
+        else if( state == STATE_RESTORING )
+        {
+            ++rStatistics.restoringResourceCount;
+        }
+    }
+
+    size_t packageCount = m_packages.GetSize();
+    for( size_t packageIndex = 0; packageIndex < packageCount; ++packageIndex )
+    {
+        if( m_packages[ packageIndex ].pinCount != 0 )
+        {
+            ++rStatistics.pinnedPackageCount;
+        }
+    }
+}
+
+/// Create the singleton ResidencyManager instance.
+///
+/// Once an instance exists, resources loaded by the GameObjectLoader are tracked automatically.
+///
+/// @return  Pointer to the created instance.
+///
+/// @see DestroyStaticInstance(), GetStaticInstance()
+ResidencyManager* ResidencyManager::CreateStaticInstance()
+{
+    if( !sm_pInstance )
+    {
+        sm_pInstance = new ResidencyManager;
+        HELIUM_ASSERT( sm_pInstance );
+    }
+
+    return sm_pInstance;
+}
+
+/// Destroy the singleton ResidencyManager instance.
+///
+/// @see CreateStaticInstance(), GetStaticInstance()
+void ResidencyManager::DestroyStaticInstance()
+{
+    delete sm_pInstance;
+    sm_pInstance = NULL;
+}
+
+/// Get the singleton ResidencyManager instance.
+///
+/// Note that the ResidencyManager instance is not created automatically.  One must explicitly be created using
+/// CreateStaticInstance() for residency to be managed.
+///
+/// @return  Pointer to the ResidencyManager instance if one exists, null if not.
+///
+/// @see CreateStaticInstance(), DestroyStaticInstance()
+ResidencyManager* ResidencyManager::GetStaticInstance()
+{
+    return sm_pInstance;
+}
+
+/// Start tracking all resources queued through TrackResource().
+void ResidencyManager::TrackPendingResources()
+{
+    MutexScopeLock scopeLock( m_pendingResourceLock );
+
+    size_t pendingCount = m_pendingResources.GetSize();
+    for( size_t pendingIndex = 0; pendingIndex < pendingCount; ++pendingIndex )
+    {
+        Resource* pResource = m_pendingResources[ pendingIndex ];
+        HELIUM_ASSERT( pResource );
+        AddResource( pResource );
+    }
+
+    m_pendingResources.Resize( 0 );
+}
+
+/// Update all package prefetches in progress.
+void ResidencyManager::TickPrefetches()
+{
+    if( m_prefetchRequests.IsEmpty() )
+    {
+        return;
+    }
+
+    GameObjectLoader* pObjectLoader = GameObjectLoader::GetStaticInstance();
+    HELIUM_ASSERT( pObjectLoader );
+
+    size_t requestIndex = m_prefetchRequests.GetSize();
+    while( requestIndex != 0 )
+    {
+        --requestIndex;
+
+        PrefetchRequest& rRequest = m_prefetchRequests[ requestIndex ];
+        GameObjectPtr spObject;
+
+        if( rRequest.stage == PREFETCH_STAGE_PACKAGE )
+        {
+            if( !pObjectLoader->TryFinishLoad( rRequest.packageLoadId, spObject ) )
+            {
+                continue;
+            }
+
+            SetInvalid( rRequest.packageLoadId );
+            rRequest.stage = PREFETCH_STAGE_OBJECTS;
+
+            // The package loader has finished preloading once the package object itself has been loaded, so the list
+            // of objects it provides is now available.
+            PackageLoader* pPackageLoader =
+                ( spObject ? pObjectLoader->FindPackageLoader( rRequest.packagePath ) : NULL );
+            if( !pPackageLoader )
+            {
+                HELIUM_TRACE(
+                    TraceLevels::Error,
+                    TXT( "ResidencyManager::TickPrefetches(): Failed to load package \"%s\" for prefetching.\n" ),
+                    *rRequest.packagePath.ToString() );
+            }
+            else
+            {
+                size_t objectCount = pPackageLoader->GetObjectCount();
+                for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+                {
+                    GameObjectPath objectPath = pPackageLoader->GetObjectPath( objectIndex );
+                    if( objectPath.IsPackage() || GetOwnerPackagePath( objectPath ) != rRequest.packagePath )
+                    {
+                        continue;
+                    }
+
+                    size_t objectLoadId = pObjectLoader->BeginLoadObject( objectPath );
+                    if( IsValid( objectLoadId ) )
+                    {
+                        rRequest.objectLoadIds.Push( objectLoadId );
+                    }
+                }
+            }
+        }
+
+        HELIUM_ASSERT( rRequest.stage == PREFETCH_STAGE_OBJECTS );
+
+        // Loaded resources are tracked as they finish loading, so the loaded objects themselves don't need to be kept.
+        size_t loadIndex = rRequest.objectLoadIds.GetSize();
+        while( loadIndex != 0 )
+        {
+            --loadIndex;
+
+            if( pObjectLoader->TryFinishLoad( rRequest.objectLoadIds[ loadIndex ], spObject ) )
+            {
+                rRequest.objectLoadIds.RemoveSwap( loadIndex );
+            }
+        }
+
+        if( rRequest.objectLoadIds.IsEmpty() )
+        {
+            GameObjectPath packagePath = rRequest.packagePath;
+            bool bReleaseOnCompletion = rRequest.bReleaseOnCompletion;
+
+            m_prefetchRequests.RemoveSwap( requestIndex );
+
+            if( bReleaseOnCompletion )
+            {
+                ReleasePackage( packagePath );
+            }
+        }
+    }
+}
+
+/// Update the restoring of evicted resource data.
+void ResidencyManager::TickRestores()
+{
+    if( m_restoreCount == 0 )
+    {
+        return;
+    }
+
+    size_t startCount = 0;
+
+    size_t resourceCount = m_resources.GetSize();
+    for( size_t resourceIndex = 0; resourceIndex < resourceCount; ++resourceIndex )
+    {
+        ResourceEntry& rEntry = m_resources[ resourceIndex ];
+        if( rEntry.state == STATE_RESTORE_PENDING && startCount < RESTORE_COUNT_MAX_PER_TICK )
+        {
+            Resource* pResource = rEntry.spResource;
+            HELIUM_ASSERT( pResource );
+
+            ++startCount;
+            rEntry.state = STATE_RESTORING;
+
+            if( pResource->NeedsPrecacheResourceData() && !pResource->BeginPrecacheResourceData() )
+            {
+                HELIUM_TRACE(
+                    TraceLevels::Error,
+                    TXT( "ResidencyManager::TickRestores(): Failed to restore resource data for \"%s\".\n" ),
+                    *pResource->GetPath().ToString() );
+
+                // Don't attempt to restore the resource again, as the resource data is likely no longer available.
+                rEntry.state = STATE_RESIDENT;
+                --m_restoreCount;
+
+                continue;
+            }
+        }
+
+        if( rEntry.state == STATE_RESTORING && rEntry.spResource->TryFinishPrecacheResourceData() )
+        {
+            FinishRestore( rEntry );
+        }
+    }
+}
+
+/// Evict the least recently used resources if the resident resource data exceeds the memory budget.
+void ResidencyManager::TickEvictions()
+{
+    if( m_memoryBudget == 0 || m_residentMemory <= m_memoryBudget )
+    {
+        return;
+    }
+
+    // Gather all resources that are eligible for eviction.
+    m_evictionCandidates.Resize( 0 );
+
+    size_t resourceCount = m_resources.GetSize();
+    for( size_t resourceIndex = 0; resourceIndex < resourceCount; ++resourceIndex )
+    {
+        const ResourceEntry& rEntry = m_resources[ resourceIndex ];
+        if( rEntry.state != STATE_RESIDENT || rEntry.residentSize == 0 )
+        {
+            continue;
+        }
+
+        uint32_t lastUseFrame = rEntry.lastUseFrame;
+        if( IsValid( rEntry.packageIndex ) )
+        {
+            const PackageEntry& rPackage = m_packages[ rEntry.packageIndex ];
+            if( rPackage.pinCount != 0 )
+            {
+                continue;
+            }
+
+            // Frame indices are compared by age so that wrapping of the frame counter is handled properly.
+            if( m_frameIndex - rPackage.lastUseFrame < m_frameIndex - lastUseFrame )
+            {
+                lastUseFrame = rPackage.lastUseFrame;
+            }
+        }
+
+        if( m_frameIndex - lastUseFrame < m_minimumEvictionAge )
+        {
+            continue;
+        }
+
+        EvictionCandidate* pCandidate = m_evictionCandidates.New();
+        HELIUM_ASSERT( pCandidate );
+        pCandidate->entryIndex = resourceIndex;
+        pCandidate->age = m_frameIndex - lastUseFrame;
+    }
+
+    size_t candidateCount = m_evictionCandidates.GetSize();
+    if( candidateCount == 0 )
+    {
+        return;
+    }
+
+    qsort( m_evictionCandidates.GetData(), candidateCount, sizeof( EvictionCandidate ), EvictionCandidateCompare );
+
+    // Evict the oldest candidates until we are back within budget.  Resources only referenced by the residency manager
+    // are flagged for release and removed afterwards so that the candidate indices remain valid.
+    size_t evictionCount = 0;
+    bool bHaveReleases = false;
+
+    for( size_t candidateIndex = 0;
+         candidateIndex < candidateCount &&
+            evictionCount < EVICTION_COUNT_MAX_PER_TICK &&
+            m_residentMemory > m_memoryBudget;
+         ++candidateIndex )
+    {
+        ResourceEntry& rEntry = m_resources[ m_evictionCandidates[ candidateIndex ].entryIndex ];
+        Resource* pResource = rEntry.spResource;
+        HELIUM_ASSERT( pResource );
+
+        if( pResource->GetRefCountProxy()->GetStrongRefCount() == 1 )
+        {
+            SetResidentSize( rEntry, 0 );
+            rEntry.state = STATE_INVALID;
+            bHaveReleases = true;
+
+            ++m_totalReleaseCount;
+        }
+        else if( rEntry.bUsageTracked && pResource->EvictResourceData() )
+        {
+            SetResidentSize( rEntry, 0 );
+            rEntry.state = STATE_EVICTED;
+
+            ++m_totalEvictionCount;
+        }
+        else
+        {
+            continue;
+        }
+
+        ++evictionCount;
+    }
+
+    if( bHaveReleases )
+    {
+        size_t resourceIndex = m_resources.GetSize();
+        while( resourceIndex != 0 )
+        {
+            --resourceIndex;
+
+            if( m_resources[ resourceIndex ].state == STATE_INVALID )
+            {
+                RemoveResource( resourceIndex );
+            }
+        }
+    }
+}
+
+/// Add an entry for the given resource.
+///
+/// @param[in] pResource  Resource to track.
+void ResidencyManager::AddResource( Resource* pResource )
+{
+    HELIUM_ASSERT( pResource );
+
+    if( IsValid( pResource->m_residencyIndex ) || pResource->IsDefaultTemplate() )
+    {
+        return;
+    }
+
+    GameObjectPath packagePath = GetOwnerPackagePath( pResource->GetPath() );
+    size_t packageIndex = ( packagePath.IsEmpty() ? Invalid< size_t >() : FindOrAddPackage( packagePath ) );
+
+    pResource->m_residencyIndex = m_resources.GetSize();
+
+    ResourceEntry* pEntry = m_resources.New();
+    HELIUM_ASSERT( pEntry );
+    pEntry->spResource = pResource;
+    pEntry->packageIndex = packageIndex;
+    pEntry->residentSize = 0;
+    pEntry->lastUseFrame = m_frameIndex;
+    pEntry->state = STATE_RESIDENT;
+    pEntry->bUsageTracked = false;
+
+    if( IsValid( packageIndex ) )
+    {
+        ++m_packages[ packageIndex ].resourceCount;
+    }
+
+    SetResidentSize( *pEntry, pResource->GetResidentResourceDataSize() );
+}
+
+/// Remove the entry at the given index, releasing the residency reference to its resource.
+///
+/// If the resource data is being restored, this waits for the restore to complete first.
+///
+/// @param[in] entryIndex  Resource entry index.
+void ResidencyManager::RemoveResource( size_t entryIndex )
+{
+    HELIUM_ASSERT( entryIndex < m_resources.GetSize() );
+
+    ResourceEntry& rEntry = m_resources[ entryIndex ];
+    Resource* pResource = rEntry.spResource;
+    HELIUM_ASSERT( pResource );
+    HELIUM_ASSERT( pResource->m_residencyIndex == entryIndex );
+
+    if( rEntry.state == STATE_RESTORING )
+    {
+        while( !pResource->TryFinishPrecacheResourceData() )
+        {
+            Thread::Yield();
+        }
+
+        FinishRestore( rEntry );
+    }
+    else if( rEntry.state == STATE_RESTORE_PENDING )
+    {
+        --m_restoreCount;
+    }
+
+    SetResidentSize( rEntry, 0 );
+
+    if( IsValid( rEntry.packageIndex ) )
+    {
+        PackageEntry& rPackage = m_packages[ rEntry.packageIndex ];
+        HELIUM_ASSERT( rPackage.resourceCount != 0 );
+        --rPackage.resourceCount;
+    }
+
+    SetInvalid( pResource->m_residencyIndex );
+
+    // Releasing the entry may destroy the resource.
+    m_resources.RemoveSwap( entryIndex );
+    if( entryIndex < m_resources.GetSize() )
+    {
+        m_resources[ entryIndex ].spResource->m_residencyIndex = entryIndex;
+    }
+}
+
+/// Mark the resource data of the given entry as restored.
+///
+/// @param[in] rEntry  Resource entry for which precaching has completed.
+void ResidencyManager::FinishRestore( ResourceEntry& rEntry )
+{
+    HELIUM_ASSERT( rEntry.state == STATE_RESTORING );
+    HELIUM_ASSERT( m_restoreCount != 0 );
+
+    rEntry.state = STATE_RESIDENT;
+    --m_restoreCount;
+    ++m_totalRestoreCount;
+
+    SetResidentSize( rEntry, rEntry.spResource->GetResidentResourceDataSize() );
+}
+
+/// Update the resident resource data size of an entry, updating the memory totals accordingly.
+///
+/// @param[in] rEntry        Resource entry.
+/// @param[in] residentSize  New resident resource data size, in bytes.
+void ResidencyManager::SetResidentSize( ResourceEntry& rEntry, size_t residentSize )
+{
+    HELIUM_ASSERT( m_residentMemory >= rEntry.residentSize );
+    m_residentMemory = m_residentMemory - rEntry.residentSize + residentSize;
+
+    if( IsValid( rEntry.packageIndex ) )
+    {
+        PackageEntry& rPackage = m_packages[ rEntry.packageIndex ];
+        HELIUM_ASSERT( rPackage.residentSize >= rEntry.residentSize );
+        rPackage.residentSize = rPackage.residentSize - rEntry.residentSize + residentSize;
+    }
+
+    rEntry.residentSize = residentSize;
+}
+
+/// Find the entry for a package.
+///
+/// @param[in] packagePath  Package path.
+///
+/// @return  Package entry index, or an invalid index if the package is not tracked.
+size_t ResidencyManager::FindPackage( GameObjectPath packagePath ) const
+{
+    size_t packageCount = m_packages.GetSize();
+    for( size_t packageIndex = 0; packageIndex < packageCount; ++packageIndex )
+    {
+        if( m_packages[ packageIndex ].path == packagePath )
+        {
+            return packageIndex;
+        }
+    }
+
+    return Invalid< size_t >();
+}
+
+/// Find the entry for a package, adding one if the package is not yet tracked.
+///
+/// Package entries are never removed, so package indices stored in resource entries remain valid.
+///
+/// @param[in] packagePath  Package path.
+///
+/// @return  Package entry index.
+size_t ResidencyManager::FindOrAddPackage( GameObjectPath packagePath )
+{
+    size_t packageIndex = FindPackage( packagePath );
+    if( IsInvalid( packageIndex ) )
+    {
+        packageIndex = m_packages.GetSize();
+
+        PackageEntry* pPackage = m_packages.New();
+        HELIUM_ASSERT( pPackage );
+        pPackage->path = packagePath;
+        pPackage->residentSize = 0;
+        pPackage->resourceCount = 0;
+        pPackage->lastUseFrame = m_frameIndex;
+        pPackage->pinCount = 0;
+    }
+
+    return packageIndex;
+}
+
+/// Get the path of the package that directly contains an object.
+///
+/// @param[in] path  GameObject path.
+///
+/// @return  Path of the nearest package above the object, or an empty path if the object is not in a package.
+GameObjectPath ResidencyManager::GetOwnerPackagePath( GameObjectPath path )
+{
+    for( GameObjectPath parentPath = path.GetParent(); !parentPath.IsEmpty(); parentPath = parentPath.GetParent() )
+    {
+        if( parentPath.IsPackage() )
+        {
+            return parentPath;
+        }
+    }
+
+    return GameObjectPath( NULL_NAME );
+}
+
+/// qsort() callback for sorting eviction candidates from oldest to most recently used.
+///
+/// @param[in] pElement0  First candidate to compare.
+/// @param[in] pElement1  Second candidate to compare.
+///
+/// @return  Less than zero if the first candidate has gone unused longer than the second, greater than zero if the
+///          second candidate has gone unused longer than the first, zero if both have gone unused equally long.
+int ResidencyManager::EvictionCandidateCompare( const void* pElement0, const void* pElement1 )
+{
+    uint32_t age0 = static_cast< const EvictionCandidate* >( pElement0 )->age;
+    uint32_t age1 = static_cast< const EvictionCandidate* >( pElement1 )->age;
+
+    return ( age0 > age1 ? -1 : ( age0 < age1 ? 1 : 0 ) );
+}
@@ -0,0 +1,290 @@
+//----------------------------------------------------------------------------------------------------------------------
+// ResidencyManager.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_ENGINE_RESIDENCY_MANAGER_H
+#define HELIUM_ENGINE_RESIDENCY_MANAGER_H
+
+#include "Engine/Engine.h"
+
+#include "Platform/Locks.h"
+#include "Engine/GameObjectPath.h"
+#include "Engine/Resource.h"
+
+namespace Helium
+{
+    class PackageLoader;
+
+    typedef Helium::StrongPtr< Resource > ResourcePtr;
+
+    /// Resource residency manager.
+    ///
+    /// The residency manager keeps track of the resources loaded through the GameObjectLoader, along with the package
+    /// from which each was loaded, the frame in which each was last used, and the amount of memory used by the
+    /// resource data of each.  When the resident resource data exceeds the memory budget, the least recently used
+    /// resources in unpinned packages are evicted a few at a time during each Tick():
+    /// - Resources that are only referenced by the residency manager are released, destroying the resource objects
+    ///   and freeing all of their data.
+    /// - Resources that are still referenced elsewhere but have not been used recently (see Touch()) have their
+    ///   resource data evicted through Resource::EvictResourceData().  The data is restored by precaching the
+    ///   resource again the next time the resource is touched.
+    ///
+    /// Resources for which the game never reports use through Touch() are never data-evicted while they are still
+    /// referenced, as the residency manager has no way of knowing whether they are still in use.
+    ///
+    /// Packages can be pinned to prevent eviction of any of their resources, prefetched ahead of when they will be
+    /// needed, and released once they are no longer needed (streaming unload).
+    ///
+    /// With the exception of TrackResource(), which may be called from any thread, all functions must be called from
+    /// the main thread.
+    class HELIUM_ENGINE_API ResidencyManager : NonCopyable
+    {
+    public:
+        /// Maximum number of resources to evict or release during a single tick.
+        static const size_t EVICTION_COUNT_MAX_PER_TICK = 16;
+        /// Maximum number of evicted resources for which to begin restoring data during a single tick.
+        static const size_t RESTORE_COUNT_MAX_PER_TICK = 8;
+        /// Default minimum number of frames since a resource was last used before it can be evicted.
+        static const uint32_t DEFAULT_MINIMUM_EVICTION_AGE = 60;
+
+        /// Residency statistics.
+        struct Statistics
+        {
+            /// Number of resources being tracked.
+            size_t resourceCount;
+            /// Number of tracked resources whose resource data has been evicted.
+            size_t evictedResourceCount;
+            /// Number of tracked resources whose resource data is being restored.
+            size_t restoringResourceCount;
+            /// Memory used by resident resource data, in bytes.
+            size_t residentMemory;
+            /// Memory budget, in bytes (zero if no budget is set).
+            size_t memoryBudget;
+            /// Number of packages currently pinned.
+            size_t pinnedPackageCount;
+            /// Number of package prefetches in progress.
+            size_t prefetchCount;
+
+            /// Total number of resources released since the residency manager was created.
+            uint64_t totalReleaseCount;
+            /// Total number of resources whose resource data has been evicted since the residency manager was created.
+            uint64_t totalEvictionCount;
+            /// Total number of resources whose resource data has been restored since the residency manager was
+            /// created.
+            uint64_t totalRestoreCount;
+        };
+
+        /// @name Budget
+        //@{
+        inline void SetMemoryBudget( size_t budget );
+        inline size_t GetMemoryBudget() const;
+        inline void SetMinimumEvictionAge( uint32_t frameCount );
+        inline uint32_t GetMinimumEvictionAge() const;
+        //@}
+
+        /// @name Updating
+        //@{
+        void Tick();
+        inline uint32_t GetFrameIndex() const;
+        //@}
+
+        /// @name Resource Tracking
+        //@{
+        void TrackResource( Resource* pResource );
+        void Touch( Resource* pResource );
+        bool IsResident( const Resource* pResource ) const;
+        //@}
+
+        /// @name Package Control
+        //@{
+        void TouchPackage( GameObjectPath packagePath );
+        void PinPackage( GameObjectPath packagePath );
+        void UnpinPackage( GameObjectPath packagePath );
+        bool IsPackagePinned( GameObjectPath packagePath ) const;
+
+        void PrefetchPackage( GameObjectPath packagePath );
+        bool IsPrefetchPending( GameObjectPath packagePath ) const;
+
+        void ReleasePackage( GameObjectPath packagePath );
+
+        size_t GetPackageResidentMemory( GameObjectPath packagePath ) const;
+        //@}
+
+        /// @name Statistics
+        //@{
+        inline size_t GetResidentMemory() const;
+        void GetStatistics( Statistics& rStatistics ) const;
+        //@}
+
+        /// @name Static Access
+        //@{
+        static ResidencyManager* CreateStaticInstance();
+        static void DestroyStaticInstance();
+        static ResidencyManager* GetStaticInstance();
+        //@}
+
+    private:
+        /// Resource residency state.
+        enum EState
+        {
+            STATE_FIRST   =  0,
+            STATE_INVALID = -1,
+
+            /// Resource data is resident.
+            STATE_RESIDENT,
+            /// Resource data has been evicted.
+            STATE_EVICTED,
+            /// Resource data has been evicted and has been requested to be restored.
+            STATE_RESTORE_PENDING,
+            /// Resource data is being restored.
+            STATE_RESTORING,
+
+            STATE_MAX,
+            STATE_LAST = STATE_MAX - 1
+        };
+
+        /// Package prefetch stage.
+        enum EPrefetchStage
+        {
+            PREFETCH_STAGE_FIRST   =  0,
+            PREFETCH_STAGE_INVALID = -1,
+
+            /// Loading the package object.
+            PREFETCH_STAGE_PACKAGE,
+            /// Loading the objects in the package.
+            PREFETCH_STAGE_OBJECTS,
+
+            PREFETCH_STAGE_MAX,
+            PREFETCH_STAGE_LAST = PREFETCH_STAGE_MAX - 1
+        };
+
+        /// Tracked resource entry.
+        struct ResourceEntry
+        {
+            /// Residency reference to the resource.
+            ResourcePtr spResource;
+            /// Index of the entry for the package from which the resource was loaded (invalid if not in a package).
+            size_t packageIndex;
+            /// Size of the resident resource data, in bytes.
+            size_t residentSize;
+            /// Index of the frame in which the resource was last used.
+            uint32_t lastUseFrame;
+            /// Residency state (EState value).
+            int32_t state;
+            /// True if the game has reported use of the resource through Touch().
+            bool bUsageTracked;
+        };
+
+        /// Tracked package entry.
+        struct PackageEntry
+        {
+            /// Package path.
+            GameObjectPath path;
+            /// Size of the resident resource data of all tracked resources in the package, in bytes.
+            size_t residentSize;
+            /// Number of tracked resources in the package.
+            size_t resourceCount;
+            /// Index of the frame in which the package was last touched.
+            uint32_t lastUseFrame;
+            /// Number of outstanding PinPackage() calls.
+            uint32_t pinCount;
+        };
+
+        /// Package prefetch request.
+        struct PrefetchRequest
+        {
+            /// Package path.
+            GameObjectPath packagePath;
+            /// Load request ID for the package object.
+            size_t packageLoadId;
+            /// Load request IDs for the objects in the package that have not finished loading.
+            DynamicArray< size_t > objectLoadIds;
+            /// Current stage (EPrefetchStage value).
+            int32_t stage;
+            /// True if the package was released while being prefetched and should be released again once the
+            /// prefetch completes.
+            bool bReleaseOnCompletion;
+        };
+
+        /// Eviction candidate.
+        struct EvictionCandidate
+        {
+            /// Resource entry index.
+            size_t entryIndex;
+            /// Number of frames since the resource or its package was last used.
+            uint32_t age;
+        };
+
+        /// Tracked resources.
+        DynamicArray< ResourceEntry > m_resources;
+        /// Tracked packages.
+        DynamicArray< PackageEntry > m_packages;
+        /// Package prefetch requests in progress.
+        DynamicArray< PrefetchRequest > m_prefetchRequests;
+
+        /// Resources queued for tracking during the next tick.
+        DynamicArray< ResourcePtr > m_pendingResources;
+        /// Mutex for synchronizing access to the pending resource queue.
+        Mutex m_pendingResourceLock;
+
+        /// Scratch buffer for gathering eviction candidates.
+        DynamicArray< EvictionCandidate > m_evictionCandidates;
+
+        /// Memory budget for resident resource data, in bytes (zero if no budget is set).
+        size_t m_memoryBudget;
+        /// Memory used by resident resource data, in bytes.
+        size_t m_residentMemory;
+        /// Number of resources whose resource data is waiting to be or is being restored.
+        size_t m_restoreCount;
+        /// Minimum number of frames since a resource was last used before it can be evicted.
+        uint32_t m_minimumEvictionAge;
+        /// Current frame index.
+        uint32_t m_frameIndex;
+
+        /// Total number of resources released.
+        uint64_t m_totalReleaseCount;
+        /// Total number of resources data-evicted.
+        uint64_t m_totalEvictionCount;
+        /// Total number of resources restored.
+        uint64_t m_totalRestoreCount;
+
+        /// Singleton instance.
+        static ResidencyManager* sm_pInstance;
+
+        /// @name Construction/Destruction, Private
+        //@{
+        ResidencyManager();
+        ~ResidencyManager();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        void TrackPendingResources();
+        void TickPrefetches();
+        void TickRestores();
+        void TickEvictions();
+
+        void AddResource( Resource* pResource );
+        void RemoveResource( size_t entryIndex );
+        void FinishRestore( ResourceEntry& rEntry );
+        void SetResidentSize( ResourceEntry& rEntry, size_t residentSize );
+
+        size_t FindPackage( GameObjectPath packagePath ) const;
+        size_t FindOrAddPackage( GameObjectPath packagePath );
+        //@}
+
+        /// @name Static Private Utility Functions
+        //@{
+        static GameObjectPath GetOwnerPackagePath( GameObjectPath path );
+        static int EvictionCandidateCompare( const void* pElement0, const void* pElement1 );
+        //@}
+    };
+}
+
+#include "Engine/ResidencyManager.inl"
+
+#endif  // HELIUM_ENGINE_RESIDENCY_MANAGER_H
@@ -0,0 +1,69 @@
+//----------------------------------------------------------------------------------------------------------------------
+// ResidencyManager.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Set the memory budget for resident resource data.
+    ///
+    /// @param[in] budget  Memory budget, in bytes, or zero to disable eviction.
+    ///
+    /// @see GetMemoryBudget()
+    void ResidencyManager::SetMemoryBudget( size_t budget )
+    {
+        m_memoryBudget = budget;
+    }
+
+    /// Get the memory budget for resident resource data.
+    ///
+    /// @return  Memory budget, in bytes (zero if no budget is set).
+    ///
+    /// @see SetMemoryBudget()
+    size_t ResidencyManager::GetMemoryBudget() const
+    {
+        return m_memoryBudget;
+    }
+
+    /// Set the minimum number of frames since a resource was last used before it can be evicted.
+    ///
+    /// @param[in] frameCount  Minimum eviction age, in frames.
+    ///
+    /// @see GetMinimumEvictionAge()
+    void ResidencyManager::SetMinimumEvictionAge( uint32_t frameCount )
+    {
+        m_minimumEvictionAge = frameCount;
+    }
+
+    /// Get the minimum number of frames since a resource was last used before it can be evicted.
+    ///
+    /// @return  Minimum eviction age, in frames.
+    ///
+    /// @see SetMinimumEvictionAge()
+    uint32_t ResidencyManager::GetMinimumEvictionAge() const
+    {
+        return m_minimumEvictionAge;
+    }
+
+    /// Get the index of the current frame.
+    ///
+    /// The frame index is incremented at the start of each Tick().
+    ///
+    /// @return  Current frame index.
+    uint32_t ResidencyManager::GetFrameIndex() const
+    {
+        return m_frameIndex;
+    }
+
+    /// Get the amount of memory used by the resource data of all tracked resources.
+    ///
+    /// @return  Resident resource data size, in bytes.
+    ///
+    /// @see GetPackageResidentMemory(), GetStatistics()
+    size_t ResidencyManager::GetResidentMemory() const
+    {
+        return m_residentMemory;
+    }
+}
@@ -13,6 +13,7 @@ using namespace Helium;
 
 /// Constructor.
 Resource::Resource()
+    : m_residencyIndex( Invalid< size_t >() )
 {
 #if HELIUM_TOOLS
     for( size_t preprocessedDataIndex = 0;
@@ -44,6 +45,33 @@ Name Resource::GetCacheName() const
     return Name( NULL_NAME );
 }
 
+/// Get the amount of memory used by the resource data currently loaded for this resource.
+///
+/// This is used by the ResidencyManager to keep track of how much memory can be reclaimed by evicting the resource
+/// data of this resource.  Resource types that do not support eviction can leave this returning zero.
+///
+/// @return  Resident resource data size, in bytes.
+///
+/// @see EvictResourceData()
+size_t Resource::GetResidentResourceDataSize() const
+{
+    return 0;
+}
+
+/// Release the resource data loaded for this resource while keeping the resource object itself around.
+///
+/// Evicted resource data is restored by precaching the resource again (see BeginPrecacheResourceData() and
+/// TryFinishPrecacheResourceData()), so resource types that support eviction must be able to have their data restored
+/// in this manner.  This is only called from the main thread, and never while the resource is being precached.
+///
+/// @return  True if the resource data was evicted, false if eviction is not supported or not currently possible.
+///
+/// @see GetResidentResourceDataSize()
+bool Resource::EvictResourceData()
+{
+    return false;
+}
+
 /// Get the size of the specified sub-data of this resource.
 ///
 /// @param[in] subDataIndex  Resource sub-data index.
@@ -83,6 +111,28 @@ size_t Resource::GetSubDataSize( uint32_t subDataIndex ) const
     return ( pCacheEntry ? pCacheEntry->size : Invalid< size_t >() );
 }
 
+/// Get the combined size of the first given number of sub-data entries of this resource.
+///
+/// @param[in] subDataCount  Number of sub-data entries, starting from the first, to include.
+///
+/// @return  Total size of all sub-data entries that could be located.
+///
+/// @see GetSubDataSize()
+size_t Resource::GetTotalSubDataSize( uint32_t subDataCount ) const
+{
+    size_t totalSize = 0;
+    for( uint32_t subDataIndex = 0; subDataIndex < subDataCount; ++subDataIndex )
+    {
+        size_t subDataSize = GetSubDataSize( subDataIndex );
+        if( IsValid( subDataSize ) )
+        {
+            totalSize += subDataSize;
+        }
+    }
+
+    return totalSize;
+}
+
 /// Begin asynchronous loading of the specified resource sub-data.
 ///
 /// @param[in] pBuffer       Buffer in which to load the resource sub-data.  This must be at least as large as the
@@ -139,16 +189,86 @@ size_t Resource::BeginLoadSubData( void* pBuffer, uint32_t subDataIndex, size_t
         return Invalid< size_t >();
     }
 
-    // Begin an asynchronous load.
     size_t subDataSize = pCacheEntry->size;
     size_t loadSize = Min( subDataSize, loadSizeMax );
 
+    // If the cache file is memory-mapped, copy the sub-data immediately and assign a dummy ID.
+    const uint8_t* pMappedData = pCache->GetMappedEntryData( *pCacheEntry );
+    if( pMappedData )
+    {
+        MemoryCopy( pBuffer, pMappedData, loadSize );
+
+        return static_cast< size_t >( -2 );
+    }
+
+    // Begin an asynchronous load.
     AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
     size_t loadId = rAsyncLoader.QueueRequest( pBuffer, pCache->GetCacheFileName(), pCacheEntry->offset, loadSize );
 
     return loadId;
 }
 
+/// Get direct read-only access to the specified resource sub-data without copying it.
+///
+/// This is only possible if the sub-data is already resident in memory (either as in-memory preprocessed data in tools
+/// builds or within a memory-mapped cache file).  Callers should fall back to BeginLoadSubData() if this fails.
+///
+/// @param[in]  subDataIndex  Resource sub-data index.
+/// @param[out] rSize         Size of the sub-data, in bytes, if found.
+///
+/// @return  Pointer to the sub-data, or null if the sub-data is not directly accessible.
+///
+/// @see BeginLoadSubData(), GetSubDataSize()
+const void* Resource::MapSubData( uint32_t subDataIndex, size_t& rSize ) const
+{
+    CacheManager& rCacheManager = CacheManager::GetStaticInstance();
+
+#if HELIUM_TOOLS
+    // Check for in-memory data first.
+    Cache::EPlatform platform = rCacheManager.GetCurrentPlatform();
+    const PreprocessedData& rPreprocessedData = GetPreprocessedData( platform );
+    if( rPreprocessedData.bLoaded )
+    {
+        const DynamicArray< DynamicArray< uint8_t > >& rSubDataBuffers = rPreprocessedData.subDataBuffers;
+        if( subDataIndex >= rSubDataBuffers.GetSize() )
+        {
+            return NULL;
+        }
+
+        const DynamicArray< uint8_t >& rSubData = rSubDataBuffers[ subDataIndex ];
+        rSize = rSubData.GetSize();
+
+        return rSubData.GetData();
+    }
+#endif
+
+    Name cacheName = GetCacheName();
+    HELIUM_ASSERT( !cacheName.IsEmpty() );
+
+    Cache* pCache = rCacheManager.GetCache( cacheName );
+    HELIUM_ASSERT( pCache );
+    pCache->EnforceTocLoad();
+    if( !pCache->IsCacheFileMapped() )
+    {
+        return NULL;
+    }
+
+    GameObjectPath resourcePath = GetPath();
+    const Cache::Entry* pCacheEntry = pCache->FindEntry( resourcePath, subDataIndex );
+    if( !pCacheEntry )
+    {
+        return NULL;
+    }
+
+    const uint8_t* pMappedData = pCache->GetMappedEntryData( *pCacheEntry );
+    if( pMappedData )
+    {
+        rSize = pCacheEntry->size;
+    }
+
+    return pMappedData;
+}
+
 /// Test for completion of an asynchronous sub-data load request.
 ///
 /// @param[in] loadId  ID associated with the load request.
@@ -158,13 +278,12 @@ bool Resource::TryFinishLoadSubData( size_t loadId )
 {
     HELIUM_ASSERT( IsValid( loadId ) );
 
-#if HELIUM_TOOLS
-    // If the load request was an in-memory request, we don't need to sync as they are performed immediately.
+    // If the load request was an in-memory or memory-mapped request, we don't need to sync as they are performed
+    // immediately.
     if( loadId == static_cast< size_t >( -2 ) )
     {
         return true;
     }
-#endif
 
     // Check the async load request.
     AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
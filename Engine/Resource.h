@@ -63,6 +63,12 @@ namespace Helium
         virtual Name GetCacheName() const;
         //@}
 
+        /// @name Resource Residency
+        //@{
+        virtual size_t GetResidentResourceDataSize() const;
+        virtual bool EvictResourceData();
+        //@}
+
 #if HELIUM_TOOLS
         /// @name Editor Support
         //@{
@@ -77,13 +83,21 @@ namespace Helium
         size_t GetSubDataSize( uint32_t subDataIndex ) const;
         size_t BeginLoadSubData( void* pBuffer, uint32_t subDataIndex, size_t loadSizeMax = Invalid< size_t >() );
         bool TryFinishLoadSubData( size_t loadId );
+
+        const void* MapSubData( uint32_t subDataIndex, size_t& rSize ) const;
+        size_t GetTotalSubDataSize( uint32_t subDataCount ) const;
         //@}
 
     private:
+        friend class ResidencyManager;
+
 #if HELIUM_TOOLS
         /// In-memory preprocessed resource data for each platform.
         PreprocessedData m_preprocessedData[ Cache::PLATFORM_MAX ];
 #endif
+
+        /// Index of the entry for this resource in the ResidencyManager (invalid if not tracked).
+        size_t m_residencyIndex;
     };
 }
 
@@ -62,6 +62,102 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
+    //@}
+
+private:
+    Parameters m_parameters;
+};
+
+/// Least-significant-digit radix sort of 64-bit keys and their associated 32-bit values.
+class HELIUM_ENGINE_JOBS_API RadixSortJob : Helium::NonCopyable
+{
+public:
+    class Parameters
+    {
+    public:
+        /// [inout] Pointer to the first key to sort.
+        uint64_t* pKeys;
+        /// [inout] Pointer to the first value to sort (values are reordered along with their keys).
+        uint32_t* pValues;
+        /// [in] Scratch buffer with space for the number of keys being sorted.
+        uint64_t* pScratchKeys;
+        /// [in] Scratch buffer with space for the number of values being sorted.
+        uint32_t* pScratchValues;
+        /// [in] Number of keys and values to sort.
+        size_t count;
+
+        /// @name Construction/Destruction
+        //@{
+        inline Parameters();
+        //@}
+    };
+
+    /// @name Construction/Destruction
+    //@{
+    inline RadixSortJob();
+    inline ~RadixSortJob();
+    //@}
+
+    /// @name Parameters
+    //@{
+    inline Parameters& GetParameters();
+    inline const Parameters& GetParameters() const;
+    inline void SetParameters( const Parameters& rParameters );
+    //@}
+
+    /// @name Job Execution
+    //@{
+    void Run( JobContext* pContext );
+    inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
+    //@}
+
+private:
+    Parameters m_parameters;
+};
+
+/// Work loop that calls a function for each index in a range, claiming indices from a counter shared between jobs.
+class HELIUM_ENGINE_JOBS_API ParallelForJob : Helium::NonCopyable
+{
+public:
+    class Parameters
+    {
+    public:
+        /// [in] Function to call for each claimed index.
+        PARALLEL_FOR_FUNC pFunction;
+        /// [in] User data to pass to the function.
+        void* pUserData;
+        /// [in] Number of indices in the range.
+        size_t count;
+        /// [in] Counter shared between all jobs working on the same range from which the next index is claimed (null
+        ///      to process all indices in order within this job).
+        volatile int32_t* pNextIndex;
+
+        /// @name Construction/Destruction
+        //@{
+        inline Parameters();
+        //@}
+    };
+
+    /// @name Construction/Destruction
+    //@{
+    inline ParallelForJob();
+    inline ~ParallelForJob();
+    //@}
+
+    /// @name Parameters
+    //@{
+    inline Parameters& GetParameters();
+    inline const Parameters& GetParameters() const;
+    inline void SetParameters( const Parameters& rParameters );
+    //@}
+
+    /// @name Job Execution
+    //@{
+    void Run( JobContext* pContext );
+    inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
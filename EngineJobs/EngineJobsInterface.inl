@@ -65,6 +65,15 @@ void SortJob< T, CompareFunction >::RunCallback( void* pJob, JobContext* pContex
     static_cast< SortJob* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+template< typename T, typename CompareFunction >
+const char* SortJob< T, CompareFunction >::GetTypeName()
+{
+    return "SortJob";
+}
+
 /// Constructor.
 template< typename T, typename CompareFunction >
 SortJob< T, CompareFunction >::Parameters::Parameters()
@@ -72,5 +81,134 @@ SortJob< T, CompareFunction >::Parameters::Parameters()
 {
 }
 
+/// Constructor.
+RadixSortJob::RadixSortJob()
+{
+}
+
+/// Destructor.
+RadixSortJob::~RadixSortJob()
+{
+}
+
+/// Get the parameters for this job.
+///
+/// @return  Reference to the structure containing the job parameters.
+///
+/// @see SetParameters()
+RadixSortJob::Parameters& RadixSortJob::GetParameters()
+{
+    return m_parameters;
+}
+
+/// Get the parameters for this job.
+///
+/// @return  Constant reference to the structure containing the job parameters.
+///
+/// @see SetParameters()
+const RadixSortJob::Parameters& RadixSortJob::GetParameters() const
+{
+    return m_parameters;
+}
+
+/// Set the job parameters.
+///
+/// @param[in] rParameters  Structure containing the job parameters.
+///
+/// @see GetParameters()
+void RadixSortJob::SetParameters( const Parameters& rParameters )
+{
+    m_parameters = rParameters;
+}
+
+/// Callback executed to run the job.
+///
+/// @param[in] pJob      Job to run.
+/// @param[in] pContext  Context associated with the running job instance.
+void RadixSortJob::RunCallback( void* pJob, JobContext* pContext )
+{
+    HELIUM_ASSERT( pJob );
+    HELIUM_ASSERT( pContext );
+    static_cast< RadixSortJob* >( pJob )->Run( pContext );
+}
+
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* RadixSortJob::GetTypeName()
+{
+    return "RadixSortJob";
+}
+
+/// Constructor.
+RadixSortJob::Parameters::Parameters()
+{
+}
+
+/// Constructor.
+ParallelForJob::ParallelForJob()
+{
+}
+
+/// Destructor.
+ParallelForJob::~ParallelForJob()
+{
+}
+
+/// Get the parameters for this job.
+///
+/// @return  Reference to the structure containing the job parameters.
+///
+/// @see SetParameters()
+ParallelForJob::Parameters& ParallelForJob::GetParameters()
+{
+    return m_parameters;
+}
+
+/// Get the parameters for this job.
+///
+/// @return  Constant reference to the structure containing the job parameters.
+///
+/// @see SetParameters()
+const ParallelForJob::Parameters& ParallelForJob::GetParameters() const
+{
+    return m_parameters;
+}
+
+/// Set the job parameters.
+///
+/// @param[in] rParameters  Structure containing the job parameters.
+///
+/// @see GetParameters()
+void ParallelForJob::SetParameters( const Parameters& rParameters )
+{
+    m_parameters = rParameters;
+}
+
+/// Callback executed to run the job.
+///
+/// @param[in] pJob      Job to run.
+/// @param[in] pContext  Context associated with the running job instance.
+void ParallelForJob::RunCallback( void* pJob, JobContext* pContext )
+{
+    HELIUM_ASSERT( pJob );
+    HELIUM_ASSERT( pContext );
+    static_cast< ParallelForJob* >( pJob )->Run( pContext );
+}
+
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* ParallelForJob::GetTypeName()
+{
+    return "ParallelForJob";
+}
+
+/// Constructor.
+ParallelForJob::Parameters::Parameters()
+    : pNextIndex(NULL)
+{
+}
+
 }  // namespace Helium
 
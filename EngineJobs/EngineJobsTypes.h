@@ -28,6 +28,12 @@ namespace Helium
     /// @param[in] pElement0  First element to swap.
     /// @param[in] pElement1  Second element to swap.
     typedef void ( *SORT_SWAP_FUNC )( void* pElement0, void* pElement1 );
+
+    /// Per-index work function for ParallelForJob.
+    ///
+    /// @param[in] pUserData  User data provided to the job.
+    /// @param[in] index      Index of the work item to process.
+    typedef void ( *PARALLEL_FOR_FUNC )( void* pUserData, size_t index );
 }
 
 #endif  // HELIUM_ENGINE_JOBS_ENGINE_JOBS_TYPES_H
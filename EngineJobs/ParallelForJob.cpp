@@ -0,0 +1,58 @@
+//----------------------------------------------------------------------------------------------------------------------
+// ParallelForJob.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "EngineJobsPch.h"
+#include "EngineJobs/EngineJobsInterface.h"
+
+#include "Platform/Atomic.h"
+#include "Engine/JobContext.h"
+#include "Engine/JobManager.h"
+
+using namespace Helium;
+
+/// Call the work function for each index claimed from the shared counter.
+///
+/// Work items with widely varying costs are balanced between jobs by having each job claim the next available index as
+/// it finishes the previous one, rather than splitting the range evenly up front.  Multiple jobs sharing the same
+/// counter should be spawned to process a range in parallel.
+///
+/// @param[in] pContext  Context in which this job is running.
+void ParallelForJob::Run( JobContext* /*pContext*/ )
+{
+    PARALLEL_FOR_FUNC pFunction = m_parameters.pFunction;
+    HELIUM_ASSERT( pFunction );
+
+    void* pUserData = m_parameters.pUserData;
+    size_t count = m_parameters.count;
+
+    volatile int32_t* pNextIndex = m_parameters.pNextIndex;
+    if( pNextIndex )
+    {
+        HELIUM_ASSERT( count <= static_cast< size_t >( INT32_MAX ) );
+
+        for( ; ; )
+        {
+            size_t index = static_cast< size_t >( AtomicIncrement( *pNextIndex ) - 1 );
+            if( index >= count )
+            {
+                break;
+            }
+
+            pFunction( pUserData, index );
+        }
+    }
+    else
+    {
+        for( size_t index = 0; index < count; ++index )
+        {
+            pFunction( pUserData, index );
+        }
+    }
+
+    JobManager& rJobManager = JobManager::GetStaticInstance();
+    rJobManager.ReleaseJob( this );
+}
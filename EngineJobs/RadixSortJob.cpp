@@ -0,0 +1,106 @@
+//----------------------------------------------------------------------------------------------------------------------
+// RadixSortJob.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "EngineJobsPch.h"
+#include "EngineJobs/EngineJobsInterface.h"
+
+#include "Engine/JobContext.h"
+#include "Engine/JobManager.h"
+
+/// Number of key bits sorted in each radix sort pass.
+#define RADIX_SORT_DIGIT_BITS 8
+/// Number of buckets for each radix sort digit.
+#define RADIX_SORT_BUCKET_COUNT ( 1 << RADIX_SORT_DIGIT_BITS )
+/// Number of radix sort digits in each key.
+#define RADIX_SORT_DIGIT_COUNT ( 64 / RADIX_SORT_DIGIT_BITS )
+
+using namespace Helium;
+
+/// Sort an array of keys and values.
+///
+/// Each pass performs a stable counting sort on one digit of the keys, starting from the least significant digit.
+/// Digit histograms for all passes are gathered in a single pass over the keys up front, and passes for digits
+/// shared by all keys are skipped, as they would not change the order of the keys.
+///
+/// @param[in] pContext  Context in which this job is running.
+void RadixSortJob::Run( JobContext* /*pContext*/ )
+{
+    size_t count = m_parameters.count;
+    if( count > 1 )
+    {
+        uint64_t* pKeys = m_parameters.pKeys;
+        HELIUM_ASSERT( pKeys );
+        uint32_t* pValues = m_parameters.pValues;
+        HELIUM_ASSERT( pValues );
+
+        uint64_t* pScratchKeys = m_parameters.pScratchKeys;
+        HELIUM_ASSERT( pScratchKeys );
+        uint32_t* pScratchValues = m_parameters.pScratchValues;
+        HELIUM_ASSERT( pScratchValues );
+
+        HELIUM_ASSERT( static_cast< uint32_t >( count ) == count );
+
+        uint32_t histograms[ RADIX_SORT_DIGIT_COUNT ][ RADIX_SORT_BUCKET_COUNT ];
+        MemoryZero( histograms, sizeof( histograms ) );
+
+        for( size_t keyIndex = 0; keyIndex < count; ++keyIndex )
+        {
+            uint64_t key = pKeys[ keyIndex ];
+            for( size_t digitIndex = 0; digitIndex < RADIX_SORT_DIGIT_COUNT; ++digitIndex )
+            {
+                ++histograms[ digitIndex ][ ( key >> ( digitIndex * RADIX_SORT_DIGIT_BITS ) ) &
+                                            ( RADIX_SORT_BUCKET_COUNT - 1 ) ];
+            }
+        }
+
+        uint64_t* pSourceKeys = pKeys;
+        uint32_t* pSourceValues = pValues;
+        uint64_t* pDestKeys = pScratchKeys;
+        uint32_t* pDestValues = pScratchValues;
+
+        for( size_t digitIndex = 0; digitIndex < RADIX_SORT_DIGIT_COUNT; ++digitIndex )
+        {
+            size_t shift = digitIndex * RADIX_SORT_DIGIT_BITS;
+            uint32_t* pOffsets = histograms[ digitIndex ];
+
+            if( pOffsets[ ( pSourceKeys[ 0 ] >> shift ) & ( RADIX_SORT_BUCKET_COUNT - 1 ) ] == count )
+            {
+                continue;
+            }
+
+            // Convert the digit counts to output offsets.
+            uint32_t offset = 0;
+            for( size_t bucketIndex = 0; bucketIndex < RADIX_SORT_BUCKET_COUNT; ++bucketIndex )
+            {
+                uint32_t bucketCount = pOffsets[ bucketIndex ];
+                pOffsets[ bucketIndex ] = offset;
+                offset += bucketCount;
+            }
+
+            for( size_t keyIndex = 0; keyIndex < count; ++keyIndex )
+            {
+                uint64_t key = pSourceKeys[ keyIndex ];
+                uint32_t destIndex = pOffsets[ ( key >> shift ) & ( RADIX_SORT_BUCKET_COUNT - 1 ) ]++;
+                pDestKeys[ destIndex ] = key;
+                pDestValues[ destIndex ] = pSourceValues[ keyIndex ];
+            }
+
+            Swap( pSourceKeys, pDestKeys );
+            Swap( pSourceValues, pDestValues );
+        }
+
+        // Copy the results back if an odd number of passes left them in the scratch buffers.
+        if( pSourceKeys != pKeys )
+        {
+            MemoryCopy( pKeys, pSourceKeys, count * sizeof( uint64_t ) );
+            MemoryCopy( pValues, pSourceValues, count * sizeof( uint32_t ) );
+        }
+    }
+
+    JobManager& rJobManager = JobManager::GetStaticInstance();
+    rJobManager.ReleaseJob( this );
+}
@@ -10,6 +10,7 @@
 
 #include "Engine/JobManager.h"
 #include "Framework/Entity.h"
+#include "Framework/Layer.h"
 #include "Framework/WorldManager.h"
 
 using namespace Helium;
@@ -17,23 +18,37 @@ using namespace Helium;
 /// Run the EntityPreUpdate job.
 ///
 /// @param[in] pContext  Context in which this job is running.
-void EntityPreUpdate::Run( JobContext* /*pContext*/ )
+void EntityPreUpdate::Run( JobContext* pContext )
 {
-    Entity* pEntity = m_parameters.pEntity;
-    HELIUM_ASSERT( pEntity );
-    HELIUM_ASSERT( pEntity->NeedsAsynchronousUpdate() );
+    Layer* pLayer = m_parameters.pLayer;
+    HELIUM_ASSERT( pLayer );
+
+    size_t startEntityIndex = m_parameters.startEntityIndex;
+    size_t entityCount = SplitEntityUpdateRange< EntityPreUpdate >( pContext, m_parameters );
+    HELIUM_ASSERT( startEntityIndex + entityCount <= pLayer->GetEntityCount() );
 
     WorldManager& rWorldManager = WorldManager::GetStaticInstance();
+    float32_t frameDeltaSeconds = rWorldManager.GetFrameDeltaSeconds();
+
+    size_t endEntityIndex = startEntityIndex + entityCount;
+    for( size_t entityIndex = startEntityIndex; entityIndex < endEntityIndex; ++entityIndex )
+    {
+        Entity* pEntity = pLayer->GetEntity( entityIndex );
+        HELIUM_ASSERT( pEntity );
 
 #if HELIUM_ENABLE_WORLD_UPDATE_SAFETY_CHECKING
-    rWorldManager.SetCurrentThreadUpdateEntity( pEntity );
+        rWorldManager.SetCurrentThreadUpdateEntity( pEntity );
 #endif
 
-    pEntity->PreUpdate( rWorldManager.GetFrameDeltaSeconds() );
+        if( pEntity->NeedsAsynchronousUpdate() )
+        {
+            pEntity->PreUpdate( frameDeltaSeconds );
+        }
 
 #if HELIUM_ENABLE_WORLD_UPDATE_SAFETY_CHECKING
-    rWorldManager.SetCurrentThreadUpdateEntity( NULL );
+        rWorldManager.SetCurrentThreadUpdateEntity( NULL );
 #endif
+    }
 
     JobManager& rJobManager = JobManager::GetStaticInstance();
     rJobManager.ReleaseJob( this );
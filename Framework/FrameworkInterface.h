@@ -20,6 +20,7 @@ namespace Helium
 namespace Helium
 {
     class Entity;
+    class Layer;
     class World;
     typedef Helium::StrongPtr< World > WorldPtr;
     typedef Helium::StrongPtr< const World > ConstWorldPtr;
@@ -42,8 +43,6 @@ public:
         size_t worldCount;
         /// [in] Index of the layer from which to start spawning update jobs.
         size_t startLayerIndex;
-        /// [in] Index of the entity from which to start spawning update jobs.
-        size_t startEntityIndex;
 
         /// @name Construction/Destruction
         //@{
@@ -68,21 +67,28 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
     Parameters m_parameters;
 };
 
-/// Read-only entity update (entity can only read data, can access other entities).
+/// Read-only entity range update (entities can only read data, can access other entities).
 class HELIUM_FRAMEWORK_API EntityPreUpdate : Helium::NonCopyable
 {
 public:
     class Parameters
     {
     public:
-        /// [in] Entity to update.
-        Entity* pEntity;
+        /// [in] Layer containing the entities to update.
+        Layer* pLayer;
+        /// [in] Index of the first entity in the range to update.
+        size_t startEntityIndex;
+        /// [in] Number of entities in the range to update.
+        size_t entityCount;
+        /// [in] Maximum number of entities to update without splitting the range into child jobs.
+        size_t grainSize;
 
         /// @name Construction/Destruction
         //@{
@@ -107,21 +113,28 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
     Parameters m_parameters;
 };
 
-/// Entity resolve update (entity can only read and write its own data, cannot access other entities).
+/// Entity range resolve update (entities can only read and write their own data, cannot access other entities).
 class HELIUM_FRAMEWORK_API EntityPostUpdate : Helium::NonCopyable
 {
 public:
     class Parameters
     {
     public:
-        /// [in] Entity to update.
-        Entity* pEntity;
+        /// [in] Layer containing the entities to update.
+        Layer* pLayer;
+        /// [in] Index of the first entity in the range to update.
+        size_t startEntityIndex;
+        /// [in] Number of entities in the range to update.
+        size_t entityCount;
+        /// [in] Maximum number of entities to update without splitting the range into child jobs.
+        size_t grainSize;
 
         /// @name Construction/Destruction
         //@{
@@ -146,6 +159,7 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
@@ -65,11 +65,19 @@ void WorldManagerUpdate< EntityUpdateJobType >::RunCallback( void* pJob, JobCont
     static_cast< WorldManagerUpdate* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+template< typename EntityUpdateJobType >
+const char* WorldManagerUpdate< EntityUpdateJobType >::GetTypeName()
+{
+    return "WorldManagerUpdate";
+}
+
 /// Constructor.
 template< typename EntityUpdateJobType >
 WorldManagerUpdate< EntityUpdateJobType >::Parameters::Parameters()
     : startLayerIndex(0)
-    , startEntityIndex(0)
 {
 }
 
@@ -124,6 +132,14 @@ void EntityPreUpdate::RunCallback( void* pJob, JobContext* pContext )
     static_cast< EntityPreUpdate* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* EntityPreUpdate::GetTypeName()
+{
+    return "EntityPreUpdate";
+}
+
 /// Constructor.
 EntityPreUpdate::Parameters::Parameters()
 {
@@ -180,6 +196,14 @@ void EntityPostUpdate::RunCallback( void* pJob, JobContext* pContext )
     static_cast< EntityPostUpdate* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* EntityPostUpdate::GetTypeName()
+{
+    return "EntityPostUpdate";
+}
+
 /// Constructor.
 EntityPostUpdate::Parameters::Parameters()
 {
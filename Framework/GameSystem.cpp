@@ -16,6 +16,7 @@
 #include "Engine/Config.h"
 #include "Engine/JobManager.h"
 #include "Engine/CacheManager.h"
+#include "Engine/ResidencyManager.h"
 #include "Windowing/WindowManager.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/RSurface.h"
@@ -98,8 +99,29 @@ bool GameSystem::Initialize(
 #endif
 
 
-    // Initialize the async loading thread.
-    bool bAsyncLoaderInitSuccess = AsyncLoader::GetStaticInstance().Initialize();
+    // Initialize the async loading thread, using the backend specified on the command line if any
+    // ("-asyncbackend <name>").
+    AsyncLoader::EBackend asyncLoaderBackend = AsyncLoader::BACKEND_STREAM;
+    for( size_t argumentIndex = 0; argumentIndex + 1 < m_arguments.GetSize(); ++argumentIndex )
+    {
+        if( CompareString( *m_arguments[ argumentIndex ], TXT( "-asyncbackend" ) ) == 0 )
+        {
+            const tchar_t* pBackendName = *m_arguments[ argumentIndex + 1 ];
+            asyncLoaderBackend = AsyncLoader::FindBackend( pBackendName );
+            if( asyncLoaderBackend == AsyncLoader::BACKEND_INVALID )
+            {
+                HELIUM_TRACE(
+                    TraceLevels::Warning,
+                    TXT( "GameSystem::Initialize(): Unknown async loader backend \"%s\", using file streams.\n" ),
+                    pBackendName );
+                asyncLoaderBackend = AsyncLoader::BACKEND_STREAM;
+            }
+
+            break;
+        }
+    }
+
+    bool bAsyncLoaderInitSuccess = AsyncLoader::GetStaticInstance().Initialize( 0, asyncLoaderBackend );
     HELIUM_ASSERT( bAsyncLoaderInitSuccess );
     if( !bAsyncLoaderInitSuccess )
     {
@@ -313,6 +335,7 @@ bool GameSystem::Initialize(
 /// @see Initialize()
 void GameSystem::Shutdown()
 {
+    ResidencyManager::DestroyStaticInstance();
     WorldManager::DestroyStaticInstance();
     DynamicDrawer::DestroyStaticInstance();
     RenderResourceManager::DestroyStaticInstance();
@@ -0,0 +1,33 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessRendererInitialization.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "FrameworkPch.h"
+#include "Framework/HeadlessRendererInitialization.h"
+
+#include "RenderingHeadless/HeadlessRenderer.h"
+
+using namespace Helium;
+
+/// @copydoc RendererInitialization::Initialize()
+bool HeadlessRendererInitialization::Initialize()
+{
+    if( !HeadlessRenderer::CreateStaticInstance() )
+    {
+        return false;
+    }
+
+    Renderer* pRenderer = HeadlessRenderer::GetStaticInstance();
+    HELIUM_ASSERT( pRenderer );
+    if( !pRenderer->Initialize() )
+    {
+        Renderer::DestroyStaticInstance();
+
+        return false;
+    }
+
+    return true;
+}
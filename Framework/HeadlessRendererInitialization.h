@@ -0,0 +1,27 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessRendererInitialization.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_FRAMEWORK_HEADLESS_RENDERER_INITIALIZATION_H
+#define HELIUM_FRAMEWORK_HEADLESS_RENDERER_INITIALIZATION_H
+
+#include "Framework/RendererInitialization.h"
+
+namespace Helium
+{
+    /// Renderer initializer that creates a headless (recording-only) renderer.
+    class HELIUM_FRAMEWORK_API HeadlessRendererInitialization : public RendererInitialization
+    {
+    public:
+        /// @name Renderer Initialization
+        //@{
+        bool Initialize();
+        //@}
+    };
+}
+
+#endif  // HELIUM_FRAMEWORK_HEADLESS_RENDERER_INITIALIZATION_H
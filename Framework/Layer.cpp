@@ -177,6 +177,111 @@ Entity* Layer::CreateEntity(
     return pEntity;
 }
 
+/// Create a batch of entities of the same type in this layer.
+///
+/// This is much faster than calling CreateEntity() for each entity when creating large numbers of entities, as the
+/// entities are allocated together and registered with the object system in a single step (see
+/// GameObject::CreateObjects()).  All entities are given the same name with automatically assigned instance indices.
+///
+/// @param[in]  pType        Type of entities to create.
+/// @param[in]  entityCount  Number of entities to create.
+/// @param[in]  pPositions   Array of entity positions, or null to place all entities at the origin.
+/// @param[in]  pRotations   Array of entity rotations, or null to use the identity rotation for all entities.
+/// @param[in]  pScales      Array of entity scales, or null to use a uniform scale of one for all entities.
+/// @param[in]  pTemplate    Template to use for the entities, or null to use the default template for the type.
+/// @param[in]  name         Entity name.  If empty, the type name will be used.
+/// @param[out] ppEntities   Optional array in which to store the created entities.
+///
+/// @return  True if the entities were created successfully, false if not.
+///
+/// @see CreateEntity(), DestroyEntity()
+bool Layer::CreateEntities(
+    const GameObjectType* pType,
+    size_t entityCount,
+    const Simd::Vector3* pPositions,
+    const Simd::Quat* pRotations,
+    const Simd::Vector3* pScales,
+    Entity* pTemplate,
+    Name name,
+    Entity** ppEntities )
+{
+    HELIUM_ASSERT( m_spPackage );
+    if( !m_spPackage )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Layer::CreateEntities(): Layer \"%s\" is not bound to a package.\n" ),
+            *GetPath().ToString() );
+
+        return false;
+    }
+
+    HELIUM_ASSERT( pType );
+    if( !pType )
+    {
+        HELIUM_TRACE( TraceLevels::Error, TXT( "Layer::CreateEntities(): No entity type specified.\n" ) );
+
+        return false;
+    }
+
+    bool bIsEntityType = pType->GetClass()->IsType( Entity::GetStaticType()->GetClass() );
+    HELIUM_ASSERT( bIsEntityType );
+    if( !bIsEntityType )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "Layer::CreateEntities(): GameObjectType \"%s\" specified is not an entity type.\n" ),
+            *pType->GetName() );
+
+        return false;
+    }
+
+    if( name.IsEmpty() )
+    {
+        name = pType->GetName();
+    }
+
+    DynamicArray< GameObjectPtr > spObjects;
+    spObjects.Resize( entityCount );
+    if( !GameObject::CreateObjects( spObjects.GetData(), entityCount, pType, name, m_spPackage, pTemplate ) )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            ( TXT( "Layer::CreateEntities(): Failed to create %" ) TPRIuSZ TXT( " entities \"%s\" of type \"%s\" " )
+              TXT( "in layer package \"%s\" (template: %s).\n" ) ),
+            entityCount,
+            *name,
+            *pType->GetName(),
+            *m_spPackage->GetPath().ToString(),
+            ( pTemplate ? *pTemplate->GetPath().ToString() : TXT( "none" ) ) );
+
+        return false;
+    }
+
+    m_entities.Reserve( m_entities.GetSize() + entityCount );
+
+    for( size_t entityIndex = 0; entityIndex < entityCount; ++entityIndex )
+    {
+        Entity* pEntity = Reflect::AssertCast< Entity >( spObjects[ entityIndex ].Get() );
+        HELIUM_ASSERT( pEntity );
+
+        pEntity->SetPosition( pPositions ? pPositions[ entityIndex ] : Simd::Vector3( 0.0f ) );
+        pEntity->SetRotation( pRotations ? pRotations[ entityIndex ] : Simd::Quat::IDENTITY );
+        pEntity->SetScale( pScales ? pScales[ entityIndex ] : Simd::Vector3( 1.0f ) );
+
+        size_t layerIndex = m_entities.Push( pEntity );
+        HELIUM_ASSERT( IsValid( layerIndex ) );
+        pEntity->SetLayerInfo( this, layerIndex );
+
+        if( ppEntities )
+        {
+            ppEntities[ entityIndex ] = pEntity;
+        }
+    }
+
+    return true;
+}
+
 /// Destroy an entity in this layer.
 ///
 /// @param[in] pEntity  Entity to destroy.
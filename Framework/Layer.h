@@ -63,6 +63,10 @@ namespace Helium
             const GameObjectType* pType, const Simd::Vector3& rPosition = Simd::Vector3( 0.0f ),
             const Simd::Quat& rRotation = Simd::Quat::IDENTITY, const Simd::Vector3& rScale = Simd::Vector3( 1.0f ),
             Entity* pTemplate = NULL, Name name = NULL_NAME, bool bAssignInstanceIndex = true );
+        virtual bool CreateEntities(
+            const GameObjectType* pType, size_t entityCount, const Simd::Vector3* pPositions = NULL,
+            const Simd::Quat* pRotations = NULL, const Simd::Vector3* pScales = NULL, Entity* pTemplate = NULL,
+            Name name = NULL_NAME, Entity** ppEntities = NULL );
         virtual bool DestroyEntity( Entity* pEntity );
         //@}
 
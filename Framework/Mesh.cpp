@@ -335,6 +335,52 @@ Name Mesh::GetCacheName() const
     return cacheName;
 }
 
+/// @copydoc Resource::GetResidentResourceDataSize()
+size_t Mesh::GetResidentResourceDataSize() const
+{
+    size_t residentSize = 0;
+
+    if( m_spVertexBuffer )
+    {
+        size_t vertexDataSize = GetSubDataSize( 0 );
+        if( IsValid( vertexDataSize ) )
+        {
+            residentSize += vertexDataSize;
+        }
+    }
+
+    if( m_spIndexBuffer )
+    {
+        size_t indexDataSize = GetSubDataSize( 1 );
+        if( IsValid( indexDataSize ) )
+        {
+            residentSize += indexDataSize;
+        }
+    }
+
+    return residentSize;
+}
+
+/// @copydoc Resource::EvictResourceData()
+bool Mesh::EvictResourceData()
+{
+    if( IsValid( m_vertexBufferLoadId ) || IsValid( m_indexBufferLoadId ) )
+    {
+        return false;
+    }
+
+    if( !m_spVertexBuffer && !m_spIndexBuffer )
+    {
+        return false;
+    }
+
+    // The buffers are recreated from the cached sub-data when the mesh is precached again.
+    m_spVertexBuffer.Release();
+    m_spIndexBuffer.Release();
+
+    return true;
+}
+
 
 /// Get the GPU skinning palette map for a specific mesh section.
 ///
@@ -114,6 +114,12 @@ namespace Helium
         virtual Name GetCacheName() const;
         //@}
 
+        /// @name Resource Residency
+        //@{
+        virtual size_t GetResidentResourceDataSize() const;
+        virtual bool EvictResourceData();
+        //@}
+
         /// @name Data Access
         //@{
         inline size_t GetSectionCount() const;
@@ -10,6 +10,8 @@
 
 #include "Platform/Timer.h"
 #include "Engine/JobContext.h"
+#include "Engine/JobProfiler.h"
+#include "Engine/ResidencyManager.h"
 #include "Framework/FrameworkInterface.h"
 #include "Framework/Layer.h"
 
@@ -26,6 +28,7 @@ WorldManager::WorldManager()
 , m_updatePhase( UPDATE_PHASE_INVALID )
 , m_bProcessedFirstFrame( false )
 {
+    MemoryZero( m_updatePhaseTickCounts, sizeof( m_updatePhaseTickCounts ) );
 }
 
 /// Destructor.
@@ -199,11 +202,17 @@ World* WorldManager::CreateDefaultWorld( const GameObjectType* pType )
 /// Update all worlds for the current frame.
 void WorldManager::Update()
 {
+#if HELIUM_PROFILE_JOBS
+    // Mark the start of a new frame in any job profiler captures.
+    JobProfiler::MarkFrame();
+#endif
+
     // Update the world time.
     UpdateTime();
 
     // Perform the entity pre-update.
     m_updatePhase = UPDATE_PHASE_PRE;
+    uint64_t phaseStartTickCount = Timer::GetTickCount();
     {
         JobContext::Spawner< 1 > entityUpdateSpawner;
         JobContext* pContext = entityUpdateSpawner.Allocate();
@@ -215,8 +224,12 @@ void WorldManager::Update()
         rParameters.worldCount = m_worlds.GetSize();
     }
 
+    uint64_t phaseEndTickCount = Timer::GetTickCount();
+    m_updatePhaseTickCounts[ UPDATE_PHASE_PRE ] = phaseEndTickCount - phaseStartTickCount;
+
     // Perform the entity post-update.
     m_updatePhase = UPDATE_PHASE_POST;
+    phaseStartTickCount = phaseEndTickCount;
     {
         JobContext::Spawner< 1 > entityUpdateSpawner;
         JobContext* pContext = entityUpdateSpawner.Allocate();
@@ -228,8 +241,12 @@ void WorldManager::Update()
         rParameters.worldCount = m_worlds.GetSize();
     }
 
+    phaseEndTickCount = Timer::GetTickCount();
+    m_updatePhaseTickCounts[ UPDATE_PHASE_POST ] = phaseEndTickCount - phaseStartTickCount;
+
     // Perform the entity synchronous update.
     m_updatePhase = UPDATE_PHASE_SYNCHRONOUS;
+    phaseStartTickCount = phaseEndTickCount;
 
     size_t worldCount = m_worlds.GetSize();
     for( size_t worldIndex = 0; worldIndex < worldCount; ++worldIndex )
@@ -308,6 +325,7 @@ void WorldManager::Update()
         }
     }
 
+    m_updatePhaseTickCounts[ UPDATE_PHASE_SYNCHRONOUS ] = Timer::GetTickCount() - phaseStartTickCount;
     m_updatePhase = UPDATE_PHASE_INVALID;
 
     // Update the graphics scene for each world.
@@ -317,6 +335,13 @@ void WorldManager::Update()
         HELIUM_ASSERT( pWorld );
         pWorld->UpdateGraphicsScene();
     }
+
+    // Update resource residency once all entities have been updated for the frame.
+    ResidencyManager* pResidencyManager = ResidencyManager::GetStaticInstance();
+    if( pResidencyManager )
+    {
+        pResidencyManager->Tick();
+    }
 }
 
 /// Get the singleton WorldManager instance, creating it if necessary.
@@ -69,6 +69,8 @@ namespace Helium
         inline uint64_t GetFrameTickCount() const;
         inline uint64_t GetFrameDeltaTickCount() const;
         inline float32_t GetFrameDeltaSeconds() const;
+
+        inline uint64_t GetUpdatePhaseTickCount( EUpdatePhase phase ) const;
         //@}
 
         /// @name Data Access
@@ -103,6 +105,8 @@ namespace Helium
 
         /// Current world update phase.
         EUpdatePhase m_updatePhase;
+        /// Actual number of ticks spent in each update phase during the most recent frame.
+        uint64_t m_updatePhaseTickCounts[ UPDATE_PHASE_MAX ];
 
 #if HELIUM_ENABLE_WORLD_UPDATE_SAFETY_CHECKING
         /// Thread-local storage for the entity currently being updated on a given thread.
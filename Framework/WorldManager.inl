@@ -43,6 +43,23 @@ namespace Helium
         return m_frameDeltaSeconds;
     }
 
+    /// Get the actual number of timer ticks spent running a given entity update phase during the most recent frame.
+    ///
+    /// Ticks are expressed in units determined by the Timer class.  Conversion between ticks and seconds can be
+    /// performed using Timer::GetTicksPerSecond() and Timer::GetSecondsPerTick().
+    ///
+    /// @param[in] phase  Update phase.
+    ///
+    /// @return  Timer ticks spent in the given update phase.
+    ///
+    /// @see GetUpdatePhase()
+    uint64_t WorldManager::GetUpdatePhaseTickCount( EUpdatePhase phase ) const
+    {
+        HELIUM_ASSERT( static_cast< size_t >( phase ) < static_cast< size_t >( UPDATE_PHASE_MAX ) );
+
+        return m_updatePhaseTickCounts[ phase ];
+    }
+
     /// Get the current entity update phase.
     ///
     /// @return  Current entity update phase.
@@ -7,27 +7,32 @@
 
 namespace Helium
 {
-    /// Maximum number of child jobs that can be spawned at once.
-    static const size_t CHILD_JOB_COUNT_MAX = 1024;
+    /// Maximum number of layer update jobs that can be spawned at once.
+    static const size_t CHILD_JOB_COUNT_MAX = 64;
+    /// Maximum number of child jobs an entity range update job can split off at once.
+    static const size_t ENTITY_RANGE_SPLIT_COUNT_MAX = 16;
+    /// Number of ranges into which each layer's entities should be split (where possible) for updating in parallel.
+    static const size_t ENTITY_RANGE_COUNT_TARGET = 64;
+    /// Minimum number of entities to update in a single range job.
+    static const size_t ENTITY_RANGE_GRAIN_SIZE_MIN = 64;
 
     /// Run the WorldManagerUpdate job.
     ///
+    /// One entity update job is spawned for the entire entity array of each layer.  Each of those jobs recursively
+    /// splits its range of entities into child jobs until the ranges are no larger than a grain size picked based on
+    /// the number of entities in the layer.
+    ///
     /// @param[in] pContext  Context in which this job is running.
     template< typename EntityUpdateJobType >
     void WorldManagerUpdate< EntityUpdateJobType >::Run( JobContext* pContext )
     {
         HELIUM_ASSERT( pContext );
 
-#if HELIUM_ENABLE_WORLD_UPDATE_SAFETY_CHECKING
-        WorldManager& rWorldManager = WorldManager::GetStaticInstance();
-#endif
-
         JobContext::Spawner< CHILD_JOB_COUNT_MAX > spawner( pContext );
 
         size_t childJobCount = 0;
 
         size_t startLayerIndex = m_parameters.startLayerIndex;
-        size_t startEntityIndex = m_parameters.startEntityIndex;
 
         const WorldPtr* pspWorlds = m_parameters.pspWorlds;
         size_t worldCount = m_parameters.worldCount;
@@ -42,51 +47,47 @@ namespace Helium
                 Layer* pLayer = pWorld->GetLayer( layerIndex );
                 HELIUM_ASSERT( pLayer );
                 size_t entityCount = pLayer->GetEntityCount();
-                for( size_t entityIndex = startEntityIndex; entityIndex < entityCount; ++entityIndex )
+                if( entityCount == 0 )
+                {
+                    continue;
+                }
+
+                // If we've allocated all but one of the available child jobs, continue spawning layer updates in a
+                // child job.
+                if( childJobCount >= CHILD_JOB_COUNT_MAX - 1 )
                 {
-                    Entity* pEntity = pLayer->GetEntity( entityIndex );
-                    HELIUM_ASSERT( pEntity );
-#if HELIUM_ENABLE_WORLD_UPDATE_SAFETY_CHECKING
-                    rWorldManager.SetCurrentThreadUpdateEntity( pEntity );
-#endif
-                    bool bUpdate = pEntity->NeedsAsynchronousUpdate();
-#if HELIUM_ENABLE_WORLD_UPDATE_SAFETY_CHECKING
-                    rWorldManager.SetCurrentThreadUpdateEntity( NULL );
-#endif
-                    if( bUpdate )
-                    {
-                        JobContext* pChildContext = spawner.Allocate();
-                        HELIUM_ASSERT( pChildContext );
-                        EntityUpdateJobType* pChildJob = pChildContext->Create< EntityUpdateJobType >();
-                        HELIUM_ASSERT( pChildJob );
-                        EntityUpdateJobType::Parameters& rParameters = pChildJob->GetParameters();
-                        rParameters.pEntity = pEntity;
-
-                        // If we've allocated the maximum number of entity update jobs for this job, continue spawning
-                        // entity updates in a child job.
-                        ++childJobCount;
-                        HELIUM_ASSERT( childJobCount < CHILD_JOB_COUNT_MAX );
-                        if( childJobCount >= CHILD_JOB_COUNT_MAX + 1 )
-                        {
-                            JobContext* pContinueContext = spawner.Allocate();
-                            HELIUM_ASSERT( pContinueContext );
-                            WorldManagerUpdate* pContinueJob = pContinueContext->Create< WorldManagerUpdate >();
-                            HELIUM_ASSERT( pContinueJob );
-                            WorldManagerUpdate::Parameters& rContinueParameters = pContinueJob->GetParameters();
-                            rContinueParameters.pspWorlds = pspWorlds + worldIndex;
-                            rContinueParameters.worldCount = worldCount - worldIndex;
-                            rContinueParameters.startLayerIndex = layerIndex;
-                            rContinueParameters.startEntityIndex = entityIndex + 1;
-
-                            JobManager& rJobManager = JobManager::GetStaticInstance();
-                            rJobManager.ReleaseJob( this );
-
-                            return;
-                        }
-                    }
+                    JobContext* pContinueContext = spawner.Allocate();
+                    HELIUM_ASSERT( pContinueContext );
+                    WorldManagerUpdate* pContinueJob = pContinueContext->Create< WorldManagerUpdate >();
+                    HELIUM_ASSERT( pContinueJob );
+                    WorldManagerUpdate::Parameters& rContinueParameters = pContinueJob->GetParameters();
+                    rContinueParameters.pspWorlds = pspWorlds + worldIndex;
+                    rContinueParameters.worldCount = worldCount - worldIndex;
+                    rContinueParameters.startLayerIndex = layerIndex;
+
+                    JobManager& rJobManager = JobManager::GetStaticInstance();
+                    rJobManager.ReleaseJob( this );
+
+                    return;
                 }
 
-                startEntityIndex = 0;
+                size_t grainSize = ( entityCount + ENTITY_RANGE_COUNT_TARGET - 1 ) / ENTITY_RANGE_COUNT_TARGET;
+                if( grainSize < ENTITY_RANGE_GRAIN_SIZE_MIN )
+                {
+                    grainSize = ENTITY_RANGE_GRAIN_SIZE_MIN;
+                }
+
+                JobContext* pChildContext = spawner.Allocate();
+                HELIUM_ASSERT( pChildContext );
+                EntityUpdateJobType* pChildJob = pChildContext->Create< EntityUpdateJobType >();
+                HELIUM_ASSERT( pChildJob );
+                typename EntityUpdateJobType::Parameters& rParameters = pChildJob->GetParameters();
+                rParameters.pLayer = pLayer;
+                rParameters.startEntityIndex = 0;
+                rParameters.entityCount = entityCount;
+                rParameters.grainSize = grainSize;
+
+                ++childJobCount;
             }
 
             startLayerIndex = 0;
@@ -95,4 +96,53 @@ namespace Helium
         JobManager& rJobManager = JobManager::GetStaticInstance();
         rJobManager.ReleaseJob( this );
     }
+
+    /// Split off child jobs for an entity range update until the part of the range left is no larger than the grain
+    /// size.
+    ///
+    /// The upper half of the remaining range is repeatedly handed off to a new child job of the same type, which will
+    /// in turn split its own range further once it runs.  The child jobs are spawned before this function returns, so
+    /// they can be stolen by other threads while the calling job updates the range that is left.
+    ///
+    /// @param[in] pContext     Context of the running entity range update job.
+    /// @param[in] rParameters  Parameters of the running entity range update job.
+    ///
+    /// @return  Number of entities, starting from the first entity in the job's range, that the calling job should
+    ///          update itself.
+    template< typename EntityUpdateJobType >
+    size_t SplitEntityUpdateRange( JobContext* pContext, const typename EntityUpdateJobType::Parameters& rParameters )
+    {
+        HELIUM_ASSERT( pContext );
+
+        size_t grainSize = rParameters.grainSize;
+        HELIUM_ASSERT( grainSize != 0 );
+
+        size_t entityCount = rParameters.entityCount;
+        if( entityCount <= grainSize )
+        {
+            return entityCount;
+        }
+
+        JobContext::Spawner< ENTITY_RANGE_SPLIT_COUNT_MAX > spawner( pContext );
+
+        for( size_t splitIndex = 0;
+             splitIndex < ENTITY_RANGE_SPLIT_COUNT_MAX && entityCount > grainSize;
+             ++splitIndex )
+        {
+            size_t splitCount = entityCount / 2;
+            entityCount -= splitCount;
+
+            JobContext* pChildContext = spawner.Allocate();
+            HELIUM_ASSERT( pChildContext );
+            EntityUpdateJobType* pChildJob = pChildContext->Create< EntityUpdateJobType >();
+            HELIUM_ASSERT( pChildJob );
+            typename EntityUpdateJobType::Parameters& rChildParameters = pChildJob->GetParameters();
+            rChildParameters.pLayer = rParameters.pLayer;
+            rChildParameters.startEntityIndex = rParameters.startEntityIndex + entityCount;
+            rChildParameters.entityCount = splitCount;
+            rChildParameters.grainSize = grainSize;
+        }
+
+        return entityCount;
+    }
 }
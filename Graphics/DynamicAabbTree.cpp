@@ -0,0 +1,753 @@
+//----------------------------------------------------------------------------------------------------------------------
+// DynamicAabbTree.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "GraphicsPch.h"
+#include "Graphics/DynamicAabbTree.h"
+
+#include "Engine/JobContext.h"
+#include "EngineJobs/EngineJobsInterface.h"
+
+using namespace Helium;
+
+/// Fraction of the size of an object's bounds along each axis by which to enlarge its leaf box on each side.
+static const float32_t LEAF_MARGIN_SCALE = 0.1f;
+
+/// Constructor.
+DynamicAabbTree::DynamicAabbTree()
+    : m_rootId( Invalid< uint32_t >() )
+    , m_freeListId( Invalid< uint32_t >() )
+    , m_leafCount( 0 )
+{
+}
+
+/// Destructor.
+DynamicAabbTree::~DynamicAabbTree()
+{
+}
+
+/// Insert a leaf for an object into this tree.
+///
+/// @param[in] objectId  ID of the object referenced by the leaf.
+/// @param[in] rBox      Object bounds.
+///
+/// @return  ID of the new leaf node.
+///
+/// @see Remove(), SetBounds()
+uint32_t DynamicAabbTree::Insert( uint32_t objectId, const Simd::AaBox& rBox )
+{
+    uint32_t leafId = AllocateNode();
+
+    Node& rLeaf = m_nodes[ leafId ];
+    rLeaf.objectId = objectId;
+    rLeaf.height = 0;
+    SetInvalid( rLeaf.children[ 0 ] );
+    SetInvalid( rLeaf.children[ 1 ] );
+
+    const Simd::Vector3& rMinimum = rBox.GetMinimum();
+    const Simd::Vector3& rMaximum = rBox.GetMaximum();
+    for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+    {
+        float32_t minimum = rMinimum.GetElement( axisIndex );
+        float32_t maximum = rMaximum.GetElement( axisIndex );
+        float32_t margin = ( maximum - minimum ) * LEAF_MARGIN_SCALE;
+        rLeaf.minimum[ axisIndex ] = minimum - margin;
+        rLeaf.maximum[ axisIndex ] = maximum + margin;
+    }
+
+    InsertLeaf( leafId );
+    ++m_leafCount;
+
+    return leafId;
+}
+
+/// Remove a leaf from this tree.
+///
+/// @param[in] leafId  ID of the leaf node to remove.
+///
+/// @see Insert()
+void DynamicAabbTree::Remove( uint32_t leafId )
+{
+    HELIUM_ASSERT( leafId < m_nodes.GetSize() );
+    HELIUM_ASSERT( m_nodes[ leafId ].height == 0 );
+
+    // Any queued update for the leaf will be skipped once the node is no longer flagged as pending.
+    RemoveLeaf( leafId );
+    FreeNode( leafId );
+
+    HELIUM_ASSERT( m_leafCount != 0 );
+    --m_leafCount;
+}
+
+/// Remove all leaves from this tree.
+void DynamicAabbTree::Clear()
+{
+    m_nodes.Clear();
+    m_pendingLeafIds.Clear();
+    m_refitTopNodeIds.Clear();
+    m_refitSubtreeIds.Clear();
+
+    SetInvalid( m_rootId );
+    SetInvalid( m_freeListId );
+    m_leafCount = 0;
+}
+
+/// Update the bounds of an object in this tree.
+///
+/// If the new bounds are still contained within the leaf box, nothing needs to be done.  Otherwise, the leaf box is
+/// updated immediately, but the tree itself will not be updated until Refit() is called, and the tree cannot be
+/// queried until then.
+///
+/// @param[in] leafId  ID of the leaf node referencing the object.
+/// @param[in] rBox    New object bounds.
+///
+/// @return  True if the leaf box was updated and the leaf queued for refitting, false if the leaf box already
+///          contained the new bounds.
+///
+/// @see Refit(), HasPendingUpdates()
+bool DynamicAabbTree::SetBounds( uint32_t leafId, const Simd::AaBox& rBox )
+{
+    HELIUM_ASSERT( leafId < m_nodes.GetSize() );
+
+    Node& rLeaf = m_nodes[ leafId ];
+    HELIUM_ASSERT( rLeaf.height == 0 );
+
+    const Simd::Vector3& rMinimum = rBox.GetMinimum();
+    const Simd::Vector3& rMaximum = rBox.GetMaximum();
+
+    float32_t minimum[ 3 ];
+    float32_t maximum[ 3 ];
+    bool bContained = true;
+    for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+    {
+        minimum[ axisIndex ] = rMinimum.GetElement( axisIndex );
+        maximum[ axisIndex ] = rMaximum.GetElement( axisIndex );
+        if( minimum[ axisIndex ] < rLeaf.minimum[ axisIndex ] || maximum[ axisIndex ] > rLeaf.maximum[ axisIndex ] )
+        {
+            bContained = false;
+        }
+    }
+
+    if( bContained )
+    {
+        return false;
+    }
+
+    for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+    {
+        float32_t margin = ( maximum[ axisIndex ] - minimum[ axisIndex ] ) * LEAF_MARGIN_SCALE;
+        rLeaf.minimum[ axisIndex ] = minimum[ axisIndex ] - margin;
+        rLeaf.maximum[ axisIndex ] = maximum[ axisIndex ] + margin;
+    }
+
+    if( !( rLeaf.flags & NODE_FLAG_PENDING ) )
+    {
+        rLeaf.flags |= NODE_FLAG_PENDING;
+        m_pendingLeafIds.Push( leafId );
+    }
+
+    return true;
+}
+
+/// Apply all leaf bounds updates queued using SetBounds().
+///
+/// @see SetBounds(), HasPendingUpdates()
+void DynamicAabbTree::Refit()
+{
+    size_t pendingCount = m_pendingLeafIds.GetSize();
+    if( pendingCount == 0 )
+    {
+        return;
+    }
+
+    if( pendingCount <= REINSERT_COUNT_MAX )
+    {
+        // Small numbers of leaves can be reinserted, maintaining the quality of the tree.
+        for( size_t pendingIndex = 0; pendingIndex < pendingCount; ++pendingIndex )
+        {
+            uint32_t leafId = m_pendingLeafIds[ pendingIndex ];
+            Node& rLeaf = m_nodes[ leafId ];
+            if( !( rLeaf.flags & NODE_FLAG_PENDING ) )
+            {
+                continue;
+            }
+
+            rLeaf.flags &= ~NODE_FLAG_PENDING;
+
+            RemoveLeaf( leafId );
+            InsertLeaf( leafId );
+        }
+    }
+    else
+    {
+        RefitParallel();
+    }
+
+    m_pendingLeafIds.Resize( 0 );
+}
+
+/// Get the height of this tree.
+///
+/// @return  Number of levels in the tree below the root node (zero if the tree is empty or the root is a leaf).
+uint32_t DynamicAabbTree::GetHeight() const
+{
+    if( IsInvalid( m_rootId ) )
+    {
+        return 0;
+    }
+
+    return static_cast< uint32_t >( m_nodes[ m_rootId ].height );
+}
+
+/// Build a list of the IDs of all objects in this tree that intersect the specified set of culling planes.
+///
+/// Tree nodes entirely inside all planes are accepted without testing their descendants, and testing of descendant
+/// nodes is limited to the planes that intersect their parent.  Objects in leaves that are not entirely inside all
+/// planes are tested using their bounding spheres.
+///
+/// @param[in]  rPlanes            Culling planes.
+/// @param[in]  rObjectBounds      Bounding sphere stream for the objects in this tree, indexed by object ID.
+/// @param[out] rVisibleObjectIds  List of visible object IDs (in no particular order).
+void DynamicAabbTree::Cull(
+    const SceneBoundsStream::Planes& rPlanes,
+    const SceneBoundsStream& rObjectBounds,
+    DynamicArray< uint32_t >& rVisibleObjectIds ) const
+{
+    HELIUM_ASSERT( !HasPendingUpdates() );
+
+    rVisibleObjectIds.Resize( 0 );
+
+    if( IsInvalid( m_rootId ) )
+    {
+        return;
+    }
+
+    const Node* pNodes = m_nodes.GetData();
+
+    // Each stack entry holds a node ID along with the mask of planes that intersect its parent.
+    uint32_t stackNodeIds[ CULL_STACK_SIZE ];
+    uint32_t stackPlaneMasks[ CULL_STACK_SIZE ];
+    stackNodeIds[ 0 ] = m_rootId;
+    stackPlaneMasks[ 0 ] = ( 1 << SceneBoundsStream::PLANE_COUNT ) - 1;
+    size_t stackSize = 1;
+
+    while( stackSize != 0 )
+    {
+        --stackSize;
+        uint32_t nodeId = stackNodeIds[ stackSize ];
+        uint32_t planeMask = stackPlaneMasks[ stackSize ];
+
+        const Node& rNode = pNodes[ nodeId ];
+
+        if( planeMask != 0 )
+        {
+            float32_t centerX = ( rNode.minimum[ 0 ] + rNode.maximum[ 0 ] ) * 0.5f;
+            float32_t centerY = ( rNode.minimum[ 1 ] + rNode.maximum[ 1 ] ) * 0.5f;
+            float32_t centerZ = ( rNode.minimum[ 2 ] + rNode.maximum[ 2 ] ) * 0.5f;
+            float32_t extentX = ( rNode.maximum[ 0 ] - rNode.minimum[ 0 ] ) * 0.5f;
+            float32_t extentY = ( rNode.maximum[ 1 ] - rNode.minimum[ 1 ] ) * 0.5f;
+            float32_t extentZ = ( rNode.maximum[ 2 ] - rNode.minimum[ 2 ] ) * 0.5f;
+
+            bool bOutside = false;
+            for( size_t planeIndex = 0; planeIndex < SceneBoundsStream::PLANE_COUNT; ++planeIndex )
+            {
+                uint32_t planeBit = ( 1 << planeIndex );
+                if( !( planeMask & planeBit ) )
+                {
+                    continue;
+                }
+
+                float32_t normalX = rPlanes.normalX[ planeIndex ];
+                float32_t normalY = rPlanes.normalY[ planeIndex ];
+                float32_t normalZ = rPlanes.normalZ[ planeIndex ];
+
+                float32_t distance =
+                    centerX * normalX + centerY * normalY + centerZ * normalZ + rPlanes.distance[ planeIndex ];
+                float32_t projectedExtent =
+                    extentX * Abs( normalX ) + extentY * Abs( normalY ) + extentZ * Abs( normalZ );
+
+                if( distance + projectedExtent < 0.0f )
+                {
+                    bOutside = true;
+
+                    break;
+                }
+
+                if( distance - projectedExtent >= 0.0f )
+                {
+                    planeMask &= ~planeBit;
+                }
+            }
+
+            if( bOutside )
+            {
+                continue;
+            }
+        }
+
+        if( rNode.height == 0 )
+        {
+            if( rObjectBounds.Intersects( rNode.objectId, rPlanes, planeMask ) )
+            {
+                rVisibleObjectIds.Push( rNode.objectId );
+            }
+
+            continue;
+        }
+
+        HELIUM_ASSERT( stackSize + 2 <= CULL_STACK_SIZE );
+        stackNodeIds[ stackSize ] = rNode.children[ 0 ];
+        stackPlaneMasks[ stackSize ] = planeMask;
+        ++stackSize;
+        stackNodeIds[ stackSize ] = rNode.children[ 1 ];
+        stackPlaneMasks[ stackSize ] = planeMask;
+        ++stackSize;
+    }
+}
+
+/// Allocate a new tree node.
+///
+/// Note that this may reallocate the node array, invalidating any existing node references.
+///
+/// @return  ID of the allocated node.
+///
+/// @see FreeNode()
+uint32_t DynamicAabbTree::AllocateNode()
+{
+    uint32_t nodeId = m_freeListId;
+    if( IsValid( nodeId ) )
+    {
+        m_freeListId = m_nodes[ nodeId ].parent;
+    }
+    else
+    {
+        nodeId = static_cast< uint32_t >( m_nodes.GetSize() );
+        m_nodes.New();
+    }
+
+    Node& rNode = m_nodes[ nodeId ];
+    SetInvalid( rNode.parent );
+    SetInvalid( rNode.children[ 0 ] );
+    SetInvalid( rNode.children[ 1 ] );
+    SetInvalid( rNode.objectId );
+    rNode.height = 0;
+    rNode.flags = 0;
+
+    return nodeId;
+}
+
+/// Release a tree node for reuse.
+///
+/// @param[in] nodeId  ID of the node to free.
+///
+/// @see AllocateNode()
+void DynamicAabbTree::FreeNode( uint32_t nodeId )
+{
+    HELIUM_ASSERT( nodeId < m_nodes.GetSize() );
+
+    Node& rNode = m_nodes[ nodeId ];
+    rNode.parent = m_freeListId;
+    rNode.height = -1;
+    rNode.flags = 0;
+
+    m_freeListId = nodeId;
+}
+
+/// Link a leaf node into the tree.
+///
+/// The leaf is paired with the sibling node that results in the smallest increase in the total surface area of the
+/// tree, and the ancestors of the leaf are rebalanced as necessary.
+///
+/// @param[in] leafId  ID of the leaf node to insert.
+///
+/// @see RemoveLeaf()
+void DynamicAabbTree::InsertLeaf( uint32_t leafId )
+{
+    if( IsInvalid( m_rootId ) )
+    {
+        m_rootId = leafId;
+        SetInvalid( m_nodes[ leafId ].parent );
+
+        return;
+    }
+
+    // Find the best sibling for the leaf.
+    float32_t mergedMinimum[ 3 ];
+    float32_t mergedMaximum[ 3 ];
+
+    uint32_t siblingId = m_rootId;
+    while( m_nodes[ siblingId ].height > 0 )
+    {
+        const Node& rLeaf = m_nodes[ leafId ];
+        const Node& rNode = m_nodes[ siblingId ];
+
+        float32_t area = ComputeSurfaceArea( rNode.minimum, rNode.maximum );
+        MergeBoxes( rNode, rLeaf, mergedMinimum, mergedMaximum );
+        float32_t mergedArea = ComputeSurfaceArea( mergedMinimum, mergedMaximum );
+
+        // Cost of creating a new parent for this node and the leaf.
+        float32_t cost = 2.0f * mergedArea;
+
+        // Minimum cost of pushing the leaf further down the tree.
+        float32_t inheritanceCost = 2.0f * ( mergedArea - area );
+
+        float32_t childCosts[ 2 ];
+        for( size_t childIndex = 0; childIndex < 2; ++childIndex )
+        {
+            const Node& rChild = m_nodes[ rNode.children[ childIndex ] ];
+            MergeBoxes( rChild, rLeaf, mergedMinimum, mergedMaximum );
+            float32_t childCost = ComputeSurfaceArea( mergedMinimum, mergedMaximum );
+            if( rChild.height > 0 )
+            {
+                childCost -= ComputeSurfaceArea( rChild.minimum, rChild.maximum );
+            }
+
+            childCosts[ childIndex ] = childCost + inheritanceCost;
+        }
+
+        if( cost < childCosts[ 0 ] && cost < childCosts[ 1 ] )
+        {
+            break;
+        }
+
+        siblingId = rNode.children[ childCosts[ 0 ] < childCosts[ 1 ] ? 0 : 1 ];
+    }
+
+    // Create a new parent for the sibling and the leaf.
+    uint32_t newParentId = AllocateNode();
+
+    Node& rLeaf = m_nodes[ leafId ];
+    Node& rSibling = m_nodes[ siblingId ];
+    Node& rNewParent = m_nodes[ newParentId ];
+
+    uint32_t oldParentId = rSibling.parent;
+    rNewParent.parent = oldParentId;
+    rNewParent.children[ 0 ] = siblingId;
+    rNewParent.children[ 1 ] = leafId;
+    rNewParent.height = rSibling.height + 1;
+    MergeBoxes( rSibling, rLeaf, rNewParent.minimum, rNewParent.maximum );
+
+    rSibling.parent = newParentId;
+    rLeaf.parent = newParentId;
+
+    if( IsValid( oldParentId ) )
+    {
+        Node& rOldParent = m_nodes[ oldParentId ];
+        rOldParent.children[ rOldParent.children[ 0 ] == siblingId ? 0 : 1 ] = newParentId;
+    }
+    else
+    {
+        m_rootId = newParentId;
+    }
+
+    // Rebalance and update the bounds of each ancestor.
+    for( uint32_t nodeId = newParentId; IsValid( nodeId ); nodeId = m_nodes[ nodeId ].parent )
+    {
+        nodeId = Balance( nodeId );
+        UpdateNode( nodeId );
+    }
+}
+
+/// Unlink a leaf node from the tree.
+///
+/// @param[in] leafId  ID of the leaf node to remove.
+///
+/// @see InsertLeaf()
+void DynamicAabbTree::RemoveLeaf( uint32_t leafId )
+{
+    if( leafId == m_rootId )
+    {
+        SetInvalid( m_rootId );
+
+        return;
+    }
+
+    uint32_t parentId = m_nodes[ leafId ].parent;
+    HELIUM_ASSERT( IsValid( parentId ) );
+
+    const Node& rParent = m_nodes[ parentId ];
+    uint32_t grandParentId = rParent.parent;
+    uint32_t siblingId = rParent.children[ rParent.children[ 0 ] == leafId ? 1 : 0 ];
+
+    // Replace the parent with the sibling.
+    m_nodes[ siblingId ].parent = grandParentId;
+    if( IsValid( grandParentId ) )
+    {
+        Node& rGrandParent = m_nodes[ grandParentId ];
+        rGrandParent.children[ rGrandParent.children[ 0 ] == parentId ? 0 : 1 ] = siblingId;
+    }
+    else
+    {
+        m_rootId = siblingId;
+    }
+
+    FreeNode( parentId );
+    SetInvalid( m_nodes[ leafId ].parent );
+
+    // Rebalance and update the bounds of each remaining ancestor.
+    for( uint32_t nodeId = grandParentId; IsValid( nodeId ); nodeId = m_nodes[ nodeId ].parent )
+    {
+        nodeId = Balance( nodeId );
+        UpdateNode( nodeId );
+    }
+}
+
+/// Rotate the subtree rooted at a given node if its children are out of balance.
+///
+/// @param[in] nodeId  ID of the subtree root node.
+///
+/// @return  ID of the node at the root of the subtree after balancing.
+uint32_t DynamicAabbTree::Balance( uint32_t nodeId )
+{
+    Node& rNode = m_nodes[ nodeId ];
+    if( rNode.height < 2 )
+    {
+        return nodeId;
+    }
+
+    int32_t balance = m_nodes[ rNode.children[ 1 ] ].height - m_nodes[ rNode.children[ 0 ] ].height;
+    if( balance >= -1 && balance <= 1 )
+    {
+        return nodeId;
+    }
+
+    // Promote the taller child, moving this node down in its place.
+    size_t tallIndex = ( balance > 1 ? 1 : 0 );
+    size_t shortIndex = 1 - tallIndex;
+
+    uint32_t tallId = rNode.children[ tallIndex ];
+    Node& rTall = m_nodes[ tallId ];
+    HELIUM_ASSERT( rTall.height > 0 );
+
+    uint32_t grandChildIds[ 2 ] = { rTall.children[ 0 ], rTall.children[ 1 ] };
+    Node& rGrandChild0 = m_nodes[ grandChildIds[ 0 ] ];
+    Node& rGrandChild1 = m_nodes[ grandChildIds[ 1 ] ];
+
+    rTall.children[ 0 ] = nodeId;
+    rTall.parent = rNode.parent;
+    rNode.parent = tallId;
+
+    if( IsValid( rTall.parent ) )
+    {
+        Node& rParent = m_nodes[ rTall.parent ];
+        rParent.children[ rParent.children[ 0 ] == nodeId ? 0 : 1 ] = tallId;
+    }
+    else
+    {
+        m_rootId = tallId;
+    }
+
+    // Keep the taller grandchild under the promoted node, and move the other under this node.
+    size_t keepIndex = ( rGrandChild0.height > rGrandChild1.height ? 0 : 1 );
+    uint32_t keepId = grandChildIds[ keepIndex ];
+    uint32_t moveId = grandChildIds[ 1 - keepIndex ];
+
+    rTall.children[ 1 ] = keepId;
+    rNode.children[ tallIndex ] = moveId;
+    m_nodes[ moveId ].parent = nodeId;
+
+    const Node& rShort = m_nodes[ rNode.children[ shortIndex ] ];
+    const Node& rMove = m_nodes[ moveId ];
+    const Node& rKeep = m_nodes[ keepId ];
+
+    MergeBoxes( rShort, rMove, rNode.minimum, rNode.maximum );
+    rNode.height = 1 + Max( rShort.height, rMove.height );
+
+    MergeBoxes( rNode, rKeep, rTall.minimum, rTall.maximum );
+    rTall.height = 1 + Max( rNode.height, rKeep.height );
+
+    return tallId;
+}
+
+/// Update the bounds and height of an internal node from those of its children.
+///
+/// @param[in] nodeId  ID of the node to update.
+void DynamicAabbTree::UpdateNode( uint32_t nodeId )
+{
+    Node& rNode = m_nodes[ nodeId ];
+    HELIUM_ASSERT( rNode.height > 0 );
+
+    const Node& rChild0 = m_nodes[ rNode.children[ 0 ] ];
+    const Node& rChild1 = m_nodes[ rNode.children[ 1 ] ];
+
+    MergeBoxes( rChild0, rChild1, rNode.minimum, rNode.maximum );
+    rNode.height = 1 + Max( rChild0.height, rChild1.height );
+}
+
+/// Apply all queued leaf updates by refitting the bounds of their ancestors without changing the tree structure.
+///
+/// Dirty subtrees at REFIT_SUBTREE_DEPTH are refit in parallel jobs, after which the dirty nodes above them are refit
+/// on the calling thread.
+void DynamicAabbTree::RefitParallel()
+{
+    // Flag the ancestors of each updated leaf as needing to be refit.
+    size_t pendingCount = m_pendingLeafIds.GetSize();
+    for( size_t pendingIndex = 0; pendingIndex < pendingCount; ++pendingIndex )
+    {
+        Node& rLeaf = m_nodes[ m_pendingLeafIds[ pendingIndex ] ];
+        if( !( rLeaf.flags & NODE_FLAG_PENDING ) )
+        {
+            continue;
+        }
+
+        rLeaf.flags &= ~NODE_FLAG_PENDING;
+
+        for( uint32_t nodeId = rLeaf.parent; IsValid( nodeId ); nodeId = m_nodes[ nodeId ].parent )
+        {
+            Node& rNode = m_nodes[ nodeId ];
+            if( rNode.flags & NODE_FLAG_DIRTY )
+            {
+                break;
+            }
+
+            rNode.flags |= NODE_FLAG_DIRTY;
+        }
+    }
+
+    if( IsInvalid( m_rootId ) || !( m_nodes[ m_rootId ].flags & NODE_FLAG_DIRTY ) )
+    {
+        return;
+    }
+
+    // Split the dirty nodes into those near the root of the tree and the roots of deeper subtrees.
+    m_refitTopNodeIds.Resize( 0 );
+    m_refitSubtreeIds.Resize( 0 );
+
+    m_refitTopNodeIds.Push( m_rootId );
+    size_t levelStartIndex = 0;
+    for( size_t depth = 1; depth <= REFIT_SUBTREE_DEPTH; ++depth )
+    {
+        size_t levelEndIndex = m_refitTopNodeIds.GetSize();
+        for( size_t topIndex = levelStartIndex; topIndex < levelEndIndex; ++topIndex )
+        {
+            const Node& rNode = m_nodes[ m_refitTopNodeIds[ topIndex ] ];
+            for( size_t childIndex = 0; childIndex < 2; ++childIndex )
+            {
+                uint32_t childId = rNode.children[ childIndex ];
+                if( m_nodes[ childId ].flags & NODE_FLAG_DIRTY )
+                {
+                    if( depth < REFIT_SUBTREE_DEPTH )
+                    {
+                        m_refitTopNodeIds.Push( childId );
+                    }
+                    else
+                    {
+                        m_refitSubtreeIds.Push( childId );
+                    }
+                }
+            }
+        }
+
+        levelStartIndex = levelEndIndex;
+    }
+
+    // Refit the deeper subtrees in parallel.
+    size_t subtreeCount = m_refitSubtreeIds.GetSize();
+    if( subtreeCount != 0 )
+    {
+        volatile int32_t nextIndex = 0;
+        size_t jobCount = Min( subtreeCount, REFIT_JOB_COUNT_MAX );
+
+        JobContext::Spawner< REFIT_JOB_COUNT_MAX > rootSpawner;
+
+        for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+        {
+            JobContext* pContext = rootSpawner.Allocate();
+            HELIUM_ASSERT( pContext );
+            ParallelForJob* pJob = pContext->Create< ParallelForJob >();
+            HELIUM_ASSERT( pJob );
+            ParallelForJob::Parameters& rParameters = pJob->GetParameters();
+            rParameters.pFunction = RefitSubtreeWorkItem;
+            rParameters.pUserData = this;
+            rParameters.count = subtreeCount;
+            rParameters.pNextIndex = &nextIndex;
+        }
+    }
+
+    // Refit the nodes near the root, working upwards from the deepest level.
+    size_t topCount = m_refitTopNodeIds.GetSize();
+    while( topCount != 0 )
+    {
+        --topCount;
+        uint32_t nodeId = m_refitTopNodeIds[ topCount ];
+        UpdateNode( nodeId );
+        m_nodes[ nodeId ].flags &= ~NODE_FLAG_DIRTY;
+    }
+}
+
+/// Refit the bounds of all dirty nodes in a subtree.
+///
+/// @param[in] nodeId  ID of the subtree root node.
+void DynamicAabbTree::RefitSubtree( uint32_t nodeId )
+{
+    Node& rNode = m_nodes[ nodeId ];
+    HELIUM_ASSERT( rNode.height > 0 );
+
+    for( size_t childIndex = 0; childIndex < 2; ++childIndex )
+    {
+        uint32_t childId = rNode.children[ childIndex ];
+        if( m_nodes[ childId ].flags & NODE_FLAG_DIRTY )
+        {
+            RefitSubtree( childId );
+        }
+    }
+
+    UpdateNode( nodeId );
+    rNode.flags &= ~NODE_FLAG_DIRTY;
+}
+
+/// Compute the box containing the boxes of two nodes.
+///
+/// @param[in]  rNode0    First node.
+/// @param[in]  rNode1    Second node.
+/// @param[out] pMinimum  Merged box minimum coordinates.
+/// @param[out] pMaximum  Merged box maximum coordinates.
+void DynamicAabbTree::MergeBoxes(
+    const Node& rNode0,
+    const Node& rNode1,
+    float32_t* pMinimum,
+    float32_t* pMaximum )
+{
+    HELIUM_ASSERT( pMinimum );
+    HELIUM_ASSERT( pMaximum );
+
+    for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+    {
+        pMinimum[ axisIndex ] = Min( rNode0.minimum[ axisIndex ], rNode1.minimum[ axisIndex ] );
+        pMaximum[ axisIndex ] = Max( rNode0.maximum[ axisIndex ], rNode1.maximum[ axisIndex ] );
+    }
+}
+
+/// Compute the surface area of a box.
+///
+/// @param[in] pMinimum  Box minimum coordinates.
+/// @param[in] pMaximum  Box maximum coordinates.
+///
+/// @return  Box surface area.
+float32_t DynamicAabbTree::ComputeSurfaceArea( const float32_t* pMinimum, const float32_t* pMaximum )
+{
+    HELIUM_ASSERT( pMinimum );
+    HELIUM_ASSERT( pMaximum );
+
+    float32_t sizeX = pMaximum[ 0 ] - pMinimum[ 0 ];
+    float32_t sizeY = pMaximum[ 1 ] - pMinimum[ 1 ];
+    float32_t sizeZ = pMaximum[ 2 ] - pMinimum[ 2 ];
+
+    return 2.0f * ( sizeX * sizeY + sizeY * sizeZ + sizeZ * sizeX );
+}
+
+/// ParallelForJob work function for refitting a single dirty subtree.
+///
+/// @param[in] pTree  Tree being refit.
+/// @param[in] index  Index of the subtree root node ID in the list of subtrees to refit.
+void DynamicAabbTree::RefitSubtreeWorkItem( void* pTree, size_t index )
+{
+    HELIUM_ASSERT( pTree );
+    DynamicAabbTree* pAabbTree = static_cast< DynamicAabbTree* >( pTree );
+    HELIUM_ASSERT( index < pAabbTree->m_refitSubtreeIds.GetSize() );
+
+    pAabbTree->RefitSubtree( pAabbTree->m_refitSubtreeIds[ index ] );
+}
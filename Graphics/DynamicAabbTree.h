@@ -0,0 +1,142 @@
+//----------------------------------------------------------------------------------------------------------------------
+// DynamicAabbTree.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_GRAPHICS_DYNAMIC_AABB_TREE_H
+#define HELIUM_GRAPHICS_DYNAMIC_AABB_TREE_H
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/AaBox.h"
+#include "Graphics/SceneBoundsStream.h"
+
+namespace Helium
+{
+    /// Dynamic bounding volume hierarchy of axis-aligned boxes, used for hierarchical visibility culling.
+    ///
+    /// Each leaf references a single object, and stores a box enlarged somewhat beyond the actual bounds of the
+    /// object so that small movements do not require the tree to be updated.  Leaves are inserted next to the sibling
+    /// that minimizes the increase in surface area of the tree, and tree nodes are rotated as needed to keep the tree
+    /// balanced.
+    ///
+    /// Movements of objects beyond the enlarged bounds of their leaves are queued using SetBounds() and applied using
+    /// Refit().  Small batches of updates are applied by reinserting each moved leaf, while larger batches are applied
+    /// by refitting the bounds of all affected nodes without changing the tree structure, splitting the work across
+    /// several jobs.
+    class HELIUM_GRAPHICS_API DynamicAabbTree : NonCopyable
+    {
+    public:
+        /// Maximum number of queued leaf updates to apply by reinserting each leaf (larger batches are refit).
+        static const size_t REINSERT_COUNT_MAX = 64;
+        /// Depth of the tree at which refitting is split into separate subtree jobs.
+        static const size_t REFIT_SUBTREE_DEPTH = 5;
+        /// Maximum number of jobs to spawn when refitting.
+        static const size_t REFIT_JOB_COUNT_MAX = 8;
+        /// Culling traversal stack size (more than enough for the height of a balanced tree).
+        static const size_t CULL_STACK_SIZE = 128;
+
+        /// @name Construction/Destruction
+        //@{
+        DynamicAabbTree();
+        ~DynamicAabbTree();
+        //@}
+
+        /// @name Leaf Management
+        //@{
+        uint32_t Insert( uint32_t objectId, const Simd::AaBox& rBox );
+        void Remove( uint32_t leafId );
+        void Clear();
+
+        bool SetBounds( uint32_t leafId, const Simd::AaBox& rBox );
+        void Refit();
+        inline bool HasPendingUpdates() const;
+
+        inline uint32_t GetObjectId( uint32_t leafId ) const;
+        inline size_t GetLeafCount() const;
+        uint32_t GetHeight() const;
+        //@}
+
+        /// @name Culling
+        //@{
+        void Cull(
+            const SceneBoundsStream::Planes& rPlanes, const SceneBoundsStream& rObjectBounds,
+            DynamicArray< uint32_t >& rVisibleObjectIds ) const;
+        //@}
+
+    private:
+        /// Node flags.
+        enum ENodeFlag
+        {
+            /// Leaf bounds have changed, and the leaf needs to be reinserted or its ancestors refit.
+            NODE_FLAG_PENDING = ( 1 << 0 ),
+            /// Internal node bounds need to be refit.
+            NODE_FLAG_DIRTY   = ( 1 << 1 )
+        };
+
+        /// Tree node.
+        struct Node
+        {
+            /// Box minimum coordinates.
+            float32_t minimum[ 3 ];
+            /// Box maximum coordinates.
+            float32_t maximum[ 3 ];
+            /// Parent node ID (next node ID in the free list for unused nodes).
+            uint32_t parent;
+            /// Child node IDs (internal nodes only).
+            uint32_t children[ 2 ];
+            /// Object ID (leaf nodes only).
+            uint32_t objectId;
+            /// Height of this node within the tree (zero for leaves, -1 for unused nodes).
+            int32_t height;
+            /// Node flags (ENodeFlag values).
+            uint32_t flags;
+        };
+
+        /// Tree nodes.
+        DynamicArray< Node > m_nodes;
+        /// Root node ID.
+        uint32_t m_rootId;
+        /// First node ID in the list of unused nodes.
+        uint32_t m_freeListId;
+        /// Number of leaves in the tree.
+        size_t m_leafCount;
+
+        /// IDs of leaves with queued bounds updates.
+        DynamicArray< uint32_t > m_pendingLeafIds;
+        /// Dirty nodes near the root of the tree to refit after all subtrees have been refit (in breadth-first order).
+        DynamicArray< uint32_t > m_refitTopNodeIds;
+        /// Root node IDs of the dirty subtrees to refit in parallel.
+        DynamicArray< uint32_t > m_refitSubtreeIds;
+
+        /// @name Private Utility Functions
+        //@{
+        uint32_t AllocateNode();
+        void FreeNode( uint32_t nodeId );
+
+        void InsertLeaf( uint32_t leafId );
+        void RemoveLeaf( uint32_t leafId );
+        uint32_t Balance( uint32_t nodeId );
+        void UpdateNode( uint32_t nodeId );
+
+        void RefitParallel();
+        void RefitSubtree( uint32_t nodeId );
+        //@}
+
+        /// @name Static Private Utility Functions
+        //@{
+        static void MergeBoxes( const Node& rNode0, const Node& rNode1, float32_t* pMinimum, float32_t* pMaximum );
+        static float32_t ComputeSurfaceArea( const float32_t* pMinimum, const float32_t* pMaximum );
+
+        static void RefitSubtreeWorkItem( void* pTree, size_t index );
+        //@}
+    };
+}
+
+#include "Graphics/DynamicAabbTree.inl"
+
+#endif  // HELIUM_GRAPHICS_DYNAMIC_AABB_TREE_H
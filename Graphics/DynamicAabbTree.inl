@@ -0,0 +1,42 @@
+//----------------------------------------------------------------------------------------------------------------------
+// DynamicAabbTree.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get whether any leaf bounds updates are waiting to be applied using Refit().
+    ///
+    /// @return  True if leaf updates are pending, false if not.
+    ///
+    /// @see SetBounds(), Refit()
+    bool DynamicAabbTree::HasPendingUpdates() const
+    {
+        return !m_pendingLeafIds.IsEmpty();
+    }
+
+    /// Get the ID of the object referenced by a given leaf.
+    ///
+    /// @param[in] leafId  Leaf node ID.
+    ///
+    /// @return  Object ID.
+    ///
+    /// @see Insert()
+    uint32_t DynamicAabbTree::GetObjectId( uint32_t leafId ) const
+    {
+        HELIUM_ASSERT( leafId < m_nodes.GetSize() );
+        HELIUM_ASSERT( m_nodes[ leafId ].height == 0 );
+
+        return m_nodes[ leafId ].objectId;
+    }
+
+    /// Get the number of leaves in this tree.
+    ///
+    /// @return  Leaf count.
+    size_t DynamicAabbTree::GetLeafCount() const
+    {
+        return m_leafCount;
+    }
+}
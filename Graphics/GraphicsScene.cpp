@@ -16,6 +16,7 @@
 #include "Rendering/RConstantBuffer.h"
 #include "Rendering/RIndexBuffer.h"
 #include "Rendering/RPixelShader.h"
+#include "Rendering/RRenderCommandList.h"
 #include "Rendering/RRenderCommandProxy.h"
 #include "Rendering/RRenderContext.h"
 #include "Rendering/Renderer.h"
@@ -38,9 +39,56 @@ using namespace Helium;
 static const size_t SCENE_VIEW_BUFFERED_DRAWER_POOL_BLOCK_SIZE = 4;
 #endif !HELIUM_RELEASE && !HELIUM_PROFILE
 
-namespace Helium
+// Draw key layout (from the most significant bit):
+// - Depth passes: pass (2 bits), depth (32 bits), vertex buffer (30 bits).
+// - Base pass: pass (2 bits), shader variants (14 bits), material (16 bits), depth bucket (10 bits), vertex buffer
+//   (22 bits).
+static const uint32_t DRAW_KEY_PASS_SHIFT = 62;
+static const uint32_t DRAW_KEY_DEPTH_SHIFT = 30;
+static const uint32_t DRAW_KEY_DEPTH_BUFFER_BITS = 30;
+static const uint32_t DRAW_KEY_SHADER_SHIFT = 48;
+static const uint32_t DRAW_KEY_SHADER_BITS = 14;
+static const uint32_t DRAW_KEY_MATERIAL_SHIFT = 32;
+static const uint32_t DRAW_KEY_MATERIAL_BITS = 16;
+static const uint32_t DRAW_KEY_DEPTH_BUCKET_SHIFT = 22;
+static const uint32_t DRAW_KEY_DEPTH_BUCKET_BITS = 10;
+static const uint32_t DRAW_KEY_BASE_BUFFER_BITS = 22;
+
+/// Convert a depth value to an unsigned integer that sorts in the same order as the original floating-point value.
+///
+/// @param[in] depth  Depth value.
+///
+/// @return  Sortable depth value.
+static uint64_t ComputeSortableDepth( float32_t depth )
 {
-    HELIUM_DECLARE_RPTR( RRenderCommandProxy );
+    union
+    {
+        float32_t f;
+        uint32_t u;
+    } depthBits;
+    depthBits.f = depth;
+
+    // Flip all bits of negative values and only the sign bit of positive values.
+    uint32_t mask = static_cast< uint32_t >( -static_cast< int32_t >( depthBits.u >> 31 ) ) | 0x80000000;
+
+    return static_cast< uint64_t >( depthBits.u ^ mask );
+}
+
+/// Reduce a resource pointer to a small identifier for grouping draws with the same resources in a draw key.
+///
+/// Different pointers may produce the same identifier, in which case their draws are simply not grouped together.
+///
+/// @param[in] pPointer  Resource pointer.
+/// @param[in] bitCount  Number of identifier bits.
+///
+/// @return  Resource identifier.
+static uint64_t ComputeDrawKeyResourceId( const void* pPointer, uint32_t bitCount )
+{
+    HELIUM_ASSERT( bitCount > 0 && bitCount < 64 );
+
+    uint64_t value = static_cast< uint64_t >( reinterpret_cast< uintptr_t >( pPointer ) );
+
+    return ( value * 0x9e3779b97f4a7c15 ) >> ( 64 - bitCount );
 }
 
 /// Constructor.
@@ -50,7 +98,8 @@ GraphicsScene::GraphicsScene()
       m_viewBufferedDrawerPool( SCENE_VIEW_BUFFERED_DRAWER_POOL_BLOCK_SIZE )
     ,
 #endif  // !HELIUM_RELEASE && !HELIUM_PROFILE
-      m_ambientLightTopColor( 0xffffffff )
+      m_bParallelRecording( true )
+    , m_ambientLightTopColor( 0xffffffff )
     , m_ambientLightTopBrightness( 0.25f )
     , m_ambientLightBottomColor( 0xff000000 )
     , m_ambientLightBottomBrightness( 0.0f )
@@ -116,6 +165,22 @@ void GraphicsScene::Update()
         m_shadowViewInverseViewProjectionMatrices.Resize( sceneViewCount );
     }
 
+    // Prepare the culling data for each frustum of each view and the sorting and command recording data for each draw
+    // pass of each view.
+    size_t cullDataCount = sceneViewCount * CULL_FRUSTUM_MAX;
+    if( m_cullData.GetSize() < cullDataCount )
+    {
+        m_cullData.Reserve( cullDataCount );
+        m_cullData.Resize( cullDataCount );
+    }
+
+    size_t drawPassDataCount = sceneViewCount * DRAW_PASS_MAX;
+    if( m_drawPassData.GetSize() < drawPassDataCount )
+    {
+        m_drawPassData.Reserve( drawPassDataCount );
+        m_drawPassData.Resize( drawPassDataCount );
+    }
+
     // Update each scene view as necessary and compute their inverse view/projection matrices.
     for( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
     {
@@ -129,23 +194,21 @@ void GraphicsScene::Update()
     }
 
     // Update each scene object as necessary.
-    size_t sceneObjectCount = m_sceneObjects.GetSize();
-    for( size_t objectIndex = 0; objectIndex < sceneObjectCount; ++objectIndex )
-    {
-        if( !m_sceneObjects.IsElementValid( objectIndex ) )
-        {
-            continue;
-        }
-
-        m_sceneObjects[ objectIndex ].ConditionalUpdate( this );
-    }
+    UpdateSceneObjects();
 
     // Swap dynamic constant buffers and update their contents.
     SwapDynamicConstantBuffers();
 
-    // Resize the visible object bit array as necessary.
-    m_visibleSceneObjects.Reserve( sceneObjectCount );
-    m_visibleSceneObjects.Resize( sceneObjectCount );
+    // Cull the scene objects against the frustums of each view once so that all draw passes of the view can share the
+    // resulting lists of visible sub-meshes.
+    CullSceneViews();
+
+    // Record the commands for each draw pass of each view in parallel if enabled (otherwise each pass will be drawn
+    // directly when its view is drawn).
+    if( m_bParallelRecording )
+    {
+        RecordDrawPassesParallel();
+    }
 
 #if !HELIUM_RELEASE && !HELIUM_PROFILE
     // Set up the scene's buffered drawer for the current frame.
@@ -169,6 +232,7 @@ void GraphicsScene::Update()
 #endif  // !HELIUM_RELEASE && !HELIUM_PROFILE
 
         DrawSceneView( static_cast< uint_fast32_t >( viewIndex ) );
+        ReleaseDrawPassCommandLists( static_cast< uint_fast32_t >( viewIndex ) );
 
 #if !HELIUM_RELEASE && !HELIUM_PROFILE
         // Finish drawing with the current view's buffered drawer.
@@ -252,7 +316,23 @@ size_t GraphicsScene::AllocateSceneObject()
     GraphicsSceneObject* pSceneObject = m_sceneObjects.New();
     HELIUM_ASSERT( pSceneObject );
 
-    return m_sceneObjects.GetElementIndex( pSceneObject );
+    size_t id = m_sceneObjects.GetElementIndex( pSceneObject );
+
+    // The object will not be considered for rendering until its bounds are set during its first update, at which
+    // point it will also be inserted into the bounding volume hierarchy.
+    size_t sceneObjectCount = m_sceneObjects.GetSize();
+    m_sceneObjectBounds.Resize( sceneObjectCount );
+    m_sceneObjectBounds.Clear( id );
+
+    size_t leafIdCount = m_sceneObjectTreeLeafIds.GetSize();
+    if( leafIdCount < sceneObjectCount )
+    {
+        m_sceneObjectTreeLeafIds.Add( Invalid< uint32_t >(), sceneObjectCount - leafIdCount );
+    }
+
+    HELIUM_ASSERT( IsInvalid( m_sceneObjectTreeLeafIds[ id ] ) );
+
+    return id;
 }
 
 /// Detach and release a previously allocated scene object.
@@ -265,7 +345,24 @@ void GraphicsScene::ReleaseSceneObject( size_t id )
     HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
     HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
 
+    HELIUM_ASSERT( id < m_sceneObjectTreeLeafIds.GetSize() );
+    uint32_t& rLeafId = m_sceneObjectTreeLeafIds[ id ];
+    if( IsValid( rLeafId ) )
+    {
+        m_sceneObjectTree.Remove( rLeafId );
+        SetInvalid( rLeafId );
+    }
+
     m_sceneObjects.Remove( id );
+
+    size_t sceneObjectCount = m_sceneObjects.GetSize();
+    m_sceneObjectBounds.Resize( sceneObjectCount );
+    if( id < sceneObjectCount )
+    {
+        m_sceneObjectBounds.Clear( id );
+    }
+
+    m_sceneObjectTreeLeafIds.Resize( sceneObjectCount );
 }
 
 /// Allocate new scene object sub-mesh data and add it to the scene.
@@ -300,6 +397,69 @@ void GraphicsScene::ReleaseSceneObjectSubMeshData( size_t id )
     m_sceneObjectSubMeshes.Remove( id );
 }
 
+/// Update each scene object flagged as needing an update, refreshing the bounds used for visibility culling.
+///
+/// This is called automatically by Update(), but can also be called directly (i.e. without an active renderer) to
+/// prepare the scene for visibility queries.
+///
+/// @see CullSceneObjects()
+void GraphicsScene::UpdateSceneObjects()
+{
+    size_t sceneObjectCount = m_sceneObjects.GetSize();
+    HELIUM_ASSERT( m_sceneObjectBounds.GetSize() == sceneObjectCount );
+    HELIUM_ASSERT( m_sceneObjectTreeLeafIds.GetSize() == sceneObjectCount );
+
+    // Bounding volume hierarchy leaves are given the boxes enclosing the bounding spheres in the bounds stream so that
+    // hierarchical culling never rejects an object that the bounds stream would accept.  Objects are inserted into
+    // the hierarchy on their first update, once their bounds are known.
+    for( size_t objectIndex = 0; objectIndex < sceneObjectCount; ++objectIndex )
+    {
+        if( !m_sceneObjects.IsElementValid( objectIndex ) )
+        {
+            continue;
+        }
+
+        GraphicsSceneObject& rSceneObject = m_sceneObjects[ objectIndex ];
+        if( rSceneObject.GetNeedsUpdate() )
+        {
+            rSceneObject.ConditionalUpdate( this );
+            m_sceneObjectBounds.Set( objectIndex, rSceneObject.GetWorldSphere() );
+
+            uint32_t& rLeafId = m_sceneObjectTreeLeafIds[ objectIndex ];
+            if( IsValid( rLeafId ) )
+            {
+                m_sceneObjectTree.SetBounds( rLeafId, m_sceneObjectBounds.GetBox( objectIndex ) );
+            }
+            else
+            {
+                rLeafId = m_sceneObjectTree.Insert(
+                    static_cast< uint32_t >( objectIndex ),
+                    m_sceneObjectBounds.GetBox( objectIndex ) );
+            }
+        }
+    }
+
+    // Apply all bounding volume hierarchy updates at once so that large batches can be refit in parallel.
+    m_sceneObjectTree.Refit();
+}
+
+/// Build a list of the IDs of all scene objects whose bounds intersect a given view frustum.
+///
+/// Scene objects must be up-to-date (see UpdateSceneObjects()) before performing visibility queries.
+///
+/// @param[in]  rViewProjectionMatrix  Combined view/projection matrix defining the view frustum.
+/// @param[out] rVisibleObjectIds      List of visible scene object IDs (in no particular order).
+///
+/// @see UpdateSceneObjects()
+void GraphicsScene::CullSceneObjects(
+    const Simd::Matrix44& rViewProjectionMatrix,
+    DynamicArray< uint32_t >& rVisibleObjectIds ) const
+{
+    SceneBoundsStream::Planes planes;
+    SceneBoundsStream::ComputePlanes( rViewProjectionMatrix, planes );
+    m_sceneObjectTree.Cull( planes, m_sceneObjectBounds, rVisibleObjectIds );
+}
+
 /// Set the properties for the scene's ambient lighting.
 ///
 /// @param[in] rTopColor         Ambient light coloring to apply to upward-facing normals.
@@ -1124,69 +1284,226 @@ void GraphicsScene::SwapDynamicConstantBuffers()
     }
 }
 
-/// Render the specified scene view.
+/// Get whether a scene view will be drawn during the current frame.
 ///
-/// @param[in] viewIndex  Index of the scene view to render (can be an invalid element, but must be less than the size
-///                       of the scene view sparse array).
-void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
+/// @param[in] viewIndex  Index of the scene view (can be an invalid element, but must be less than the size of the
+///                       scene view sparse array).
+///
+/// @return  True if the view will be drawn, false if it will be skipped by DrawSceneView().
+bool GraphicsScene::CanDrawSceneView( size_t viewIndex ) const
 {
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
 
-    if( !m_sceneViews.IsElementValid( viewIndex ) )
+    return ( m_sceneViews.IsElementValid( viewIndex ) &&
+             m_viewVertexGlobalDataBuffers[ m_constantBufferSetIndex ][ viewIndex ] &&
+             m_sceneViews[ viewIndex ].GetRenderContext() );
+}
+
+/// Cull the scene objects against the frustums of each scene view that will be drawn during the current frame.
+///
+/// Each view is culled against its view frustum, and against its shadow view frustum if shadows are enabled.  The
+/// resulting lists of visible sub-meshes are shared by all draw passes using the same frustum.  Frustums are culled
+/// in parallel if parallel recording is enabled.
+///
+/// @see PrepareDrawPass(), SetParallelRecordingEnabled()
+void GraphicsScene::CullSceneViews()
+{
+    RenderResourceManager& rRenderResourceManager = RenderResourceManager::GetStaticInstance();
+    GraphicsConfig::EShadowMode shadowMode = rRenderResourceManager.GetShadowMode();
+    bool bShadowsEnabled =
+        ( shadowMode != GraphicsConfig::EShadowMode::INVALID && shadowMode != GraphicsConfig::EShadowMode::NONE );
+
+    // Build the list of frustums to cull.
+    m_cullDataIndices.Resize( 0 );
+
+    size_t sceneViewCount = m_sceneViews.GetSize();
+    HELIUM_ASSERT( m_cullData.GetSize() >= sceneViewCount * CULL_FRUSTUM_MAX );
+    for( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
     {
-        return;
+        if( !CanDrawSceneView( viewIndex ) )
+        {
+            continue;
+        }
+
+        size_t cullDataIndex = viewIndex * CULL_FRUSTUM_MAX;
+        if( bShadowsEnabled )
+        {
+            m_cullDataIndices.Push( static_cast< uint32_t >( cullDataIndex + CULL_FRUSTUM_SHADOW ) );
+        }
+
+        m_cullDataIndices.Push( static_cast< uint32_t >( cullDataIndex + CULL_FRUSTUM_VIEW ) );
     }
 
-    RConstantBuffer* pViewVertexGlobalDataBuffer =
-        m_viewVertexGlobalDataBuffers[ m_constantBufferSetIndex ][ viewIndex ];
-    if( !pViewVertexGlobalDataBuffer )
+    size_t cullCount = m_cullDataIndices.GetSize();
+    if( !m_bParallelRecording )
     {
+        for( size_t cullIndex = 0; cullIndex < cullCount; ++cullIndex )
+        {
+            CullSceneViewFrustumWorkItem( this, cullIndex );
+        }
+
         return;
     }
 
-    GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
-    RRenderContext* pRenderContext = rView.GetRenderContext();
-    if( !pRenderContext )
+    if( cullCount == 0 )
     {
         return;
     }
 
-    // Determine which scene objects are visible in the current view.
-    m_visibleSceneObjects.UnsetAll();
+    volatile int32_t nextIndex = 0;
+    size_t jobCount = Min( cullCount, DRAW_PASS_JOB_COUNT_MAX );
 
-    const Simd::Frustum& rViewFrustum = rView.GetFrustum();
+    JobContext::Spawner< DRAW_PASS_JOB_COUNT_MAX > rootSpawner;
 
-    size_t sceneObjectCount = m_sceneObjects.GetSize();
-    for( size_t sceneObjectIndex = 0; sceneObjectIndex < sceneObjectCount; ++sceneObjectIndex )
+    for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
     {
-        if( m_sceneObjects.IsElementValid( sceneObjectIndex ) )
-        {
-            //const AaBox& rObjectBounds = m_sceneObjects[ sceneObjectIndex ].GetWorldBox();
-            const Simd::Sphere& rObjectBounds = m_sceneObjects[ sceneObjectIndex ].GetWorldSphere();
-            if( rViewFrustum.Intersects( rObjectBounds ) )
-            {
-                m_visibleSceneObjects.SetElement( sceneObjectIndex );
-            }
-        }
+        JobContext* pContext = rootSpawner.Allocate();
+        HELIUM_ASSERT( pContext );
+        ParallelForJob* pJob = pContext->Create< ParallelForJob >();
+        HELIUM_ASSERT( pJob );
+        ParallelForJob::Parameters& rParameters = pJob->GetParameters();
+        rParameters.pFunction = CullSceneViewFrustumWorkItem;
+        rParameters.pUserData = this;
+        rParameters.count = cullCount;
+        rParameters.pNextIndex = &nextIndex;
     }
+}
 
-    // Build a list of indices for each visible sub-mesh for sorting.
-    m_sceneObjectSubMeshIndices.Resize( 0 );
+/// Cull the scene objects against a single frustum of a scene view and gather the sub-meshes of the visible objects.
+///
+/// This can be called for different frustums from multiple threads at once.
+///
+/// @param[in] viewIndex  Index of the scene view being culled.
+/// @param[in] frustum    Frustum against which to cull.
+///
+/// @see CullSceneViews()
+void GraphicsScene::CullSceneViewFrustum( uint_fast32_t viewIndex, ECullFrustum frustum )
+{
+    HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+    HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
+    HELIUM_ASSERT( static_cast< size_t >( frustum ) < CULL_FRUSTUM_MAX );
 
-    size_t subMeshCount = m_sceneObjectSubMeshes.GetSize();
-    for( size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex )
+    size_t cullDataIndex = viewIndex * CULL_FRUSTUM_MAX + frustum;
+    HELIUM_ASSERT( cullDataIndex < m_cullData.GetSize() );
+    CullData& rCullData = m_cullData[ cullDataIndex ];
+
+    if( frustum == CULL_FRUSTUM_SHADOW )
     {
-        if( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) )
+        HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
+        CullSceneObjects( m_shadowViewInverseViewProjectionMatrices[ viewIndex ], rCullData.visibleSceneObjectIds );
+    }
+    else
+    {
+        CullSceneObjects(
+            m_sceneViews[ viewIndex ].GetInverseViewProjectionMatrix(),
+            rCullData.visibleSceneObjectIds );
+    }
+
+    GatherVisibleSubMeshes( rCullData );
+}
+
+/// Sort and record the commands for each draw pass of each scene view in parallel.
+///
+/// Each draw pass is recorded to its own deferred command list by a set of jobs.  The command lists are then
+/// submitted in order to the immediate command proxy by DrawSceneView().
+///
+/// @see DrawSceneView(), SubmitDrawPass()
+void GraphicsScene::RecordDrawPassesParallel()
+{
+    Renderer* pRenderer = Renderer::GetStaticInstance();
+    HELIUM_ASSERT( pRenderer );
+
+    // Make sure names cached in function-local static variables are initialized before they are accessed from
+    // multiple threads at once.
+    GetDefaultSamplerStateName();
+    GetShadowSamplerStateName();
+    GetShadowMapTextureName();
+    GetNoneOptionName();
+    GetSkinningSysSelectName();
+    GetSkinningSmoothOptionName();
+
+    // Build the list of draw passes to record, creating deferred command proxies for each as necessary.
+    m_recordPassDataIndices.Resize( 0 );
+
+    size_t sceneViewCount = m_sceneViews.GetSize();
+    HELIUM_ASSERT( m_drawPassData.GetSize() >= sceneViewCount * DRAW_PASS_MAX );
+    for( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
+    {
+        // Skip views that won't be drawn.
+        if( !CanDrawSceneView( viewIndex ) )
         {
-            size_t sceneObjectId = m_sceneObjectSubMeshes[ subMeshIndex ].GetSceneObjectId();
-            HELIUM_ASSERT( sceneObjectId < m_visibleSceneObjects.GetSize() );
-            if( m_visibleSceneObjects[ sceneObjectId ] )
+            continue;
+        }
+
+        for( size_t passIndex = 0; passIndex < DRAW_PASS_MAX; ++passIndex )
+        {
+            size_t passDataIndex = viewIndex * DRAW_PASS_MAX + passIndex;
+            DrawPassData& rPassData = m_drawPassData[ passDataIndex ];
+            if( !rPassData.spCommandProxy )
             {
-                m_sceneObjectSubMeshIndices.Push( subMeshIndex );
+                rPassData.spCommandProxy = pRenderer->CreateDeferredCommandProxy();
+                HELIUM_ASSERT( rPassData.spCommandProxy );
             }
+
+            m_recordPassDataIndices.Push( static_cast< uint32_t >( passDataIndex ) );
         }
     }
 
+    size_t passCount = m_recordPassDataIndices.GetSize();
+    if( passCount == 0 )
+    {
+        return;
+    }
+
+    volatile int32_t nextIndex = 0;
+    size_t jobCount = Min( passCount, DRAW_PASS_JOB_COUNT_MAX );
+
+    JobContext::Spawner< DRAW_PASS_JOB_COUNT_MAX > rootSpawner;
+
+    for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+    {
+        JobContext* pContext = rootSpawner.Allocate();
+        HELIUM_ASSERT( pContext );
+        ParallelForJob* pJob = pContext->Create< ParallelForJob >();
+        HELIUM_ASSERT( pJob );
+        ParallelForJob::Parameters& rParameters = pJob->GetParameters();
+        rParameters.pFunction = RecordDrawPassWorkItem;
+        rParameters.pUserData = this;
+        rParameters.count = passCount;
+        rParameters.pNextIndex = &nextIndex;
+    }
+}
+
+/// Render the specified scene view.
+///
+/// Draw passes recorded by RecordDrawPassesParallel() are submitted in order along with the commands for setting up
+/// and presenting the view, while any draw passes not recorded in advance are drawn directly.
+///
+/// @param[in] viewIndex  Index of the scene view to render (can be an invalid element, but must be less than the size
+///                       of the scene view sparse array).
+void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
+{
+    HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+
+    if( !m_sceneViews.IsElementValid( viewIndex ) )
+    {
+        return;
+    }
+
+    RConstantBuffer* pViewVertexGlobalDataBuffer =
+        m_viewVertexGlobalDataBuffers[ m_constantBufferSetIndex ][ viewIndex ];
+    if( !pViewVertexGlobalDataBuffer )
+    {
+        return;
+    }
+
+    GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
+    RRenderContext* pRenderContext = rView.GetRenderContext();
+    if( !pRenderContext )
+    {
+        return;
+    }
+
     // Get the renderer interface and the main command proxy for the renderer.
     Renderer* pRenderer = Renderer::GetStaticInstance();
     HELIUM_ASSERT( pRenderer );
@@ -1212,7 +1529,7 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
     spCommandProxy->SetDepthStencilState( pDepthStateDefault, 0 );
 
     // Draw shadow depth pass (this will also set up the shadow depth scene as needed).
-    DrawShadowDepthPass( viewIndex );
+    SubmitDrawPass( viewIndex, DRAW_PASS_SHADOW_DEPTH, spCommandProxy );
 
     // Set up normal scene rendering.
     RSurface* pDepthStencilSurface = rView.GetDepthStencilSurface();
@@ -1238,8 +1555,8 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
     spCommandProxy->SetVertexConstantBuffers( 0, 1, &pViewVertexGlobalDataBuffer );
 
     // Draw passes...
-    DrawDepthPrePass( viewIndex );
-    DrawBasePass( viewIndex );
+    SubmitDrawPass( viewIndex, DRAW_PASS_DEPTH_PRE_PASS, spCommandProxy );
+    SubmitDrawPass( viewIndex, DRAW_PASS_BASE, spCommandProxy );
 
 #if !HELIUM_RELEASE && !HELIUM_PROFILE
     // Draw buffered world-space draw calls for the current scene and view.
@@ -1342,16 +1659,308 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
     pRenderContext->Swap();
 }
 
+/// Submit the commands for a single draw pass of a scene view.
+///
+/// If the pass has been recorded to a command list (see RecordDrawPassesParallel()), the command list is executed.
+/// Otherwise, the pass is sorted and drawn directly using the given command proxy.
+///
+/// @param[in] viewIndex      Index of the scene view being drawn.
+/// @param[in] pass           Draw pass to submit.
+/// @param[in] pCommandProxy  Command proxy to which the pass commands should be submitted.
+///
+/// @see RecordDrawPass(), RecordDrawPassesParallel()
+void GraphicsScene::SubmitDrawPass( uint_fast32_t viewIndex, EDrawPass pass, RRenderCommandProxy* pCommandProxy )
+{
+    HELIUM_ASSERT( static_cast< size_t >( pass ) < DRAW_PASS_MAX );
+    HELIUM_ASSERT( pCommandProxy );
+
+    size_t passDataIndex = viewIndex * DRAW_PASS_MAX + pass;
+    HELIUM_ASSERT( passDataIndex < m_drawPassData.GetSize() );
+
+    RRenderCommandList* pCommandList = m_drawPassData[ passDataIndex ].spCommandList;
+    if( pCommandList )
+    {
+        pCommandProxy->ExecuteCommandList( pCommandList );
+    }
+    else
+    {
+        RecordDrawPass( viewIndex, pass, pCommandProxy );
+    }
+}
+
+/// Release the command lists recorded for each draw pass of a scene view.
+///
+/// @param[in] viewIndex  Index of the scene view.
+void GraphicsScene::ReleaseDrawPassCommandLists( uint_fast32_t viewIndex )
+{
+    size_t passDataIndex = viewIndex * DRAW_PASS_MAX;
+    HELIUM_ASSERT( passDataIndex + DRAW_PASS_MAX <= m_drawPassData.GetSize() );
+
+    for( size_t passIndex = 0; passIndex < DRAW_PASS_MAX; ++passIndex )
+    {
+        m_drawPassData[ passDataIndex + passIndex ].spCommandList.Release();
+    }
+}
+
+/// Sort and draw a single draw pass of a scene view.
+///
+/// This can be called for different draw passes from multiple threads at once, provided that each call uses a
+/// separate command proxy.
+///
+/// @param[in] viewIndex      Index of the scene view being drawn.
+/// @param[in] pass           Draw pass to draw.
+/// @param[in] pCommandProxy  Command proxy to which the pass commands should be issued.
+///
+/// @see SubmitDrawPass(), RecordDrawPassesParallel()
+void GraphicsScene::RecordDrawPass( uint_fast32_t viewIndex, EDrawPass pass, RRenderCommandProxy* pCommandProxy )
+{
+    HELIUM_ASSERT( static_cast< size_t >( pass ) < DRAW_PASS_MAX );
+    HELIUM_ASSERT( pCommandProxy );
+
+    size_t passDataIndex = viewIndex * DRAW_PASS_MAX + pass;
+    HELIUM_ASSERT( passDataIndex < m_drawPassData.GetSize() );
+    DrawPassData& rPassData = m_drawPassData[ passDataIndex ];
+
+    if( pass == DRAW_PASS_SHADOW_DEPTH )
+    {
+        DrawShadowDepthPass( viewIndex, rPassData, pCommandProxy );
+    }
+    else if( pass == DRAW_PASS_DEPTH_PRE_PASS )
+    {
+        DrawDepthPrePass( viewIndex, rPassData, pCommandProxy );
+    }
+    else
+    {
+        HELIUM_ASSERT( pass == DRAW_PASS_BASE );
+        DrawBasePass( viewIndex, rPassData, pCommandProxy );
+    }
+}
+
+/// Build the sorted list of sub-meshes to render for a single draw pass of a scene view.
+///
+/// The visible sub-meshes are taken from the culling results computed for the view by CullSceneViews().
+///
+/// @param[in]  viewIndex  Index of the scene view being drawn.
+/// @param[in]  pass       Draw pass being drawn.
+/// @param[out] rPassData  Draw pass data in which to store the sorted list of visible sub-meshes.
+void GraphicsScene::PrepareDrawPass( uint_fast32_t viewIndex, EDrawPass pass, DrawPassData& rPassData ) const
+{
+    HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+    HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
+
+    if( pass == DRAW_PASS_SHADOW_DEPTH )
+    {
+        // Shadow depth pass sub-meshes are sorted along the light direction.
+        size_t cullDataIndex = viewIndex * CULL_FRUSTUM_MAX + CULL_FRUSTUM_SHADOW;
+        HELIUM_ASSERT( cullDataIndex < m_cullData.GetSize() );
+        SortVisibleSubMeshes(
+            pass,
+            m_directionalLightDirection,
+            m_cullData[ cullDataIndex ].subMeshIndices,
+            rPassData );
+    }
+    else
+    {
+        size_t cullDataIndex = viewIndex * CULL_FRUSTUM_MAX + CULL_FRUSTUM_VIEW;
+        HELIUM_ASSERT( cullDataIndex < m_cullData.GetSize() );
+        SortVisibleSubMeshes(
+            pass,
+            m_sceneViews[ viewIndex ].GetForward(),
+            m_cullData[ cullDataIndex ].subMeshIndices,
+            rPassData );
+    }
+}
+
+/// Build a list of the sub-meshes belonging to the scene objects visible within a culling frustum.
+///
+/// @param[in,out] rCullData  Culling data containing the IDs of the visible scene objects, and in which to store the
+///                           list of visible sub-mesh indices (unsorted).
+void GraphicsScene::GatherVisibleSubMeshes( CullData& rCullData ) const
+{
+    BitArray<>& rVisibleSceneObjects = rCullData.visibleSceneObjects;
+
+    size_t sceneObjectCount = m_sceneObjects.GetSize();
+    rVisibleSceneObjects.Reserve( sceneObjectCount );
+    rVisibleSceneObjects.Resize( sceneObjectCount );
+    rVisibleSceneObjects.UnsetAll();
+
+    const DynamicArray< uint32_t >& rVisibleObjectIds = rCullData.visibleSceneObjectIds;
+    size_t visibleObjectCount = rVisibleObjectIds.GetSize();
+    for( size_t visibleIndex = 0; visibleIndex < visibleObjectCount; ++visibleIndex )
+    {
+        size_t sceneObjectIndex = rVisibleObjectIds[ visibleIndex ];
+        HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectIndex ) );
+        rVisibleSceneObjects.SetElement( sceneObjectIndex );
+    }
+
+    DynamicArray< uint32_t >& rSubMeshIndices = rCullData.subMeshIndices;
+    rSubMeshIndices.Resize( 0 );
+
+    size_t subMeshCount = m_sceneObjectSubMeshes.GetSize();
+    for( size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex )
+    {
+        if( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) )
+        {
+            size_t sceneObjectId = m_sceneObjectSubMeshes[ subMeshIndex ].GetSceneObjectId();
+            HELIUM_ASSERT( sceneObjectId < rVisibleSceneObjects.GetSize() );
+            if( rVisibleSceneObjects[ sceneObjectId ] )
+            {
+                rSubMeshIndices.Push( static_cast< uint32_t >( subMeshIndex ) );
+            }
+        }
+    }
+}
+
+/// Compute the key used to sort a sub-mesh within a draw pass.
+///
+/// Depth pass keys sort sub-meshes from front to back, while base pass keys sort them by shader and material, then
+/// roughly from front to back.  Sub-meshes using the same resources are grouped together where possible.
+///
+/// @param[in] pass                  Draw pass in which the sub-mesh is drawn.
+/// @param[in] depth                 Depth of the sub-mesh along the view direction (may be negative).
+/// @param[in] pVertexBuffer         Sub-mesh vertex buffer.
+/// @param[in] pMaterial             Sub-mesh material (only used for the base pass).
+/// @param[in] pVertexShaderVariant  Material vertex shader variant (only used for the base pass).
+/// @param[in] pPixelShaderVariant   Material pixel shader variant (only used for the base pass).
+///
+/// @return  Draw key for the sub-mesh.  Keys for all passes can be sorted together as unsigned integers.
+///
+/// @see SortVisibleSubMeshes()
+uint64_t GraphicsScene::ComputeDrawKey(
+    EDrawPass pass,
+    float32_t depth,
+    const RVertexBuffer* pVertexBuffer,
+    const Material* pMaterial,
+    const ShaderVariant* pVertexShaderVariant,
+    const ShaderVariant* pPixelShaderVariant )
+{
+    HELIUM_COMPILE_ASSERT( DRAW_PASS_MAX <= ( 1 << ( 64 - DRAW_KEY_PASS_SHIFT ) ) );
+    HELIUM_ASSERT( static_cast< size_t >( pass ) < DRAW_PASS_MAX );
+
+    uint64_t passKey = static_cast< uint64_t >( pass ) << DRAW_KEY_PASS_SHIFT;
+    uint64_t sortableDepth = ComputeSortableDepth( depth );
+
+    if( pass != DRAW_PASS_BASE )
+    {
+        return
+            passKey |
+            ( sortableDepth << DRAW_KEY_DEPTH_SHIFT ) |
+            ComputeDrawKeyResourceId( pVertexBuffer, DRAW_KEY_DEPTH_BUFFER_BITS );
+    }
+
+    uint64_t shaderId =
+        ComputeDrawKeyResourceId( pVertexShaderVariant, DRAW_KEY_SHADER_BITS ) ^
+        ComputeDrawKeyResourceId( pPixelShaderVariant, DRAW_KEY_SHADER_BITS );
+
+    return
+        passKey |
+        ( shaderId << DRAW_KEY_SHADER_SHIFT ) |
+        ( ComputeDrawKeyResourceId( pMaterial, DRAW_KEY_MATERIAL_BITS ) << DRAW_KEY_MATERIAL_SHIFT ) |
+        ( ( sortableDepth >> ( 32 - DRAW_KEY_DEPTH_BUCKET_BITS ) ) << DRAW_KEY_DEPTH_BUCKET_SHIFT ) |
+        ComputeDrawKeyResourceId( pVertexBuffer, DRAW_KEY_BASE_BUFFER_BITS );
+}
+
+/// Sort the list of visible sub-meshes for a draw pass.
+///
+/// A 64-bit draw key is computed for each sub-mesh in a single pass over the sub-mesh list (see ComputeDrawKey()),
+/// after which the keys are sorted using a radix sort.
+///
+/// @param[in]     pass             Draw pass for which to sort.
+/// @param[in]     rViewDirection   View direction, used for front-to-back sorting.
+/// @param[in]     rSubMeshIndices  Indices of the visible sub-meshes (unsorted).
+/// @param[in,out] rPassData        Draw pass data in which to store the sorted sub-mesh indices.
+void GraphicsScene::SortVisibleSubMeshes(
+    EDrawPass pass,
+    const Simd::Vector3& rViewDirection,
+    const DynamicArray< uint32_t >& rSubMeshIndices,
+    DrawPassData& rPassData ) const
+{
+    HELIUM_ASSERT( static_cast< size_t >( pass ) < DRAW_PASS_MAX );
+
+    size_t subMeshIndexCount = rSubMeshIndices.GetSize();
+
+    rPassData.drawKeys.Reserve( subMeshIndexCount );
+    rPassData.drawKeys.Resize( subMeshIndexCount );
+    rPassData.sortedSubMeshIndices.Reserve( subMeshIndexCount );
+    rPassData.sortedSubMeshIndices.Resize( subMeshIndexCount );
+
+    uint64_t* pKeys = rPassData.drawKeys.GetData();
+    uint32_t* pSortedSubMeshIndices = rPassData.sortedSubMeshIndices.GetData();
+
+    bool bBasePass = ( pass == DRAW_PASS_BASE );
+
+    for( size_t indexIndex = 0; indexIndex < subMeshIndexCount; ++indexIndex )
+    {
+        uint32_t subMeshIndex = rSubMeshIndices[ indexIndex ];
+        HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) );
+        const GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ subMeshIndex ];
+
+        size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
+        HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+        const GraphicsSceneObject& rSceneObject = m_sceneObjects[ sceneObjectId ];
+
+        Simd::Vector3 position = Simd::Vector4ToVector3( rSceneObject.GetTransform().GetRow( 3 ) );
+
+        const Material* pMaterial = NULL;
+        const ShaderVariant* pVertexShaderVariant = NULL;
+        const ShaderVariant* pPixelShaderVariant = NULL;
+        if( bBasePass )
+        {
+            pMaterial = rSubMeshData.GetMaterial();
+            if( pMaterial )
+            {
+                pVertexShaderVariant = pMaterial->GetShaderVariant( RShader::TYPE_VERTEX );
+                pPixelShaderVariant = pMaterial->GetShaderVariant( RShader::TYPE_PIXEL );
+            }
+        }
+
+        pKeys[ indexIndex ] = ComputeDrawKey(
+            pass,
+            position.Dot( rViewDirection ),
+            rSceneObject.GetVertexBuffer(),
+            pMaterial,
+            pVertexShaderVariant,
+            pPixelShaderVariant );
+        pSortedSubMeshIndices[ indexIndex ] = subMeshIndex;
+    }
+
+    rPassData.drawKeySortScratch.Reserve( subMeshIndexCount );
+    rPassData.drawKeySortScratch.Resize( subMeshIndexCount );
+    rPassData.subMeshIndexSortScratch.Reserve( subMeshIndexCount );
+    rPassData.subMeshIndexSortScratch.Resize( subMeshIndexCount );
+
+    {
+        JobContext::Spawner< 1 > rootSpawner;
+
+        JobContext* pContext = rootSpawner.Allocate();
+        HELIUM_ASSERT( pContext );
+        RadixSortJob* pJob = pContext->Create< RadixSortJob >();
+        HELIUM_ASSERT( pJob );
+
+        RadixSortJob::Parameters& rParameters = pJob->GetParameters();
+        rParameters.pKeys = pKeys;
+        rParameters.pValues = pSortedSubMeshIndices;
+        rParameters.pScratchKeys = rPassData.drawKeySortScratch.GetData();
+        rParameters.pScratchValues = rPassData.subMeshIndexSortScratch.GetData();
+        rParameters.count = subMeshIndexCount;
+    }
+}
+
 /// Draw the shadow depth render pass.
 ///
-/// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
-///   meshes.  This function will sort by depth if rendering is performed.
+/// - The sub-meshes of the scene objects within the shadow view frustum (see CullSceneViews()) are sorted by depth if
+///   rendering is performed.
 /// - Default rasterizer and depth states should be already set.
 ///
-/// @param[in] viewIndex  Index of the view for which the shadow depth pass is being rendered.
+/// @param[in] viewIndex      Index of the view for which the shadow depth pass is being rendered.
+/// @param[in] rPassData      Sorting data for the shadow depth pass of the given view.
+/// @param[in] pCommandProxy  Command proxy to which the pass commands should be issued.
 ///
 /// @see DrawDepthPrePass(), DrawBasePass()
-void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
+void GraphicsScene::DrawShadowDepthPass(
+    uint_fast32_t viewIndex,
+    DrawPassData& rPassData,
+    RRenderCommandProxy* pCommandProxy )
 {
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
     HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
@@ -1427,63 +2036,47 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
     RSurfacePtr spShadowDepthTextureSurface = pShadowDepthTexture->GetSurface( 0 );
     HELIUM_ASSERT( spShadowDepthTextureSurface );
 
-    // Sort meshes based on distance from front to back in order to reduce overdraw.
-    size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
-
-    {
-        JobContext::Spawner< 1 > rootSpawner;
+    // Gather the sub-meshes of the scene objects within the shadow view frustum, sorted based on distance from front
+    // to back in order to reduce overdraw.
+    PrepareDrawPass( viewIndex, DRAW_PASS_SHADOW_DEPTH, rPassData );
 
-        JobContext* pContext = rootSpawner.Allocate();
-        HELIUM_ASSERT( pContext );
-        SortJob< size_t, SubMeshFrontToBackCompare >* pJob =
-            pContext->Create< SortJob< size_t, SubMeshFrontToBackCompare > >();
-        HELIUM_ASSERT( pJob );
-
-        SortJob< size_t, SubMeshFrontToBackCompare >::Parameters& rParameters = pJob->GetParameters();
-        rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-        rParameters.count = subMeshIndexCount;
-        rParameters.compare = SubMeshFrontToBackCompare(
-            m_directionalLightDirection,
-            m_sceneObjects,
-            m_sceneObjectSubMeshes );
-        rParameters.singleJobCount = 100;
-    }
+    size_t subMeshIndexCount = rPassData.sortedSubMeshIndices.GetSize();
+    const uint32_t* pSortedSubMeshIndices = rPassData.sortedSubMeshIndices.GetData();
 
     // Prepare the shadow depth pass scene for rendering.
     Renderer* pRenderer = Renderer::GetStaticInstance();
     HELIUM_ASSERT( pRenderer );
 
-    RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
-    HELIUM_ASSERT( spCommandProxy );
+    HELIUM_ASSERT( pCommandProxy );
 
     RTexture2d* pSceneTexture = rRenderResourceManager.GetSceneTexture();
     HELIUM_ASSERT( pSceneTexture );
     RSurfacePtr spSceneTextureSurface = pSceneTexture->GetSurface( 0 );
     HELIUM_ASSERT( spSceneTextureSurface );
 
-    spCommandProxy->SetRenderSurfaces( spSceneTextureSurface, spShadowDepthTextureSurface );
-    spCommandProxy->SetViewport( 0, 0, shadowDepthTextureUsableSize, shadowDepthTextureUsableSize );
+    pCommandProxy->SetRenderSurfaces( spSceneTextureSurface, spShadowDepthTextureSurface );
+    pCommandProxy->SetViewport( 0, 0, shadowDepthTextureUsableSize, shadowDepthTextureUsableSize );
 
     RRasterizerState* pRasterizerStateShadowDepth = rRenderResourceManager.GetRasterizerState(
         RenderResourceManager::RASTERIZER_STATE_SHADOW_DEPTH );
-    spCommandProxy->SetRasterizerState( pRasterizerStateShadowDepth );
+    pCommandProxy->SetRasterizerState( pRasterizerStateShadowDepth );
 
     RBlendState* pBlendStateNoColor = rRenderResourceManager.GetBlendState(
         RenderResourceManager::BLEND_STATE_NO_COLOR );
-    spCommandProxy->SetBlendState( pBlendStateNoColor );
+    pCommandProxy->SetBlendState( pBlendStateNoColor );
 
     // Draw the scene.
-    spCommandProxy->BeginScene();
-    spCommandProxy->Clear( RENDERER_CLEAR_FLAG_DEPTH );
+    pCommandProxy->BeginScene();
+    pCommandProxy->Clear( RENDERER_CLEAR_FLAG_DEPTH );
 
-    spCommandProxy->SetVertexConstantBuffers( 0, 1, &pShadowViewVertexDataBuffer );
-    spCommandProxy->SetPixelShader( NULL );
+    pCommandProxy->SetVertexConstantBuffers( 0, 1, &pShadowViewVertexDataBuffer );
+    pCommandProxy->SetPixelShader( NULL );
 
     RVertexShader* pPreviousVertexShader = NULL;
 
     for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
     {
-        size_t meshIndex = m_sceneObjectSubMeshIndices[ meshIndexIndex ];
+        size_t meshIndex = pSortedSubMeshIndices[ meshIndexIndex ];
         HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
 
         GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ meshIndex ];
@@ -1535,8 +2128,7 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
             pVertexShader = pPrePassSmoothSkinningVertexShader;
         }
 
-        pVertexShader->CacheDescription( pRenderer, pVertexDescription );
-        RVertexInputLayout* pInputLayout = pVertexShader->GetCachedInputLayout();
+        RVertexInputLayout* pInputLayout = pVertexShader->GetInputLayout( pRenderer, pVertexDescription );
         if( !pInputLayout )
         {
             continue;
@@ -1553,16 +2145,16 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 
         if( pPreviousVertexShader != pVertexShader )
         {
-            spCommandProxy->SetVertexShader( pVertexShader );
+            pCommandProxy->SetVertexShader( pVertexShader );
             pPreviousVertexShader = pVertexShader;
         }
 
-        spCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
-        spCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
-        spCommandProxy->SetIndexBuffer( pIndexBuffer );
-        spCommandProxy->SetVertexInputLayout( pInputLayout );
+        pCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
+        pCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
+        pCommandProxy->SetIndexBuffer( pIndexBuffer );
+        pCommandProxy->SetVertexInputLayout( pInputLayout );
 
-        spCommandProxy->DrawIndexed(
+        pCommandProxy->DrawIndexed(
             primitiveType,
             startVertex,
             0,
@@ -1571,21 +2163,26 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
             primitiveCount );
     }
 
-    spCommandProxy->EndScene();
+    pCommandProxy->EndScene();
 }
 
 /// Draw the depth-only pre-pass for the given scene view.
 ///
-/// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
-///   meshes.  This function will sort by depth if rendering is performed.
+/// - The sub-meshes of the scene objects within the view frustum (see CullSceneViews()) are sorted by depth if
+///   rendering is performed.
 /// - Standard viewport render surfaces are expected to have already been set, with the depth buffer cleared.
 /// - Default rasterizer and depth states should be already set.
 /// - Global per-view constant buffers should be already set.
 ///
-/// @param[in] viewIndex  Index of the view for which the depth-only pre-pass is being rendered.
+/// @param[in] viewIndex      Index of the view for which the depth-only pre-pass is being rendered.
+/// @param[in] rPassData      Sorting data for the depth-only pre-pass of the given view.
+/// @param[in] pCommandProxy  Command proxy to which the pass commands should be issued.
 ///
 /// @see DrawShadowDepthPass(), DrawBasePass()
-void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
+void GraphicsScene::DrawDepthPrePass(
+    uint_fast32_t viewIndex,
+    DrawPassData& rPassData,
+    RRenderCommandProxy* pCommandProxy )
 {
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
     HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
@@ -1635,47 +2232,30 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
     HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
     RVertexShader* pPrePassSmoothSkinningVertexShader = static_cast< RVertexShader* >( pPrePassShaderResource );
 
-    // Sort meshes based on distance from front to back in order to reduce overdraw.
-    GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
-    const Simd::Vector3& rViewDirection = rView.GetForward();
-
-    size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
-
-    {
-        JobContext::Spawner< 1 > rootSpawner;
-
-        JobContext* pContext = rootSpawner.Allocate();
-        HELIUM_ASSERT( pContext );
-        SortJob< size_t, SubMeshFrontToBackCompare >* pJob =
-            pContext->Create< SortJob< size_t, SubMeshFrontToBackCompare > >();
-        HELIUM_ASSERT( pJob );
+    // Gather the sub-meshes of the visible scene objects, sorted from front to back in order to reduce overdraw.
+    PrepareDrawPass( viewIndex, DRAW_PASS_DEPTH_PRE_PASS, rPassData );
 
-        SortJob< size_t, SubMeshFrontToBackCompare >::Parameters& rParameters = pJob->GetParameters();
-        rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-        rParameters.count = subMeshIndexCount;
-        rParameters.compare = SubMeshFrontToBackCompare( rViewDirection, m_sceneObjects, m_sceneObjectSubMeshes );
-        rParameters.singleJobCount = 100;
-    }
+    size_t subMeshIndexCount = rPassData.sortedSubMeshIndices.GetSize();
+    const uint32_t* pSortedSubMeshIndices = rPassData.sortedSubMeshIndices.GetData();
 
     // Initialize the blend state and shaders for performing no color writes.
     Renderer* pRenderer = Renderer::GetStaticInstance();
     HELIUM_ASSERT( pRenderer );
 
-    RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
-    HELIUM_ASSERT( spCommandProxy );
+    HELIUM_ASSERT( pCommandProxy );
 
     RBlendState* pBlendStateNoColor = rRenderResourceManager.GetBlendState(
         RenderResourceManager::BLEND_STATE_NO_COLOR );
-    spCommandProxy->SetBlendState( pBlendStateNoColor );
+    pCommandProxy->SetBlendState( pBlendStateNoColor );
 
-    spCommandProxy->SetPixelShader( NULL );
+    pCommandProxy->SetPixelShader( NULL );
 
     // Draw each visible mesh instance.
     RVertexShader* pPreviousVertexShader = NULL;
 
     for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
     {
-        size_t meshIndex = m_sceneObjectSubMeshIndices[ meshIndexIndex ];
+        size_t meshIndex = pSortedSubMeshIndices[ meshIndexIndex ];
         HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
 
         GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ meshIndex ];
@@ -1727,8 +2307,7 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
             pVertexShader = pPrePassSmoothSkinningVertexShader;
         }
 
-        pVertexShader->CacheDescription( pRenderer, pVertexDescription );
-        RVertexInputLayout* pInputLayout = pVertexShader->GetCachedInputLayout();
+        RVertexInputLayout* pInputLayout = pVertexShader->GetInputLayout( pRenderer, pVertexDescription );
         if( !pInputLayout )
         {
             continue;
@@ -1745,16 +2324,16 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 
         if( pPreviousVertexShader != pVertexShader )
         {
-            spCommandProxy->SetVertexShader( pVertexShader );
+            pCommandProxy->SetVertexShader( pVertexShader );
             pPreviousVertexShader = pVertexShader;
         }
 
-        spCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
-        spCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
-        spCommandProxy->SetIndexBuffer( pIndexBuffer );
-        spCommandProxy->SetVertexInputLayout( pInputLayout );
+        pCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
+        pCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
+        pCommandProxy->SetIndexBuffer( pIndexBuffer );
+        pCommandProxy->SetVertexInputLayout( pInputLayout );
 
-        spCommandProxy->DrawIndexed(
+        pCommandProxy->DrawIndexed(
             primitiveType,
             startVertex,
             0,
@@ -1766,18 +2345,20 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 
 /// Draw the base pass for the given scene view.
 ///
-/// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
-///   meshes.  This function will sort as appropriate if rendering is performed.
+/// - Scene objects are culled against the view frustum, and the sub-meshes of the objects found to be visible are
+///   sorted by shader and material if rendering is performed.
 /// - Standard viewport render surfaces are expected to have already been set, with the depth buffer either cleared
 ///   or prepared by the depth-only pre-pass.
 /// - Default rasterizer and depth states should be already set.
 /// - Global per-view constant buffers should be already set (buffers specific to the base pass will be set by this
 ///   function).
 ///
-/// @param[in] viewIndex  Index of the view for which the base pass is being rendered.
+/// @param[in] viewIndex      Index of the view for which the base pass is being rendered.
+/// @param[in] rPassData      Sorting data for the base pass of the given view.
+/// @param[in] pCommandProxy  Command proxy to which the pass commands should be issued.
 ///
 /// @see DrawShadowDepthPass(), DrawDepthPrePass()
-void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
+void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex, DrawPassData& rPassData, RRenderCommandProxy* pCommandProxy )
 {
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
     HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
@@ -1797,10 +2378,9 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
         return;
     }
 
-    // Build the list of system options for retrieving the proper material shader variant to use for rendering.
-    static Name shadowsSysSelectName( TXT( "SHADOWS" ) );
-
-    static const Name shadowSelectOptions[] =
+    // Build the list of system options for retrieving the proper material shader variant to use for rendering (note
+    // that this can run on multiple threads at once, so we avoid caching names in function-local static variables).
+    const Name shadowSelectOptions[] =
     {
         GetNoneOptionName(),
         Name( TXT( "SHADOWS_SIMPLE" ) ),
@@ -1825,38 +2405,25 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 
     systemSelections[ 0 ].choice = shadowSelectOptions[ shadowMode ];
 
-    // Sort meshes based on material in order to reduce shader switches.
-    size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
+    // Gather the sub-meshes of the visible scene objects, sorted by shader and material in order to reduce state
+    // changes.
+    PrepareDrawPass( viewIndex, DRAW_PASS_BASE, rPassData );
 
-    {
-        JobContext::Spawner< 1 > rootSpawner;
-
-        JobContext* pContext = rootSpawner.Allocate();
-        HELIUM_ASSERT( pContext );
-        SortJob< size_t, SubMeshMaterialCompare >* pJob =
-            pContext->Create< SortJob< size_t, SubMeshMaterialCompare > >();
-        HELIUM_ASSERT( pJob );
-
-        SortJob< size_t, SubMeshMaterialCompare >::Parameters& rParameters = pJob->GetParameters();
-        rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-        rParameters.count = subMeshIndexCount;
-        rParameters.compare = SubMeshMaterialCompare( m_sceneObjectSubMeshes );
-        rParameters.singleJobCount = 100;
-    }
+    size_t subMeshIndexCount = rPassData.sortedSubMeshIndices.GetSize();
+    const uint32_t* pSortedSubMeshIndices = rPassData.sortedSubMeshIndices.GetData();
 
     // Set the opaque rendering blend state and per-view constant buffers for this pass.
     Renderer* pRenderer = Renderer::GetStaticInstance();
     HELIUM_ASSERT( pRenderer );
 
-    RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
-    HELIUM_ASSERT( spCommandProxy );
+    HELIUM_ASSERT( pCommandProxy );
 
     RBlendState* pBlendStateOpaque = rRenderResourceManager.GetBlendState(
         RenderResourceManager::BLEND_STATE_OPAQUE );
-    spCommandProxy->SetBlendState( pBlendStateOpaque );
+    pCommandProxy->SetBlendState( pBlendStateOpaque );
 
-    spCommandProxy->SetVertexConstantBuffers( 1, 1, &pViewVertexBasePassDataBuffer );
-    spCommandProxy->SetPixelConstantBuffers( 0, 1, &pViewPixelBasePassDataBuffer );
+    pCommandProxy->SetVertexConstantBuffers( 1, 1, &pViewVertexBasePassDataBuffer );
+    pCommandProxy->SetPixelConstantBuffers( 0, 1, &pViewPixelBasePassDataBuffer );
 
     // Draw each visible sub-mesh.
     Name defaultSamplerStateName = GetDefaultSamplerStateName();
@@ -1879,7 +2446,7 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 
     for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
     {
-        size_t meshIndex = m_sceneObjectSubMeshIndices[ meshIndexIndex ];
+        size_t meshIndex = pSortedSubMeshIndices[ meshIndexIndex ];
         HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
 
         GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ meshIndex ];
@@ -1982,8 +2549,7 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
             continue;
         }
 
-        pVertexShader->CacheDescription( pRenderer, pVertexDescription );
-        RVertexInputLayout* pInputLayout = pVertexShader->GetCachedInputLayout();
+        RVertexInputLayout* pInputLayout = pVertexShader->GetInputLayout( pRenderer, pVertexDescription );
         if( !pInputLayout )
         {
             continue;
@@ -2003,36 +2569,36 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
         uint32_t vertexRange = rSubMeshData.GetVertexRange();
         uint32_t startIndex = rSubMeshData.GetStartIndex();
 
-        spCommandProxy->SetVertexConstantBuffers( 2, 1, &pInstanceVertexGlobalDataBuffer );
+        pCommandProxy->SetVertexConstantBuffers( 2, 1, &pInstanceVertexGlobalDataBuffer );
 
         if( pMaterialVertexConstantBuffer != pPreviousMaterialVertexConstantBuffer )
         {
-            spCommandProxy->SetVertexConstantBuffers( 3, 1, &pMaterialVertexConstantBuffer );
+            pCommandProxy->SetVertexConstantBuffers( 3, 1, &pMaterialVertexConstantBuffer );
             pPreviousMaterialVertexConstantBuffer = pMaterialVertexConstantBuffer;
         }
 
         if( pMaterialPixelConstantBuffer != pPreviousMaterialPixelConstantBuffer )
         {
-            spCommandProxy->SetPixelConstantBuffers( 1, 1, &pMaterialPixelConstantBuffer );
+            pCommandProxy->SetPixelConstantBuffers( 1, 1, &pMaterialPixelConstantBuffer );
             pPreviousMaterialPixelConstantBuffer = pMaterialPixelConstantBuffer;
         }
 
-        spCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
-        spCommandProxy->SetIndexBuffer( pIndexBuffer );
+        pCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
+        pCommandProxy->SetIndexBuffer( pIndexBuffer );
 
         if( pVertexShader != pPreviousVertexShader )
         {
-            spCommandProxy->SetVertexShader( pVertexShader );
+            pCommandProxy->SetVertexShader( pVertexShader );
             pPreviousVertexShader = pVertexShader;
         }
 
         if( pPixelShader != pPreviousPixelShader )
         {
-            spCommandProxy->SetPixelShader( pPixelShader );
+            pCommandProxy->SetPixelShader( pPixelShader );
             pPreviousPixelShader = pPixelShader;
         }
 
-        spCommandProxy->SetVertexInputLayout( pInputLayout );
+        pCommandProxy->SetVertexInputLayout( pInputLayout );
 
         const ShaderSamplerInfoSet* pSamplerInfoSet = pPixelShaderVariant->GetSamplerInfoSet( 0 );
         if( pSamplerInfoSet )
@@ -2055,7 +2621,7 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
                     pSamplerState = pSamplerStateShadowMap;
                 }
 
-                spCommandProxy->SetSamplerStates( rInputInfo.bindIndex, 1, &pSamplerState );
+                pCommandProxy->SetSamplerStates( rInputInfo.bindIndex, 1, &pSamplerState );
             }
         }
 
@@ -2098,11 +2664,11 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
                     }
                 }
 
-                spCommandProxy->SetTexture( rInputInfo.bindIndex, pTextureResource );
+                pCommandProxy->SetTexture( rInputInfo.bindIndex, pTextureResource );
             }
         }
 
-        spCommandProxy->DrawIndexed(
+        pCommandProxy->DrawIndexed(
             primitiveType,
             startVertex,
             0,
@@ -2158,111 +2724,42 @@ Name GraphicsScene::GetSkinningRigidOptionName()
     return skinningRigidOptionName;
 }
 
-/// Constructor.
-GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare()
-: m_cameraDirection( 0.0f )
-, m_pSceneObjects( NULL )
-, m_pSubMeshes( NULL )
-{
-}
-
-/// Constructor.
-///
-/// @param[in] rCameraDirection  Camera world direction.
-/// @param[in] rSceneObjects     List of graphics scene objects in the scene.
-/// @param[in] rSubMeshes        List of scene object sub-meshes in the scene.
-GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare(
-    const Simd::Vector3& rCameraDirection,
-    const SparseArray< GraphicsSceneObject >& rSceneObjects,
-    const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes )
-    : m_cameraDirection( rCameraDirection )
-    , m_pSceneObjects( &rSceneObjects )
-    , m_pSubMeshes( &rSubMeshes )
-{
-}
-
-/// Compare two sub-meshes for sorting.
-///
-/// @param[in] subMeshIndex0  Index of the first sub-mesh to compare.
-/// @param[in] subMeshIndex1  Index of the second sub-mesh to compare.
-///
-/// @return  True if the first sub-mesh should be sorted before the second, false if it should be sorted after or if
-///          they share the same sorting priority.
-bool GraphicsScene::SubMeshFrontToBackCompare::operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const
-{
-    const GraphicsSceneObject::SubMeshData& rSubMesh0 = m_pSubMeshes->GetElement( subMeshIndex0 );
-    const GraphicsSceneObject::SubMeshData& rSubMesh1 = m_pSubMeshes->GetElement( subMeshIndex1 );
-
-    size_t sceneObjectIndex0 = rSubMesh0.GetSceneObjectId();
-    HELIUM_ASSERT( m_pSceneObjects->IsElementValid( sceneObjectIndex0 ) );
-    size_t sceneObjectIndex1 = rSubMesh1.GetSceneObjectId();
-    HELIUM_ASSERT( m_pSceneObjects->IsElementValid( sceneObjectIndex1 ) );
-
-    const GraphicsSceneObject& rSceneObject0 = m_pSceneObjects->GetElement( sceneObjectIndex0 );
-    const GraphicsSceneObject& rSceneObject1 = m_pSceneObjects->GetElement( sceneObjectIndex1 );
-
-    Simd::Vector3 object0Pos = Simd::Vector4ToVector3( rSceneObject0.GetTransform().GetRow( 3 ) );
-    Simd::Vector3 object1Pos = Simd::Vector4ToVector3( rSceneObject1.GetTransform().GetRow( 3 ) );
-
-    float distance0 = object0Pos.Dot( m_cameraDirection );
-    float distance1 = object1Pos.Dot( m_cameraDirection );
-
-    return ( distance0 < distance1 );
-}
-
-/// Constructor.
-GraphicsScene::SubMeshMaterialCompare::SubMeshMaterialCompare()
-: m_pSubMeshes( NULL )
-{
-}
-
-/// Constructor.
+/// ParallelForJob work function for culling a single frustum of a scene view.
 ///
-/// @param[in] rSubMeshes  List of scene object sub-meshes in the scene.
-GraphicsScene::SubMeshMaterialCompare::SubMeshMaterialCompare(
-    const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes )
-    : m_pSubMeshes( &rSubMeshes )
+/// @param[in] pScene  Scene being culled.
+/// @param[in] index   Index of the culling data index in the list of frustums being culled.
+void GraphicsScene::CullSceneViewFrustumWorkItem( void* pScene, size_t index )
 {
+    HELIUM_ASSERT( pScene );
+    GraphicsScene* pGraphicsScene = static_cast< GraphicsScene* >( pScene );
+    HELIUM_ASSERT( index < pGraphicsScene->m_cullDataIndices.GetSize() );
+
+    uint32_t cullDataIndex = pGraphicsScene->m_cullDataIndices[ index ];
+    pGraphicsScene->CullSceneViewFrustum(
+        cullDataIndex / CULL_FRUSTUM_MAX,
+        static_cast< ECullFrustum >( cullDataIndex % CULL_FRUSTUM_MAX ) );
 }
 
-/// Compare two sub-meshes for sorting.
+/// ParallelForJob work function for recording a single draw pass to its deferred command list.
 ///
-/// @param[in] subMeshIndex0  Index of the first sub-mesh to compare.
-/// @param[in] subMeshIndex1  Index of the second sub-mesh to compare.
-///
-/// @return  True if the first sub-mesh should be sorted before the second, false if it should be sorted after or if
-///          they share the same sorting priority.
-bool GraphicsScene::SubMeshMaterialCompare::operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const
+/// @param[in] pScene  Scene being drawn.
+/// @param[in] index   Index of the draw pass data index in the list of draw passes being recorded.
+void GraphicsScene::RecordDrawPassWorkItem( void* pScene, size_t index )
 {
-    const GraphicsSceneObject::SubMeshData& rSubMesh0 = m_pSubMeshes->GetElement( subMeshIndex0 );
-    const GraphicsSceneObject::SubMeshData& rSubMesh1 = m_pSubMeshes->GetElement( subMeshIndex1 );
-
-    Material* pMaterial0 = rSubMesh0.GetMaterial();
-    Material* pMaterial1 = rSubMesh1.GetMaterial();
-    if( pMaterial0 == pMaterial1 )
-    {
-        return false;
-    }
-
-    if( !pMaterial0 )
-    {
-        return true;
-    }
-
-    if( !pMaterial1 )
-    {
-        return false;
-    }
-
-    ShaderVariant* pVariant0 = pMaterial0->GetShaderVariant( RShader::TYPE_VERTEX );
-    ShaderVariant* pVariant1 = pMaterial1->GetShaderVariant( RShader::TYPE_VERTEX );
-    if( pVariant0 != pVariant1 )
-    {
-        return ( pVariant0 < pVariant1 );
-    }
-
-    pVariant0 = pMaterial0->GetShaderVariant( RShader::TYPE_PIXEL );
-    pVariant1 = pMaterial1->GetShaderVariant( RShader::TYPE_PIXEL );
-
-    return ( pVariant0 < pVariant1 );
+    HELIUM_ASSERT( pScene );
+    GraphicsScene* pGraphicsScene = static_cast< GraphicsScene* >( pScene );
+    HELIUM_ASSERT( index < pGraphicsScene->m_recordPassDataIndices.GetSize() );
+
+    uint32_t passDataIndex = pGraphicsScene->m_recordPassDataIndices[ index ];
+    HELIUM_ASSERT( passDataIndex < pGraphicsScene->m_drawPassData.GetSize() );
+    DrawPassData& rPassData = pGraphicsScene->m_drawPassData[ passDataIndex ];
+
+    RRenderCommandProxy* pCommandProxy = rPassData.spCommandProxy;
+    HELIUM_ASSERT( pCommandProxy );
+
+    pGraphicsScene->RecordDrawPass(
+        passDataIndex / DRAW_PASS_MAX,
+        static_cast< EDrawPass >( passDataIndex % DRAW_PASS_MAX ),
+        pCommandProxy );
+    pCommandProxy->FinishCommandList( rPassData.spCommandList );
 }
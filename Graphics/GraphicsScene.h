@@ -16,6 +16,8 @@
 #include "Rendering/RRenderResource.h"
 #include "GraphicsTypes/GraphicsSceneObject.h"
 #include "GraphicsTypes/GraphicsSceneView.h"
+#include "Graphics/SceneBoundsStream.h"
+#include "Graphics/DynamicAabbTree.h"
 
 #if !HELIUM_RELEASE && !HELIUM_PROFILE
 #include "Foundation/ObjectPool.h"
@@ -24,14 +26,41 @@
 
 namespace Helium
 {
+    class ShaderVariant;
+
     HELIUM_DECLARE_RPTR( RConstantBuffer );
+    HELIUM_DECLARE_RPTR( RRenderCommandProxy );
+    HELIUM_DECLARE_RPTR( RRenderCommandList );
 
     /// Manager for a graphics scene.
+    ///
+    /// By default, culling, sorting, and command recording for each draw pass of each scene view (shadow depth pass,
+    /// depth-only pre-pass, and base pass) are performed as separate jobs, each recording to its own deferred command
+    /// list.  The recorded command lists are then submitted to the immediate command proxy in the same order in which
+    /// the passes would have been drawn serially.  Parallel recording can be disabled in order to draw each pass
+    /// directly through the immediate command proxy, which is useful for debugging.
     class HELIUM_GRAPHICS_API GraphicsScene : public GameObject
     {
         HELIUM_DECLARE_OBJECT( GraphicsScene, GameObject );
 
     public:
+        /// Draw passes, in the order in which they are submitted for each view.
+        enum EDrawPass
+        {
+            DRAW_PASS_FIRST   =  0,
+            DRAW_PASS_INVALID = -1,
+
+            /// Shadow depth pass.
+            DRAW_PASS_SHADOW_DEPTH,
+            /// Depth-only pre-pass.
+            DRAW_PASS_DEPTH_PRE_PASS,
+            /// Base pass.
+            DRAW_PASS_BASE,
+
+            DRAW_PASS_MAX,
+            DRAW_PASS_LAST = DRAW_PASS_MAX - 1
+        };
+
         /// @name Construction/Destruction
         //@{
         GraphicsScene();
@@ -43,6 +72,19 @@ namespace Helium
         virtual void Update();
         //@}
 
+        /// @name Command Recording
+        //@{
+        inline void SetParallelRecordingEnabled( bool bEnabled );
+        inline bool IsParallelRecordingEnabled() const;
+        //@}
+
+        /// @name Draw Sorting
+        //@{
+        static uint64_t ComputeDrawKey(
+            EDrawPass pass, float32_t depth, const RVertexBuffer* pVertexBuffer, const Material* pMaterial,
+            const ShaderVariant* pVertexShaderVariant, const ShaderVariant* pPixelShaderVariant );
+        //@}
+
         /// @name Scene View Management
         //@{
         uint32_t AllocateSceneView();
@@ -66,6 +108,13 @@ namespace Helium
         inline GraphicsSceneObject::SubMeshData* GetSceneObjectSubMeshData( size_t id );
         //@}
 
+        /// @name Visibility Culling
+        //@{
+        void UpdateSceneObjects();
+        void CullSceneObjects(
+            const Simd::Matrix44& rViewProjectionMatrix, DynamicArray< uint32_t >& rVisibleObjectIds ) const;
+        //@}
+
         /// @name Lighting
         //@{
         void SetAmbientLight(
@@ -97,50 +146,52 @@ namespace Helium
         //@}
 
     private:
-        /// Front-to-back sub-mesh sort comparison function
-        class HELIUM_GRAPHICS_API SubMeshFrontToBackCompare
+        /// Frustums against which scene objects are culled for each view.
+        enum ECullFrustum
         {
-        public:
-            /// @name Construction/Destruction
-            //@{
-            SubMeshFrontToBackCompare();
-            SubMeshFrontToBackCompare(
-                const Simd::Vector3& rCameraDirection, const SparseArray< GraphicsSceneObject >& rSceneObjects,
-                const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes );
-            //@}
-
-            /// @name Overloaded Operators
-            //@{
-            bool operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const;
-            //@}
-
-        private:
-            /// Camera direction.
-            Simd::Vector3 m_cameraDirection;
-            /// Scene object list.
-            const SparseArray< GraphicsSceneObject >* m_pSceneObjects;
-            /// Scene object sub-mesh list.
-            const SparseArray< GraphicsSceneObject::SubMeshData >* m_pSubMeshes;
+            CULL_FRUSTUM_FIRST   =  0,
+            CULL_FRUSTUM_INVALID = -1,
+
+            /// Shadow view frustum (used by the shadow depth pass).
+            CULL_FRUSTUM_SHADOW,
+            /// View frustum (shared by the depth-only pre-pass and the base pass).
+            CULL_FRUSTUM_VIEW,
+
+            CULL_FRUSTUM_MAX,
+            CULL_FRUSTUM_LAST = CULL_FRUSTUM_MAX - 1
         };
 
-        /// Material-based sub-mesh sort comparison function
-        class HELIUM_GRAPHICS_API SubMeshMaterialCompare
+        /// Maximum number of jobs to spawn when culling views or recording draw passes in parallel.
+        static const size_t DRAW_PASS_JOB_COUNT_MAX = 16;
+
+        /// Culling data for a single frustum of a single view.
+        struct CullData
         {
-        public:
-            /// @name Construction/Destruction
-            //@{
-            SubMeshMaterialCompare();
-            explicit SubMeshMaterialCompare( const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes );
-            //@}
-
-            /// @name Overloaded Operators
-            //@{
-            bool operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const;
-            //@}
-
-        private:
-            /// Scene object sub-mesh list.
-            const SparseArray< GraphicsSceneObject::SubMeshData >* m_pSubMeshes;
+            /// IDs of the scene objects within the frustum.
+            DynamicArray< uint32_t > visibleSceneObjectIds;
+            /// Flags specifying which scene objects are within the frustum.
+            BitArray<> visibleSceneObjects;
+            /// Indices of the visible sub-meshes (unsorted).
+            DynamicArray< uint32_t > subMeshIndices;
+        };
+
+        /// Sorting and command recording data for a single draw pass of a single view.
+        struct DrawPassData
+        {
+            /// Indices of the visible sub-meshes in draw order.
+            DynamicArray< uint32_t > sortedSubMeshIndices;
+
+            /// Draw sort keys for the visible sub-meshes.
+            DynamicArray< uint64_t > drawKeys;
+            /// Scratch buffer for sorting draw keys.
+            DynamicArray< uint64_t > drawKeySortScratch;
+            /// Scratch buffer for sorting the sub-mesh indices associated with each draw key.
+            DynamicArray< uint32_t > subMeshIndexSortScratch;
+
+            /// Deferred command proxy used to record the pass commands.
+            RRenderCommandProxyPtr spCommandProxy;
+            /// Commands recorded for the current frame (null if the pass has not been recorded).
+            RRenderCommandListPtr spCommandList;
         };
 
         /// Scene view list.
@@ -159,10 +210,25 @@ namespace Helium
         DynamicArray< BufferedDrawer* > m_viewBufferedDrawers;
 #endif  // !HELIUM_RELEASE && !HELIUM_PROFILE
 
-        /// Visible scene objects for the current view.
-        BitArray<> m_visibleSceneObjects;
-        /// Scene object sub-data index list (for sorting during rendering).
-        DynamicArray< size_t > m_sceneObjectSubMeshIndices;
+        /// Scene object bounding sphere stream (indexed by scene object ID).
+        SceneBoundsStream m_sceneObjectBounds;
+        /// Scene object bounding volume hierarchy.
+        DynamicAabbTree m_sceneObjectTree;
+        /// Bounding volume hierarchy leaf node IDs (indexed by scene object ID).
+        DynamicArray< uint32_t > m_sceneObjectTreeLeafIds;
+
+        /// Culling data for each frustum of each view (indexed by view index times CULL_FRUSTUM_MAX plus the frustum).
+        DynamicArray< CullData > m_cullData;
+        /// Indices of the culling data entries being updated for the current frame.
+        DynamicArray< uint32_t > m_cullDataIndices;
+        /// Sorting and command recording data for each draw pass of each view (indexed by view index times
+        /// DRAW_PASS_MAX plus the draw pass).
+        DynamicArray< DrawPassData > m_drawPassData;
+        /// Indices of the draw pass data entries being recorded in parallel for the current frame.
+        DynamicArray< uint32_t > m_recordPassDataIndices;
+        /// True to cull views and record draw passes in parallel, false to cull each view and draw each pass using the
+        /// immediate command proxy on the calling thread.
+        bool m_bParallelRecording;
 
         /// Ambient light top color.
         Color m_ambientLightTopColor;
@@ -224,11 +290,27 @@ namespace Helium
 
         void SwapDynamicConstantBuffers();
 
-        void DrawSceneView( uint_fast32_t viewIndex );
+        bool CanDrawSceneView( size_t viewIndex ) const;
+
+        void CullSceneViews();
+        void CullSceneViewFrustum( uint_fast32_t viewIndex, ECullFrustum frustum );
+        void GatherVisibleSubMeshes( CullData& rCullData ) const;
 
-        void DrawShadowDepthPass( uint_fast32_t viewIndex );
-        void DrawDepthPrePass( uint_fast32_t viewIndex );
-        void DrawBasePass( uint_fast32_t viewIndex );
+        void RecordDrawPassesParallel();
+        void DrawSceneView( uint_fast32_t viewIndex );
+        void SubmitDrawPass( uint_fast32_t viewIndex, EDrawPass pass, RRenderCommandProxy* pCommandProxy );
+        void ReleaseDrawPassCommandLists( uint_fast32_t viewIndex );
+
+        void RecordDrawPass( uint_fast32_t viewIndex, EDrawPass pass, RRenderCommandProxy* pCommandProxy );
+        void PrepareDrawPass( uint_fast32_t viewIndex, EDrawPass pass, DrawPassData& rPassData ) const;
+        void SortVisibleSubMeshes(
+            EDrawPass pass, const Simd::Vector3& rViewDirection, const DynamicArray< uint32_t >& rSubMeshIndices,
+            DrawPassData& rPassData ) const;
+
+        void DrawShadowDepthPass(
+            uint_fast32_t viewIndex, DrawPassData& rPassData, RRenderCommandProxy* pCommandProxy );
+        void DrawDepthPrePass( uint_fast32_t viewIndex, DrawPassData& rPassData, RRenderCommandProxy* pCommandProxy );
+        void DrawBasePass( uint_fast32_t viewIndex, DrawPassData& rPassData, RRenderCommandProxy* pCommandProxy );
         //@}
 
         /// @name Private Static Utility Functions
@@ -238,6 +320,9 @@ namespace Helium
         static Name GetSkinningSysSelectName();
         static Name GetSkinningSmoothOptionName();
         static Name GetSkinningRigidOptionName();
+
+        static void CullSceneViewFrustumWorkItem( void* pScene, size_t index );
+        static void RecordDrawPassWorkItem( void* pScene, size_t index );
         //@}
     };
 }
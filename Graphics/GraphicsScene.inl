@@ -7,6 +7,31 @@
 
 namespace Helium
 {
+    /// Set whether draw passes should be recorded in parallel.
+    ///
+    /// When parallel recording is disabled, each view is culled and each draw pass is sorted and drawn serially using
+    /// the immediate command proxy.  The resulting command stream is the same in either case.
+    ///
+    /// @param[in] bEnabled  True to record draw passes in parallel to deferred command lists, false to draw each pass
+    ///                      directly using the immediate command proxy.
+    ///
+    /// @see IsParallelRecordingEnabled()
+    void GraphicsScene::SetParallelRecordingEnabled( bool bEnabled )
+    {
+        m_bParallelRecording = bEnabled;
+    }
+
+    /// Get whether draw passes are recorded in parallel.
+    ///
+    /// @return  True if draw passes are recorded in parallel to deferred command lists, false if each pass is drawn
+    ///          directly using the immediate command proxy.
+    ///
+    /// @see SetParallelRecordingEnabled()
+    bool GraphicsScene::IsParallelRecordingEnabled() const
+    {
+        return m_bParallelRecording;
+    }
+
     /// Access the scene view with the specified ID.
     ///
     /// @param[in] id  ID of the view to retrieve.
@@ -0,0 +1,348 @@
+//----------------------------------------------------------------------------------------------------------------------
+// SceneBoundsStream.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "GraphicsPch.h"
+#include "Graphics/SceneBoundsStream.h"
+
+using namespace Helium;
+
+/// Radius assigned to unused stream entries (large enough to fail every plane test).
+static const float32_t EMPTY_RADIUS = -1.0e30f;
+
+/// Constructor.
+SceneBoundsStream::SceneBoundsStream()
+    : m_size( 0 )
+{
+}
+
+/// Resize this stream.
+///
+/// Any new entries added are cleared so that they are never reported as visible until they are set.
+///
+/// @param[in] size  Number of entries.
+///
+/// @see GetSize(), Set(), Clear()
+void SceneBoundsStream::Resize( size_t size )
+{
+    size_t blockCount = ( size + BLOCK_WIDTH - 1 ) / BLOCK_WIDTH;
+    size_t oldBlockCount = m_blocks.GetSize();
+    if( blockCount != oldBlockCount )
+    {
+        m_blocks.Resize( blockCount );
+
+        for( size_t blockIndex = oldBlockCount; blockIndex < blockCount; ++blockIndex )
+        {
+            Block& rBlock = m_blocks[ blockIndex ];
+            for( size_t laneIndex = 0; laneIndex < BLOCK_WIDTH; ++laneIndex )
+            {
+                rBlock.centerX[ laneIndex ] = 0.0f;
+                rBlock.centerY[ laneIndex ] = 0.0f;
+                rBlock.centerZ[ laneIndex ] = 0.0f;
+                rBlock.radius[ laneIndex ] = EMPTY_RADIUS;
+            }
+        }
+    }
+
+    // Clear entries truncated within the last block so that they do not show up if the stream is grown again.
+    for( size_t index = size; index < m_size && index < blockCount * BLOCK_WIDTH; ++index )
+    {
+        Clear( index );
+    }
+
+    m_size = size;
+}
+
+/// Set the bounding sphere for a given stream entry.
+///
+/// @param[in] index    Entry index.
+/// @param[in] rSphere  World-space bounding sphere.
+///
+/// @see Clear()
+void SceneBoundsStream::Set( size_t index, const Simd::Sphere& rSphere )
+{
+    HELIUM_ASSERT( index < m_size );
+
+    Simd::Vector3 center = rSphere.GetCenter();
+
+    Block& rBlock = m_blocks[ index / BLOCK_WIDTH ];
+    size_t laneIndex = index % BLOCK_WIDTH;
+
+    rBlock.centerX[ laneIndex ] = center.GetElement( 0 );
+    rBlock.centerY[ laneIndex ] = center.GetElement( 1 );
+    rBlock.centerZ[ laneIndex ] = center.GetElement( 2 );
+    rBlock.radius[ laneIndex ] = rSphere.GetRadius();
+}
+
+/// Set the bounding sphere for a given stream entry from its world-space bounding box.
+///
+/// The sphere is computed the same way as Simd::Sphere::Set() computes the sphere enclosing a box.
+///
+/// @param[in] index  Entry index.
+/// @param[in] rBox   World-space axis-aligned bounding box.
+///
+/// @see Clear()
+void SceneBoundsStream::Set( size_t index, const Simd::AaBox& rBox )
+{
+    Simd::Sphere sphere;
+    sphere.Set( rBox );
+    Set( index, sphere );
+}
+
+/// Clear a given stream entry so that it will never be reported as visible.
+///
+/// @param[in] index  Entry index.
+///
+/// @see Set()
+void SceneBoundsStream::Clear( size_t index )
+{
+    HELIUM_ASSERT( index / BLOCK_WIDTH < m_blocks.GetSize() );
+
+    Block& rBlock = m_blocks[ index / BLOCK_WIDTH ];
+    size_t laneIndex = index % BLOCK_WIDTH;
+
+    rBlock.centerX[ laneIndex ] = 0.0f;
+    rBlock.centerY[ laneIndex ] = 0.0f;
+    rBlock.centerZ[ laneIndex ] = 0.0f;
+    rBlock.radius[ laneIndex ] = EMPTY_RADIUS;
+}
+
+/// Get the axis-aligned box enclosing the bounding sphere of a given stream entry.
+///
+/// @param[in] index  Entry index.
+///
+/// @return  Box enclosing the bounding sphere (empty box at the origin if the entry has been cleared).
+///
+/// @see Set()
+Simd::AaBox SceneBoundsStream::GetBox( size_t index ) const
+{
+    HELIUM_ASSERT( index < m_size );
+
+    const Block& rBlock = m_blocks[ index / BLOCK_WIDTH ];
+    size_t laneIndex = index % BLOCK_WIDTH;
+
+    float32_t radius = rBlock.radius[ laneIndex ];
+    if( radius < 0.0f )
+    {
+        return Simd::AaBox( Simd::Vector3( 0.0f, 0.0f, 0.0f ), Simd::Vector3( 0.0f, 0.0f, 0.0f ) );
+    }
+
+    float32_t centerX = rBlock.centerX[ laneIndex ];
+    float32_t centerY = rBlock.centerY[ laneIndex ];
+    float32_t centerZ = rBlock.centerZ[ laneIndex ];
+
+    return Simd::AaBox(
+        Simd::Vector3( centerX - radius, centerY - radius, centerZ - radius ),
+        Simd::Vector3( centerX + radius, centerY + radius, centerZ + radius ) );
+}
+
+/// Build a list of the indices of all entries whose bounding spheres intersect the specified set of culling planes.
+///
+/// @param[in]  rPlanes          Culling planes.
+/// @param[out] rVisibleIndices  List of visible entry indices, in ascending order.
+///
+/// @see ComputePlanes()
+void SceneBoundsStream::Cull( const Planes& rPlanes, DynamicArray< uint32_t >& rVisibleIndices ) const
+{
+    size_t blockCount = m_blocks.GetSize();
+
+    // Size the output list for the worst case up front so that indices can be written unconditionally, advancing the
+    // output position only for visible entries.
+    rVisibleIndices.Reserve( blockCount * BLOCK_WIDTH );
+    rVisibleIndices.Resize( blockCount * BLOCK_WIDTH );
+    uint32_t* pVisibleIndices = rVisibleIndices.GetData();
+    size_t visibleCount = 0;
+
+    const Block* pBlocks = m_blocks.GetData();
+
+#if HELIUM_SIMD_SSE
+    Simd::Register planeNormalX[ PLANE_COUNT ];
+    Simd::Register planeNormalY[ PLANE_COUNT ];
+    Simd::Register planeNormalZ[ PLANE_COUNT ];
+    Simd::Register planeDistance[ PLANE_COUNT ];
+    for( size_t planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex )
+    {
+        planeNormalX[ planeIndex ] = Simd::SetSplatF32( rPlanes.normalX[ planeIndex ] );
+        planeNormalY[ planeIndex ] = Simd::SetSplatF32( rPlanes.normalY[ planeIndex ] );
+        planeNormalZ[ planeIndex ] = Simd::SetSplatF32( rPlanes.normalZ[ planeIndex ] );
+        planeDistance[ planeIndex ] = Simd::SetSplatF32( rPlanes.distance[ planeIndex ] );
+    }
+
+    Simd::Register zeroVec = _mm_setzero_ps();
+
+    for( size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        const Block& rBlock = pBlocks[ blockIndex ];
+
+        Simd::Register centerX = Simd::LoadAligned( rBlock.centerX );
+        Simd::Register centerY = Simd::LoadAligned( rBlock.centerY );
+        Simd::Register centerZ = Simd::LoadAligned( rBlock.centerZ );
+        Simd::Register negativeRadius = Simd::SubtractF32( zeroVec, Simd::LoadAligned( rBlock.radius ) );
+
+        // Spheres are rejected only if they lie strictly outside a plane (distance < -radius), matching the scalar test
+        // exactly, including for spheres touching a plane.
+        Simd::Register outsideMask = zeroVec;
+        for( size_t planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex )
+        {
+            Simd::Register distance = Simd::AddF32(
+                Simd::AddF32(
+                    Simd::MultiplyF32( centerX, planeNormalX[ planeIndex ] ),
+                    Simd::MultiplyF32( centerY, planeNormalY[ planeIndex ] ) ),
+                Simd::AddF32(
+                    Simd::MultiplyF32( centerZ, planeNormalZ[ planeIndex ] ),
+                    planeDistance[ planeIndex ] ) );
+            outsideMask = _mm_or_ps( outsideMask, _mm_cmplt_ps( distance, negativeRadius ) );
+        }
+
+        int visibleBits = ~_mm_movemask_ps( outsideMask ) & ( ( 1 << BLOCK_WIDTH ) - 1 );
+        if( visibleBits != 0 )
+        {
+            uint32_t baseIndex = static_cast< uint32_t >( blockIndex * BLOCK_WIDTH );
+            for( size_t laneIndex = 0; laneIndex < BLOCK_WIDTH; ++laneIndex )
+            {
+                pVisibleIndices[ visibleCount ] = baseIndex + static_cast< uint32_t >( laneIndex );
+                visibleCount += ( visibleBits >> laneIndex ) & 1;
+            }
+        }
+    }
+#else
+    for( size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        const Block& rBlock = pBlocks[ blockIndex ];
+
+        uint32_t baseIndex = static_cast< uint32_t >( blockIndex * BLOCK_WIDTH );
+        for( size_t laneIndex = 0; laneIndex < BLOCK_WIDTH; ++laneIndex )
+        {
+            float32_t centerX = rBlock.centerX[ laneIndex ];
+            float32_t centerY = rBlock.centerY[ laneIndex ];
+            float32_t centerZ = rBlock.centerZ[ laneIndex ];
+            float32_t negativeRadius = -rBlock.radius[ laneIndex ];
+
+            size_t planeIndex;
+            for( planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex )
+            {
+                float32_t distance =
+                    ( centerX * rPlanes.normalX[ planeIndex ] + centerY * rPlanes.normalY[ planeIndex ] ) +
+                    ( centerZ * rPlanes.normalZ[ planeIndex ] + rPlanes.distance[ planeIndex ] );
+                if( distance < negativeRadius )
+                {
+                    break;
+                }
+            }
+
+            pVisibleIndices[ visibleCount ] = baseIndex + static_cast< uint32_t >( laneIndex );
+            visibleCount += ( planeIndex == PLANE_COUNT ? 1 : 0 );
+        }
+    }
+#endif  // HELIUM_SIMD_SSE
+
+    rVisibleIndices.Resize( visibleCount );
+}
+
+/// Test whether the bounding sphere of a single stream entry intersects a subset of a set of culling planes.
+///
+/// @param[in] index      Entry index.
+/// @param[in] rPlanes    Culling planes.
+/// @param[in] planeMask  Mask of the planes against which to test (bit N set to test the plane at index N).
+///
+/// @return  True if the sphere is not entirely outside any of the specified planes, false if it is or if the entry
+///          has been cleared.
+///
+/// @see Cull()
+bool SceneBoundsStream::Intersects( size_t index, const Planes& rPlanes, uint32_t planeMask ) const
+{
+    HELIUM_ASSERT( index < m_size );
+
+    const Block& rBlock = m_blocks[ index / BLOCK_WIDTH ];
+    size_t laneIndex = index % BLOCK_WIDTH;
+
+    float32_t radius = rBlock.radius[ laneIndex ];
+    if( radius < 0.0f )
+    {
+        return false;
+    }
+
+    float32_t centerX = rBlock.centerX[ laneIndex ];
+    float32_t centerY = rBlock.centerY[ laneIndex ];
+    float32_t centerZ = rBlock.centerZ[ laneIndex ];
+    float32_t negativeRadius = -radius;
+
+    // Distances are summed in the same order as in Cull() so that both produce the same results.
+    for( size_t planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex )
+    {
+        if( planeMask & ( 1 << planeIndex ) )
+        {
+            float32_t distance =
+                ( centerX * rPlanes.normalX[ planeIndex ] + centerY * rPlanes.normalY[ planeIndex ] ) +
+                ( centerZ * rPlanes.normalZ[ planeIndex ] + rPlanes.distance[ planeIndex ] );
+            if( distance < negativeRadius )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/// Compute the culling planes for the frustum defined by a combined view/projection matrix.
+///
+/// @param[in]  rViewProjectionMatrix  Matrix transforming world-space coordinates to clip space (note that the scene
+///                                    view refers to this as its "inverse view/projection" matrix).
+/// @param[out] rPlanes                Normalized culling planes.
+void SceneBoundsStream::ComputePlanes( const Simd::Matrix44& rViewProjectionMatrix, Planes& rPlanes )
+{
+    // Points are transformed as row vectors, so each clip-space coordinate is the dot product of the homogeneous
+    // point with the corresponding matrix column.
+    float32_t clipX[ 4 ];
+    float32_t clipY[ 4 ];
+    float32_t clipZ[ 4 ];
+    float32_t clipW[ 4 ];
+    for( size_t rowIndex = 0; rowIndex < 4; ++rowIndex )
+    {
+        clipX[ rowIndex ] = rViewProjectionMatrix.GetElement( rowIndex * 4 + 0 );
+        clipY[ rowIndex ] = rViewProjectionMatrix.GetElement( rowIndex * 4 + 1 );
+        clipZ[ rowIndex ] = rViewProjectionMatrix.GetElement( rowIndex * 4 + 2 );
+        clipW[ rowIndex ] = rViewProjectionMatrix.GetElement( rowIndex * 4 + 3 );
+    }
+
+    // Left, right, bottom, top, near (z >= 0), and far (z <= w) planes.
+    float32_t plane[ PLANE_COUNT ][ 4 ];
+    for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+    {
+        plane[ 0 ][ componentIndex ] = clipW[ componentIndex ] + clipX[ componentIndex ];
+        plane[ 1 ][ componentIndex ] = clipW[ componentIndex ] - clipX[ componentIndex ];
+        plane[ 2 ][ componentIndex ] = clipW[ componentIndex ] + clipY[ componentIndex ];
+        plane[ 3 ][ componentIndex ] = clipW[ componentIndex ] - clipY[ componentIndex ];
+        plane[ 4 ][ componentIndex ] = clipZ[ componentIndex ];
+        plane[ 5 ][ componentIndex ] = clipW[ componentIndex ] - clipZ[ componentIndex ];
+    }
+
+    for( size_t planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex )
+    {
+        float32_t normalX = plane[ planeIndex ][ 0 ];
+        float32_t normalY = plane[ planeIndex ][ 1 ];
+        float32_t normalZ = plane[ planeIndex ][ 2 ];
+        float32_t length = Sqrt( normalX * normalX + normalY * normalY + normalZ * normalZ );
+
+        // Degenerate planes (i.e. the far plane of an infinite projection) never reject anything.
+        if( length < HELIUM_EPSILON )
+        {
+            rPlanes.normalX[ planeIndex ] = 0.0f;
+            rPlanes.normalY[ planeIndex ] = 0.0f;
+            rPlanes.normalZ[ planeIndex ] = 0.0f;
+            rPlanes.distance[ planeIndex ] = 1.0f;
+
+            continue;
+        }
+
+        float32_t lengthInv = 1.0f / length;
+        rPlanes.normalX[ planeIndex ] = normalX * lengthInv;
+        rPlanes.normalY[ planeIndex ] = normalY * lengthInv;
+        rPlanes.normalZ[ planeIndex ] = normalZ * lengthInv;
+        rPlanes.distance[ planeIndex ] = plane[ planeIndex ][ 3 ] * lengthInv;
+    }
+}
@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------------------------------------------------------
+// SceneBoundsStream.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_GRAPHICS_SCENE_BOUNDS_STREAM_H
+#define HELIUM_GRAPHICS_SCENE_BOUNDS_STREAM_H
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/AaBox.h"
+#include "MathSimd/Matrix44.h"
+#include "MathSimd/Sphere.h"
+
+namespace Helium
+{
+    /// Packed structure-of-arrays stream of scene object bounding spheres for SIMD visibility culling.
+    ///
+    /// Spheres are tested with the same plane comparison as Simd::Frustum::Intersects(), so for spheres set from the
+    /// same Simd::Sphere values and planes computed from the same view/projection matrix, culling produces the same
+    /// results as testing each sphere against a Simd::Frustum.
+    ///
+    /// Bounding spheres are stored in blocks of BLOCK_WIDTH spheres, with the X, Y, and Z center coordinates and the
+    /// radius of each sphere in a block kept in separate SIMD-aligned arrays, so that a full block of spheres can be
+    /// tested against each culling plane at once.  Entries are indexed by scene object ID.  Unused entries are given a
+    /// negative radius large enough that they never pass a visibility test, allowing entire blocks to be tested
+    /// without checking which objects are valid.
+    class HELIUM_GRAPHICS_API SceneBoundsStream
+    {
+    public:
+        /// Number of bounding spheres tested at once.
+        static const size_t BLOCK_WIDTH = HELIUM_SIMD_SIZE / sizeof( float32_t );
+        /// Number of culling planes.
+        static const size_t PLANE_COUNT = 6;
+
+        /// Normalized, inward-facing culling planes in structure-of-arrays form.
+        struct Planes
+        {
+            /// Plane normal X components.
+            float32_t normalX[ PLANE_COUNT ];
+            /// Plane normal Y components.
+            float32_t normalY[ PLANE_COUNT ];
+            /// Plane normal Z components.
+            float32_t normalZ[ PLANE_COUNT ];
+            /// Plane distances (points for which the dot product with the normal plus the distance is non-negative
+            /// are on the inner side of the plane).
+            float32_t distance[ PLANE_COUNT ];
+        };
+
+        /// @name Construction/Destruction
+        //@{
+        SceneBoundsStream();
+        //@}
+
+        /// @name Stream Updating
+        //@{
+        void Resize( size_t size );
+        inline size_t GetSize() const;
+
+        void Set( size_t index, const Simd::Sphere& rSphere );
+        void Set( size_t index, const Simd::AaBox& rBox );
+        void Clear( size_t index );
+
+        Simd::AaBox GetBox( size_t index ) const;
+        //@}
+
+        /// @name Culling
+        //@{
+        void Cull( const Planes& rPlanes, DynamicArray< uint32_t >& rVisibleIndices ) const;
+        bool Intersects( size_t index, const Planes& rPlanes, uint32_t planeMask ) const;
+        //@}
+
+        /// @name Static Culling Support
+        //@{
+        static void ComputePlanes( const Simd::Matrix44& rViewProjectionMatrix, Planes& rPlanes );
+        //@}
+
+    private:
+        /// Block of bounding spheres.
+        HELIUM_SIMD_ALIGN_PRE struct Block
+        {
+            /// Sphere center X coordinates.
+            float32_t centerX[ BLOCK_WIDTH ];
+            /// Sphere center Y coordinates.
+            float32_t centerY[ BLOCK_WIDTH ];
+            /// Sphere center Z coordinates.
+            float32_t centerZ[ BLOCK_WIDTH ];
+            /// Sphere radii.
+            float32_t radius[ BLOCK_WIDTH ];
+        } HELIUM_SIMD_ALIGN_POST;
+
+        /// Sphere blocks.
+        DynamicArray< Block > m_blocks;
+        /// Number of entries in the stream.
+        size_t m_size;
+    };
+}
+
+#include "Graphics/SceneBoundsStream.inl"
+
+#endif  // HELIUM_GRAPHICS_SCENE_BOUNDS_STREAM_H
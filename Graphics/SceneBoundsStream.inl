@@ -0,0 +1,19 @@
+//----------------------------------------------------------------------------------------------------------------------
+// SceneBoundsStream.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get the number of entries in this stream.
+    ///
+    /// @return  Number of entries.
+    ///
+    /// @see Resize()
+    size_t SceneBoundsStream::GetSize() const
+    {
+        return m_size;
+    }
+}
@@ -169,24 +169,7 @@ void Shader::FinalizeLoad()
 {
     Base::FinalizeLoad();
 
-    // Cache the number of user variants for each shader type.  Note that we don't need to create variants for the
-    // default type template.
-    if( IsDefaultTemplate() )
-    {
-        MemoryZero( m_variantCounts, sizeof( m_variantCounts ) );
-    }
-    else
-    {
-        const Options& rUserOptions = m_persistentResourceData.GetUserOptions();
-
-        for( size_t shaderTypeIndex = 0; shaderTypeIndex < HELIUM_ARRAY_COUNT( m_variantCounts ); ++shaderTypeIndex )
-        {
-            size_t count = rUserOptions.ComputeOptionSetCount( static_cast< RShader::EType >( shaderTypeIndex ) );
-            HELIUM_ASSERT( count <= UINT32_MAX );
-
-            m_variantCounts[ shaderTypeIndex ] = static_cast< uint32_t >( count );
-        }
-    }
+    UpdateVariantCounts();
 }
 
 #if HELIUM_TOOLS
@@ -930,9 +913,35 @@ bool Helium::Shader::LoadPersistentResourceObject( Reflect::ObjectPtr &_object )
 
     _object->CopyTo(&m_persistentResourceData);
 
+    // Resource data may be replaced after the shader has finished loading (i.e. when preprocessed as part of a
+    // batch), so keep the variant counts in sync with the user options.
+    UpdateVariantCounts();
+
     return true;
 }
 
+/// Update the cached number of user variants for each shader type from the persistent resource data.
+void Shader::UpdateVariantCounts()
+{
+    // Note that we don't need to create variants for the default type template.
+    if( IsDefaultTemplate() )
+    {
+        MemoryZero( m_variantCounts, sizeof( m_variantCounts ) );
+
+        return;
+    }
+
+    const Options& rUserOptions = m_persistentResourceData.GetUserOptions();
+
+    for( size_t shaderTypeIndex = 0; shaderTypeIndex < HELIUM_ARRAY_COUNT( m_variantCounts ); ++shaderTypeIndex )
+    {
+        size_t count = rUserOptions.ComputeOptionSetCount( static_cast< RShader::EType >( shaderTypeIndex ) );
+        HELIUM_ASSERT( count <= UINT32_MAX );
+
+        m_variantCounts[ shaderTypeIndex ] = static_cast< uint32_t >( count );
+    }
+}
+
 bool Helium::ShaderVariant::LoadPersistentResourceObject( Reflect::ObjectPtr &_object )
 {
     HELIUM_ASSERT(_object.ReferencesObject());
@@ -976,6 +985,53 @@ Name ShaderVariant::GetCacheName() const
     return cacheName;
 }
 
+/// @copydoc Resource::GetResidentResourceDataSize()
+size_t ShaderVariant::GetResidentResourceDataSize() const
+{
+    size_t residentSize = 0;
+
+    size_t renderResourceCount = m_renderResources.GetSize();
+    for( size_t resourceIndex = 0; resourceIndex < renderResourceCount; ++resourceIndex )
+    {
+        if( m_renderResources[ resourceIndex ] )
+        {
+            size_t subDataSize = GetSubDataSize( static_cast< uint32_t >( resourceIndex ) );
+            if( IsValid( subDataSize ) )
+            {
+                residentSize += subDataSize;
+            }
+        }
+    }
+
+    return residentSize;
+}
+
+/// @copydoc Resource::EvictResourceData()
+bool ShaderVariant::EvictResourceData()
+{
+    if( m_pRenderResourceLoadBuffer )
+    {
+        return false;
+    }
+
+    // Release the shaders but keep the array sized to the resource count, as BeginPrecacheResourceData() reloads each
+    // entry in place.
+    bool bEvicted = false;
+
+    size_t renderResourceCount = m_renderResources.GetSize();
+    for( size_t resourceIndex = 0; resourceIndex < renderResourceCount; ++resourceIndex )
+    {
+        RShaderPtr& rspRenderResource = m_renderResources[ resourceIndex ];
+        if( rspRenderResource )
+        {
+            rspRenderResource.Release();
+            bEvicted = true;
+        }
+    }
+
+    return bEvicted;
+}
+
 Helium::ShaderVariant::PersistentResourceData::PersistentResourceData()
     : m_resourceCount(0)
 {
@@ -416,6 +416,11 @@ namespace Helium
         static TRY_FINISH_LOAD_VARIANT_FUNC* sm_pTryFinishLoadVariantOverride;
         /// Shader variant load override callback data.
         static void* sm_pVariantLoadOverrideData;
+
+        /// @name Private Utility Functions
+        //@{
+        void UpdateVariantCounts();
+        //@}
     };
 
     /// Single variation of a shader.
@@ -467,6 +472,12 @@ namespace Helium
         virtual Name GetCacheName() const;
         //@}
 
+        /// @name Resource Residency
+        //@{
+        virtual size_t GetResidentResourceDataSize() const;
+        virtual bool EvictResourceData();
+        //@}
+
         /// @name Data Access
         //@{
         inline RShader* GetRenderResource( size_t index ) const;
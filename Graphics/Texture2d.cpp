@@ -12,6 +12,7 @@ using namespace Helium;
 /// Constructor.
 Texture2d::Texture2d()
 {
+    MemoryZero( &m_evictedTextureInfo, sizeof( m_evictedTextureInfo ) );
 }
 
 /// Destructor.
@@ -30,6 +31,32 @@ bool Texture2d::BeginPrecacheResourceData()
 {
     HELIUM_ASSERT( m_renderResourceLoadIds.IsEmpty() );
 
+    // Recreate the texture resource if its data was evicted.
+    if( m_evictedTextureInfo.mipCount != 0 )
+    {
+        HELIUM_ASSERT( !m_spTexture );
+
+        Renderer* pRenderer = Renderer::GetStaticInstance();
+        if( pRenderer )
+        {
+            m_spTexture = pRenderer->CreateTexture2d(
+                m_evictedTextureInfo.width,
+                m_evictedTextureInfo.height,
+                m_evictedTextureInfo.mipCount,
+                m_evictedTextureInfo.format,
+                RENDERER_BUFFER_USAGE_STATIC );
+            if( !m_spTexture )
+            {
+                HELIUM_TRACE(
+                    TraceLevels::Error,
+                    TXT( "Texture2d::BeginPrecacheResourceData(): Failed to recreate evicted texture \"%s\".\n" ),
+                    *GetPath().ToString() );
+            }
+        }
+
+        m_evictedTextureInfo.mipCount = 0;
+    }
+
     // Don't load any resources if we have no texture resource (texture resource should already be allocated in
     // SerializePersistentResourceData()).
     RTexture2d* pTexture2d = static_cast< RTexture2d* >( m_spTexture.Get() );
@@ -196,6 +223,34 @@ void Texture2d::SerializePersistentResourceData( Serializer& s )
     }
 }
 
+/// @copydoc Resource::GetResidentResourceDataSize()
+size_t Texture2d::GetResidentResourceDataSize() const
+{
+    RTexture2d* pTexture2d = static_cast< RTexture2d* >( m_spTexture.Get() );
+
+    return ( pTexture2d ? GetTotalSubDataSize( pTexture2d->GetMipCount() ) : 0 );
+}
+
+/// @copydoc Resource::EvictResourceData()
+bool Texture2d::EvictResourceData()
+{
+    RTexture2d* pTexture2d = static_cast< RTexture2d* >( m_spTexture.Get() );
+    if( !pTexture2d || !m_renderResourceLoadIds.IsEmpty() )
+    {
+        return false;
+    }
+
+    // Keep the texture parameters so that the texture can be recreated when it is precached again.
+    m_evictedTextureInfo.width = pTexture2d->GetWidth();
+    m_evictedTextureInfo.height = pTexture2d->GetHeight();
+    m_evictedTextureInfo.mipCount = pTexture2d->GetMipCount();
+    m_evictedTextureInfo.format = pTexture2d->GetPixelFormat();
+
+    m_spTexture.Release();
+
+    return true;
+}
+
 /// @copydoc Texture::GetRenderResource2d()
 RTexture2d* Texture2d::GetRenderResource2d() const
 {
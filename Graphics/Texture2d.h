@@ -11,6 +11,8 @@
 
 #include "Graphics/Texture.h"
 
+#include "Rendering/RendererTypes.h"
+
 namespace Helium
 {
     /// 2D texture resource.
@@ -37,14 +39,36 @@ namespace Helium
         virtual void SerializePersistentResourceData( Serializer& s );
         //@}
 
+        /// @name Resource Residency
+        //@{
+        virtual size_t GetResidentResourceDataSize() const;
+        virtual bool EvictResourceData();
+        //@}
+
         /// @name Data Access
         //@{
         RTexture2d* GetRenderResource2d() const;
         //@}
 
     private:
+        /// Texture render resource parameters saved when evicting the texture data.
+        struct EvictedTextureInfo
+        {
+            /// Base mip level width.
+            uint32_t width;
+            /// Base mip level height.
+            uint32_t height;
+            /// Number of mip levels.
+            uint32_t mipCount;
+            /// Pixel format.
+            ERendererPixelFormat format;
+        };
+
         /// Async load IDs for cached texture data.
         DynamicArray< size_t > m_renderResourceLoadIds;
+
+        /// Render resource parameters of the evicted texture data (mip count is zero if not evicted).
+        EvictedTextureInfo m_evictedTextureInfo;
     };
 }
 
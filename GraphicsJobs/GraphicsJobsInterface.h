@@ -64,6 +64,7 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
@@ -107,6 +108,7 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
@@ -152,6 +154,7 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
@@ -195,6 +198,7 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
@@ -240,6 +244,7 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
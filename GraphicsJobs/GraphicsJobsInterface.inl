@@ -59,6 +59,14 @@ void UpdateGraphicsSceneConstantBuffersJobSpawner::RunCallback( void* pJob, JobC
     static_cast< UpdateGraphicsSceneConstantBuffersJobSpawner* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* UpdateGraphicsSceneConstantBuffersJobSpawner::GetTypeName()
+{
+    return "UpdateGraphicsSceneConstantBuffersJobSpawner";
+}
+
 /// Constructor.
 UpdateGraphicsSceneConstantBuffersJobSpawner::Parameters::Parameters()
 {
@@ -115,6 +123,14 @@ void UpdateGraphicsSceneObjectBuffersJobSpawner::RunCallback( void* pJob, JobCon
     static_cast< UpdateGraphicsSceneObjectBuffersJobSpawner* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* UpdateGraphicsSceneObjectBuffersJobSpawner::GetTypeName()
+{
+    return "UpdateGraphicsSceneObjectBuffersJobSpawner";
+}
+
 /// Constructor.
 UpdateGraphicsSceneObjectBuffersJobSpawner::Parameters::Parameters()
 {
@@ -171,6 +187,14 @@ void UpdateGraphicsSceneSubMeshBuffersJobSpawner::RunCallback( void* pJob, JobCo
     static_cast< UpdateGraphicsSceneSubMeshBuffersJobSpawner* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* UpdateGraphicsSceneSubMeshBuffersJobSpawner::GetTypeName()
+{
+    return "UpdateGraphicsSceneSubMeshBuffersJobSpawner";
+}
+
 /// Constructor.
 UpdateGraphicsSceneSubMeshBuffersJobSpawner::Parameters::Parameters()
 {
@@ -227,6 +251,14 @@ void UpdateGraphicsSceneObjectBuffersJob::RunCallback( void* pJob, JobContext* p
     static_cast< UpdateGraphicsSceneObjectBuffersJob* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* UpdateGraphicsSceneObjectBuffersJob::GetTypeName()
+{
+    return "UpdateGraphicsSceneObjectBuffersJob";
+}
+
 /// Constructor.
 UpdateGraphicsSceneObjectBuffersJob::Parameters::Parameters()
 {
@@ -283,6 +315,14 @@ void UpdateGraphicsSceneSubMeshBuffersJob::RunCallback( void* pJob, JobContext*
     static_cast< UpdateGraphicsSceneSubMeshBuffersJob* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* UpdateGraphicsSceneSubMeshBuffersJob::GetTypeName()
+{
+    return "UpdateGraphicsSceneSubMeshBuffersJob";
+}
+
 /// Constructor.
 UpdateGraphicsSceneSubMeshBuffersJob::Parameters::Parameters()
 {
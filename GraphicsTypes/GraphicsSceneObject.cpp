@@ -43,6 +43,9 @@ void GraphicsSceneObject::SetTransform( const Simd::Matrix44& rTransform )
 
 /// Set the world-space axis-aligned bounding box for this instance.
 ///
+/// The graphics scene only picks up bounds changes made during an update of this object, so this should only be
+/// called from the update callback (use SetNeedsUpdate() to request an update).
+///
 /// @param[in] rBox  World-space axis-aligned bounding box to set.
 ///
 /// @see GetWorldBox(), GetWorldSphere()
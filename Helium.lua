@@ -109,6 +109,12 @@ newoption
 	description = "Build using wchar_t instead of UTF-8 strings"
 }
 
+newoption
+{
+	trigger = "native-jobs",
+	description = "Run jobs on the native work-stealing scheduler instead of TBB tasks"
+}
+
 Helium.DoBasicSolutionSettings = function()
 
 	location "Premake"
@@ -154,6 +160,13 @@ Helium.DoBasicSolutionSettings = function()
 		}
 	end
 
+	if _OPTIONS[ "native-jobs" ] then
+		defines
+		{
+			"HELIUM_NATIVE_JOB_SCHEDULER=1",
+		}
+	end
+
 	flags
 	{
 		"Unicode",
@@ -93,12 +93,9 @@ void ArchiveObjectLoader::OnLoadComplete( GameObjectPath /*path*/, GameObject* p
 		 return;
 	 }
  
-	 // Grab the package timestamp.
-	 HELIUM_ASSERT( pPackageLoader->IsSourcePackageFile() );
-	 int64_t objectTimestamp = pPackageLoader->GetFileTimestamp();
- 
 	 // Attempt to load the resource data.
-	 pObjectPreprocessor->LoadResourceData( pResource, objectTimestamp );
+	 HELIUM_ASSERT( pPackageLoader->IsSourcePackageFile() );
+	 pObjectPreprocessor->LoadResourceData( pResource );
  }
 
 /// @copydoc GameObjectLoader::CacheObject()
@@ -138,69 +135,8 @@ bool ArchiveObjectLoader::CacheObject( GameObject* pObject, bool bEvictPlatformP
 		}
 	}
 
-	// Get the timestamp for the object based on the timestamp of its source package file and, if it's a resource,
-	// the timestamp of the source resource file.
-	GameObject* pPackageObject;
-	for( pPackageObject = pObject;
-		pPackageObject && !pPackageObject->IsPackage();
-		pPackageObject = pPackageObject->GetOwner() )
-	{
-	}
-
-	HELIUM_ASSERT( pPackageObject );
-
-	PackageLoader* pPackageLoader = Reflect::AssertCast< Package >( pPackageObject )->GetLoader();
-	HELIUM_ASSERT( pPackageLoader );
-	HELIUM_ASSERT( pPackageLoader->IsSourcePackageFile() );
-
-	int64_t objectTimestamp = pPackageLoader->GetFileTimestamp();
-
-	if( !pObject->IsDefaultTemplate() )
-	{
-		Resource* pResource = Reflect::SafeCast< Resource >( pObject );
-		if( pResource )
-		{
-			GameObjectPath baseResourcePath = pResource->GetPath();
-			HELIUM_ASSERT( !baseResourcePath.IsPackage() );
-			for( ; ; )
-			{
-				GameObjectPath parentPath = baseResourcePath.GetParent();
-				if( parentPath.IsEmpty() || parentPath.IsPackage() )
-				{
-					break;
-				}
-
-				baseResourcePath = parentPath;
-			}
-
-			FilePath sourceFilePath;
-			if ( !FileLocations::GetDataDirectory( sourceFilePath ) )
-			{
-				HELIUM_TRACE(
-					TraceLevels::Warning,
-					TXT( "ArchiveObjectLoader::CacheObject(): Could not obtain data directory.\n" ) );
-
-				return false;
-			}
-
-			sourceFilePath += baseResourcePath.ToFilePathString().GetData();
-
-			Status stat;
-			stat.Read( sourceFilePath.Get().c_str() );
-
-			int64_t sourceFileTimestamp = stat.m_ModifiedTime;
-			if( sourceFileTimestamp > objectTimestamp )
-			{
-				objectTimestamp = sourceFileTimestamp;
-			}
-		}
-	}
-
 	// Cache the object.
-	bool bSuccess = pObjectPreprocessor->CacheObject(
-		pObject,
-		objectTimestamp,
-		bEvictPlatformPreprocessedResourceData );
+	bool bSuccess = pObjectPreprocessor->CacheObject( pObject, bEvictPlatformPreprocessedResourceData );
 	if( !bSuccess )
 	{
 		HELIUM_TRACE(
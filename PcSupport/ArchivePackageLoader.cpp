@@ -35,6 +35,27 @@ REFLECT_DEFINE_OBJECT( Helium::ObjectDescriptor );
 
 using namespace Helium;
 
+/// Package manifest magic number.
+static const uint32_t MANIFEST_MAGIC = 0x4d504b48;  // 'HKPM'
+
+/// Get the name of a file within its directory.
+///
+/// @param[in] rFilePath  File path.
+///
+/// @return  File name.
+static Name GetFileName( const FilePath& rFilePath )
+{
+    String fileNameString( *rFilePath );
+
+    size_t pathSeparatorLocation = fileNameString.FindReverse( TXT( '/' ) );
+    if( IsValid( pathSeparatorLocation ) )
+    {
+        fileNameString.Substring( fileNameString, pathSeparatorLocation + 1 );
+    }
+
+    return Name( fileNameString );
+}
+
 void Helium::ObjectDescriptor::PopulateComposite( Reflect::Composite& comp )
 {
     comp.AddField(&ObjectDescriptor::m_Name, TXT("m_Name"));
@@ -47,6 +68,10 @@ ArchivePackageLoader::ArchivePackageLoader()
     : m_startPreloadCounter( 0 )
     , m_preloadedCounter( 0 )
     , m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
+    , m_pManifestLoadBuffer( NULL )
+    , m_manifestFileSize( 0 )
+    , m_manifestLoadId( Invalid< size_t >() )
+    , m_bManifestDirty( false )
     , m_parentPackageLoadId( Invalid< size_t >() )
     //, m_pTocLoadBuffer( 0 )
     //, m_tocAsyncLoadId( Invalid<size_t>() )
@@ -115,6 +140,7 @@ bool ArchivePackageLoader::Initialize( GameObjectPath packagePath )
         }
 
         pPackage->SetLoader( this );
+        ConditionalEnablePackageArena( pPackage );
     }
     else
     {
@@ -264,7 +290,22 @@ void ArchivePackageLoader::Shutdown()
     AtomicExchangeRelease( m_startPreloadCounter, 0 );
     AtomicExchangeRelease( m_preloadedCounter, 0 );
 
+    HELIUM_ASSERT( IsInvalid( m_manifestLoadId ) );
+    HELIUM_ASSERT( !m_pManifestLoadBuffer );
+    HELIUM_ASSERT( m_fileReadRequests.IsEmpty() );
+
+    DefaultAllocator allocator;
+    size_t objectCount = m_objects.GetSize();
+    for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    {
+        allocator.Free( m_objects[ objectIndex ].pFileData );
+    }
+
     m_objects.Clear();
+    m_objectIndexMap.Clear();
+    m_objectFiles.Clear();
+    m_manifestFileSize = 0;
+    m_bManifestDirty = false;
 
     size_t loadRequestCount = m_loadRequests.GetSize();
     for( size_t requestIndex = 0; requestIndex < loadRequestCount; ++requestIndex )
@@ -317,30 +358,62 @@ bool ArchivePackageLoader::BeginPreload()
 //         HELIUM_ASSERT( IsValid(m_tocAsyncLoadId) );
 //     }
 
-    AsyncLoader &rAsyncLoader = AsyncLoader::GetStaticInstance();
-    //rAsyncLoader.
-    
+    // Gather the object files in the package directory.  If a package manifest exists, only the manifest needs to be
+    // read to get the object descriptors of all object files it covers that have not been modified since it was written.
+    HELIUM_ASSERT( m_objectFiles.IsEmpty() );
+    HELIUM_ASSERT( !m_bManifestDirty );
+    m_manifestFileSize = 0;
+
+    Name manifestFileName( HELIUM_ARCHIVE_PACKAGE_MANIFEST_FILENAME );
+    FilePath manifestFilePath;
+
     DirectoryIterator packageDirectory( m_packageDirPath );
     for( ; !packageDirectory.IsDone(); packageDirectory.Next() )
     {
         const DirectoryIteratorItem& item = packageDirectory.GetItem();
         if (item.m_Path.Extension() == TXT("object"))
         {
-            FileReadRequest *request = m_fileReadRequests.New();
-            request->expectedSize = item.m_Size;
-
-			HELIUM_ASSERT( item.m_Size < UINT32_MAX );
-
-            // Create a buffer for the file to be read into temporarily
-            request->pLoadBuffer = DefaultAllocator().Allocate( static_cast< size_t > ( item.m_Size ) );
-            HELIUM_ASSERT( request->pLoadBuffer );
+            HELIUM_ASSERT( item.m_Size < UINT32_MAX );
+
+            ObjectFileInfo* pFileInfo = m_objectFiles.New();
+            HELIUM_ASSERT( pFileInfo );
+            pFileInfo->filePath = item.m_Path;
+            pFileInfo->fileName = GetFileName( item.m_Path );
+            pFileInfo->size = item.m_Size;
+            pFileInfo->timestamp = static_cast< int64_t >( item.m_ModTime );
+            pFileInfo->bInManifest = false;
+        }
+        else if( GetFileName( item.m_Path ) == manifestFileName && item.m_Size < UINT32_MAX )
+        {
+            manifestFilePath = item.m_Path;
+            m_manifestFileSize = static_cast< size_t >( item.m_Size );
+        }
+    }
 
-            // Queue up the read
-            request->asyncLoadId = rAsyncLoader.QueueRequest( request->pLoadBuffer, String( item.m_Path.c_str() ), 0, static_cast< size_t >( item.m_Size ) );
-            HELIUM_ASSERT( IsValid( request->asyncLoadId ) );
+    if( m_manifestFileSize != 0 )
+    {
+        HELIUM_ASSERT( !m_pManifestLoadBuffer );
+        m_pManifestLoadBuffer = DefaultAllocator().Allocate( m_manifestFileSize );
+        HELIUM_ASSERT( m_pManifestLoadBuffer );
 
-            request->filePath = item.m_Path;
+        AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+        m_manifestLoadId = rAsyncLoader.QueueRequest(
+            m_pManifestLoadBuffer,
+            String( manifestFilePath.c_str() ),
+            0,
+            m_manifestFileSize );
+        HELIUM_ASSERT( IsValid( m_manifestLoadId ) );
+    }
+    else
+    {
+        // No manifest, so read every object file and write a manifest once preloading completes.
+        size_t objectFileCount = m_objectFiles.GetSize();
+        for( size_t objectFileIndex = 0; objectFileIndex < objectFileCount; ++objectFileIndex )
+        {
+            QueueObjectFileRead( objectFileIndex );
         }
+
+        m_bManifestDirty = ( objectFileCount != 0 );
     }
 
     AtomicExchangeRelease( m_startPreloadCounter, 1 );
@@ -402,18 +475,13 @@ size_t ArchivePackageLoader::BeginLoadObject( GameObjectPath path )
     }
 
     // Locate the object within this package.
-    size_t objectCount = m_objects.GetSize();
-    size_t objectIndex;
-    for( objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    size_t objectIndex = Invalid< size_t >();
+    if( path.GetParent() == m_packagePath )
     {
-        SerializedObjectData& rObjectData = m_objects[ objectIndex ];
-        if( rObjectData.objectPath == path )
-        {
-            break;
-        }
+        objectIndex = FindObjectIndex( path.GetName() );
     }
 
-    if( objectIndex >= objectCount )
+    if( IsInvalid( objectIndex ) )
     {
         HELIUM_TRACE(
             TraceLevels::Warning,
@@ -797,6 +865,42 @@ void ArchivePackageLoader::TickPreload()
 //         SetInvalid( m_tocAsyncLoadId );
 //     }
 
+    // Read the object descriptors from the package manifest, falling back to reading the object files themselves for
+    // any files the manifest does not cover.
+    if( IsValid( m_manifestLoadId ) )
+    {
+        size_t bytes_read = 0;
+        if( !rAsyncLoader.TrySyncRequest( m_manifestLoadId, bytes_read ) )
+        {
+            return;
+        }
+
+        SetInvalid( m_manifestLoadId );
+
+        if( bytes_read != m_manifestFileSize || !ReadManifest( m_pManifestLoadBuffer, bytes_read ) )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Warning,
+                TXT( "ArchivePackageLoader: Package manifest for \"%s\" is invalid and will be rebuilt.\n" ),
+                *m_packagePath.ToString() );
+
+            m_bManifestDirty = true;
+        }
+
+        DefaultAllocator().Free( m_pManifestLoadBuffer );
+        m_pManifestLoadBuffer = NULL;
+
+        size_t objectFileCount = m_objectFiles.GetSize();
+        for( size_t objectFileIndex = 0; objectFileIndex < objectFileCount; ++objectFileIndex )
+        {
+            if( !m_objectFiles[ objectFileIndex ].bInManifest )
+            {
+                QueueObjectFileRead( objectFileIndex );
+                m_bManifestDirty = true;
+            }
+        }
+    }
+
     // Walk through every load request
     for (size_t i = 0; i < m_fileReadRequests.GetSize();)
     {
@@ -831,16 +935,8 @@ void ArchivePackageLoader::TickPreload()
         }
         else
         {
-            // TODO: Read it in
-            //tstringstream ss;
-            //ss << (tchar_t *)rRequest.pLoadBuffer;
-            //tstring str;
-            //str.assign((tchar_t *)rRequest.pLoadBuffer, rRequest.expectedSize / sizeof(tchar_t));
-            //Helium::Reflect::ObjectPtr object = Reflect::ArchiveXML::FromString(str);
-
             tstringstream xml_ss_in;
             xml_ss_in.write((tchar_t *)rRequest.pLoadBuffer, rRequest.expectedSize / sizeof(tchar_t));
-            //xml_ss_in.str(xml_str);
 
             Reflect::ArchiveXML xml_in(new Reflect::TCharStream(&xml_ss_in, false), false);
             xml_in.ReadFileHeader();
@@ -861,11 +957,19 @@ void ArchivePackageLoader::TickPreload()
                     Name type_name;
                     type_name.Set(object_descriptor->m_TypeName.c_str());
 
-                    SerializedObjectData* pObjectData = m_objects.New();
-                    HELIUM_ASSERT( pObjectData );
-                    HELIUM_VERIFY( pObjectData->objectPath.Set( object_name, false, m_packagePath ) );
-                    pObjectData->templatePath.Set(object_descriptor->m_TemplatePath.c_str());
-                    pObjectData->typeName = type_name;
+                    HELIUM_ASSERT( rRequest.objectFileIndex < m_objectFiles.GetSize() );
+                    SerializedObjectData* pObjectData = AddObject(
+                        object_name,
+                        type_name,
+                        object_descriptor->m_TemplatePath.c_str(),
+                        &m_objectFiles[ rRequest.objectFileIndex ] );
+                    if( pObjectData )
+                    {
+                        // Keep the file contents around so that the object does not need to be read again when it is
+                        // deserialized.
+                        pObjectData->pFileData = rRequest.pLoadBuffer;
+                        rRequest.pLoadBuffer = NULL;
+                    }
                 }
                 else
                 {
@@ -886,13 +990,19 @@ void ArchivePackageLoader::TickPreload()
             }
         }
 
-        // We're finished with this load, so deallocate memory and get rid of the request
+        // We're finished with this load, so deallocate memory (unless it was handed off to the object) and get rid of
+        // the request
         DefaultAllocator().Free( rRequest.pLoadBuffer );
         rRequest.pLoadBuffer = NULL;
         SetInvalid(rRequest.asyncLoadId);
         m_fileReadRequests.RemoveSwap(i);
     }
 
+    if( !m_fileReadRequests.IsEmpty() )
+    {
+        return;
+    }
+
     // Wait for the parent package to finish loading.
     GameObjectPtr spParentPackage;
     if( IsValid( m_parentPackageLoadId ) )
@@ -919,6 +1029,7 @@ void ArchivePackageLoader::TickPreload()
         pPackage = m_spPackage;
         HELIUM_ASSERT( pPackage );
         pPackage->SetLoader( this );
+        ConditionalEnablePackageArena( pPackage );
     }
 
     HELIUM_ASSERT( pPackage->GetLoader() == this );
@@ -950,32 +1061,14 @@ void ArchivePackageLoader::TickPreload()
         }
 
         // Make sure an object entry doesn't already exist for the file.
-        String objectNameString( *item.m_Path );
-
-        size_t pathSeparatorLocation = objectNameString.FindReverse( TXT( '/' ) );
-        if( IsValid( pathSeparatorLocation ) )
-        {
-            objectNameString.Substring( objectNameString, pathSeparatorLocation + 1 );
-        }
-
-        Name objectName( objectNameString );
-        size_t objectCount = m_objects.GetSize();
-        size_t objectIndex;
-        for( objectIndex = 0; objectIndex < objectCount; ++objectIndex )
-        {
-            SerializedObjectData& rObjectData = m_objects[ objectIndex ];
-            if( rObjectData.objectPath.GetName() == objectName &&
-                rObjectData.objectPath.GetParent() == m_packagePath )
-            {
-                break;
-            }
-        }
-
-        if( objectIndex < objectCount )
+        Name objectName = GetFileName( item.m_Path );
+        if( IsValid( FindObjectIndex( objectName ) ) )
         {
             continue;
         }
 
+        String objectNameString( *objectName );
+
         // Check the extension to see if the file is supported by one of the resource handlers.
         ResourceHandler* pBestHandler = NULL;
         size_t bestHandlerExtensionLength = 0;
@@ -1020,14 +1113,16 @@ void ArchivePackageLoader::TickPreload()
                 *pResourceType->GetName(),
                 *m_packagePath.ToString() );
 
-            SerializedObjectData* pObjectData = m_objects.New();
-            HELIUM_ASSERT( pObjectData );
-            HELIUM_VERIFY( pObjectData->objectPath.Set( objectName, false, m_packagePath ) );
-            pObjectData->typeName = pResourceType->GetName();
-            pObjectData->templatePath.Clear();
+            AddObject( objectName, pResourceType->GetName(), NULL, NULL );
         }
     }
 
+    // Rewrite the package manifest if any object files were not covered by it.
+    if( m_bManifestDirty )
+    {
+        WriteManifest();
+        m_bManifestDirty = false;
+    }
 
     // Package preloading is now complete.
     pPackage->SetFlags( GameObject::FLAG_PRELOADED | GameObject::FLAG_LINKED );
@@ -1036,6 +1131,315 @@ void ArchivePackageLoader::TickPreload()
     AtomicExchangeRelease( m_preloadedCounter, 1 );
 }
 
+/// Queue an asynchronous read of the full contents of an object file found in the package directory.
+///
+/// @param[in] objectFileIndex  Index of the file in the object file list.
+void ArchivePackageLoader::QueueObjectFileRead( size_t objectFileIndex )
+{
+    HELIUM_ASSERT( objectFileIndex < m_objectFiles.GetSize() );
+    const ObjectFileInfo& rFileInfo = m_objectFiles[ objectFileIndex ];
+
+    size_t fileSize = static_cast< size_t >( rFileInfo.size );
+
+    FileReadRequest* pRequest = m_fileReadRequests.New();
+    HELIUM_ASSERT( pRequest );
+    pRequest->filePath = rFileInfo.filePath;
+    pRequest->pLoadBuffer = DefaultAllocator().Allocate( fileSize );
+    HELIUM_ASSERT( pRequest->pLoadBuffer );
+    pRequest->expectedSize = rFileInfo.size;
+    pRequest->objectFileIndex = objectFileIndex;
+
+    AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+    pRequest->asyncLoadId = rAsyncLoader.QueueRequest(
+        pRequest->pLoadBuffer,
+        String( rFileInfo.filePath.c_str() ),
+        0,
+        fileSize );
+    HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+}
+
+/// Add the object descriptors from a package manifest for each object file that has not changed since the manifest
+/// was written.
+///
+/// Object files whose size or timestamp differ from those recorded in the manifest are left marked as not being in the
+/// manifest so that they can be read directly.
+///
+/// @param[in] pData  Package manifest file contents.
+/// @param[in] size   Size of the package manifest file, in bytes.
+///
+/// @return  True if the manifest was valid and covered every object file it listed, false if the manifest was invalid
+///          or out of date.
+///
+/// @see WriteManifest()
+bool ArchivePackageLoader::ReadManifest( const void* pData, size_t size )
+{
+    HELIUM_ASSERT( pData || size == 0 );
+
+    if( size < sizeof( ManifestHeader ) )
+    {
+        return false;
+    }
+
+    const ManifestHeader* pHeader = static_cast< const ManifestHeader* >( pData );
+    if( pHeader->magic != MANIFEST_MAGIC ||
+        pHeader->version != MANIFEST_VERSION ||
+        pHeader->characterSize != sizeof( tchar_t ) )
+    {
+        return false;
+    }
+
+    size_t entryCount = pHeader->entryCount;
+    size_t stringPoolSize = pHeader->stringPoolSize;
+    if( size != sizeof( ManifestHeader ) + sizeof( ManifestEntry ) * entryCount + sizeof( tchar_t ) * stringPoolSize )
+    {
+        return false;
+    }
+
+    const ManifestEntry* pEntries = reinterpret_cast< const ManifestEntry* >( pHeader + 1 );
+    const tchar_t* pStringPool = reinterpret_cast< const tchar_t* >( pEntries + entryCount );
+
+    // Make sure every string in the pool is terminated.
+    if( stringPoolSize != 0 && pStringPool[ stringPoolSize - 1 ] != TXT( '\0' ) )
+    {
+        return false;
+    }
+
+    // Map the object files found in the package directory by name.
+    HashMap< Name, size_t > objectFileMap;
+    size_t objectFileCount = m_objectFiles.GetSize();
+    for( size_t objectFileIndex = 0; objectFileIndex < objectFileCount; ++objectFileIndex )
+    {
+        HashMap< Name, size_t >::Iterator fileIterator;
+        objectFileMap.Insert(
+            fileIterator,
+            KeyValue< Name, size_t >( m_objectFiles[ objectFileIndex ].fileName, objectFileIndex ) );
+    }
+
+    bool bUpToDate = true;
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        const ManifestEntry& rEntry = pEntries[ entryIndex ];
+        if( rEntry.fileNameOffset >= stringPoolSize ||
+            rEntry.nameOffset >= stringPoolSize ||
+            rEntry.typeNameOffset >= stringPoolSize ||
+            rEntry.templatePathOffset >= stringPoolSize )
+        {
+            return false;
+        }
+
+        Name fileName( pStringPool + rEntry.fileNameOffset );
+        HashMap< Name, size_t >::ConstIterator fileIterator = objectFileMap.Find( fileName );
+        if( fileIterator == objectFileMap.End() )
+        {
+            // Object file has been removed since the manifest was written.
+            bUpToDate = false;
+
+            continue;
+        }
+
+        ObjectFileInfo& rFileInfo = m_objectFiles[ fileIterator->Second() ];
+        if( rFileInfo.bInManifest ||
+            rFileInfo.size != rEntry.fileSize ||
+            rFileInfo.timestamp != rEntry.fileTimestamp )
+        {
+            // Object file has been modified since the manifest was written, so it will need to be read directly.
+            bUpToDate = false;
+
+            continue;
+        }
+
+        SerializedObjectData* pObjectData = AddObject(
+            Name( pStringPool + rEntry.nameOffset ),
+            Name( pStringPool + rEntry.typeNameOffset ),
+            pStringPool + rEntry.templatePathOffset,
+            &rFileInfo );
+        if( pObjectData )
+        {
+            rFileInfo.bInManifest = true;
+        }
+    }
+
+    return bUpToDate;
+}
+
+/// Write the package manifest, recording the object descriptor, file size, and file timestamp of each object loaded
+/// from an object file in the package directory.
+///
+/// Failure to write the manifest is not fatal, as the object files will simply be read directly again the next time
+/// the package is preloaded.
+///
+/// @see ReadManifest()
+void ArchivePackageLoader::WriteManifest() const
+{
+    FilePath manifestFilePath = m_packageDirPath + HELIUM_ARCHIVE_PACKAGE_MANIFEST_FILENAME;
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "ArchivePackageLoader: Writing package manifest \"%s\".\n" ),
+        manifestFilePath.c_str() );
+
+    DynamicArray< ManifestEntry > entries;
+    DynamicArray< tchar_t > stringPool;
+
+    String templatePathString;
+
+    size_t objectCount = m_objects.GetSize();
+    for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    {
+        const SerializedObjectData& rObjectData = m_objects[ objectIndex ];
+        if( rObjectData.fileName.IsEmpty() )
+        {
+            // Object was not loaded from an object file (i.e. it was registered from a source asset file).
+            continue;
+        }
+
+        const tchar_t* strings[ 4 ];
+        strings[ 0 ] = *rObjectData.fileName;
+        strings[ 1 ] = *rObjectData.objectPath.GetName();
+        strings[ 2 ] = *rObjectData.typeName;
+
+        rObjectData.templatePath.ToString( templatePathString );
+        strings[ 3 ] = *templatePathString;
+
+        uint32_t offsets[ 4 ];
+        for( size_t stringIndex = 0; stringIndex < HELIUM_ARRAY_COUNT( strings ); ++stringIndex )
+        {
+            const tchar_t* pString = strings[ stringIndex ];
+            HELIUM_ASSERT( pString );
+
+            size_t stringPoolSize = stringPool.GetSize();
+            size_t stringLength = StringLength( pString );
+            offsets[ stringIndex ] = static_cast< uint32_t >( stringPoolSize );
+
+            stringPool.Resize( stringPoolSize + stringLength + 1 );
+            MemoryCopy( stringPool.GetData() + stringPoolSize, pString, sizeof( tchar_t ) * ( stringLength + 1 ) );
+        }
+
+        ManifestEntry* pEntry = entries.New();
+        HELIUM_ASSERT( pEntry );
+        pEntry->fileSize = rObjectData.fileSize;
+        pEntry->fileTimestamp = rObjectData.fileTimestamp;
+        pEntry->fileNameOffset = offsets[ 0 ];
+        pEntry->nameOffset = offsets[ 1 ];
+        pEntry->typeNameOffset = offsets[ 2 ];
+        pEntry->templatePathOffset = offsets[ 3 ];
+    }
+
+    FileStream* pManifestStream = FileStream::OpenFileStream( manifestFilePath, FileStream::MODE_WRITE, true );
+    if( !pManifestStream )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            TXT( "ArchivePackageLoader: Failed to open package manifest \"%s\" for writing.\n" ),
+            manifestFilePath.c_str() );
+
+        return;
+    }
+
+    ManifestHeader header;
+    header.magic = MANIFEST_MAGIC;
+    header.version = MANIFEST_VERSION;
+    header.entryCount = static_cast< uint32_t >( entries.GetSize() );
+    header.stringPoolSize = static_cast< uint32_t >( stringPool.GetSize() );
+    header.characterSize = sizeof( tchar_t );
+    header.reserved = 0;
+
+    BufferedStream* pBufferedStream = new BufferedStream( pManifestStream );
+    HELIUM_ASSERT( pBufferedStream );
+
+    pBufferedStream->Write( &header, sizeof( header ), 1 );
+    pBufferedStream->Write( entries.GetData(), sizeof( ManifestEntry ), entries.GetSize() );
+    pBufferedStream->Write( stringPool.GetData(), sizeof( tchar_t ), stringPool.GetSize() );
+
+    delete pBufferedStream;
+    delete pManifestStream;
+}
+
+/// Add an object to the list of objects in this package.
+///
+/// @param[in] objectName     Object name.
+/// @param[in] typeName       Object type name.
+/// @param[in] pTemplatePath  Template object path string (null or empty to use the default template for the type).
+/// @param[in] pFileInfo      Object file from which the object descriptor was read, or null if the object does not
+///                           have an object file.
+///
+/// @return  Pointer to the object data if added successfully, null if an object with the same name already exists or
+///          the template path is invalid.
+ArchivePackageLoader::SerializedObjectData* ArchivePackageLoader::AddObject(
+    Name objectName,
+    Name typeName,
+    const tchar_t* pTemplatePath,
+    const ObjectFileInfo* pFileInfo )
+{
+    if( IsValid( FindObjectIndex( objectName ) ) )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            TXT( "ArchivePackageLoader: Duplicate object \"%s\" found in package \"%s\".\n" ),
+            *objectName,
+            *m_packagePath.ToString() );
+
+        return NULL;
+    }
+
+    GameObjectPath templatePath;
+    if( pTemplatePath && pTemplatePath[ 0 ] != TXT( '\0' ) && !templatePath.Set( pTemplatePath ) )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            TXT( "ArchivePackageLoader: Invalid template path \"%s\" for object \"%s\" in package \"%s\".\n" ),
+            pTemplatePath,
+            *objectName,
+            *m_packagePath.ToString() );
+
+        return NULL;
+    }
+
+    size_t objectIndex = m_objects.GetSize();
+
+    SerializedObjectData* pObjectData = m_objects.New();
+    HELIUM_ASSERT( pObjectData );
+    HELIUM_VERIFY( pObjectData->objectPath.Set( objectName, false, m_packagePath ) );
+    pObjectData->typeName = typeName;
+    pObjectData->templatePath = templatePath;
+
+    if( pFileInfo )
+    {
+        pObjectData->fileName = pFileInfo->fileName;
+        pObjectData->fileSize = pFileInfo->size;
+        pObjectData->fileTimestamp = pFileInfo->timestamp;
+    }
+    else
+    {
+        pObjectData->fileName.Clear();
+        pObjectData->fileSize = 0;
+        pObjectData->fileTimestamp = 0;
+    }
+
+    pObjectData->pFileData = NULL;
+
+    HashMap< Name, size_t >::Iterator indexIterator;
+    HELIUM_VERIFY( m_objectIndexMap.Insert( indexIterator, KeyValue< Name, size_t >( objectName, objectIndex ) ) );
+
+    return pObjectData;
+}
+
+/// Find the index of an object directly within this package.
+///
+/// @param[in] objectName  Object name.
+///
+/// @return  Index of the object in the object list if found, invalid index if not found.
+size_t ArchivePackageLoader::FindObjectIndex( Name objectName ) const
+{
+    HashMap< Name, size_t >::ConstIterator indexIterator = m_objectIndexMap.Find( objectName );
+    if( indexIterator == m_objectIndexMap.End() )
+    {
+        return Invalid< size_t >();
+    }
+
+    return indexIterator->Second();
+}
+
 /// Update load processing of object load requests.
 void ArchivePackageLoader::TickLoadRequests()
 {
@@ -1216,8 +1620,20 @@ bool ArchivePackageLoader::TickDeserialize( LoadRequest* pRequest )
     FilePath object_file_path = m_packageDirPath + *rObjectData.objectPath.GetName() + TXT(".xml.object");
 
     bool load_properties_from_file = true;
+    bool object_file_preloaded = false;
     size_t object_file_size = 0;
-    if ( !IsValid( pRequest->asyncFileLoadId ) )
+    if ( !IsValid( pRequest->asyncFileLoadId ) && rObjectData.pFileData )
+    {
+        // The object file was already read in full while preloading the package, so deserialize from those contents
+        // instead of reading the file again.
+        HELIUM_ASSERT( !pRequest->pAsyncFileLoadBuffer );
+        pRequest->pAsyncFileLoadBuffer = rObjectData.pFileData;
+        pRequest->asyncFileLoadBufferSize = static_cast< size_t >( rObjectData.fileSize );
+        rObjectData.pFileData = NULL;
+
+        object_file_preloaded = true;
+    }
+    else if ( !IsValid( pRequest->asyncFileLoadId ) )
     {
         if (!object_file_path.IsFile())
         {
@@ -1308,7 +1724,11 @@ bool ArchivePackageLoader::TickDeserialize( LoadRequest* pRequest )
     }
     
     size_t bytesRead = 0;
-    if (load_properties_from_file)
+    if (object_file_preloaded)
+    {
+        bytesRead = pRequest->asyncFileLoadBufferSize;
+    }
+    else if (load_properties_from_file)
     {
         HELIUM_ASSERT( IsValid( pRequest->asyncFileLoadId ) );
 
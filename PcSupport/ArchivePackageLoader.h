@@ -15,11 +15,14 @@
 //#include "Engine/Serializer.h"
 
 #include "Foundation/FilePath.h"
+#include "Foundation/HashMap.h"
 
 /// XML package file extension string.
 #define HELIUM_ARCHIVE_PACKAGE_OBJECT_FILE_EXTENSION TXT( ".object" )
 /// Directory-based XML package file name string.
 //#define HELIUM_ARCHIVE_PACKAGE_TOC_FILENAME TXT( "!toc.xml" )
+/// Package manifest file name string.
+#define HELIUM_ARCHIVE_PACKAGE_MANIFEST_FILENAME TXT( "!package.manifest" )
 
 namespace Helium
 {
@@ -48,6 +51,9 @@ namespace Helium
         /// Maximum number of bytes to parse at a time.
         static const size_t PARSE_CHUNK_SIZE = 4 * 1024;
 
+        /// Package manifest file format version.
+        static const uint32_t MANIFEST_VERSION = 1;
+
         /// Serialized object data.
         struct SerializedObjectData
         {
@@ -59,6 +65,15 @@ namespace Helium
             /// Template path.
             GameObjectPath templatePath;
 
+            /// Name of the object file in the package directory (null name if the object has no object file).
+            Name fileName;
+            /// Size of the object file, in bytes.
+            uint64_t fileSize;
+            /// Modification timestamp of the object file.
+            int64_t fileTimestamp;
+            /// Object file contents read during preloading, kept for deserialization (null if not read).
+            void* pFileData;
+
             /// Serialized properties.
             //ConcurrentHashMap< String, String > properties;
             /// Cached array sizes.
@@ -183,6 +198,8 @@ namespace Helium
 
         /// Serialized object data parsed from the XML package.
         DynamicArray< SerializedObjectData > m_objects;
+        /// Index of each entry in m_objects, keyed by object name.
+        HashMap< Name, size_t > m_objectIndexMap;
 
         /// Pending load requests.
         SparseArray< LoadRequest* > m_loadRequests;
@@ -206,9 +223,72 @@ namespace Helium
             void* pLoadBuffer;
             size_t asyncLoadId;
             uint64_t expectedSize;
+            /// Index of the file in m_objectFiles.
+            size_t objectFileIndex;
         };
         DynamicArray<FileReadRequest> m_fileReadRequests;
 
+        /// Object file found in the package directory.
+        struct ObjectFileInfo
+        {
+            /// Full file path.
+            FilePath filePath;
+            /// File name within the package directory.
+            Name fileName;
+            /// File size, in bytes.
+            uint64_t size;
+            /// Modification timestamp.
+            int64_t timestamp;
+            /// True if the object descriptor for this file was found in the package manifest.
+            bool bInManifest;
+        };
+
+        /// Package manifest file header.
+        struct ManifestHeader
+        {
+            /// Magic number identifying the file.
+            uint32_t magic;
+            /// File format version.
+            uint32_t version;
+            /// Number of entries.
+            uint32_t entryCount;
+            /// Number of characters in the string pool.
+            uint32_t stringPoolSize;
+            /// Size of each string pool character, in bytes.
+            uint32_t characterSize;
+            /// Padding for aligning the entries that follow (always zero).
+            uint32_t reserved;
+        };
+
+        /// Package manifest entry (one per object file).
+        struct ManifestEntry
+        {
+            /// Object file size, in bytes.
+            uint64_t fileSize;
+            /// Object file modification timestamp.
+            int64_t fileTimestamp;
+            /// String pool offset of the object file name.
+            uint32_t fileNameOffset;
+            /// String pool offset of the object name.
+            uint32_t nameOffset;
+            /// String pool offset of the object type name.
+            uint32_t typeNameOffset;
+            /// String pool offset of the template path.
+            uint32_t templatePathOffset;
+        };
+
+        /// Object files found in the package directory when preloading began.
+        DynamicArray< ObjectFileInfo > m_objectFiles;
+
+        /// Buffer for loading the package manifest.
+        void* m_pManifestLoadBuffer;
+        /// Size of the package manifest file.
+        size_t m_manifestFileSize;
+        /// Async load ID for the package manifest.
+        size_t m_manifestLoadId;
+        /// True if the package manifest needs to be rewritten once preloading completes.
+        bool m_bManifestDirty;
+
 
         /// Parent package load request ID.
         size_t m_parentPackageLoadId;
@@ -220,6 +300,13 @@ namespace Helium
         //@{
         void TickPreload();
 
+        void QueueObjectFileRead( size_t objectFileIndex );
+        bool ReadManifest( const void* pData, size_t size );
+        void WriteManifest() const;
+        SerializedObjectData* AddObject(
+            Name objectName, Name typeName, const tchar_t* pTemplatePath, const ObjectFileInfo* pFileInfo );
+        size_t FindObjectIndex( Name objectName ) const;
+
         void TickLoadRequests();
         bool TickDeserialize( LoadRequest* pRequest );
         bool TickPersistentResourcePreload( LoadRequest* pRequest );
@@ -0,0 +1,918 @@
+//----------------------------------------------------------------------------------------------------------------------
+// DependencyDatabase.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "PcSupportPch.h"
+#include "PcSupport/DependencyDatabase.h"
+
+#include "Platform/File.h"
+#include "Foundation/FileStream.h"
+
+using namespace Helium;
+
+/// Dependency database file magic number.
+static const uint32_t DATABASE_MAGIC = 0x42445048;  // 'HPDB'
+
+/// Size of the buffer used when reading files for hashing.
+static const size_t HASH_READ_BUFFER_SIZE = 64 * 1024;
+
+/// Constructor.
+DependencyDatabase::DependencyDatabase()
+    : m_bDirty( false )
+{
+}
+
+/// Destructor.
+DependencyDatabase::~DependencyDatabase()
+{
+    Shutdown();
+}
+
+/// Initialize this database, loading the existing database file if one exists.
+///
+/// @param[in] pFileName  Name of the file in which to store the database.
+///
+/// @return  True if initialization was successful, false if not.  A missing or invalid database file is not considered
+///          a failure, as the database will simply start out empty.
+///
+/// @see Shutdown()
+bool DependencyDatabase::Initialize( const tchar_t* pFileName )
+{
+    HELIUM_ASSERT( pFileName );
+
+    Shutdown();
+
+    MutexScopeLock scopeLock( m_lock );
+
+    m_fileName = pFileName;
+    if( !Load() )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Info,
+            TXT( "DependencyDatabase: Database \"%s\" is missing or out of date and will be rebuilt.\n" ),
+            pFileName );
+
+        m_files.Clear();
+        m_objects.Clear();
+    }
+
+    return true;
+}
+
+/// Save any changes to this database and release all of its records.
+///
+/// @see Initialize()
+void DependencyDatabase::Shutdown()
+{
+    if( m_bDirty )
+    {
+        Save();
+    }
+
+    MutexScopeLock scopeLock( m_lock );
+
+    HELIUM_ASSERT( m_pendingObjects.IsEmpty() );
+
+    m_files.Clear();
+    m_objects.Clear();
+    m_pendingObjects.Clear();
+    m_fileName.Clear();
+    m_bDirty = false;
+}
+
+/// Write the contents of this database to its file.
+///
+/// @return  True if the database was written successfully, false if not.
+bool DependencyDatabase::Save()
+{
+    MutexScopeLock scopeLock( m_lock );
+
+    if( m_fileName.IsEmpty() )
+    {
+        return false;
+    }
+
+    DynamicArray< tchar_t > stringPool;
+
+    DynamicArray< FileEntry > fileEntries;
+    fileEntries.Reserve( m_files.GetSize() );
+
+    HashMap< Name, FileRecord >::ConstIterator fileEnd = m_files.End();
+    for( HashMap< Name, FileRecord >::ConstIterator fileIterator = m_files.Begin();
+        fileIterator != fileEnd;
+        ++fileIterator )
+    {
+        const FileRecord& rRecord = fileIterator->Second();
+
+        FileEntry* pEntry = fileEntries.New();
+        HELIUM_ASSERT( pEntry );
+        pEntry->hash = rRecord.hash;
+        pEntry->size = rRecord.size;
+        pEntry->timestamp = rRecord.timestamp;
+        pEntry->pathOffset = AddPoolString( stringPool, *fileIterator->First() );
+        pEntry->reserved = 0;
+    }
+
+    DynamicArray< ObjectEntry > objectEntries;
+    objectEntries.Reserve( m_objects.GetSize() );
+
+    DynamicArray< DependencyEntry > dependencyEntries;
+
+    String pathString;
+
+    HashMap< GameObjectPath, ObjectRecord >::ConstIterator objectEnd = m_objects.End();
+    for( HashMap< GameObjectPath, ObjectRecord >::ConstIterator objectIterator = m_objects.Begin();
+        objectIterator != objectEnd;
+        ++objectIterator )
+    {
+        const ObjectRecord& rRecord = objectIterator->Second();
+
+        objectIterator->First().ToString( pathString );
+
+        ObjectEntry* pEntry = objectEntries.New();
+        HELIUM_ASSERT( pEntry );
+        pEntry->sourceHash = rRecord.sourceHash;
+        pEntry->objectDataHash = rRecord.objectDataHash;
+        pEntry->key = rRecord.key;
+        pEntry->pathOffset = AddPoolString( stringPool, *pathString );
+        pEntry->sourcePathOffset = AddPoolString(
+            stringPool,
+            ( rRecord.sourceFilePath.IsEmpty() ? TXT( "" ) : *rRecord.sourceFilePath ) );
+        pEntry->handlerVersion = rRecord.handlerVersion;
+        pEntry->dependencyCount = static_cast< uint32_t >( rRecord.dependencies.GetSize() );
+
+        size_t dependencyCount = rRecord.dependencies.GetSize();
+        for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+        {
+            const Dependency& rDependency = rRecord.dependencies[ dependencyIndex ];
+
+            DependencyEntry* pDependencyEntry = dependencyEntries.New();
+            HELIUM_ASSERT( pDependencyEntry );
+            pDependencyEntry->hash = rDependency.hash;
+            pDependencyEntry->type = rDependency.type;
+
+            if( rDependency.type == DEPENDENCY_TYPE_FILE )
+            {
+                pDependencyEntry->pathOffset = AddPoolString( stringPool, *rDependency.filePath );
+            }
+            else
+            {
+                rDependency.objectPath.ToString( pathString );
+                pDependencyEntry->pathOffset = AddPoolString( stringPool, *pathString );
+            }
+        }
+    }
+
+    FileStream* pFileStream = FileStream::OpenFileStream( m_fileName, FileStream::MODE_WRITE, true );
+    if( !pFileStream )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "DependencyDatabase: Failed to open \"%s\" for writing.\n" ),
+            *m_fileName );
+
+        return false;
+    }
+
+    FileHeader header;
+    header.magic = DATABASE_MAGIC;
+    header.version = VERSION;
+    header.fileCount = static_cast< uint32_t >( fileEntries.GetSize() );
+    header.objectCount = static_cast< uint32_t >( objectEntries.GetSize() );
+    header.dependencyCount = static_cast< uint32_t >( dependencyEntries.GetSize() );
+    header.stringPoolSize = static_cast< uint32_t >( stringPool.GetSize() );
+    header.characterSize = sizeof( tchar_t );
+    header.reserved = 0;
+
+    BufferedStream* pBufferedStream = new BufferedStream( pFileStream );
+    HELIUM_ASSERT( pBufferedStream );
+
+    pBufferedStream->Write( &header, sizeof( header ), 1 );
+    pBufferedStream->Write( fileEntries.GetData(), sizeof( FileEntry ), fileEntries.GetSize() );
+    pBufferedStream->Write( objectEntries.GetData(), sizeof( ObjectEntry ), objectEntries.GetSize() );
+    pBufferedStream->Write( dependencyEntries.GetData(), sizeof( DependencyEntry ), dependencyEntries.GetSize() );
+    pBufferedStream->Write( stringPool.GetData(), sizeof( tchar_t ), stringPool.GetSize() );
+
+    delete pBufferedStream;
+    delete pFileStream;
+
+    m_bDirty = false;
+
+    return true;
+}
+
+/// Get the hash of the contents of a file.
+///
+/// The hash is only recomputed if the size or modification timestamp of the file has changed since the hash was last
+/// computed.
+///
+/// @param[in] pFilePath  File path.
+///
+/// @return  File content hash, or zero if the file does not exist or could not be read.
+uint64_t DependencyDatabase::GetFileHash( const tchar_t* pFilePath )
+{
+    HELIUM_ASSERT( pFilePath );
+
+    MutexScopeLock scopeLock( m_lock );
+
+    return GetFileHashUnlocked( Name( pFilePath ) );
+}
+
+/// Compute the current cook key for an object.
+///
+/// The key is computed from the current contents of the object's source file, its serialized property data, the
+/// handler version, and the current state of every dependency recorded the last time the object was cooked.  If the
+/// key matches the one with which the object's cached data was written, the cached data is up to date.
+///
+/// @param[in] objectPath       Object path.
+/// @param[in] pSourceFilePath  Source file path, or null if the object has no source file.
+/// @param[in] objectDataHash   Hash of the serialized object property data.
+/// @param[in] handlerVersion   Version of the resource handler used to cook the object.
+///
+/// @return  Current cook key.
+///
+/// @see GetObjectKey(), EndObjectRecord()
+uint64_t DependencyDatabase::ComputeObjectKey(
+    GameObjectPath objectPath,
+    const tchar_t* pSourceFilePath,
+    uint64_t objectDataHash,
+    uint32_t handlerVersion )
+{
+    HELIUM_ASSERT( !objectPath.IsEmpty() );
+
+    MutexScopeLock scopeLock( m_lock );
+
+    const DynamicArray< Dependency >* pDependencies = NULL;
+
+    HashMap< GameObjectPath, ObjectRecord >::ConstIterator objectIterator = m_objects.Find( objectPath );
+    if( objectIterator != m_objects.End() )
+    {
+        pDependencies = &objectIterator->Second().dependencies;
+    }
+
+    Name sourceFilePath;
+    if( pSourceFilePath )
+    {
+        sourceFilePath.Set( pSourceFilePath );
+    }
+
+    return ComputeKey( sourceFilePath, objectDataHash, handlerVersion, pDependencies, 0 );
+}
+
+/// Get the cook key recorded the last time an object was cooked.
+///
+/// @param[in]  objectPath  Object path.
+/// @param[out] rKey        Recorded cook key.
+///
+/// @return  True if a cook record exists for the object, false if not.
+///
+/// @see ComputeObjectKey()
+bool DependencyDatabase::GetObjectKey( GameObjectPath objectPath, uint64_t& rKey ) const
+{
+    MutexScopeLock scopeLock( m_lock );
+
+    HashMap< GameObjectPath, ObjectRecord >::ConstIterator objectIterator = m_objects.Find( objectPath );
+    if( objectIterator == m_objects.End() )
+    {
+        return false;
+    }
+
+    rKey = objectIterator->Second().key;
+
+    return true;
+}
+
+/// Begin recording the dependencies of an object being cooked.
+///
+/// While the object is being cooked, call AddFileDependency() and AddObjectDependency() for each input that affects
+/// the cooked data, then call EndObjectRecord() to commit the record.
+///
+/// @param[in] objectPath       Object path.
+/// @param[in] pSourceFilePath  Source file path, or null if the object has no source file.
+/// @param[in] objectDataHash   Hash of the serialized object property data.
+/// @param[in] handlerVersion   Version of the resource handler used to cook the object.
+///
+/// @see EndObjectRecord()
+void DependencyDatabase::BeginObjectRecord(
+    GameObjectPath objectPath,
+    const tchar_t* pSourceFilePath,
+    uint64_t objectDataHash,
+    uint32_t handlerVersion )
+{
+    HELIUM_ASSERT( !objectPath.IsEmpty() );
+
+    MutexScopeLock scopeLock( m_lock );
+
+    HashMap< GameObjectPath, ObjectRecord >::Iterator objectIterator;
+    m_pendingObjects.Insert( objectIterator, KeyValue< GameObjectPath, ObjectRecord >( objectPath, ObjectRecord() ) );
+
+    ObjectRecord& rRecord = objectIterator->Second();
+    rRecord.sourceFilePath.Clear();
+    if( pSourceFilePath )
+    {
+        rRecord.sourceFilePath.Set( pSourceFilePath );
+    }
+
+    rRecord.sourceHash = 0;
+    rRecord.objectDataHash = objectDataHash;
+    rRecord.key = 0;
+    rRecord.handlerVersion = handlerVersion;
+    rRecord.dependencies.Resize( 0 );
+}
+
+/// Record a file on which the cooked data of an object depends.
+///
+/// @param[in] objectPath  Path of the object being cooked (see BeginObjectRecord()).
+/// @param[in] pFilePath   Dependency file path.
+///
+/// @see AddObjectDependency()
+void DependencyDatabase::AddFileDependency( GameObjectPath objectPath, const tchar_t* pFilePath )
+{
+    HELIUM_ASSERT( pFilePath );
+
+    MutexScopeLock scopeLock( m_lock );
+
+    HashMap< GameObjectPath, ObjectRecord >::Iterator objectIterator = m_pendingObjects.Find( objectPath );
+    HELIUM_ASSERT( objectIterator != m_pendingObjects.End() );
+    if( objectIterator == m_pendingObjects.End() )
+    {
+        return;
+    }
+
+    Name filePath( pFilePath );
+
+    DynamicArray< Dependency >& rDependencies = objectIterator->Second().dependencies;
+    size_t dependencyCount = rDependencies.GetSize();
+    for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+    {
+        const Dependency& rDependency = rDependencies[ dependencyIndex ];
+        if( rDependency.type == DEPENDENCY_TYPE_FILE && rDependency.filePath == filePath )
+        {
+            return;
+        }
+    }
+
+    Dependency* pDependency = rDependencies.New();
+    HELIUM_ASSERT( pDependency );
+    pDependency->filePath = filePath;
+    pDependency->objectPath.Clear();
+    pDependency->hash = 0;
+    pDependency->type = DEPENDENCY_TYPE_FILE;
+}
+
+/// Record another cooked object on which the cooked data of an object depends.
+///
+/// @param[in] objectPath      Path of the object being cooked (see BeginObjectRecord()).
+/// @param[in] dependencyPath  Dependency object path.
+///
+/// @see AddFileDependency()
+void DependencyDatabase::AddObjectDependency( GameObjectPath objectPath, GameObjectPath dependencyPath )
+{
+    HELIUM_ASSERT( !dependencyPath.IsEmpty() );
+
+    if( dependencyPath == objectPath )
+    {
+        return;
+    }
+
+    MutexScopeLock scopeLock( m_lock );
+
+    HashMap< GameObjectPath, ObjectRecord >::Iterator objectIterator = m_pendingObjects.Find( objectPath );
+    HELIUM_ASSERT( objectIterator != m_pendingObjects.End() );
+    if( objectIterator == m_pendingObjects.End() )
+    {
+        return;
+    }
+
+    DynamicArray< Dependency >& rDependencies = objectIterator->Second().dependencies;
+    size_t dependencyCount = rDependencies.GetSize();
+    for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+    {
+        const Dependency& rDependency = rDependencies[ dependencyIndex ];
+        if( rDependency.type == DEPENDENCY_TYPE_OBJECT && rDependency.objectPath == dependencyPath )
+        {
+            return;
+        }
+    }
+
+    Dependency* pDependency = rDependencies.New();
+    HELIUM_ASSERT( pDependency );
+    pDependency->filePath.Clear();
+    pDependency->objectPath = dependencyPath;
+    pDependency->hash = 0;
+    pDependency->type = DEPENDENCY_TYPE_OBJECT;
+}
+
+/// Finish recording the dependencies of an object being cooked.
+///
+/// @param[in] objectPath  Path of the object being cooked (see BeginObjectRecord()).
+/// @param[in] bCommit     True to replace the existing record for the object with the new record, false to discard
+///                        the new record (i.e. if cooking failed).
+///
+/// @return  Cook key with which the cooked data should be cached if the record was committed, zero if not.
+///
+/// @see BeginObjectRecord()
+uint64_t DependencyDatabase::EndObjectRecord( GameObjectPath objectPath, bool bCommit )
+{
+    MutexScopeLock scopeLock( m_lock );
+
+    HashMap< GameObjectPath, ObjectRecord >::Iterator pendingIterator = m_pendingObjects.Find( objectPath );
+    HELIUM_ASSERT( pendingIterator != m_pendingObjects.End() );
+    if( pendingIterator == m_pendingObjects.End() )
+    {
+        return 0;
+    }
+
+    if( !bCommit )
+    {
+        m_pendingObjects.Remove( objectPath );
+
+        return 0;
+    }
+
+    HashMap< GameObjectPath, ObjectRecord >::Iterator objectIterator;
+    m_objects.Insert( objectIterator, KeyValue< GameObjectPath, ObjectRecord >( objectPath, ObjectRecord() ) );
+
+    ObjectRecord& rRecord = objectIterator->Second();
+    rRecord = pendingIterator->Second();
+    m_pendingObjects.Remove( objectPath );
+
+    // Record the state of each input at the time the object was cooked.
+    rRecord.sourceHash = ( rRecord.sourceFilePath.IsEmpty() ? 0 : GetFileHashUnlocked( rRecord.sourceFilePath ) );
+
+    size_t dependencyCount = rRecord.dependencies.GetSize();
+    for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+    {
+        Dependency& rDependency = rRecord.dependencies[ dependencyIndex ];
+        rDependency.hash = ComputeDependencyHash( rDependency, 0 );
+    }
+
+    rRecord.key = ComputeKey(
+        rRecord.sourceFilePath,
+        rRecord.objectDataHash,
+        rRecord.handlerVersion,
+        &rRecord.dependencies,
+        0 );
+
+    m_bDirty = true;
+
+    return rRecord.key;
+}
+
+/// Get the objects whose cooked data depends on a given file, either directly (as a source file or file dependency)
+/// or indirectly through another cooked object.
+///
+/// @param[in]  pFilePath    File path.
+/// @param[out] rDependents  Paths of all dependent objects.
+void DependencyDatabase::GetFileDependents( const tchar_t* pFilePath, DynamicArray< GameObjectPath >& rDependents ) const
+{
+    HELIUM_ASSERT( pFilePath );
+
+    rDependents.Resize( 0 );
+
+    MutexScopeLock scopeLock( m_lock );
+
+    Name filePath( pFilePath );
+
+    HashMap< GameObjectPath, ObjectRecord >::ConstIterator objectEnd = m_objects.End();
+    for( HashMap< GameObjectPath, ObjectRecord >::ConstIterator objectIterator = m_objects.Begin();
+        objectIterator != objectEnd;
+        ++objectIterator )
+    {
+        if( DependsOn( objectIterator->Second(), filePath, 0 ) )
+        {
+            rDependents.Push( objectIterator->First() );
+        }
+    }
+}
+
+/// Compute the 64-bit FNV-1a hash of a block of data.
+///
+/// @param[in] pData  Data to hash.
+/// @param[in] size   Size of the data, in bytes.
+/// @param[in] hash   Hash value with which to start (either HASH_SEED or the result of a previous call when hashing
+///                   data in multiple blocks).
+///
+/// @return  Updated hash value.
+uint64_t DependencyDatabase::ComputeHash( const void* pData, size_t size, uint64_t hash )
+{
+    HELIUM_ASSERT( pData || size == 0 );
+
+    const uint8_t* pBytes = static_cast< const uint8_t* >( pData );
+    for( size_t byteIndex = 0; byteIndex < size; ++byteIndex )
+    {
+        hash ^= pBytes[ byteIndex ];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/// Load the contents of the database file.
+///
+/// This must be called with the database lock held.
+///
+/// @return  True if the database file was loaded successfully, false if it does not exist or is invalid.
+bool DependencyDatabase::Load()
+{
+    Status status;
+    if( !status.Read( *m_fileName ) || status.m_Size <= 0 )
+    {
+        return false;
+    }
+
+    if( static_cast< uint64_t >( status.m_Size ) >= UINT32_MAX )
+    {
+        return false;
+    }
+
+    FileStream* pFileStream = FileStream::OpenFileStream( m_fileName, FileStream::MODE_READ );
+    if( !pFileStream )
+    {
+        return false;
+    }
+
+    size_t fileSize = static_cast< size_t >( status.m_Size );
+
+    DynamicArray< uint8_t > fileData;
+    fileData.Resize( fileSize );
+    size_t bytesRead = pFileStream->Read( fileData.GetData(), 1, fileSize );
+
+    delete pFileStream;
+
+    if( bytesRead != fileSize || fileSize < sizeof( FileHeader ) )
+    {
+        return false;
+    }
+
+    const FileHeader* pHeader = reinterpret_cast< const FileHeader* >( fileData.GetData() );
+    if( pHeader->magic != DATABASE_MAGIC ||
+        pHeader->version != VERSION ||
+        pHeader->characterSize != sizeof( tchar_t ) )
+    {
+        return false;
+    }
+
+    size_t fileCount = pHeader->fileCount;
+    size_t objectCount = pHeader->objectCount;
+    size_t dependencyCount = pHeader->dependencyCount;
+    size_t stringPoolSize = pHeader->stringPoolSize;
+
+    size_t expectedSize =
+        sizeof( FileHeader ) +
+        sizeof( FileEntry ) * fileCount +
+        sizeof( ObjectEntry ) * objectCount +
+        sizeof( DependencyEntry ) * dependencyCount +
+        sizeof( tchar_t ) * stringPoolSize;
+    if( fileSize != expectedSize )
+    {
+        return false;
+    }
+
+    const FileEntry* pFileEntries = reinterpret_cast< const FileEntry* >( pHeader + 1 );
+    const ObjectEntry* pObjectEntries = reinterpret_cast< const ObjectEntry* >( pFileEntries + fileCount );
+    const DependencyEntry* pDependencyEntries = reinterpret_cast< const DependencyEntry* >(
+        pObjectEntries + objectCount );
+    const tchar_t* pStringPool = reinterpret_cast< const tchar_t* >( pDependencyEntries + dependencyCount );
+
+    if( stringPoolSize != 0 && pStringPool[ stringPoolSize - 1 ] != TXT( '\0' ) )
+    {
+        return false;
+    }
+
+    for( size_t fileIndex = 0; fileIndex < fileCount; ++fileIndex )
+    {
+        const FileEntry& rEntry = pFileEntries[ fileIndex ];
+        if( rEntry.pathOffset >= stringPoolSize )
+        {
+            return false;
+        }
+
+        FileRecord record;
+        record.hash = rEntry.hash;
+        record.size = rEntry.size;
+        record.timestamp = rEntry.timestamp;
+
+        HashMap< Name, FileRecord >::Iterator fileIterator;
+        m_files.Insert(
+            fileIterator,
+            KeyValue< Name, FileRecord >( Name( pStringPool + rEntry.pathOffset ), record ) );
+    }
+
+    size_t dependencyIndex = 0;
+    for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    {
+        const ObjectEntry& rEntry = pObjectEntries[ objectIndex ];
+        if( rEntry.pathOffset >= stringPoolSize ||
+            rEntry.sourcePathOffset >= stringPoolSize ||
+            rEntry.dependencyCount > dependencyCount - dependencyIndex )
+        {
+            return false;
+        }
+
+        GameObjectPath objectPath;
+        if( !objectPath.Set( pStringPool + rEntry.pathOffset ) )
+        {
+            dependencyIndex += rEntry.dependencyCount;
+
+            continue;
+        }
+
+        HashMap< GameObjectPath, ObjectRecord >::Iterator objectIterator;
+        m_objects.Insert( objectIterator, KeyValue< GameObjectPath, ObjectRecord >( objectPath, ObjectRecord() ) );
+
+        ObjectRecord& rRecord = objectIterator->Second();
+        rRecord.sourceFilePath.Clear();
+        const tchar_t* pSourcePath = pStringPool + rEntry.sourcePathOffset;
+        if( pSourcePath[ 0 ] != TXT( '\0' ) )
+        {
+            rRecord.sourceFilePath.Set( pSourcePath );
+        }
+
+        rRecord.sourceHash = rEntry.sourceHash;
+        rRecord.objectDataHash = rEntry.objectDataHash;
+        rRecord.key = rEntry.key;
+        rRecord.handlerVersion = rEntry.handlerVersion;
+        rRecord.dependencies.Reserve( rEntry.dependencyCount );
+        rRecord.dependencies.Resize( 0 );
+
+        for( uint32_t entryDependencyIndex = 0;
+            entryDependencyIndex < rEntry.dependencyCount;
+            ++entryDependencyIndex, ++dependencyIndex )
+        {
+            const DependencyEntry& rDependencyEntry = pDependencyEntries[ dependencyIndex ];
+            if( rDependencyEntry.pathOffset >= stringPoolSize )
+            {
+                return false;
+            }
+
+            const tchar_t* pPath = pStringPool + rDependencyEntry.pathOffset;
+
+            Dependency* pDependency = rRecord.dependencies.New();
+            HELIUM_ASSERT( pDependency );
+            pDependency->hash = rDependencyEntry.hash;
+            pDependency->type = rDependencyEntry.type;
+
+            if( rDependencyEntry.type == DEPENDENCY_TYPE_FILE )
+            {
+                pDependency->filePath.Set( pPath );
+                pDependency->objectPath.Clear();
+            }
+            else if( rDependencyEntry.type == DEPENDENCY_TYPE_OBJECT )
+            {
+                pDependency->filePath.Clear();
+                if( !pDependency->objectPath.Set( pPath ) )
+                {
+                    // Keep an entry for the invalid path so that the cook key still changes.
+                    pDependency->objectPath.Clear();
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+
+    m_bDirty = false;
+
+    return true;
+}
+
+/// Get the hash of the contents of a file.
+///
+/// This must be called with the database lock held.
+///
+/// @param[in] filePath  File path.
+///
+/// @return  File content hash, or zero if the file does not exist or could not be read.
+///
+/// @see GetFileHash()
+uint64_t DependencyDatabase::GetFileHashUnlocked( Name filePath )
+{
+    HELIUM_ASSERT( !filePath.IsEmpty() );
+
+    Status status;
+    if( !status.Read( *filePath ) || status.m_Size < 0 )
+    {
+        return 0;
+    }
+
+    HashMap< Name, FileRecord >::Iterator fileIterator = m_files.Find( filePath );
+    if( fileIterator != m_files.End() )
+    {
+        const FileRecord& rRecord = fileIterator->Second();
+        if( rRecord.size == status.m_Size && rRecord.timestamp == status.m_ModifiedTime )
+        {
+            return rRecord.hash;
+        }
+    }
+
+    FileStream* pFileStream = FileStream::OpenFileStream( *filePath, FileStream::MODE_READ );
+    if( !pFileStream )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            TXT( "DependencyDatabase: Failed to open \"%s\" for hashing.\n" ),
+            *filePath );
+
+        return 0;
+    }
+
+    DynamicArray< uint8_t > readBuffer;
+    readBuffer.Resize( HASH_READ_BUFFER_SIZE );
+
+    uint64_t hash = HASH_SEED;
+    for( ; ; )
+    {
+        size_t bytesRead = pFileStream->Read( readBuffer.GetData(), 1, HASH_READ_BUFFER_SIZE );
+        hash = ComputeHash( readBuffer.GetData(), bytesRead, hash );
+        if( bytesRead < HASH_READ_BUFFER_SIZE )
+        {
+            break;
+        }
+    }
+
+    delete pFileStream;
+
+    FileRecord record;
+    record.hash = hash;
+    record.size = status.m_Size;
+    record.timestamp = status.m_ModifiedTime;
+
+    if( fileIterator != m_files.End() )
+    {
+        fileIterator->Second() = record;
+    }
+    else
+    {
+        m_files.Insert( fileIterator, KeyValue< Name, FileRecord >( filePath, record ) );
+    }
+
+    m_bDirty = true;
+
+    return hash;
+}
+
+/// Compute a cook key from the current state of the inputs of an object.
+///
+/// This must be called with the database lock held.
+///
+/// @param[in] sourceFilePath  Source file path (null name if the object has no source file).
+/// @param[in] objectDataHash  Hash of the serialized object property data.
+/// @param[in] handlerVersion  Resource handler version.
+/// @param[in] pDependencies   Recorded dependencies (can be null if no dependencies have been recorded).
+/// @param[in] depth           Current object dependency depth.
+///
+/// @return  Cook key.
+uint64_t DependencyDatabase::ComputeKey(
+    Name sourceFilePath,
+    uint64_t objectDataHash,
+    uint32_t handlerVersion,
+    const DynamicArray< Dependency >* pDependencies,
+    size_t depth )
+{
+    uint64_t key = HASH_SEED;
+    key = HashValue( key, handlerVersion );
+    key = HashValue( key, objectDataHash );
+    key = HashValue( key, ( sourceFilePath.IsEmpty() ? 0 : GetFileHashUnlocked( sourceFilePath ) ) );
+
+    if( pDependencies )
+    {
+        size_t dependencyCount = pDependencies->GetSize();
+        key = HashValue( key, dependencyCount );
+
+        for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+        {
+            const Dependency& rDependency = ( *pDependencies )[ dependencyIndex ];
+            key = HashValue( key, rDependency.type );
+            key = HashValue( key, ComputeDependencyHash( rDependency, depth ) );
+        }
+    }
+
+    return key;
+}
+
+/// Compute the current hash of a dependency.
+///
+/// This must be called with the database lock held.
+///
+/// @param[in] rDependency  Dependency.
+/// @param[in] depth        Current object dependency depth.
+///
+/// @return  Current content hash of a file dependency, or current cook key of an object dependency.
+uint64_t DependencyDatabase::ComputeDependencyHash( const Dependency& rDependency, size_t depth )
+{
+    if( rDependency.type == DEPENDENCY_TYPE_FILE )
+    {
+        return GetFileHashUnlocked( rDependency.filePath );
+    }
+
+    if( rDependency.objectPath.IsEmpty() )
+    {
+        return 0;
+    }
+
+    HashMap< GameObjectPath, ObjectRecord >::ConstIterator objectIterator = m_objects.Find( rDependency.objectPath );
+    if( objectIterator == m_objects.End() )
+    {
+        // Dependency has not been cooked, so there is no state to track.
+        return 0;
+    }
+
+    const ObjectRecord& rRecord = objectIterator->Second();
+    if( depth >= DEPENDENCY_DEPTH_MAX )
+    {
+        // Don't follow circular or excessively deep dependency chains any further.
+        return rRecord.key;
+    }
+
+    return ComputeKey(
+        rRecord.sourceFilePath,
+        rRecord.objectDataHash,
+        rRecord.handlerVersion,
+        &rRecord.dependencies,
+        depth + 1 );
+}
+
+/// Get whether the cooked data for an object depends on a given file.
+///
+/// This must be called with the database lock held.
+///
+/// @param[in] rRecord   Object cook record.
+/// @param[in] filePath  File path.
+/// @param[in] depth     Current object dependency depth.
+///
+/// @return  True if the object depends on the file, directly or indirectly, false if not.
+bool DependencyDatabase::DependsOn( const ObjectRecord& rRecord, Name filePath, size_t depth ) const
+{
+    if( rRecord.sourceFilePath == filePath )
+    {
+        return true;
+    }
+
+    size_t dependencyCount = rRecord.dependencies.GetSize();
+    for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+    {
+        const Dependency& rDependency = rRecord.dependencies[ dependencyIndex ];
+        if( rDependency.type == DEPENDENCY_TYPE_FILE )
+        {
+            if( rDependency.filePath == filePath )
+            {
+                return true;
+            }
+        }
+        else if( depth < DEPENDENCY_DEPTH_MAX && !rDependency.objectPath.IsEmpty() )
+        {
+            HashMap< GameObjectPath, ObjectRecord >::ConstIterator objectIterator =
+                m_objects.Find( rDependency.objectPath );
+            if( objectIterator != m_objects.End() && DependsOn( objectIterator->Second(), filePath, depth + 1 ) )
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/// Combine a value into a hash.
+///
+/// Values are hashed one byte at a time from least to most significant so that keys are the same on every platform.
+///
+/// @param[in] hash   Current hash value.
+/// @param[in] value  Value to combine.
+///
+/// @return  Updated hash value.
+uint64_t DependencyDatabase::HashValue( uint64_t hash, uint64_t value )
+{
+    for( size_t byteIndex = 0; byteIndex < sizeof( value ); ++byteIndex )
+    {
+        hash ^= static_cast< uint8_t >( value >> ( byteIndex * 8 ) );
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/// Append a string to a string pool.
+///
+/// @param[in] rStringPool  String pool.
+/// @param[in] pString      String to append.
+///
+/// @return  Offset of the string in the string pool.
+uint32_t DependencyDatabase::AddPoolString( DynamicArray< tchar_t >& rStringPool, const tchar_t* pString )
+{
+    HELIUM_ASSERT( pString );
+
+    size_t stringPoolSize = rStringPool.GetSize();
+    size_t stringLength = StringLength( pString );
+
+    rStringPool.Resize( stringPoolSize + stringLength + 1 );
+    MemoryCopy( rStringPool.GetData() + stringPoolSize, pString, sizeof( tchar_t ) * ( stringLength + 1 ) );
+
+    return static_cast< uint32_t >( stringPoolSize );
+}
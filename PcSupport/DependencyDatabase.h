@@ -0,0 +1,248 @@
+//----------------------------------------------------------------------------------------------------------------------
+// DependencyDatabase.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_PC_SUPPORT_DEPENDENCY_DATABASE_H
+#define HELIUM_PC_SUPPORT_DEPENDENCY_DATABASE_H
+
+#include "PcSupport/PcSupport.h"
+
+#include "Platform/Locks.h"
+#include "Foundation/HashMap.h"
+#include "Engine/GameObjectPath.h"
+
+/// Dependency database file name string.
+#define HELIUM_DEPENDENCY_DATABASE_FILENAME TXT( "Dependencies.hdb" )
+
+namespace Helium
+{
+    /// Persistent database of the inputs used to cook each preprocessed object.
+    ///
+    /// For each cooked object, the database records the content hash of its source file, the hash of its serialized
+    /// property data, the version of the resource handler used to cook it, and the content hash of every file and
+    /// object on which the cooked data depends (i.e. shader include files, or the shader and textures used by a
+    /// material).  From these, a cook key is computed that only changes when the content of one of the inputs
+    /// changes, regardless of file timestamps.  The cook key of an object dependency is computed recursively, so
+    /// changes to a shared file propagate to every object that depends on it, directly or indirectly.
+    ///
+    /// Content hashes of files are cached along with the size and modification timestamp at which each was computed,
+    /// so files are only re-read when they appear to have changed.
+    ///
+    /// All functions are thread-safe.
+    class HELIUM_PC_SUPPORT_API DependencyDatabase : NonCopyable
+    {
+    public:
+        /// Dependency database file format version.
+        static const uint32_t VERSION = 1;
+        /// Initial value for hashes computed using ComputeHash() (64-bit FNV-1a offset basis).
+        static const uint64_t HASH_SEED = 14695981039346656037ULL;
+
+        /// Maximum object dependency depth to follow when computing cook keys.
+        static const size_t DEPENDENCY_DEPTH_MAX = 16;
+
+        /// @name Construction/Destruction
+        //@{
+        DependencyDatabase();
+        ~DependencyDatabase();
+        //@}
+
+        /// @name Initialization
+        //@{
+        bool Initialize( const tchar_t* pFileName );
+        void Shutdown();
+
+        bool Save();
+        inline const String& GetFileName() const;
+        //@}
+
+        /// @name Content Hashing
+        //@{
+        uint64_t GetFileHash( const tchar_t* pFilePath );
+        //@}
+
+        /// @name Cook Records
+        //@{
+        uint64_t ComputeObjectKey(
+            GameObjectPath objectPath, const tchar_t* pSourceFilePath, uint64_t objectDataHash, uint32_t handlerVersion );
+        bool GetObjectKey( GameObjectPath objectPath, uint64_t& rKey ) const;
+
+        void BeginObjectRecord(
+            GameObjectPath objectPath, const tchar_t* pSourceFilePath, uint64_t objectDataHash, uint32_t handlerVersion );
+        void AddFileDependency( GameObjectPath objectPath, const tchar_t* pFilePath );
+        void AddObjectDependency( GameObjectPath objectPath, GameObjectPath dependencyPath );
+        uint64_t EndObjectRecord( GameObjectPath objectPath, bool bCommit );
+
+        void GetFileDependents( const tchar_t* pFilePath, DynamicArray< GameObjectPath >& rDependents ) const;
+        //@}
+
+        /// @name Static Utility Functions
+        //@{
+        static uint64_t ComputeHash( const void* pData, size_t size, uint64_t hash = HASH_SEED );
+        //@}
+
+    private:
+        /// Dependency types.
+        enum EDependencyType
+        {
+            DEPENDENCY_TYPE_FIRST   =  0,
+            DEPENDENCY_TYPE_INVALID = -1,
+
+            /// File dependency.
+            DEPENDENCY_TYPE_FILE,
+            /// Cooked object dependency.
+            DEPENDENCY_TYPE_OBJECT,
+
+            DEPENDENCY_TYPE_MAX,
+            DEPENDENCY_TYPE_LAST = DEPENDENCY_TYPE_MAX - 1
+        };
+
+        /// Cached file content hash.
+        struct FileRecord
+        {
+            /// Content hash.
+            uint64_t hash;
+            /// File size at the time the hash was computed.
+            int64_t size;
+            /// File modification timestamp at the time the hash was computed.
+            int64_t timestamp;
+        };
+
+        /// Cook dependency.
+        struct Dependency
+        {
+            /// File path (file dependencies only).
+            Name filePath;
+            /// Object path (object dependencies only).
+            GameObjectPath objectPath;
+            /// Content hash (files) or cook key (objects) at the time the dependent object was cooked.
+            uint64_t hash;
+            /// Dependency type (EDependencyType value).
+            uint32_t type;
+        };
+
+        /// Cook record for a single object.
+        struct ObjectRecord
+        {
+            /// Source file path (null name if the object has no source file).
+            Name sourceFilePath;
+            /// Content hash of the source file when the object was cooked.
+            uint64_t sourceHash;
+            /// Hash of the serialized object property data when the object was cooked.
+            uint64_t objectDataHash;
+            /// Cook key computed when the object was cooked.
+            uint64_t key;
+            /// Version of the resource handler used to cook the object.
+            uint32_t handlerVersion;
+            /// Dependencies recorded while the object was cooked.
+            DynamicArray< Dependency > dependencies;
+        };
+
+        /// Database file header.
+        struct FileHeader
+        {
+            /// Magic number identifying the file.
+            uint32_t magic;
+            /// File format version.
+            uint32_t version;
+            /// Number of file records.
+            uint32_t fileCount;
+            /// Number of object records.
+            uint32_t objectCount;
+            /// Total number of dependency entries.
+            uint32_t dependencyCount;
+            /// Number of characters in the string pool.
+            uint32_t stringPoolSize;
+            /// Size of each string pool character, in bytes.
+            uint32_t characterSize;
+            /// Padding for aligning the entries that follow (always zero).
+            uint32_t reserved;
+        };
+
+        /// File record entry in the database file.
+        struct FileEntry
+        {
+            /// Content hash.
+            uint64_t hash;
+            /// File size.
+            int64_t size;
+            /// File modification timestamp.
+            int64_t timestamp;
+            /// String pool offset of the file path.
+            uint32_t pathOffset;
+            /// Padding (always zero).
+            uint32_t reserved;
+        };
+
+        /// Object record entry in the database file.
+        struct ObjectEntry
+        {
+            /// Content hash of the source file.
+            uint64_t sourceHash;
+            /// Hash of the serialized object property data.
+            uint64_t objectDataHash;
+            /// Cook key.
+            uint64_t key;
+            /// String pool offset of the object path.
+            uint32_t pathOffset;
+            /// String pool offset of the source file path.
+            uint32_t sourcePathOffset;
+            /// Resource handler version.
+            uint32_t handlerVersion;
+            /// Number of dependency entries for this object (stored consecutively after those of the previous object).
+            uint32_t dependencyCount;
+        };
+
+        /// Dependency entry in the database file.
+        struct DependencyEntry
+        {
+            /// Content hash or cook key.
+            uint64_t hash;
+            /// String pool offset of the file or object path.
+            uint32_t pathOffset;
+            /// Dependency type (EDependencyType value).
+            uint32_t type;
+        };
+
+        /// Database file name.
+        String m_fileName;
+
+        /// Cached file content hashes.
+        HashMap< Name, FileRecord > m_files;
+        /// Committed object cook records.
+        HashMap< GameObjectPath, ObjectRecord > m_objects;
+        /// Object cook records being built.
+        HashMap< GameObjectPath, ObjectRecord > m_pendingObjects;
+
+        /// True if the database has been modified since it was last loaded or saved.
+        bool m_bDirty;
+
+        /// Mutex for synchronizing access to the database.
+        mutable Mutex m_lock;
+
+        /// @name Private Utility Functions
+        //@{
+        bool Load();
+
+        uint64_t GetFileHashUnlocked( Name filePath );
+        uint64_t ComputeKey(
+            Name sourceFilePath, uint64_t objectDataHash, uint32_t handlerVersion,
+            const DynamicArray< Dependency >* pDependencies, size_t depth );
+        uint64_t ComputeDependencyHash( const Dependency& rDependency, size_t depth );
+        bool DependsOn( const ObjectRecord& rRecord, Name filePath, size_t depth ) const;
+        //@}
+
+        /// @name Static Private Utility Functions
+        //@{
+        static uint64_t HashValue( uint64_t hash, uint64_t value );
+        static uint32_t AddPoolString( DynamicArray< tchar_t >& rStringPool, const tchar_t* pString );
+        //@}
+    };
+}
+
+#include "PcSupport/DependencyDatabase.inl"
+
+#endif  // HELIUM_PC_SUPPORT_DEPENDENCY_DATABASE_H
@@ -0,0 +1,17 @@
+//----------------------------------------------------------------------------------------------------------------------
+// DependencyDatabase.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get the name of the file in which this database is stored.
+    ///
+    /// @return  Database file name (empty if the database has not been initialized).
+    const String& DependencyDatabase::GetFileName() const
+    {
+        return m_fileName;
+    }
+}
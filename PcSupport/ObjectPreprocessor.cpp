@@ -1,19 +1,21 @@
 #include "PcSupportPch.h"
 #include "ObjectPreprocessor.h"
 
-#include "Platform/File.h"
 #include "Foundation/FilePath.h"
 #include "Foundation/FileStream.h"
 #include "Foundation/MemoryStream.h"
 #include "Foundation/Numeric.h"
+#include "Platform/Timer.h"
 #include "Engine/FileLocations.h"
 #include "Engine/BinaryDeserializer.h"
 #include "Engine/BinarySerializer.h"
 #include "Engine/CacheManager.h"
 #include "Engine/GameObjectLoader.h"
+#include "Engine/JobContext.h"
 #include "Engine/Resource.h"
 #include "PcSupport/PlatformPreprocessor.h"
 #include "PcSupport/ResourceHandler.h"
+#include "EngineJobs/EngineJobsInterface.h"
 
 using namespace Helium;
 
@@ -21,13 +23,26 @@ ObjectPreprocessor* ObjectPreprocessor::sm_pInstance = NULL;
 
 /// Constructor.
 ObjectPreprocessor::ObjectPreprocessor()
+: m_bBatching( false )
 {
 	MemoryZero( m_pPlatformPreprocessors, sizeof( m_pPlatformPreprocessors ) );
+
+#if HELIUM_TOOLS
+	// The dependency database is shared by all platforms, so store it alongside the PC cache data.
+	CacheManager& rCacheManager = CacheManager::GetStaticInstance();
+	String dependencyDatabaseFileName = rCacheManager.GetPlatformDataDirectory( Cache::PLATFORM_PC );
+	dependencyDatabaseFileName += HELIUM_DEPENDENCY_DATABASE_FILENAME;
+	HELIUM_VERIFY( m_dependencyDatabase.Initialize( *dependencyDatabaseFileName ) );
+#endif
 }
 
 /// Destructor.
 ObjectPreprocessor::~ObjectPreprocessor()
 {
+#if HELIUM_TOOLS
+	m_dependencyDatabase.Shutdown();
+#endif
+
 	for( size_t platformIndex = 0; platformIndex < HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ); ++platformIndex )
 	{
 		delete m_pPlatformPreprocessors[ platformIndex ];
@@ -52,8 +67,10 @@ void ObjectPreprocessor::SetPlatformPreprocessor( Cache::EPlatform platform, Pla
 
 /// Cache an object for all registered platforms.
 ///
+/// Objects are cached using a cook key in place of a timestamp, so the cache entries for an object are only replaced
+/// when the content of the object or of any input used to preprocess its resource data changes.
+///
 /// @param[in] pObject                                 GameObject to cache.
-/// @param[in] timestamp                               GameObject timestamp.
 /// @param[in] bEvictPlatformPreprocessedResourceData  If the object being cached is a Resource-based object,
 ///                                                    specifying true will free the raw preprocessed resource data
 ///                                                    for the current platform after caching, while false will keep
@@ -63,15 +80,28 @@ void ObjectPreprocessor::SetPlatformPreprocessor( Cache::EPlatform platform, Pla
 ///                                                    to keep this data intact.
 ///
 /// @return  True if object caching was successful, false if not.
-bool ObjectPreprocessor::CacheObject(
-	GameObject* pObject,
-	int64_t timestamp,
-	bool bEvictPlatformPreprocessedResourceData )
+bool ObjectPreprocessor::CacheObject( GameObject* pObject, bool bEvictPlatformPreprocessedResourceData )
 {
 #if HELIUM_TOOLS
 
 	HELIUM_ASSERT( pObject );
 
+	// Resources queued for batch preprocessing are cached once the batch has been processed.
+	if( m_bBatching )
+	{
+		MutexScopeLock scopeLock( m_batchLock );
+
+		HashMap< GameObjectPath, size_t >::ConstIterator entryIterator =
+			m_batchEntryIndices.Find( pObject->GetPath() );
+		if( entryIterator != m_batchEntryIndices.End() )
+		{
+			BatchEntry& rEntry = m_batchEntries[ entryIterator->Second() ];
+			rEntry.bEvictPlatformPreprocessedResourceData = bEvictPlatformPreprocessedResourceData;
+
+			return true;
+		}
+	}
+
 	bool bCacheFailure = false;
 
 	DynamicArray< uint8_t > objectStreamBuffer;
@@ -85,6 +115,16 @@ bool ObjectPreprocessor::CacheObject(
 	// object for its specific type.
 	Resource* pResource = ( !pObject->IsDefaultTemplate() ? Reflect::SafeCast< Resource >( pObject ) : NULL );
 
+	// Resources are keyed on the inputs recorded when their resource data was last preprocessed, while all other
+	// objects are keyed on their property data alone.
+	uint64_t objectKey;
+	if( !pResource || !m_dependencyDatabase.GetObjectKey( objectPath, objectKey ) )
+	{
+		objectKey = ComputeObjectDataHash( pObject );
+	}
+
+	int64_t cookKey = static_cast< int64_t >( objectKey );
+
 	CacheManager& rCacheManager = CacheManager::GetStaticInstance();
 
 	GameObjectLoader* pObjectLoader = GameObjectLoader::GetStaticInstance();
@@ -109,7 +149,7 @@ bool ObjectPreprocessor::CacheObject(
 
 		// Don't recache the object if an up-to-date cache entry already exists for it.
 		const Cache::Entry* pEntry = pCache->FindEntry( objectPath, 0 );
-		if( pEntry && pEntry->timestamp == timestamp )
+		if( pEntry && pEntry->timestamp == cookKey )
 		{
 			continue;
 		}
@@ -130,7 +170,7 @@ bool ObjectPreprocessor::CacheObject(
 			( bSwapBytes ? static_cast< Stream& >( byteSwappingStream ) : static_cast< Stream& >( directStream ) );
 		
 		DynamicArray<uint8_t> data_buffer;
-		Cache::WriteCacheObjectToBuffer(*pObject, data_buffer);
+		Cache::WriteCacheObjectToBuffer(*pObject, data_buffer, pCache->GetPayloadFormat());
 
 		if (!data_buffer.IsEmpty())
 		{
@@ -186,7 +226,7 @@ bool ObjectPreprocessor::CacheObject(
 			objectPath,
 			0,
 			objectStreamBuffer.GetData(),
-			timestamp,
+			cookKey,
 			static_cast< uint32_t >( objectDataSize ) );
 		if( !bCacheResult )
 		{
@@ -219,29 +259,33 @@ bool ObjectPreprocessor::CacheObject(
 					HELIUM_ASSERT( pResourceCache );
 					pResourceCache->EnforceTocLoad();
 
+					// Write all sub-data for the resource in a single batch.
+					DynamicArray< Cache::EntryWrite > subDataWrites;
+					subDataWrites.Resize( subDataBufferCount );
+
 					for( size_t subDataBufferIndex = 0;
 						subDataBufferIndex < subDataBufferCount;
 						++subDataBufferIndex )
 					{
 						const DynamicArray< uint8_t >& rSubData = rSubDataBuffers[ subDataBufferIndex ];
 
-						bCacheResult = pResourceCache->CacheEntry(
-							objectPath,
-							static_cast< uint32_t >( subDataBufferIndex ),
-							rSubData.GetData(),
-							timestamp,
-							static_cast< uint32_t >( rSubData.GetSize() ) );
-						if( !bCacheResult )
-						{
-							HELIUM_TRACE(
-								TraceLevels::Error,
-								( TXT( "ObjectPreprocessor: Failed to cache resource sub-data %" ) TPRIuSZ
-								TXT( " for resource \"%s\".\n" ) ),
-								subDataBufferIndex,
-								*objectPath.ToString() );
-
-							bCacheFailure = true;
-						}
+						Cache::EntryWrite& rWrite = subDataWrites[ subDataBufferIndex ];
+						rWrite.path = objectPath;
+						rWrite.subDataIndex = static_cast< uint32_t >( subDataBufferIndex );
+						rWrite.pData = rSubData.GetData();
+						rWrite.timestamp = cookKey;
+						rWrite.size = static_cast< uint32_t >( rSubData.GetSize() );
+					}
+
+					bCacheResult = pResourceCache->CacheEntries( subDataWrites.GetData(), subDataBufferCount );
+					if( !bCacheResult )
+					{
+						HELIUM_TRACE(
+							TraceLevels::Error,
+							TXT( "ObjectPreprocessor: Failed to cache resource sub-data for resource \"%s\".\n" ),
+							*objectPath.ToString() );
+
+						bCacheFailure = true;
 					}
 				}
 
@@ -268,7 +312,6 @@ bool ObjectPreprocessor::CacheObject(
 #else  // HELIUM_TOOLS
 
 	HELIUM_UNREF( pObject );
-	HELIUM_UNREF( timestamp );
 	HELIUM_UNREF( bEvictPlatformPreprocessedResourceData );
 
 	return false;
@@ -278,11 +321,17 @@ bool ObjectPreprocessor::CacheObject(
 
 /// Load data for the specified resource into memory, preprocessing it from source data if it is out-of-date.
 ///
-/// @param[in] pResource        Resource to load.
-/// @param[in] objectTimestamp  Timestamp of the object data stored on disk.  This will be combined with the source
-///                             asset timestamp to get the timestamp value with which to compare against the cached
-///                             data.
-void ObjectPreprocessor::LoadResourceData( Resource* pResource, int64_t objectTimestamp )
+/// Cached resource data is considered up-to-date if it was cached with the same cook key as the one computed from the
+/// current content of the resource, its source file, and all other files and objects on which its preprocessed data
+/// depends.
+///
+/// @param[in] pResource  Resource to load.
+///
+/// @return  True if resource data for all supported platforms is loaded upon returning, false if loading failed or if
+///          preprocessing was deferred to the end of the current batch (see BeginBatch()).
+///
+/// @see DependencyDatabase::ComputeObjectKey()
+bool ObjectPreprocessor::LoadResourceData( Resource* pResource )
 {
 #if HELIUM_TOOLS
 
@@ -290,41 +339,26 @@ void ObjectPreprocessor::LoadResourceData( Resource* pResource, int64_t objectTi
 
 	GameObjectPath resourcePath = pResource->GetPath();
 
-	// Locate the source asset file of the source template resource and combine its timestamp with the object timestamp.
-	Resource* pTemplateResource = pResource;
-	GameObject* pTestTemplate = Reflect::AssertCast< GameObject >( pResource->GetTemplate() );
-	while( pTestTemplate && !pTestTemplate->IsDefaultTemplate() )
-	{
-		pTemplateResource = Reflect::AssertCast< Resource >( pTestTemplate );
-		pTestTemplate = Reflect::AssertCast< GameObject >( pTemplateResource->GetTemplate() );
-	}
-
-	GameObjectPath parentPath = pTemplateResource->GetPath();
-	GameObjectPath baseResourcePath;
-	do
-	{
-		baseResourcePath = parentPath;
-		parentPath = parentPath.GetParent();
-	} while( !parentPath.IsEmpty() && !parentPath.IsPackage() );
-
 	FilePath sourceFilePath;
-	if ( !FileLocations::GetDataDirectory( sourceFilePath ) )
+	if( !GetSourceFilePath( pResource, sourceFilePath ) )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
 			TXT( "ObjectPreprocessor::LoadResourceData(): Could not retrieve data directory.\n" ) );
 
-		return;
+		return false;
 	}
 
-	sourceFilePath += baseResourcePath.ToFilePathString().GetData();
-
-	Helium::Status stat;
-	stat.Read( sourceFilePath );
+	// Compute the cook key from the current state of all inputs to the resource data.
+	ResourceHandler* pResourceHandler = ResourceHandler::FindResourceHandlerForType( pResource->GetGameObjectType() );
+	uint32_t handlerVersion = ( pResourceHandler ? pResourceHandler->GetVersion() : 0 );
 
-	int64_t sourceFileTimestamp = stat.m_ModifiedTime;
-
-	int64_t timestamp = Max( objectTimestamp, sourceFileTimestamp );
+	uint64_t objectDataHash = ComputeObjectDataHash( pResource );
+	int64_t cookKey = static_cast< int64_t >( m_dependencyDatabase.ComputeObjectKey(
+		resourcePath,
+		sourceFilePath.c_str(),
+		objectDataHash,
+		handlerVersion ) );
 
 	// Check if data is loaded for each supported platform, attempting to load the data from the cache if it exists
 	// and is up-to-date.
@@ -358,7 +392,7 @@ void ObjectPreprocessor::LoadResourceData( Resource* pResource, int64_t objectTi
 		pCache->EnforceTocLoad();
 
 		const Cache::Entry* pCacheEntry = pCache->FindEntry( resourcePath, 0 );
-		if( !pCacheEntry || pCacheEntry->timestamp != timestamp )
+		if( !pCacheEntry || pCacheEntry->timestamp != cookKey )
 		{
 			HELIUM_TRACE(
 				TraceLevels::Info,
@@ -385,26 +419,78 @@ void ObjectPreprocessor::LoadResourceData( Resource* pResource, int64_t objectTi
 	if( platformIndex >= HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ) )
 	{
 		// All supported platforms loaded successfully, so nothing else needs to be done.
-		return;
+		return true;
+	}
+
+	// Defer preprocessing to the end of the current batch if one is in progress.
+	String sourceFilePathString( sourceFilePath.c_str() );
+	if( m_bBatching && pResourceHandler &&
+		QueueBatchResource( pResource, pResourceHandler, sourceFilePathString, objectDataHash ) )
+	{
+		return false;
 	}
 
 	// Preprocess all resources for each supported platform.
-	if( !PreprocessResource( pResource, String( sourceFilePath.c_str() ) ) )
+	if( !PreprocessResource( pResource, sourceFilePathString, objectDataHash ) )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
 			TXT( "ObjectPreprocessor::LoadResourceData(): Preprocessing of resource \"%s\" failed.\n" ),
 			*resourcePath.ToString() );
+
+		return false;
 	}
 
+	return true;
+
 #else  // HELIUM_TOOLS
 
 	HELIUM_UNREF( pResource );
-	HELIUM_UNREF( objectTimestamp );
+
+	return false;
 
 #endif  // HELIUM_TOOLS
 }
 
+/// Record a file dependency for the resource currently being preprocessed.
+///
+/// This should only be called by resource handlers from within ResourceHandler::CacheResource() for each file other
+/// than the resource source file that is read while preprocessing the resource.  Changes to the content of the file
+/// will cause the resource to be preprocessed again the next time it is loaded.
+///
+/// @param[in] pResource  Resource being preprocessed.
+/// @param[in] pFilePath  Path name of the file on which the resource depends.
+///
+/// @see AddObjectDependency()
+void ObjectPreprocessor::AddFileDependency( Resource* pResource, const tchar_t* pFilePath )
+{
+	HELIUM_ASSERT( pResource );
+	HELIUM_ASSERT( pFilePath );
+
+	m_dependencyDatabase.AddFileDependency( pResource->GetPath(), pFilePath );
+}
+
+/// Record an object dependency for the resource currently being preprocessed.
+///
+/// This should only be called by resource handlers from within ResourceHandler::CacheResource() for each object
+/// whose content affects the preprocessed data of the resource.  Changes to the object or to any of its own
+/// dependencies will cause the resource to be preprocessed again the next time it is loaded.
+///
+/// @param[in] pResource    Resource being preprocessed.
+/// @param[in] pDependency  Object on which the resource depends.  Null references and default template objects are
+///                         ignored.
+///
+/// @see AddFileDependency()
+void ObjectPreprocessor::AddObjectDependency( Resource* pResource, GameObject* pDependency )
+{
+	HELIUM_ASSERT( pResource );
+
+	if( pDependency && !pDependency->IsDefaultTemplate() )
+	{
+		m_dependencyDatabase.AddObjectDependency( pResource->GetPath(), pDependency->GetPath() );
+	}
+}
+
 /// Load the persistent resource data for the specified resource from the object cache.
 ///
 /// @param[in]  resourcePath           FilePath of the resource object.
@@ -615,6 +701,293 @@ uint32_t ObjectPreprocessor::LoadPersistentResourceData(
 	return subDataCount;
 }
 
+/// Begin deferring resource preprocessing to the end of a batch.
+///
+/// While a batch is in progress, LoadResourceData() queues each resource whose cached data is out-of-date instead of
+/// preprocessing it immediately, leaving the resource without any loaded resource data (and returning false so that
+/// callers can skip deserializing and precaching it), and CacheObject() skips caching of queued resources.  All queued
+/// resources are then preprocessed in parallel and cached by EndBatch().
+///
+/// Batching is intended for offline cooking, where resources are only loaded in order to be cached.  Resources
+/// queued in a batch should not be used for rendering until the batch has ended.
+///
+/// @see EndBatch(), IsBatching()
+void ObjectPreprocessor::BeginBatch()
+{
+#if HELIUM_TOOLS
+	MutexScopeLock scopeLock( m_batchLock );
+
+	HELIUM_ASSERT( !m_bBatching );
+	HELIUM_ASSERT( m_batchEntries.IsEmpty() );
+	m_bBatching = true;
+#endif
+}
+
+/// Preprocess and cache all resources queued since the last call to BeginBatch().
+///
+/// Resources are preprocessed in dependency order: a resource is not preprocessed until each of the resources in the
+/// batch that its resource handler reports as a dependency (see ResourceHandler::GetResourceDependencies()) has been
+/// preprocessed.  Resources that are ready are preprocessed in parallel on the job system if their resource handler
+/// supports concurrent caching, and sequentially within a single job otherwise.  Writes to the object and resource
+/// caches are not thread-safe, so all preprocessed resources are cached on the calling thread once preprocessing is
+/// complete.
+///
+/// This must be called from the main thread.
+///
+/// @param[out] pStatistics  If not null, this will be filled with preprocessing statistics for each resource handler
+///                          used in the batch.
+///
+/// @return  True if all queued resources were preprocessed and cached successfully, false if any failed.
+///
+/// @see BeginBatch(), IsBatching()
+bool ObjectPreprocessor::EndBatch( DynamicArray< BatchStatistics >* pStatistics )
+{
+	if( pStatistics )
+	{
+		pStatistics->Resize( 0 );
+	}
+
+#if HELIUM_TOOLS
+
+	{
+		MutexScopeLock scopeLock( m_batchLock );
+
+		HELIUM_ASSERT( m_bBatching );
+		m_bBatching = false;
+	}
+
+	size_t entryCount = m_batchEntries.GetSize();
+	if( entryCount == 0 )
+	{
+		return true;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "ObjectPreprocessor::EndBatch(): Preprocessing %" ) TPRIuSZ TXT( " resources.\n" ),
+		entryCount );
+
+	// Build the dependency graph of the queued resources.
+	DynamicArray< GameObject* > dependencies;
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		BatchEntry& rEntry = m_batchEntries[ entryIndex ];
+		HELIUM_ASSERT( rEntry.pHandler );
+
+		dependencies.Resize( 0 );
+		rEntry.pHandler->GetResourceDependencies( rEntry.spResource, dependencies );
+
+		size_t dependencyCount = dependencies.GetSize();
+		for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+		{
+			GameObject* pDependency = dependencies[ dependencyIndex ];
+			if( !pDependency )
+			{
+				continue;
+			}
+
+			HashMap< GameObjectPath, size_t >::ConstIterator entryIterator =
+				m_batchEntryIndices.Find( pDependency->GetPath() );
+			if( entryIterator != m_batchEntryIndices.End() && entryIterator->Second() != entryIndex )
+			{
+				m_batchEntries[ entryIterator->Second() ].dependents.Push( entryIndex );
+				++rEntry.pendingDependencyCount;
+			}
+		}
+	}
+
+	// Preprocess the resources in waves, with each wave containing all resources whose dependencies have been
+	// preprocessed.
+	DynamicArray< size_t > readyEntries;
+	DynamicArray< size_t > nextReadyEntries;
+	DynamicArray< size_t > concurrentEntries;
+	DynamicArray< size_t > serialEntries;
+
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		if( m_batchEntries[ entryIndex ].pendingDependencyCount == 0 )
+		{
+			readyEntries.Push( entryIndex );
+		}
+	}
+
+	size_t processedCount = 0;
+	while( !readyEntries.IsEmpty() )
+	{
+		concurrentEntries.Resize( 0 );
+		serialEntries.Resize( 0 );
+
+		size_t readyCount = readyEntries.GetSize();
+		for( size_t readyIndex = 0; readyIndex < readyCount; ++readyIndex )
+		{
+			size_t entryIndex = readyEntries[ readyIndex ];
+			if( m_batchEntries[ entryIndex ].pHandler->SupportsConcurrentCaching() )
+			{
+				concurrentEntries.Push( entryIndex );
+			}
+			else
+			{
+				serialEntries.Push( entryIndex );
+			}
+		}
+
+		RunBatchWave( concurrentEntries, serialEntries );
+
+		// Load the persistent data of each preprocessed resource so that it is available to any dependents in the
+		// next wave, and release those dependents.
+		nextReadyEntries.Resize( 0 );
+
+		for( size_t readyIndex = 0; readyIndex < readyCount; ++readyIndex )
+		{
+			BatchEntry& rEntry = m_batchEntries[ readyEntries[ readyIndex ] ];
+			if( rEntry.bSucceeded )
+			{
+				LoadPreprocessedPersistentData( rEntry.spResource );
+			}
+
+			size_t dependentCount = rEntry.dependents.GetSize();
+			for( size_t dependentIndex = 0; dependentIndex < dependentCount; ++dependentIndex )
+			{
+				size_t dependentEntryIndex = rEntry.dependents[ dependentIndex ];
+				BatchEntry& rDependentEntry = m_batchEntries[ dependentEntryIndex ];
+				HELIUM_ASSERT( rDependentEntry.pendingDependencyCount != 0 );
+				if( --rDependentEntry.pendingDependencyCount == 0 )
+				{
+					nextReadyEntries.Push( dependentEntryIndex );
+				}
+			}
+		}
+
+		processedCount += readyCount;
+		readyEntries = nextReadyEntries;
+	}
+
+	// Any resources left over are part of a dependency cycle, so just preprocess them in the order in which they were
+	// queued.
+	if( processedCount < entryCount )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			( TXT( "ObjectPreprocessor::EndBatch(): %" ) TPRIuSZ TXT( " resources have cyclic dependencies and will " )
+			TXT( "be preprocessed sequentially.\n" ) ),
+			entryCount - processedCount );
+
+		for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+		{
+			BatchEntry& rEntry = m_batchEntries[ entryIndex ];
+			if( rEntry.pendingDependencyCount != 0 )
+			{
+				RunBatchEntry( entryIndex );
+				if( rEntry.bSucceeded )
+				{
+					LoadPreprocessedPersistentData( rEntry.spResource );
+				}
+			}
+		}
+	}
+
+	// Cache all successfully preprocessed resources.  Resources that failed to preprocess are left uncached so that
+	// they are preprocessed again the next time they are loaded.
+	GameObjectLoader* pObjectLoader = GameObjectLoader::GetStaticInstance();
+	HELIUM_ASSERT( pObjectLoader );
+
+	bool bSuccess = true;
+
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		BatchEntry& rEntry = m_batchEntries[ entryIndex ];
+		if( !rEntry.bSucceeded )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "ObjectPreprocessor::EndBatch(): Preprocessing of resource \"%s\" failed.\n" ),
+				*rEntry.spResource->GetPath().ToString() );
+
+			bSuccess = false;
+
+			continue;
+		}
+
+		if( !pObjectLoader->CacheObject( rEntry.spResource, rEntry.bEvictPlatformPreprocessedResourceData ) )
+		{
+			bSuccess = false;
+		}
+	}
+
+	// Gather statistics for each resource handler.
+	if( pStatistics )
+	{
+		DynamicArray< uint64_t > startTickCounts;
+		DynamicArray< uint64_t > endTickCounts;
+
+		for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+		{
+			const BatchEntry& rEntry = m_batchEntries[ entryIndex ];
+
+			size_t statisticsCount = pStatistics->GetSize();
+			size_t statisticsIndex;
+			for( statisticsIndex = 0; statisticsIndex < statisticsCount; ++statisticsIndex )
+			{
+				if( ( *pStatistics )[ statisticsIndex ].pHandler == rEntry.pHandler )
+				{
+					break;
+				}
+			}
+
+			if( statisticsIndex >= statisticsCount )
+			{
+				BatchStatistics* pHandlerStatistics = pStatistics->New();
+				HELIUM_ASSERT( pHandlerStatistics );
+				pHandlerStatistics->pHandler = rEntry.pHandler;
+				pHandlerStatistics->resourceCount = 0;
+				pHandlerStatistics->failureCount = 0;
+				pHandlerStatistics->busyTickCount = 0;
+				pHandlerStatistics->wallTickCount = 0;
+
+				startTickCounts.Push( rEntry.startTickCount );
+				endTickCounts.Push( rEntry.endTickCount );
+			}
+
+			BatchStatistics& rHandlerStatistics = ( *pStatistics )[ statisticsIndex ];
+			++rHandlerStatistics.resourceCount;
+			if( !rEntry.bSucceeded )
+			{
+				++rHandlerStatistics.failureCount;
+			}
+
+			rHandlerStatistics.busyTickCount += rEntry.endTickCount - rEntry.startTickCount;
+
+			if( startTickCounts[ statisticsIndex ] > rEntry.startTickCount )
+			{
+				startTickCounts[ statisticsIndex ] = rEntry.startTickCount;
+			}
+
+			if( endTickCounts[ statisticsIndex ] < rEntry.endTickCount )
+			{
+				endTickCounts[ statisticsIndex ] = rEntry.endTickCount;
+			}
+		}
+
+		size_t statisticsCount = pStatistics->GetSize();
+		for( size_t statisticsIndex = 0; statisticsIndex < statisticsCount; ++statisticsIndex )
+		{
+			( *pStatistics )[ statisticsIndex ].wallTickCount =
+				endTickCounts[ statisticsIndex ] - startTickCounts[ statisticsIndex ];
+		}
+	}
+
+	m_batchEntryIndices.Clear();
+	m_batchEntries.Clear();
+
+	return bSuccess;
+
+#else  // HELIUM_TOOLS
+
+	return false;
+
+#endif  // HELIUM_TOOLS
+}
+
 /// Create the singleton ObjectPreprocessor instance.
 ///
 /// @return  Pointer to the created instance.
@@ -803,9 +1176,13 @@ bool ObjectPreprocessor::LoadCachedResourceData( Resource* pResource, Cache::EPl
 ///
 /// @param[in] pResource        Resource to preprocess.
 /// @param[in] rSourceFilePath  FilePath name of the source resource data file.
+/// @param[in] objectDataHash   Hash of the serialized resource property data.
 ///
 /// @return  True if preprocessing was successful, false if not.
-bool ObjectPreprocessor::PreprocessResource( Resource* pResource, const String& rSourceFilePath )
+bool ObjectPreprocessor::PreprocessResource(
+	Resource* pResource,
+	const String& rSourceFilePath,
+	uint64_t objectDataHash )
 {
 	HELIUM_ASSERT( pResource );
 	HELIUM_ASSERT( !pResource->IsDefaultTemplate() );
@@ -815,16 +1192,6 @@ bool ObjectPreprocessor::PreprocessResource( Resource* pResource, const String&
 		TXT( "ObjectPreprocessor::PreprocessResource(): Preprocessing resource \"%s\".\n" ),
 		*pResource->GetPath().ToString() );
 
-	// Clear out all existing resource data.
-	for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
-	{
-		Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
-			static_cast< Cache::EPlatform >( platformIndex ) );
-		rPreprocessedData.persistentDataBuffer.Clear();
-		rPreprocessedData.subDataBuffers.Clear();
-		rPreprocessedData.bLoaded = false;
-	}
-
 	// Locate a resource handler for the resource type.
 	const GameObjectType* pResourceType = pResource->GetGameObjectType();
 	HELIUM_ASSERT( pResourceType );
@@ -841,8 +1208,7 @@ bool ObjectPreprocessor::PreprocessResource( Resource* pResource, const String&
 		return false;
 	}
 
-	// Preprocess and cache the resource for the each enabled platform.
-	if( !pResourceHandler->CacheResource( this, pResource, rSourceFilePath ) )
+	if( !CacheResourceData( pResourceHandler, pResource, rSourceFilePath, objectDataHash ) )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
@@ -852,6 +1218,64 @@ bool ObjectPreprocessor::PreprocessResource( Resource* pResource, const String&
 		return false;
 	}
 
+	LoadPreprocessedPersistentData( pResource );
+
+	return true;
+}
+
+/// Run the resource handler to preprocess a resource for all enabled platforms.
+///
+/// This may be called from any thread, provided the resource handler supports concurrent caching.
+///
+/// @param[in] pResourceHandler  Resource handler for the resource type.
+/// @param[in] pResource         Resource to preprocess.
+/// @param[in] rSourceFilePath   FilePath name of the source resource data file.
+/// @param[in] objectDataHash    Hash of the serialized resource property data.
+///
+/// @return  True if preprocessing was successful, false if not.
+///
+/// @see ResourceHandler::SupportsConcurrentCaching()
+bool ObjectPreprocessor::CacheResourceData(
+	ResourceHandler* pResourceHandler,
+	Resource* pResource,
+	const String& rSourceFilePath,
+	uint64_t objectDataHash )
+{
+	HELIUM_ASSERT( pResourceHandler );
+	HELIUM_ASSERT( pResource );
+
+	// Clear out all existing resource data.
+	for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
+	{
+		Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
+			static_cast< Cache::EPlatform >( platformIndex ) );
+		rPreprocessedData.persistentDataBuffer.Clear();
+		rPreprocessedData.subDataBuffers.Clear();
+		rPreprocessedData.bLoaded = false;
+	}
+
+	// Preprocess and cache the resource for the each enabled platform, recording each file and object read by the
+	// resource handler as a dependency of the resource.
+	GameObjectPath resourcePath = pResource->GetPath();
+	m_dependencyDatabase.BeginObjectRecord(
+		resourcePath,
+		*rSourceFilePath,
+		objectDataHash,
+		pResourceHandler->GetVersion() );
+
+	bool bCacheResult = pResourceHandler->CacheResource( this, pResource, rSourceFilePath );
+	m_dependencyDatabase.EndObjectRecord( resourcePath, bCacheResult );
+
+	return bCacheResult;
+}
+
+/// Deserialize the persistent resource data preprocessed for the current platform into a resource.
+///
+/// @param[in] pResource  Preprocessed resource.
+void ObjectPreprocessor::LoadPreprocessedPersistentData( Resource* pResource )
+{
+	HELIUM_ASSERT( pResource );
+
 	// Reserialize the current platform's persistent resource data.
 	CacheManager& rCacheManager = CacheManager::GetStaticInstance();
 	Cache::EPlatform platform = rCacheManager.GetCurrentPlatform();
@@ -872,7 +1296,222 @@ bool ObjectPreprocessor::PreprocessResource( Resource* pResource, const String&
 			}
 		}
 	}
+}
+
+/// Queue a resource for preprocessing at the end of the current batch.
+///
+/// @param[in] pResource         Resource to preprocess.
+/// @param[in] pResourceHandler  Resource handler for the resource type.
+/// @param[in] rSourceFilePath   FilePath name of the source resource data file.
+/// @param[in] objectDataHash    Hash of the serialized resource property data.
+///
+/// @return  True if the resource was queued (or was already queued), false if no batch is in progress.
+bool ObjectPreprocessor::QueueBatchResource(
+	Resource* pResource,
+	ResourceHandler* pResourceHandler,
+	const String& rSourceFilePath,
+	uint64_t objectDataHash )
+{
+	HELIUM_ASSERT( pResource );
+	HELIUM_ASSERT( pResourceHandler );
+
+	MutexScopeLock scopeLock( m_batchLock );
+
+	if( !m_bBatching )
+	{
+		return false;
+	}
+
+	GameObjectPath resourcePath = pResource->GetPath();
+
+	HashMap< GameObjectPath, size_t >::Iterator entryIterator;
+	if( !m_batchEntryIndices.Insert(
+		entryIterator,
+		KeyValue< GameObjectPath, size_t >( resourcePath, m_batchEntries.GetSize() ) ) )
+	{
+		return true;
+	}
+
+	BatchEntry* pEntry = m_batchEntries.New();
+	HELIUM_ASSERT( pEntry );
+	pEntry->spResource = pResource;
+	pEntry->pHandler = pResourceHandler;
+	pEntry->sourceFilePath = rSourceFilePath;
+	pEntry->objectDataHash = objectDataHash;
+	pEntry->pendingDependencyCount = 0;
+	pEntry->startTickCount = 0;
+	pEntry->endTickCount = 0;
+	pEntry->bEvictPlatformPreprocessedResourceData = true;
+	pEntry->bSucceeded = false;
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "ObjectPreprocessor: Queued resource \"%s\" for batch preprocessing.\n" ),
+		*resourcePath.ToString() );
 
 	return true;
 }
+
+/// Preprocess a single batched resource, recording the time spent doing so.
+///
+/// This may be called from any thread, provided the resource handler for the resource supports concurrent caching.
+///
+/// @param[in] entryIndex  Batch entry index.
+void ObjectPreprocessor::RunBatchEntry( size_t entryIndex )
+{
+	HELIUM_ASSERT( entryIndex < m_batchEntries.GetSize() );
+	BatchEntry& rEntry = m_batchEntries[ entryIndex ];
+
+	rEntry.startTickCount = Timer::GetTickCount();
+	rEntry.bSucceeded = CacheResourceData(
+		rEntry.pHandler,
+		rEntry.spResource,
+		rEntry.sourceFilePath,
+		rEntry.objectDataHash );
+	rEntry.endTickCount = Timer::GetTickCount();
+}
+
+/// Preprocess a set of batched resources whose dependencies have all been preprocessed.
+///
+/// @param[in] rConcurrentEntries  Indices of the batch entries that can be preprocessed in parallel.
+/// @param[in] rSerialEntries      Indices of the batch entries that must be preprocessed one at a time.
+void ObjectPreprocessor::RunBatchWave(
+	const DynamicArray< size_t >& rConcurrentEntries,
+	const DynamicArray< size_t >& rSerialEntries )
+{
+	size_t concurrentCount = rConcurrentEntries.GetSize();
+	size_t serialCount = rSerialEntries.GetSize();
+
+	size_t jobCount = concurrentCount;
+	if( jobCount > BATCH_JOB_COUNT_MAX )
+	{
+		jobCount = BATCH_JOB_COUNT_MAX;
+	}
+
+	if( jobCount + ( serialCount != 0 ? 1 : 0 ) < 2 )
+	{
+		// Not enough work to be worth running in parallel.
+		for( size_t entryIndex = 0; entryIndex < concurrentCount; ++entryIndex )
+		{
+			RunBatchEntry( rConcurrentEntries[ entryIndex ] );
+		}
+
+		for( size_t entryIndex = 0; entryIndex < serialCount; ++entryIndex )
+		{
+			RunBatchEntry( rSerialEntries[ entryIndex ] );
+		}
+
+		return;
+	}
+
+	// Resource preprocessing times vary wildly, so rather than splitting the entries evenly between jobs, let each
+	// job claim the next available entry as it finishes the previous one.
+	HELIUM_ASSERT( concurrentCount <= static_cast< size_t >( INT32_MAX ) );
+	volatile int32_t nextIndex = 0;
+
+	BatchWorkList concurrentWorkList = { this, rConcurrentEntries.GetData() };
+	BatchWorkList serialWorkList = { this, rSerialEntries.GetData() };
+
+	{
+		JobContext::Spawner< BATCH_JOB_COUNT_MAX + 1 > rootSpawner;
+
+		for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+		{
+			JobContext* pContext = rootSpawner.Allocate();
+			HELIUM_ASSERT( pContext );
+			ParallelForJob* pJob = pContext->Create< ParallelForJob >();
+			HELIUM_ASSERT( pJob );
+			ParallelForJob::Parameters& rParameters = pJob->GetParameters();
+			rParameters.pFunction = RunBatchWorkItem;
+			rParameters.pUserData = &concurrentWorkList;
+			rParameters.count = concurrentCount;
+			rParameters.pNextIndex = &nextIndex;
+		}
+
+		// Resources whose handlers do not support concurrent caching are all preprocessed in order within a single
+		// job.
+		if( serialCount != 0 )
+		{
+			JobContext* pContext = rootSpawner.Allocate();
+			HELIUM_ASSERT( pContext );
+			ParallelForJob* pJob = pContext->Create< ParallelForJob >();
+			HELIUM_ASSERT( pJob );
+			ParallelForJob::Parameters& rParameters = pJob->GetParameters();
+			rParameters.pFunction = RunBatchWorkItem;
+			rParameters.pUserData = &serialWorkList;
+			rParameters.count = serialCount;
+		}
+	}
+}
+
+/// ParallelForJob work function for preprocessing a single entry of a batch wave.
+///
+/// @param[in] pWorkList  Batch entries being preprocessed (BatchWorkList instance).
+/// @param[in] index      Index of the entry within the work list.
+void ObjectPreprocessor::RunBatchWorkItem( void* pWorkList, size_t index )
+{
+	HELIUM_ASSERT( pWorkList );
+	const BatchWorkList* pBatchWorkList = static_cast< const BatchWorkList* >( pWorkList );
+	HELIUM_ASSERT( pBatchWorkList->pPreprocessor );
+	HELIUM_ASSERT( pBatchWorkList->pEntryIndices );
+
+	pBatchWorkList->pPreprocessor->RunBatchEntry( pBatchWorkList->pEntryIndices[ index ] );
+}
+
+/// Get the path name of the source asset file for a resource.
+///
+/// Resources based on a template resource share the source asset file of the base template resource.
+///
+/// @param[in]  pResource        Resource for which to locate the source file.
+/// @param[out] rSourceFilePath  Source file path name.
+///
+/// @return  True if the source file path was resolved, false if the data directory could not be retrieved.
+bool ObjectPreprocessor::GetSourceFilePath( Resource* pResource, FilePath& rSourceFilePath )
+{
+	HELIUM_ASSERT( pResource );
+
+	Resource* pTemplateResource = pResource;
+	GameObject* pTestTemplate = Reflect::AssertCast< GameObject >( pResource->GetTemplate() );
+	while( pTestTemplate && !pTestTemplate->IsDefaultTemplate() )
+	{
+		pTemplateResource = Reflect::AssertCast< Resource >( pTestTemplate );
+		pTestTemplate = Reflect::AssertCast< GameObject >( pTemplateResource->GetTemplate() );
+	}
+
+	GameObjectPath parentPath = pTemplateResource->GetPath();
+	GameObjectPath baseResourcePath;
+	do
+	{
+		baseResourcePath = parentPath;
+		parentPath = parentPath.GetParent();
+	} while( !parentPath.IsEmpty() && !parentPath.IsPackage() );
+
+	if( !FileLocations::GetDataDirectory( rSourceFilePath ) )
+	{
+		return false;
+	}
+
+	rSourceFilePath += baseResourcePath.ToFilePathString().GetData();
+
+	return true;
+}
+
+/// Compute a hash of the serialized property data of an object.
+///
+/// The same hash is used as the cook key for every platform cache, so the data is always serialized in the binary
+/// payload format rather than the format of any one cache; changing a cache's payload format alone does not
+/// invalidate its entries.
+///
+/// @param[in] pObject  Object to hash.
+///
+/// @return  Object data hash.
+uint64_t ObjectPreprocessor::ComputeObjectDataHash( GameObject* pObject )
+{
+	HELIUM_ASSERT( pObject );
+
+	DynamicArray< uint8_t > objectData;
+	Cache::WriteCacheObjectToBuffer( *pObject, objectData, Cache::PAYLOAD_FORMAT_BINARY );
+
+	return DependencyDatabase::ComputeHash( objectData.GetData(), objectData.GetSize() );
+}
 #endif  // HELIUM_TOOLS
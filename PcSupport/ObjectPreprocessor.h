@@ -11,18 +11,41 @@
 
 #include "PcSupport/PcSupport.h"
 
+#include "Platform/Locks.h"
 #include "Engine/Cache.h"
+#include "Engine/Resource.h"
+#include "PcSupport/DependencyDatabase.h"
 
 namespace Helium
 {
     class GameObject;
     class Resource;
+    class ResourceHandler;
     class PlatformPreprocessor;
+    class FilePath;
 
     /// GameObject caching and resource preprocessing interface.
     class HELIUM_PC_SUPPORT_API ObjectPreprocessor : NonCopyable
     {
     public:
+        /// Maximum number of jobs to run in parallel when preprocessing a batch of resources.
+        static const size_t BATCH_JOB_COUNT_MAX = 32;
+
+        /// Preprocessing statistics for a single resource handler, gathered while processing a batch.
+        struct BatchStatistics
+        {
+            /// Resource handler.
+            ResourceHandler* pHandler;
+            /// Number of resources preprocessed.
+            size_t resourceCount;
+            /// Number of resources that failed to preprocess.
+            size_t failureCount;
+            /// Total time spent preprocessing resources, summed across all threads, in ticks.
+            uint64_t busyTickCount;
+            /// Time from the start of the first resource preprocessed to the end of the last, in ticks.
+            uint64_t wallTickCount;
+        };
+
         /// @name Platform Preprocessor Registration
         //@{
         void SetPlatformPreprocessor( Cache::EPlatform platform, PlatformPreprocessor* pPreprocessor );
@@ -31,17 +54,32 @@ namespace Helium
 
         /// @name GameObject Caching
         //@{
-        bool CacheObject( GameObject* pObject, int64_t timestamp, bool bEvictPlatformPreprocessedResourceData = true );
+        bool CacheObject( GameObject* pObject, bool bEvictPlatformPreprocessedResourceData = true );
         //@}
 
         /// @name Resource Preprocessing
         //@{
-        void LoadResourceData( Resource* pResource, int64_t objectTimestamp );
+        bool LoadResourceData( Resource* pResource );
 
         uint32_t LoadPersistentResourceData(
             GameObjectPath resourcePath, Cache::EPlatform platform, DynamicArray< uint8_t >& rPersistentDataBuffer );
         //@}
 
+        /// @name Batch Preprocessing
+        //@{
+        void BeginBatch();
+        bool EndBatch( DynamicArray< BatchStatistics >* pStatistics = NULL );
+        inline bool IsBatching() const;
+        //@}
+
+        /// @name Dependency Tracking
+        //@{
+        inline DependencyDatabase& GetDependencyDatabase();
+
+        void AddFileDependency( Resource* pResource, const tchar_t* pFilePath );
+        void AddObjectDependency( Resource* pResource, GameObject* pDependency );
+        //@}
+
         /// @name Static Access
         //@{
         static ObjectPreprocessor* CreateStaticInstance();
@@ -51,8 +89,53 @@ namespace Helium
        //@}
 
     private:
+        /// Resource queued for batch preprocessing.
+        struct BatchEntry
+        {
+            /// Resource to preprocess.
+            StrongPtr< Resource > spResource;
+            /// Resource handler with which to preprocess the resource.
+            ResourceHandler* pHandler;
+            /// Path name of the resource source file.
+            String sourceFilePath;
+            /// Hash of the serialized resource property data.
+            uint64_t objectDataHash;
+            /// Indices of the batch entries that depend on this resource.
+            DynamicArray< size_t > dependents;
+            /// Number of resources in the batch on which this resource depends that have not yet been preprocessed.
+            size_t pendingDependencyCount;
+            /// Tick count at which preprocessing started.
+            uint64_t startTickCount;
+            /// Tick count at which preprocessing finished.
+            uint64_t endTickCount;
+            /// True to evict the raw preprocessed resource data for the current platform once cached.
+            bool bEvictPlatformPreprocessedResourceData;
+            /// True if preprocessing succeeded.
+            bool bSucceeded;
+        };
+
+        /// Set of batch entries preprocessed by the jobs of a single batch wave.
+        struct BatchWorkList
+        {
+            /// Object preprocessor running the batch.
+            ObjectPreprocessor* pPreprocessor;
+            /// Indices of the batch entries to preprocess.
+            const size_t* pEntryIndices;
+        };
+
         /// Platform-specific preprocessing support.
         PlatformPreprocessor* m_pPlatformPreprocessors[ Cache::PLATFORM_MAX ];
+        /// Cook dependency database.
+        DependencyDatabase m_dependencyDatabase;
+
+        /// True if resource preprocessing is being deferred to the end of a batch.
+        bool m_bBatching;
+        /// Resources queued for batch preprocessing.
+        DynamicArray< BatchEntry > m_batchEntries;
+        /// Batch entry indices, indexed by resource path.
+        HashMap< GameObjectPath, size_t > m_batchEntryIndices;
+        /// Mutex for synchronizing access to the batch queue.
+        Mutex m_batchLock;
 
         /// Singleton instance.
         static ObjectPreprocessor* sm_pInstance;
@@ -67,7 +150,28 @@ namespace Helium
         //@{
 #if HELIUM_TOOLS
         bool LoadCachedResourceData( Resource* pResource, Cache::EPlatform platform );
-        bool PreprocessResource( Resource* pResource, const String& rSourceFilePath );
+        bool PreprocessResource( Resource* pResource, const String& rSourceFilePath, uint64_t objectDataHash );
+        bool CacheResourceData(
+            ResourceHandler* pResourceHandler, Resource* pResource, const String& rSourceFilePath,
+            uint64_t objectDataHash );
+        void LoadPreprocessedPersistentData( Resource* pResource );
+
+        bool QueueBatchResource(
+            Resource* pResource, ResourceHandler* pResourceHandler, const String& rSourceFilePath,
+            uint64_t objectDataHash );
+        void RunBatchEntry( size_t entryIndex );
+        void RunBatchWave(
+            const DynamicArray< size_t >& rConcurrentEntries, const DynamicArray< size_t >& rSerialEntries );
+#endif
+        //@}
+
+        /// @name Static Private Utility Functions
+        //@{
+#if HELIUM_TOOLS
+        static bool GetSourceFilePath( Resource* pResource, FilePath& rSourceFilePath );
+        static uint64_t ComputeObjectDataHash( GameObject* pObject );
+
+        static void RunBatchWorkItem( void* pWorkList, size_t index );
 #endif
         //@}
     };
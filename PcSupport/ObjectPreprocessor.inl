@@ -20,4 +20,24 @@ namespace Helium
 
         return m_pPlatformPreprocessors[ platform ];
     }
+
+    /// Get the database used to track the inputs of cooked objects.
+    ///
+    /// @return  Cook dependency database.
+    ///
+    /// @see AddFileDependency(), AddObjectDependency()
+    DependencyDatabase& ObjectPreprocessor::GetDependencyDatabase()
+    {
+        return m_dependencyDatabase;
+    }
+
+    /// Get whether resource preprocessing is currently being deferred to the end of a batch.
+    ///
+    /// @return  True if a batch is in progress, false if not.
+    ///
+    /// @see BeginBatch(), EndBatch()
+    bool ObjectPreprocessor::IsBatching() const
+    {
+        return m_bBatching;
+    }
 }
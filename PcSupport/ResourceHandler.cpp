@@ -1,6 +1,9 @@
 #include "PcSupportPch.h"
 #include "PcSupport/ResourceHandler.h"
 
+#include "Engine/CacheManager.h"
+#include "Engine/GameObjectLoader.h"
+
 HELIUM_IMPLEMENT_OBJECT( Helium::ResourceHandler, PcSupport, 0 );
 
 using namespace Helium;
@@ -33,6 +36,17 @@ void ResourceHandler::GetSourceExtensions( const tchar_t* const*& rppExtensions,
     rExtensionCount = 0;
 }
 
+/// Get the version of the resource data produced by this handler.
+///
+/// Resources cooked with a different handler version are automatically preprocessed again, so this should be
+/// incremented whenever a change to the handler affects the data it produces.
+///
+/// @return  Handler version.
+uint32_t ResourceHandler::GetVersion() const
+{
+    return 0;
+}
+
 #if HELIUM_TOOLS
 /// Preprocess and cache the resource data for the given resource for all enabled target platforms.
 ///
@@ -48,11 +62,47 @@ bool ResourceHandler::CacheResource(
 {
     return false;
 }
+
+/// Get whether CacheResource() can safely be called for multiple resources on different threads at the same time.
+///
+/// Handlers that rely on shared, unsynchronized state (such as third-party importer libraries with global state)
+/// should leave this returning false, in which case batched resources of their type are preprocessed one at a time.
+///
+/// @return  True if concurrent caching is supported, false if not.
+///
+/// @see ObjectPreprocessor::EndBatch()
+bool ResourceHandler::SupportsConcurrentCaching() const
+{
+    return false;
+}
+
+/// Get the objects whose preprocessed data must be available before the given resource can be preprocessed.
+///
+/// When preprocessing a batch of resources, each resource is only preprocessed once the resources returned by this
+/// function that are part of the same batch have been preprocessed.
+///
+/// @param[in]  pResource      Resource being preprocessed.
+/// @param[out] rDependencies  Array to which each dependency should be appended.
+///
+/// @see ObjectPreprocessor::EndBatch()
+void ResourceHandler::GetResourceDependencies(
+    Resource* /*pResource*/,
+    DynamicArray< GameObject* >& /*rDependencies*/ ) const
+{
+}
 #endif  // HELIUM_TOOLS
 
 
 #if HELIUM_TOOLS
-void Helium::ResourceHandler::SaveObjectToPersistentDataBuffer( Reflect::Object *_object, DynamicArray< uint8_t > &_buffer )
+/// Serialize persistent resource data in the payload format of the object cache for a given platform.
+///
+/// @param[in]  _object   Persistent resource data object (can be null, in which case the buffer is cleared).
+/// @param[out] _buffer   Buffer in which to store the serialized data.
+/// @param[in]  platform  Platform for which the data is being serialized.
+///
+/// @see GetObjectPayloadFormat()
+void Helium::ResourceHandler::SaveObjectToPersistentDataBuffer(
+    Reflect::Object *_object, DynamicArray< uint8_t > &_buffer, Cache::EPlatform platform )
 {
     _buffer.Resize(0);
     if (!_object)
@@ -60,7 +110,7 @@ void Helium::ResourceHandler::SaveObjectToPersistentDataBuffer( Reflect::Object
         return;
     }
 
-    Cache::WriteCacheObjectToBuffer(*_object, _buffer);
+    Cache::WriteCacheObjectToBuffer(*_object, _buffer, GetObjectPayloadFormat( platform ));
 }
 #endif  // HELIUM_TOOLS
 
@@ -118,3 +168,47 @@ ResourceHandler* ResourceHandler::FindResourceHandlerForType( const GameObjectTy
 
     return NULL;
 }
+
+#if HELIUM_TOOLS
+/// Get the payload format used by the object cache for a given platform.
+///
+/// Persistent resource data is stored with the object's entry in the object cache, so it should be serialized in
+/// the format selected for that cache.
+///
+/// @param[in] platform  Target platform.
+///
+/// @return  Object cache payload format.
+///
+/// @see GetResourcePayloadFormat()
+Cache::EPayloadFormat ResourceHandler::GetObjectPayloadFormat( Cache::EPlatform platform )
+{
+    GameObjectLoader* pObjectLoader = GameObjectLoader::GetStaticInstance();
+    HELIUM_ASSERT( pObjectLoader );
+
+    Cache* pCache = CacheManager::GetStaticInstance().GetCache( pObjectLoader->GetCacheName(), platform );
+    HELIUM_ASSERT( pCache );
+
+    return pCache->GetPayloadFormat();
+}
+
+/// Get the payload format used by the cache holding the sub-data of a given resource.
+///
+/// @param[in] pResource  Resource.
+/// @param[in] platform   Target platform.
+///
+/// @return  Resource cache payload format.
+///
+/// @see GetObjectPayloadFormat()
+Cache::EPayloadFormat ResourceHandler::GetResourcePayloadFormat( Resource* pResource, Cache::EPlatform platform )
+{
+    HELIUM_ASSERT( pResource );
+
+    Name resourceCacheName = pResource->GetCacheName();
+    HELIUM_ASSERT( !resourceCacheName.IsEmpty() );
+
+    Cache* pCache = CacheManager::GetStaticInstance().GetCache( resourceCacheName, platform );
+    HELIUM_ASSERT( pCache );
+
+    return pCache->GetPayloadFormat();
+}
+#endif  // HELIUM_TOOLS
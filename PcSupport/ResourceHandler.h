@@ -39,12 +39,16 @@ namespace Helium
         //@{
         virtual const GameObjectType* GetResourceType() const;
         virtual void GetSourceExtensions( const tchar_t* const*& rppExtensions, size_t& rExtensionCount ) const;
+        virtual uint32_t GetVersion() const;
 
 #if HELIUM_TOOLS
         virtual bool CacheResource(
             ObjectPreprocessor* pObjectPreprocessor, Resource* pResource, const String& rSourceFilePath );
+        virtual bool SupportsConcurrentCaching() const;
+        virtual void GetResourceDependencies( Resource* pResource, DynamicArray< GameObject* >& rDependencies ) const;
         
-        void SaveObjectToPersistentDataBuffer(Reflect::Object *_object, DynamicArray< uint8_t > &_buffer);
+        void SaveObjectToPersistentDataBuffer(
+            Reflect::Object *_object, DynamicArray< uint8_t > &_buffer, Cache::EPlatform platform );
 #endif
         //@}
 
@@ -52,6 +56,11 @@ namespace Helium
         //@{
         static void GetAllResourceHandlers( DynamicArray< ResourceHandler* >& rResourceHandlers );
         static ResourceHandler* FindResourceHandlerForType( const GameObjectType* pType );
+
+#if HELIUM_TOOLS
+        static Cache::EPayloadFormat GetObjectPayloadFormat( Cache::EPlatform platform );
+        static Cache::EPayloadFormat GetResourcePayloadFormat( Resource* pResource, Cache::EPlatform platform );
+#endif
         //@}
     };
 }
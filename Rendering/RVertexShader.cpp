@@ -35,7 +35,7 @@ RShader::EType RVertexShader::GetType() const
 /// @param[in] pRenderer     Renderer instance.
 /// @param[in] pDescription  Vertex description.
 ///
-/// @see GetCachedInputLayout()
+/// @see GetCachedInputLayout(), GetInputLayout()
 void RVertexShader::CacheDescription( Renderer* pRenderer, RVertexDescription* pDescription )
 {
     if( m_spCachedDescription != pDescription )
@@ -61,3 +61,61 @@ RVertexInputLayout* RVertexShader::GetCachedInputLayout() const
 {
     return m_spCachedInputLayout;
 }
+
+/// Get the input layout for the specified vertex description, creating it if necessary.
+///
+/// Unlike CacheDescription(), this keeps an input layout around for each description used with this shader, and it
+/// can be safely called from multiple threads at once.  Note that the renderer will only be used to create a new
+/// input layout the first time a given description is used, and creation of input layouts is serialized across all
+/// threads using this function for the same shader.
+///
+/// @param[in] pRenderer     Renderer instance.
+/// @param[in] pDescription  Vertex description.
+///
+/// @return  Input layout for the given description, or null if the description is null.
+///
+/// @see CacheDescription()
+RVertexInputLayout* RVertexShader::GetInputLayout( Renderer* pRenderer, RVertexDescription* pDescription )
+{
+    if( !pDescription )
+    {
+        return NULL;
+    }
+
+    {
+        ScopeReadLock readLock( m_inputLayoutLock );
+
+        size_t layoutCount = m_inputLayouts.GetSize();
+        for( size_t layoutIndex = 0; layoutIndex < layoutCount; ++layoutIndex )
+        {
+            const InputLayoutEntry& rEntry = m_inputLayouts[ layoutIndex ];
+            if( rEntry.spDescription == pDescription )
+            {
+                return rEntry.spInputLayout;
+            }
+        }
+    }
+
+    ScopeWriteLock writeLock( m_inputLayoutLock );
+
+    // Another thread may have created the input layout while we were waiting for the write lock.
+    size_t layoutCount = m_inputLayouts.GetSize();
+    for( size_t layoutIndex = 0; layoutIndex < layoutCount; ++layoutIndex )
+    {
+        const InputLayoutEntry& rEntry = m_inputLayouts[ layoutIndex ];
+        if( rEntry.spDescription == pDescription )
+        {
+            return rEntry.spInputLayout;
+        }
+    }
+
+    HELIUM_ASSERT( pRenderer );
+
+    InputLayoutEntry* pEntry = m_inputLayouts.New();
+    HELIUM_ASSERT( pEntry );
+    pEntry->spDescription = pDescription;
+    pEntry->spInputLayout = pRenderer->CreateVertexInputLayout( pDescription, this );
+    HELIUM_ASSERT( pEntry->spInputLayout );
+
+    return pEntry->spInputLayout;
+}
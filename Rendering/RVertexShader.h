@@ -11,6 +11,9 @@
 
 #include "Rendering/RShader.h"
 
+#include "Foundation/DynamicArray.h"
+#include "Platform/Locks.h"
+
 namespace Helium
 {
     class Renderer;
@@ -31,14 +34,31 @@ namespace Helium
         //@{
         void CacheDescription( Renderer* pRenderer, RVertexDescription* pDescription );
         RVertexInputLayout* GetCachedInputLayout() const;
+
+        RVertexInputLayout* GetInputLayout( Renderer* pRenderer, RVertexDescription* pDescription );
         //@}
 
     protected:
+        /// Input layout created for a specific vertex description.
+        struct InputLayoutEntry
+        {
+            /// Vertex description.
+            RVertexDescriptionPtr spDescription;
+            /// Input layout for the vertex description.
+            RVertexInputLayoutPtr spInputLayout;
+        };
+
+
         /// Most recently used vertex description.
         RVertexDescriptionPtr m_spCachedDescription;
         /// Input layout associated with the most recently used vertex description.
         RVertexInputLayoutPtr m_spCachedInputLayout;
 
+        /// Input layouts created for each vertex description used with GetInputLayout().
+        DynamicArray< InputLayoutEntry > m_inputLayouts;
+        /// Synchronization lock for accessing the input layout list.
+        ReadWriteLock m_inputLayoutLock;
+
         /// @name Construction/Destruction
         //@{
         RVertexShader();
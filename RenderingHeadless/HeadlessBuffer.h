@@ -0,0 +1,66 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessBuffer.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_BUFFER_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_BUFFER_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RVertexBuffer.h"
+#include "Rendering/RIndexBuffer.h"
+#include "Rendering/RConstantBuffer.h"
+
+#include "Platform/MemoryHeap.h"
+#include "RenderingHeadless/HeadlessRenderer.h"
+
+namespace Helium
+{
+    /// System memory buffer implementation for the headless renderer.
+    ///
+    /// The same implementation is shared by all buffer interfaces (vertex, index, and constant buffers), which only
+    /// differ in the type of interface exposed.
+    template< typename BufferBase >
+    class HeadlessBuffer : public BufferBase
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        HeadlessBuffer( void* pData, size_t size );
+        //@}
+
+        /// @name Data Access
+        //@{
+        void* Map( ERendererBufferMapHint hint );
+        void Unmap();
+
+        const void* GetData() const;
+        size_t GetSize() const;
+        //@}
+
+    private:
+        /// Buffer data.
+        void* m_pData;
+        /// Buffer size, in bytes.
+        size_t m_size;
+
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessBuffer();
+        //@}
+    };
+
+    /// Headless vertex buffer.
+    typedef HeadlessBuffer< RVertexBuffer > HeadlessVertexBuffer;
+    /// Headless index buffer.
+    typedef HeadlessBuffer< RIndexBuffer > HeadlessIndexBuffer;
+    /// Headless constant buffer.
+    typedef HeadlessBuffer< RConstantBuffer > HeadlessConstantBuffer;
+}
+
+#include "RenderingHeadless/HeadlessBuffer.inl"
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_BUFFER_H
@@ -0,0 +1,78 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessBuffer.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Constructor.
+    ///
+    /// @param[in] pData  Buffer data allocated using DefaultAllocator.  This object will assume ownership of the
+    ///                   buffer memory once it has been constructed.
+    /// @param[in] size   Buffer size, in bytes.
+    template< typename BufferBase >
+    HeadlessBuffer< BufferBase >::HeadlessBuffer( void* pData, size_t size )
+        : m_pData( pData )
+        , m_size( size )
+    {
+        HELIUM_ASSERT( pData || size == 0 );
+    }
+
+    /// Destructor.
+    template< typename BufferBase >
+    HeadlessBuffer< BufferBase >::~HeadlessBuffer()
+    {
+        DefaultAllocator().Free( m_pData );
+    }
+
+    /// Map this buffer for writing.
+    ///
+    /// @param[in] hint  Mapping hint (ignored, as the buffer is never in use by a device).
+    ///
+    /// @return  Pointer to the buffer data.
+    ///
+    /// @see Unmap()
+    template< typename BufferBase >
+    void* HeadlessBuffer< BufferBase >::Map( ERendererBufferMapHint /*hint*/ )
+    {
+        return m_pData;
+    }
+
+    /// Unmap this buffer after writing.
+    ///
+    /// The entire buffer is counted as uploaded in the renderer statistics, matching the cost of a full buffer update
+    /// on a device.
+    ///
+    /// @see Map()
+    template< typename BufferBase >
+    void HeadlessBuffer< BufferBase >::Unmap()
+    {
+        HeadlessRenderer* pRenderer = static_cast< HeadlessRenderer* >( Renderer::GetStaticInstance() );
+        HELIUM_ASSERT( pRenderer );
+        pRenderer->NotifyUpload( m_size );
+    }
+
+    /// Get the buffer data.
+    ///
+    /// @return  Buffer data.
+    ///
+    /// @see GetSize()
+    template< typename BufferBase >
+    const void* HeadlessBuffer< BufferBase >::GetData() const
+    {
+        return m_pData;
+    }
+
+    /// Get the size of this buffer.
+    ///
+    /// @return  Buffer size, in bytes.
+    ///
+    /// @see GetData()
+    template< typename BufferBase >
+    size_t HeadlessBuffer< BufferBase >::GetSize() const
+    {
+        return m_size;
+    }
+}
@@ -0,0 +1,29 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessCommandList.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "RenderingHeadlessPch.h"
+#include "RenderingHeadless/HeadlessCommandList.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] rStream      Recorded command stream.  The contents of this array are swapped into the command list,
+///                         leaving the given array empty.
+/// @param[in] rStatistics  Counters for the recorded commands.
+HeadlessCommandList::HeadlessCommandList(
+    DynamicArray< uint8_t >& rStream,
+    const HeadlessCommandProxy::Statistics& rStatistics )
+    : m_statistics( rStatistics )
+{
+    m_stream.Swap( rStream );
+}
+
+/// Destructor.
+HeadlessCommandList::~HeadlessCommandList()
+{
+}
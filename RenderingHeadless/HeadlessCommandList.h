@@ -0,0 +1,50 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessCommandList.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_COMMAND_LIST_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_COMMAND_LIST_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RRenderCommandList.h"
+
+#include "RenderingHeadless/HeadlessCommandProxy.h"
+
+namespace Helium
+{
+    /// Command list for the headless renderer, holding a command stream recorded by a HeadlessCommandProxy.
+    class HeadlessCommandList : public RRenderCommandList
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        HeadlessCommandList( DynamicArray< uint8_t >& rStream, const HeadlessCommandProxy::Statistics& rStatistics );
+        //@}
+
+        /// @name Data Access
+        //@{
+        inline const uint8_t* GetStreamData() const;
+        inline size_t GetStreamSize() const;
+        inline const HeadlessCommandProxy::Statistics& GetStatistics() const;
+        //@}
+
+    private:
+        /// Recorded command stream.
+        DynamicArray< uint8_t > m_stream;
+        /// Recorded command counters.
+        HeadlessCommandProxy::Statistics m_statistics;
+
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessCommandList();
+        //@}
+    };
+}
+
+#include "RenderingHeadless/HeadlessCommandList.inl"
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_COMMAND_LIST_H
@@ -0,0 +1,37 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessCommandList.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get the recorded command stream.
+    ///
+    /// @return  Command stream data.
+    ///
+    /// @see GetStreamSize()
+    const uint8_t* HeadlessCommandList::GetStreamData() const
+    {
+        return m_stream.GetData();
+    }
+
+    /// Get the size of the recorded command stream.
+    ///
+    /// @return  Command stream size, in bytes.
+    ///
+    /// @see GetStreamData()
+    size_t HeadlessCommandList::GetStreamSize() const
+    {
+        return m_stream.GetSize();
+    }
+
+    /// Get the counters for the recorded commands.
+    ///
+    /// @return  Command statistics.
+    const HeadlessCommandProxy::Statistics& HeadlessCommandList::GetStatistics() const
+    {
+        return m_statistics;
+    }
+}
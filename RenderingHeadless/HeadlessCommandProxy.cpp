@@ -0,0 +1,333 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessCommandProxy.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "RenderingHeadlessPch.h"
+#include "RenderingHeadless/HeadlessCommandProxy.h"
+
+#include "RenderingHeadless/HeadlessCommandList.h"
+
+using namespace Helium;
+
+/// Constructor.
+HeadlessCommandProxy::HeadlessCommandProxy()
+{
+}
+
+/// Destructor.
+HeadlessCommandProxy::~HeadlessCommandProxy()
+{
+}
+
+/// @copydoc RRenderCommandProxy::SetRasterizerState()
+void HeadlessCommandProxy::SetRasterizerState( RRasterizerState* pState )
+{
+    BeginCommand( COMMAND_SET_RASTERIZER_STATE );
+    WriteResource( pState );
+
+    ++m_statistics.stateChangeCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetBlendState()
+void HeadlessCommandProxy::SetBlendState( RBlendState* pState )
+{
+    BeginCommand( COMMAND_SET_BLEND_STATE );
+    WriteResource( pState );
+
+    ++m_statistics.stateChangeCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetDepthStencilState()
+void HeadlessCommandProxy::SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue )
+{
+    BeginCommand( COMMAND_SET_DEPTH_STENCIL_STATE );
+    WriteResource( pState );
+    Write( stencilReferenceValue );
+
+    ++m_statistics.stateChangeCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetSamplerStates()
+void HeadlessCommandProxy::SetSamplerStates( size_t startIndex, size_t samplerCount, RSamplerState* const* ppStates )
+{
+    HELIUM_ASSERT( ppStates || samplerCount == 0 );
+
+    BeginCommand( COMMAND_SET_SAMPLER_STATES );
+    Write( static_cast< uint32_t >( startIndex ) );
+    Write( static_cast< uint32_t >( samplerCount ) );
+    for( size_t samplerIndex = 0; samplerIndex < samplerCount; ++samplerIndex )
+    {
+        WriteResource( ppStates[ samplerIndex ] );
+    }
+
+    ++m_statistics.stateChangeCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetRenderSurfaces()
+void HeadlessCommandProxy::SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface )
+{
+    BeginCommand( COMMAND_SET_RENDER_SURFACES );
+    WriteResource( pRenderTargetSurface );
+    WriteResource( pDepthStencilSurface );
+
+    ++m_statistics.stateChangeCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetViewport()
+void HeadlessCommandProxy::SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+{
+    BeginCommand( COMMAND_SET_VIEWPORT );
+    Write( x );
+    Write( y );
+    Write( width );
+    Write( height );
+
+    ++m_statistics.stateChangeCount;
+}
+
+/// @copydoc RRenderCommandProxy::BeginScene()
+void HeadlessCommandProxy::BeginScene()
+{
+    BeginCommand( COMMAND_BEGIN_SCENE );
+}
+
+/// @copydoc RRenderCommandProxy::EndScene()
+void HeadlessCommandProxy::EndScene()
+{
+    BeginCommand( COMMAND_END_SCENE );
+}
+
+/// @copydoc RRenderCommandProxy::Clear()
+void HeadlessCommandProxy::Clear( uint32_t clearFlags, const Color& rColor, float32_t depth, uint8_t stencil )
+{
+    BeginCommand( COMMAND_CLEAR );
+    Write( clearFlags );
+    Write( rColor.GetArgb() );
+    Write( depth );
+    Write( stencil );
+
+    ++m_statistics.clearCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetIndexBuffer()
+void HeadlessCommandProxy::SetIndexBuffer( RIndexBuffer* pBuffer )
+{
+    BeginCommand( COMMAND_SET_INDEX_BUFFER );
+    WriteResource( pBuffer );
+
+    ++m_statistics.resourceBindCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexBuffers()
+void HeadlessCommandProxy::SetVertexBuffers(
+    size_t startIndex,
+    size_t bufferCount,
+    RVertexBuffer* const* ppBuffers,
+    uint32_t* pStrides,
+    uint32_t* pOffsets )
+{
+    HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+    HELIUM_ASSERT( pStrides || bufferCount == 0 );
+    HELIUM_ASSERT( pOffsets || bufferCount == 0 );
+
+    BeginCommand( COMMAND_SET_VERTEX_BUFFERS );
+    Write( static_cast< uint32_t >( startIndex ) );
+    Write( static_cast< uint32_t >( bufferCount ) );
+    for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+    {
+        WriteResource( ppBuffers[ bufferIndex ] );
+        Write( pStrides[ bufferIndex ] );
+        Write( pOffsets[ bufferIndex ] );
+    }
+
+    ++m_statistics.resourceBindCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexInputLayout()
+void HeadlessCommandProxy::SetVertexInputLayout( RVertexInputLayout* pLayout )
+{
+    BeginCommand( COMMAND_SET_VERTEX_INPUT_LAYOUT );
+    WriteResource( pLayout );
+
+    ++m_statistics.stateChangeCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexShader()
+void HeadlessCommandProxy::SetVertexShader( RVertexShader* pShader )
+{
+    BeginCommand( COMMAND_SET_VERTEX_SHADER );
+    WriteResource( pShader );
+
+    ++m_statistics.stateChangeCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelShader()
+void HeadlessCommandProxy::SetPixelShader( RPixelShader* pShader )
+{
+    BeginCommand( COMMAND_SET_PIXEL_SHADER );
+    WriteResource( pShader );
+
+    ++m_statistics.stateChangeCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexConstantBuffers()
+void HeadlessCommandProxy::SetVertexConstantBuffers(
+    size_t startIndex,
+    size_t bufferCount,
+    RConstantBuffer* const* ppBuffers,
+    const size_t* pLimitSizes )
+{
+    SetConstantBuffers( COMMAND_SET_VERTEX_CONSTANT_BUFFERS, startIndex, bufferCount, ppBuffers, pLimitSizes );
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelConstantBuffers()
+void HeadlessCommandProxy::SetPixelConstantBuffers(
+    size_t startIndex,
+    size_t bufferCount,
+    RConstantBuffer* const* ppBuffers,
+    const size_t* pLimitSizes )
+{
+    SetConstantBuffers( COMMAND_SET_PIXEL_CONSTANT_BUFFERS, startIndex, bufferCount, ppBuffers, pLimitSizes );
+}
+
+/// @copydoc RRenderCommandProxy::SetTexture()
+void HeadlessCommandProxy::SetTexture( size_t samplerIndex, RTexture* pTexture )
+{
+    BeginCommand( COMMAND_SET_TEXTURE );
+    Write( static_cast< uint32_t >( samplerIndex ) );
+    WriteResource( pTexture );
+
+    ++m_statistics.resourceBindCount;
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexed()
+void HeadlessCommandProxy::DrawIndexed(
+    ERendererPrimitiveType primitiveType,
+    uint32_t baseVertexIndex,
+    uint32_t minIndex,
+    uint32_t usedVertexCount,
+    uint32_t startIndex,
+    uint32_t primitiveCount )
+{
+    BeginCommand( COMMAND_DRAW_INDEXED );
+    Write( static_cast< uint8_t >( primitiveType ) );
+    Write( baseVertexIndex );
+    Write( minIndex );
+    Write( usedVertexCount );
+    Write( startIndex );
+    Write( primitiveCount );
+
+    ++m_statistics.drawCallCount;
+    m_statistics.primitiveCount += primitiveCount;
+}
+
+/// @copydoc RRenderCommandProxy::DrawUnindexed()
+void HeadlessCommandProxy::DrawUnindexed(
+    ERendererPrimitiveType primitiveType,
+    uint32_t baseVertexIndex,
+    uint32_t primitiveCount )
+{
+    BeginCommand( COMMAND_DRAW_UNINDEXED );
+    Write( static_cast< uint8_t >( primitiveType ) );
+    Write( baseVertexIndex );
+    Write( primitiveCount );
+
+    ++m_statistics.drawCallCount;
+    m_statistics.primitiveCount += primitiveCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetFence()
+void HeadlessCommandProxy::SetFence( RFence* pFence )
+{
+    BeginCommand( COMMAND_SET_FENCE );
+    WriteResource( pFence );
+}
+
+/// @copydoc RRenderCommandProxy::UnbindResources()
+void HeadlessCommandProxy::UnbindResources()
+{
+    BeginCommand( COMMAND_UNBIND_RESOURCES );
+}
+
+/// @copydoc RRenderCommandProxy::ExecuteCommandList()
+void HeadlessCommandProxy::ExecuteCommandList( RRenderCommandList* pCommandList )
+{
+    HELIUM_ASSERT( pCommandList );
+
+    HeadlessCommandList* pHeadlessCommandList = static_cast< HeadlessCommandList* >( pCommandList );
+    m_stream.AddArray( pHeadlessCommandList->GetStreamData(), pHeadlessCommandList->GetStreamSize() );
+    m_statistics.Add( pHeadlessCommandList->GetStatistics() );
+
+    ++m_statistics.commandListCount;
+}
+
+/// @copydoc RRenderCommandProxy::FinishCommandList()
+void HeadlessCommandProxy::FinishCommandList( RRenderCommandListPtr& rspCommandList )
+{
+    rspCommandList = new HeadlessCommandList( m_stream, m_statistics );
+    HELIUM_ASSERT( rspCommandList );
+
+    Reset();
+}
+
+/// Clear the recorded command stream and reset all command counters.
+///
+/// The immediate command proxy of the headless renderer is reset automatically each time a frame is presented (see
+/// HeadlessRenderer::NotifySwap()).
+///
+/// @see GetStreamData(), GetStreamSize(), GetStatistics()
+void HeadlessCommandProxy::Reset()
+{
+    m_stream.Resize( 0 );
+    m_statistics = Statistics();
+}
+
+/// Write the start of a new command to the command stream.
+///
+/// @param[in] command  Command identifier.
+void HeadlessCommandProxy::BeginCommand( ECommand command )
+{
+    HELIUM_ASSERT( static_cast< size_t >( command ) < static_cast< size_t >( COMMAND_MAX ) );
+
+    Write( static_cast< uint8_t >( command ) );
+    ++m_statistics.commandCount;
+}
+
+/// Write a resource reference to the command stream.
+///
+/// @param[in] pResource  Resource to reference (can be null).
+void HeadlessCommandProxy::WriteResource( const void* pResource )
+{
+    Write( static_cast< uint64_t >( reinterpret_cast< uintptr_t >( pResource ) ) );
+}
+
+/// Write a constant buffer binding command to the command stream.
+///
+/// @param[in] command      Command identifier.
+/// @param[in] startIndex   Index of the first constant buffer slot to set.
+/// @param[in] bufferCount  Number of constant buffers to set.
+/// @param[in] ppBuffers    Constant buffers to set.
+/// @param[in] pLimitSizes  Optional array of limits on the number of bytes of each buffer to use.
+void HeadlessCommandProxy::SetConstantBuffers(
+    ECommand command,
+    size_t startIndex,
+    size_t bufferCount,
+    RConstantBuffer* const* ppBuffers,
+    const size_t* pLimitSizes )
+{
+    HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+
+    BeginCommand( command );
+    Write( static_cast< uint32_t >( startIndex ) );
+    Write( static_cast< uint32_t >( bufferCount ) );
+    for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+    {
+        WriteResource( ppBuffers[ bufferIndex ] );
+        Write( static_cast< uint64_t >( pLimitSizes ? pLimitSizes[ bufferIndex ] : Invalid< size_t >() ) );
+    }
+
+    ++m_statistics.resourceBindCount;
+}
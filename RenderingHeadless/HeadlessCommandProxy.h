@@ -0,0 +1,215 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessCommandProxy.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_COMMAND_PROXY_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_COMMAND_PROXY_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RRenderCommandProxy.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+    /// Render command proxy for the headless renderer.
+    ///
+    /// Commands are not executed, but are instead recorded into a compact command stream along with a set of counters
+    /// that can be used for benchmarking and regression testing of the rendering code.  Each command is written as a
+    /// single command identifier byte (see ECommand) followed by its tightly packed arguments, with resources written
+    /// as their object addresses.
+    ///
+    /// The same implementation is used for both the immediate command proxy and deferred command proxies.  Executing a
+    /// command list appends its stream to the stream of the executing proxy, so rendering through deferred command
+    /// lists produces the same stream as issuing the same commands directly on the immediate proxy.
+    class HELIUM_RENDERING_HEADLESS_API HeadlessCommandProxy : public RRenderCommandProxy
+    {
+    public:
+        /// Recorded command identifiers.
+        enum ECommand
+        {
+            COMMAND_FIRST   =  0,
+            COMMAND_INVALID = -1,
+
+            /// SetRasterizerState().
+            COMMAND_SET_RASTERIZER_STATE,
+            /// SetBlendState().
+            COMMAND_SET_BLEND_STATE,
+            /// SetDepthStencilState().
+            COMMAND_SET_DEPTH_STENCIL_STATE,
+            /// SetSamplerStates().
+            COMMAND_SET_SAMPLER_STATES,
+            /// SetRenderSurfaces().
+            COMMAND_SET_RENDER_SURFACES,
+            /// SetViewport().
+            COMMAND_SET_VIEWPORT,
+            /// BeginScene().
+            COMMAND_BEGIN_SCENE,
+            /// EndScene().
+            COMMAND_END_SCENE,
+            /// Clear().
+            COMMAND_CLEAR,
+            /// SetIndexBuffer().
+            COMMAND_SET_INDEX_BUFFER,
+            /// SetVertexBuffers().
+            COMMAND_SET_VERTEX_BUFFERS,
+            /// SetVertexInputLayout().
+            COMMAND_SET_VERTEX_INPUT_LAYOUT,
+            /// SetVertexShader().
+            COMMAND_SET_VERTEX_SHADER,
+            /// SetPixelShader().
+            COMMAND_SET_PIXEL_SHADER,
+            /// SetVertexConstantBuffers().
+            COMMAND_SET_VERTEX_CONSTANT_BUFFERS,
+            /// SetPixelConstantBuffers().
+            COMMAND_SET_PIXEL_CONSTANT_BUFFERS,
+            /// SetTexture().
+            COMMAND_SET_TEXTURE,
+            /// DrawIndexed().
+            COMMAND_DRAW_INDEXED,
+            /// DrawUnindexed().
+            COMMAND_DRAW_UNINDEXED,
+            /// SetFence().
+            COMMAND_SET_FENCE,
+            /// UnbindResources().
+            COMMAND_UNBIND_RESOURCES,
+
+            COMMAND_MAX,
+            COMMAND_LAST = COMMAND_MAX - 1
+        };
+
+        /// Recorded command counters.
+        struct Statistics
+        {
+            /// Total number of commands recorded.
+            uint32_t commandCount;
+            /// Number of draw calls.
+            uint32_t drawCallCount;
+            /// Number of primitives drawn.
+            uint64_t primitiveCount;
+            /// Number of pipeline state changes (state objects, render surfaces, viewports, shaders, and vertex input
+            /// layouts).
+            uint32_t stateChangeCount;
+            /// Number of resource binding changes (vertex, index, and constant buffers, and textures).
+            uint32_t resourceBindCount;
+            /// Number of surface clears.
+            uint32_t clearCount;
+            /// Number of command lists executed (not counted in the command stream itself).
+            uint32_t commandListCount;
+
+            /// @name Construction/Destruction
+            //@{
+            inline Statistics();
+            //@}
+
+            /// @name Counter Updates
+            //@{
+            inline void Add( const Statistics& rStatistics );
+            //@}
+        };
+
+        /// @name Construction/Destruction
+        //@{
+        HeadlessCommandProxy();
+        //@}
+
+        /// @name State Management
+        //@{
+        void SetRasterizerState( RRasterizerState* pState );
+        void SetBlendState( RBlendState* pState );
+        void SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue );
+        void SetSamplerStates( size_t startIndex, size_t samplerCount, RSamplerState* const* ppStates );
+        //@}
+
+        /// @name Render Target Management
+        //@{
+        void SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface );
+        void SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+        //@}
+
+        /// @name Command Generation
+        //@{
+        void BeginScene();
+        void EndScene();
+
+        void Clear( uint32_t clearFlags, const Color& rColor, float32_t depth, uint8_t stencil );
+
+        void SetIndexBuffer( RIndexBuffer* pBuffer );
+        void SetVertexBuffers(
+            size_t startIndex, size_t bufferCount, RVertexBuffer* const* ppBuffers, uint32_t* pStrides,
+            uint32_t* pOffsets );
+        void SetVertexInputLayout( RVertexInputLayout* pLayout );
+
+        void SetVertexShader( RVertexShader* pShader );
+        void SetPixelShader( RPixelShader* pShader );
+
+        void SetVertexConstantBuffers(
+            size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes );
+        void SetPixelConstantBuffers(
+            size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes );
+
+        void SetTexture( size_t samplerIndex, RTexture* pTexture );
+
+        void DrawIndexed(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+            uint32_t startIndex, uint32_t primitiveCount );
+        void DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount );
+        //@}
+
+        /// @name Fence Commands
+        //@{
+        void SetFence( RFence* pFence );
+        //@}
+
+        /// @name Miscellaneous Resource Management
+        //@{
+        void UnbindResources();
+        //@}
+
+        /// @name Command List Support
+        //@{
+        void ExecuteCommandList( RRenderCommandList* pCommandList );
+
+        void FinishCommandList( RRenderCommandListPtr& rspCommandList );
+        //@}
+
+        /// @name Command Stream Access
+        //@{
+        inline const uint8_t* GetStreamData() const;
+        inline size_t GetStreamSize() const;
+        inline const Statistics& GetStatistics() const;
+
+        void Reset();
+        //@}
+
+    private:
+        /// Recorded command stream.
+        DynamicArray< uint8_t > m_stream;
+        /// Recorded command counters.
+        Statistics m_statistics;
+
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessCommandProxy();
+        //@}
+
+        /// @name Command Stream Writing
+        //@{
+        void BeginCommand( ECommand command );
+        void WriteResource( const void* pResource );
+        template< typename T > void Write( const T& rValue );
+
+        void SetConstantBuffers(
+            ECommand command, size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
+            const size_t* pLimitSizes );
+        //@}
+    };
+}
+
+#include "RenderingHeadless/HeadlessCommandProxy.inl"
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_COMMAND_PROXY_H
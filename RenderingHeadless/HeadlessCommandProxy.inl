@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessCommandProxy.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Constructor.
+    HeadlessCommandProxy::Statistics::Statistics()
+        : commandCount( 0 )
+        , drawCallCount( 0 )
+        , primitiveCount( 0 )
+        , stateChangeCount( 0 )
+        , resourceBindCount( 0 )
+        , clearCount( 0 )
+        , commandListCount( 0 )
+    {
+    }
+
+    /// Add the counters from another set of statistics to this set.
+    ///
+    /// @param[in] rStatistics  Statistics to add.
+    void HeadlessCommandProxy::Statistics::Add( const Statistics& rStatistics )
+    {
+        commandCount += rStatistics.commandCount;
+        drawCallCount += rStatistics.drawCallCount;
+        primitiveCount += rStatistics.primitiveCount;
+        stateChangeCount += rStatistics.stateChangeCount;
+        resourceBindCount += rStatistics.resourceBindCount;
+        clearCount += rStatistics.clearCount;
+        commandListCount += rStatistics.commandListCount;
+    }
+
+    /// Get the command stream recorded since this proxy was created or last reset.
+    ///
+    /// @return  Command stream data.
+    ///
+    /// @see GetStreamSize(), GetStatistics(), Reset()
+    const uint8_t* HeadlessCommandProxy::GetStreamData() const
+    {
+        return m_stream.GetData();
+    }
+
+    /// Get the size of the command stream recorded since this proxy was created or last reset.
+    ///
+    /// @return  Command stream size, in bytes.
+    ///
+    /// @see GetStreamData(), GetStatistics(), Reset()
+    size_t HeadlessCommandProxy::GetStreamSize() const
+    {
+        return m_stream.GetSize();
+    }
+
+    /// Get the counters for the commands recorded since this proxy was created or last reset.
+    ///
+    /// @return  Command statistics.
+    ///
+    /// @see GetStreamData(), GetStreamSize(), Reset()
+    const HeadlessCommandProxy::Statistics& HeadlessCommandProxy::GetStatistics() const
+    {
+        return m_statistics;
+    }
+
+    /// Write a value to the end of the command stream.
+    ///
+    /// @param[in] rValue  Value to write.
+    template< typename T >
+    void HeadlessCommandProxy::Write( const T& rValue )
+    {
+        m_stream.AddArray( reinterpret_cast< const uint8_t* >( &rValue ), sizeof( T ) );
+    }
+}
@@ -0,0 +1,16 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessFence.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "RenderingHeadlessPch.h"
+#include "RenderingHeadless/HeadlessFence.h"
+
+using namespace Helium;
+
+/// Destructor.
+HeadlessFence::~HeadlessFence()
+{
+}
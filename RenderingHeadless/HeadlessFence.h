@@ -0,0 +1,28 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessFence.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_FENCE_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_FENCE_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RFence.h"
+
+namespace Helium
+{
+    /// Fence for the headless renderer.  Commands are never executed asynchronously, so fences are always signaled.
+    class HeadlessFence : public RFence
+    {
+    private:
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessFence();
+        //@}
+    };
+}
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_FENCE_H
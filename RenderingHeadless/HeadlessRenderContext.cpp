@@ -0,0 +1,42 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessRenderContext.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "RenderingHeadlessPch.h"
+#include "RenderingHeadless/HeadlessRenderContext.h"
+
+#include "RenderingHeadless/HeadlessSurface.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] width   Back buffer width, in pixels.
+/// @param[in] height  Back buffer height, in pixels.
+HeadlessRenderContext::HeadlessRenderContext( uint32_t width, uint32_t height )
+    : m_spBackBufferSurface( new HeadlessSurface( width, height ) )
+{
+    HELIUM_ASSERT( m_spBackBufferSurface );
+}
+
+/// Destructor.
+HeadlessRenderContext::~HeadlessRenderContext()
+{
+}
+
+/// @copydoc RRenderContext::GetBackBufferSurface()
+RSurface* HeadlessRenderContext::GetBackBufferSurface()
+{
+    return m_spBackBufferSurface;
+}
+
+/// @copydoc RRenderContext::Swap()
+void HeadlessRenderContext::Swap()
+{
+    HeadlessRenderer* pRenderer = static_cast< HeadlessRenderer* >( Renderer::GetStaticInstance() );
+    HELIUM_ASSERT( pRenderer );
+    pRenderer->NotifySwap();
+}
@@ -0,0 +1,46 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessRenderContext.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_RENDER_CONTEXT_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_RENDER_CONTEXT_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RRenderContext.h"
+
+namespace Helium
+{
+    HELIUM_DECLARE_RPTR( HeadlessSurface );
+
+    /// Render context for the headless renderer.  Swapping only updates the renderer statistics, as there is no
+    /// display to present to.
+    class HeadlessRenderContext : public RRenderContext
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        HeadlessRenderContext( uint32_t width, uint32_t height );
+        //@}
+
+        /// @name Render Control
+        //@{
+        RSurface* GetBackBufferSurface();
+        void Swap();
+        //@}
+
+    private:
+        /// Back buffer surface.
+        HeadlessSurfacePtr m_spBackBufferSurface;
+
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessRenderContext();
+        //@}
+    };
+}
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_RENDER_CONTEXT_H
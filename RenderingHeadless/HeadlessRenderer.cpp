@@ -0,0 +1,548 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessRenderer.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "RenderingHeadlessPch.h"
+#include "RenderingHeadless/HeadlessRenderer.h"
+
+#include "Rendering/RendererUtil.h"
+
+#include "RenderingHeadless/HeadlessBuffer.h"
+#include "RenderingHeadless/HeadlessCommandProxy.h"
+#include "RenderingHeadless/HeadlessFence.h"
+#include "RenderingHeadless/HeadlessRenderContext.h"
+#include "RenderingHeadless/HeadlessShader.h"
+#include "RenderingHeadless/HeadlessStateObject.h"
+#include "RenderingHeadless/HeadlessSurface.h"
+#include "RenderingHeadless/HeadlessTexture2d.h"
+#include "RenderingHeadless/HeadlessVertexDescription.h"
+#include "RenderingHeadless/HeadlessVertexInputLayout.h"
+
+using namespace Helium;
+
+/// Constructor.
+HeadlessRenderer::HeadlessRenderer()
+    : m_pCommandStreamCapture( NULL )
+{
+}
+
+/// Destructor.
+HeadlessRenderer::~HeadlessRenderer()
+{
+}
+
+/// @copydoc Renderer::Initialize()
+bool HeadlessRenderer::Initialize()
+{
+    // Trap attempts at multiple initialization.
+    HELIUM_ASSERT( !m_spImmediateCommandProxy );
+    if( m_spImmediateCommandProxy )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            TXT( "HeadlessRenderer: Initialize() called on an already initialized renderer.\n" ) );
+
+        return true;
+    }
+
+    HELIUM_TRACE( TraceLevels::Info, TXT( "Initializing headless rendering support (HeadlessRenderer).\n" ) );
+
+    m_spImmediateCommandProxy = new HeadlessCommandProxy;
+    HELIUM_ASSERT( m_spImmediateCommandProxy );
+
+    // Depth textures are simply system memory textures, so report support for them in order to exercise the shadow
+    // rendering paths as well.
+    m_featureFlags = RENDERER_FEATURE_FLAG_DEPTH_TEXTURE;
+
+    ResetStatistics();
+
+    HELIUM_TRACE( TraceLevels::Info, TXT( "Headless renderer initialized successfully.\n" ) );
+
+    return true;
+}
+
+/// @copydoc Renderer::Shutdown()
+void HeadlessRenderer::Shutdown()
+{
+    HELIUM_TRACE( TraceLevels::Info, TXT( "Shutting down headless rendering support.\n" ) );
+
+    m_spMainContext.Release();
+    m_spImmediateCommandProxy.Release();
+
+    m_featureFlags = 0;
+
+    HELIUM_TRACE( TraceLevels::Info, TXT( "Headless renderer shutdown complete.\n" ) );
+}
+
+/// @copydoc Renderer::CreateMainContext()
+bool HeadlessRenderer::CreateMainContext( const ContextInitParameters& rInitParameters )
+{
+    HELIUM_ASSERT( !m_spMainContext );
+    if( m_spMainContext )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "HeadlessRenderer::CreateMainContext(): Main context has already been created.\n" ) );
+
+        return false;
+    }
+
+    m_spMainContext = new HeadlessRenderContext( rInitParameters.displayWidth, rInitParameters.displayHeight );
+    HELIUM_ASSERT( m_spMainContext );
+
+    return true;
+}
+
+/// @copydoc Renderer::ResetMainContext()
+bool HeadlessRenderer::ResetMainContext( const ContextInitParameters& rInitParameters )
+{
+    HELIUM_ASSERT( m_spMainContext );
+    if( !m_spMainContext )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "HeadlessRenderer::ResetMainContext(): Main context has not been created.\n" ) );
+
+        return false;
+    }
+
+    m_spMainContext = new HeadlessRenderContext( rInitParameters.displayWidth, rInitParameters.displayHeight );
+    HELIUM_ASSERT( m_spMainContext );
+
+    return true;
+}
+
+/// @copydoc Renderer::GetMainContext()
+RRenderContext* HeadlessRenderer::GetMainContext()
+{
+    return m_spMainContext;
+}
+
+/// @copydoc Renderer::CreateSubContext()
+RRenderContext* HeadlessRenderer::CreateSubContext( const ContextInitParameters& rInitParameters )
+{
+    HeadlessRenderContext* pContext =
+        new HeadlessRenderContext( rInitParameters.displayWidth, rInitParameters.displayHeight );
+    HELIUM_ASSERT( pContext );
+
+    return pContext;
+}
+
+/// @copydoc Renderer::GetStatus()
+Renderer::EStatus HeadlessRenderer::GetStatus()
+{
+    // There is no device to lose.
+    return STATUS_READY;
+}
+
+/// @copydoc Renderer::Reset()
+Renderer::EStatus HeadlessRenderer::Reset()
+{
+    return STATUS_READY;
+}
+
+/// @copydoc Renderer::CreateRasterizerState()
+RRasterizerState* HeadlessRenderer::CreateRasterizerState( const RRasterizerState::Description& rDescription )
+{
+    HeadlessRasterizerState* pState = new HeadlessRasterizerState( rDescription );
+    HELIUM_ASSERT( pState );
+
+    return pState;
+}
+
+/// @copydoc Renderer::CreateBlendState()
+RBlendState* HeadlessRenderer::CreateBlendState( const RBlendState::Description& rDescription )
+{
+    HeadlessBlendState* pState = new HeadlessBlendState( rDescription );
+    HELIUM_ASSERT( pState );
+
+    return pState;
+}
+
+/// @copydoc Renderer::CreateDepthStencilState()
+RDepthStencilState* HeadlessRenderer::CreateDepthStencilState( const RDepthStencilState::Description& rDescription )
+{
+    HeadlessDepthStencilState* pState = new HeadlessDepthStencilState( rDescription );
+    HELIUM_ASSERT( pState );
+
+    return pState;
+}
+
+/// @copydoc Renderer::CreateSamplerState()
+RSamplerState* HeadlessRenderer::CreateSamplerState( const RSamplerState::Description& rDescription )
+{
+    HeadlessSamplerState* pState = new HeadlessSamplerState( rDescription );
+    HELIUM_ASSERT( pState );
+
+    return pState;
+}
+
+/// @copydoc Renderer::CreateDepthStencilSurface()
+RSurface* HeadlessRenderer::CreateDepthStencilSurface(
+    uint32_t width,
+    uint32_t height,
+    ERendererSurfaceFormat /*format*/,
+    uint32_t /*multisampleCount*/ )
+{
+    HeadlessSurface* pSurface = new HeadlessSurface( width, height );
+    HELIUM_ASSERT( pSurface );
+
+    return pSurface;
+}
+
+/// @copydoc Renderer::CreateVertexShader()
+RVertexShader* HeadlessRenderer::CreateVertexShader( size_t size, const void* pData )
+{
+    void* pShaderData = DefaultAllocator().Allocate( size );
+    HELIUM_ASSERT( pShaderData || size == 0 );
+    if( pData )
+    {
+        MemoryCopy( pShaderData, pData, size );
+    }
+
+    HeadlessVertexShader* pShader = new HeadlessVertexShader( pShaderData, size, !pData );
+    HELIUM_ASSERT( pShader );
+
+    return pShader;
+}
+
+/// @copydoc Renderer::CreatePixelShader()
+RPixelShader* HeadlessRenderer::CreatePixelShader( size_t size, const void* pData )
+{
+    void* pShaderData = DefaultAllocator().Allocate( size );
+    HELIUM_ASSERT( pShaderData || size == 0 );
+    if( pData )
+    {
+        MemoryCopy( pShaderData, pData, size );
+    }
+
+    HeadlessPixelShader* pShader = new HeadlessPixelShader( pShaderData, size, !pData );
+    HELIUM_ASSERT( pShader );
+
+    return pShader;
+}
+
+/// @copydoc Renderer::CreateVertexBuffer()
+RVertexBuffer* HeadlessRenderer::CreateVertexBuffer( size_t size, ERendererBufferUsage usage, const void* pData )
+{
+    // Vertex and index buffers can only be created with static or dynamic usage semantics.
+    HELIUM_ASSERT( usage == RENDERER_BUFFER_USAGE_STATIC || usage == RENDERER_BUFFER_USAGE_DYNAMIC );
+    if( usage != RENDERER_BUFFER_USAGE_STATIC && usage != RENDERER_BUFFER_USAGE_DYNAMIC )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            ( TXT( "HeadlessRenderer::CreateVertexBuffer(): Vertex buffers can only be created with static or " )
+            TXT( "dynamic usage semantics.\n" ) ) );
+
+        return NULL;
+    }
+
+    void* pBufferData = DefaultAllocator().Allocate( size );
+    HELIUM_ASSERT( pBufferData || size == 0 );
+    if( pData )
+    {
+        MemoryCopy( pBufferData, pData, size );
+    }
+
+    HeadlessVertexBuffer* pBuffer = new HeadlessVertexBuffer( pBufferData, size );
+    HELIUM_ASSERT( pBuffer );
+
+    NotifyResourceCreated( pData ? size : 0 );
+
+    return pBuffer;
+}
+
+/// @copydoc Renderer::CreateIndexBuffer()
+RIndexBuffer* HeadlessRenderer::CreateIndexBuffer(
+    size_t size,
+    ERendererBufferUsage usage,
+    ERendererIndexFormat format,
+    const void* pData )
+{
+    // Vertex and index buffers can only be created with static or dynamic usage semantics.
+    HELIUM_ASSERT( usage == RENDERER_BUFFER_USAGE_STATIC || usage == RENDERER_BUFFER_USAGE_DYNAMIC );
+    if( usage != RENDERER_BUFFER_USAGE_STATIC && usage != RENDERER_BUFFER_USAGE_DYNAMIC )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            ( TXT( "HeadlessRenderer::CreateIndexBuffer(): Index buffers can only be created with static or " )
+            TXT( "dynamic usage semantics.\n" ) ) );
+
+        return NULL;
+    }
+
+    HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_INDEX_FORMAT_MAX ) );
+    HELIUM_UNREF( format );
+
+    void* pBufferData = DefaultAllocator().Allocate( size );
+    HELIUM_ASSERT( pBufferData || size == 0 );
+    if( pData )
+    {
+        MemoryCopy( pBufferData, pData, size );
+    }
+
+    HeadlessIndexBuffer* pBuffer = new HeadlessIndexBuffer( pBufferData, size );
+    HELIUM_ASSERT( pBuffer );
+
+    NotifyResourceCreated( pData ? size : 0 );
+
+    return pBuffer;
+}
+
+/// @copydoc Renderer::CreateConstantBuffer()
+RConstantBuffer* HeadlessRenderer::CreateConstantBuffer( size_t size, ERendererBufferUsage usage, const void* pData )
+{
+    // Constant buffers can only be created with static or dynamic usage semantics.
+    HELIUM_ASSERT( usage == RENDERER_BUFFER_USAGE_STATIC || usage == RENDERER_BUFFER_USAGE_DYNAMIC );
+    HELIUM_UNREF( usage );
+
+    void* pBufferData = DefaultAllocator().Allocate( size );
+    HELIUM_ASSERT( pBufferData || size == 0 );
+    if( pData )
+    {
+        MemoryCopy( pBufferData, pData, size );
+    }
+
+    HeadlessConstantBuffer* pBuffer = new HeadlessConstantBuffer( pBufferData, size );
+    HELIUM_ASSERT( pBuffer );
+
+    NotifyResourceCreated( pData ? size : 0 );
+
+    return pBuffer;
+}
+
+/// @copydoc Renderer::CreateVertexDescription()
+RVertexDescription* HeadlessRenderer::CreateVertexDescription(
+    const RVertexDescription::Element* pElements,
+    size_t elementCount )
+{
+    HELIUM_ASSERT( pElements );
+    HELIUM_ASSERT( elementCount != 0 );
+
+    HeadlessVertexDescription* pDescription = new HeadlessVertexDescription( pElements, elementCount );
+    HELIUM_ASSERT( pDescription );
+
+    return pDescription;
+}
+
+/// @copydoc Renderer::CreateVertexInputLayout()
+RVertexInputLayout* HeadlessRenderer::CreateVertexInputLayout(
+    RVertexDescription* pDescription,
+    RVertexShader* /*pShader*/ )
+{
+    HELIUM_ASSERT( pDescription );
+
+    HeadlessVertexInputLayout* pLayout = new HeadlessVertexInputLayout( pDescription );
+    HELIUM_ASSERT( pLayout );
+
+    return pLayout;
+}
+
+/// @copydoc Renderer::CreateTexture2d()
+RTexture2d* HeadlessRenderer::CreateTexture2d(
+    uint32_t width,
+    uint32_t height,
+    uint32_t mipCount,
+    ERendererPixelFormat format,
+    ERendererBufferUsage usage,
+    const RTexture2d::CreateData* pData )
+{
+    HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
+    HELIUM_ASSERT( static_cast< size_t >( usage ) < static_cast< size_t >( RENDERER_BUFFER_USAGE_MAX ) );
+    HELIUM_UNREF( usage );
+
+    HeadlessTexture2d* pTexture = new HeadlessTexture2d( width, height, mipCount, format );
+    HELIUM_ASSERT( pTexture );
+
+    // Initialize the texture if an initial set of data was specified.
+    size_t uploadByteCount = 0;
+    if( pData )
+    {
+        uint32_t textureMipCount = pTexture->GetMipCount();
+        for( uint32_t mipIndex = 0; mipIndex < textureMipCount; ++mipIndex )
+        {
+            const RTexture2d::CreateData& rCreateData = pData[ mipIndex ];
+            const uint8_t* pSourceRow = static_cast< const uint8_t* >( rCreateData.pData );
+            HELIUM_ASSERT( pSourceRow );
+            size_t sourcePitch = rCreateData.pitch;
+
+            size_t destPitch = pTexture->GetPitch( mipIndex );
+            uint8_t* pDestRow = static_cast< uint8_t* >(
+                pTexture->Map( mipIndex, destPitch, RENDERER_BUFFER_MAP_HINT_DISCARD ) );
+            HELIUM_ASSERT( pDestRow );
+
+            size_t copyPitch = Min( sourcePitch, destPitch );
+
+            uint_fast32_t blockRowCount = RendererUtil::PixelToBlockRowCount( pTexture->GetHeight( mipIndex ), format );
+            for( uint_fast32_t rowIndex = 0; rowIndex < blockRowCount; ++rowIndex )
+            {
+                MemoryCopy( pDestRow, pSourceRow, copyPitch );
+                pSourceRow += sourcePitch;
+                pDestRow += destPitch;
+            }
+
+            uploadByteCount += pTexture->GetMipSize( mipIndex );
+        }
+    }
+
+    NotifyResourceCreated( uploadByteCount );
+
+    return pTexture;
+}
+
+/// @copydoc Renderer::CreateFence()
+RFence* HeadlessRenderer::CreateFence()
+{
+    HeadlessFence* pFence = new HeadlessFence;
+    HELIUM_ASSERT( pFence );
+
+    return pFence;
+}
+
+/// @copydoc Renderer::SyncFence()
+void HeadlessRenderer::SyncFence( RFence* pFence )
+{
+    // Commands are never executed asynchronously, so fences are always signaled.
+    HELIUM_ASSERT( pFence );
+    HELIUM_UNREF( pFence );
+}
+
+/// @copydoc Renderer::TrySyncFence()
+bool HeadlessRenderer::TrySyncFence( RFence* pFence )
+{
+    HELIUM_ASSERT( pFence );
+    HELIUM_UNREF( pFence );
+
+    return true;
+}
+
+/// @copydoc Renderer::GetImmediateCommandProxy()
+RRenderCommandProxy* HeadlessRenderer::GetImmediateCommandProxy()
+{
+    return m_spImmediateCommandProxy;
+}
+
+/// @copydoc Renderer::CreateDeferredCommandProxy()
+RRenderCommandProxy* HeadlessRenderer::CreateDeferredCommandProxy()
+{
+    HeadlessCommandProxy* pCommandProxy = new HeadlessCommandProxy;
+    HELIUM_ASSERT( pCommandProxy );
+
+    return pCommandProxy;
+}
+
+/// @copydoc Renderer::Flush()
+void HeadlessRenderer::Flush()
+{
+}
+
+/// Get a snapshot of the resource and frame statistics gathered since the renderer was initialized or the statistics
+/// were last reset.
+///
+/// Command statistics only include commands presented by a render context swap (see NotifySwap()).  Counters for
+/// commands issued since the last swap can be retrieved from the immediate command proxy itself.
+///
+/// @param[out] rStatistics  Resource and frame statistics.
+///
+/// @see ResetStatistics()
+void HeadlessRenderer::GetStatistics( Statistics& rStatistics ) const
+{
+    MutexScopeLock scopeLock( m_statisticsLock );
+    rStatistics = m_statistics;
+}
+
+/// Reset all resource and frame statistics.
+///
+/// @see GetStatistics()
+void HeadlessRenderer::ResetStatistics()
+{
+    MutexScopeLock scopeLock( m_statisticsLock );
+    m_statistics = Statistics();
+}
+
+/// Set the buffer to which the immediate command stream should be appended each time a frame is presented.
+///
+/// This is intended for verifying the commands issued over a number of frames.  The buffer grows with each frame
+/// presented, so capture should only be enabled for short periods.
+///
+/// @param[in] pStream  Buffer in which to capture presented commands, or null to discard them.
+void HeadlessRenderer::SetCommandStreamCapture( DynamicArray< uint8_t >* pStream )
+{
+    m_pCommandStreamCapture = pStream;
+}
+
+/// Update the resource statistics for a resource data upload.
+///
+/// This is called by headless resources when they are unmapped after writing.
+///
+/// @param[in] byteCount  Number of bytes uploaded.
+void HeadlessRenderer::NotifyUpload( size_t byteCount )
+{
+    MutexScopeLock scopeLock( m_statisticsLock );
+    m_statistics.bytesUploaded += byteCount;
+    ++m_statistics.uploadCount;
+}
+
+/// Update the frame statistics for a render context swap.
+///
+/// Each swap marks the end of a frame.  The commands issued through the immediate command proxy are added to the
+/// frame statistics (and appended to the capture buffer, if set) and then discarded, so memory usage stays flat when
+/// rendering for an extended period of time.
+///
+/// @see SetCommandStreamCapture()
+void HeadlessRenderer::NotifySwap()
+{
+    HeadlessCommandProxy::Statistics commandStatistics;
+
+    HeadlessCommandProxy* pImmediateCommandProxy = m_spImmediateCommandProxy;
+    if( pImmediateCommandProxy )
+    {
+        if( m_pCommandStreamCapture )
+        {
+            m_pCommandStreamCapture->AddArray(
+                pImmediateCommandProxy->GetStreamData(),
+                pImmediateCommandProxy->GetStreamSize() );
+        }
+
+        commandStatistics = pImmediateCommandProxy->GetStatistics();
+        pImmediateCommandProxy->Reset();
+    }
+
+    MutexScopeLock scopeLock( m_statisticsLock );
+    ++m_statistics.swapCount;
+    m_statistics.commandStatistics.Add( commandStatistics );
+}
+
+/// Create the static renderer instance as a HeadlessRenderer.
+///
+/// @return  True if the renderer was created successfully, false if not or another renderer instance already exists.
+bool HeadlessRenderer::CreateStaticInstance()
+{
+    if( sm_pInstance )
+    {
+        return false;
+    }
+
+    sm_pInstance = new HeadlessRenderer;
+    HELIUM_ASSERT( sm_pInstance );
+
+    return ( sm_pInstance != NULL );
+}
+
+/// Update the resource statistics for a newly created buffer or texture.
+///
+/// @param[in] uploadByteCount  Number of bytes of initial data uploaded when creating the resource, or zero if the
+///                             resource was created without any initial data.
+void HeadlessRenderer::NotifyResourceCreated( size_t uploadByteCount )
+{
+    MutexScopeLock scopeLock( m_statisticsLock );
+    ++m_statistics.resourceCount;
+    if( uploadByteCount != 0 )
+    {
+        m_statistics.bytesUploaded += uploadByteCount;
+        ++m_statistics.uploadCount;
+    }
+}
@@ -0,0 +1,159 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessRenderer.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_RENDERER_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_RENDERER_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/Renderer.h"
+
+#include "RenderingHeadless/HeadlessCommandProxy.h"
+
+#include "Platform/Locks.h"
+
+namespace Helium
+{
+    HELIUM_DECLARE_RPTR( HeadlessCommandProxy );
+    HELIUM_DECLARE_RPTR( HeadlessRenderContext );
+
+    /// Renderer implementation that runs entirely on the CPU without any display or GPU device.
+    ///
+    /// All resources are backed by system memory, and all command proxies record the commands issued through them
+    /// into a compact command stream instead of executing them (see HeadlessCommandProxy).  This allows the full
+    /// frame rendering path to be run, profiled, and verified on systems without graphics hardware.
+    class HELIUM_RENDERING_HEADLESS_API HeadlessRenderer : public Renderer
+    {
+    public:
+        /// Renderer-wide resource and frame statistics.
+        struct Statistics
+        {
+            /// Number of bytes of resource data uploaded, either on resource creation or when unmapping a resource.
+            uint64_t bytesUploaded;
+            /// Number of resource data uploads.
+            uint32_t uploadCount;
+            /// Number of buffer and texture resources created.
+            uint32_t resourceCount;
+            /// Number of render context swaps (frames presented).
+            uint32_t swapCount;
+            /// Counters for the commands issued through the immediate command proxy and presented by each swap.
+            HeadlessCommandProxy::Statistics commandStatistics;
+
+            /// @name Construction/Destruction
+            //@{
+            inline Statistics();
+            //@}
+        };
+
+        /// @name Initialization
+        //@{
+        bool Initialize();
+        void Shutdown();
+        //@}
+
+        /// @name Display Initialization
+        //@{
+        bool CreateMainContext( const ContextInitParameters& rInitParameters );
+        bool ResetMainContext( const ContextInitParameters& rInitParameters );
+        RRenderContext* GetMainContext();
+
+        RRenderContext* CreateSubContext( const ContextInitParameters& rInitParameters );
+
+        EStatus GetStatus();
+        EStatus Reset();
+        //@}
+
+        /// @name State Object Creation
+        //@{
+        RRasterizerState* CreateRasterizerState( const RRasterizerState::Description& rDescription );
+        RBlendState* CreateBlendState( const RBlendState::Description& rDescription );
+        RDepthStencilState* CreateDepthStencilState( const RDepthStencilState::Description& rDescription );
+        RSamplerState* CreateSamplerState( const RSamplerState::Description& rDescription );
+        //@}
+
+        /// @name Resource Allocation
+        //@{
+        RSurface* CreateDepthStencilSurface(
+            uint32_t width, uint32_t height, ERendererSurfaceFormat format, uint32_t multisampleCount );
+
+        RVertexShader* CreateVertexShader( size_t size, const void* pData );
+        RPixelShader* CreatePixelShader( size_t size, const void* pData );
+
+        RVertexBuffer* CreateVertexBuffer( size_t size, ERendererBufferUsage usage, const void* pData );
+        RIndexBuffer* CreateIndexBuffer(
+            size_t size, ERendererBufferUsage usage, ERendererIndexFormat format, const void* pData );
+        RConstantBuffer* CreateConstantBuffer( size_t size, ERendererBufferUsage usage, const void* pData );
+
+        RVertexDescription* CreateVertexDescription( const RVertexDescription::Element* pElements, size_t elementCount );
+        RVertexInputLayout* CreateVertexInputLayout( RVertexDescription* pDescription, RVertexShader* pShader );
+
+        RTexture2d* CreateTexture2d(
+            uint32_t width, uint32_t height, uint32_t mipCount, ERendererPixelFormat format, ERendererBufferUsage usage,
+            const RTexture2d::CreateData* pData );
+        //@}
+
+        /// @name Deferred Query Allocation
+        //@{
+        RFence* CreateFence();
+        void SyncFence( RFence* pFence );
+        bool TrySyncFence( RFence* pFence );
+        //@}
+
+        /// @name Command Interfaces
+        //@{
+        RRenderCommandProxy* GetImmediateCommandProxy();
+        RRenderCommandProxy* CreateDeferredCommandProxy();
+
+        void Flush();
+        //@}
+
+        /// @name Statistics
+        //@{
+        void GetStatistics( Statistics& rStatistics ) const;
+        void ResetStatistics();
+
+        void SetCommandStreamCapture( DynamicArray< uint8_t >* pStream );
+
+        void NotifyUpload( size_t byteCount );
+        void NotifySwap();
+        //@}
+
+        /// @name Static Initialization
+        //@{
+        static bool CreateStaticInstance();
+        //@}
+
+    private:
+        /// Main rendering context.
+        HeadlessRenderContextPtr m_spMainContext;
+        /// Immediate render command proxy.
+        HeadlessCommandProxyPtr m_spImmediateCommandProxy;
+        /// Buffer to which the immediate command stream is appended on each swap (null to discard presented commands).
+        DynamicArray< uint8_t >* m_pCommandStreamCapture;
+
+        /// Resource statistics.
+        Statistics m_statistics;
+        /// Synchronization lock for updating resource statistics (resources may be created and mapped from loading
+        /// threads).
+        mutable Mutex m_statisticsLock;
+
+        /// @name Construction/Destruction
+        //@{
+        HeadlessRenderer();
+        virtual ~HeadlessRenderer();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        void NotifyResourceCreated( size_t uploadByteCount );
+        //@}
+    };
+}
+
+#include "RenderingHeadless/HeadlessRenderer.inl"
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_RENDERER_H
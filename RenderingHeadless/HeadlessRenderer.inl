@@ -0,0 +1,18 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessRenderer.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Constructor.
+    HeadlessRenderer::Statistics::Statistics()
+        : bytesUploaded( 0 )
+        , uploadCount( 0 )
+        , resourceCount( 0 )
+        , swapCount( 0 )
+    {
+    }
+}
@@ -0,0 +1,67 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessShader.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_SHADER_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_SHADER_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RVertexShader.h"
+#include "Rendering/RPixelShader.h"
+
+#include "Platform/MemoryHeap.h"
+
+namespace Helium
+{
+    /// Shader implementation for the headless renderer.
+    ///
+    /// Shader byte code is kept in system memory as-is, as it is never compiled for a device.  The same implementation
+    /// is shared by both the vertex and pixel shader interfaces.
+    template< typename ShaderBase >
+    class HeadlessShader : public ShaderBase
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        HeadlessShader( void* pData, size_t size, bool bStaging );
+        //@}
+
+        /// @name Loading
+        //@{
+        void* Lock();
+        bool Unlock();
+        //@}
+
+        /// @name Data Access
+        //@{
+        const void* GetData() const;
+        size_t GetSize() const;
+        //@}
+
+    private:
+        /// Shader byte code, allocated using DefaultAllocator.
+        void* m_pData;
+        /// Size of the shader byte code, in bytes.
+        size_t m_size;
+        /// True if the shader data is still a staging area waiting to be filled in, false if it has been loaded.
+        bool m_bStaging;
+
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessShader();
+        //@}
+    };
+
+    /// Headless vertex shader.
+    typedef HeadlessShader< RVertexShader > HeadlessVertexShader;
+    /// Headless pixel shader.
+    typedef HeadlessShader< RPixelShader > HeadlessPixelShader;
+}
+
+#include "RenderingHeadless/HeadlessShader.inl"
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_SHADER_H
@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessShader.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Constructor.
+    ///
+    /// @param[in] pData     Shader data allocated using DefaultAllocator.  This object will assume ownership of the
+    ///                      buffer memory once it has been constructed.
+    /// @param[in] size      Size of the shader data, in bytes.
+    /// @param[in] bStaging  True if the shader data is a staging area that still needs to be filled in using Lock()
+    ///                      and Unlock(), false if it already contains the shader byte code.
+    template< typename ShaderBase >
+    HeadlessShader< ShaderBase >::HeadlessShader( void* pData, size_t size, bool bStaging )
+        : m_pData( pData )
+        , m_size( size )
+        , m_bStaging( bStaging )
+    {
+        HELIUM_ASSERT( pData || size == 0 );
+    }
+
+    /// Destructor.
+    template< typename ShaderBase >
+    HeadlessShader< ShaderBase >::~HeadlessShader()
+    {
+        DefaultAllocator().Free( m_pData );
+    }
+
+    /// @copydoc RShader::Lock()
+    template< typename ShaderBase >
+    void* HeadlessShader< ShaderBase >::Lock()
+    {
+        if( !m_bStaging )
+        {
+            HELIUM_TRACE( TraceLevels::Error, TXT( "HeadlessShader::Lock(): Shader has already been loaded.\n" ) );
+
+            return NULL;
+        }
+
+        return m_pData;
+    }
+
+    /// @copydoc RShader::Unlock()
+    template< typename ShaderBase >
+    bool HeadlessShader< ShaderBase >::Unlock()
+    {
+        if( !m_bStaging )
+        {
+            HELIUM_TRACE( TraceLevels::Error, TXT( "HeadlessShader::Unlock(): Shader has already been loaded.\n" ) );
+
+            return false;
+        }
+
+        m_bStaging = false;
+
+        return true;
+    }
+
+    /// Get the shader byte code.
+    ///
+    /// @return  Shader data.
+    ///
+    /// @see GetSize()
+    template< typename ShaderBase >
+    const void* HeadlessShader< ShaderBase >::GetData() const
+    {
+        return m_pData;
+    }
+
+    /// Get the size of the shader byte code.
+    ///
+    /// @return  Shader data size, in bytes.
+    ///
+    /// @see GetData()
+    template< typename ShaderBase >
+    size_t HeadlessShader< ShaderBase >::GetSize() const
+    {
+        return m_size;
+    }
+}
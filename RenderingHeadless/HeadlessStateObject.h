@@ -0,0 +1,63 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessStateObject.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_STATE_OBJECT_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_STATE_OBJECT_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RRasterizerState.h"
+#include "Rendering/RBlendState.h"
+#include "Rendering/RDepthStencilState.h"
+#include "Rendering/RSamplerState.h"
+
+namespace Helium
+{
+    /// State object implementation for the headless renderer.
+    ///
+    /// State objects simply store the description with which they were created, so the same implementation is shared
+    /// by all state object interfaces.
+    template< typename StateBase >
+    class HeadlessStateObject : public StateBase
+    {
+    public:
+        /// State description type.
+        typedef typename StateBase::Description Description;
+
+        /// @name Construction/Destruction
+        //@{
+        explicit HeadlessStateObject( const Description& rDescription );
+        //@}
+
+        /// @name State Information
+        //@{
+        void GetDescription( Description& rDescription ) const;
+        //@}
+
+    private:
+        /// State description.
+        Description m_description;
+
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessStateObject();
+        //@}
+    };
+
+    /// Headless rasterizer state.
+    typedef HeadlessStateObject< RRasterizerState > HeadlessRasterizerState;
+    /// Headless blend state.
+    typedef HeadlessStateObject< RBlendState > HeadlessBlendState;
+    /// Headless depth-stencil state.
+    typedef HeadlessStateObject< RDepthStencilState > HeadlessDepthStencilState;
+    /// Headless sampler state.
+    typedef HeadlessStateObject< RSamplerState > HeadlessSamplerState;
+}
+
+#include "RenderingHeadless/HeadlessStateObject.inl"
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_STATE_OBJECT_H
@@ -0,0 +1,33 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessStateObject.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Constructor.
+    ///
+    /// @param[in] rDescription  State description.
+    template< typename StateBase >
+    HeadlessStateObject< StateBase >::HeadlessStateObject( const Description& rDescription )
+        : m_description( rDescription )
+    {
+    }
+
+    /// Destructor.
+    template< typename StateBase >
+    HeadlessStateObject< StateBase >::~HeadlessStateObject()
+    {
+    }
+
+    /// Get the description of this state object.
+    ///
+    /// @param[out] rDescription  State description.
+    template< typename StateBase >
+    void HeadlessStateObject< StateBase >::GetDescription( Description& rDescription ) const
+    {
+        rDescription = m_description;
+    }
+}
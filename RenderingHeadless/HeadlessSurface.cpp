@@ -0,0 +1,26 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessSurface.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "RenderingHeadlessPch.h"
+#include "RenderingHeadless/HeadlessSurface.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] width   Surface width, in pixels.
+/// @param[in] height  Surface height, in pixels.
+HeadlessSurface::HeadlessSurface( uint32_t width, uint32_t height )
+    : m_width( width )
+    , m_height( height )
+{
+}
+
+/// Destructor.
+HeadlessSurface::~HeadlessSurface()
+{
+}
@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessSurface.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_SURFACE_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_SURFACE_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RSurface.h"
+
+namespace Helium
+{
+    /// Render surface for the headless renderer.
+    ///
+    /// Nothing is ever rendered, so surfaces do not have any backing storage and only track their dimensions.
+    class HeadlessSurface : public RSurface
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        HeadlessSurface( uint32_t width, uint32_t height );
+        //@}
+
+        /// @name Data Access
+        //@{
+        inline uint32_t GetWidth() const;
+        inline uint32_t GetHeight() const;
+        //@}
+
+    private:
+        /// Surface width, in pixels.
+        uint32_t m_width;
+        /// Surface height, in pixels.
+        uint32_t m_height;
+
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessSurface();
+        //@}
+    };
+}
+
+#include "RenderingHeadless/HeadlessSurface.inl"
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_SURFACE_H
@@ -0,0 +1,29 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessSurface.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get the width of this surface.
+    ///
+    /// @return  Surface width, in pixels.
+    ///
+    /// @see GetHeight()
+    uint32_t HeadlessSurface::GetWidth() const
+    {
+        return m_width;
+    }
+
+    /// Get the height of this surface.
+    ///
+    /// @return  Surface height, in pixels.
+    ///
+    /// @see GetWidth()
+    uint32_t HeadlessSurface::GetHeight() const
+    {
+        return m_height;
+    }
+}
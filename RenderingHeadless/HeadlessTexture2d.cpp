@@ -0,0 +1,175 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessTexture2d.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "RenderingHeadlessPch.h"
+#include "RenderingHeadless/HeadlessTexture2d.h"
+
+#include "Rendering/RendererUtil.h"
+#include "RenderingHeadless/HeadlessSurface.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// The texture data is allocated upon construction, but left uninitialized.
+///
+/// @param[in] width     Width of the top mip level, in pixels.
+/// @param[in] height    Height of the top mip level, in pixels.
+/// @param[in] mipCount  Number of mip levels, or zero to allocate the full mip chain.
+/// @param[in] format    Pixel format.
+HeadlessTexture2d::HeadlessTexture2d( uint32_t width, uint32_t height, uint32_t mipCount, ERendererPixelFormat format )
+    : m_pData( NULL )
+    , m_dataSize( 0 )
+    , m_width( width )
+    , m_height( height )
+    , m_format( format )
+{
+    HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
+
+    // Number of bytes per pixel for uncompressed formats, or bytes per 4x4 block for block-compressed formats.
+    static const size_t BYTES_PER_BLOCK[] =
+    {
+        4,   // RENDERER_PIXEL_FORMAT_R8G8B8A8
+        4,   // RENDERER_PIXEL_FORMAT_R8G8B8A8_SRGB
+        1,   // RENDERER_PIXEL_FORMAT_R8
+        8,   // RENDERER_PIXEL_FORMAT_BC1
+        8,   // RENDERER_PIXEL_FORMAT_BC1_SRGB
+        16,  // RENDERER_PIXEL_FORMAT_BC2
+        16,  // RENDERER_PIXEL_FORMAT_BC2_SRGB
+        16,  // RENDERER_PIXEL_FORMAT_BC3
+        16,  // RENDERER_PIXEL_FORMAT_BC3_SRGB
+        8,   // RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT
+        4    // RENDERER_PIXEL_FORMAT_DEPTH
+    };
+
+    HELIUM_COMPILE_ASSERT( HELIUM_ARRAY_COUNT( BYTES_PER_BLOCK ) == RENDERER_PIXEL_FORMAT_MAX );
+
+    if( mipCount == 0 )
+    {
+        mipCount = GetFullMipCount( width, height );
+    }
+
+    size_t bytesPerBlock = BYTES_PER_BLOCK[ format ];
+
+    // Lay out each mip level.  Blocks are square, so the pixel-to-block row conversion also gives us the number of
+    // block columns.
+    m_mipLevels.Resize( mipCount );
+
+    uint32_t mipWidth = width;
+    uint32_t mipHeight = height;
+    for( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+    {
+        MipLevel& rMipLevel = m_mipLevels[ mipIndex ];
+        rMipLevel.offset = m_dataSize;
+        rMipLevel.pitch = RendererUtil::PixelToBlockRowCount( mipWidth, format ) * bytesPerBlock;
+        rMipLevel.size = rMipLevel.pitch * RendererUtil::PixelToBlockRowCount( mipHeight, format );
+
+        m_dataSize += rMipLevel.size;
+
+        mipWidth = Max< uint32_t >( mipWidth / 2, 1 );
+        mipHeight = Max< uint32_t >( mipHeight / 2, 1 );
+    }
+
+    if( m_dataSize != 0 )
+    {
+        m_pData = static_cast< uint8_t* >( DefaultAllocator().Allocate( m_dataSize ) );
+        HELIUM_ASSERT( m_pData );
+    }
+}
+
+/// Destructor.
+HeadlessTexture2d::~HeadlessTexture2d()
+{
+    DefaultAllocator().Free( m_pData );
+}
+
+/// @copydoc RTexture::GetMipCount()
+uint32_t HeadlessTexture2d::GetMipCount() const
+{
+    return static_cast< uint32_t >( m_mipLevels.GetSize() );
+}
+
+/// @copydoc RTexture2d::Map()
+void* HeadlessTexture2d::Map( uint32_t mipLevel, size_t& rPitch, ERendererBufferMapHint /*hint*/ )
+{
+    HELIUM_ASSERT( mipLevel < m_mipLevels.GetSize() );
+
+    const MipLevel& rMipLevel = m_mipLevels[ mipLevel ];
+    rPitch = rMipLevel.pitch;
+
+    return m_pData + rMipLevel.offset;
+}
+
+/// @copydoc RTexture2d::Unmap()
+void HeadlessTexture2d::Unmap( uint32_t mipLevel )
+{
+    HELIUM_ASSERT( mipLevel < m_mipLevels.GetSize() );
+
+    HeadlessRenderer* pRenderer = static_cast< HeadlessRenderer* >( Renderer::GetStaticInstance() );
+    HELIUM_ASSERT( pRenderer );
+    pRenderer->NotifyUpload( m_mipLevels[ mipLevel ].size );
+}
+
+/// @copydoc RTexture2d::CanMapWholeResource()
+bool HeadlessTexture2d::CanMapWholeResource() const
+{
+    return true;
+}
+
+/// @copydoc RTexture2d::GetWidth()
+uint32_t HeadlessTexture2d::GetWidth( uint32_t mipLevel ) const
+{
+    HELIUM_ASSERT( mipLevel < m_mipLevels.GetSize() );
+
+    return Max< uint32_t >( m_width >> mipLevel, 1 );
+}
+
+/// @copydoc RTexture2d::GetHeight()
+uint32_t HeadlessTexture2d::GetHeight( uint32_t mipLevel ) const
+{
+    HELIUM_ASSERT( mipLevel < m_mipLevels.GetSize() );
+
+    return Max< uint32_t >( m_height >> mipLevel, 1 );
+}
+
+/// @copydoc RTexture2d::GetPixelFormat()
+ERendererPixelFormat HeadlessTexture2d::GetPixelFormat() const
+{
+    return m_format;
+}
+
+/// @copydoc RTexture2d::GetSurface()
+RSurface* HeadlessTexture2d::GetSurface( uint32_t mipLevel )
+{
+    HELIUM_ASSERT( mipLevel < m_mipLevels.GetSize() );
+
+    MipLevel& rMipLevel = m_mipLevels[ mipLevel ];
+    if( !rMipLevel.spSurface )
+    {
+        rMipLevel.spSurface = new HeadlessSurface( GetWidth( mipLevel ), GetHeight( mipLevel ) );
+        HELIUM_ASSERT( rMipLevel.spSurface );
+    }
+
+    return rMipLevel.spSurface;
+}
+
+/// Get the number of mip levels in a full mip chain for a texture of the given size.
+///
+/// @param[in] width   Width of the top mip level, in pixels.
+/// @param[in] height  Height of the top mip level, in pixels.
+///
+/// @return  Number of mip levels down to and including the 1x1 mip level.
+uint32_t HeadlessTexture2d::GetFullMipCount( uint32_t width, uint32_t height )
+{
+    uint32_t mipCount = 1;
+    for( uint32_t size = Max( width, height ); size > 1; size /= 2 )
+    {
+        ++mipCount;
+    }
+
+    return mipCount;
+}
@@ -0,0 +1,97 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessTexture2d.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_TEXTURE_2D_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_TEXTURE_2D_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RTexture2d.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+    HELIUM_DECLARE_RPTR( HeadlessSurface );
+
+    /// System memory 2D texture implementation for the headless renderer.
+    ///
+    /// All mip levels are stored contiguously in a single allocation, with each row of pixels (or blocks, for
+    /// block-compressed formats) tightly packed.
+    class HeadlessTexture2d : public RTexture2d
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        HeadlessTexture2d( uint32_t width, uint32_t height, uint32_t mipCount, ERendererPixelFormat format );
+        //@}
+
+        /// @name Base Texture Information
+        //@{
+        uint32_t GetMipCount() const;
+        //@}
+
+        /// @name Data Access
+        //@{
+        void* Map( uint32_t mipLevel, size_t& rPitch, ERendererBufferMapHint hint );
+        void Unmap( uint32_t mipLevel );
+        bool CanMapWholeResource() const;
+
+        uint32_t GetWidth( uint32_t mipLevel ) const;
+        uint32_t GetHeight( uint32_t mipLevel ) const;
+        ERendererPixelFormat GetPixelFormat() const;
+
+        RSurface* GetSurface( uint32_t mipLevel );
+
+        inline size_t GetPitch( uint32_t mipLevel ) const;
+        inline size_t GetMipSize( uint32_t mipLevel ) const;
+        inline size_t GetDataSize() const;
+        //@}
+
+        /// @name Static Utility Functions
+        //@{
+        static uint32_t GetFullMipCount( uint32_t width, uint32_t height );
+        //@}
+
+    private:
+        /// Mip level information.
+        struct MipLevel
+        {
+            /// Byte offset of the mip level data from the start of the texture data.
+            size_t offset;
+            /// Number of bytes per row of pixels or blocks.
+            size_t pitch;
+            /// Total size of the mip level data, in bytes.
+            size_t size;
+            /// Render surface for the mip level (created on first access).
+            HeadlessSurfacePtr spSurface;
+        };
+
+        /// Texture data for all mip levels.
+        uint8_t* m_pData;
+        /// Total size of the texture data, in bytes.
+        size_t m_dataSize;
+        /// Mip level information.
+        DynamicArray< MipLevel > m_mipLevels;
+
+        /// Width of the top mip level, in pixels.
+        uint32_t m_width;
+        /// Height of the top mip level, in pixels.
+        uint32_t m_height;
+        /// Pixel format.
+        ERendererPixelFormat m_format;
+
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessTexture2d();
+        //@}
+    };
+}
+
+#include "RenderingHeadless/HeadlessTexture2d.inl"
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_TEXTURE_2D_H
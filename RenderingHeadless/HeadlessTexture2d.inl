@@ -0,0 +1,47 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessTexture2d.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get the number of bytes per row of pixels (or blocks, for block-compressed formats) in a given mip level.
+    ///
+    /// @param[in] mipLevel  Mip level.
+    ///
+    /// @return  Mip level pitch, in bytes.
+    ///
+    /// @see GetMipSize()
+    size_t HeadlessTexture2d::GetPitch( uint32_t mipLevel ) const
+    {
+        HELIUM_ASSERT( mipLevel < m_mipLevels.GetSize() );
+
+        return m_mipLevels[ mipLevel ].pitch;
+    }
+
+    /// Get the total size of a given mip level.
+    ///
+    /// @param[in] mipLevel  Mip level.
+    ///
+    /// @return  Mip level size, in bytes.
+    ///
+    /// @see GetPitch(), GetDataSize()
+    size_t HeadlessTexture2d::GetMipSize( uint32_t mipLevel ) const
+    {
+        HELIUM_ASSERT( mipLevel < m_mipLevels.GetSize() );
+
+        return m_mipLevels[ mipLevel ].size;
+    }
+
+    /// Get the total size of the texture data for all mip levels.
+    ///
+    /// @return  Texture data size, in bytes.
+    ///
+    /// @see GetMipSize()
+    size_t HeadlessTexture2d::GetDataSize() const
+    {
+        return m_dataSize;
+    }
+}
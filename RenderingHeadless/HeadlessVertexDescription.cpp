@@ -0,0 +1,26 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessVertexDescription.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "RenderingHeadlessPch.h"
+#include "RenderingHeadless/HeadlessVertexDescription.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] pElements     Array of vertex elements.
+/// @param[in] elementCount  Number of elements in the vertex element array.
+HeadlessVertexDescription::HeadlessVertexDescription( const Element* pElements, size_t elementCount )
+{
+    HELIUM_ASSERT( pElements || elementCount == 0 );
+    m_elements.AddArray( pElements, elementCount );
+}
+
+/// Destructor.
+HeadlessVertexDescription::~HeadlessVertexDescription()
+{
+}
@@ -0,0 +1,47 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessVertexDescription.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_VERTEX_DESCRIPTION_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_VERTEX_DESCRIPTION_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RVertexDescription.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+    /// Vertex description implementation for the headless renderer.
+    class HeadlessVertexDescription : public RVertexDescription
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        HeadlessVertexDescription( const Element* pElements, size_t elementCount );
+        //@}
+
+        /// @name Data Access
+        //@{
+        inline const Element* GetElements() const;
+        inline size_t GetElementCount() const;
+        //@}
+
+    private:
+        /// Vertex elements.
+        DynamicArray< Element > m_elements;
+
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessVertexDescription();
+        //@}
+    };
+}
+
+#include "RenderingHeadless/HeadlessVertexDescription.inl"
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_VERTEX_DESCRIPTION_H
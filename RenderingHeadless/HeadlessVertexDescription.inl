@@ -0,0 +1,29 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessVertexDescription.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get the vertex elements in this description.
+    ///
+    /// @return  Vertex element array.
+    ///
+    /// @see GetElementCount()
+    const RVertexDescription::Element* HeadlessVertexDescription::GetElements() const
+    {
+        return m_elements.GetData();
+    }
+
+    /// Get the number of vertex elements in this description.
+    ///
+    /// @return  Vertex element count.
+    ///
+    /// @see GetElements()
+    size_t HeadlessVertexDescription::GetElementCount() const
+    {
+        return m_elements.GetSize();
+    }
+}
@@ -0,0 +1,25 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessVertexInputLayout.cpp
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "RenderingHeadlessPch.h"
+#include "RenderingHeadless/HeadlessVertexInputLayout.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] pDescription  Vertex description from which this layout is created.
+HeadlessVertexInputLayout::HeadlessVertexInputLayout( RVertexDescription* pDescription )
+    : m_spDescription( pDescription )
+{
+    HELIUM_ASSERT( pDescription );
+}
+
+/// Destructor.
+HeadlessVertexInputLayout::~HeadlessVertexInputLayout()
+{
+}
@@ -0,0 +1,47 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessVertexInputLayout.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_HEADLESS_VERTEX_INPUT_LAYOUT_H
+#define HELIUM_RENDERING_HEADLESS_HEADLESS_VERTEX_INPUT_LAYOUT_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+#include "Rendering/RVertexInputLayout.h"
+#include "Rendering/RVertexDescription.h"
+
+namespace Helium
+{
+    HELIUM_DECLARE_RPTR( RVertexDescription );
+
+    /// Vertex input layout implementation for the headless renderer.
+    class HeadlessVertexInputLayout : public RVertexInputLayout
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        HeadlessVertexInputLayout( RVertexDescription* pDescription );
+        //@}
+
+        /// @name Data Access
+        //@{
+        inline RVertexDescription* GetDescription() const;
+        //@}
+
+    private:
+        /// Vertex description from which this layout was created.
+        RVertexDescriptionPtr m_spDescription;
+
+        /// @name Construction/Destruction
+        //@{
+        ~HeadlessVertexInputLayout();
+        //@}
+    };
+}
+
+#include "RenderingHeadless/HeadlessVertexInputLayout.inl"
+
+#endif  // HELIUM_RENDERING_HEADLESS_HEADLESS_VERTEX_INPUT_LAYOUT_H
@@ -0,0 +1,17 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessVertexInputLayout.inl
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace Helium
+{
+    /// Get the vertex description from which this layout was created.
+    ///
+    /// @return  Vertex description.
+    RVertexDescription* HeadlessVertexInputLayout::GetDescription() const
+    {
+        return m_spDescription;
+    }
+}
@@ -0,0 +1,24 @@
+//----------------------------------------------------------------------------------------------------------------------
+// RenderingHeadless.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_RENDERING_HEADLESS_H
+#define HELIUM_RENDERING_HEADLESS_RENDERING_HEADLESS_H
+
+#include "Platform/System.h"
+
+#if HELIUM_SHARED
+    #ifdef HELIUM_RENDERING_HEADLESS_EXPORTS
+        #define HELIUM_RENDERING_HEADLESS_API HELIUM_API_EXPORT
+    #else
+        #define HELIUM_RENDERING_HEADLESS_API HELIUM_API_IMPORT
+    #endif
+#else
+    #define HELIUM_RENDERING_HEADLESS_API
+#endif
+
+#endif  // HELIUM_RENDERING_HEADLESS_RENDERING_HEADLESS_H
@@ -0,0 +1,10 @@
+#include "RenderingHeadlessPch.h"
+
+#include "Platform/MemoryHeap.h"
+
+// Define the memory heap for the current module and include the "new"/"delete" operator implementations.
+HELIUM_DEFINE_DEFAULT_MODULE_HEAP( RenderingHeadless );
+
+#if HELIUM_DEBUG
+#include "Platform/NewDelete.h"
+#endif
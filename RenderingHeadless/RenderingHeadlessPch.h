@@ -0,0 +1,19 @@
+//----------------------------------------------------------------------------------------------------------------------
+// RenderingHeadlessPch.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+#ifndef HELIUM_RENDERING_HEADLESS_RENDERING_HEADLESS_PCH_H
+#define HELIUM_RENDERING_HEADLESS_RENDERING_HEADLESS_PCH_H
+
+#include "RenderingHeadless/RenderingHeadless.h"
+
+#include "Platform/Assert.h"
+#include "Platform/Trace.h"
+#include "Platform/MemoryHeap.h"
+#include "RenderingHeadless/HeadlessRenderer.h"
+
+#endif  // HELIUM_RENDERING_HEADLESS_RENDERING_HEADLESS_PCH_H
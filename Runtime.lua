@@ -89,6 +89,7 @@ project( prefix .. "ExampleMain" )
 		prefix .. "EngineJobs",
 		prefix .. "Windowing",
 		prefix .. "Rendering",
+		prefix .. "RenderingHeadless",
 		prefix .. "GraphicsTypes",
 		prefix .. "GraphicsJobs",
 		prefix .. "Graphics",
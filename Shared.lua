@@ -161,6 +161,26 @@ project( prefix .. "Engine" )
 		"Dependencies/boost-preprocessor/include",
 	}
 
+	configuration "windows"
+		excludes
+		{
+			"Engine/*Posix.*",
+			"Engine/*Lin.*",
+		}
+
+	configuration "macosx"
+		excludes
+		{
+			"Engine/*Win.*",
+			"Engine/*Lin.*",
+		}
+
+	configuration "linux"
+		excludes
+		{
+			"Engine/*Win.*",
+		}
+
 	configuration "SharedLib"
 		links
 		{
@@ -253,6 +273,34 @@ project( prefix .. "Rendering" )
 			prefix .. "EngineJobs",
 		}
 
+project( prefix .. "RenderingHeadless" )
+	uuid "C0F61639-F0FB-4A47-A307-C79B2AEF399D"
+
+	Helium.DoModuleProjectSettings( ".", "HELIUM", "RenderingHeadless", "RENDERING_HEADLESS" )
+
+	files
+	{
+		"RenderingHeadless/*",
+	}
+
+	includedirs
+	{
+		"Dependencies/boost-preprocessor/include",
+	}
+
+	configuration "SharedLib"
+		links
+		{
+			prefix .. "Platform",
+			prefix .. "Foundation",
+			prefix .. "Reflect",
+			prefix .. "Math",
+			prefix .. "MathSimd",
+			prefix .. "Engine",
+			prefix .. "EngineJobs",
+			prefix .. "Rendering",
+		}
+
 project( prefix .. "GraphicsTypes" )
 	uuid "4A13A4F6-6860-4F52-A217-B0C3943E7025"
 
@@ -510,6 +558,7 @@ project( prefix .. "Framework" )
 			prefix .. "EngineJobs",
 			prefix .. "Windowing",
 			prefix .. "Rendering",
+			prefix .. "RenderingHeadless",
 			prefix .. "GraphicsTypes",
 			prefix .. "GraphicsJobs",
 			prefix .. "Graphics",
@@ -851,6 +900,7 @@ project( prefix .. "TestApp" )-- DEPRECATED
 		prefix .. "EngineJobs",
 		prefix .. "Windowing",
 		prefix .. "Rendering",
+		prefix .. "RenderingHeadless",
 		prefix .. "GraphicsTypes",
 		prefix .. "GraphicsJobs",
 		prefix .. "Graphics",
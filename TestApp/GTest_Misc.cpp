@@ -1,5 +1,7 @@
 
 #include "TestAppPch.h"
+#include "HeadlessTestScene.h"
+#include "TestGameObject.h"
 
 using namespace Helium;
 
@@ -392,3 +394,1443 @@ TEST(Engine, PackageObjectTest)
         HELIUM_UNREF( pTestObjectCast );
     }
 }
+
+TEST(Engine, LinkDependencyLoad)
+{
+    // TestObject2 references TestObject3 in the same package, so it can only finish loading once TestObject3 has been
+    // loaded and linked into its properties.
+    GameObjectPath objectPath;
+    HELIUM_VERIFY( objectPath.Set(
+        HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "EngineTest" ) HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "ChildPackage" )
+        HELIUM_OBJECT_PATH_CHAR_STRING TXT( "TestObject2" ) ) );
+
+    GameObjectPath referencePath;
+    HELIUM_VERIFY( referencePath.Set(
+        HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "EngineTest" ) HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "ChildPackage" )
+        HELIUM_OBJECT_PATH_CHAR_STRING TXT( "TestObject3" ) ) );
+
+    size_t loadId = gObjectLoader->BeginLoadObject( objectPath );
+    HELIUM_ASSERT( IsValid( loadId ) );
+
+    GameObjectPtr spObject;
+    while( !gObjectLoader->TryFinishLoad( loadId, spObject ) )
+    {
+        gObjectLoader->Tick();
+        Thread::Yield();
+    }
+
+    TestGameObject2* pObject = Reflect::SafeCast< TestGameObject2 >( spObject.Get() );
+    HELIUM_ASSERT( pObject );
+    HELIUM_ASSERT( pObject->IsFullyLoaded() );
+    HELIUM_ASSERT( pObject->GetPath() == objectPath );
+    HELIUM_ASSERT( pObject->m_TestValue1 == 240.0f );
+
+    // Loading the referenced object again should return the same instance that was linked into the first object.
+    GameObjectPtr spReference;
+    HELIUM_VERIFY( gObjectLoader->LoadObject( referencePath, spReference ) );
+    TestGameObject3* pReference = Reflect::SafeCast< TestGameObject3 >( spReference.Get() );
+    HELIUM_ASSERT( pReference );
+    HELIUM_ASSERT( pReference->IsFullyLoaded() );
+    HELIUM_ASSERT( pReference->m_TestValue1 == 320.0f );
+    HELIUM_ASSERT( pReference->m_TestValue2 == 240.0f );
+
+    HELIUM_ASSERT( pObject->m_TestReference.Get() == pReference );
+    HELIUM_ASSERT( pObject->m_TestDeepCopy );
+    HELIUM_ASSERT( pObject->m_TestDeepCopy->m_TestValue1 == pReference->m_TestValue1 );
+    HELIUM_ASSERT( pObject->m_TestDeepCopy->m_TestValue2 == pReference->m_TestValue2 );
+    HELIUM_UNREF( pObject );
+    HELIUM_UNREF( pReference );
+}
+
+static void BenchmarkCopyPlan( const GameObjectType* pType, size_t iterationCount )
+{
+    HELIUM_ASSERT( pType );
+    HELIUM_ASSERT( iterationCount != 0 );
+
+    GameObject* pTemplate = pType->GetTemplate();
+    HELIUM_ASSERT( pTemplate );
+
+    GameObjectPtr spObject;
+    HELIUM_VERIFY( GameObject::CreateObject( spObject, pType, Name( TXT( "CopyPlanTest" ) ), NULL, NULL, true ) );
+    HELIUM_ASSERT( spObject );
+
+    const GameObjectCopyPlan* pPlan = pType->GetCopyPlan();
+    HELIUM_ASSERT( pPlan );
+    HELIUM_ASSERT( pPlan->GetComposite() == pType->GetClass() );
+    HELIUM_ASSERT( pPlan->GetOperationCount() <= pPlan->GetFieldCount() );
+
+    // Copy field-by-field through Reflect.
+    uint64_t startTickCount = Timer::GetTickCount();
+    for( size_t iterationIndex = 0; iterationIndex < iterationCount; ++iterationIndex )
+    {
+        pTemplate->Reflect::Object::CopyTo( spObject );
+    }
+
+    uint64_t reflectTickCount = Timer::GetTickCount() - startTickCount;
+
+    // Copy using the type's copy plan.
+    startTickCount = Timer::GetTickCount();
+    for( size_t iterationIndex = 0; iterationIndex < iterationCount; ++iterationIndex )
+    {
+        pTemplate->CopyTo( spObject );
+    }
+
+    uint64_t planTickCount = Timer::GetTickCount() - startTickCount;
+
+    float64_t microsecondsPerTick = Timer::GetSecondsPerTick() * 1000000.0;
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        ( TXT( "%s: %" ) TPRIuSZ TXT( " fields, %" ) TPRIuSZ TXT( " plan operations; " )
+          TXT( "Reflect copy %f us, plan copy %f us per object\n" ) ),
+        *pType->GetName(),
+        pPlan->GetFieldCount(),
+        pPlan->GetOperationCount(),
+        static_cast< float64_t >( reflectTickCount ) * microsecondsPerTick / static_cast< float64_t >( iterationCount ),
+        static_cast< float64_t >( planTickCount ) * microsecondsPerTick / static_cast< float64_t >( iterationCount ) );
+    HELIUM_UNREF( reflectTickCount );
+    HELIUM_UNREF( planTickCount );
+    HELIUM_UNREF( microsecondsPerTick );
+}
+
+static void VerifyCopyPlanTestObject( const TestGameObject4* pObject, const TestGameObject4* pSource )
+{
+    HELIUM_ASSERT( pObject );
+    HELIUM_ASSERT( pSource );
+    HELIUM_ASSERT( pObject != pSource );
+
+    HELIUM_ASSERT( pObject->m_TestValue1 == pSource->m_TestValue1 );
+    HELIUM_ASSERT( pObject->m_TestCount == pSource->m_TestCount );
+    HELIUM_ASSERT( pObject->m_TestFlag == pSource->m_TestFlag );
+    HELIUM_ASSERT( pObject->m_TestString == pSource->m_TestString );
+    HELIUM_ASSERT( pObject->m_TestReference == pSource->m_TestReference );
+
+    // Arrays must be copied into the destination object's own storage.
+    size_t arraySize = pSource->m_TestArray.GetSize();
+    HELIUM_ASSERT( pObject->m_TestArray.GetSize() == arraySize );
+    HELIUM_ASSERT( pObject->m_TestArray.GetData() != pSource->m_TestArray.GetData() );
+    for( size_t arrayIndex = 0; arrayIndex < arraySize; ++arrayIndex )
+    {
+        HELIUM_ASSERT( pObject->m_TestArray[ arrayIndex ] == pSource->m_TestArray[ arrayIndex ] );
+    }
+
+    HELIUM_UNREF( arraySize );
+}
+
+TEST(Engine, GameObjectCopyPlan)
+{
+    static const size_t ITERATION_COUNT = 10000;
+
+    // Make sure objects copied using a copy plan match objects copied field-by-field through Reflect.
+    {
+        const GameObjectCopyPlan* pPlan = TestGameObject4::GetStaticType()->GetCopyPlan();
+        HELIUM_ASSERT( pPlan );
+
+        // The test type should exercise each type of copy operation.
+        uint32_t operationTypeMask = 0;
+        size_t operationCount = pPlan->GetOperationCount();
+        for( size_t operationIndex = 0; operationIndex < operationCount; ++operationIndex )
+        {
+            operationTypeMask |= ( 1 << pPlan->GetOperation( operationIndex ).type );
+        }
+
+        HELIUM_ASSERT( operationTypeMask == ( 1 << GameObjectCopyPlan::OPERATION_MAX ) - 1 );
+        HELIUM_UNREF( operationTypeMask );
+
+        StrongPtr< TestGameObject3 > spReference;
+        HELIUM_VERIFY( GameObject::Create< TestGameObject3 >( spReference, Name( TXT( "CopyPlanReference" ) ), NULL ) );
+        HELIUM_ASSERT( spReference );
+
+        StrongPtr< TestGameObject4 > spSource;
+        HELIUM_VERIFY( GameObject::Create< TestGameObject4 >( spSource, Name( TXT( "CopyPlanSource" ) ), NULL ) );
+        HELIUM_ASSERT( spSource );
+        spSource->m_TestValue1 = 12.5f;
+        spSource->m_TestCount = 0xdeadbeef;
+        spSource->m_TestFlag = true;
+        spSource->m_TestString = TXT( "Copy plan test string" );
+        spSource->m_TestArray.Add( 3 );
+        spSource->m_TestArray.Add( 1 );
+        spSource->m_TestArray.Add( 4 );
+        spSource->m_TestReference = spReference;
+
+        StrongPtr< TestGameObject4 > spPlanTarget;
+        HELIUM_VERIFY( GameObject::Create< TestGameObject4 >( spPlanTarget, Name( TXT( "CopyPlanTarget" ) ), NULL ) );
+        HELIUM_ASSERT( spPlanTarget );
+
+        StrongPtr< TestGameObject4 > spReflectTarget;
+        HELIUM_VERIFY(
+            GameObject::Create< TestGameObject4 >( spReflectTarget, Name( TXT( "CopyPlanReflectTarget" ) ), NULL ) );
+        HELIUM_ASSERT( spReflectTarget );
+
+        spSource->CopyTo( spPlanTarget );
+        spSource->Reflect::Object::CopyTo( spReflectTarget );
+
+        VerifyCopyPlanTestObject( spPlanTarget, spSource );
+        VerifyCopyPlanTestObject( spReflectTarget, spSource );
+        VerifyCopyPlanTestObject( spPlanTarget, spReflectTarget );
+    }
+
+    BenchmarkCopyPlan( Material::GetStaticType(), ITERATION_COUNT );
+    BenchmarkCopyPlan( Mesh::GetStaticType(), ITERATION_COUNT );
+    BenchmarkCopyPlan( Entity::GetStaticType(), ITERATION_COUNT );
+    BenchmarkCopyPlan( TestGameObject4::GetStaticType(), ITERATION_COUNT );
+}
+
+static void DeleteTestFile( const tchar_t* pFileName )
+{
+    FilePath path( pFileName );
+    if( path.Exists() )
+    {
+        HELIUM_VERIFY( path.Delete() );
+    }
+}
+
+TEST(Engine, CacheTocLookup)
+{
+    const tchar_t* pTocFileName = TXT( "CacheTocTest.cachetoc" );
+    const tchar_t* pCacheFileName = TXT( "CacheTocTest.cache" );
+    const tchar_t* pJournalFileName = TXT( "CacheTocTest.cachetoc.journal" );
+
+    DeleteTestFile( pTocFileName );
+    DeleteTestFile( pCacheFileName );
+    DeleteTestFile( pJournalFileName );
+
+    static const tchar_t* const pathStrings[] =
+    {
+        HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "CacheTest" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "Object" ),
+        HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "CacheTest" ) HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "Nested" )
+            HELIUM_OBJECT_PATH_CHAR_STRING TXT( "Object" ),
+        HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "CacheTest" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "Object" )
+            HELIUM_INSTANCE_PATH_CHAR_STRING TXT( "3" ),
+        HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "CacheTest" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "Object" )
+            HELIUM_OBJECT_PATH_CHAR_STRING TXT( "Child" )
+    };
+
+    static const uint32_t SUB_DATA_COUNT = 2;
+
+    GameObjectPath paths[ HELIUM_ARRAY_COUNT( pathStrings ) ];
+    for( size_t pathIndex = 0; pathIndex < HELIUM_ARRAY_COUNT( paths ); ++pathIndex )
+    {
+        HELIUM_VERIFY( paths[ pathIndex ].Set( pathStrings[ pathIndex ] ) );
+    }
+
+    // Write the entries and fold them into a new TOC file.
+    {
+        Cache cache;
+        HELIUM_VERIFY( cache.Initialize(
+            Name( TXT( "CacheTocTest" ) ), Cache::PLATFORM_PC, pTocFileName, pCacheFileName ) );
+        cache.EnforceTocLoad();
+
+        for( size_t pathIndex = 0; pathIndex < HELIUM_ARRAY_COUNT( paths ); ++pathIndex )
+        {
+            for( uint32_t subDataIndex = 0; subDataIndex < SUB_DATA_COUNT; ++subDataIndex )
+            {
+                uint32_t value = static_cast< uint32_t >( pathIndex * SUB_DATA_COUNT + subDataIndex );
+                HELIUM_VERIFY( cache.CacheEntry(
+                    paths[ pathIndex ], subDataIndex, &value, static_cast< int64_t >( value ), sizeof( value ) ) );
+            }
+        }
+
+        HELIUM_VERIFY( cache.Compact() );
+        HELIUM_ASSERT( cache.GetJournalRecordCount() == 0 );
+
+        cache.Shutdown();
+    }
+
+    // Reload the TOC and look up each entry in place, along with keys that are not in the cache.
+    {
+        Cache cache;
+        HELIUM_VERIFY( cache.Initialize(
+            Name( TXT( "CacheTocTest" ) ), Cache::PLATFORM_PC, pTocFileName, pCacheFileName ) );
+        cache.EnforceTocLoad();
+        HELIUM_ASSERT( cache.GetEntryCount() == HELIUM_ARRAY_COUNT( paths ) * SUB_DATA_COUNT );
+
+        for( size_t pathIndex = 0; pathIndex < HELIUM_ARRAY_COUNT( paths ); ++pathIndex )
+        {
+            for( uint32_t subDataIndex = 0; subDataIndex < SUB_DATA_COUNT; ++subDataIndex )
+            {
+                const Cache::Entry* pEntry = cache.FindEntry( paths[ pathIndex ], subDataIndex );
+                HELIUM_ASSERT( pEntry );
+                HELIUM_ASSERT( pEntry->subDataIndex == subDataIndex );
+                HELIUM_ASSERT( pEntry->size == sizeof( uint32_t ) );
+                HELIUM_ASSERT(
+                    pEntry->timestamp == static_cast< int64_t >( pathIndex * SUB_DATA_COUNT + subDataIndex ) );
+                HELIUM_ASSERT( cache.GetEntryPath( *pEntry ) == paths[ pathIndex ] );
+                HELIUM_ASSERT( CompareString( cache.GetEntryPathString( *pEntry ), pathStrings[ pathIndex ] ) == 0 );
+                HELIUM_UNREF( pEntry );
+            }
+
+            HELIUM_ASSERT( !cache.FindEntry( paths[ pathIndex ], SUB_DATA_COUNT ) );
+        }
+
+        GameObjectPath missingPath;
+        HELIUM_VERIFY( missingPath.Set(
+            HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "CacheTest" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "Missing" ) ) );
+        HELIUM_ASSERT( !cache.FindEntry( missingPath, 0 ) );
+
+        GameObjectPath packagePath;
+        HELIUM_VERIFY( packagePath.Set( HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "CacheTest" ) ) );
+        HELIUM_ASSERT( !cache.FindEntry( packagePath, 0 ) );
+
+        cache.Shutdown();
+    }
+
+    DeleteTestFile( pTocFileName );
+    DeleteTestFile( pCacheFileName );
+    DeleteTestFile( pJournalFileName );
+}
+
+TEST(Engine, AsyncLoaderBackends)
+{
+    const tchar_t* pFileName = TXT( "AsyncLoaderTest.bin" );
+
+    static const size_t FILE_SIZE = 256 * 1024 + 13;
+
+    DynArray< uint8_t > fileData;
+    fileData.Resize( FILE_SIZE );
+    for( size_t byteIndex = 0; byteIndex < FILE_SIZE; ++byteIndex )
+    {
+        fileData[ byteIndex ] = static_cast< uint8_t >( ( byteIndex * 31 ) ^ ( byteIndex >> 8 ) );
+    }
+
+    {
+        FileStream* pStream = FileStream::OpenFileStream( pFileName, FileStream::MODE_WRITE, true );
+        HELIUM_ASSERT( pStream );
+        HELIUM_VERIFY( pStream->Write( fileData.GetData(), 1, FILE_SIZE ) == FILE_SIZE );
+        delete pStream;
+    }
+
+    // Adjacent reads (which the loader may coalesce), scattered reads, and a read running past the end of the file.
+    struct ReadRange
+    {
+        uint64_t offset;
+        size_t size;
+    };
+
+    static const ReadRange ranges[] =
+    {
+        { 0, 4096 },
+        { 4096, 4096 },
+        { 8192, 1 },
+        { 100003, 65536 },
+        { 17, 3 },
+        { 200000, 40000 },
+        { FILE_SIZE - 100, 4096 },
+    };
+
+    static const AsyncLoader::EBackend backends[] =
+    {
+        AsyncLoader::BACKEND_STREAM,
+        AsyncLoader::BACKEND_POSITIONAL,
+        AsyncLoader::BACKEND_IO_URING,
+        AsyncLoader::BACKEND_IO_URING,  // Run again with io_uring disabled to test the fallback.
+    };
+
+    AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+    AsyncLoader::EBackend originalBackend = rAsyncLoader.GetBackend();
+
+    String fileName( pFileName );
+    DynArray< uint8_t > readBuffers[ HELIUM_ARRAY_COUNT( ranges ) ];
+    size_t requestIds[ HELIUM_ARRAY_COUNT( ranges ) ];
+
+    for( size_t backendIndex = 0; backendIndex < HELIUM_ARRAY_COUNT( backends ); ++backendIndex )
+    {
+        AsyncLoader::EBackend backend = backends[ backendIndex ];
+        bool bFallback = ( backendIndex == HELIUM_ARRAY_COUNT( backends ) - 1 );
+        AsyncLoader::SetIoUringAllowed( !bFallback );
+
+        HELIUM_VERIFY( rAsyncLoader.Initialize( 0, backend ) );
+
+#if HELIUM_OS_LINUX
+        if( bFallback )
+        {
+            HELIUM_ASSERT( rAsyncLoader.GetBackend() == AsyncLoader::BACKEND_POSITIONAL );
+        }
+        else if( backend != AsyncLoader::BACKEND_IO_URING )
+        {
+            HELIUM_ASSERT( rAsyncLoader.GetBackend() == backend );
+        }
+#else
+        HELIUM_ASSERT( rAsyncLoader.GetBackend() == AsyncLoader::BACKEND_STREAM );
+#endif
+
+        HELIUM_TRACE(
+            TraceLevels::Info,
+            TXT( "AsyncLoaderBackends: Requested \"%s\", using \"%s\".\n" ),
+            AsyncLoader::GetBackendName( backend ),
+            AsyncLoader::GetBackendName( rAsyncLoader.GetBackend() ) );
+
+        for( size_t rangeIndex = 0; rangeIndex < HELIUM_ARRAY_COUNT( ranges ); ++rangeIndex )
+        {
+            DynArray< uint8_t >& rBuffer = readBuffers[ rangeIndex ];
+            rBuffer.Resize( ranges[ rangeIndex ].size );
+            MemorySet( rBuffer.GetData(), 0xcd, rBuffer.GetSize() );
+
+            requestIds[ rangeIndex ] = rAsyncLoader.QueueRequest(
+                rBuffer.GetData(),
+                fileName,
+                ranges[ rangeIndex ].offset,
+                ranges[ rangeIndex ].size );
+            HELIUM_ASSERT( IsValid( requestIds[ rangeIndex ] ) );
+        }
+
+        for( size_t rangeIndex = 0; rangeIndex < HELIUM_ARRAY_COUNT( ranges ); ++rangeIndex )
+        {
+            const ReadRange& rRange = ranges[ rangeIndex ];
+            size_t expectedSize = static_cast< size_t >(
+                Min< uint64_t >( rRange.size, FILE_SIZE - rRange.offset ) );
+
+            size_t bytesRead = rAsyncLoader.SyncRequest( requestIds[ rangeIndex ] );
+            HELIUM_ASSERT( bytesRead == expectedSize );
+            HELIUM_UNREF( bytesRead );
+
+            const uint8_t* pReadData = readBuffers[ rangeIndex ].GetData();
+            HELIUM_ASSERT( MemoryCompare( pReadData, &fileData[ rRange.offset ], expectedSize ) == 0 );
+            HELIUM_UNREF( pReadData );
+        }
+    }
+
+    AsyncLoader::SetIoUringAllowed( true );
+    HELIUM_VERIFY( rAsyncLoader.Initialize( 0, originalBackend ) );
+
+    DeleteTestFile( pFileName );
+}
+
+TEST(Engine, ResidencyManager)
+{
+    ResidencyManager* pResidencyManager = ResidencyManager::CreateStaticInstance();
+    HELIUM_ASSERT( pResidencyManager );
+
+    // Least recently used resources should be evicted once the resident data exceeds a small budget, and restored
+    // once they are used again.  References are kept to the test resources so that their data gets evicted instead of
+    // the resources being released.
+    {
+        static const size_t RESOURCE_DATA_SIZE = 1000;
+
+        PackagePtr spTestPackage;
+        HELIUM_VERIFY( GameObject::Create< Package >( spTestPackage, Name( TXT( "ResidencyTest" ) ), NULL ) );
+        HELIUM_ASSERT( spTestPackage );
+        GameObjectPath testPackagePath = spTestPackage->GetPath();
+
+        static const tchar_t* const resourceNames[] =
+        {
+            TXT( "Resource0" ),
+            TXT( "Resource1" ),
+            TXT( "Resource2" ),
+            TXT( "Resource3" )
+        };
+
+        StrongPtr< TestResource > spResources[ HELIUM_ARRAY_COUNT( resourceNames ) ];
+        for( size_t resourceIndex = 0; resourceIndex < HELIUM_ARRAY_COUNT( spResources ); ++resourceIndex )
+        {
+            HELIUM_VERIFY( GameObject::Create< TestResource >(
+                spResources[ resourceIndex ],
+                Name( resourceNames[ resourceIndex ] ),
+                spTestPackage ) );
+            HELIUM_ASSERT( spResources[ resourceIndex ] );
+            spResources[ resourceIndex ]->m_TestDataSize = RESOURCE_DATA_SIZE;
+            pResidencyManager->TrackResource( spResources[ resourceIndex ] );
+        }
+
+        pResidencyManager->SetMinimumEvictionAge( 2 );
+        pResidencyManager->Tick();
+        HELIUM_ASSERT( pResidencyManager->GetResidentMemory() == 4 * RESOURCE_DATA_SIZE );
+        HELIUM_ASSERT( pResidencyManager->GetPackageResidentMemory( testPackagePath ) == 4 * RESOURCE_DATA_SIZE );
+
+        // Use each resource in a different frame, oldest first.
+        for( size_t resourceIndex = 0; resourceIndex < HELIUM_ARRAY_COUNT( spResources ); ++resourceIndex )
+        {
+            pResidencyManager->Touch( spResources[ resourceIndex ] );
+            pResidencyManager->Tick();
+        }
+
+        // Resources 0 and 1 were used least recently, so evicting them brings us back within budget.
+        pResidencyManager->SetMemoryBudget( 2 * RESOURCE_DATA_SIZE + RESOURCE_DATA_SIZE / 2 );
+        pResidencyManager->Tick();
+        HELIUM_ASSERT( !pResidencyManager->IsResident( spResources[ 0 ] ) );
+        HELIUM_ASSERT( !pResidencyManager->IsResident( spResources[ 1 ] ) );
+        HELIUM_ASSERT( pResidencyManager->IsResident( spResources[ 2 ] ) );
+        HELIUM_ASSERT( pResidencyManager->IsResident( spResources[ 3 ] ) );
+        HELIUM_ASSERT( pResidencyManager->GetResidentMemory() == 2 * RESOURCE_DATA_SIZE );
+
+        // Requesting an evicted resource restores it on the next tick, evicting the now least recently used resource.
+        pResidencyManager->Touch( spResources[ 0 ] );
+        HELIUM_ASSERT( !pResidencyManager->IsResident( spResources[ 0 ] ) );
+        pResidencyManager->Tick();
+        HELIUM_ASSERT( pResidencyManager->IsResident( spResources[ 0 ] ) );
+        HELIUM_ASSERT( spResources[ 0 ]->m_bTestDataResident );
+        HELIUM_ASSERT( !pResidencyManager->IsResident( spResources[ 1 ] ) );
+        HELIUM_ASSERT( !pResidencyManager->IsResident( spResources[ 2 ] ) );
+        HELIUM_ASSERT( pResidencyManager->IsResident( spResources[ 3 ] ) );
+        HELIUM_ASSERT( pResidencyManager->GetResidentMemory() == 2 * RESOURCE_DATA_SIZE );
+
+        // Nothing is evicted from a pinned package, even when over budget.
+        pResidencyManager->PinPackage( testPackagePath );
+        pResidencyManager->Touch( spResources[ 1 ] );
+        pResidencyManager->Touch( spResources[ 2 ] );
+        for( uint32_t tickIndex = 0; tickIndex < pResidencyManager->GetMinimumEvictionAge() + 1; ++tickIndex )
+        {
+            pResidencyManager->Tick();
+        }
+
+        for( size_t resourceIndex = 0; resourceIndex < HELIUM_ARRAY_COUNT( spResources ); ++resourceIndex )
+        {
+            HELIUM_ASSERT( pResidencyManager->IsResident( spResources[ resourceIndex ] ) );
+        }
+
+        HELIUM_ASSERT( pResidencyManager->GetResidentMemory() == 4 * RESOURCE_DATA_SIZE );
+
+        // Once unpinned, the least recently used resources (0 and 3) are evicted again.
+        pResidencyManager->UnpinPackage( testPackagePath );
+        pResidencyManager->Tick();
+        HELIUM_ASSERT( !pResidencyManager->IsResident( spResources[ 0 ] ) );
+        HELIUM_ASSERT( pResidencyManager->IsResident( spResources[ 1 ] ) );
+        HELIUM_ASSERT( pResidencyManager->IsResident( spResources[ 2 ] ) );
+        HELIUM_ASSERT( !pResidencyManager->IsResident( spResources[ 3 ] ) );
+        HELIUM_ASSERT( pResidencyManager->GetResidentMemory() == 2 * RESOURCE_DATA_SIZE );
+
+        ResidencyManager::Statistics statistics;
+        pResidencyManager->GetStatistics( statistics );
+        HELIUM_ASSERT( statistics.resourceCount == HELIUM_ARRAY_COUNT( spResources ) );
+        HELIUM_ASSERT( statistics.evictedResourceCount == 2 );
+        HELIUM_ASSERT( statistics.totalEvictionCount == 5 );
+        HELIUM_ASSERT( statistics.totalRestoreCount == 3 );
+        HELIUM_UNREF( statistics );
+
+        pResidencyManager->SetMemoryBudget( 0 );
+        pResidencyManager->ReleasePackage( testPackagePath );
+        HELIUM_ASSERT( pResidencyManager->GetResidentMemory() == 0 );
+    }
+
+    GameObjectPath packagePath;
+    HELIUM_VERIFY( packagePath.Set( HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "EngineTest" ) ) );
+
+    pResidencyManager->PinPackage( packagePath );
+    pResidencyManager->PinPackage( packagePath );
+    HELIUM_ASSERT( pResidencyManager->IsPackagePinned( packagePath ) );
+    pResidencyManager->UnpinPackage( packagePath );
+    HELIUM_ASSERT( pResidencyManager->IsPackagePinned( packagePath ) );
+
+    // Fail instead of hanging if the prefetch never completes.
+    static const float64_t PREFETCH_TIMEOUT_SECONDS = 30.0;
+    uint64_t prefetchTimeoutTickCount =
+        Timer::GetTickCount() + static_cast< uint64_t >( PREFETCH_TIMEOUT_SECONDS / Timer::GetSecondsPerTick() );
+
+    pResidencyManager->PrefetchPackage( packagePath );
+    while( pResidencyManager->IsPrefetchPending( packagePath ) && Timer::GetTickCount() < prefetchTimeoutTickCount )
+    {
+        gObjectLoader->Tick();
+        pResidencyManager->Tick();
+    }
+
+    HELIUM_ASSERT( !pResidencyManager->IsPrefetchPending( packagePath ) );
+
+    // Releasing the package drops all pins and residency references.
+    pResidencyManager->ReleasePackage( packagePath );
+    HELIUM_ASSERT( !pResidencyManager->IsPackagePinned( packagePath ) );
+    HELIUM_ASSERT( pResidencyManager->GetPackageResidentMemory( packagePath ) == 0 );
+
+    ResidencyManager::Statistics statistics;
+    pResidencyManager->GetStatistics( statistics );
+    HELIUM_ASSERT( statistics.pinnedPackageCount == 0 );
+    HELIUM_ASSERT( statistics.prefetchCount == 0 );
+    HELIUM_UNREF( statistics );
+
+    ResidencyManager::DestroyStaticInstance();
+}
+
+/// Compute a Fibonacci number through FibJob and FibContinuation jobs.
+///
+/// @param[in] n  Index of the Fibonacci number to compute.
+///
+/// @return  Computed Fibonacci number.
+static uint32_t RunFibJobs( uint32_t n )
+{
+    uint32_t sum = 0;
+
+    {
+        JobContext::Spawner< 1 > rootSpawner;
+        JobContext* pContext = rootSpawner.Allocate();
+        HELIUM_ASSERT( pContext );
+        FibJob* pJob = pContext->Create< FibJob >();
+        HELIUM_ASSERT( pJob );
+
+        FibJob::Parameters& rParameters = pJob->GetParameters();
+        rParameters.n = n;
+        rParameters.pSum = &sum;
+    }
+
+    return sum;
+}
+
+/// Compute a Fibonacci number through jobs a number of times, checking the result of each run.
+///
+/// @param[in] n               Index of the Fibonacci number to compute.
+/// @param[in] iterationCount  Number of times to compute the Fibonacci number.
+///
+/// @return  Average time taken to compute the Fibonacci number once, in milliseconds.
+static float64_t BenchmarkFibJobs( uint32_t n, size_t iterationCount )
+{
+    uint32_t expectedSum = 0;
+    uint32_t nextSum = 1;
+    for( uint32_t index = 0; index < n; ++index )
+    {
+        uint32_t sum = expectedSum + nextSum;
+        expectedSum = nextSum;
+        nextSum = sum;
+    }
+
+    uint64_t startTickCount = Timer::GetTickCount();
+    for( size_t iterationIndex = 0; iterationIndex < iterationCount; ++iterationIndex )
+    {
+        uint32_t sum = RunFibJobs( n );
+        HELIUM_ASSERT( sum == expectedSum );
+        HELIUM_UNREF( sum );
+    }
+
+    uint64_t tickCount = Timer::GetTickCount() - startTickCount;
+    HELIUM_UNREF( expectedSum );
+
+    return static_cast< float64_t >( tickCount ) * Timer::GetSecondsPerTick() * 1000.0 /
+        static_cast< float64_t >( iterationCount );
+}
+
+TEST(Engine, FibJobs)
+{
+    static const uint32_t FIB_N = 22;
+    static const size_t ITERATION_COUNT = 20;
+
+    // Warm up the job pools before timing.
+    HELIUM_VERIFY( RunFibJobs( 10 ) == 55 );
+
+    float64_t milliseconds = BenchmarkFibJobs( FIB_N, ITERATION_COUNT );
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "FibJobs: fib(%" ) TPRIu32 TXT( ") took %f ms\n" ),
+        FIB_N,
+        milliseconds );
+    HELIUM_UNREF( milliseconds );
+
+#if HELIUM_NATIVE_JOB_SCHEDULER
+    // Restarting the scheduler frees the worker registered for this thread, which must be registered again the next
+    // time this thread commits jobs.
+    JobScheduler& rJobScheduler = JobScheduler::GetStaticInstance();
+    HELIUM_VERIFY( rJobScheduler.Initialize( rJobScheduler.GetWorkerThreadCount() ) );
+    HELIUM_ASSERT( rJobScheduler.GetCurrentWorkerIndex() == JobScheduler::INVALID_WORKER_INDEX );
+
+    BenchmarkFibJobs( FIB_N, 1 );
+#endif
+}
+
+#if HELIUM_PROFILE_JOBS
+TEST(Engine, FibJobsProfiled)
+{
+    static const uint32_t FIB_N = 22;
+    static const size_t ITERATION_COUNT = 20;
+
+    // Warm up the job pools and the profiler's buffer for this thread before timing.
+    JobProfiler::Enable();
+    HELIUM_VERIFY( RunFibJobs( 10 ) == 55 );
+    JobProfiler::Disable();
+
+    float64_t disabledMilliseconds = BenchmarkFibJobs( FIB_N, ITERATION_COUNT );
+
+    JobProfiler::Enable();
+    float64_t enabledMilliseconds = BenchmarkFibJobs( FIB_N, ITERATION_COUNT );
+    JobProfiler::Disable();
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "FibJobsProfiled: fib(%" ) TPRIu32 TXT( ") took %f ms with profiling disabled, %f ms with profiling " )
+        TXT( "enabled\n" ),
+        FIB_N,
+        disabledMilliseconds,
+        enabledMilliseconds );
+    HELIUM_UNREF( disabledMilliseconds );
+    HELIUM_UNREF( enabledMilliseconds );
+
+    JobProfiler::Shutdown();
+}
+#endif  // HELIUM_PROFILE_JOBS
+
+TEST(Graphics, SceneBoundsCulling)
+{
+    static const size_t OBJECT_COUNT = 100000;
+    static const size_t ITERATION_COUNT = 100;
+
+    // Scatter objects of varying sizes around a camera at the origin looking down the positive Z axis.
+    SceneBoundsStream boundsStream;
+    boundsStream.Resize( OBJECT_COUNT );
+
+    DynamicArray< Simd::Sphere > spheres;
+    spheres.Reserve( OBJECT_COUNT );
+
+    srand( 0 );
+    for( size_t objectIndex = 0; objectIndex < OBJECT_COUNT; ++objectIndex )
+    {
+        float32_t position[ 3 ];
+        for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+        {
+            position[ axisIndex ] =
+                ( static_cast< float32_t >( rand() ) / static_cast< float32_t >( RAND_MAX ) ) * 2000.0f - 1000.0f;
+        }
+
+        float32_t extent = ( static_cast< float32_t >( rand() ) / static_cast< float32_t >( RAND_MAX ) ) * 10.0f;
+
+        Simd::AaBox box(
+            Simd::Vector3( position[ 0 ] - extent, position[ 1 ] - extent, position[ 2 ] - extent ),
+            Simd::Vector3( position[ 0 ] + extent, position[ 1 ] + extent, position[ 2 ] + extent ) );
+        Simd::Sphere* pSphere = spheres.New();
+        HELIUM_ASSERT( pSphere );
+        pSphere->Set( box );
+
+        boundsStream.Set( objectIndex, *pSphere );
+    }
+
+    Simd::Matrix44 viewProjection;
+    viewProjection.SetPerspectiveProjection(
+        90.0f * static_cast< float32_t >( HELIUM_DEG_TO_RAD ), 16.0f / 9.0f, 1.0f, 800.0f );
+
+    Simd::Frustum frustum;
+    frustum.Set( viewProjection.GetTranspose() );
+
+    SceneBoundsStream::Planes planes;
+    SceneBoundsStream::ComputePlanes( viewProjection, planes );
+
+    // Test each sphere individually against the view frustum.
+    size_t referenceVisibleCount = 0;
+    uint64_t startTickCount = Timer::GetTickCount();
+    for( size_t iterationIndex = 0; iterationIndex < ITERATION_COUNT; ++iterationIndex )
+    {
+        referenceVisibleCount = 0;
+        for( size_t objectIndex = 0; objectIndex < OBJECT_COUNT; ++objectIndex )
+        {
+            if( frustum.Intersects( spheres[ objectIndex ] ) )
+            {
+                ++referenceVisibleCount;
+            }
+        }
+    }
+
+    uint64_t referenceTickCount = Timer::GetTickCount() - startTickCount;
+
+    // Test the packed bounds stream.
+    DynamicArray< uint32_t > visibleIndices;
+    startTickCount = Timer::GetTickCount();
+    for( size_t iterationIndex = 0; iterationIndex < ITERATION_COUNT; ++iterationIndex )
+    {
+        boundsStream.Cull( planes, visibleIndices );
+    }
+
+    uint64_t streamTickCount = Timer::GetTickCount() - startTickCount;
+
+    // Results should match the per-sphere tests exactly.
+    size_t mismatchCount = 0;
+    size_t visibleCount = visibleIndices.GetSize();
+    for( size_t visibleIndex = 0; visibleIndex < visibleCount; ++visibleIndex )
+    {
+        HELIUM_ASSERT( visibleIndices[ visibleIndex ] < OBJECT_COUNT );
+        HELIUM_ASSERT( visibleIndex == 0 || visibleIndices[ visibleIndex - 1 ] < visibleIndices[ visibleIndex ] );
+        if( !frustum.Intersects( spheres[ visibleIndices[ visibleIndex ] ] ) )
+        {
+            ++mismatchCount;
+        }
+    }
+
+    mismatchCount += referenceVisibleCount - ( visibleCount - mismatchCount );
+    HELIUM_ASSERT( mismatchCount == 0 );
+    HELIUM_UNREF( mismatchCount );
+
+    float64_t millisecondsPerIteration =
+        Timer::GetSecondsPerTick() * 1000.0 / static_cast< float64_t >( ITERATION_COUNT );
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        ( TXT( "Culled %" ) TPRIuSZ TXT( " objects (%" ) TPRIuSZ TXT( " visible): per-object test %f ms, " )
+          TXT( "bounds stream %f ms per view\n" ) ),
+        OBJECT_COUNT,
+        visibleCount,
+        static_cast< float64_t >( referenceTickCount ) * millisecondsPerIteration,
+        static_cast< float64_t >( streamTickCount ) * millisecondsPerIteration );
+    HELIUM_UNREF( referenceTickCount );
+    HELIUM_UNREF( streamTickCount );
+    HELIUM_UNREF( millisecondsPerIteration );
+}
+
+static void UpdateCullingTestSceneObject( void* pData, GraphicsScene* /*pScene*/, GraphicsSceneObject* pSceneObject )
+{
+    HELIUM_ASSERT( pData );
+    HELIUM_ASSERT( pSceneObject );
+    pSceneObject->SetWorldBounds( *static_cast< const Simd::AaBox* >( pData ) );
+}
+
+static Simd::AaBox MakeCullingTestBox( float32_t range, float32_t extentMax )
+{
+    float32_t position[ 3 ];
+    for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+    {
+        position[ axisIndex ] =
+            ( static_cast< float32_t >( rand() ) / static_cast< float32_t >( RAND_MAX ) ) * 2.0f * range - range;
+    }
+
+    float32_t extent = ( static_cast< float32_t >( rand() ) / static_cast< float32_t >( RAND_MAX ) ) * extentMax;
+
+    return Simd::AaBox(
+        Simd::Vector3( position[ 0 ] - extent, position[ 1 ] - extent, position[ 2 ] - extent ),
+        Simd::Vector3( position[ 0 ] + extent, position[ 1 ] + extent, position[ 2 ] + extent ) );
+}
+
+static size_t CountSceneCullingMismatches(
+    const GraphicsScene* pScene,
+    const SceneBoundsStream& rReferenceStream,
+    const Simd::Matrix44& rViewProjection )
+{
+    HELIUM_ASSERT( pScene );
+
+    SceneBoundsStream::Planes planes;
+    SceneBoundsStream::ComputePlanes( rViewProjection, planes );
+
+    DynamicArray< uint32_t > referenceIds;
+    rReferenceStream.Cull( planes, referenceIds );
+
+    DynamicArray< uint32_t > visibleIds;
+    pScene->CullSceneObjects( rViewProjection, visibleIds );
+    std::sort( visibleIds.GetData(), visibleIds.GetData() + visibleIds.GetSize() );
+
+    // Count the IDs present in only one of the two sorted lists.
+    size_t mismatchCount = 0;
+    size_t referenceIndex = 0;
+    size_t visibleIndex = 0;
+    size_t referenceCount = referenceIds.GetSize();
+    size_t visibleCount = visibleIds.GetSize();
+    while( referenceIndex < referenceCount || visibleIndex < visibleCount )
+    {
+        if( visibleIndex >= visibleCount ||
+            ( referenceIndex < referenceCount && referenceIds[ referenceIndex ] < visibleIds[ visibleIndex ] ) )
+        {
+            ++referenceIndex;
+            ++mismatchCount;
+        }
+        else if( referenceIndex >= referenceCount || visibleIds[ visibleIndex ] < referenceIds[ referenceIndex ] )
+        {
+            ++visibleIndex;
+            ++mismatchCount;
+        }
+        else
+        {
+            ++referenceIndex;
+            ++visibleIndex;
+        }
+    }
+
+    return mismatchCount;
+}
+
+TEST(Graphics, SceneObjectTreeCulling)
+{
+    static const size_t OBJECT_COUNT = 50000;
+    static const size_t REINSERT_OBJECT_COUNT = 32;
+    static const size_t RELEASE_OBJECT_COUNT = 1000;
+    static const size_t ITERATION_COUNT = 100;
+
+    // Scene objects can be culled directly without an active renderer.
+    GraphicsScenePtr spScene;
+    HELIUM_VERIFY( GameObject::Create< GraphicsScene >(
+        spScene, Name( TXT( "CullingTestScene" ) ), NULL, NULL, true ) );
+    HELIUM_ASSERT( spScene );
+
+    SceneBoundsStream referenceStream;
+    referenceStream.Resize( OBJECT_COUNT );
+
+    // Object bounds are referenced by the update callbacks, so the array must not be reallocated.
+    DynamicArray< Simd::AaBox > boxes;
+    boxes.Reserve( OBJECT_COUNT );
+
+    srand( 0 );
+    for( size_t objectIndex = 0; objectIndex < OBJECT_COUNT; ++objectIndex )
+    {
+        Simd::AaBox* pBox = boxes.New( MakeCullingTestBox( 1000.0f, 10.0f ) );
+        HELIUM_ASSERT( pBox );
+
+        size_t sceneObjectId = spScene->AllocateSceneObject();
+        HELIUM_ASSERT( sceneObjectId == objectIndex );
+        GraphicsSceneObject* pSceneObject = spScene->GetSceneObject( sceneObjectId );
+        HELIUM_ASSERT( pSceneObject );
+        pSceneObject->SetUpdateCallback( UpdateCullingTestSceneObject, pBox );
+        pSceneObject->SetNeedsUpdate();
+
+        referenceStream.Set( objectIndex, *pBox );
+    }
+
+    spScene->UpdateSceneObjects();
+
+    Simd::Matrix44 viewProjection;
+    viewProjection.SetPerspectiveProjection(
+        90.0f * static_cast< float32_t >( HELIUM_DEG_TO_RAD ), 16.0f / 9.0f, 1.0f, 800.0f );
+
+    // Leaves are tested with the same sphere test as the bounds stream, so the results should match exactly.
+    size_t mismatchCount = CountSceneCullingMismatches( spScene.Get(), referenceStream, viewProjection );
+    HELIUM_ASSERT( mismatchCount == 0 );
+
+    // Move a few objects (applied by reinserting their leaves).
+    for( size_t moveIndex = 0; moveIndex < REINSERT_OBJECT_COUNT; ++moveIndex )
+    {
+        size_t objectIndex = static_cast< size_t >( rand() ) % OBJECT_COUNT;
+        boxes[ objectIndex ] = MakeCullingTestBox( 1000.0f, 10.0f );
+        spScene->GetSceneObject( objectIndex )->SetNeedsUpdate();
+        referenceStream.Set( objectIndex, boxes[ objectIndex ] );
+    }
+
+    spScene->UpdateSceneObjects();
+
+    mismatchCount = CountSceneCullingMismatches( spScene.Get(), referenceStream, viewProjection );
+    HELIUM_ASSERT( mismatchCount == 0 );
+
+    // Move every other object by a small amount (applied by refitting the tree in parallel).
+    for( size_t objectIndex = 0; objectIndex < OBJECT_COUNT; objectIndex += 2 )
+    {
+        Simd::Vector3 offset = MakeCullingTestBox( 20.0f, 0.0f ).GetMinimum();
+        Simd::AaBox& rBox = boxes[ objectIndex ];
+        rBox = Simd::AaBox( rBox.GetMinimum() + offset, rBox.GetMaximum() + offset );
+        spScene->GetSceneObject( objectIndex )->SetNeedsUpdate();
+        referenceStream.Set( objectIndex, rBox );
+    }
+
+    uint64_t startTickCount = Timer::GetTickCount();
+    spScene->UpdateSceneObjects();
+    uint64_t refitTickCount = Timer::GetTickCount() - startTickCount;
+
+    mismatchCount = CountSceneCullingMismatches( spScene.Get(), referenceStream, viewProjection );
+    HELIUM_ASSERT( mismatchCount == 0 );
+
+    // Released objects should no longer be reported.
+    for( size_t releaseIndex = 0; releaseIndex < RELEASE_OBJECT_COUNT; ++releaseIndex )
+    {
+        size_t objectIndex = releaseIndex * ( OBJECT_COUNT / RELEASE_OBJECT_COUNT );
+        spScene->ReleaseSceneObject( objectIndex );
+        referenceStream.Clear( objectIndex );
+    }
+
+    mismatchCount = CountSceneCullingMismatches( spScene.Get(), referenceStream, viewProjection );
+    HELIUM_ASSERT( mismatchCount == 0 );
+    HELIUM_UNREF( mismatchCount );
+
+    // Compare the cost of hierarchical culling against testing every object.
+    SceneBoundsStream::Planes planes;
+    SceneBoundsStream::ComputePlanes( viewProjection, planes );
+
+    DynamicArray< uint32_t > visibleIds;
+    startTickCount = Timer::GetTickCount();
+    for( size_t iterationIndex = 0; iterationIndex < ITERATION_COUNT; ++iterationIndex )
+    {
+        referenceStream.Cull( planes, visibleIds );
+    }
+
+    uint64_t streamTickCount = Timer::GetTickCount() - startTickCount;
+
+    startTickCount = Timer::GetTickCount();
+    for( size_t iterationIndex = 0; iterationIndex < ITERATION_COUNT; ++iterationIndex )
+    {
+        spScene->CullSceneObjects( viewProjection, visibleIds );
+    }
+
+    uint64_t treeTickCount = Timer::GetTickCount() - startTickCount;
+
+    float64_t millisecondsPerTick = Timer::GetSecondsPerTick() * 1000.0;
+    float64_t millisecondsPerIteration = millisecondsPerTick / static_cast< float64_t >( ITERATION_COUNT );
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        ( TXT( "Culled %" ) TPRIuSZ TXT( " scene objects (%" ) TPRIuSZ TXT( " visible): bounds stream %f ms, " )
+          TXT( "tree %f ms per view; refit of %" ) TPRIuSZ TXT( " objects %f ms\n" ) ),
+        OBJECT_COUNT - RELEASE_OBJECT_COUNT,
+        visibleIds.GetSize(),
+        static_cast< float64_t >( streamTickCount ) * millisecondsPerIteration,
+        static_cast< float64_t >( treeTickCount ) * millisecondsPerIteration,
+        OBJECT_COUNT / 2,
+        static_cast< float64_t >( refitTickCount ) * millisecondsPerTick );
+    HELIUM_UNREF( streamTickCount );
+    HELIUM_UNREF( treeTickCount );
+    HELIUM_UNREF( refitTickCount );
+    HELIUM_UNREF( millisecondsPerIteration );
+
+    spScene.Release();
+}
+
+namespace
+{
+    /// Sub-mesh sorting data for the draw sorting test.
+    struct DrawSortTestSubMesh
+    {
+        /// Distance along the view direction.
+        float32_t depth;
+        /// Material index.
+        uint32_t materialIndex;
+        /// Shader index (shared by multiple materials).
+        uint32_t shaderIndex;
+
+        /// Material.
+        const Material* pMaterial;
+        /// Vertex shader variant.
+        const ShaderVariant* pVertexShaderVariant;
+        /// Pixel shader variant.
+        const ShaderVariant* pPixelShaderVariant;
+        /// Vertex buffer.
+        const RVertexBuffer* pVertexBuffer;
+    };
+
+    /// Sub-mesh comparison function for the draw sorting test.
+    ///
+    /// Sub-meshes are ordered by draw key, with sub-meshes with the same key kept in their original order (matching the
+    /// stable radix sort).
+    class DrawSortTestCompare
+    {
+    public:
+        DrawSortTestCompare()
+            : m_pKeys( NULL )
+        {
+        }
+
+        explicit DrawSortTestCompare( const uint64_t* pKeys )
+            : m_pKeys( pKeys )
+        {
+        }
+
+        bool operator()( uint32_t subMeshIndex0, uint32_t subMeshIndex1 ) const
+        {
+            uint64_t key0 = m_pKeys[ subMeshIndex0 ];
+            uint64_t key1 = m_pKeys[ subMeshIndex1 ];
+            if( key0 != key1 )
+            {
+                return ( key0 < key1 );
+            }
+
+            return ( subMeshIndex0 < subMeshIndex1 );
+        }
+
+    private:
+        const uint64_t* m_pKeys;
+    };
+}
+
+TEST(Graphics, DrawKeyRadixSort)
+{
+    static const size_t SUB_MESH_COUNT = 50000;
+    static const uint32_t MATERIAL_COUNT = 16;
+    static const uint32_t SHADER_COUNT = 4;
+    static const uint32_t VERTEX_BUFFER_COUNT = 8;
+    static const size_t ITERATION_COUNT = 20;
+
+    // Draw keys only use resource addresses, so entries in a byte array can stand in for the actual resources.
+    static const uint8_t resources[ MATERIAL_COUNT + SHADER_COUNT * 2 + VERTEX_BUFFER_COUNT ] = { 0 };
+    const uint8_t* pMaterialResources = resources;
+    const uint8_t* pVertexShaderResources = pMaterialResources + MATERIAL_COUNT;
+    const uint8_t* pPixelShaderResources = pVertexShaderResources + SHADER_COUNT;
+    const uint8_t* pVertexBufferResources = pPixelShaderResources + SHADER_COUNT;
+
+    DynamicArray< DrawSortTestSubMesh > subMeshes;
+    subMeshes.Reserve( SUB_MESH_COUNT );
+    subMeshes.Resize( SUB_MESH_COUNT );
+
+    srand( 0 );
+    for( size_t subMeshIndex = 0; subMeshIndex < SUB_MESH_COUNT; ++subMeshIndex )
+    {
+        DrawSortTestSubMesh& rSubMesh = subMeshes[ subMeshIndex ];
+
+        // Duplicate some sub-meshes so that their draw keys are equal.
+        if( subMeshIndex % 101 == 100 )
+        {
+            rSubMesh = subMeshes[ subMeshIndex - 1 ];
+
+            continue;
+        }
+
+        // Roughly half of the sub-meshes are placed behind the view position (negative depth).
+        rSubMesh.depth =
+            ( static_cast< float32_t >( rand() ) / static_cast< float32_t >( RAND_MAX ) ) * 2000.0f - 1000.0f;
+        rSubMesh.materialIndex = static_cast< uint32_t >( rand() ) % MATERIAL_COUNT;
+        rSubMesh.shaderIndex = rSubMesh.materialIndex % SHADER_COUNT;
+
+        rSubMesh.pMaterial = reinterpret_cast< const Material* >( pMaterialResources + rSubMesh.materialIndex );
+        rSubMesh.pVertexShaderVariant =
+            reinterpret_cast< const ShaderVariant* >( pVertexShaderResources + rSubMesh.shaderIndex );
+        rSubMesh.pPixelShaderVariant =
+            reinterpret_cast< const ShaderVariant* >( pPixelShaderResources + rSubMesh.shaderIndex );
+        rSubMesh.pVertexBuffer = reinterpret_cast< const RVertexBuffer* >(
+            pVertexBufferResources + static_cast< uint32_t >( rand() ) % VERTEX_BUFFER_COUNT );
+    }
+
+    DynamicArray< uint64_t > keys;
+    keys.Reserve( SUB_MESH_COUNT );
+    keys.Resize( SUB_MESH_COUNT );
+
+    DynamicArray< uint32_t > compareSortedIndices;
+    compareSortedIndices.Reserve( SUB_MESH_COUNT );
+    compareSortedIndices.Resize( SUB_MESH_COUNT );
+
+    DynamicArray< uint64_t > radixSortedKeys;
+    radixSortedKeys.Reserve( SUB_MESH_COUNT );
+    radixSortedKeys.Resize( SUB_MESH_COUNT );
+
+    DynamicArray< uint32_t > radixSortedIndices;
+    radixSortedIndices.Reserve( SUB_MESH_COUNT );
+    radixSortedIndices.Resize( SUB_MESH_COUNT );
+
+    DynamicArray< uint64_t > scratchKeys;
+    scratchKeys.Reserve( SUB_MESH_COUNT );
+    scratchKeys.Resize( SUB_MESH_COUNT );
+
+    DynamicArray< uint32_t > scratchIndices;
+    scratchIndices.Reserve( SUB_MESH_COUNT );
+    scratchIndices.Resize( SUB_MESH_COUNT );
+
+    static const GraphicsScene::EDrawPass passes[] =
+    {
+        GraphicsScene::DRAW_PASS_DEPTH_PRE_PASS,
+        GraphicsScene::DRAW_PASS_BASE
+    };
+
+    for( size_t passIndex = 0; passIndex < HELIUM_ARRAY_COUNT( passes ); ++passIndex )
+    {
+        GraphicsScene::EDrawPass pass = passes[ passIndex ];
+
+        for( size_t subMeshIndex = 0; subMeshIndex < SUB_MESH_COUNT; ++subMeshIndex )
+        {
+            const DrawSortTestSubMesh& rSubMesh = subMeshes[ subMeshIndex ];
+            keys[ subMeshIndex ] = GraphicsScene::ComputeDrawKey(
+                pass,
+                rSubMesh.depth,
+                rSubMesh.pVertexBuffer,
+                rSubMesh.pMaterial,
+                rSubMesh.pVertexShaderVariant,
+                rSubMesh.pPixelShaderVariant );
+        }
+
+        // Sort sub-mesh indices using a comparison function that looks up the draw key for each comparison.
+        uint64_t startTickCount = Timer::GetTickCount();
+        for( size_t iterationIndex = 0; iterationIndex < ITERATION_COUNT; ++iterationIndex )
+        {
+            for( size_t subMeshIndex = 0; subMeshIndex < SUB_MESH_COUNT; ++subMeshIndex )
+            {
+                compareSortedIndices[ subMeshIndex ] = static_cast< uint32_t >( subMeshIndex );
+            }
+
+            JobContext::Spawner< 1 > rootSpawner;
+            JobContext* pContext = rootSpawner.Allocate();
+            HELIUM_ASSERT( pContext );
+            SortJob< uint32_t, DrawSortTestCompare >* pJob =
+                pContext->Create< SortJob< uint32_t, DrawSortTestCompare > >();
+            HELIUM_ASSERT( pJob );
+
+            SortJob< uint32_t, DrawSortTestCompare >::Parameters& rParameters = pJob->GetParameters();
+            rParameters.pBase = compareSortedIndices.GetData();
+            rParameters.count = SUB_MESH_COUNT;
+            rParameters.compare = DrawSortTestCompare( keys.GetData() );
+            rParameters.singleJobCount = 100;
+        }
+
+        uint64_t compareTickCount = Timer::GetTickCount() - startTickCount;
+
+        // Sort the draw keys directly using a radix sort.
+        startTickCount = Timer::GetTickCount();
+        for( size_t iterationIndex = 0; iterationIndex < ITERATION_COUNT; ++iterationIndex )
+        {
+            MemoryCopy( radixSortedKeys.GetData(), keys.GetData(), SUB_MESH_COUNT * sizeof( uint64_t ) );
+            for( size_t subMeshIndex = 0; subMeshIndex < SUB_MESH_COUNT; ++subMeshIndex )
+            {
+                radixSortedIndices[ subMeshIndex ] = static_cast< uint32_t >( subMeshIndex );
+            }
+
+            JobContext::Spawner< 1 > rootSpawner;
+            JobContext* pContext = rootSpawner.Allocate();
+            HELIUM_ASSERT( pContext );
+            RadixSortJob* pJob = pContext->Create< RadixSortJob >();
+            HELIUM_ASSERT( pJob );
+
+            RadixSortJob::Parameters& rParameters = pJob->GetParameters();
+            rParameters.pKeys = radixSortedKeys.GetData();
+            rParameters.pValues = radixSortedIndices.GetData();
+            rParameters.pScratchKeys = scratchKeys.GetData();
+            rParameters.pScratchValues = scratchIndices.GetData();
+            rParameters.count = SUB_MESH_COUNT;
+        }
+
+        uint64_t radixTickCount = Timer::GetTickCount() - startTickCount;
+
+        // Both sorts should produce exactly the same order.
+        for( size_t sortedIndex = 0; sortedIndex < SUB_MESH_COUNT; ++sortedIndex )
+        {
+            HELIUM_ASSERT( radixSortedIndices[ sortedIndex ] == compareSortedIndices[ sortedIndex ] );
+            HELIUM_ASSERT( radixSortedKeys[ sortedIndex ] == keys[ radixSortedIndices[ sortedIndex ] ] );
+        }
+
+        if( pass == GraphicsScene::DRAW_PASS_BASE )
+        {
+            // Sub-meshes should be grouped by shader, then by material.
+            bool shadersSeen[ SHADER_COUNT ] = { false };
+            bool materialsSeen[ MATERIAL_COUNT ] = { false };
+            for( size_t sortedIndex = 0; sortedIndex < SUB_MESH_COUNT; ++sortedIndex )
+            {
+                const DrawSortTestSubMesh& rSubMesh = subMeshes[ radixSortedIndices[ sortedIndex ] ];
+                const DrawSortTestSubMesh* pPreviousSubMesh =
+                    ( sortedIndex != 0 ? &subMeshes[ radixSortedIndices[ sortedIndex - 1 ] ] : NULL );
+
+                if( !pPreviousSubMesh || pPreviousSubMesh->shaderIndex != rSubMesh.shaderIndex )
+                {
+                    HELIUM_ASSERT( !shadersSeen[ rSubMesh.shaderIndex ] );
+                    shadersSeen[ rSubMesh.shaderIndex ] = true;
+                }
+
+                if( !pPreviousSubMesh || pPreviousSubMesh->materialIndex != rSubMesh.materialIndex )
+                {
+                    HELIUM_ASSERT( !materialsSeen[ rSubMesh.materialIndex ] );
+                    materialsSeen[ rSubMesh.materialIndex ] = true;
+                }
+            }
+        }
+        else
+        {
+            // Sub-meshes should be sorted from front to back.
+            for( size_t sortedIndex = 1; sortedIndex < SUB_MESH_COUNT; ++sortedIndex )
+            {
+                HELIUM_ASSERT(
+                    subMeshes[ radixSortedIndices[ sortedIndex - 1 ] ].depth <=
+                    subMeshes[ radixSortedIndices[ sortedIndex ] ].depth );
+            }
+        }
+
+        float64_t millisecondsPerIteration =
+            Timer::GetSecondsPerTick() * 1000.0 / static_cast< float64_t >( ITERATION_COUNT );
+        HELIUM_TRACE(
+            TraceLevels::Info,
+            ( TXT( "Sorted %" ) TPRIuSZ TXT( " sub-meshes for draw pass %" ) TPRIuSZ
+              TXT( ": comparison sort %f ms, draw key radix sort %f ms\n" ) ),
+            SUB_MESH_COUNT,
+            static_cast< size_t >( pass ),
+            static_cast< float64_t >( compareTickCount ) * millisecondsPerIteration,
+            static_cast< float64_t >( radixTickCount ) * millisecondsPerIteration );
+        HELIUM_UNREF( compareTickCount );
+        HELIUM_UNREF( radixTickCount );
+        HELIUM_UNREF( millisecondsPerIteration );
+    }
+}
+
+static void RecordHeadlessTestBatch( RRenderCommandProxy* pCommandProxy, uint32_t batchIndex )
+{
+    HELIUM_ASSERT( pCommandProxy );
+
+    RConstantBuffer* constantBuffers[ 2 ] = { NULL, NULL };
+    size_t limitSizes[ 2 ] = { 64, 128 };
+
+    pCommandProxy->SetViewport( 0, 0, 64 + batchIndex, 64 );
+    pCommandProxy->Clear( RENDERER_CLEAR_FLAG_DEPTH, Color( 0xff000000 ), 1.0f, 0 );
+    pCommandProxy->SetVertexShader( NULL );
+    pCommandProxy->SetVertexConstantBuffers( 0, 2, constantBuffers, limitSizes );
+    pCommandProxy->SetIndexBuffer( NULL );
+    pCommandProxy->DrawIndexed( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST, 0, 0, 3 * batchIndex + 3, 0, batchIndex + 1 );
+    pCommandProxy->DrawUnindexed( RENDERER_PRIMITIVE_TYPE_LINE_LIST, batchIndex, 2 );
+}
+
+TEST(Graphics, HeadlessCommandStreamEquivalence)
+{
+    static const uint32_t BATCH_COUNT = 4;
+
+    // Record all batches directly on one proxy.
+    HeadlessCommandProxyPtr spImmediateProxy = new HeadlessCommandProxy;
+    HELIUM_ASSERT( spImmediateProxy );
+    for( uint32_t batchIndex = 0; batchIndex < BATCH_COUNT; ++batchIndex )
+    {
+        RecordHeadlessTestBatch( spImmediateProxy, batchIndex );
+    }
+
+    // Record each batch on its own deferred proxy, and execute the resulting command lists in order.
+    HeadlessCommandProxyPtr spExecutingProxy = new HeadlessCommandProxy;
+    HELIUM_ASSERT( spExecutingProxy );
+    for( uint32_t batchIndex = 0; batchIndex < BATCH_COUNT; ++batchIndex )
+    {
+        HeadlessCommandProxyPtr spDeferredProxy = new HeadlessCommandProxy;
+        HELIUM_ASSERT( spDeferredProxy );
+        RecordHeadlessTestBatch( spDeferredProxy, batchIndex );
+
+        RRenderCommandListPtr spCommandList;
+        spDeferredProxy->FinishCommandList( spCommandList );
+        HELIUM_ASSERT( spCommandList );
+        HELIUM_ASSERT( spDeferredProxy->GetStreamSize() == 0 );
+
+        spExecutingProxy->ExecuteCommandList( spCommandList );
+    }
+
+    size_t streamSize = spImmediateProxy->GetStreamSize();
+    HELIUM_ASSERT( streamSize != 0 );
+    HELIUM_ASSERT( spExecutingProxy->GetStreamSize() == streamSize );
+    HELIUM_ASSERT(
+        MemoryCompare( spExecutingProxy->GetStreamData(), spImmediateProxy->GetStreamData(), streamSize ) == 0 );
+
+    const HeadlessCommandProxy::Statistics& rImmediateStatistics = spImmediateProxy->GetStatistics();
+    const HeadlessCommandProxy::Statistics& rExecutingStatistics = spExecutingProxy->GetStatistics();
+    HELIUM_ASSERT( rImmediateStatistics.commandCount == BATCH_COUNT * 7 );
+    HELIUM_ASSERT( rImmediateStatistics.drawCallCount == BATCH_COUNT * 2 );
+    HELIUM_ASSERT( rImmediateStatistics.primitiveCount == BATCH_COUNT * 2 + BATCH_COUNT * ( BATCH_COUNT + 1 ) / 2 );
+    HELIUM_ASSERT( rImmediateStatistics.commandListCount == 0 );
+    HELIUM_ASSERT( rExecutingStatistics.commandCount == rImmediateStatistics.commandCount );
+    HELIUM_ASSERT( rExecutingStatistics.drawCallCount == rImmediateStatistics.drawCallCount );
+    HELIUM_ASSERT( rExecutingStatistics.primitiveCount == rImmediateStatistics.primitiveCount );
+    HELIUM_ASSERT( rExecutingStatistics.stateChangeCount == rImmediateStatistics.stateChangeCount );
+    HELIUM_ASSERT( rExecutingStatistics.resourceBindCount == rImmediateStatistics.resourceBindCount );
+    HELIUM_ASSERT( rExecutingStatistics.clearCount == rImmediateStatistics.clearCount );
+    HELIUM_ASSERT( rExecutingStatistics.commandListCount == BATCH_COUNT );
+
+    HELIUM_UNREF( streamSize );
+    HELIUM_UNREF( rImmediateStatistics );
+    HELIUM_UNREF( rExecutingStatistics );
+}
+
+TEST(Graphics, ParallelRecordingEquivalence)
+{
+    // Number of scene updates captured in each recording mode.  This covers a full cycle of the double-buffered
+    // constant buffer sets, so both modes start and end on the same buffers.
+    static const uint32_t CAPTURE_UPDATE_COUNT = 2;
+
+    HeadlessTestScene testScene;
+    HELIUM_VERIFY( testScene.Initialize( 2 ) );
+
+    HeadlessRenderer* pRenderer = testScene.GetRenderer();
+    HELIUM_ASSERT( pRenderer );
+    GraphicsScene* pScene = testScene.GetGraphicsScene();
+    HELIUM_ASSERT( pScene );
+
+    // Attach the scene entities and let the graphics scene allocate all of its per-frame resources.
+    WorldManager::GetStaticInstance().Update();
+    for( uint32_t updateIndex = 0; updateIndex < CAPTURE_UPDATE_COUNT; ++updateIndex )
+    {
+        pScene->Update();
+    }
+
+    DynamicArray< uint8_t > streams[ 2 ];
+    HeadlessRenderer::Statistics statistics[ 2 ];
+    for( size_t modeIndex = 0; modeIndex < HELIUM_ARRAY_COUNT( streams ); ++modeIndex )
+    {
+        pScene->SetParallelRecordingEnabled( modeIndex == 0 );
+
+        pRenderer->ResetStatistics();
+        pRenderer->SetCommandStreamCapture( &streams[ modeIndex ] );
+        for( uint32_t updateIndex = 0; updateIndex < CAPTURE_UPDATE_COUNT; ++updateIndex )
+        {
+            pScene->Update();
+        }
+
+        pRenderer->SetCommandStreamCapture( NULL );
+        pRenderer->GetStatistics( statistics[ modeIndex ] );
+    }
+
+    pScene->SetParallelRecordingEnabled( true );
+
+    const DynamicArray< uint8_t >& rParallelStream = streams[ 0 ];
+    const DynamicArray< uint8_t >& rSerialStream = streams[ 1 ];
+    size_t streamSize = rSerialStream.GetSize();
+    HELIUM_ASSERT( streamSize != 0 );
+    HELIUM_ASSERT( rParallelStream.GetSize() == streamSize );
+    HELIUM_ASSERT( MemoryCompare( rParallelStream.GetData(), rSerialStream.GetData(), streamSize ) == 0 );
+
+    const HeadlessRenderer::Statistics& rParallelStatistics = statistics[ 0 ];
+    const HeadlessRenderer::Statistics& rSerialStatistics = statistics[ 1 ];
+    HELIUM_ASSERT( rSerialStatistics.bytesUploaded == rParallelStatistics.bytesUploaded );
+    HELIUM_ASSERT( rSerialStatistics.uploadCount == rParallelStatistics.uploadCount );
+    HELIUM_ASSERT( rSerialStatistics.swapCount == rParallelStatistics.swapCount );
+
+    const HeadlessCommandProxy::Statistics& rParallelCommands = rParallelStatistics.commandStatistics;
+    const HeadlessCommandProxy::Statistics& rSerialCommands = rSerialStatistics.commandStatistics;
+    HELIUM_ASSERT( rSerialCommands.drawCallCount != 0 );
+    HELIUM_ASSERT( rSerialCommands.commandCount == rParallelCommands.commandCount );
+    HELIUM_ASSERT( rSerialCommands.drawCallCount == rParallelCommands.drawCallCount );
+    HELIUM_ASSERT( rSerialCommands.primitiveCount == rParallelCommands.primitiveCount );
+    HELIUM_ASSERT( rSerialCommands.stateChangeCount == rParallelCommands.stateChangeCount );
+    HELIUM_ASSERT( rSerialCommands.resourceBindCount == rParallelCommands.resourceBindCount );
+    HELIUM_ASSERT( rSerialCommands.clearCount == rParallelCommands.clearCount );
+
+    // Only parallel recording should go through deferred command lists.
+    HELIUM_ASSERT( rParallelCommands.commandListCount != 0 );
+    HELIUM_ASSERT( rSerialCommands.commandListCount == 0 );
+
+    HELIUM_UNREF( streamSize );
+    HELIUM_UNREF( rParallelStream );
+    HELIUM_UNREF( rSerialStream );
+    HELIUM_UNREF( rParallelCommands );
+    HELIUM_UNREF( rSerialCommands );
+
+    testScene.Shutdown();
+}
+
+#if HELIUM_TOOLS
+static void WriteDependencyTestFile( const tchar_t* pFileName, const char* pContents )
+{
+    FileStream* pStream = FileStream::OpenFileStream( pFileName, FileStream::MODE_WRITE, true );
+    HELIUM_ASSERT( pStream );
+    pStream->Write( pContents, 1, StringLength( pContents ) );
+    delete pStream;
+}
+
+TEST(PcSupport, DependencyDatabase)
+{
+    const tchar_t* pIncludeFileName = TXT( "DependencyDatabaseTest.inc" );
+    const tchar_t* pDatabaseFileName = TXT( "DependencyDatabaseTest.hdb" );
+
+    // Start from a clean state in case a previous run did not finish.
+    DeleteTestFile( pIncludeFileName );
+    DeleteTestFile( pDatabaseFileName );
+
+    DependencyDatabase database;
+    HELIUM_VERIFY( database.Initialize( pDatabaseFileName ) );
+
+    GameObjectPath shaderPath;
+    HELIUM_VERIFY( shaderPath.Set(
+        HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "DependencyTest" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "Shader" ) ) );
+    GameObjectPath materialPath;
+    HELIUM_VERIFY( materialPath.Set(
+        HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "DependencyTest" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "Material" ) ) );
+
+    // Record a shader that includes a file, and a material that depends on the shader.
+    WriteDependencyTestFile( pIncludeFileName, "float4 Color;" );
+
+    database.BeginObjectRecord( shaderPath, NULL, 1, 0 );
+    database.AddFileDependency( shaderPath, pIncludeFileName );
+    uint64_t shaderKey = database.EndObjectRecord( shaderPath, true );
+
+    database.BeginObjectRecord( materialPath, NULL, 2, 0 );
+    database.AddObjectDependency( materialPath, shaderPath );
+    uint64_t materialKey = database.EndObjectRecord( materialPath, true );
+
+    HELIUM_ASSERT( database.ComputeObjectKey( shaderPath, NULL, 1, 0 ) == shaderKey );
+    HELIUM_ASSERT( database.ComputeObjectKey( materialPath, NULL, 2, 0 ) == materialKey );
+
+    // Object data and handler version changes alter the key.
+    HELIUM_ASSERT( database.ComputeObjectKey( shaderPath, NULL, 3, 0 ) != shaderKey );
+    HELIUM_ASSERT( database.ComputeObjectKey( shaderPath, NULL, 1, 1 ) != shaderKey );
+
+    DynamicArray< GameObjectPath > dependents;
+    database.GetFileDependents( pIncludeFileName, dependents );
+    HELIUM_ASSERT( dependents.GetSize() == 2 );
+
+    // Changing the include file contents propagates to both the shader and the material.
+    WriteDependencyTestFile( pIncludeFileName, "float4 Color; float4 Tint;" );
+    HELIUM_ASSERT( database.ComputeObjectKey( shaderPath, NULL, 1, 0 ) != shaderKey );
+    HELIUM_ASSERT( database.ComputeObjectKey( materialPath, NULL, 2, 0 ) != materialKey );
+
+    // Records survive saving and reloading the database.
+    database.BeginObjectRecord( shaderPath, NULL, 1, 0 );
+    database.AddFileDependency( shaderPath, pIncludeFileName );
+    shaderKey = database.EndObjectRecord( shaderPath, true );
+    HELIUM_VERIFY( database.Save() );
+    database.Shutdown();
+
+    HELIUM_VERIFY( database.Initialize( pDatabaseFileName ) );
+    uint64_t loadedKey = 0;
+    HELIUM_VERIFY( database.GetObjectKey( shaderPath, loadedKey ) );
+    HELIUM_ASSERT( loadedKey == shaderKey );
+    HELIUM_ASSERT( database.ComputeObjectKey( shaderPath, NULL, 1, 0 ) == shaderKey );
+    HELIUM_UNREF( loadedKey );
+    HELIUM_UNREF( materialKey );
+
+    database.Shutdown();
+
+    DeleteTestFile( pIncludeFileName );
+    DeleteTestFile( pDatabaseFileName );
+}
+#endif  // HELIUM_TOOLS
@@ -0,0 +1,223 @@
+#include "TestAppPch.h"
+#include "HeadlessTestScene.h"
+
+using namespace Helium;
+
+/// Constructor.
+HeadlessTestScene::HeadlessTestScene()
+{
+}
+
+/// Destructor.
+HeadlessTestScene::~HeadlessTestScene()
+{
+    Shutdown();
+}
+
+/// Create the headless renderer and set up the test scene.
+///
+/// @param[in] meshGridSize  Number of mesh entities to place along each axis of a square grid in the scene.
+///
+/// @return  True if initialization was successful, false if the headless renderer could not be created.
+///
+/// @see Shutdown()
+bool HeadlessTestScene::Initialize( uint32_t meshGridSize )
+{
+    HELIUM_ASSERT( !m_spWorld );
+
+    HeadlessRendererInitialization rendererInitialization;
+    if( !rendererInitialization.Initialize() )
+    {
+        HELIUM_TRACE( TraceLevels::Error, TXT( "HeadlessTestScene: Failed to initialize the headless renderer.\n" ) );
+
+        return false;
+    }
+
+    uint32_t displayWidth;
+    uint32_t displayHeight;
+
+    {
+        Config& rConfig = Config::GetStaticInstance();
+        StrongPtr< GraphicsConfig > spGraphicsConfig(
+            rConfig.GetConfigObject< GraphicsConfig >( Name( TXT( "GraphicsConfig" ) ) ) );
+        HELIUM_ASSERT( spGraphicsConfig );
+        displayWidth = spGraphicsConfig->GetWidth();
+        displayHeight = spGraphicsConfig->GetHeight();
+    }
+
+    Renderer* pRenderer = Renderer::GetStaticInstance();
+    HELIUM_ASSERT( pRenderer );
+
+    Renderer::ContextInitParameters contextInitParams;
+    contextInitParams.displayWidth = displayWidth;
+    contextInitParams.displayHeight = displayHeight;
+    HELIUM_VERIFY( pRenderer->CreateMainContext( contextInitParams ) );
+
+    RRenderContextPtr spSubRenderContext = pRenderer->CreateSubContext( contextInitParams );
+    HELIUM_ASSERT( spSubRenderContext );
+
+    RenderResourceManager& rRenderResourceManager = RenderResourceManager::GetStaticInstance();
+    rRenderResourceManager.Initialize();
+    rRenderResourceManager.UpdateMaxViewportSize( displayWidth, displayHeight );
+
+    DynamicDrawer& rDynamicDrawer = DynamicDrawer::GetStaticInstance();
+    HELIUM_VERIFY( rDynamicDrawer.Initialize() );
+
+    RRenderContextPtr spMainRenderContext = pRenderer->GetMainContext();
+    HELIUM_ASSERT( spMainRenderContext );
+
+    WorldManager& rWorldManager = WorldManager::GetStaticInstance();
+    HELIUM_VERIFY( rWorldManager.Initialize() );
+
+    m_spWorld = rWorldManager.CreateDefaultWorld();
+    HELIUM_ASSERT( m_spWorld );
+    HELIUM_VERIFY( m_spWorld->Initialize() );
+
+    HELIUM_VERIFY( GameObject::Create< Package >( m_spLayerPackage, Name( TXT( "DefaultLayerPackage" ) ), NULL ) );
+    HELIUM_ASSERT( m_spLayerPackage );
+
+    HELIUM_VERIFY( GameObject::Create< Layer >( m_spLayer, Name( TXT( "Layer" ) ), m_spLayerPackage ) );
+    HELIUM_ASSERT( m_spLayer );
+    m_spLayer->BindPackage( m_spLayerPackage );
+
+    HELIUM_VERIFY( m_spWorld->AddLayer( m_spLayer ) );
+
+    m_spCameras[ 0 ] = Reflect::AssertCast< Camera >( m_spWorld->CreateEntity(
+        m_spLayer,
+        Camera::GetStaticType(),
+        Simd::Vector3( 0.0f, 200.0f, 750.0f ),
+        Simd::Quat( 0.0f, static_cast< float32_t >( HELIUM_PI ), 0.0f ),
+        Simd::Vector3( 1.0f ),
+        NULL,
+        NULL_NAME,
+        true ) );
+    HELIUM_ASSERT( m_spCameras[ 0 ] );
+
+    m_spCameras[ 1 ] = Reflect::AssertCast< Camera >( m_spWorld->CreateEntity(
+        m_spLayer,
+        Camera::GetStaticType(),
+        Simd::Vector3( 750.0f, 200.0f, 0.0f ),
+        Simd::Quat( 0.0f, static_cast< float32_t >( -HELIUM_PI_2 ), 0.0f ),
+        Simd::Vector3( 1.0f ),
+        NULL,
+        NULL_NAME,
+        true ) );
+    HELIUM_ASSERT( m_spCameras[ 1 ] );
+
+    GraphicsScene* pGraphicsScene = m_spWorld->GetGraphicsScene();
+    HELIUM_ASSERT( pGraphicsScene );
+
+    RSurface* pDepthStencilSurface = rRenderResourceManager.GetDepthStencilSurface();
+    HELIUM_ASSERT( pDepthStencilSurface );
+
+    float32_t aspectRatio = static_cast< float32_t >( displayWidth ) / static_cast< float32_t >( displayHeight );
+
+    RRenderContext* const viewRenderContexts[] = { spMainRenderContext, spSubRenderContext };
+    HELIUM_COMPILE_ASSERT( HELIUM_ARRAY_COUNT( viewRenderContexts ) == HELIUM_ARRAY_COUNT( m_spCameras ) );
+    for( size_t viewIndex = 0; viewIndex < HELIUM_ARRAY_COUNT( m_spCameras ); ++viewIndex )
+    {
+        uint32_t sceneViewId = pGraphicsScene->AllocateSceneView();
+        HELIUM_ASSERT( IsValid( sceneViewId ) );
+
+        GraphicsSceneView* pSceneView = pGraphicsScene->GetSceneView( sceneViewId );
+        HELIUM_ASSERT( pSceneView );
+        pSceneView->SetRenderContext( viewRenderContexts[ viewIndex ] );
+        pSceneView->SetDepthStencilSurface( pDepthStencilSurface );
+        pSceneView->SetAspectRatio( aspectRatio );
+        pSceneView->SetViewport( 0, 0, displayWidth, displayHeight );
+        pSceneView->SetClearColor( Color( 0x00202020 ) );
+
+        m_spCameras[ viewIndex ]->SetSceneViewId( sceneViewId );
+    }
+
+    GameObjectLoader* pObjectLoader = GameObjectLoader::GetStaticInstance();
+    HELIUM_ASSERT( pObjectLoader );
+
+    GameObjectPath meshPath;
+    HELIUM_VERIFY( meshPath.Set(
+        HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "Meshes" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "TestBull.fbx" ) ) );
+
+    GameObjectPtr spMeshObject;
+    HELIUM_VERIFY( pObjectLoader->LoadObject( meshPath, spMeshObject ) );
+    HELIUM_ASSERT( spMeshObject );
+    Mesh* pMesh = Reflect::AssertCast< Mesh >( spMeshObject.Get() );
+
+    GameObjectPath animationPath;
+    HELIUM_VERIFY( animationPath.Set(
+        HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "Animations" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "TestBull_anim.fbx" ) ) );
+
+    GameObjectPtr spAnimationObject;
+    HELIUM_VERIFY( pObjectLoader->LoadObject( animationPath, spAnimationObject ) );
+    HELIUM_ASSERT( spAnimationObject );
+    Animation* pAnimation = Reflect::AssertCast< Animation >( spAnimationObject.Get() );
+
+    float32_t gridOffset = static_cast< float32_t >( meshGridSize - 1 ) * 0.5f;
+    for( uint32_t gridZ = 0; gridZ < meshGridSize; ++gridZ )
+    {
+        for( uint32_t gridX = 0; gridX < meshGridSize; ++gridX )
+        {
+            SkeletalMeshEntityPtr spMeshEntity( Reflect::AssertCast< SkeletalMeshEntity >( m_spWorld->CreateEntity(
+                m_spLayer,
+                SkeletalMeshEntity::GetStaticType(),
+                Simd::Vector3(
+                    ( static_cast< float32_t >( gridX ) - gridOffset ) * 200.0f,
+                    -20.0f,
+                    ( static_cast< float32_t >( gridZ ) - gridOffset ) * 200.0f ) ) ) );
+            HELIUM_ASSERT( spMeshEntity );
+            spMeshEntity->SetMesh( pMesh );
+            spMeshEntity->SetAnimation( pAnimation );
+
+            m_meshEntities.Push( spMeshEntity );
+        }
+    }
+
+    return true;
+}
+
+/// Destroy the test scene along with the headless renderer and the systems created by Initialize().
+///
+/// @see Initialize()
+void HeadlessTestScene::Shutdown()
+{
+    if( !m_spWorld )
+    {
+        return;
+    }
+
+    m_meshEntities.Clear();
+    m_spCameras[ 1 ].Release();
+    m_spCameras[ 0 ].Release();
+
+    m_spWorld->Shutdown();
+
+    if( m_spLayer )
+    {
+        m_spLayer->BindPackage( NULL );
+    }
+
+    m_spLayerPackage.Release();
+    m_spLayer.Release();
+    m_spWorld.Release();
+    WorldManager::DestroyStaticInstance();
+
+    DynamicDrawer::DestroyStaticInstance();
+    RenderResourceManager::DestroyStaticInstance();
+
+    Renderer::DestroyStaticInstance();
+}
+
+/// Get the headless renderer used to render the test scene.
+///
+/// @return  Headless renderer instance.
+HeadlessRenderer* HeadlessTestScene::GetRenderer() const
+{
+    return static_cast< HeadlessRenderer* >( Renderer::GetStaticInstance() );
+}
+
+/// Get the graphics scene of the test world.
+///
+/// @return  Test world graphics scene, or null if the scene has not been initialized.
+GraphicsScene* HeadlessTestScene::GetGraphicsScene() const
+{
+    return ( m_spWorld ? m_spWorld->GetGraphicsScene() : NULL );
+}
@@ -0,0 +1,47 @@
+//----------------------------------------------------------------------------------------------------------------------
+// HeadlessTestScene.h
+//
+// Copyright (C) 2010 WhiteMoon Dreams, Inc.
+// All Rights Reserved
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+
+/// Test scene rendered using the headless renderer.
+///
+/// The scene is set up like the one displayed by the interactive test application (two views of animated meshes),
+/// but no windows are created and no display device is needed.  Initialize() creates the headless renderer along with
+/// the rendering and world systems it depends on, and Shutdown() destroys all of them again.
+class HeadlessTestScene : Helium::NonCopyable
+{
+public:
+    /// @name Construction/Destruction
+    //@{
+    HeadlessTestScene();
+    ~HeadlessTestScene();
+    //@}
+
+    /// @name Initialization
+    //@{
+    bool Initialize( uint32_t meshGridSize );
+    void Shutdown();
+    //@}
+
+    /// @name Data Access
+    //@{
+    Helium::HeadlessRenderer* GetRenderer() const;
+    Helium::GraphicsScene* GetGraphicsScene() const;
+    //@}
+
+private:
+    /// World containing the scene entities.
+    Helium::WorldPtr m_spWorld;
+    /// Package bound to the scene layer.
+    Helium::PackagePtr m_spLayerPackage;
+    /// Layer containing the scene entities.
+    Helium::LayerPtr m_spLayer;
+    /// Cameras for each scene view.
+    Helium::CameraPtr m_spCameras[ 2 ];
+    /// Mesh entities in the scene.
+    Helium::DynamicArray< Helium::SkeletalMeshEntityPtr > m_meshEntities;
+};
@@ -15,6 +15,7 @@
 #include "PcSupport/ArchivePackageLoader.h"
 
 #include "gtest.h"
+#include "HeadlessTestScene.h"
 #include "TestGameObject.h"
 #include "WindowProc.h"
 
@@ -69,13 +70,182 @@ void TestComponentFour::PopulateComposite( Reflect::Composite& comp )
 }
 
 
-int APIENTRY _tWinMain( HINSTANCE hInstance, HINSTANCE /*hPrevInstance*/, LPTSTR /*lpCmdLine*/, int nCmdShow )
+/// Shut down all engine systems initialized by _tWinMain().
+static void ShutdownTestApp()
+{
+    JobManager::DestroyStaticInstance();
+
+    Config::DestroyStaticInstance();
+
+#if HELIUM_TOOLS
+    ObjectPreprocessor::DestroyStaticInstance();
+#endif
+    GameObjectLoader::DestroyStaticInstance();
+    CacheManager::DestroyStaticInstance();
+
+#if HELIUM_TOOLS
+    FontResourceHandler::DestroyStaticLibrary();
+#endif
+
+#if HELIUM_TOOLS
+    UnregisterEditorSupportTypes();
+#endif
+    UnregisterPcSupportTypes();
+    UnregisterFrameworkTypes();
+    UnregisterGraphicsTypes();
+    UnregisterEngineTypes();
+
+    GameObjectType::Shutdown();
+    GameObject::Shutdown();
+
+    AsyncLoader::DestroyStaticInstance();
+
+    Reflect::Cleanup();
+
+    Reflect::ObjectRefCountSupport::Shutdown();
+
+    GameObjectPath::Shutdown();
+    Name::Shutdown();
+
+    FileLocations::Shutdown();
+
+    ThreadLocalStackAllocator::ReleaseMemoryHeap();
+
+#if HELIUM_ENABLE_MEMORY_TRACKING
+    DynamicMemoryHeap::LogMemoryStats();
+    ThreadLocalStackAllocator::ReleaseMemoryHeap();
+#endif
+}
+
+/// Default number of frames to render when running headless.
+static const uint32_t HEADLESS_FRAME_COUNT_DEFAULT = 1000;
+/// Number of mesh entities to place in the scene rendered when running headless (along each axis of a square grid).
+static const uint32_t HEADLESS_MESH_GRID_SIZE = 4;
+
+/// Render a number of frames using the headless renderer and report the renderer statistics.
+///
+/// No windows are created and no device is needed, so the CPU cost of the frame rendering path can be measured on any
+/// system (see HeadlessTestScene).
+///
+/// @param[in] frameCount  Number of frames to render.
+///
+/// @return  True if all frames were rendered, false if the headless renderer could not be initialized.
+static bool RunHeadless( uint32_t frameCount )
+{
+    HeadlessTestScene testScene;
+    if( !testScene.Initialize( HEADLESS_MESH_GRID_SIZE ) )
+    {
+        return false;
+    }
+
+    HeadlessRenderer* pRenderer = testScene.GetRenderer();
+    HELIUM_ASSERT( pRenderer );
+
+    WorldManager& rWorldManager = WorldManager::GetStaticInstance();
+
+    // Let the first frame finish creating any remaining resources before gathering statistics.
+    rWorldManager.Update();
+    pRenderer->ResetStatistics();
+
+    uint64_t startTickCount = Timer::GetTickCount();
+
+    for( uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex )
+    {
+        rWorldManager.Update();
+    }
+
+    float64_t elapsedSeconds =
+        static_cast< float64_t >( Timer::GetTickCount() - startTickCount ) * Timer::GetSecondsPerTick();
+
+    HeadlessRenderer::Statistics statistics;
+    pRenderer->GetStatistics( statistics );
+
+    const HeadlessCommandProxy::Statistics& rCommandStatistics = statistics.commandStatistics;
+    float64_t frameScale = ( frameCount != 0 ? 1.0 / static_cast< float64_t >( frameCount ) : 0.0 );
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "TestApp: Rendered %" ) TPRIu32 TXT( " headless frames in %.3f sec (%.3f msec/frame).\n" ),
+        frameCount,
+        elapsedSeconds,
+        elapsedSeconds * 1000.0 * frameScale );
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "TestApp: Draw calls: %" ) TPRIu32 TXT( " (%.1f/frame).\n" ),
+        rCommandStatistics.drawCallCount,
+        static_cast< float64_t >( rCommandStatistics.drawCallCount ) * frameScale );
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "TestApp: State changes: %" ) TPRIu32 TXT( " (%.1f/frame).\n" ),
+        rCommandStatistics.stateChangeCount,
+        static_cast< float64_t >( rCommandStatistics.stateChangeCount ) * frameScale );
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "TestApp: Resource binds: %" ) TPRIu32 TXT( " (%.1f/frame).\n" ),
+        rCommandStatistics.resourceBindCount,
+        static_cast< float64_t >( rCommandStatistics.resourceBindCount ) * frameScale );
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "TestApp: Bytes uploaded: %" ) TPRIu64 TXT( " (%.1f/frame).\n" ),
+        statistics.bytesUploaded,
+        static_cast< float64_t >( statistics.bytesUploaded ) * frameScale );
+
+    testScene.Shutdown();
+
+    return true;
+}
+
+/// Get the async loader backend specified on the command line ("-asyncbackend <name>").
+///
+/// @param[in] pCommandLine  Command-line string (can be null).
+///
+/// @return  Async loader backend to use.
+static AsyncLoader::EBackend GetAsyncLoaderBackend( const tchar_t* pCommandLine )
+{
+    const tchar_t* pOption = ( pCommandLine ? _tcsstr( pCommandLine, TXT( "-asyncbackend" ) ) : NULL );
+    if( !pOption )
+    {
+        return AsyncLoader::BACKEND_STREAM;
+    }
+
+    pOption += StringLength( TXT( "-asyncbackend" ) );
+    while( *pOption == TXT( ' ' ) )
+    {
+        ++pOption;
+    }
+
+    tchar_t backendName[ 32 ];
+    size_t nameLength = 0;
+    while( pOption[ nameLength ] != TXT( '\0' ) && pOption[ nameLength ] != TXT( ' ' ) &&
+           nameLength < HELIUM_ARRAY_COUNT( backendName ) - 1 )
+    {
+        backendName[ nameLength ] = pOption[ nameLength ];
+        ++nameLength;
+    }
+
+    backendName[ nameLength ] = TXT( '\0' );
+
+    AsyncLoader::EBackend backend = AsyncLoader::FindBackend( backendName );
+    if( backend == AsyncLoader::BACKEND_INVALID )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            TXT( "TestApp: Unknown async loader backend \"%s\", using file streams.\n" ),
+            backendName );
+
+        return AsyncLoader::BACKEND_STREAM;
+    }
+
+    return backend;
+}
+
+int APIENTRY _tWinMain( HINSTANCE hInstance, HINSTANCE /*hPrevInstance*/, LPTSTR lpCmdLine, int nCmdShow )
 {
     HELIUM_TRACE_SET_LEVEL( TraceLevels::Debug );
 
     Timer::StaticInitialize();
 
-    AsyncLoader::GetStaticInstance().Initialize();
+    AsyncLoader::GetStaticInstance().Initialize( 0, GetAsyncLoaderBackend( lpCmdLine ) );
 
     FilePath baseDirectory;
     if ( !FileLocations::GetBaseDirectory( baseDirectory ) )
@@ -319,6 +489,45 @@ int APIENTRY _tWinMain( HINSTANCE hInstance, HINSTANCE /*hPrevInstance*/, LPTSTR
     }
 
     ConfigPc::SaveUserConfig();
+
+    // Render frames with the headless renderer and report the renderer statistics in place of the test application if
+    // requested ("-headless [frame count]").
+    const tchar_t* pHeadlessOption = ( lpCmdLine ? _tcsstr( lpCmdLine, TXT( "-headless" ) ) : NULL );
+    if( pHeadlessOption )
+    {
+        uint32_t frameCount = static_cast< uint32_t >(
+            _tcstoul( pHeadlessOption + StringLength( TXT( "-headless" ) ), NULL, 10 ) );
+        if( frameCount == 0 )
+        {
+            frameCount = HEADLESS_FRAME_COUNT_DEFAULT;
+        }
+
+        HELIUM_VERIFY( JobManager::GetStaticInstance().Initialize() );
+
+        bool bHeadlessSuccess = RunHeadless( frameCount );
+
+        ShutdownTestApp();
+
+        return ( bHeadlessSuccess ? 0 : -1 );
+    }
+
+#if HELIUM_TOOLS
+    // Run a headless batch cook of all resources in place of the test application if requested.
+    if( lpCmdLine && _tcsstr( lpCmdLine, TXT( "-cook" ) ) )
+    {
+        HELIUM_VERIFY( JobManager::GetStaticInstance().Initialize() );
+
+        bool bCookSuccess;
+        {
+            BatchCooker cooker;
+            bCookSuccess = cooker.Run();
+        }
+
+        ShutdownTestApp();
+
+        return ( bCookSuccess ? 0 : -1 );
+    }
+#endif
     /*
     JobManager& rJobManager = JobManager::GetStaticInstance();
     HELIUM_VERIFY( rJobManager.Initialize() );
@@ -1641,48 +1850,7 @@ int APIENTRY _tWinMain( HINSTANCE hInstance, HINSTANCE /*hPrevInstance*/, LPTSTR
     HELIUM_TRACE( TraceLevels::Debug, TXT( "- TBB parallel_sort(): %f msec\n" ), tbbParallelAvg );
     HELIUM_TRACE( TraceLevels::Debug, TXT( "- Helium SortJob: %f msec\n" ), jobParallelAvg );
 
-    JobManager::DestroyStaticInstance();
-
-    Config::DestroyStaticInstance();
-
-#if HELIUM_TOOLS
-    ObjectPreprocessor::DestroyStaticInstance();
-#endif
-    GameObjectLoader::DestroyStaticInstance();
-    CacheManager::DestroyStaticInstance();
-
-#if HELIUM_TOOLS
-    FontResourceHandler::DestroyStaticLibrary();
-#endif
-
-#if HELIUM_TOOLS
-    UnregisterEditorSupportTypes();
-#endif
-    UnregisterPcSupportTypes();
-    UnregisterFrameworkTypes();
-    UnregisterGraphicsTypes();
-    UnregisterEngineTypes();
-
-    GameObjectType::Shutdown();
-    GameObject::Shutdown();
-
-    AsyncLoader::DestroyStaticInstance();
-
-    Reflect::Cleanup();
-
-    Reflect::ObjectRefCountSupport::Shutdown();
-
-    GameObjectPath::Shutdown();
-    Name::Shutdown();
-
-    FileLocations::Shutdown();
-
-    ThreadLocalStackAllocator::ReleaseMemoryHeap();
-
-#if HELIUM_ENABLE_MEMORY_TRACKING
-    DynamicMemoryHeap::LogMemoryStats();
-    ThreadLocalStackAllocator::ReleaseMemoryHeap();
-#endif
+    ShutdownTestApp();
 
     return windowData.resultCode;
 }
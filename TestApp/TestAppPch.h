@@ -18,11 +18,17 @@
 #include "MathSimd/Matrix44Soa.h"
 #include "MathSimd/QuatSoa.h"
 #include "MathSimd/AaBox.h"
+#include "MathSimd/Frustum.h"
+#include "MathSimd/Sphere.h"
 #include "Math/Float16.h"
 #include "Engine/GameObjectType.h"
+#include "Engine/GameObjectCopyPlan.h"
+#include "Engine/ResidencyManager.h"
 #include "Engine/Package.h"
 #include "Engine/JobManager.h"
+#include "Engine/JobScheduler.h"
 #include "Engine/JobContext.h"
+#include "Engine/JobProfiler.h"
 #include "Engine/Config.h"
 #include "Engine/CacheManager.h"
 #include "EngineJobs/EngineJobsInterface.h"
@@ -33,14 +39,19 @@
 #include "Rendering/RRenderCommandProxy.h"
 #include "Rendering/RRenderContext.h"
 #include "Rendering/RSurface.h"
+#include "RenderingHeadless/HeadlessRenderer.h"
+#include "RenderingHeadless/HeadlessCommandProxy.h"
 #include "Graphics/Animation.h"
 #include "Graphics/DynamicDrawer.h"
 #include "Graphics/Font.h"
+#include "Graphics/GraphicsScene.h"
 #include "Graphics/GraphicsConfig.h"
 #include "Graphics/Material.h"
 #include "Graphics/RenderResourceManager.h"
+#include "Graphics/SceneBoundsStream.h"
 #include "GraphicsJobs/GraphicsJobs.h"
 #include "Framework/Camera.h"
+#include "Framework/HeadlessRendererInitialization.h"
 #include "Framework/Layer.h"
 #include "Framework/Mesh.h"
 #include "Framework/SkeletalMeshEntity.h"
@@ -52,6 +63,7 @@
 #if HELIUM_TOOLS
 #include "PcSupport/ObjectPreprocessor.h"
 #include "EditorSupport/EditorObjectLoader.h"
+#include "EditorSupport/BatchCooker.h"
 #include "EditorSupport/FontResourceHandler.h"
 #include "PreprocessingPc/PcPreprocessor.h"
 #endif
@@ -45,6 +45,8 @@ HELIUM_TEST_APP_API void RegisterTestAppTypes()
     HELIUM_VERIFY( Helium::TestGameObject1::InitStaticType() );
     HELIUM_VERIFY( Helium::TestGameObject3::InitStaticType() );
     HELIUM_VERIFY( Helium::TestGameObject2::InitStaticType() );
+    HELIUM_VERIFY( Helium::TestGameObject4::InitStaticType() );
+    HELIUM_VERIFY( Helium::TestResource::InitStaticType() );
 }
 
 HELIUM_TEST_APP_API void UnregisterTestAppTypes()
@@ -52,6 +54,8 @@ HELIUM_TEST_APP_API void UnregisterTestAppTypes()
     Helium::TestGameObject1::ReleaseStaticType();
     Helium::TestGameObject3::ReleaseStaticType();
     Helium::TestGameObject2::ReleaseStaticType();
+    Helium::TestGameObject4::ReleaseStaticType();
+    Helium::TestResource::ReleaseStaticType();
 
     ReleaseTestAppTypePackage();
 }
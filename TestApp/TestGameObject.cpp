@@ -6,6 +6,8 @@
 HELIUM_IMPLEMENT_OBJECT( Helium::TestGameObject1, TestApp, 0 );
 HELIUM_IMPLEMENT_OBJECT( Helium::TestGameObject2, TestApp, 0 );
 HELIUM_IMPLEMENT_OBJECT( Helium::TestGameObject3, TestApp, 0 );
+HELIUM_IMPLEMENT_OBJECT( Helium::TestGameObject4, TestApp, 0 );
+HELIUM_IMPLEMENT_OBJECT( Helium::TestResource, TestApp, 0 );
 
 using namespace Helium;
 
@@ -27,3 +29,49 @@ void TestGameObject3::PopulateComposite( Reflect::Composite& comp )
     comp.AddField(            &TestGameObject3::m_TestValue1,               TXT( "m_TestValue1" ) );
     comp.AddField(            &TestGameObject3::m_TestValue2,               TXT( "m_TestValue2" ) );
 }
+
+void TestGameObject4::PopulateComposite( Reflect::Composite& comp )
+{
+    comp.AddField(            &TestGameObject4::m_TestValue1,               TXT( "m_TestValue1" ) );
+    comp.AddField(            &TestGameObject4::m_TestCount,                TXT( "m_TestCount" ) );
+    comp.AddField(            &TestGameObject4::m_TestFlag,                 TXT( "m_TestFlag" ) );
+    comp.AddField(            &TestGameObject4::m_TestString,               TXT( "m_TestString" ) );
+    comp.AddField(            &TestGameObject4::m_TestArray,                TXT( "m_TestArray" ) );
+    comp.AddField(            &TestGameObject4::m_TestReference,            TXT( "m_TestReference" ), Reflect::FieldFlags::Share );
+}
+
+TestResource::TestResource()
+    : m_TestDataSize( 0 )
+    , m_bTestDataResident( true )
+{
+}
+
+bool TestResource::NeedsPrecacheResourceData() const
+{
+    return !m_bTestDataResident;
+}
+
+bool TestResource::BeginPrecacheResourceData()
+{
+    // Restoring completes immediately, as the simulated data does not need to be loaded.
+    m_bTestDataResident = true;
+
+    return true;
+}
+
+size_t TestResource::GetResidentResourceDataSize() const
+{
+    return ( m_bTestDataResident ? m_TestDataSize : 0 );
+}
+
+bool TestResource::EvictResourceData()
+{
+    if( !m_bTestDataResident )
+    {
+        return false;
+    }
+
+    m_bTestDataResident = false;
+
+    return true;
+}
@@ -1,5 +1,6 @@
 
 #include "Engine/GameObject.h"
+#include "Engine/Resource.h"
 
 namespace Helium
 {
@@ -33,4 +34,35 @@ namespace Helium
         
         static void PopulateComposite( Reflect::Composite& comp);
     };
+
+    class TestGameObject4 : public Helium::GameObject
+    {
+        HELIUM_DECLARE_OBJECT( TestGameObject4, GameObject );
+    public:
+        float m_TestValue1;
+        uint32_t m_TestCount;
+        bool m_TestFlag;
+        tstring m_TestString;
+        Helium::DynamicArray<uint32_t> m_TestArray;
+        Helium::StrongPtr<TestGameObject3> m_TestReference;
+
+        static void PopulateComposite( Reflect::Composite& comp);
+    };
+
+    /// Resource with simulated resource data, used for testing residency management without any resource caches.
+    class TestResource : public Helium::Resource
+    {
+        HELIUM_DECLARE_OBJECT( TestResource, Resource );
+    public:
+        TestResource();
+
+        virtual bool NeedsPrecacheResourceData() const;
+        virtual bool BeginPrecacheResourceData();
+
+        virtual size_t GetResidentResourceDataSize() const;
+        virtual bool EvictResourceData();
+
+        size_t m_TestDataSize;
+        bool m_bTestDataResident;
+    };
 }
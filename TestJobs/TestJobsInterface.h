@@ -54,6 +54,7 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
@@ -96,6 +97,7 @@ public:
     //@{
     void Run( JobContext* pContext );
     inline static void RunCallback( void* pJob, JobContext* pContext );
+    inline static const char* GetTypeName();
     //@}
 
 private:
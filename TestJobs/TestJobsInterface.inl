@@ -59,6 +59,14 @@ void FibJob::RunCallback( void* pJob, JobContext* pContext )
     static_cast< FibJob* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* FibJob::GetTypeName()
+{
+    return "FibJob";
+}
+
 /// Constructor.
 FibJob::Parameters::Parameters()
     : n(0)
@@ -117,6 +125,14 @@ void FibContinuation::RunCallback( void* pJob, JobContext* pContext )
     static_cast< FibContinuation* >( pJob )->Run( pContext );
 }
 
+/// Get the name of this job type.
+///
+/// @return  Job type name.
+const char* FibContinuation::GetTypeName()
+{
+    return "FibContinuation";
+}
+
 /// Constructor.
 FibContinuation::Parameters::Parameters()
     : x(0)
@@ -155,6 +155,7 @@ project( prefix .. "Editor" )
 		prefix .. "EngineJobs",
 		prefix .. "Windowing",
 		prefix .. "Rendering",
+		prefix .. "RenderingHeadless",
 		prefix .. "GraphicsTypes",
 		prefix .. "GraphicsJobs",
 		prefix .. "Graphics",